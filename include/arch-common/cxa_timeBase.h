@@ -18,6 +18,11 @@
  * maximum value of the counter into account. It is not possible to judge elapsed time
  * beyond the range returned by ::cxa_timeBase_getMaxCount_us.
  *
+ * To measure longer periods, ::cxa_timeBase_getCount64_us provides a 64-bit count which
+ * (for all practical purposes) never overflows. Where the hardware counter is narrower, the
+ * architecture-specific implementation extends it in software. It is also guaranteed to be
+ * monotonic (eg. it does not jump on NTP / SNTP corrections of the wall clock).
+ *
  * @note This file contains the base functionality for a timeBase object available across all architectures. Additional
  *		functionality, including initialization is available in the architecture-specific implementation.
  *
@@ -68,4 +73,17 @@ uint32_t cxa_timeBase_getCount_us(void);
 uint32_t cxa_timeBase_getMaxCount_us(void);
 
 
+/**
+ * @public
+ * @brief Returns the current monotonic, relative time in microseconds as a 64-bit
+ * count which does not overflow (unlike ::cxa_timeBase_getCount_us).
+ *
+ * @note implementations that extend a narrower hardware counter in software must be
+ * 		called at least once per hardware overflow period (the runLoop does this)
+ *
+ * @return the current time of the timeBase, in microseconds
+ */
+uint64_t cxa_timeBase_getCount64_us(void);
+
+
 #endif // CXA_TIMEBASE_H_
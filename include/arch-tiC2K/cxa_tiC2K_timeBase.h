@@ -0,0 +1,35 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_TIC2K_TIMEBASE_H_
+#define CXA_TIC2K_TIMEBASE_H_
+
+
+// ******** includes ********
+#include <stdint.h>
+#include <cxa_timeBase.h>
+
+
+// ******** global macro definitions ********
+
+
+// ******** global type definitions *********
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * Configures the given CPU timer (eg. CPUTIMER1_BASE) as a free-running 1MHz
+ * down-counter and uses it as the timeBase. The timer must not be used for
+ * anything else (CPUTIMER2 is usually claimed by the RTOS).
+ *
+ * @note ::cxa_timeBase_getCount64_us must be called at least once per 32-bit
+ * 		wrap (~71 minutes) to track overflows (::cxa_runLoop_iterate does this)
+ */
+void cxa_tiC2K_timeBase_init(uint32_t cpuTimerBaseIn);
+
+
+#endif
@@ -23,8 +23,9 @@
 
 
 // ******** global macro definitions ********
+// (connection managers / schedulers each register one to learn when we become ready)
 #ifndef CXA_BTLE_CENTRAL_MAXNUM_LISTENERS
-	#define CXA_BTLE_CENTRAL_MAXNUM_LISTENERS				2
+	#define CXA_BTLE_CENTRAL_MAXNUM_LISTENERS				4
 #endif
 
 #ifndef CXA_BTLE_CENTRAL_MAXNUM_CONNECTIONS
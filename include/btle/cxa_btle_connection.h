@@ -13,6 +13,7 @@
 #include <cxa_config.h>
 #include <cxa_eui48.h>
 #include <cxa_fixedByteBuffer.h>
+#include <cxa_timeDiff.h>
 
 
 // ******** global macro definitions ********
@@ -20,6 +21,12 @@
 	#define CXA_BTLE_CONNECTION_MAXNUM_NOTIINDI_SUBSCRIPTIONS	2
 #endif
 
+#define CXA_BTLE_CONNECTION_DEFAULT_ATT_MTU						23
+#define CXA_BTLE_CONNECTION_ATT_WRITE_HEADER_SIZE_BYTES			3
+
+#define CXA_BTLE_CONNECTION_DEFAULT_DATA_LENGTH_BYTES			27
+#define CXA_BTLE_CONNECTION_MAX_DATA_LENGTH_BYTES				251
+
 
 // ******** global type definitions *********
 /**
@@ -40,6 +47,45 @@ typedef enum
 }cxa_btle_connection_disconnectReason_t;
 
 
+/**
+ * @public
+ * Values may be OR'd together when requesting a PHY
+ */
+typedef enum
+{
+	CXA_BTLE_CONNECTION_PHY_1M = 0x01,
+	CXA_BTLE_CONNECTION_PHY_2M = 0x02,
+	CXA_BTLE_CONNECTION_PHY_CODED = 0x04
+}cxa_btle_connection_phy_t;
+
+
+/**
+ * @public
+ */
+typedef struct
+{
+	uint32_t minInterval_us;
+	uint32_t maxInterval_us;
+	uint16_t slaveLatency;
+	uint16_t supervisionTimeout_ms;
+}cxa_btle_connection_parameters_t;
+
+
+/**
+ * @public
+ * Current state of the link as reported by the underlying stack
+ */
+typedef struct
+{
+	uint32_t interval_us;
+	uint16_t slaveLatency;
+	uint16_t supervisionTimeout_ms;
+
+	cxa_btle_connection_phy_t phy;
+	uint16_t dataLength_bytes;
+}cxa_btle_connection_linkInfo_t;
+
+
 /**
  * @public
  */
@@ -70,6 +116,14 @@ typedef void (*cxa_btle_connection_cb_onNotiIndiSubscriptionChanged_t)(const cha
 																	   void* userVarIn);
 
 
+/**
+ * @public
+ * Called whenever the ATT MTU, connection parameters, PHY or
+ * data length of the connection change
+ */
+typedef void (*cxa_btle_connection_cb_onLinkChanged_t)(cxa_btle_connection_t *const connIn, void* userVarIn);
+
+
 /**
  * @public
  */
@@ -110,6 +164,42 @@ typedef void (*cxa_btle_connection_scm_changeNotifications_t)(cxa_btle_connectio
 															  bool enableNotificationsIn);
 
 
+/**
+ * @protected
+ * Should return true if the write was accepted by the stack
+ * (or queued pending characteristic resolution), false otherwise
+ */
+typedef bool (*cxa_btle_connection_scm_writeToCharacteristic_noResponse_t)(cxa_btle_connection_t *const superIn,
+																		   const char *const serviceUuidIn,
+																		   const char *const characteristicUuidIn,
+																		   void *const dataIn,
+																		   size_t numBytesIn);
+
+
+/**
+ * @protected
+ * Should return true if the request was accepted by the stack
+ */
+typedef bool (*cxa_btle_connection_scm_requestParameters_t)(cxa_btle_connection_t *const superIn,
+															cxa_btle_connection_parameters_t *const paramsIn);
+
+
+/**
+ * @protected
+ * Should return true if the request was accepted by the stack
+ */
+typedef bool (*cxa_btle_connection_scm_requestPhy_t)(cxa_btle_connection_t *const superIn,
+													 uint8_t phyMaskIn);
+
+
+/**
+ * @protected
+ * Should return true if the request was accepted by the stack
+ */
+typedef bool (*cxa_btle_connection_scm_requestDataLength_t)(cxa_btle_connection_t *const superIn,
+															uint16_t dataLength_bytesIn);
+
+
 /**
  * @private
  */
@@ -130,6 +220,24 @@ struct cxa_btle_connection
 {
 	void* btlec;				// cxa_btle_central_t
 	cxa_eui48_t targetAddr;
+	uint16_t attMtu;
+	cxa_btle_connection_linkInfo_t linkInfo;
+
+	uint8_t activeProcedures;
+
+	struct
+	{
+		bool isEnabled;
+		bool isFast;
+		bool isCheckPending;
+		int threadId;
+
+		cxa_btle_connection_parameters_t params_fast;
+		cxa_btle_connection_parameters_t params_relaxed;
+		uint32_t idleTimeout_ms;
+
+		cxa_timeDiff_t td_lastActivity;
+	}adaptive;
 
 	cxa_array_t notiIndiSubs;
 	cxa_btle_connection_notiIndiSubscription_t notiIndiSubs_raw[CXA_BTLE_CONNECTION_MAXNUM_NOTIINDI_SUBSCRIPTIONS];
@@ -165,6 +273,12 @@ struct cxa_btle_connection
 			cxa_btle_connection_cb_onNotiIndiSubscriptionChanged_t func;
 			void* userVar;
 		}unsubscribeFromChar;
+
+		struct
+		{
+			cxa_btle_connection_cb_onLinkChanged_t func;
+			void* userVar;
+		}linkChanged;
 	}cbs;
 
 	struct
@@ -173,8 +287,13 @@ struct cxa_btle_connection
 
 		cxa_btle_connection_scm_readFromCharacteristic_t readFromCharacteristic;
 		cxa_btle_connection_scm_writeToCharacteristic_t writeToCharacteristic;
+		cxa_btle_connection_scm_writeToCharacteristic_noResponse_t writeToCharacteristic_noResponse;
 
 		cxa_btle_connection_scm_changeNotifications_t changeNotifications;
+
+		cxa_btle_connection_scm_requestParameters_t requestParameters;
+		cxa_btle_connection_scm_requestPhy_t requestPhy;
+		cxa_btle_connection_scm_requestDataLength_t requestDataLength;
 	}scms;
 };
 
@@ -188,9 +307,21 @@ void cxa_btle_connection_init(cxa_btle_connection_t *const connIn,
 							  cxa_btle_connection_scm_stopConnection_t scm_stopConnectionIn,
 							  cxa_btle_connection_scm_readFromCharacteristic_t scm_readFromCharIn,
 							  cxa_btle_connection_scm_writeToCharacteristic_t scm_writeToCharIn,
+							  cxa_btle_connection_scm_writeToCharacteristic_noResponse_t scm_writeToCharNoRspIn,
 							  cxa_btle_connection_scm_changeNotifications_t scm_changeNotiIndisIn);
 
 
+/**
+ * @protected
+ * Link-layer tuning is optional, any of these may be NULL if the
+ * underlying stack does not support the corresponding request
+ */
+void cxa_btle_connection_setLinkScms(cxa_btle_connection_t *const connIn,
+									 cxa_btle_connection_scm_requestParameters_t scm_requestParamsIn,
+									 cxa_btle_connection_scm_requestPhy_t scm_requestPhyIn,
+									 cxa_btle_connection_scm_requestDataLength_t scm_requestDataLengthIn);
+
+
 /**
  * @protected
  */
@@ -212,6 +343,115 @@ void cxa_btle_connection_setOnClosedCb(cxa_btle_connection_t *const connIn,
 cxa_eui48_t* cxa_btle_connection_getTargetMacAddress(cxa_btle_connection_t *const connIn);
 
 
+/**
+ * @public
+ * @return the currently negotiated ATT MTU for this connection
+ * 		(CXA_BTLE_CONNECTION_DEFAULT_ATT_MTU until the exchange completes)
+ */
+uint16_t cxa_btle_connection_getAttMtu(cxa_btle_connection_t *const connIn);
+
+
+/**
+ * @public
+ * @return the maximum number of bytes that can be carried in a single
+ * 		write or notification given the current ATT MTU
+ */
+size_t cxa_btle_connection_getMaxAttPayloadSize_bytes(cxa_btle_connection_t *const connIn);
+
+
+/**
+ * @public
+ * @return the most recently reported state of the link
+ */
+cxa_btle_connection_linkInfo_t* cxa_btle_connection_getLinkInfo(cxa_btle_connection_t *const connIn);
+
+
+/**
+ * @public
+ */
+void cxa_btle_connection_setOnLinkChangedCb(cxa_btle_connection_t *const connIn,
+											cxa_btle_connection_cb_onLinkChanged_t cbIn,
+											void* userVarIn);
+
+
+/**
+ * @public
+ * Requests new connection parameters. The change takes effect once the
+ * peer agrees (reported via the onLinkChanged callback).
+ *
+ * @return true if the request was accepted by the stack
+ */
+bool cxa_btle_connection_requestParameters(cxa_btle_connection_t *const connIn,
+										   cxa_btle_connection_parameters_t *const paramsIn);
+
+
+/**
+ * @public
+ * @param[in] phyMaskIn one or more of ::cxa_btle_connection_phy_t OR'd together
+ *
+ * @return true if the request was accepted by the stack
+ */
+bool cxa_btle_connection_requestPhy(cxa_btle_connection_t *const connIn,
+									uint8_t phyMaskIn);
+
+
+/**
+ * @public
+ * Requests a new maximum link-layer payload (data length extension)
+ *
+ * @note not every backend supports this request: the siLabs BGAPI stack
+ * 		negotiates the data length itself, so this always returns false there
+ * 		(the negotiated value is still reported through the link changed callback)
+ *
+ * @return true if the request was accepted by the stack, false if it was
+ * 		rejected, out of range or unsupported by this backend
+ */
+bool cxa_btle_connection_requestDataLength(cxa_btle_connection_t *const connIn,
+										   uint16_t dataLength_bytesIn);
+
+
+/**
+ * @public
+ * Requests the 2M PHY (falling back to 1M) and the maximum data length
+ * supported by the stack. The ATT MTU is negotiated by the underlying
+ * stack when the connection is opened.
+ *
+ * @return true if at least one of the requests was accepted
+ */
+bool cxa_btle_connection_requestMaxThroughput(cxa_btle_connection_t *const connIn);
+
+
+/**
+ * @public
+ * Enables an adaptive connection interval policy for the current connection.
+ * The fast parameters are requested as soon as a GATT procedure is started
+ * (or a notification is received) and the relaxed parameters are requested
+ * once no procedures have been pending for idleTimeout_msIn.
+ *
+ * @note The policy is cleared when the connection closes
+ *
+ * @param[in] threadIdIn the runLoop thread used to check for idle
+ */
+void cxa_btle_connection_enableAdaptiveInterval(cxa_btle_connection_t *const connIn,
+												int threadIdIn,
+												cxa_btle_connection_parameters_t *const params_fastIn,
+												cxa_btle_connection_parameters_t *const params_relaxedIn,
+												uint32_t idleTimeout_msIn);
+
+
+/**
+ * @public
+ */
+void cxa_btle_connection_disableAdaptiveInterval(cxa_btle_connection_t *const connIn);
+
+
+/**
+ * @public
+ * @return true if a read, write or subscription change is in progress
+ */
+bool cxa_btle_connection_hasPendingProcedures(cxa_btle_connection_t *const connIn);
+
+
 /**
  * @public
  */
@@ -245,6 +485,27 @@ void cxa_btle_connection_writeToCharacteristic_ptr(cxa_btle_connection_t *const
 												   void *userVarIn);
 
 
+/**
+ * @public
+ * Performs a write-without-response (ATT write command). Unlike
+ * ::cxa_btle_connection_writeToCharacteristic, multiple writes may be
+ * outstanding and no completion callback is issued.
+ *
+ * Backends that address characteristics by handle (eg. siLabs) only accept
+ * the write once the characteristic has been resolved: until then this returns
+ * false and starts resolving it in the background (if no other procedure is
+ * in progress), so the caller's retry succeeds once resolution completes.
+ *
+ * @return true if the write was accepted, false if the underlying stack
+ * 		cannot currently accept it (caller should retry later)
+ */
+bool cxa_btle_connection_writeToCharacteristic_noResponse(cxa_btle_connection_t *const connIn,
+														  const char *const serviceUuidIn,
+														  const char *const characteristicUuidIn,
+														  void *const dataIn,
+														  size_t numBytesIn);
+
+
 /**
  * @public
  */
@@ -278,6 +539,36 @@ void cxa_btle_connection_notify_connectionClose(cxa_btle_connection_t *const con
 												cxa_btle_connection_disconnectReason_t reasonIn);
 
 
+/**
+ * @protected
+ */
+void cxa_btle_connection_notify_attMtuChanged(cxa_btle_connection_t *const connIn,
+											  uint16_t attMtuIn);
+
+
+/**
+ * @protected
+ */
+void cxa_btle_connection_notify_parametersChanged(cxa_btle_connection_t *const connIn,
+												  uint32_t interval_usIn,
+												  uint16_t slaveLatencyIn,
+												  uint16_t supervisionTimeout_msIn);
+
+
+/**
+ * @protected
+ */
+void cxa_btle_connection_notify_phyChanged(cxa_btle_connection_t *const connIn,
+										   cxa_btle_connection_phy_t phyIn);
+
+
+/**
+ * @protected
+ */
+void cxa_btle_connection_notify_dataLengthChanged(cxa_btle_connection_t *const connIn,
+												  uint16_t dataLength_bytesIn);
+
+
 /**
  * @protected
  */
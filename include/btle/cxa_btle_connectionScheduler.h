@@ -0,0 +1,345 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains a scheduler which rotates a table of target peripherals through
+ * the (limited) number of simultaneous connections supported by a btle central. Where
+ * ::cxa_btle_connectionManager_t maintains a single connection to a single peripheral,
+ * the scheduler is meant for gateways that must periodically poll many peripherals.
+ *
+ * Each target has a polling period and a priority. When a connection slot is available,
+ * the scheduler connects to the highest-priority target whose polling period has elapsed
+ * (ties go to the most overdue target) and hands the connection to the target's
+ * `cb_onPoll` callback. The callback (or anything it kicks off) must eventually call
+ * ::cxa_btle_connectionScheduler_releaseTarget, at which point the connection is closed
+ * and the slot is returned to the pool. Targets with one or more subscriptions are
+ * considered persistent: once connected their subscriptions are restored and they hold
+ * their slot until disconnected.
+ *
+ * Optionally, passive scan windows may be interleaved between connection attempts
+ * using ::cxa_btle_connectionScheduler_setScanWindow.
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_btle_connectionScheduler_t sched;
+ * cxa_btle_connectionScheduler_init(&sched, btlec, CXA_RUNLOOP_THREADID_DEFAULT);
+ *
+ * cxa_btle_connectionScheduler_target_t* tgt = cxa_btle_connectionScheduler_addTarget(&sched, &sensorMac, false, 60000, 1, cb_onPoll, NULL);
+ * cxa_btle_connectionScheduler_start(&sched);
+ *
+ * ...
+ *
+ * static void cb_onPoll(cxa_btle_connectionScheduler_target_t *const targetIn, cxa_btle_connection_t *const connIn, void* userVarIn)
+ * {
+ *    // read some characteristics, then (from the read-complete callback)
+ *    cxa_btle_connectionScheduler_releaseTarget(targetIn, true);
+ * }
+ * @endcode
+ */
+#ifndef CXA_BTLE_CONNECTIONSCHEDULER_H_
+#define CXA_BTLE_CONNECTIONSCHEDULER_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cxa_array.h>
+#include <cxa_btle_central.h>
+#include <cxa_btle_connection.h>
+#include <cxa_config.h>
+#include <cxa_eui48.h>
+#include <cxa_logger_header.h>
+#include <cxa_stateMachine.h>
+#include <cxa_timeDiff.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_BTLE_CONNECTION_SCHEDULER_MAXNUM_TARGETS
+	#define CXA_BTLE_CONNECTION_SCHEDULER_MAXNUM_TARGETS					16
+#endif
+
+#ifndef CXA_BTLE_CONNECTION_SCHEDULER_MAXNUM_SUBSCRIPTIONS_PER_TARGET
+	#define CXA_BTLE_CONNECTION_SCHEDULER_MAXNUM_SUBSCRIPTIONS_PER_TARGET	2
+#endif
+
+#ifndef CXA_BTLE_CONNECTION_SCHEDULER_MAX_HOLD_MS
+	#define CXA_BTLE_CONNECTION_SCHEDULER_MAX_HOLD_MS						10000
+#endif
+
+#ifndef CXA_BTLE_CONNECTION_SCHEDULER_RETRY_STANDOFF_MS
+	#define CXA_BTLE_CONNECTION_SCHEDULER_RETRY_STANDOFF_MS					5000
+#endif
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ */
+typedef struct cxa_btle_connectionScheduler cxa_btle_connectionScheduler_t;
+
+
+/**
+ * @public
+ */
+typedef struct cxa_btle_connectionScheduler_target cxa_btle_connectionScheduler_target_t;
+
+
+/**
+ * @public
+ * Called when a connection to a (non-persistent) target has been opened. The target
+ * must be released using ::cxa_btle_connectionScheduler_releaseTarget once polling is
+ * complete, otherwise it will be forcibly disconnected after
+ * CXA_BTLE_CONNECTION_SCHEDULER_MAX_HOLD_MS.
+ */
+typedef void (*cxa_btle_connectionScheduler_cb_onPoll_t)(cxa_btle_connectionScheduler_target_t *const targetIn, cxa_btle_connection_t *const connIn, void* userVarIn);
+
+
+/**
+ * @public
+ * Per-target connection metrics. All latencies are in milliseconds.
+ */
+typedef struct
+{
+	uint32_t numConnectAttempts;
+	uint32_t numConnectFailures;
+	uint32_t numPollsSuccessful;
+	uint32_t numPollsFailed;
+	uint32_t numHoldTimeouts;
+	uint32_t numUnexpectedDisconnects;
+
+	uint32_t lastConnectLatency_ms;				///< time from connection request until connection opened
+	uint32_t maxConnectLatency_ms;
+	uint32_t avgConnectLatency_ms;				///< exponentially-weighted (1/8) moving average
+
+	uint32_t lastScheduleLag_ms;				///< how late the last connection attempt was relative to its polling period
+	uint32_t maxScheduleLag_ms;
+}cxa_btle_connectionScheduler_targetStats_t;
+
+
+/**
+ * @private
+ */
+typedef enum
+{
+	CXA_BTLE_CONNSCHED_TARGETSTATE_IDLE,
+	CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTING,
+	CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTED,
+	CXA_BTLE_CONNSCHED_TARGETSTATE_DISCONNECTING
+}cxa_btle_connectionScheduler_targetState_t;
+
+
+/**
+ * @private
+ */
+typedef struct
+{
+	const char* serviceUuid_str;
+	const char* characteristicUuid_str;
+
+	cxa_btle_connection_cb_onNotiIndiRx_t cb_onRx;
+	void* userVar;
+}cxa_btle_connectionScheduler_subscription_t;
+
+
+/**
+ * @private
+ */
+struct cxa_btle_connectionScheduler_target
+{
+	cxa_btle_connectionScheduler_t* parent;
+
+	cxa_eui48_t macAddress;
+	bool isRandomAddress;
+
+	uint32_t pollPeriod_ms;
+	uint8_t priority;
+	bool isEnabled;
+
+	cxa_array_t subscriptions;
+	cxa_btle_connectionScheduler_subscription_t subscriptions_raw[CXA_BTLE_CONNECTION_SCHEDULER_MAXNUM_SUBSCRIPTIONS_PER_TARGET];
+	size_t currSubscriptionIndex;
+
+	cxa_btle_connectionScheduler_targetState_t state;
+	cxa_btle_connection_t* conn;
+
+	cxa_timeDiff_t td_lastPoll;
+	uint32_t nextPollDelay_ms;
+	cxa_timeDiff_t td_stateChange;
+
+	cxa_btle_connectionScheduler_cb_onPoll_t cb_onPoll;
+	void* userVar;
+
+	cxa_btle_connectionScheduler_targetStats_t stats;
+};
+
+
+/**
+ * @private
+ */
+struct cxa_btle_connectionScheduler
+{
+	cxa_btle_central_t* btlec;
+
+	bool isRunning;
+
+	cxa_array_t targets;
+	cxa_btle_connectionScheduler_target_t targets_raw[CXA_BTLE_CONNECTION_SCHEDULER_MAXNUM_TARGETS];
+	cxa_btle_connectionScheduler_target_t* connectingTarget;
+
+	struct
+	{
+		uint32_t period_ms;
+		uint32_t duration_ms;
+		cxa_timeDiff_t td_period;
+
+		cxa_btle_central_cb_onAdvertRx_t cb_onAdvert;
+		void* userVar;
+	}scan;
+
+	cxa_stateMachine_t stateMachine;
+	cxa_logger_t logger;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the scheduler. No connections are made until
+ * ::cxa_btle_connectionScheduler_start is called.
+ *
+ * @param[in] schedIn the pre-allocated scheduler
+ * @param[in] btlecIn the central used to connect to targets
+ * @param[in] threadIdIn the runLoop thread on which the scheduler should execute
+ */
+void cxa_btle_connectionScheduler_init(cxa_btle_connectionScheduler_t *const schedIn, cxa_btle_central_t *const btlecIn, int threadIdIn);
+
+
+/**
+ * @public
+ * @brief Adds a peripheral to the scheduler's target table
+ *
+ * @param[in] schedIn the pre-initialized scheduler
+ * @param[in] macIn address of the target peripheral (copied)
+ * @param[in] isRandomAddrIn true if the peripheral uses a random address
+ * @param[in] pollPeriod_msIn how often the target should be connected
+ * 		(ignored for persistent / subscribed targets)
+ * @param[in] priorityIn higher numbers are serviced first when multiple targets are due
+ * @param[in] cb_onPollIn called when a connection to the target is opened
+ * @param[in] userVarIn passed to cb_onPollIn
+ *
+ * @return the new target or NULL if CXA_BTLE_CONNECTION_SCHEDULER_MAXNUM_TARGETS
+ * 		has been reached
+ */
+cxa_btle_connectionScheduler_target_t* cxa_btle_connectionScheduler_addTarget(cxa_btle_connectionScheduler_t *const schedIn,
+																			   cxa_eui48_t *const macIn, bool isRandomAddrIn,
+																			   uint32_t pollPeriod_msIn, uint8_t priorityIn,
+																			   cxa_btle_connectionScheduler_cb_onPoll_t cb_onPollIn,
+																			   void* userVarIn);
+
+
+/**
+ * @public
+ * @brief Adds a notification subscription to the target. Targets with subscriptions
+ * are kept connected and their subscriptions are restored on every (re)connection.
+ *
+ * @return true on success, false if
+ * 		CXA_BTLE_CONNECTION_SCHEDULER_MAXNUM_SUBSCRIPTIONS_PER_TARGET has been reached
+ */
+bool cxa_btle_connectionScheduler_target_addSubscription(cxa_btle_connectionScheduler_target_t *const targetIn,
+														 const char *const serviceUuidIn,
+														 const char *const characteristicUuidIn,
+														 cxa_btle_connection_cb_onNotiIndiRx_t cb_onRxIn,
+														 void* userVarIn);
+
+
+/**
+ * @public
+ * @brief Enables or disables scheduling of the given target. Disabling a
+ * connected target will disconnect it.
+ */
+void cxa_btle_connectionScheduler_target_setEnabled(cxa_btle_connectionScheduler_target_t *const targetIn, bool isEnabledIn);
+
+
+/**
+ * @public
+ * @brief Schedules the target for connection as soon as a slot is available
+ * (regardless of its polling period)
+ */
+void cxa_btle_connectionScheduler_target_pollNow(cxa_btle_connectionScheduler_target_t *const targetIn);
+
+
+/**
+ * @public
+ * @brief Configures passive scans which are interleaved with connection attempts
+ *
+ * @param[in] schedIn the pre-initialized scheduler
+ * @param[in] period_msIn how often a scan window should be opened (0 to disable)
+ * @param[in] duration_msIn how long each scan window should last
+ * @param[in] cb_onAdvertIn called for each advert received during a scan window
+ * @param[in] userVarIn passed to cb_onAdvertIn
+ */
+void cxa_btle_connectionScheduler_setScanWindow(cxa_btle_connectionScheduler_t *const schedIn,
+												uint32_t period_msIn, uint32_t duration_msIn,
+												cxa_btle_central_cb_onAdvertRx_t cb_onAdvertIn,
+												void* userVarIn);
+
+
+/**
+ * @public
+ */
+void cxa_btle_connectionScheduler_start(cxa_btle_connectionScheduler_t *const schedIn);
+
+
+/**
+ * @public
+ * @brief Stops scheduling new connections and closes all open connections
+ */
+void cxa_btle_connectionScheduler_stop(cxa_btle_connectionScheduler_t *const schedIn);
+
+
+/**
+ * @public
+ * @brief Indicates that polling of the given target is complete. The connection
+ * will be closed and the slot made available to other targets.
+ *
+ * @param[in] targetIn the target passed to the cb_onPoll callback
+ * @param[in] wasSuccessfulIn used for the target's statistics
+ */
+void cxa_btle_connectionScheduler_releaseTarget(cxa_btle_connectionScheduler_target_t *const targetIn, bool wasSuccessfulIn);
+
+
+/**
+ * @public
+ * @return the number of targets currently holding (or acquiring) a connection slot
+ */
+size_t cxa_btle_connectionScheduler_getNumActiveConnections(cxa_btle_connectionScheduler_t *const schedIn);
+
+
+/**
+ * @public
+ * @return the current connection for the target, or NULL if not connected
+ */
+cxa_btle_connection_t* cxa_btle_connectionScheduler_target_getConnection(cxa_btle_connectionScheduler_target_t *const targetIn);
+
+
+/**
+ * @public
+ * @return pointer to the target's (live) connection statistics
+ */
+cxa_btle_connectionScheduler_targetStats_t* cxa_btle_connectionScheduler_target_getStats(cxa_btle_connectionScheduler_target_t *const targetIn);
+
+
+/**
+ * @public
+ * @brief Resets the connection statistics for all targets
+ */
+void cxa_btle_connectionScheduler_resetStats(cxa_btle_connectionScheduler_t *const schedIn);
+
+#endif
@@ -0,0 +1,252 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains a coalescing layer for notifications sent by a ::cxa_btle_peripheral_t.
+ * Rather than sending a notification for every update, the coalescer holds the latest value
+ * for each registered characteristic and flushes all pending values at most
+ * `maxLatency_ms` after the first update. A value that is updated again before it is
+ * flushed replaces the previous (stale) value instead of generating another notification.
+ *
+ * Characteristics may also be "packed": several small values share a single carrier
+ * characteristic and all pending values are sent in as few notifications as possible.
+ * Each value in a packed notification is framed as:
+ *
+ *     <tag> <length> <value...>
+ *
+ * The coalescer tracks subscriptions (where the backend reports them) and drops values for
+ * characteristics that nobody is subscribed to. Because of this, it registers its own
+ * subscription-changed handler for each characteristic it sends on. Applications wishing to
+ * know about subscription changes should pass their callback to
+ * ::cxa_btle_notificationCoalescer_addCharacteristic instead.
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_btle_notificationCoalescer_t nc;
+ * cxa_btle_notificationCoalescer_init(&nc, btlep, CXA_RUNLOOP_THREADID_DEFAULT, 50);
+ *
+ * cxa_btle_notificationCoalescer_entry_t* tempEntry = cxa_btle_notificationCoalescer_addCharacteristic(&nc, SVC_UUID, TEMP_CHAR_UUID, NULL, NULL);
+ * cxa_btle_notificationCoalescer_entry_t* batEntry = cxa_btle_notificationCoalescer_addPackedCharacteristic(&nc, SVC_UUID, STATUS_CHAR_UUID, 0x01);
+ * cxa_btle_notificationCoalescer_entry_t* rssiEntry = cxa_btle_notificationCoalescer_addPackedCharacteristic(&nc, SVC_UUID, STATUS_CHAR_UUID, 0x02);
+ *
+ * ...
+ *
+ * // battery and rssi will go out in the same notification on STATUS_CHAR_UUID
+ * cxa_btle_notificationCoalescer_update(&nc, batEntry, &batLevel, sizeof(batLevel));
+ * cxa_btle_notificationCoalescer_update(&nc, rssiEntry, &rssi, sizeof(rssi));
+ * @endcode
+ */
+#ifndef CXA_BTLE_NOTIFICATIONCOALESCER_H_
+#define CXA_BTLE_NOTIFICATIONCOALESCER_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cxa_array.h>
+#include <cxa_btle_peripheral.h>
+#include <cxa_config.h>
+#include <cxa_logger_header.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_BTLE_NOTIFICATIONCOALESCER_MAXNUM_ENTRIES
+	#define CXA_BTLE_NOTIFICATIONCOALESCER_MAXNUM_ENTRIES				8
+#endif
+
+#ifndef CXA_BTLE_NOTIFICATIONCOALESCER_MAXNUM_CHANNELS
+	#define CXA_BTLE_NOTIFICATIONCOALESCER_MAXNUM_CHANNELS				4
+#endif
+
+#ifndef CXA_BTLE_NOTIFICATIONCOALESCER_MAX_NOTIFICATION_SIZE_BYTES
+	#define CXA_BTLE_NOTIFICATIONCOALESCER_MAX_NOTIFICATION_SIZE_BYTES	20
+#endif
+
+#define CXA_BTLE_NOTIFICATIONCOALESCER_PACKED_HEADER_SIZE_BYTES			2
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ */
+typedef struct cxa_btle_notificationCoalescer cxa_btle_notificationCoalescer_t;
+
+
+/**
+ * @public
+ */
+typedef struct cxa_btle_notificationCoalescer_entry cxa_btle_notificationCoalescer_entry_t;
+
+
+/**
+ * @public
+ */
+typedef struct
+{
+	uint32_t numUpdates;
+	uint32_t numNotificationsSent;
+	uint32_t numNotificationsSaved;				///< superseded values + values that shared a notification
+	uint32_t numValuesSuperseded;
+	uint32_t numValuesDropped;					///< pending values discarded because nobody was subscribed
+	uint32_t maxQueueDepth;
+}cxa_btle_notificationCoalescer_stats_t;
+
+
+/**
+ * @private
+ */
+typedef enum
+{
+	CXA_BTLE_NOTIFICATIONCOALESCER_SUBSCRIPTION_UNKNOWN,
+	CXA_BTLE_NOTIFICATIONCOALESCER_SUBSCRIPTION_SUBSCRIBED,
+	CXA_BTLE_NOTIFICATIONCOALESCER_SUBSCRIPTION_UNSUBSCRIBED
+}cxa_btle_notificationCoalescer_subscriptionState_t;
+
+
+/**
+ * @private
+ * A characteristic on which notifications are actually sent
+ */
+typedef struct
+{
+	cxa_btle_notificationCoalescer_t* parent;
+
+	const char* serviceUuid_str;
+	const char* charUuid_str;
+	bool isPacked;
+
+	cxa_btle_notificationCoalescer_subscriptionState_t subscriptionState;
+
+	cxa_btle_peripheral_cb_onSubscriptionChanged_t cb_onSubscriptionChanged;
+	void* userVar;
+}cxa_btle_notificationCoalescer_channel_t;
+
+
+/**
+ * @private
+ */
+struct cxa_btle_notificationCoalescer_entry
+{
+	cxa_btle_notificationCoalescer_channel_t* channel;
+	uint8_t tag;
+
+	bool isPending;
+	size_t valueSize_bytes;
+	uint8_t value[CXA_BTLE_NOTIFICATIONCOALESCER_MAX_NOTIFICATION_SIZE_BYTES];
+};
+
+
+/**
+ * @private
+ */
+struct cxa_btle_notificationCoalescer
+{
+	cxa_btle_peripheral_t* btlep;
+	int threadId;
+	uint32_t maxLatency_ms;
+
+	cxa_array_t channels;
+	cxa_btle_notificationCoalescer_channel_t channels_raw[CXA_BTLE_NOTIFICATIONCOALESCER_MAXNUM_CHANNELS];
+
+	cxa_array_t entries;
+	cxa_btle_notificationCoalescer_entry_t entries_raw[CXA_BTLE_NOTIFICATIONCOALESCER_MAXNUM_ENTRIES];
+
+	size_t numPendingEntries;
+	bool isFlushScheduled;
+
+	cxa_btle_notificationCoalescer_stats_t stats;
+
+	cxa_logger_t logger;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @param[in] maxLatency_msIn the maximum time a value may be held before it
+ * 		is sent. 0 sends at the next runLoop iteration (coalescing all
+ * 		updates made during the current iteration)
+ */
+void cxa_btle_notificationCoalescer_init(cxa_btle_notificationCoalescer_t *const ncIn,
+										 cxa_btle_peripheral_t *const btlepIn,
+										 int threadIdIn,
+										 uint32_t maxLatency_msIn);
+
+
+/**
+ * @public
+ * Registers a characteristic whose (latest) value is sent in its own notification
+ *
+ * @param[in] cb_onSubChangedIn optional, called when the subscription changes
+ * 		(replaces ::cxa_btle_peripheral_registerSubscriptionChangedHandler)
+ *
+ * @return the entry to use for updates
+ */
+cxa_btle_notificationCoalescer_entry_t* cxa_btle_notificationCoalescer_addCharacteristic(cxa_btle_notificationCoalescer_t *const ncIn,
+																						 const char *const serviceUuidStrIn,
+																						 const char *const charUuidStrIn,
+																						 cxa_btle_peripheral_cb_onSubscriptionChanged_t cb_onSubChangedIn,
+																						 void* userVarIn);
+
+
+/**
+ * @public
+ * Registers a value which is packed (with other values sharing the same carrier
+ * characteristic) into a single notification
+ *
+ * @param[in] tagIn identifies this value within the carrier's notifications
+ *
+ * @return the entry to use for updates
+ */
+cxa_btle_notificationCoalescer_entry_t* cxa_btle_notificationCoalescer_addPackedCharacteristic(cxa_btle_notificationCoalescer_t *const ncIn,
+																							   const char *const serviceUuidStrIn,
+																							   const char *const carrierCharUuidStrIn,
+																							   uint8_t tagIn);
+
+
+/**
+ * @public
+ * Replaces the pending value for the given entry and schedules a flush
+ *
+ * @return false if the value is too large for the entry
+ */
+bool cxa_btle_notificationCoalescer_update(cxa_btle_notificationCoalescer_t *const ncIn,
+										   cxa_btle_notificationCoalescer_entry_t *const entryIn,
+										   void *const dataIn,
+										   size_t numBytesIn);
+
+
+/**
+ * @public
+ * Immediately sends all pending values
+ */
+void cxa_btle_notificationCoalescer_flush(cxa_btle_notificationCoalescer_t *const ncIn);
+
+
+/**
+ * @public
+ * @return the number of values waiting to be sent
+ */
+size_t cxa_btle_notificationCoalescer_getQueueDepth(cxa_btle_notificationCoalescer_t *const ncIn);
+
+
+/**
+ * @public
+ */
+cxa_btle_notificationCoalescer_stats_t* cxa_btle_notificationCoalescer_getStats(cxa_btle_notificationCoalescer_t *const ncIn);
+
+
+/**
+ * @public
+ */
+void cxa_btle_notificationCoalescer_resetStats(cxa_btle_notificationCoalescer_t *const ncIn);
+
+
+#endif
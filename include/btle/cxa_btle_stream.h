@@ -0,0 +1,231 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_BTLE_STREAM_H_
+#define CXA_BTLE_STREAM_H_
+
+
+/**
+ * @file
+ * Exposes a pair of characteristics on a BTLE connection as a bidirectional
+ * byte stream (::cxa_ioStream_t). Data sent to the peer uses write-without-response
+ * on the "tx" characteristic while data received from the peer arrives as
+ * notifications on the "rx" characteristic. Each packet is sized to the
+ * negotiated ATT MTU so throughput scales with the link.
+ *
+ * Flow control is credit-based (windowed): each packet starts with a single
+ * header byte:
+ *
+ *     0x00 <payload...>    data packet, consumes one credit at the sender
+ *     0x01 <numCredits>    credit packet, grants the receiver of this packet
+ *                          permission to send <numCredits> more data packets
+ *
+ * Each side grants credits based on the free space in its receive buffer.
+ * Credit packets never consume credits themselves. The peer must implement
+ * the same framing (and use the same CXA_BTLE_STREAM_MAX_PACKET_SIZE_BYTES).
+ *
+ * Credits are counted in packets, so their size in bytes depends on the ATT
+ * MTU. The MTU is exchanged at most once per connection and only grows, so
+ * until the exchange has happened each credit is sized for the largest packet
+ * the peer could send afterwards (CXA_BTLE_STREAM_MAX_PACKET_SIZE_BYTES). The
+ * window is smaller until then, but a late exchange can't overrun our buffer.
+ *
+ * @code
+ * cxa_btle_stream_t stream;
+ * cxa_btle_stream_init(&stream, threadId);
+ * ...
+ * // once connected
+ * cxa_btle_stream_open(&stream, conn, SVC_UUID, TX_CHAR_UUID, RX_CHAR_UUID, cb_onOpened, NULL);
+ * ...
+ * cxa_ioStream_writeBytes(cxa_btle_stream_getIoStream(&stream), data, len);
+ * @endcode
+ *
+ * @note ::cxa_btle_stream_close should be called from the connection's
+ * 		onClosed callback (the stream does not claim that callback itself)
+ */
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cxa_btle_connection.h>
+#include <cxa_config.h>
+#include <cxa_fixedFifo.h>
+#include <cxa_ioStream.h>
+#include <cxa_logger_header.h>
+#include <cxa_runLoop.h>
+#include <cxa_timeDiff.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_BTLE_STREAM_TX_BUFFER_SIZE_BYTES
+	#define CXA_BTLE_STREAM_TX_BUFFER_SIZE_BYTES				1024
+#endif
+
+#ifndef CXA_BTLE_STREAM_RX_BUFFER_SIZE_BYTES
+	#define CXA_BTLE_STREAM_RX_BUFFER_SIZE_BYTES				1024
+#endif
+
+#ifndef CXA_BTLE_STREAM_MAX_PACKET_SIZE_BYTES
+	#define CXA_BTLE_STREAM_MAX_PACKET_SIZE_BYTES				244
+#endif
+
+#ifndef CXA_BTLE_STREAM_OPEN_TIMEOUT_MS
+	#define CXA_BTLE_STREAM_OPEN_TIMEOUT_MS					5000
+#endif
+
+#define CXA_BTLE_STREAM_PACKET_HEADER_SIZE_BYTES				1
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ */
+typedef struct cxa_btle_stream cxa_btle_stream_t;
+
+
+/**
+ * @public
+ */
+typedef void (*cxa_btle_stream_cb_onOpened_t)(cxa_btle_stream_t *const streamIn, bool wasSuccessfulIn, void* userVarIn);
+
+
+/**
+ * @public
+ */
+typedef struct
+{
+	uint32_t numBytesTx;
+	uint32_t numBytesRx;
+	uint32_t numPacketsTx;
+	uint32_t numPacketsRx;
+
+	uint32_t numTxStalls_noCredits;
+	uint32_t numTxStalls_stackBusy;
+	uint32_t numRxOverruns;
+}cxa_btle_stream_stats_t;
+
+
+/**
+ * @private
+ */
+typedef enum
+{
+	CXA_BTLE_STREAM_STATE_CLOSED,
+	CXA_BTLE_STREAM_STATE_OPENING,
+	CXA_BTLE_STREAM_STATE_OPENING_TX,
+	CXA_BTLE_STREAM_STATE_OPEN
+}cxa_btle_stream_state_t;
+
+
+/**
+ * @private
+ */
+struct cxa_btle_stream
+{
+	cxa_btle_stream_state_t state;
+	int threadId;
+	cxa_runLoop_entryHandle_t runLoopEntry;
+	bool isRunLoopEntrySuspended;
+
+	cxa_btle_connection_t* conn;
+	const char* serviceUuid;
+	const char* txCharUuid;
+	const char* rxCharUuid;
+
+	cxa_btle_stream_cb_onOpened_t cb_onOpened;
+	void* cb_userVar;
+	cxa_timeDiff_t td_open;
+
+	cxa_ioStream_t ioStream;
+
+	cxa_fixedFifo_t fifo_tx;
+	uint8_t fifo_tx_raw[CXA_BTLE_STREAM_TX_BUFFER_SIZE_BYTES];
+
+	cxa_fixedFifo_t fifo_rx;
+	uint8_t fifo_rx_raw[CXA_BTLE_STREAM_RX_BUFFER_SIZE_BYTES];
+
+	uint8_t pendingPacket[CXA_BTLE_STREAM_PACKET_HEADER_SIZE_BYTES + CXA_BTLE_STREAM_MAX_PACKET_SIZE_BYTES];
+	size_t pendingPacketSize_bytes;
+
+	uint16_t txCredits;
+	uint16_t rxCreditsOutstanding;
+
+	cxa_btle_stream_stats_t stats;
+
+	cxa_logger_t logger;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ */
+void cxa_btle_stream_init(cxa_btle_stream_t *const streamIn, int threadIdIn);
+
+
+/**
+ * @public
+ * Subscribes to the rx characteristic, then grants the peer its initial
+ * window through the tx characteristic (which also resolves the tx
+ * characteristic on backends that need it). The stream is open (and
+ * cb_onOpenedIn is called) once the initial window has been sent, or fails
+ * after CXA_BTLE_STREAM_OPEN_TIMEOUT_MS. The stream remains usable (buffers
+ * writes) while opening.
+ *
+ * @param[in] serviceUuidIn, txCharUuidIn, rxCharUuidIn must remain valid
+ * 		while the stream is open
+ */
+void cxa_btle_stream_open(cxa_btle_stream_t *const streamIn,
+						  cxa_btle_connection_t *const connIn,
+						  const char *const serviceUuidIn,
+						  const char *const txCharUuidIn,
+						  const char *const rxCharUuidIn,
+						  cxa_btle_stream_cb_onOpened_t cb_onOpenedIn,
+						  void* userVarIn);
+
+
+/**
+ * @public
+ * Discards any buffered data and detaches from the connection
+ */
+void cxa_btle_stream_close(cxa_btle_stream_t *const streamIn);
+
+
+/**
+ * @public
+ */
+bool cxa_btle_stream_isOpen(cxa_btle_stream_t *const streamIn);
+
+
+/**
+ * @public
+ */
+cxa_ioStream_t* cxa_btle_stream_getIoStream(cxa_btle_stream_t *const streamIn);
+
+
+/**
+ * @public
+ * @return the number of bytes that can currently be written without
+ * 		the ioStream write failing
+ */
+size_t cxa_btle_stream_getTxFreeSize_bytes(cxa_btle_stream_t *const streamIn);
+
+
+/**
+ * @public
+ */
+cxa_btle_stream_stats_t* cxa_btle_stream_getStats(cxa_btle_stream_t *const streamIn);
+
+
+/**
+ * @public
+ */
+void cxa_btle_stream_resetStats(cxa_btle_stream_t *const streamIn);
+
+
+#endif
@@ -30,6 +30,10 @@
 	#define CXA_SILABSBGAPI_BTLE_CENTRAL_MAXNUM_CONNS						2
 #endif
 
+#ifndef CXA_SILABSBGAPI_BTLE_CENTRAL_MAXNUM_CONN_HANDLES
+	#define CXA_SILABSBGAPI_BTLE_CENTRAL_MAXNUM_CONN_HANDLES				8
+#endif
+
 
 // ******** global type definitions *********
 /**
@@ -50,12 +54,14 @@ struct cxa_siLabsBgApi_btle_central
 	bool isConnectionInProgress;
 
 	cxa_siLabsBgApi_btle_connection_t conns[CXA_SILABSBGAPI_BTLE_CENTRAL_MAXNUM_CONNS];
+	cxa_siLabsBgApi_btle_connection_t* connsByHandle[CXA_SILABSBGAPI_BTLE_CENTRAL_MAXNUM_CONN_HANDLES];
 };
 
 
 // ******** global function prototypes ********
 /**
  * @protected
+ * Registers with ::cxa_siLabsBgApi_eventDispatcher (must be initialized first)
  */
 void cxa_siLabsBgApi_btle_central_init(cxa_siLabsBgApi_btle_central_t *const btlecIn, int threadIdIn);
 
@@ -65,12 +71,4 @@ void cxa_siLabsBgApi_btle_central_init(cxa_siLabsBgApi_btle_central_t *const btl
  */
 bool cxa_siLabsBgApi_btle_central_setConnectionInterval(cxa_siLabsBgApi_btle_central_t *const btlecIn, cxa_eui48_t *const targetConnectionAddressIn, uint16_t connectionInterval_msIn);
 
-
-/**
- * @protected
- *
- * @return true if this event was handled
- */
-bool cxa_siLabsBgApi_btle_central_handleBgEvent(cxa_siLabsBgApi_btle_central_t *const btlecIn, struct gecko_cmd_packet *evt);
-
 #endif
@@ -41,6 +41,10 @@
 	#define CXA_SILABSBGAPI_BTLE_CONNECTION_BUFFER_SIZE_BYTES					128
 #endif
 
+#ifndef CXA_SILABSBGAPI_BTLE_CONNECTION_MAX_ATT_MTU
+	#define CXA_SILABSBGAPI_BTLE_CONNECTION_MAX_ATT_MTU							247
+#endif
+
 
 // ******** global type definitions *********
 /**
@@ -57,6 +61,7 @@ typedef enum
 	CXA_SILABSBGAPI_PROCTYPE_NONE,
 	CXA_SILABSBGAPI_PROCTYPE_READ,
 	CXA_SILABSBGAPI_PROCTYPE_WRITE,
+	CXA_SILABSBGAPI_PROCTYPE_RESOLVE,
 	CXA_SILABSBGAPI_PROCTYPE_NOTI_INDI_CHANGE
 }cxa_siLabsBgApi_btle_connection_procType_t;
 
@@ -130,6 +135,9 @@ void cxa_siLabsBgApi_btle_connection_handleEvent_closed(cxa_siLabsBgApi_btle_con
 void cxa_siLabsBgApi_btle_connection_handleEvent_serviceResolved(cxa_siLabsBgApi_btle_connection_t *const connIn, cxa_btle_uuid_t *const uuidIn, uint32_t handleIn);
 void cxa_siLabsBgApi_btle_connection_handleEvent_characteristicResolved(cxa_siLabsBgApi_btle_connection_t *const connIn, cxa_btle_uuid_t *const uuidIn, uint16_t handleIn);
 void cxa_siLabsBgApi_btle_connection_handleEvent_characteristicValueUpdated(cxa_siLabsBgApi_btle_connection_t *const connIn, uint16_t handleIn, enum gatt_att_opcode opcodeIn, uint8_t *const dataIn, size_t dataLen_bytesIn);
+void cxa_siLabsBgApi_btle_connection_handleEvent_mtuExchanged(cxa_siLabsBgApi_btle_connection_t *const connIn, uint16_t mtuIn);
+void cxa_siLabsBgApi_btle_connection_handleEvent_parametersChanged(cxa_siLabsBgApi_btle_connection_t *const connIn, uint16_t interval_1250usIn, uint16_t latencyIn, uint16_t timeout_10msIn, uint16_t txSize_bytesIn);
+void cxa_siLabsBgApi_btle_connection_handleEvent_phyChanged(cxa_siLabsBgApi_btle_connection_t *const connIn, uint8_t phyIn);
 void cxa_siLabsBgApi_btle_connection_handleEvent_procedureComplete(cxa_siLabsBgApi_btle_connection_t *const connIn, uint16_t resultCodeIn);
 
 #endif
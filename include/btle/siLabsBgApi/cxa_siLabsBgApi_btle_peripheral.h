@@ -89,12 +89,4 @@ void cxa_siLabsBgApi_btle_peripheral_registerHandle(cxa_siLabsBgApi_btle_periphe
 													uint16_t handleIn);
 
 
-/**
- * @protected
- *
- * @return true if this event was handled
- */
-bool cxa_siLabsBgApi_btle_peripheral_handleBgEvent(cxa_siLabsBgApi_btle_peripheral_t *const btlepIn, struct gecko_cmd_packet *evt);
-
-
 #endif
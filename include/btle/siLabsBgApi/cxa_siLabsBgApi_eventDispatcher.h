@@ -0,0 +1,80 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_SILABSBGAPI_EVENTDISPATCHER_H_
+#define CXA_SILABSBGAPI_EVENTDISPATCHER_H_
+
+
+/**
+ * @file
+ * Table-driven dispatch of BGAPI events. The class and method of each
+ * event are decoded once and used to index directly into a static table
+ * of registered handlers, so the cost of dispatch does not depend on how
+ * many subsystems are listening. Events are passed by reference (pointing
+ * into the BGLib receive buffer) and must not be retained past the call.
+ *
+ * Multiple handlers may be registered for the same event. They are called
+ * in registration order until one of them returns true.
+ */
+
+
+// ******** includes ********
+#include <cxa_config.h>
+#if defined(CXA_SILABSBGAPI_MODE_SOC) || defined(CXA_SILABSBGAPI_MODE_SOC_HIGH_POWER)
+#include "bg_types.h"
+#include "native_gecko.h"
+#include "infrastructure.h"
+#else
+#include <gecko_bglib.h>
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_SILABSBGAPI_EVENTDISPATCHER_MAXNUM_HANDLERS
+	#define CXA_SILABSBGAPI_EVENTDISPATCHER_MAXNUM_HANDLERS				24
+#endif
+
+#ifndef CXA_SILABSBGAPI_EVENTDISPATCHER_MAXNUM_CLASSES
+	#define CXA_SILABSBGAPI_EVENTDISPATCHER_MAXNUM_CLASSES				8
+#endif
+
+#define CXA_SILABSBGAPI_EVENTDISPATCHER_MAX_CLASS_ID					0x7F
+#define CXA_SILABSBGAPI_EVENTDISPATCHER_MAX_METHOD_ID					0x0F
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @return true if this event was handled (stops further dispatch)
+ */
+typedef bool (*cxa_siLabsBgApi_eventDispatcher_cb_onEvent_t)(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+
+
+// ******** global function prototypes ********
+/**
+ * @protected
+ */
+void cxa_siLabsBgApi_eventDispatcher_init(void);
+
+
+/**
+ * @protected
+ * @param[in] evtIdIn the BGAPI event id (eg. gecko_evt_le_connection_opened_id)
+ */
+void cxa_siLabsBgApi_eventDispatcher_addHandler(uint32_t evtIdIn, cxa_siLabsBgApi_eventDispatcher_cb_onEvent_t cbIn, void* userVarIn);
+
+
+/**
+ * @protected
+ * @return true if the event was handled by a registered handler
+ */
+bool cxa_siLabsBgApi_eventDispatcher_dispatch(struct gecko_cmd_packet *const evtIn);
+
+
+#endif
@@ -58,6 +58,9 @@
 
 
 // ******** global macro definitions ********
+#define CXA_ARRAY_HASHINDEX_EMPTY									UINT16_MAX
+
+
 /**
  * @public
  * @brief Shortcut to initialize an array with a buffer of an explicit data type
@@ -106,6 +109,44 @@
 																    (varNameIn)++)
 
 
+/**
+ * @public
+ * @brief Like ::cxa_array_iterate, but computes the end of the array once
+ * (for hot loops). Elements must NOT be appended/inserted/removed during
+ * the loop.
+ *
+ * @param[in] arrIn pointer to the pre-initialized array
+ * @param[in] varNameIn name of the variable which will be initialized
+ * 		by the loop (a pointer to the current element)
+ * @param[in] elemTypeIn the base datatype of each element (not their pointer)
+ */
+#define cxa_array_iterate_unchecked(arrIn, varNameIn, elemTypeIn)	for(elemTypeIn *(varNameIn) = ((elemTypeIn*)((arrIn)->bufferLoc)), *const varNameIn##_end = (varNameIn) + (arrIn)->insertIndex;	\
+																	(varNameIn) < varNameIn##_end;	\
+																	(varNameIn)++)
+
+
+/**
+ * @public
+ * @brief Returns a pointer to the element at the given index without any
+ * checks (for hot loops where the index is already known to be valid)
+ */
+#define cxa_array_get_unchecked(arrIn, indexIn, elemTypeIn)			(&(((elemTypeIn*)((arrIn)->bufferLoc))[(indexIn)]))
+
+
+/**
+ * @public
+ * @brief Shortcut to initialize a hash index with a slots buffer of an
+ * explicit size
+ *
+ * @code
+ * uint16_t myIndex_slots[32];				// power of 2, larger than the array
+ * cxa_array_hashIndex_initStd(&myIndex, &myArray, myIndex_slots, getKeyCb, hashCb, compareCb);
+ * @endcode
+ */
+#define cxa_array_hashIndex_initStd(indexIn, arrIn, slotsIn, cb_getKeyIn, cb_hashIn, cb_compareIn)		\
+																	cxa_array_hashIndex_init((indexIn), (arrIn), (slotsIn), (sizeof(slotsIn)/sizeof(*(slotsIn))), (cb_getKeyIn), (cb_hashIn), (cb_compareIn))
+
+
 // ******** global type definitions *********
 /**
  * @public
@@ -127,6 +168,55 @@ struct cxa_array
 };
 
 
+/**
+ * @public
+ * @brief Compares a key against an element of the array (like the comparator
+ * for bsearch). For the sorted functions, the key passed when inserting is
+ * the new element itself.
+ *
+ * @return <0 if the key sorts before the element, 0 if they are equal, >0 if
+ * 		the key sorts after the element
+ */
+typedef int (*cxa_array_compareCb_t)(const void *const keyIn, const void *const elemIn);
+
+
+/**
+ * @public
+ * @brief Returns a pointer to the key of the given element (eg. its name or id)
+ */
+typedef const void* (*cxa_array_getKeyCb_t)(const void *const elemIn);
+
+
+/**
+ * @public
+ * @brief Hashes a key (see ::cxa_array_hashIndex_hashBytes for a reasonable default)
+ */
+typedef uint32_t (*cxa_array_hashCb_t)(const void *const keyIn);
+
+
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_array_hashIndex_t object
+ */
+typedef struct cxa_array_hashIndex cxa_array_hashIndex_t;
+
+
+/**
+ * @private
+ */
+struct cxa_array_hashIndex
+{
+	cxa_array_t* arr;
+
+	uint16_t* slots;				///< element index, or CXA_ARRAY_HASHINDEX_EMPTY
+	size_t numSlots;
+
+	cxa_array_getKeyCb_t cb_getKey;
+	cxa_array_hashCb_t cb_hash;
+	cxa_array_compareCb_t cb_compare;
+};
+
+
 // ******** global function prototypes ********
 /**
  * @public
@@ -350,4 +440,104 @@ bool cxa_array_isEmpty(cxa_array_t *const arrIn);
 void cxa_array_clear(cxa_array_t *const arrIn);
 
 
+/**
+ * @public
+ * @brief Inserts an element into an array that is kept sorted by the given
+ * comparator (after any elements that compare equal to it)
+ *
+ * @param[in] arrIn pointer to the pre-initialized (and sorted) cxa_array_t object
+ * @param[in] itemLocIn pointer to the element which will be copied into the array
+ * @param[in] cb_compareIn comparator (called with itemLocIn as the key)
+ *
+ * @return true on successful insertion, false if the array is full
+ */
+bool cxa_array_insert_sorted(cxa_array_t *const arrIn, void *const itemLocIn, cxa_array_compareCb_t cb_compareIn);
+
+
+/**
+ * @public
+ * @brief Binary search for the index of the first element that does not sort
+ * before the given key
+ *
+ * @param[in] arrIn pointer to the pre-initialized (and sorted) cxa_array_t object
+ *
+ * @return the index of the first element >= keyIn, or ::cxa_array_getSize_elems
+ * 		if all elements sort before keyIn
+ */
+size_t cxa_array_getLowerBound_sorted(cxa_array_t *const arrIn, const void *const keyIn, cxa_array_compareCb_t cb_compareIn);
+
+
+/**
+ * @public
+ * @brief Binary search for an element matching the given key
+ *
+ * @param[in] arrIn pointer to the pre-initialized (and sorted) cxa_array_t object
+ *
+ * @return pointer to the (first) matching element, or NULL if not found
+ */
+void* cxa_array_find_sorted(cxa_array_t *const arrIn, const void *const keyIn, cxa_array_compareCb_t cb_compareIn);
+
+
+/**
+ * @public
+ * @brief Initializes an open-addressing hash index over the existing elements
+ * of an array (which does not need to be sorted). The array itself is not
+ * modified: the index only stores element indices in the given slots buffer.
+ *
+ * The index must be rebuilt (::cxa_array_hashIndex_rebuild) after the array
+ * is modified other than through ::cxa_array_hashIndex_append.
+ *
+ * @param[in] slotsIn buffer to hold the index
+ * @param[in] numSlotsIn number of elements in slotsIn. Must be a power of 2
+ * 		and larger than the maximum size of the array (2x is a good choice)
+ * @param[in] cb_getKeyIn returns the key of an element
+ * @param[in] cb_hashIn hashes a key
+ * @param[in] cb_compareIn compares a key with an element (only equality matters)
+ */
+void cxa_array_hashIndex_init(cxa_array_hashIndex_t *const indexIn, cxa_array_t *const arrIn, uint16_t *const slotsIn, size_t numSlotsIn,
+							  cxa_array_getKeyCb_t cb_getKeyIn, cxa_array_hashCb_t cb_hashIn, cxa_array_compareCb_t cb_compareIn);
+
+
+/**
+ * @public
+ * @brief Re-indexes every element of the array
+ */
+void cxa_array_hashIndex_rebuild(cxa_array_hashIndex_t *const indexIn);
+
+
+/**
+ * @public
+ * @brief Appends an element to the indexed array and adds it to the index
+ *
+ * @return true on successful append, false if the array is full
+ */
+bool cxa_array_hashIndex_append(cxa_array_hashIndex_t *const indexIn, void *const itemLocIn);
+
+
+/**
+ * @public
+ * @brief Removes the given element from the indexed array (see ::cxa_array_remove)
+ * and rebuilds the index
+ *
+ * @return true if the element was removed
+ */
+bool cxa_array_hashIndex_remove(cxa_array_hashIndex_t *const indexIn, void *const itemLocIn);
+
+
+/**
+ * @public
+ * @brief Finds the element with the given key
+ *
+ * @return pointer to the element, or NULL if not found
+ */
+void* cxa_array_hashIndex_find(cxa_array_hashIndex_t *const indexIn, const void *const keyIn);
+
+
+/**
+ * @public
+ * @brief FNV-1a hash of the given bytes (for use in a ::cxa_array_hashCb_t)
+ */
+uint32_t cxa_array_hashIndex_hashBytes(const void *const bytesIn, size_t numBytesIn);
+
+
 #endif // CXA_ARRAY_H_
@@ -0,0 +1,256 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains an implementation of a statically allocated, fixed-max-length
+ * priority queue (d-ary heap) holding elements of a single datatype (and size). The
+ * heap itself does not hold any data, rather, it stores the data in an external buffer
+ * supplied during initialization. A second (uint16_t) buffer holds the heap ordering.
+ *
+ * Elements never move within the data buffer, so the pointer returned by
+ * ::cxa_fixedHeap_insert is a stable handle to the element for as long as it
+ * remains in the heap. This allows the element's key to be changed in place
+ * (eg. decrease-key when a timeout is moved up) followed by a call to
+ * ::cxa_fixedHeap_update.
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * typedef struct
+ * {
+ * 	uint32_t expiry_ms;
+ * 	...
+ * }timer_t;
+ *
+ * static int compareTimers(const void *const aIn, const void *const bIn)
+ * {
+ * 	uint32_t a = ((timer_t*)aIn)->expiry_ms;
+ * 	uint32_t b = ((timer_t*)bIn)->expiry_ms;
+ * 	return (a < b) ? -1 : (a > b);
+ * }
+ *
+ * cxa_fixedHeap_t myHeap;
+ * timer_t myHeap_buffer[16];											// where the data is actually stored
+ * uint16_t myHeap_indexBuffer[CXA_FIXEDHEAP_INDEXBUFFER_NUMELEMS(16)];	// where the ordering is stored
+ *
+ * cxa_fixedHeap_initStd(&myHeap, myHeap_buffer, myHeap_indexBuffer, compareTimers);
+ *
+ * ...
+ *
+ * // add a new timer, keeping a handle to it
+ * timer_t newTimer = { .expiry_ms = 1234 };
+ * timer_t* handle = (timer_t*)cxa_fixedHeap_insert(&myHeap, &newTimer);
+ *
+ * ...
+ *
+ * // move it earlier
+ * handle->expiry_ms = 1000;
+ * cxa_fixedHeap_update(&myHeap, handle);
+ *
+ * ...
+ *
+ * // service the soonest timer
+ * timer_t* soonest = (timer_t*)cxa_fixedHeap_peek(&myHeap);
+ * if( (soonest != NULL) && (soonest->expiry_ms <= now_ms) ) cxa_fixedHeap_pop(&myHeap, NULL);
+ * @endcode
+ */
+#ifndef CXA_FIXEDHEAP_H_
+#define CXA_FIXEDHEAP_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * Number of children per node (2 or 4). A 4-ary heap has half the depth of
+ * a binary heap (cheaper inserts and decrease-keys) but does more compares
+ * per level when popping.
+ */
+#ifndef CXA_FIXEDHEAP_ARITY
+	#define CXA_FIXEDHEAP_ARITY					2
+#endif
+
+
+/**
+ * @public
+ * @brief Number of uint16_t elements needed in the index buffer for a heap
+ * holding up to numElems elements
+ */
+#define CXA_FIXEDHEAP_INDEXBUFFER_NUMELEMS(numElems)		((numElems) * 2)
+
+
+/**
+ * @public
+ * @brief Shortcut to initialize a heap with buffers of an explicit data type
+ *
+ * @code
+ * cxa_fixedHeap_t myHeap;
+ * double myBuffer[100];
+ * uint16_t myIndexBuffer[CXA_FIXEDHEAP_INDEXBUFFER_NUMELEMS(100)];
+ *
+ * cxa_fixedHeap_initStd(&myHeap, myBuffer, myIndexBuffer, compareCb);
+ * // equivalent to
+ * cxa_fixedHeap_init(&myHeap, sizeof(*myBuffer), (void*)myBuffer, sizeof(myBuffer), myIndexBuffer, sizeof(myIndexBuffer), compareCb);
+ * @endcode
+ */
+#define cxa_fixedHeap_initStd(heapIn, bufferIn, indexBufferIn, cb_compareIn)		cxa_fixedHeap_init((heapIn), sizeof(*(bufferIn)), ((void*)(bufferIn)), sizeof(bufferIn), (indexBufferIn), sizeof(indexBufferIn), (cb_compareIn))
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_fixedHeap_t object
+ */
+typedef struct cxa_fixedHeap cxa_fixedHeap_t;
+
+
+/**
+ * @public
+ * @brief Determines the order of the heap
+ *
+ * @return <0 if element a should come out of the heap before element b,
+ * 		>0 if after, 0 if either order is fine
+ */
+typedef int (*cxa_fixedHeap_compareCb_t)(const void *const aIn, const void *const bIn);
+
+
+/**
+ * @private
+ */
+struct cxa_fixedHeap
+{
+	void *bufferLoc;
+	size_t datatypeSize_bytes;
+	size_t maxNumElements;
+
+	// slot indices: [0, numElements) is the heap, the remainder are free slots
+	uint16_t *heapOrder;
+	// inverse of heapOrder (position of each slot within heapOrder)
+	uint16_t *heapPositions;
+	size_t numElements;
+
+	cxa_fixedHeap_compareCb_t cb_compare;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the heap using the specified (empty) buffers
+ *
+ * @param[in] datatypeSize_bytesIn the size of each element (all elements MUST be the same size)
+ * @param[in] bufferLocIn buffer used to store the elements
+ * @param[in] bufferMaxSize_bytesIn size of bufferLocIn, in bytes
+ * @param[in] indexBufferIn buffer used to store the ordering. Must hold at least
+ * 		CXA_FIXEDHEAP_INDEXBUFFER_NUMELEMS(max number of elements) elements.
+ * @param[in] indexBufferSize_bytesIn size of indexBufferIn, in bytes
+ * @param[in] cb_compareIn determines the order of the heap
+ */
+void cxa_fixedHeap_init(cxa_fixedHeap_t *const heapIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+						uint16_t *const indexBufferIn, const size_t indexBufferSize_bytesIn, cxa_fixedHeap_compareCb_t cb_compareIn);
+
+
+/**
+ * @public
+ * @brief Copies the given element into the heap
+ *
+ * @return a stable handle (pointer) to the element within the heap's buffer,
+ * 		or NULL if the heap is full
+ */
+void* cxa_fixedHeap_insert(cxa_fixedHeap_t *const heapIn, void *const itemLocIn);
+
+
+/**
+ * @public
+ * @brief Returns the element that would be popped next (without removing it)
+ *
+ * @return pointer to the element, or NULL if the heap is empty
+ */
+void* cxa_fixedHeap_peek(cxa_fixedHeap_t *const heapIn);
+
+
+/**
+ * @public
+ * @brief Removes the element that comes first in the heap
+ *
+ * @param[out] itemOut (optional) location to which the element is copied
+ *
+ * @return true if an element was removed, false if the heap was empty
+ */
+bool cxa_fixedHeap_pop(cxa_fixedHeap_t *const heapIn, void *const itemOut);
+
+
+/**
+ * @public
+ * @brief Removes the given element (wherever it is in the heap)
+ *
+ * @param[in] handleIn handle returned by ::cxa_fixedHeap_insert
+ *
+ * @return true if the element was removed, false if it was not in the heap
+ */
+bool cxa_fixedHeap_remove(cxa_fixedHeap_t *const heapIn, void *const handleIn);
+
+
+/**
+ * @public
+ * @brief Restores the heap order after the key of the given element was changed
+ * in place (either direction)
+ *
+ * @param[in] handleIn handle returned by ::cxa_fixedHeap_insert
+ *
+ * @return true on success, false if the element is not in the heap
+ */
+bool cxa_fixedHeap_update(cxa_fixedHeap_t *const heapIn, void *const handleIn);
+
+
+/**
+ * @public
+ * @return the number of elements in the heap
+ */
+size_t cxa_fixedHeap_getSize_elems(cxa_fixedHeap_t *const heapIn);
+
+
+/**
+ * @public
+ * @return the maximum number of elements this heap can hold
+ */
+size_t cxa_fixedHeap_getMaxSize_elems(cxa_fixedHeap_t *const heapIn);
+
+
+/**
+ * @public
+ * @return true if the heap does not contain any elements
+ */
+bool cxa_fixedHeap_isEmpty(cxa_fixedHeap_t *const heapIn);
+
+
+/**
+ * @public
+ * @return true if the heap cannot hold any more elements
+ */
+bool cxa_fixedHeap_isFull(cxa_fixedHeap_t *const heapIn);
+
+
+/**
+ * @public
+ * @brief Discards all elements (all handles become invalid)
+ */
+void cxa_fixedHeap_clear(cxa_fixedHeap_t *const heapIn);
+
+
+#endif // CXA_FIXEDHEAP_H_
@@ -69,15 +69,22 @@ struct cxa_fixedByteBuffer_linkedField
 {
 	cxa_fixedByteBuffer_t* parent;
 
+	cxa_linkedField_t* root;
 	cxa_linkedField_t* prev;
 	cxa_linkedField_t* next;
 
-	size_t startIndex;
+	size_t startIndex;						///< absolute index within the parent (kept up-to-date as upstream fields change size)
+	size_t ordinal;							///< position within the chain (root is 0)
+	size_t fixedFieldsLen_bytes;			///< sum of the max lengths of all fixed-length fields up to (and including) this one
 
 	bool isFixedLength;
 	size_t maxFixedLength_bytes;
 
 	size_t currSize_bytes;
+
+	// only maintained by the root field
+	cxa_linkedField_t* tail;
+	size_t firstUnfilledFixedOrdinal;
 };
 
 
@@ -0,0 +1,203 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains lookup-table based hex and base64 (RFC 4648, standard
+ * alphabet) encoders and decoders. Each codec is available as a one-shot
+ * buffer-to-buffer function and as a stream object that accepts input in
+ * arbitrarily-sized pieces and writes its output directly into an ioStream or
+ * a fixedByteBuffer (eg. while a certificate is being received).
+ *
+ * Decoders accept upper and lower case hex and skip whitespace (so PEM-style
+ * line breaks are fine). Encoders emit upper case hex and padded base64.
+ *
+ * On hosts with SSSE3 or AArch64 NEON, hex encoding is vectorized 16 bytes at
+ * a time.
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_encodingUtils_stream_t b64;
+ * cxa_encodingUtils_stream_init_fbb(&b64, CXA_ENCODINGUTILS_TYPE_BASE64, false, &fbb_cert);
+ *
+ * // as each piece arrives
+ * if( !cxa_encodingUtils_stream_update(&b64, rxChunk, rxChunkLen_bytes) ) ...
+ *
+ * // once all pieces have arrived (flushes any partial quantum)
+ * if( !cxa_encodingUtils_stream_finish(&b64) ) ...
+ * @endcode
+ */
+#ifndef CXA_ENCODINGUTILS_H_
+#define CXA_ENCODINGUTILS_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cxa_fixedByteBuffer.h>
+#include <cxa_ioStream.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_ENCODINGUTILS_STREAM_BUFFERLEN_BYTES
+	#define CXA_ENCODINGUTILS_STREAM_BUFFERLEN_BYTES			64
+#endif
+
+#define CXA_ENCODINGUTILS_HEX_ENCODEDLEN(numBytes)				((numBytes) * 2)
+#define CXA_ENCODINGUTILS_BASE64_ENCODEDLEN(numBytes)			((((numBytes) + 2) / 3) * 4)
+#define CXA_ENCODINGUTILS_BASE64_MAXDECODEDLEN(numChars)		((((numChars) + 3) / 4) * 3)
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ */
+typedef enum
+{
+	CXA_ENCODINGUTILS_TYPE_HEX,
+	CXA_ENCODINGUTILS_TYPE_BASE64
+}cxa_encodingUtils_type_t;
+
+
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_encodingUtils_stream_t object
+ */
+typedef struct cxa_encodingUtils_stream cxa_encodingUtils_stream_t;
+
+
+/**
+ * @private
+ */
+struct cxa_encodingUtils_stream
+{
+	cxa_encodingUtils_type_t type;
+	bool isEncoder;
+
+	cxa_ioStream_t* ioStream;
+	cxa_fixedByteBuffer_t* fbb;
+
+	// partial quantum carried between updates
+	uint32_t accum;
+	uint8_t numAccum;
+	uint8_t numPadChars;
+
+	bool hasError;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * Encodes the given bytes as upper case hex
+ *
+ * @param hexOut buffer to receive CXA_ENCODINGUTILS_HEX_ENCODEDLEN(numBytesIn)
+ * 		characters (NOT null-terminated)
+ *
+ * @return the number of characters written
+ */
+size_t cxa_encodingUtils_hex_encode(const void *const bytesIn, size_t numBytesIn, char *const hexOut);
+
+
+/**
+ * @public
+ * Decodes the given hex characters (no whitespace allowed)
+ *
+ * @param numCharsIn must be even
+ * @param bytesOut buffer to receive numCharsIn / 2 bytes
+ *
+ * @return true on success, false if an odd number of characters or an invalid
+ * 		character was encountered
+ */
+bool cxa_encodingUtils_hex_decode(const char *const hexIn, size_t numCharsIn, uint8_t *const bytesOut);
+
+
+/**
+ * @public
+ * Writes the given bytes to the ioStream as upper case hex, optionally
+ * separating each byte (eg. ", " for memdumps). Output is written in chunks
+ * rather than a byte at a time.
+ *
+ * @param separatorIn string written between each byte, or NULL for none
+ *
+ * @return true on successful write
+ */
+bool cxa_encodingUtils_hex_writeToIoStream(cxa_ioStream_t *const ioStreamIn, const void *const bytesIn, size_t numBytesIn, const char *const separatorIn);
+
+
+/**
+ * @public
+ * Encodes the given bytes as padded base64
+ *
+ * @param charsOut buffer to receive CXA_ENCODINGUTILS_BASE64_ENCODEDLEN(numBytesIn)
+ * 		characters (NOT null-terminated)
+ *
+ * @return the number of characters written
+ */
+size_t cxa_encodingUtils_base64_encode(const void *const bytesIn, size_t numBytesIn, char *const charsOut);
+
+
+/**
+ * @public
+ * Decodes the given base64 characters (padding optional, whitespace skipped)
+ *
+ * @param bytesOut buffer to receive the decoded bytes
+ * @param maxNumBytesIn size of bytesOut (CXA_ENCODINGUTILS_BASE64_MAXDECODEDLEN(numCharsIn)
+ * 		is always enough)
+ * @param numBytesOut (optional) receives the number of decoded bytes
+ *
+ * @return true on success, false on malformed input or if bytesOut is too small
+ */
+bool cxa_encodingUtils_base64_decode(const char *const charsIn, size_t numCharsIn, uint8_t *const bytesOut, size_t maxNumBytesIn, size_t *const numBytesOut);
+
+
+/**
+ * @public
+ * Initializes a streaming encoder/decoder whose output is written to the given ioStream
+ *
+ * @param isEncoderIn true to encode bytes into characters, false to decode characters into bytes
+ */
+void cxa_encodingUtils_stream_init_ioStream(cxa_encodingUtils_stream_t *const streamIn, cxa_encodingUtils_type_t typeIn, bool isEncoderIn, cxa_ioStream_t *const ioStreamIn);
+
+
+/**
+ * @public
+ * Initializes a streaming encoder/decoder whose output is appended to the given fixedByteBuffer
+ *
+ * @param isEncoderIn true to encode bytes into characters, false to decode characters into bytes
+ */
+void cxa_encodingUtils_stream_init_fbb(cxa_encodingUtils_stream_t *const streamIn, cxa_encodingUtils_type_t typeIn, bool isEncoderIn, cxa_fixedByteBuffer_t *const fbbIn);
+
+
+/**
+ * @public
+ * Feeds the next piece of input through the stream. Pieces may be split anywhere
+ * (including mid-quantum).
+ *
+ * @return false if the input was malformed or the output could not be written.
+ * 		Once false is returned, all further calls also return false.
+ */
+bool cxa_encodingUtils_stream_update(cxa_encodingUtils_stream_t *const streamIn, const void *const dataIn, size_t numBytesIn);
+
+
+/**
+ * @public
+ * Flushes any partial quantum (writing base64 padding when encoding) and
+ * validates that the input was complete (when decoding)
+ *
+ * @return true if the entire stream was successfully encoded/decoded
+ */
+bool cxa_encodingUtils_stream_finish(cxa_encodingUtils_stream_t *const streamIn);
+
+
+#endif // CXA_ENCODINGUTILS_H_
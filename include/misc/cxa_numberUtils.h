@@ -30,14 +30,83 @@
 #define CXA_CLAMP_LOW(val, min)						((val) = CXA_MAX((val), (min)))
 #define CXA_CLAMP_LOW_HIGH(val, min, max)			((val) = CXA_CLAMP_HIGH(CXA_CLAMP_LOW((val), (min)), (max)))
 
+/**
+ * Size of the (const) lookup tables used by the software CRC implementations.
+ * They live in flash with the rest of .rodata (in program memory via PROGMEM on AVR):
+ * 8 - 256-entry tables (512 bytes for CRC-16, 1KB per CRC-32 variant)
+ * 4 - 16-entry tables (for small MCUs, roughly half the speed)
+ * 0 - no tables (bit-by-bit)
+ */
+#ifndef CXA_NUMBERUTILS_CRC_TABLE_BITS
+	#define CXA_NUMBERUTILS_CRC_TABLE_BITS				8
+#endif
+
+/**
+ * Set to 1 to process 8 bytes per step using tables generated in RAM on first
+ * use (~8KB per CRC). Enabled by default on hosted (POSIX) builds. CRC-32 / CRC-32C
+ * use the SSE4.2 / ARMv8 crc instructions instead when the compiler targets them.
+ *
+ * @note on POSIX the tables are generated under pthread_once, so the first CRC
+ * 		may be computed from any thread. Elsewhere generation is unsynchronized:
+ * 		compute one CRC before computing CRCs from multiple threads / interrupts
+ */
+#ifndef CXA_NUMBERUTILS_CRC_SLICE_BY_8
+	#if defined(__unix__) || defined(__APPLE__)
+		#define CXA_NUMBERUTILS_CRC_SLICE_BY_8			1
+	#else
+		#define CXA_NUMBERUTILS_CRC_SLICE_BY_8			0
+	#endif
+#endif
+
 
 // ******** global type definitions *********
 
 
 // ******** global function prototypes ********
-uint16_t cxa_numberUtils_crc16_oneShot(void* dataIn, size_t dataLen_bytesIn);
+/**
+ * @public
+ * @return the CRC-16/ARC of the given data
+ */
+uint16_t cxa_numberUtils_crc16_oneShot(const void* dataIn, size_t dataLen_bytesIn);
 
+/**
+ * @public
+ * Adds a single byte to a running CRC-16/ARC (start with 0)
+ */
 uint16_t cxa_numberUtils_crc16_step(uint16_t crcIn, uint8_t byteIn);
 
+/**
+ * @public
+ * Adds the given data to a running CRC-16/ARC (start with 0). Data can be
+ * supplied in arbitrary chunks, eg. as it streams in.
+ */
+uint16_t cxa_numberUtils_crc16_update(uint16_t crcIn, const void* dataIn, size_t dataLen_bytesIn);
+
+/**
+ * @public
+ * @return the CRC-32 (IEEE 802.3 / zlib) of the given data
+ */
+uint32_t cxa_numberUtils_crc32_oneShot(const void* dataIn, size_t dataLen_bytesIn);
+
+/**
+ * @public
+ * Adds the given data to a running CRC-32 (start with 0). The return value is
+ * always the finished CRC of all data so far, so
+ * `update(update(0, a), b) == oneShot(a + b)`
+ */
+uint32_t cxa_numberUtils_crc32_update(uint32_t crcIn, const void* dataIn, size_t dataLen_bytesIn);
+
+/**
+ * @public
+ * @return the CRC-32C (Castagnoli) of the given data
+ */
+uint32_t cxa_numberUtils_crc32c_oneShot(const void* dataIn, size_t dataLen_bytesIn);
+
+/**
+ * @public
+ * Adds the given data to a running CRC-32C (start with 0), see ::cxa_numberUtils_crc32_update
+ */
+uint32_t cxa_numberUtils_crc32c_update(uint32_t crcIn, const void* dataIn, size_t dataLen_bytesIn);
+
 
 #endif // CXA_NUMBERUTILS_H_
@@ -31,6 +31,9 @@
 	#define CXA_LINE_ENDING			"\r\n"
 #endif
 
+// enough for any of the cxa_stringUtils_formatX functions (eg. "-2.147483648" plus null term)
+#define CXA_STRINGUTILS_NUMBERSTRING_MAXLEN_BYTES		13
+
 
 // ******** global type definitions *********
 typedef enum
@@ -56,6 +59,13 @@ typedef struct
 }cxa_stringUtils_parseResult_t;
 
 
+typedef struct
+{
+	const char* str;			///< points into the split string (not null-terminated)
+	size_t len_bytes;
+}cxa_stringUtils_token_t;
+
+
 // ******** global function prototypes ********
 bool cxa_stringUtils_startsWith(const char* targetStringIn, const char* prefixStringIn);
 bool cxa_stringUtils_startsWith_withLengths(const char* targetStringIn, size_t targetStringLen_bytesIn, const char* prefixStringIn, size_t prefixStringLen_bytesIn);
@@ -87,6 +97,20 @@ size_t cxa_stringUtils_countOccurences(const char* targetStringIn, const char* e
 size_t cxa_stringUtils_countOccurences_withLengths(const char* targetStringIn, size_t targetStringLen_bytesIn, const char* elementIn, size_t elementStringLen_bytesIn);
 ssize_t cxa_stringUtils_indexOfFirstOccurence_withLengths(const char* targetStringIn, size_t targetStringLen_bytesIn, const char* elementIn, size_t elementLen_bytesIn);
 
+/**
+ * Splits the target string at each separator in a single pass (eg. an MQTT topic
+ * into its levels). Empty tokens are kept (eg. "a//b" yields "a", "", "b") and the
+ * target string is not modified.
+ *
+ * @param tokensOut array to receive the tokens
+ * @param maxNumTokensIn number of elements in tokensOut
+ *
+ * @return the number of tokens in the target string. If this is larger than
+ * 		maxNumTokensIn, only the first maxNumTokensIn tokens were stored.
+ */
+size_t cxa_stringUtils_split_withLengths(const char* targetStringIn, size_t targetStringLen_bytesIn, char separatorIn,
+										 cxa_stringUtils_token_t *const tokensOut, size_t maxNumTokensIn);
+
 char* cxa_stringUtils_getLastCharacters(const char* targetStringIn, size_t numCharsIn);
 
 bool cxa_stringUtils_replaceFirstOccurence(const char *targetStringIn, const char *stringToReplaceIn, const char *replacementStringIn);
@@ -102,6 +126,60 @@ bool cxa_stringUtils_hexStringToBytes(const char *const hexStringIn, size_t numB
 bool cxa_stringUtils_ipStringToUint32(const char *const ipStringIn, uint32_t *const ipBytesOut);
 
 bool cxa_stringUtils_parseString(char *const strIn, cxa_stringUtils_parseResult_t* parseResultOut);
+
+/**
+ * Formats a number without going through printf. The output is always
+ * null-terminated (if maxLen_bytesIn > 0).
+ *
+ * @param maxLen_bytesIn size of strOut (CXA_STRINGUTILS_NUMBERSTRING_MAXLEN_BYTES
+ * 		always fits)
+ *
+ * @return the number of characters written (excluding the null term), or 0
+ * 		if the number didn't fit (strOut will be empty)
+ */
+size_t cxa_stringUtils_formatUint32(uint32_t valIn, char *const strOut, size_t maxLen_bytesIn);
+size_t cxa_stringUtils_formatInt32(int32_t valIn, char *const strOut, size_t maxLen_bytesIn);
+
+/**
+ * @param minNumDigitsIn output is zero-padded to at least this many digits (0-8)
+ */
+size_t cxa_stringUtils_formatHex(uint32_t valIn, uint8_t minNumDigitsIn, char *const strOut, size_t maxLen_bytesIn);
+
+/**
+ * Formats a fixed-point number (eg. 1234 with 2 fractional digits is "12.34")
+ *
+ * @param numFracDigitsIn number of (decimal) fractional digits in valIn (0-9)
+ */
+size_t cxa_stringUtils_formatFixed(int32_t valIn, uint8_t numFracDigitsIn, char *const strOut, size_t maxLen_bytesIn);
+
+/**
+ * Parses a number without going through strtol/strtod. The entire string (or
+ * the first strLen_bytesIn bytes for the _withLength variants) must be the
+ * number, with no surrounding whitespace.
+ *
+ * @return true on success, false if the string isn't a number or it overflows
+ * 		the result type (valOut is left untouched)
+ */
+bool cxa_stringUtils_parseUint32(const char *const strIn, uint32_t *const valOut);
+bool cxa_stringUtils_parseUint32_withLength(const char *const strIn, size_t strLen_bytesIn, uint32_t *const valOut);
+bool cxa_stringUtils_parseInt32(const char *const strIn, int32_t *const valOut);
+bool cxa_stringUtils_parseInt32_withLength(const char *const strIn, size_t strLen_bytesIn, int32_t *const valOut);
+
+/**
+ * Accepts an optional "0x" / "0X" prefix and upper or lower case digits
+ */
+bool cxa_stringUtils_parseHex(const char *const strIn, uint32_t *const valOut);
+bool cxa_stringUtils_parseHex_withLength(const char *const strIn, size_t strLen_bytesIn, uint32_t *const valOut);
+
+/**
+ * Parses a decimal string into a fixed-point number (eg. "12.34" with 2
+ * fractional digits is 1234). Fractional digits beyond numFracDigitsIn are
+ * truncated.
+ *
+ * @param numFracDigitsIn number of (decimal) fractional digits in valOut (0-9)
+ */
+bool cxa_stringUtils_parseFixed(const char *const strIn, uint8_t numFracDigitsIn, int32_t *const valOut);
+bool cxa_stringUtils_parseFixed_withLength(const char *const strIn, size_t strLen_bytesIn, uint8_t numFracDigitsIn, int32_t *const valOut);
 const char* cxa_stringUtils_getStringForDataType(cxa_stringUtils_dataType_t dataTypeIn);
 
 
@@ -14,6 +14,7 @@
 #include <cxa_fixedByteBuffer.h>
 #include <cxa_logger_header.h>
 #include <cxa_mqtt_client.h>
+#include <cxa_runLoop.h>
 #include <cxa_timeDiff.h>
 #include <cxa_config.h>
 
@@ -147,6 +148,7 @@ struct cxa_mqtt_rpc_node
 
 	cxa_array_t outstandingRequests;
 	cxa_mqtt_rpc_node_outstandingRequest_t outstandingRequests_raw[CXA_MQTT_RPCNODE_MAXNUM_OUTSTANDING_REQS];
+	cxa_runLoop_entryHandle_t runLoopEntry;
 
 	cxa_mqtt_rpc_node_scm_handleMessage_upstream_t scm_handleMessage_upstream;
 	cxa_mqtt_rpc_node_scm_handleMessage_downstream_t scm_handleMessage_downstream;
@@ -0,0 +1,177 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_NETWORK_DNSCACHE_H_
+#define CXA_NETWORK_DNSCACHE_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cxa_timeDiff.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_NETWORK_DNSCACHE_MAXNUM_ENTRIES
+	#define CXA_NETWORK_DNSCACHE_MAXNUM_ENTRIES					4
+#endif
+
+#ifndef CXA_NETWORK_DNSCACHE_MAXHOSTNAMELEN_BYTES
+	#define CXA_NETWORK_DNSCACHE_MAXHOSTNAMELEN_BYTES			64
+#endif
+
+#ifndef CXA_NETWORK_DNSCACHE_MAXADDRESSLEN_BYTES
+	#define CXA_NETWORK_DNSCACHE_MAXADDRESSLEN_BYTES			45		// textual IPv6 (with embedded IPv4)
+#endif
+
+#ifndef CXA_NETWORK_DNSCACHE_DEFAULT_TTL_S
+	#define CXA_NETWORK_DNSCACHE_DEFAULT_TTL_S					300
+#endif
+
+#ifndef CXA_NETWORK_DNSCACHE_MAX_TTL_S
+	#define CXA_NETWORK_DNSCACHE_MAX_TTL_S						3600
+#endif
+
+#ifndef CXA_NETWORK_DNSCACHE_NEGATIVE_TTL_S
+	#define CXA_NETWORK_DNSCACHE_NEGATIVE_TTL_S					30
+#endif
+
+#ifndef CXA_NETWORK_DNSCACHE_RESOLVE_TIMEOUT_MS
+	#define CXA_NETWORK_DNSCACHE_RESOLVE_TIMEOUT_MS				15000
+#endif
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ */
+typedef enum
+{
+	CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED,			///< address was copied out
+	CXA_NETWORK_DNSCACHE_LOOKUP_PENDING,			///< resolution is in progress, try again later
+	CXA_NETWORK_DNSCACHE_LOOKUP_FAILED				///< host could not be resolved (recently)
+}cxa_network_dnsCache_lookupResult_t;
+
+
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_network_dnsCache_entry_t object
+ */
+typedef struct cxa_network_dnsCache_entry cxa_network_dnsCache_entry_t;
+
+
+/**
+ * @protected
+ * Implemented by the network backend to start a non-blocking resolution of
+ * the given host. The backend must eventually call
+ * cxa_network_dnsCache_entry_setResult (from any context) for this entry,
+ * passing the same host name.
+ *
+ * @return false if the resolution could not be started
+ */
+typedef bool (*cxa_network_dnsCache_scm_startResolve_t)(cxa_network_dnsCache_entry_t *const entryIn, const char *const hostNameIn);
+
+
+/**
+ * @private
+ */
+typedef enum
+{
+	CXA_NETWORK_DNSCACHE_ENTRYSTATE_EMPTY,
+	CXA_NETWORK_DNSCACHE_ENTRYSTATE_QUEUED,
+	CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVING,
+	CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVED,
+	CXA_NETWORK_DNSCACHE_ENTRYSTATE_FAILED
+}cxa_network_dnsCache_entryState_t;
+
+
+/**
+ * @private
+ */
+struct cxa_network_dnsCache_entry
+{
+	cxa_network_dnsCache_entryState_t state;
+	bool isPinned;
+
+	char hostName[CXA_NETWORK_DNSCACHE_MAXHOSTNAMELEN_BYTES+1];
+	char address[CXA_NETWORK_DNSCACHE_MAXADDRESSLEN_BYTES+1];
+	uint32_t ttl_s;
+
+	cxa_timeDiff_t td_stateChange;
+	cxa_timeDiff_t td_lastUsed;
+
+	// written by the backend (possibly from another context)...guarded by
+	// cxa_criticalSection along with any change into or out of RESOLVING
+	bool isResultReady;
+	bool wasResultSuccessful;
+	uint32_t resultTtl_s;
+	char resultAddress[CXA_NETWORK_DNSCACHE_MAXADDRESSLEN_BYTES+1];
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @protected
+ * Called once by the network factory. Resolutions are started (and results
+ * collected) by the runLoop of the given thread.
+ */
+void cxa_network_dnsCache_init(int threadIdIn, cxa_network_dnsCache_scm_startResolve_t scm_startResolveIn);
+
+
+/**
+ * @public
+ * @return true if the network backend has initialized the cache
+ */
+bool cxa_network_dnsCache_isInit(void);
+
+
+/**
+ * @public
+ * Looks up the address for the given host. Never blocks: on a cache miss the
+ * resolution is queued and CXA_NETWORK_DNSCACHE_LOOKUP_PENDING is returned.
+ * Numeric addresses are returned as-is without touching the cache.
+ *
+ * @param addressOut buffer to receive the textual address
+ * @param maxAddressLen_bytesIn size of addressOut (including terminator)
+ */
+cxa_network_dnsCache_lookupResult_t cxa_network_dnsCache_lookup(const char *const hostNameIn, char *const addressOut, size_t maxAddressLen_bytesIn);
+
+
+/**
+ * @public
+ * Queues a resolution for the given host and keeps it fresh (it is refreshed
+ * when its TTL expires and is never evicted). Intended to be called at
+ * startup for hosts we know we'll connect to.
+ *
+ * @return false if there is no room in the cache
+ */
+bool cxa_network_dnsCache_preResolve(const char *const hostNameIn);
+
+
+/**
+ * @public
+ * Drops any cached result for the given host (eg. after a connect to the
+ * cached address failed)
+ */
+void cxa_network_dnsCache_invalidate(const char *const hostNameIn);
+
+
+/**
+ * @protected
+ * Called by the network backend once a resolution completes. Results that
+ * arrive late (eg. after the resolution timed out and the entry was reused
+ * for another host) are discarded.
+ *
+ * @param hostNameIn the host that was resolved
+ * @param addressIn the textual address, or NULL if the resolution failed
+ * @param ttl_sIn the record's TTL, or 0 to use CXA_NETWORK_DNSCACHE_DEFAULT_TTL_S
+ */
+void cxa_network_dnsCache_entry_setResult(cxa_network_dnsCache_entry_t *const entryIn, const char *const hostNameIn, const char *const addressIn, uint32_t ttl_sIn);
+
+
+#endif // CXA_NETWORK_DNSCACHE_H_
@@ -26,4 +26,12 @@ void cxa_network_factory_freeTcpClient(cxa_network_tcpClient_t *const clientIn);
 cxa_network_tcpServer_t* cxa_network_factory_reserveTcpServer(int threadIdIn);
 void cxa_network_factory_freeTcpServer(cxa_network_tcpServer_t *const serverIn);
 
+/**
+ * Starts (non-blocking) resolution of a host we expect to connect to later
+ * and keeps the result fresh in the DNS cache
+ *
+ * @return false if the backend cannot resolve host names or the cache is full
+ */
+bool cxa_network_factory_preResolveHost(int threadIdIn, const char *const hostNameIn);
+
 #endif // CXA_NETWORK_FACTORY_H_
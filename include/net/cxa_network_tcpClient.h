@@ -109,6 +109,14 @@ struct cxa_network_tcpClient
 
 	cxa_timeDiff_t td_genPurp;
 
+	struct
+	{
+		cxa_timeDiff_t td_connect;
+		uint32_t tcpConnect_ms;
+		uint32_t tlsHandshake_ms;
+		bool isTlsHandshaking;
+	}connectTiming;
+
 	cxa_array_t listeners;
 	cxa_network_tcpClient_listenerEntry_t listeners_raw[CXA_NETWORK_TCPCLIENT_MAXNUM_LISTENERS];
 
@@ -170,12 +178,33 @@ bool cxa_network_tcpClient_isConnected(cxa_network_tcpClient_t *const netClientI
 cxa_ioStream_t* cxa_network_tcpClient_getIoStream(cxa_network_tcpClient_t *const netClientIn);
 
 
+/**
+ * @public
+ * Returns the time taken by the most recent connection attempt, split into
+ * establishing the TCP connection and performing the TLS handshake. If the
+ * underlying client does not report the start of the TLS handshake, the
+ * entire connection time is reported as tcpConnect_msOut.
+ *
+ * @param[out] tcpConnect_msOut optional
+ * @param[out] tlsHandshake_msOut optional, 0 for non-TLS connections
+ */
+void cxa_network_tcpClient_getConnectTiming(cxa_network_tcpClient_t *const netClientIn, uint32_t *const tcpConnect_msOut, uint32_t *const tlsHandshake_msOut);
+
+
 /**
  * @protected
  */
 void cxa_network_tcpClient_notify_connect(cxa_network_tcpClient_t *const netClientIn);
 
 
+/**
+ * @protected
+ * Called by subclasses once the TCP connection is established, just before
+ * starting the TLS handshake (used for connection timing only)
+ */
+void cxa_network_tcpClient_notify_tlsHandshakeStarting(cxa_network_tcpClient_t *const netClientIn);
+
+
 /**
  * @protected
  */
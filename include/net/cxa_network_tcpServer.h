@@ -52,6 +52,22 @@ typedef bool (*cxa_network_tcpServer_scm_listen_t)(cxa_network_tcpServer_t *cons
 typedef void (*cxa_network_tcpServer_scm_stopListening_t)(cxa_network_tcpServer_t *const superIn);
 
 
+/**
+ * @public
+ * Connection statistics, useful for sizing the number of connected clients
+ */
+typedef struct
+{
+	uint32_t numAccepted;
+	uint32_t numDisconnected;
+	size_t numConnectedClients;
+	size_t maxNumConnectedClients;
+
+	uint32_t numAcceptPauses;			///< times accepting stopped because all clients were in use
+	uint32_t maxAcceptPause_ms;			///< upper bound on how long a pending connection waited to be accepted
+}cxa_network_tcpServer_stats_t;
+
+
 /**
  * @private
  */
@@ -75,6 +91,10 @@ struct cxa_network_tcpServer
 	cxa_array_t listeners;
 	cxa_network_tcpServer_listenerEntry_t listeners_raw[CXA_NETWORK_TCPSERVER_MAXNUM_LISTENERS];
 
+	cxa_network_tcpServer_stats_t stats;
+	bool isAcceptPaused;
+	cxa_timeDiff_t td_acceptPaused;
+
 	cxa_logger_t logger;
 };
 
@@ -107,10 +127,38 @@ bool cxa_network_tcpServer_listen(cxa_network_tcpServer_t *const tcpServerIn, ui
 void cxa_network_tcpServer_stopListening(cxa_network_tcpServer_t *const tcpServerIn);
 
 
+/**
+ * @public
+ */
+cxa_network_tcpServer_stats_t* cxa_network_tcpServer_getStats(cxa_network_tcpServer_t *const tcpServerIn);
+
+
+/**
+ * @public
+ * Resets all statistics except the number of currently connected clients
+ */
+void cxa_network_tcpServer_resetStats(cxa_network_tcpServer_t *const tcpServerIn);
+
+
 /**
  * @protected
  */
 void cxa_network_tcpServer_notifyConnect(cxa_network_tcpServer_t *const tcpServerIn, cxa_network_tcpServer_connectedClient_t* clientIn);
 
 
+/**
+ * @protected
+ * Called by subclasses when a connected client is unbound and available for reuse
+ */
+void cxa_network_tcpServer_notifyClientReleased(cxa_network_tcpServer_t *const tcpServerIn);
+
+
+/**
+ * @protected
+ * Called by subclasses when they stop (or resume) accepting connections
+ * because all connected clients are in use
+ */
+void cxa_network_tcpServer_notifyAcceptPaused(cxa_network_tcpServer_t *const tcpServerIn, bool isPausedIn);
+
+
 #endif // CXA_NETWORK_TCPSERVER_H_
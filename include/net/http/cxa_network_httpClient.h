@@ -16,7 +16,6 @@
 #include <cxa_ioStream_nullablePassthrough.h>
 #include <cxa_logger_header.h>
 #include <cxa_network_tcpClient.h>
-#include <cxa_protocolParser_crlf.h>
 #include <cxa_stateMachine.h>
 #include <cxa_timeDiff.h>
 #include <cxa_config.h>
@@ -31,10 +30,22 @@
 #define CXA_NETWORK_HTTPCLIENT_HOSTNAME_MAX_LEN_BYTES	64
 #endif
 
-#ifndef CXA_NETWORK_HTTPCLIENT_RESPONSE_LINE_BUFFERLEN_BYTES
+#ifndef CXA_NETWORK_HTTPCLIENT_HEADER_LINE_BUFFERLEN_BYTES
 #define CXA_NETWORK_HTTPCLIENT_HEADER_LINE_BUFFERLEN_BYTES		92
 #endif
 
+#ifndef CXA_NETWORK_HTTPCLIENT_MAXNUM_RESPONSE_HEADER_LISTENERS
+#define CXA_NETWORK_HTTPCLIENT_MAXNUM_RESPONSE_HEADER_LISTENERS		2
+#endif
+
+#ifndef CXA_NETWORK_HTTPCLIENT_CHUNK_BUFFERLEN_BYTES
+#define CXA_NETWORK_HTTPCLIENT_CHUNK_BUFFERLEN_BYTES		128
+#endif
+
+#ifndef CXA_NETWORK_HTTPCLIENT_DOWNLOAD_MAXNUM_RESUMES
+#define CXA_NETWORK_HTTPCLIENT_DOWNLOAD_MAXNUM_RESUMES		3
+#endif
+
 
 // ******** global type definitions *********
 /**
@@ -77,6 +88,11 @@ typedef bool (*cxa_network_httpClient_cb_asyncGenHeaders_t)(cxa_network_httpClie
  * time. This function will continue to be called periodically until either the server closes the
  * connection or this function returns false
  *
+ * By default, the body is generated twice: once to calculate the `Content-Length` and once
+ * to actually send it (so the generated body must be identical between passes). If chunked
+ * requests are enabled (::cxa_network_httpClient_setUseChunkedRequests), the body is generated
+ * exactly once.
+ *
  * @param clientIn the client performing the post operation
  * @param iosIn the ioStream which is presently connected to the server
  * @param userVarIn the previously-provided user variable
@@ -108,6 +124,86 @@ typedef void (*cxa_network_httpClient_cb_onPostComplete_t)(cxa_network_httpClien
 														   void* userVarIn);
 
 
+/**
+ * @public
+ * Callback used to stream the response body (see ::cxa_network_httpClient_setResponseBodyCallback).
+ * Called zero or more times per request, as body data arrives (chunked framing is already removed).
+ * The data is only valid for the duration of the call.
+ *
+ * @param clientIn the client performing the request
+ * @param statusIn the HTTP status code of the response
+ * @param dataIn the next portion of the body
+ * @param numBytesIn number of bytes in dataIn
+ * @param userVarIn the user variable provided with the request
+ *
+ * @return true to continue receiving, false to abort the request (the
+ * 		postComplete callback will indicate failure)
+ */
+typedef bool (*cxa_network_httpClient_cb_onResponseBodyData_t)(cxa_network_httpClient_t *const clientIn,
+															   uint16_t statusIn, uint8_t *const dataIn, size_t numBytesIn,
+															   void* userVarIn);
+
+
+/**
+ * @public
+ * Callback that is called once a download (::cxa_network_httpClient_download_async) is
+ * finished. This function is always the last callback per download.
+ *
+ * @param clientIn the client performing the download
+ * @param didCompleteSuccessfully true if a complete response was received (check statusIn:
+ * 			the body is only written to the sink for 200 and 206 responses). False if the
+ * 			connection was lost more than CXA_NETWORK_HTTPCLIENT_DOWNLOAD_MAXNUM_RESUMES times
+ * 			in a row without progress, or the sink could not be written.
+ * @param statusIn the HTTP status code (valid if 'didCompleteSuccesssfully' is true)
+ * @param offset_bytesIn offset within the resource up to which the sink has been written (pass
+ * 			this to a later download to resume where this one left off)
+ */
+typedef void (*cxa_network_httpClient_cb_onDownloadComplete_t)(cxa_network_httpClient_t *const clientIn,
+															   bool didCompleteSuccessfully,
+															   uint16_t statusIn, size_t offset_bytesIn,
+															   void* userVarIn);
+
+
+/**
+ * @public
+ * Called for each response header matching the name provided to
+ * ::cxa_network_httpClient_addResponseHeaderListener. Headers whose value does
+ * not fit in CXA_NETWORK_HTTPCLIENT_HEADER_LINE_BUFFERLEN_BYTES are skipped.
+ *
+ * @param nameIn the name of the header (as sent by the server)
+ * @param valueIn the value of the header (leading/trailing whitespace removed)
+ */
+typedef void (*cxa_network_httpClient_cb_onResponseHeader_t)(cxa_network_httpClient_t *const clientIn,
+															 const char *const nameIn, const char *const valueIn,
+															 void* userVarIn);
+
+
+/**
+ * @private
+ */
+typedef struct
+{
+	const char* headerName;
+	cxa_network_httpClient_cb_onResponseHeader_t cb;
+	void* userVar;
+}cxa_network_httpClient_responseHeaderListener_t;
+
+
+/**
+ * @public
+ * Timing of a single request (all times in milliseconds, measured from the
+ * call to `cxa_network_httpClient_post_async`)
+ */
+typedef struct
+{
+	bool wasConnectionReused;			///< if true, connect_ms and tls_ms are 0
+	uint32_t connect_ms;				///< time to establish the TCP connection
+	uint32_t tls_ms;					///< time to perform the TLS handshake (if any)
+	uint32_t firstByte_ms;				///< time until the response status line was received
+	uint32_t total_ms;					///< time until the response was complete (or failed)
+}cxa_network_httpClient_timing_t;
+
+
 /**
  * @private
  */
@@ -123,23 +219,67 @@ struct cxa_network_httpClient
 		void* userVar;
 	}cbs;
 
+	const char* method;
+	bool requestHasBody;
+	bool isRequestChunked;
 	char hostname[CXA_NETWORK_HTTPCLIENT_HOSTNAME_MAX_LEN_BYTES+1];
 	char url[CXA_NETWORK_HTTPCLIENT_URL_MAX_LEN_BYTES+1];
 	uint16_t portNum;
 	bool useTls;
 	uint32_t timeout_ms;
 	bool keepOpen;
+	bool useChunkedRequests;
+	bool reconnectAfterDisconnect;
+
+	struct
+	{
+		char line[CXA_NETWORK_HTTPCLIENT_HEADER_LINE_BUFFERLEN_BYTES+1];
+		size_t numBytes;
+		size_t nameLen_bytes;
+		uint8_t state;
+	}headerScan;
+
+	cxa_array_t responseHeaderListeners;
+	cxa_network_httpClient_responseHeaderListener_t responseHeaderListeners_raw[CXA_NETWORK_HTTPCLIENT_MAXNUM_RESPONSE_HEADER_LISTENERS];
+
+	cxa_network_httpClient_cb_onResponseBodyData_t cb_onResponseBodyData;
 
-	cxa_fixedByteBuffer_t headerLineBuffer;
-	uint8_t headerLineBuffer_raw[CXA_NETWORK_HTTPCLIENT_HEADER_LINE_BUFFERLEN_BYTES];
-	cxa_protocolParser_crlf_t headerLineParser;
+	struct
+	{
+		cxa_ioStream_t* sink;
+		cxa_network_httpClient_cb_onDownloadComplete_t cb_onComplete;
+
+		size_t offset_bytes;
+		size_t attemptOffset_bytes;
+		size_t numBytesToSkip;
+		uint8_t numResumesRemaining;
+		bool isResumable;
+		bool isWritingToSink;
+
+		bool hasContentRange;
+		size_t contentRangeStart_bytes;
+	}download;
 
 	cxa_ioStream_nullablePassthrough_t ios_bodyGeneration;
 
+	cxa_ioStream_t ios_chunkedBody;
+	uint8_t chunkBuffer[CXA_NETWORK_HTTPCLIENT_CHUNK_BUFFERLEN_BYTES];
+	size_t chunkBuffer_numBytes;
+
 	cxa_timeDiff_t td_receptionTimeout;
 
+	cxa_timeDiff_t td_request;
+	cxa_network_httpClient_timing_t lastTiming;
+
 	uint16_t responseStatusCode;
 	size_t responseContentLength_bytes;
+	bool hasResponseContentLength;
+	bool isResponseChunked;
+	bool responseRequestsClose;
+	bool isResponseComplete;
+
+	uint8_t responseChunkState;
+	size_t responseChunk_remainingBytes;
 
 	uint8_t* responseBodyBuffer;
 	size_t responseBody_currSize_bytes;
@@ -159,8 +299,14 @@ void cxa_network_httpClient_init(cxa_network_httpClient_t *const netClientIn, in
 
 /**
  * @public
+ * Performs a POST. If the client was left connected to the same host by a previous
+ * request (keepOpenIn), the existing connection is reused. Otherwise, any existing
+ * connection is closed and a new connection is established.
  *
+ * @param keepOpenIn true to keep the connection open after the response is received
+ * 		(unless the server responds with `Connection: close`)
  * @param responseBodyBufferIn buffer in which to store the response body, NULL if body should be discarded
+ * 		(ignored if a response body callback is set, see ::cxa_network_httpClient_setResponseBodyCallback)
  */
 void cxa_network_httpClient_post_async(cxa_network_httpClient_t *const netClientIn,
 								 	   char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
@@ -172,4 +318,116 @@ void cxa_network_httpClient_post_async(cxa_network_httpClient_t *const netClient
 									   void* userVarIn);
 
 
+/**
+ * @public
+ * Performs a PUT. Identical to `cxa_network_httpClient_post_async` other than the method.
+ */
+void cxa_network_httpClient_put_async(cxa_network_httpClient_t *const netClientIn,
+									  char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+									  const char *const urlIn, uint32_t timeout_msIn, bool keepOpenIn,
+									  cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+									  cxa_network_httpClient_cb_postAsyncGenBody_t cb_genBodyIn,
+									  cxa_network_httpClient_cb_onPostComplete_t cb_putCompleteIn,
+									  uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+									  void* userVarIn);
+
+
+/**
+ * @public
+ * Performs a GET (no request body). Otherwise identical to `cxa_network_httpClient_post_async`.
+ */
+void cxa_network_httpClient_get_async(cxa_network_httpClient_t *const netClientIn,
+									  char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+									  const char *const urlIn, uint32_t timeout_msIn, bool keepOpenIn,
+									  cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+									  cxa_network_httpClient_cb_onPostComplete_t cb_getCompleteIn,
+									  uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+									  void* userVarIn);
+
+
+/**
+ * @public
+ * Downloads a resource (GET) directly into the given sink, starting at the given offset
+ * within the resource (using a `Range` request). If the connection is lost mid-transfer,
+ * the download is automatically resumed from the last byte written to the sink (giving up
+ * after CXA_NETWORK_HTTPCLIENT_DOWNLOAD_MAXNUM_RESUMES consecutive attempts without progress).
+ * If the server ignores the range and sends the entire resource, the bytes before the
+ * offset are discarded so the sink always receives a contiguous stream.
+ *
+ * @param sinkIn ioStream to which the body is written (eg. a `cxa_ioStream_file`)
+ * @param offset_bytesIn offset within the resource at which to start (0 for the entire resource)
+ */
+void cxa_network_httpClient_download_async(cxa_network_httpClient_t *const netClientIn,
+										   char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+										   const char *const urlIn, uint32_t timeout_msIn,
+										   cxa_ioStream_t *const sinkIn, size_t offset_bytesIn,
+										   cxa_network_httpClient_cb_onDownloadComplete_t cb_onCompleteIn,
+										   void* userVarIn);
+
+
+/**
+ * @public
+ * Determines how the bodies of subsequent requests are sent. When enabled, bodies
+ * are sent with `Transfer-Encoding: chunked` and the genBody callback is only run
+ * once (output is buffered into chunks of up to CXA_NETWORK_HTTPCLIENT_CHUNK_BUFFERLEN_BYTES).
+ * When disabled (default), the body is generated twice to calculate `Content-Length`.
+ *
+ * Note: chunked responses are always accepted, regardless of this setting
+ */
+void cxa_network_httpClient_setUseChunkedRequests(cxa_network_httpClient_t *const netClientIn, bool useChunkedRequestsIn);
+
+
+/**
+ * @public
+ * Streams the bodies of subsequent responses to the given callback (as they arrive)
+ * rather than storing them in the buffer provided to `cxa_network_httpClient_post_async`.
+ * This places no limit on the size of the response body. The postComplete callback is
+ * still called, with a NULL body and the total number of body bytes received.
+ *
+ * @param cb_onResponseBodyDataIn the callback, NULL to return to buffered responses (default)
+ */
+void cxa_network_httpClient_setResponseBodyCallback(cxa_network_httpClient_t *const netClientIn,
+													cxa_network_httpClient_cb_onResponseBodyData_t cb_onResponseBodyDataIn);
+
+
+/**
+ * @public
+ * Requests that the value of the named response header be delivered to the
+ * given callback (for all subsequent responses). Header names are matched
+ * case-insensitively. All other headers (except those needed for framing)
+ * are skipped without being buffered.
+ *
+ * @param headerNameIn the name of the header (must remain valid, eg. a string literal)
+ */
+void cxa_network_httpClient_addResponseHeaderListener(cxa_network_httpClient_t *const netClientIn,
+													  const char *const headerNameIn,
+													  cxa_network_httpClient_cb_onResponseHeader_t cbIn,
+													  void* userVarIn);
+
+
+/**
+ * @public
+ * @return true if the client is not currently performing a request
+ * 		(and `cxa_network_httpClient_post_async` may be called)
+ */
+bool cxa_network_httpClient_isIdle(cxa_network_httpClient_t *const netClientIn);
+
+
+/**
+ * @public
+ * @return true if the client is idle and holds an open (keep-alive) connection
+ * 		to the given host. A request to this host will not need to reconnect.
+ */
+bool cxa_network_httpClient_isConnectedTo(cxa_network_httpClient_t *const netClientIn,
+										  const char *const hostNameIn, uint16_t portNumIn, bool useTlsIn);
+
+
+/**
+ * @public
+ * @return the timing of the most recent request. Valid from within the
+ * 		postComplete callback.
+ */
+cxa_network_httpClient_timing_t* cxa_network_httpClient_getLastTiming(cxa_network_httpClient_t *const netClientIn);
+
+
 #endif // CXA_NETWORK_HTTPCLIENT_H_
@@ -0,0 +1,253 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_NETWORK_HTTPCLIENTPOOL_H_
+#define CXA_NETWORK_HTTPCLIENTPOOL_H_
+
+
+/**
+ * @file
+ * A statically-sized pool of ::cxa_network_httpClient_t objects with a request queue.
+ * Connections are kept open (HTTP/1.1 keep-alive) between requests and are keyed by
+ * host:port:tls. Queued requests are dispatched to, in order of preference:
+ *
+ * 1. an idle client already connected to the same host (a pool "hit")
+ * 2. an idle client that is not connected
+ * 3. the least-recently-used idle client (its connection is closed first)
+ *
+ * Requests are not pipelined (each connection has at most one outstanding request),
+ * since POST and PUT are not safe to pipeline and a failed pipelined GET would force
+ * every request behind it to be retried. Consecutive requests to the same host are
+ * instead sent back-to-back over the same connection.
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_network_httpClientPool_t pool;
+ * cxa_network_httpClientPool_init(&pool, CXA_RUNLOOP_THREADID_DEFAULT);
+ *
+ * cxa_network_httpClientPool_post_async(&pool, "example.com", 443, true, "/telemetry", 5000,
+ *                                       NULL, cb_genBody, cb_postComplete,
+ *                                       respBuffer, sizeof(respBuffer), NULL);
+ * ...
+ *
+ * static void cb_postComplete(cxa_network_httpClient_t *const clientIn, bool didCompleteSuccessfullyIn,
+ *                             uint16_t statusIn, char *const bodyIn, size_t bodySize_bytesIn, void* userVarIn)
+ * {
+ *     cxa_network_httpClient_timing_t* timing = cxa_network_httpClient_getLastTiming(clientIn);
+ *     ...
+ * }
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cxa_array.h>
+#include <cxa_logger_header.h>
+#include <cxa_network_httpClient.h>
+#include <cxa_runLoop.h>
+#include <cxa_timeDiff.h>
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_NETWORK_HTTPCLIENTPOOL_MAXNUM_CLIENTS
+	#define CXA_NETWORK_HTTPCLIENTPOOL_MAXNUM_CLIENTS				2
+#endif
+
+#ifndef CXA_NETWORK_HTTPCLIENTPOOL_MAXNUM_QUEUED_REQUESTS
+	#define CXA_NETWORK_HTTPCLIENTPOOL_MAXNUM_QUEUED_REQUESTS		4
+#endif
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * Forward declaration of cxa_network_httpClientPool_t object
+ */
+typedef struct cxa_network_httpClientPool cxa_network_httpClientPool_t;
+
+
+/**
+ * @public
+ * Timing sums are over all successfully completed requests
+ * (divide by numSuccesses for an average)
+ */
+typedef struct
+{
+	uint32_t numRequests;				///< requests started on a client
+	uint32_t numPoolHits;				///< requests that reused an open connection
+	uint32_t numEvictions;				///< connections closed to make room for another host
+	uint32_t numSuccesses;
+	uint32_t numFailures;
+	uint32_t numRejected;				///< requests rejected because the queue was full
+	uint32_t maxQueueDepth;
+
+	uint32_t sumConnect_ms;
+	uint32_t sumTls_ms;
+	uint32_t sumFirstByte_ms;
+	uint32_t sumTotal_ms;
+}cxa_network_httpClientPool_stats_t;
+
+
+/**
+ * @private
+ */
+typedef enum
+{
+	CXA_NETWORK_HTTPCLIENTPOOL_METHOD_GET,
+	CXA_NETWORK_HTTPCLIENTPOOL_METHOD_POST,
+	CXA_NETWORK_HTTPCLIENTPOOL_METHOD_PUT
+}cxa_network_httpClientPool_method_t;
+
+
+/**
+ * @private
+ */
+typedef struct
+{
+	cxa_network_httpClientPool_method_t method;
+
+	char hostname[CXA_NETWORK_HTTPCLIENT_HOSTNAME_MAX_LEN_BYTES+1];
+	char url[CXA_NETWORK_HTTPCLIENT_URL_MAX_LEN_BYTES+1];
+	uint16_t portNum;
+	bool useTls;
+	uint32_t timeout_ms;
+
+	cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeaders;
+	cxa_network_httpClient_cb_postAsyncGenBody_t cb_genBody;
+	cxa_network_httpClient_cb_onPostComplete_t cb_postComplete;
+	void* userVar;
+
+	uint8_t* responseBodyBuffer;
+	size_t responseBody_maxSize_bytes;
+}cxa_network_httpClientPool_request_t;
+
+
+/**
+ * @private
+ */
+typedef struct
+{
+	cxa_network_httpClientPool_t* parent;
+
+	cxa_network_httpClient_t client;
+	bool isBusy;
+	bool wasHit;
+
+	cxa_network_httpClientPool_request_t request;
+	cxa_timeDiff_t td_lastUsed;
+}cxa_network_httpClientPool_slot_t;
+
+
+/**
+ * @private
+ */
+struct cxa_network_httpClientPool
+{
+	cxa_network_httpClientPool_slot_t slots[CXA_NETWORK_HTTPCLIENTPOOL_MAXNUM_CLIENTS];
+
+	cxa_array_t requestQueue;
+	cxa_network_httpClientPool_request_t requestQueue_raw[CXA_NETWORK_HTTPCLIENTPOOL_MAXNUM_QUEUED_REQUESTS];
+	cxa_runLoop_entryHandle_t runLoopEntry;
+
+	cxa_network_httpClientPool_stats_t stats;
+
+	cxa_logger_t logger;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * Initializes the pool. Reserves CXA_NETWORK_HTTPCLIENTPOOL_MAXNUM_CLIENTS
+ * tcpClients from the network factory.
+ */
+void cxa_network_httpClientPool_init(cxa_network_httpClientPool_t *const poolIn, int threadIdIn);
+
+
+/**
+ * @public
+ * Queues a POST request. Parameters are as per `cxa_network_httpClient_post_async`.
+ * The connection is always kept open after the request. The `clientIn` passed to
+ * the callbacks is the pooled client performing the request.
+ *
+ * @return true if the request was queued, false if the queue is full
+ */
+bool cxa_network_httpClientPool_post_async(cxa_network_httpClientPool_t *const poolIn,
+										   const char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+										   const char *const urlIn, uint32_t timeout_msIn,
+										   cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+										   cxa_network_httpClient_cb_postAsyncGenBody_t cb_genBodyIn,
+										   cxa_network_httpClient_cb_onPostComplete_t cb_postCompleteIn,
+										   uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+										   void* userVarIn);
+
+
+/**
+ * @public
+ * Queues a PUT request. Identical to `cxa_network_httpClientPool_post_async` other than the method.
+ */
+bool cxa_network_httpClientPool_put_async(cxa_network_httpClientPool_t *const poolIn,
+										  const char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+										  const char *const urlIn, uint32_t timeout_msIn,
+										  cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+										  cxa_network_httpClient_cb_postAsyncGenBody_t cb_genBodyIn,
+										  cxa_network_httpClient_cb_onPostComplete_t cb_putCompleteIn,
+										  uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+										  void* userVarIn);
+
+
+/**
+ * @public
+ * Queues a GET request (no request body). Otherwise identical to `cxa_network_httpClientPool_post_async`.
+ */
+bool cxa_network_httpClientPool_get_async(cxa_network_httpClientPool_t *const poolIn,
+										  const char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+										  const char *const urlIn, uint32_t timeout_msIn,
+										  cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+										  cxa_network_httpClient_cb_onPostComplete_t cb_getCompleteIn,
+										  uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+										  void* userVarIn);
+
+
+/**
+ * @public
+ * See `cxa_network_httpClient_setUseChunkedRequests` (applies to all pooled clients)
+ */
+void cxa_network_httpClientPool_setUseChunkedRequests(cxa_network_httpClientPool_t *const poolIn, bool useChunkedRequestsIn);
+
+
+/**
+ * @public
+ * @return the number of requests waiting for a free client
+ */
+size_t cxa_network_httpClientPool_getQueueDepth(cxa_network_httpClientPool_t *const poolIn);
+
+
+/**
+ * @public
+ * @return the percentage of requests which reused an existing connection
+ */
+uint8_t cxa_network_httpClientPool_getHitRate_pct(cxa_network_httpClientPool_t *const poolIn);
+
+
+/**
+ * @public
+ */
+cxa_network_httpClientPool_stats_t* cxa_network_httpClientPool_getStats(cxa_network_httpClientPool_t *const poolIn);
+
+
+/**
+ * @public
+ */
+void cxa_network_httpClientPool_resetStats(cxa_network_httpClientPool_t *const poolIn);
+
+
+#endif
@@ -31,6 +31,10 @@
 	#define CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_MAXPORTNUMLEN_BYTES			5
 #endif
 
+#ifndef CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_RXBUFFERLEN_BYTES
+	#define CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_RXBUFFERLEN_BYTES			512
+#endif
+
 
 // ******** global type definitions *********
 /**
@@ -54,6 +58,14 @@ struct cxa_lwipMbedTls_network_tcpClient
 	cxa_timeDiff_t td_writeTimeout;
 	cxa_stateMachine_t stateMachine;
 
+	// decrypted data waiting to be read (filled a record at a time)
+	struct
+	{
+		uint8_t buffer[CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_RXBUFFERLEN_BYTES];
+		size_t readIndex;
+		size_t numBytes;
+	}rxBuffer;
+
 	bool useClientCert;
 	struct
 	{
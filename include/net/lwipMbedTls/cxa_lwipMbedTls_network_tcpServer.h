@@ -44,6 +44,8 @@ struct cxa_lwipMbedTls_network_tcpServer
 	int listenSocket;
 
 	cxa_lwipMbedTls_network_tcpServer_connectedClient_t connectedClients[CXA_LWIPMBEDTLS_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS];
+	size_t freeClientIndices[CXA_LWIPMBEDTLS_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS];
+	size_t numFreeClients;
 
 	cxa_stateMachine_t stateMachine;
 };
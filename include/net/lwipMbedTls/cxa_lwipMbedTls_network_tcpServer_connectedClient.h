@@ -17,6 +17,9 @@
 
 
 // ******** global macro definitions ********
+#ifndef CXA_LWIPMBEDTLS_NETWORK_TCPSERVER_CONNECTEDCLIENT_RXBUFFERLEN_BYTES
+	#define CXA_LWIPMBEDTLS_NETWORK_TCPSERVER_CONNECTEDCLIENT_RXBUFFERLEN_BYTES		256
+#endif
 
 
 // ******** global type definitions *********
@@ -27,6 +30,13 @@
 typedef struct cxa_lwipMbedTls_network_tcpServer_connectedClient cxa_lwipMbedTls_network_tcpServer_connectedClient_t;
 
 
+/**
+ * @protected
+ * Called (after the disconnect listeners) when the client is unbound and may be reused
+ */
+typedef void (*cxa_lwipMbedTls_network_tcpServer_connectedClient_cb_onUnbound_t)(cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn, void* userVarIn);
+
+
 /**
  * @private
  */
@@ -37,7 +47,18 @@ struct cxa_lwipMbedTls_network_tcpServer_connectedClient
 	int socket;
 	char descriptiveString[23];			// "aaa.bbb.ccc.ddd::eeeee"
 
+	struct
+	{
+		uint8_t buffer[CXA_LWIPMBEDTLS_NETWORK_TCPSERVER_CONNECTEDCLIENT_RXBUFFERLEN_BYTES];
+		size_t readIndex;
+		size_t numBytes;
+	}rxRing;
+	bool isPeerClosed;					// closed once rxRing is drained
+
 	cxa_timeDiff_t td_writeTimeout;
+
+	cxa_lwipMbedTls_network_tcpServer_connectedClient_cb_onUnbound_t cb_onUnbound;
+	void* userVar;
 };
 
 
@@ -45,7 +66,9 @@ struct cxa_lwipMbedTls_network_tcpServer_connectedClient
 /**
  * @protected
  */
-void cxa_lwipMbedTls_network_tcpServer_connectedClient_initUnbound(cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn);
+void cxa_lwipMbedTls_network_tcpServer_connectedClient_initUnbound(cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn,
+																	cxa_lwipMbedTls_network_tcpServer_connectedClient_cb_onUnbound_t cb_onUnboundIn,
+																	void* userVarIn);
 
 
 /**
@@ -56,4 +79,20 @@ void cxa_lwipMbedTls_network_tcpServer_connectedClient_bindToSocket(cxa_lwipMbed
 																	struct sockaddr_in * clientAddressIn);
 
 
+/**
+ * @protected
+ * @return true if the client is bound and has room in its receive buffer
+ * 		(ie. the server should poll its socket for readability)
+ */
+bool cxa_lwipMbedTls_network_tcpServer_connectedClient_wantsRead(cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn);
+
+
+/**
+ * @protected
+ * Called by the server when the client's socket is readable. Reads as much
+ * as will fit (contiguously) in the receive buffer with a single `recv`.
+ */
+void cxa_lwipMbedTls_network_tcpServer_connectedClient_serviceRead(cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn);
+
+
 #endif // CXA_LWIPMBEDTLS_NETWORK_TCPSERVER_CONNECTEDCLIENT_H_
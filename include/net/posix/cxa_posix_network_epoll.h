@@ -0,0 +1,108 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_POSIX_NETWORK_EPOLL_H_
+#define CXA_POSIX_NETWORK_EPOLL_H_
+
+
+/**
+ * @file
+ * A single (Linux) epoll instance shared by all posix network objects. The epoll
+ * instance is the runLoop's event source (see ::cxa_runLoop_setEventSource): an idle
+ * runLoop sleeps in epoll_wait, and the callback registered for each ready file
+ * descriptor is called with the reported events. Network objects can keep their
+ * runLoop entries suspended until then.
+ *
+ * All file descriptors are serviced from the runLoop thread used by the first
+ * registration.
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_posix_network_epoll_entry_t* entry = cxa_posix_network_epoll_add(CXA_RUNLOOP_THREADID_DEFAULT, sock, EPOLLIN, cb_onEvents, (void*)myObj);
+ * ...
+ * cxa_posix_network_epoll_remove(entry);
+ * close(sock);
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_POSIX_NETWORK_EPOLL_MAXNUM_ENTRIES
+	#define CXA_POSIX_NETWORK_EPOLL_MAXNUM_ENTRIES					16
+#endif
+
+#ifndef CXA_POSIX_NETWORK_EPOLL_MAXNUM_EVENTS_PER_ITERATION
+	#define CXA_POSIX_NETWORK_EPOLL_MAXNUM_EVENTS_PER_ITERATION		16
+#endif
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * Forward declaration of cxa_posix_network_epoll_entry_t object
+ */
+typedef struct cxa_posix_network_epoll_entry cxa_posix_network_epoll_entry_t;
+
+
+/**
+ * @public
+ * @param[in] eventsIn the epoll events reported for the file descriptor (EPOLLIN, EPOLLOUT, EPOLLHUP, etc)
+ */
+typedef void (*cxa_posix_network_epoll_cb_onEvents_t)(uint32_t eventsIn, void* userVarIn);
+
+
+/**
+ * @private
+ */
+struct cxa_posix_network_epoll_entry
+{
+	int fd;
+	uint32_t generation;
+
+	cxa_posix_network_epoll_cb_onEvents_t cb_onEvents;
+	void* userVar;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * Starts monitoring the given file descriptor
+ *
+ * @param[in] eventsIn the epoll events of interest (level-triggered)
+ *
+ * @return the entry to use for subsequent calls or NULL on error
+ */
+cxa_posix_network_epoll_entry_t* cxa_posix_network_epoll_add(int threadIdIn, int fdIn, uint32_t eventsIn,
+															 cxa_posix_network_epoll_cb_onEvents_t cb_onEventsIn, void* userVarIn);
+
+
+/**
+ * @public
+ * Changes the events of interest for the given entry (0 pauses reporting)
+ */
+bool cxa_posix_network_epoll_modify(cxa_posix_network_epoll_entry_t *const entryIn, uint32_t eventsIn);
+
+
+/**
+ * @public
+ * Stops monitoring the entry's file descriptor. Must be called _before_ the
+ * file descriptor is closed. Events already collected for this entry during
+ * the current iteration are discarded.
+ */
+void cxa_posix_network_epoll_remove(cxa_posix_network_epoll_entry_t *const entryIn);
+
+
+#endif // CXA_POSIX_NETWORK_EPOLL_H_
@@ -0,0 +1,144 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_POSIX_NETWORK_SOCKET_H_
+#define CXA_POSIX_NETWORK_SOCKET_H_
+
+
+/**
+ * @file
+ * A non-blocking stream socket with a receive buffer, shared by the posix tcpClient
+ * and tcpServer_connectedClient. Reads are gated by epoll readiness: bytes are read
+ * from the kernel in bulk (up to CXA_POSIX_NETWORK_SOCKET_RXBUFFERLEN_BYTES at a time)
+ * and served from the buffer, and no `recv` is issued until the socket is readable.
+ * Peer closure is detected by the runLoop even if the owner is not reading.
+ */
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cxa_config.h>
+#include <cxa_ioStream.h>
+#include <cxa_logger_header.h>
+#include <cxa_posix_network_epoll.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_POSIX_NETWORK_SOCKET_RXBUFFERLEN_BYTES
+	#define CXA_POSIX_NETWORK_SOCKET_RXBUFFERLEN_BYTES			1024
+#endif
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * Forward declaration of cxa_posix_network_socket_t object
+ */
+typedef struct cxa_posix_network_socket cxa_posix_network_socket_t;
+
+
+/**
+ * @protected
+ * Called (once) when a pending connect completes
+ *
+ * @param[in] errorIn 0 on success, otherwise the socket error (SO_ERROR)
+ */
+typedef void (*cxa_posix_network_socket_cb_onConnectComplete_t)(cxa_posix_network_socket_t *const sockIn, int errorIn, void* userVarIn);
+
+
+/**
+ * @protected
+ * Called when the peer closes the connection or a read/write error occurs.
+ * The socket is already closed when this is called.
+ */
+typedef void (*cxa_posix_network_socket_cb_onClosed_t)(cxa_posix_network_socket_t *const sockIn, void* userVarIn);
+
+
+/**
+ * @private
+ */
+struct cxa_posix_network_socket
+{
+	int fd;
+	cxa_posix_network_epoll_entry_t* epollEntry;
+	bool isConnectPending;
+	bool isReadable;
+
+	uint8_t rxBuffer[CXA_POSIX_NETWORK_SOCKET_RXBUFFERLEN_BYTES];
+	size_t rxBuffer_numBytes;
+	size_t rxBuffer_readIndex;
+
+	cxa_posix_network_socket_cb_onConnectComplete_t cb_onConnectComplete;
+	cxa_posix_network_socket_cb_onClosed_t cb_onClosed;
+	void* userVar;
+
+	cxa_ioStream_t* ioStream;
+
+	cxa_logger_t* logger;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @protected
+ * @param[in] ioStreamIn the owner's ioStream (which reads from this socket),
+ * 		notified via ::cxa_ioStream_notify_dataAvailable whenever the socket
+ * 		becomes readable (the owner should ::cxa_ioStream_setNotifiesDataAvailable
+ * 		after binding it)
+ */
+void cxa_posix_network_socket_init(cxa_posix_network_socket_t *const sockIn,
+								   cxa_posix_network_socket_cb_onConnectComplete_t cb_onConnectCompleteIn,
+								   cxa_posix_network_socket_cb_onClosed_t cb_onClosedIn,
+								   void* userVarIn,
+								   cxa_ioStream_t *const ioStreamIn,
+								   cxa_logger_t *const loggerIn);
+
+
+/**
+ * @protected
+ * Takes ownership of an already-open, non-blocking socket and starts monitoring it
+ *
+ * @param[in] isConnectPendingIn true if a non-blocking connect is in progress
+ * 		(cb_onConnectComplete will be called when it completes)
+ *
+ * @return false if the socket could not be monitored (the socket is closed)
+ */
+bool cxa_posix_network_socket_attach(cxa_posix_network_socket_t *const sockIn, int threadIdIn, int fdIn, bool isConnectPendingIn);
+
+
+/**
+ * @protected
+ * Stops monitoring and closes the socket (if open) and discards any buffered data.
+ * Does _not_ call cb_onClosed.
+ */
+void cxa_posix_network_socket_close(cxa_posix_network_socket_t *const sockIn);
+
+
+/**
+ * @protected
+ */
+bool cxa_posix_network_socket_isOpen(cxa_posix_network_socket_t *const sockIn);
+
+
+/**
+ * @protected
+ * Suitable for use as (or from) an ioStream readByte callback
+ */
+cxa_ioStream_readStatus_t cxa_posix_network_socket_readByte(cxa_posix_network_socket_t *const sockIn, uint8_t *const byteOut);
+
+
+/**
+ * @protected
+ * Writes all bytes, waiting (up to timeout_msIn between partial writes) for
+ * the socket to become writable as needed
+ */
+bool cxa_posix_network_socket_writeBytes(cxa_posix_network_socket_t *const sockIn, void* buffIn, size_t bufferSize_bytesIn, uint32_t timeout_msIn);
+
+
+#endif // CXA_POSIX_NETWORK_SOCKET_H_
@@ -0,0 +1,59 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_POSIX_NETWORK_TCPCLIENT_H_
+#define CXA_POSIX_NETWORK_TCPCLIENT_H_
+
+
+// ******** includes ********
+#include <cxa_network_tcpClient.h>
+
+#include <cxa_posix_network_socket.h>
+#include <cxa_stateMachine.h>
+#include <cxa_timeDiff.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_POSIX_NETWORK_TCPCLIENT_MAXHOSTNAMELEN_BYTES
+	#define CXA_POSIX_NETWORK_TCPCLIENT_MAXHOSTNAMELEN_BYTES			64
+#endif
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_posix_network_tcpClient_t object
+ */
+typedef struct cxa_posix_network_tcpClient cxa_posix_network_tcpClient_t;
+
+
+/**
+ * @private
+ */
+struct cxa_posix_network_tcpClient
+{
+	cxa_network_tcpClient_t super;
+
+	char targetHostName[CXA_POSIX_NETWORK_TCPCLIENT_MAXHOSTNAMELEN_BYTES+1];
+	uint16_t targetPortNum;
+	uint32_t connectTimeout_ms;
+
+	int threadId;
+	cxa_posix_network_socket_t socket;
+
+	cxa_timeDiff_t td_connectTimeout;
+	cxa_stateMachine_t stateMachine;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @private
+ */
+void cxa_posix_network_tcpClient_init(cxa_posix_network_tcpClient_t *const netClientIn, int threadIdIn);
+
+
+#endif // CXA_POSIX_NETWORK_TCPCLIENT_H_
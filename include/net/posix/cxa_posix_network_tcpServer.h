@@ -0,0 +1,71 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_POSIX_NETWORK_TCPSERVER_H_
+#define CXA_POSIX_NETWORK_TCPSERVER_H_
+
+
+// ******** includes ********
+#include <cxa_network_tcpServer.h>
+
+#include <cxa_posix_network_epoll.h>
+#include <cxa_posix_network_tcpServer_connectedClient.h>
+#include <cxa_stateMachine.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_POSIX_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS
+	#define CXA_POSIX_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS			4
+#endif
+
+/**
+ * @public
+ * Connections the kernel will hold while we are not accepting. Connection bursts
+ * beyond this are dropped and only retried by the client's SYN retransmit (~1s).
+ */
+#ifndef CXA_POSIX_NETWORK_TCPSERVER_CONNECTION_BACKLOG
+	#define CXA_POSIX_NETWORK_TCPSERVER_CONNECTION_BACKLOG			8
+#endif
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_posix_network_tcpServer_t object
+ */
+typedef struct cxa_posix_network_tcpServer cxa_posix_network_tcpServer_t;
+
+
+/**
+ * @private
+ */
+struct cxa_posix_network_tcpServer
+{
+	cxa_network_tcpServer_t super;
+
+	int threadId;
+	uint16_t portNumber;
+
+	int listenSocket;
+	cxa_posix_network_epoll_entry_t* listenEntry;
+	bool isAcceptPaused;
+
+	cxa_posix_network_tcpServer_connectedClient_t connectedClients[CXA_POSIX_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS];
+	size_t freeClientIndices[CXA_POSIX_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS];
+	size_t numFreeClients;
+
+	cxa_stateMachine_t stateMachine;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @protected
+ */
+void cxa_posix_network_tcpServer_init(cxa_posix_network_tcpServer_t *const netServerIn, int threadIdIn);
+
+
+#endif // CXA_POSIX_NETWORK_TCPSERVER_H_
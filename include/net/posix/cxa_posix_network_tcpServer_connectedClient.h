@@ -0,0 +1,73 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_POSIX_NETWORK_TCPSERVER_CONNECTEDCLIENT_H_
+#define CXA_POSIX_NETWORK_TCPSERVER_CONNECTEDCLIENT_H_
+
+
+// ******** includes ********
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <cxa_network_tcpServer_connectedClient.h>
+#include <cxa_posix_network_socket.h>
+
+
+// ******** global macro definitions ********
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_posix_network_tcpServer_connectedClient_t object
+ */
+typedef struct cxa_posix_network_tcpServer_connectedClient cxa_posix_network_tcpServer_connectedClient_t;
+
+
+/**
+ * @protected
+ * Called (after the disconnect listeners) when the client is unbound and may be reused
+ */
+typedef void (*cxa_posix_network_tcpServer_connectedClient_cb_onUnbound_t)(cxa_posix_network_tcpServer_connectedClient_t *const ccIn, void* userVarIn);
+
+
+/**
+ * @private
+ */
+struct cxa_posix_network_tcpServer_connectedClient
+{
+	cxa_network_tcpServer_connectedClient_t super;
+
+	int threadId;
+	cxa_posix_network_socket_t socket;
+	char descriptiveString[INET6_ADDRSTRLEN+8];			// "<address>::eeeee"
+
+	cxa_posix_network_tcpServer_connectedClient_cb_onUnbound_t cb_onUnbound;
+	void* userVar;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @protected
+ */
+void cxa_posix_network_tcpServer_connectedClient_initUnbound(cxa_posix_network_tcpServer_connectedClient_t *const ccIn, int threadIdIn,
+															 cxa_posix_network_tcpServer_connectedClient_cb_onUnbound_t cb_onUnboundIn,
+															 void* userVarIn);
+
+
+/**
+ * @protected
+ * Takes ownership of a freshly-accepted, non-blocking socket
+ *
+ * @return false if the socket could not be bound (the socket is closed)
+ */
+bool cxa_posix_network_tcpServer_connectedClient_bindToSocket(cxa_posix_network_tcpServer_connectedClient_t *const ccIn,
+															  int socketIn,
+															  struct sockaddr_storage *const clientAddressIn);
+
+
+#endif // CXA_POSIX_NETWORK_TCPSERVER_CONNECTEDCLIENT_H_
@@ -0,0 +1,117 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_WOLFSSLDIALSOCKET_IOBRIDGE_H_
+#define CXA_WOLFSSLDIALSOCKET_IOBRIDGE_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cxa_ioStream.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_WOLFSSLDIALSOCKET_IOBRIDGE_RINGBUFFERLEN_BYTES
+	#define CXA_WOLFSSLDIALSOCKET_IOBRIDGE_RINGBUFFERLEN_BYTES			1024
+#endif
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_wolfSslDialSocket_ioBridge_t object
+ */
+typedef struct cxa_wolfSslDialSocket_ioBridge cxa_wolfSslDialSocket_ioBridge_t;
+
+
+/**
+ * @private
+ */
+struct cxa_wolfSslDialSocket_ioBridge
+{
+	cxa_ioStream_t* modemIoStream;
+	bool hadReadError;
+
+	struct
+	{
+		uint8_t buffer[CXA_WOLFSSLDIALSOCKET_IOBRIDGE_RINGBUFFERLEN_BYTES];
+		size_t readIndex;
+		size_t numBytes;
+	}ring;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * Initializes a detached bridge
+ */
+void cxa_wolfSslDialSocket_ioBridge_init(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn);
+
+
+/**
+ * @public
+ * Attaches the bridge to the (already connected) modem socket ioStream,
+ * discarding any previously buffered data
+ */
+void cxa_wolfSslDialSocket_ioBridge_attach(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn, cxa_ioStream_t *const modemIoStreamIn);
+
+
+/**
+ * @public
+ * Detaches the bridge from the modem ioStream, discarding any buffered data
+ */
+void cxa_wolfSslDialSocket_ioBridge_detach(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn);
+
+
+/**
+ * @public
+ * @return true if the bridge is currently attached to a modem ioStream
+ */
+bool cxa_wolfSslDialSocket_ioBridge_isAttached(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn);
+
+
+/**
+ * @public
+ * Drains everything currently available from the modem ioStream into the
+ * ring buffer (stopping when the modem has no more data or the ring is full)
+ *
+ * @return the number of bytes moved into the ring buffer
+ */
+size_t cxa_wolfSslDialSocket_ioBridge_fill(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn);
+
+
+/**
+ * @public
+ * Copies up to maxNumBytesIn buffered bytes into buffOut (refilling from
+ * the modem first if needed). Never blocks.
+ *
+ * @param numBytesReadOut the number of bytes copied (may be NULL)
+ *
+ * @return CXA_IOSTREAM_READSTAT_GOTDATA if any bytes were copied,
+ * 		CXA_IOSTREAM_READSTAT_NODATA if no bytes are available yet, or
+ * 		CXA_IOSTREAM_READSTAT_ERROR if the ring is empty and the modem
+ * 		ioStream has reported an error (or the bridge is detached)
+ */
+cxa_ioStream_readStatus_t cxa_wolfSslDialSocket_ioBridge_readBlock(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn,
+																	void *const buffOut, size_t maxNumBytesIn,
+																	size_t *const numBytesReadOut);
+
+
+/**
+ * @public
+ * Writes the entire block to the modem ioStream in a single write
+ *
+ * @return true on success
+ */
+bool cxa_wolfSslDialSocket_ioBridge_writeBlock(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn,
+											   void *const buffIn, size_t numBytesIn);
+
+
+#endif // CXA_WOLFSSLDIALSOCKET_IOBRIDGE_H_
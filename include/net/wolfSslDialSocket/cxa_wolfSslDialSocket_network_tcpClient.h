@@ -13,6 +13,7 @@
 #include <cxa_network_tcpClient.h>
 #include <cxa_stateMachine.h>
 #include <cxa_timeDiff.h>
+#include <cxa_wolfSslDialSocket_ioBridge.h>
 
 #include <wolfssl/options.h>
 #include <wolfssl/ssl.h>
@@ -27,6 +28,10 @@
 	#define CXA_WOLFSSLDIALSOCKET_NETWORK_TCPCLIENT_MAXPORTNUMLEN_BYTES			5
 #endif
 
+#ifndef CXA_WOLFSSLDIALSOCKET_NETWORK_TCPCLIENT_RXBUFFERLEN_BYTES
+	#define CXA_WOLFSSLDIALSOCKET_NETWORK_TCPCLIENT_RXBUFFERLEN_BYTES			256
+#endif
+
 
 // ******** global type definitions *********
 /**
@@ -44,13 +49,25 @@ struct cxa_wolfSslDialSocket_network_tcpClient
 	cxa_network_tcpClient_t super;
 
     aq_telitTsvgModem_t* modem;
-    cxa_ioStream_t* modemIoStream;
+    cxa_wolfSslDialSocket_ioBridge_t modemBridge;
 
 	char targetHostName[CXA_WOLFSSLDIALSOCKET_NETWORK_TCPCLIENT_MAXHOSTNAMELEN_BYTES+1];
 	uint16_t targetPortNum;
 
 	cxa_stateMachine_t stateMachine;
 
+	bool isHandshaking;
+	uint32_t connectTimeout_ms;
+	cxa_timeDiff_t td_connectTimeout;
+
+	// decrypted data waiting to be read (filled a record at a time)
+	struct
+	{
+		uint8_t buffer[CXA_WOLFSSLDIALSOCKET_NETWORK_TCPCLIENT_RXBUFFERLEN_BYTES];
+		size_t readIndex;
+		size_t numBytes;
+	}rxBuffer;
+
 	bool useClientCert;
 	struct
 	{
@@ -19,6 +19,18 @@
 	#define CXA_RUNLOOP_MAXNUM_ENTRIES				10
 #endif
 
+/**
+ * @public
+ * Upper bound on how long ::cxa_runLoop_execute sleeps while all entries are
+ * idle. Bounds the latency of events that don't resume an entry (or that are
+ * signalled from contexts that can't wake the sleeping thread).
+ */
+#ifndef CXA_RUNLOOP_MAXIDLETIME_MS
+	#define CXA_RUNLOOP_MAXIDLETIME_MS				100
+#endif
+
+#define CXA_RUNLOOP_ENTRYHANDLE_INVALID				0
+
 #define CXA_RUNLOOP_THREADID_DEFAULT				0
 
 
@@ -29,16 +41,99 @@
 typedef void (*cxa_runLoop_cb_t)(void* userVarIn);
 
 
+/**
+ * @public
+ * Waits (at most timeout_msIn, 0 for a non-blocking check) for external events
+ * and handles any that arrived. See ::cxa_runLoop_setEventSource
+ */
+typedef void (*cxa_runLoop_cb_waitForEvents_t)(uint32_t timeout_msIn, void* userVarIn);
+
+
+/**
+ * @public
+ * Handle to a (non one-shot) runLoop entry. Handles are invalidated by
+ * ::cxa_runLoop_clearAllEntries: operations on an invalidated handle are ignored
+ * (even if the entry's slot has since been reused).
+ */
+typedef uint32_t cxa_runLoop_entryHandle_t;
+
+
 // ******** global function prototypes ********
-void cxa_runLoop_addEntry(int threadIdIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
-void cxa_runLoop_addTimedEntry(int threadIdIn, uint32_t execPeriod_msIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+cxa_runLoop_entryHandle_t cxa_runLoop_addEntry(int threadIdIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+cxa_runLoop_entryHandle_t cxa_runLoop_addTimedEntry(int threadIdIn, uint32_t execPeriod_msIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
+/**
+ * @public
+ * Removes all entries (of all threads) and invalidates all entry handles
+ */
 void cxa_runLoop_clearAllEntries(void);
 
+/**
+ * @public
+ * Stops calling the entry's update callback until it is resumed. Entries that only
+ * react to external events should suspend themselves while idle (rather than
+ * polling every iteration).
+ */
+void cxa_runLoop_entry_suspend(cxa_runLoop_entryHandle_t entryIn);
+
+/**
+ * @public
+ * Resumes a suspended entry (its update callback is called on the next iteration).
+ * Safe to call on an entry that isn't suspended, and from other threads (a thread
+ * sleeping in ::cxa_runLoop_execute is woken where the platform supports it).
+ */
+void cxa_runLoop_entry_resume(cxa_runLoop_entryHandle_t entryIn);
+
+/**
+ * @public
+ * Suspends the entry until the given amount of time has elapsed (or it is
+ * resumed, whichever comes first)
+ */
+void cxa_runLoop_entry_resumeAfter(cxa_runLoop_entryHandle_t entryIn, uint32_t delay_msIn);
+
+/**
+ * @public
+ * Makes the given thread wait on an external event source (eg. an epoll instance)
+ * instead of sleeping: ::cxa_runLoop_execute calls cb_waitIn with its idle time,
+ * and cb_wakeIn (possibly from another thread) when an entry is resumed during
+ * that wait. Iterations that don't follow such a wait call cb_waitIn with 0
+ * first, so events are still handled while the thread is busy.
+ *
+ * One event source per process (posix only).
+ */
+void cxa_runLoop_setEventSource(int threadIdIn, cxa_runLoop_cb_waitForEvents_t cb_waitIn, cxa_runLoop_cb_t cb_wakeIn, void *const userVarIn);
+
 void cxa_runLoop_dispatchNextIteration(int threadIdIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
 void cxa_runLoop_dispatchAfter(int threadIdIn, uint32_t delay_msIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn);
 
 uint32_t cxa_runLoop_iterate(int threadIdIn);
+
+/**
+ * @public
+ * Iterates the given thread forever. Between iterations, the calling thread sleeps
+ * until the next entry needs to run (see ::cxa_runLoop_getTimeUntilNextEntry_ms),
+ * at most CXA_RUNLOOP_MAXIDLETIME_MS. On posix, resuming an entry wakes the
+ * thread early (and the thread waits on its event source, if it has one);
+ * FreeRTOS sleeps (in ticks) without an early wake and other platforms don't
+ * sleep at all.
+ */
 void cxa_runLoop_execute(int threadIdIn);
 
+/**
+ * @public
+ * A single pass of ::cxa_runLoop_execute: iterates the given thread once, then
+ * sleeps until its next entry needs to run (at most maxIdleTime_msIn). For
+ * callers that need control between iterations (eg. tests and benchmarks).
+ */
+void cxa_runLoop_executeOnce(int threadIdIn, uint32_t maxIdleTime_msIn);
+
+/**
+ * @public
+ * @return the number of milliseconds until an entry of the given thread needs to
+ * 		be called: 0 if any entry is active, UINT32_MAX if all entries are suspended
+ * 		indefinitely. Platforms may sleep (or enter a low-power mode) for this long
+ * 		between iterations, provided they wake for external events.
+ */
+uint32_t cxa_runLoop_getTimeUntilNextEntry_ms(int threadIdIn);
+
 
 #endif // CXA_RUN_LOOP_H_
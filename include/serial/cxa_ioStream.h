@@ -51,6 +51,23 @@ typedef enum
 typedef cxa_ioStream_readStatus_t (*cxa_ioStream_cb_readByte_t)(uint8_t *const byteOut, void *const userVarIn);
 
 
+/**
+ * @public
+ * @brief Read a block of bytes from the ioStream (optional, see
+ * 		::cxa_ioStream_setReadBytesCb).
+ *
+ * @param[out] buffOut pointer to a location at which to store the received bytes
+ * @param[in] maxNumBytesIn the maximum number of bytes to store (> 0)
+ * @param[out] numBytesReadOut the number of bytes stored
+ * @param[in] userVarIn pointer to the user-supplied variable passed to
+ * 		::cxa_ioStream_bind
+ *
+ * @return the return status of the read (CXA_IOSTREAM_READSTAT_GOTDATA if any
+ * 		bytes were stored)
+ */
+typedef cxa_ioStream_readStatus_t (*cxa_ioStream_cb_readBytes_t)(void *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
+
+
 /**
  * @public
  * @brief Write bytes to the ioStream.
@@ -69,12 +86,25 @@ typedef cxa_ioStream_readStatus_t (*cxa_ioStream_cb_readByte_t)(uint8_t *const b
 typedef bool (*cxa_ioStream_cb_writeBytes_t)(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 
 
+/**
+ * @public
+ * @brief Called when data may have become available to read (or the ioStream
+ * 		was bound / unbound). See ::cxa_ioStream_setDataAvailableListener
+ */
+typedef void (*cxa_ioStream_cb_onDataAvailable_t)(cxa_ioStream_t *const ioStreamIn, void *const userVarIn);
+
+
 struct cxa_ioStream
 {
 	cxa_ioStream_cb_readByte_t readCb;
+	cxa_ioStream_cb_readBytes_t readBytesCb;
 	cxa_ioStream_cb_writeBytes_t writeCb;
 
 	void *userVar;
+
+	bool notifiesDataAvailable;
+	cxa_ioStream_cb_onDataAvailable_t cb_onDataAvailable;
+	void *onDataAvailable_userVar;
 };
 
 
@@ -85,7 +115,58 @@ void cxa_ioStream_bind(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readByt
 void cxa_ioStream_unbind(cxa_ioStream_t *const ioStreamIn);
 bool cxa_ioStream_isBound(cxa_ioStream_t *const ioStreamIn);
 
+/**
+ * @public
+ * Registers the reader's data-available callback (one per ioStream, survives
+ * bind / unbind). The callback is also called whenever the ioStream is bound or
+ * unbound, so a waiting reader can re-check the stream.
+ */
+void cxa_ioStream_setDataAvailableListener(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_onDataAvailable_t cbIn, void *const userVarIn);
+
+/**
+ * @public
+ * @return true if the data-available listener will be called when there is
+ * 		something new to read: the bound implementation notifies whenever new
+ * 		data arrives, or the ioStream is unbound (binding notifies). A reader
+ * 		that gets no data from such a stream can wait for the listener rather
+ * 		than polling.
+ */
+bool cxa_ioStream_notifiesDataAvailable(cxa_ioStream_t *const ioStreamIn);
+
+/**
+ * @protected
+ * For implementations: declares (after ::cxa_ioStream_bind, which clears it)
+ * that ::cxa_ioStream_notify_dataAvailable is called whenever new data arrives
+ */
+void cxa_ioStream_setNotifiesDataAvailable(cxa_ioStream_t *const ioStreamIn, bool notifiesIn);
+
+/**
+ * @protected
+ * For implementations: calls the data-available listener (if any). Must be
+ * called from a context that may call ::cxa_runLoop_entry_resume.
+ */
+void cxa_ioStream_notify_dataAvailable(cxa_ioStream_t *const ioStreamIn);
+
+/**
+ * @protected
+ * For implementations: provides a block read (after ::cxa_ioStream_bind, which
+ * clears it). Without one, ::cxa_ioStream_readBytes reads a byte at a time.
+ */
+void cxa_ioStream_setReadBytesCb(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readBytes_t readBytesCbIn);
+
 cxa_ioStream_readStatus_t cxa_ioStream_readByte(cxa_ioStream_t *const ioStreamIn, uint8_t *const byteOut);
+
+/**
+ * @public
+ * Reads up to maxNumBytesIn bytes in a single call (one copy for implementations
+ * with a block read, otherwise byte by byte until the stream runs dry)
+ *
+ * @param numBytesReadOut the number of bytes read (may be NULL)
+ *
+ * @return CXA_IOSTREAM_READSTAT_GOTDATA if any bytes were read. An error that
+ * 		occurs after some bytes were read is reported by the next call.
+ */
+cxa_ioStream_readStatus_t cxa_ioStream_readBytes(cxa_ioStream_t *const ioStreamIn, void *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut);
 bool cxa_ioStream_waitForCharSequence_withTimeout(cxa_ioStream_t *const ioStreamIn, const char* targetSeqIn, uint32_t timeout_msIn);
 
 void cxa_ioStream_clearReadBuffer(cxa_ioStream_t *const ioStreamIn);
@@ -95,6 +176,17 @@ bool cxa_ioStream_writeBytes(cxa_ioStream_t *const ioStreamIn, void* buffIn, siz
 bool cxa_ioStream_writeFixedByteBuffer(cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const fbbIn);
 bool cxa_ioStream_writeString(cxa_ioStream_t *const ioStreamIn, const char* stringIn);
 bool cxa_ioStream_writeLine(cxa_ioStream_t *const ioStreamIn, const char* stringIn);
+
+/**
+ * @public
+ * Typed number writers that don't go through printf (see cxa_stringUtils_formatX
+ * for the formats)
+ */
+bool cxa_ioStream_writeUint32(cxa_ioStream_t *const ioStreamIn, uint32_t valIn);
+bool cxa_ioStream_writeInt32(cxa_ioStream_t *const ioStreamIn, int32_t valIn);
+bool cxa_ioStream_writeHex(cxa_ioStream_t *const ioStreamIn, uint32_t valIn, uint8_t minNumDigitsIn);
+bool cxa_ioStream_writeFixed(cxa_ioStream_t *const ioStreamIn, int32_t valIn, uint8_t numFracDigitsIn);
+
 bool cxa_ioStream_writeFormattedString(cxa_ioStream_t *const ioStreamIn, const char* formatIn, ...);
 bool cxa_ioStream_writeFormattedLine(cxa_ioStream_t *const ioStreamIn, const char* formatIn, ...);
 
@@ -17,6 +17,7 @@
 #include <cxa_array.h>
 #include <cxa_ioStream.h>
 #include <cxa_logger_header.h>
+#include <cxa_stateMachine.h>
 #include <cxa_timeDiff.h>
 
 
@@ -140,6 +141,7 @@ struct cxa_protocolParser
 	cxa_timeDiff_t td_timeout;
 
 	cxa_ioStream_t* ioStream;
+	cxa_stateMachine_t* rxStateMachine;
 
 	cxa_fixedByteBuffer_t* currBuffer;
 
@@ -269,6 +271,24 @@ bool cxa_protocolParser_writePacket_bytes(cxa_protocolParser_t *const ppIn, void
 void cxa_protocolParser_resetError(cxa_protocolParser_t *const ppIn);
 
 
+/**
+ * @protected
+ * Lets the subclass' receive state machine sleep in its event-driven states: it
+ * is suspended while idle and kicked when the ioStream has data (or is bound /
+ * unbound) and when the buffer changes.
+ */
+void cxa_protocolParser_setRxStateMachine(cxa_protocolParser_t *const ppIn, cxa_stateMachine_t *const smIn);
+
+
+/**
+ * @protected
+ * Called by an event-driven receive state that stays in its state after a read:
+ * it runs again on the next iteration if the read got data (more may be
+ * waiting) or the ioStream can't notify us, otherwise once the ioStream has data.
+ */
+void cxa_protocolParser_continueReading(cxa_protocolParser_t *const ppIn, cxa_ioStream_readStatus_t lastReadStatIn);
+
+
 /**
  * @protected
  */
@@ -11,14 +11,13 @@
 // ******** includes ********
 #include <stdint.h>
 #include <cxa_array.h>
+#include <cxa_runLoop.h>
+#include <cxa_timeDiff.h>
 
 #include <cxa_config.h>
 #ifdef CXA_STATE_MACHINE_ENABLE_LOGGING
 	#include <cxa_logger_header.h>
 #endif
-#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
-	#include <cxa_timeDiff.h>
-#endif
 
 
 // ******** global macro definitions ********
@@ -29,6 +28,52 @@
 #define CXA_STATE_MACHINE_STATE_UNKNOWN						-1
 
 
+/**
+ * @public
+ * Declares an entry of a const state table (see ::cxa_stateMachine_init_stateTable).
+ * Entries are placed at the index of their state id, so ids must be dense
+ * (eg. an enum starting at 0). The `_FULL` variants mirror
+ * ::cxa_stateMachine_addState_full (entering and left callbacks). Event-driven
+ * states are declared with a designated initializer:
+ * `[STATE_X] = { .stateId=STATE_X, .stateName="x", ..., .isEventDriven=true }`
+ */
+#define CXA_STATE_MACHINE_STATE_FULL(idIn, nameIn, cb_enteringIn, cb_enteredIn, cb_stateIn, cb_leavingIn, cb_leftIn, userVarIn)		\
+	[(idIn)] = {																							\
+		.type=CXA_STATE_MACHINE_STATE_TYPE_NORMAL,															\
+		.stateId=(idIn),																					\
+		.stateName=(nameIn),																				\
+		.cb_entering=(cb_enteringIn),																		\
+		.cb_entered=(cb_enteredIn),																			\
+		.cb_state=(cb_stateIn),																				\
+		.cb_leaving=(cb_leavingIn),																			\
+		.cb_left=(cb_leftIn),																				\
+		.userVar=(userVarIn)																				\
+	}
+
+#define CXA_STATE_MACHINE_STATE(idIn, nameIn, cb_enteredIn, cb_stateIn, cb_leavingIn, userVarIn)		\
+	CXA_STATE_MACHINE_STATE_FULL((idIn), (nameIn), NULL, (cb_enteredIn), (cb_stateIn), (cb_leavingIn), NULL, (userVarIn))
+
+#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
+#define CXA_STATE_MACHINE_STATE_TIMED_FULL(idIn, nameIn, nextStateIdIn, stateTime_msIn, cb_enteringIn, cb_enteredIn, cb_stateIn, cb_leavingIn, cb_leftIn, userVarIn)		\
+	[(idIn)] = {																							\
+		.type=CXA_STATE_MACHINE_STATE_TYPE_TIMED,															\
+		.stateId=(idIn),																					\
+		.stateName=(nameIn),																				\
+		.cb_entering=(cb_enteringIn),																		\
+		.cb_entered=(cb_enteredIn),																			\
+		.cb_state=(cb_stateIn),																				\
+		.cb_leaving=(cb_leavingIn),																			\
+		.cb_left=(cb_leftIn),																				\
+		.userVar=(userVarIn),																				\
+		.nextStateId=(nextStateIdIn),																		\
+		.stateTime_ms=(stateTime_msIn)																		\
+	}
+
+#define CXA_STATE_MACHINE_STATE_TIMED(idIn, nameIn, nextStateIdIn, stateTime_msIn, cb_enteredIn, cb_stateIn, cb_leavingIn, userVarIn)		\
+	CXA_STATE_MACHINE_STATE_TIMED_FULL((idIn), (nameIn), (nextStateIdIn), (stateTime_msIn), NULL, (cb_enteredIn), (cb_stateIn), (cb_leavingIn), NULL, (userVarIn))
+#endif
+
+
 // ******** global type definitions *********
 /**
  * @public
@@ -63,7 +108,10 @@ typedef enum
  */
 typedef struct
 {
-	cxa_stateMachine_stateType_t type;
+	// a cxa_stateMachine_stateType_t, narrowed so isEventDriven fits in the
+	// padding before stateId (the struct is no larger than without it)
+	uint8_t type;
+	bool isEventDriven;
 
 	int stateId;
 	const char* stateName;
@@ -87,13 +135,26 @@ typedef struct
  */
 struct cxa_stateMachine
 {
-	cxa_stateMachine_state_t* currState;
-	cxa_stateMachine_state_t* nextState;
+	const cxa_stateMachine_state_t* currState;
+	const cxa_stateMachine_state_t* nextState;
 
 	bool hasStarted;
 
-	cxa_array_t states;
-	cxa_stateMachine_state_t states_raw[CXA_STATE_MACHINE_MAXNUM_STATES];
+	cxa_runLoop_entryHandle_t runLoopEntry;
+	bool suspendWhenIdle;
+	volatile bool isKicked;
+
+	bool hasKickDeadline;
+	uint32_t kickDelay_ms;
+	cxa_timeDiff_t td_kick;
+
+	const cxa_stateMachine_state_t* stateTable;
+	size_t stateTable_numStates;
+
+	#ifndef CXA_STATE_MACHINE_DISABLE_DYNAMIC_STATES
+		cxa_array_t states;
+		cxa_stateMachine_state_t states_raw[CXA_STATE_MACHINE_MAXNUM_STATES];
+	#endif
 
 	#ifdef CXA_STATE_MACHINE_ENABLE_LOGGING
 		cxa_logger_t logger;
@@ -109,6 +170,30 @@ struct cxa_stateMachine
 // ******** global function prototypes ********
 void cxa_stateMachine_init(cxa_stateMachine_t *const smIn, const char* nameIn, int threadIdIn);
 
+/**
+ * @public
+ * Initializes a state machine whose states are declared up-front in a const table
+ * (which can live in flash) rather than added at runtime. The table is indexed
+ * directly by state id, so state lookups (eg. on every transition) are O(1).
+ * States cannot be added to a state machine initialized this way.
+ *
+ * @code
+ * static const cxa_stateMachine_state_t STATES[] = {
+ * 	CXA_STATE_MACHINE_STATE(STATE_IDLE, "idle", stateCb_idle_enter, NULL, NULL, NULL),
+ * 	CXA_STATE_MACHINE_STATE(STATE_RUN, "run", NULL, stateCb_run_state, NULL, NULL),
+ * };
+ *
+ * cxa_stateMachine_init_stateTable(&sm, "myFsm", STATES, sizeof(STATES)/sizeof(*STATES), CXA_RUNLOOP_THREADID_DEFAULT);
+ * @endcode
+ *
+ * @param stateTableIn table of states where the state at index i has id i
+ * @param numStatesIn number of entries in stateTableIn
+ */
+void cxa_stateMachine_init_stateTable(cxa_stateMachine_t *const smIn, const char* nameIn,
+		const cxa_stateMachine_state_t *const stateTableIn, size_t numStatesIn,
+		int threadIdIn);
+
+#ifndef CXA_STATE_MACHINE_DISABLE_DYNAMIC_STATES
 void cxa_stateMachine_addState(cxa_stateMachine_t *const smIn, int idIn, const char* nameIn,
 	cxa_stateMachine_cb_entered_t cb_enteredIn, cxa_stateMachine_cb_state_t cb_stateIn, cxa_stateMachine_cb_leaving_t cb_leavingIn,
 	void *userVarIn);
@@ -129,12 +214,62 @@ void cxa_stateMachine_addState_timed_full(cxa_stateMachine_t *const smIn, int id
 		cxa_stateMachine_cb_leaving_t cb_leavingIn, cxa_stateMachine_cb_left_t cb_leftIn,
 		void *userVarIn);
 #endif
+#endif
 
 void cxa_stateMachine_setInitialState(cxa_stateMachine_t *const smIn, int stateIdIn);
 
+#ifndef CXA_STATE_MACHINE_DISABLE_DYNAMIC_STATES
+/**
+ * @public
+ * By default, the state callback of the current state is called every runLoop
+ * iteration. Event-driven states (those waiting on an external event) can opt out
+ * of this polling: their state callback is then only called after entering the
+ * state and after each call to ::cxa_stateMachine_kick.
+ *
+ * See also ::cxa_stateMachine_setSuspendWhenIdle
+ *
+ * @note only for states added at runtime (table states declare `isEventDriven`)
+ */
+void cxa_stateMachine_setStateIsPolled(cxa_stateMachine_t *const smIn, int stateIdIn, bool isPolledIn);
+#endif
+
+/**
+ * @public
+ * By default, a state machine's runLoop entry runs every iteration. A state
+ * machine whose states only change through transitions, kicks and timeouts
+ * can instead have its entry suspended while there is nothing to do: while in
+ * a state without a state callback (or an event-driven state that hasn't been
+ * kicked), it is not scheduled until the next transition or kick (timed states
+ * and ::cxa_stateMachine_kickAfter deadlines are woken at their deadline). This
+ * lets ::cxa_runLoop_execute sleep.
+ *
+ * Transitions and kicks then resume the entry, so only enable this if every
+ * context that transitions or kicks this state machine may call
+ * ::cxa_runLoop_entry_resume (eg. not from a posix signal handler).
+ */
+void cxa_stateMachine_setSuspendWhenIdle(cxa_stateMachine_t *const smIn, bool suspendWhenIdleIn);
+
 void cxa_stateMachine_transition(cxa_stateMachine_t *const smIn, int stateIdIn);
 void cxa_stateMachine_transitionNow(cxa_stateMachine_t *const smIn, int stateIdIn);
 
+/**
+ * @public
+ * Schedules a call of the current state's state callback on the next runLoop
+ * iteration (for use by event sources of non-polled states)
+ */
+void cxa_stateMachine_kick(cxa_stateMachine_t *const smIn);
+
+/**
+ * @public
+ * Kicks the state machine once the given time has elapsed (unless it transitions
+ * first). Lets an event-driven state wait for a timeout (eg. a keepalive) without
+ * being polled. A later call replaces an earlier deadline.
+ *
+ * @note must be called from the state machine's runLoop thread (typically from
+ * 		its own state callbacks)
+ */
+void cxa_stateMachine_kickAfter(cxa_stateMachine_t *const smIn, uint32_t delay_msIn);
+
 int cxa_stateMachine_getCurrentState(cxa_stateMachine_t *const smIn);
 
 
@@ -0,0 +1,160 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * This file contains an implementation of a fixed-size performance statistics
+ * accumulator. Each sample consists of a latency (in microseconds) and a number of
+ * bytes. Latencies are stored in a log-linear histogram so percentiles can be
+ * estimated without storing individual samples (accurate to within
+ * 1/(2^CXA_PERFSTATS_SUBBUCKET_BITS) of the true value).
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_perfStats_t stats_rpc;
+ * cxa_perfStats_init(&stats_rpc);
+ *
+ * ...
+ *
+ * // when the request is sent
+ * cxa_timeDiff_setStartTime_now(&td_request);
+ *
+ * ...
+ *
+ * // when the response is received
+ * cxa_perfStats_recordSample(&stats_rpc, cxa_timeDiff_getElapsedTime_us(&td_request), responseSize_bytes);
+ *
+ * ...
+ *
+ * cxa_perfStats_writeReport(&stats_rpc, "rpc", ios_console);
+ * @endcode
+ */
+#ifndef CXA_PERFSTATS_H_
+#define CXA_PERFSTATS_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cxa_ioStream.h>
+#include <cxa_timeDiff.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_PERFSTATS_SUBBUCKET_BITS
+	#define CXA_PERFSTATS_SUBBUCKET_BITS				2
+#endif
+
+#define CXA_PERFSTATS_NUM_BUCKETS						((33 - CXA_PERFSTATS_SUBBUCKET_BITS) << CXA_PERFSTATS_SUBBUCKET_BITS)
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_perfStats_t object
+ */
+typedef struct cxa_perfStats cxa_perfStats_t;
+
+
+/**
+ * @private
+ */
+struct cxa_perfStats
+{
+	uint32_t numSamples;
+	uint64_t numBytes;
+
+	uint32_t minLatency_us;
+	uint32_t maxLatency_us;
+	uint64_t sumLatency_us;
+
+	uint32_t buckets[CXA_PERFSTATS_NUM_BUCKETS];
+
+	cxa_timeDiff_t td_window;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * Initializes the statistics (and starts the measurement window)
+ */
+void cxa_perfStats_init(cxa_perfStats_t *const statsIn);
+
+
+/**
+ * @public
+ * Discards all samples and restarts the measurement window
+ */
+void cxa_perfStats_reset(cxa_perfStats_t *const statsIn);
+
+
+/**
+ * @public
+ * Records a single sample (eg. a message or request/response)
+ *
+ * @param latency_usIn the latency of this sample, in microseconds
+ * @param numBytesIn the number of bytes transferred by this sample
+ */
+void cxa_perfStats_recordSample(cxa_perfStats_t *const statsIn, uint32_t latency_usIn, size_t numBytesIn);
+
+
+/**
+ * @public
+ * @return the number of samples recorded since init/reset
+ */
+uint32_t cxa_perfStats_getNumSamples(cxa_perfStats_t *const statsIn);
+
+
+/**
+ * @public
+ * @return the estimated latency (in microseconds) below which the given percentage
+ * 		of samples fall (eg. 50 for the median, 99 for the tail), or 0 if there are
+ * 		no samples
+ */
+uint32_t cxa_perfStats_getPercentile_us(cxa_perfStats_t *const statsIn, uint8_t percentIn);
+
+
+/**
+ * @public
+ * @return the mean latency in microseconds, or 0 if there are no samples
+ */
+uint32_t cxa_perfStats_getMeanLatency_us(cxa_perfStats_t *const statsIn);
+
+
+/**
+ * @public
+ * @return the number of samples per second since init/reset
+ */
+uint32_t cxa_perfStats_getSamplesPerSec(cxa_perfStats_t *const statsIn);
+
+
+/**
+ * @public
+ * @return the number of bytes per second since init/reset
+ */
+uint32_t cxa_perfStats_getBytesPerSec(cxa_perfStats_t *const statsIn);
+
+
+/**
+ * @public
+ * Writes a single-line summary of the statistics to the given ioStream
+ *
+ * @param nameIn descriptive name of what was measured
+ *
+ * @return true on successful write
+ */
+bool cxa_perfStats_writeReport(cxa_perfStats_t *const statsIn, const char *const nameIn, cxa_ioStream_t *const ioStreamIn);
+
+
+#endif // CXA_PERFSTATS_H_
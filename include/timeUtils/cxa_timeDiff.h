@@ -9,6 +9,9 @@
  * @file
  * This file contains an implementation of a time differential. Time differentials
  * allow the user to judge the passage of time (as compared to a reference time base).
+ * They are based on the 64-bit ::cxa_timeBase_getCount64_us so they are not limited
+ * by the range of ::cxa_timeBase_getMaxCount_us (millisecond intervals can be up to
+ * ~49 days long).
  *
  * @note This object should work across all architecture-specific implementations
  *
@@ -51,7 +54,7 @@
 // ******** global type definitions *********
 typedef struct
 {
-	uint32_t startTime_us;
+	uint64_t startTime_us;
 }cxa_timeDiff_t;
 
 
@@ -86,6 +89,17 @@ void cxa_timeDiff_setStartTime_now(cxa_timeDiff_t *const tdIn);
  */
 uint32_t cxa_timeDiff_getElapsedTime_ms(cxa_timeDiff_t *const tdIn);
 
+/**
+ * @public
+ *
+ * @param[in] tdIn the pre-initialized timeDiff
+ *
+ * @return the amount of time (in microseconds) since a call to
+ * 		setStartTime_now (as indicated by the reference timeBase), saturating
+ * 		at UINT32_MAX (~71 minutes)
+ */
+uint32_t cxa_timeDiff_getElapsedTime_us(cxa_timeDiff_t *const tdIn);
+
 /**
  * @public
  *
@@ -94,25 +108,36 @@ uint32_t cxa_timeDiff_getElapsedTime_ms(cxa_timeDiff_t *const tdIn);
  *
  * @return true if the specified amount of time has elapsed since the last
  * 		call to setStartTime_now. Once true is returned, this timeDiff
- * 		will return true until the following occurs:
- * 		1. setStartTime_now is called again
- * 		2. the timeBase "rolls" over
+ * 		will return true until setStartTime_now is called again
  */
 bool cxa_timeDiff_isElapsed_ms(cxa_timeDiff_t *const tdIn, uint32_t msIn);
 
 /**
  * @public
- * This is a convenience method which combines calls to isElapsed_ms and
- * setStartTime_now.
  *
  * @param[in] tdIn the pre-initialized timeDiff
  * @param[in] msIn the desired number of milliseconds
  *
- * @return true if the specified amount of time has elapsed since the last
- * 		call to setStartTime_now. Once true is returned, this function will
- * 		automatically call setStartTime_now. Thus, the next call to any
- * 		isElapsed function will likely return false (unless it is a small
- * 		time difference).
+ * @return the number of milliseconds until isElapsed_ms(msIn) returns true
+ * 		(0 if it already has)
+ */
+uint32_t cxa_timeDiff_getRemainingTime_ms(cxa_timeDiff_t *const tdIn, uint32_t msIn);
+
+/**
+ * @public
+ * This is a convenience method for periodic tasks, similar to calling isElapsed_ms
+ * followed by setStartTime_now.
+ *
+ * Rather than restarting at the current time, the start time is advanced by whole
+ * periods. This keeps the period from drifting by the caller's latency (eg. a 1Hz
+ * task still runs 86400 times per day). If more than one period has been missed,
+ * the missed periods are skipped rather than reported back-to-back.
+ *
+ * @param[in] tdIn the pre-initialized timeDiff
+ * @param[in] msIn the desired number of milliseconds
+ *
+ * @return true if the specified amount of time has elapsed since the start of the
+ * 		current period
  */
 bool cxa_timeDiff_isElapsed_recurring_ms(cxa_timeDiff_t *const tdIn, uint32_t msIn);
 
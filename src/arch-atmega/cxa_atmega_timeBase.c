@@ -7,6 +7,8 @@
 #include <cxa_atmega_timeBase.h>
 
 // ******** includes ********
+#include <util/atomic.h>
+
 #include <cxa_assert.h>
 
 
@@ -38,7 +40,7 @@ void cxa_atmega_timeBase_initWithTimer8(cxa_atmega_timer8_t *const timerIn)
 
 uint32_t cxa_timeBase_getCount_us(void)
 {
-	return (timer != NULL) ? (numOverflows * cxa_atmega_timer8_getOverflowPeriod_us(timer)) : 0;
+	return (uint32_t)cxa_timeBase_getCount64_us();
 }
 
 
@@ -48,6 +50,18 @@ uint32_t cxa_timeBase_getMaxCount_us(void)
 }
 
 
+uint64_t cxa_timeBase_getCount64_us(void)
+{
+	if( timer == NULL ) return 0;
+
+	// numOverflows is updated from our ISR
+	uint32_t currNumOverflows;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { currNumOverflows = numOverflows; }
+
+	return (uint64_t)currNumOverflows * cxa_atmega_timer8_getOverflowPeriod_us(timer);
+}
+
+
 // ******** local function implementations ********
 static void timer8_cb_onOverflow(cxa_atmega_timer8_t *const timerIn, void *userVarIn)
 {
@@ -8,10 +8,12 @@
 
 // ******** includes ********
 #include <cxa_assert.h>
+#include <cxa_criticalSection.h>
 #include <em_rtcc.h>
 
 
 // ******** local macro definitions ********
+#define RTCC_FREQ_HZ					32768
 
 
 // ******** local type definitions ********
@@ -21,6 +23,8 @@
 
 
 // ********  local variable declarations *********
+static uint32_t lastCount_cnts = 0;
+static uint64_t overflowedCount_cnts = 0;
 
 
 // ******** global function implementations ********
@@ -36,4 +40,18 @@ uint32_t cxa_timeBase_getMaxCount_us(void)
 }
 
 
+uint64_t cxa_timeBase_getCount64_us(void)
+{
+	// extend the 32-bit RTCC by accumulating its overflows
+	cxa_criticalSection_enter();
+	uint32_t currCount_cnts = RTCC_CounterGet();
+	if( currCount_cnts < lastCount_cnts ) overflowedCount_cnts += ((uint64_t)UINT32_MAX + 1);
+	lastCount_cnts = currCount_cnts;
+	uint64_t totalCount_cnts = overflowedCount_cnts + currCount_cnts;
+	cxa_criticalSection_exit();
+
+	return (totalCount_cnts * 1000000) / RTCC_FREQ_HZ;
+}
+
+
 // ******** local function implementations ********
@@ -33,7 +33,7 @@ void cxa_esp32_timeBase_init(void)
 
 uint32_t cxa_timeBase_getCount_us(void)
 {
-	return esp_timer_get_time() % UINT32_MAX;
+	return (uint32_t)cxa_timeBase_getCount64_us();
 }
 
 
@@ -43,4 +43,11 @@ uint32_t cxa_timeBase_getMaxCount_us(void)
 }
 
 
+uint64_t cxa_timeBase_getCount64_us(void)
+{
+	// already a 64-bit, monotonic count since boot
+	return (uint64_t)esp_timer_get_time();
+}
+
+
 // ******** local function implementations ********
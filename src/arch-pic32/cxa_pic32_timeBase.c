@@ -9,6 +9,7 @@
 
 // ******** includes ********
 #include <cxa_assert.h>
+#include <cxa_criticalSection.h>
 
 
 // ******** local macro definitions ********
@@ -21,6 +22,8 @@
 
 
 // ********  local variable declarations *********
+static TickType_t lastCount_ticks = 0;
+static uint64_t overflowedCount_ticks = 0;
 
 
 // ******** global function implementations ********
@@ -36,4 +39,18 @@ uint32_t cxa_timeBase_getMaxCount_us(void)
 }
 
 
+uint64_t cxa_timeBase_getCount64_us(void)
+{
+	// extend the tick count by accumulating its overflows
+	cxa_criticalSection_enter();
+	TickType_t currCount_ticks = xTaskGetTickCount();
+	if( currCount_ticks < lastCount_ticks ) overflowedCount_ticks += ((uint64_t)((TickType_t)-1) + 1);
+	lastCount_ticks = currCount_ticks;
+	uint64_t totalCount_ticks = overflowedCount_ticks + currCount_ticks;
+	cxa_criticalSection_exit();
+
+	return (totalCount_ticks * 1000000) / configTICK_RATE_HZ;
+}
+
+
 // ******** local function implementations ********
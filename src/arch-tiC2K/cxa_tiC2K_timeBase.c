@@ -4,14 +4,19 @@
  *
  * @author Christopher Armenio
  */
-#include <cxa_timeBase.h>
+#include "cxa_tiC2K_timeBase.h"
 
 
 // ******** includes ********
+#include <stdbool.h>
+
+#include <device.h>
 #include <cxa_assert.h>
+#include <cxa_criticalSection.h>
 
 
 // ******** local macro definitions ********
+#define TICKS_PER_US						(DEVICE_SYSCLK_FREQ / 1000000UL)
 
 
 // ******** local type definitions ********
@@ -21,18 +26,41 @@
 
 
 // ********  local variable declarations *********
+static uint32_t timerBase = 0;
+static bool isInit = false;
+
+static uint32_t lastCount_us = 0;
+static uint64_t overflowedCount_us = 0;
 
 
 // ******** global function implementations ********
-void cxa_esp32_timeBase_init(void)
+void cxa_tiC2K_timeBase_init(uint32_t cpuTimerBaseIn)
 {
+	cxa_assert((TICKS_PER_US > 0) && (TICKS_PER_US <= 0x10000UL));
+
+	timerBase = cpuTimerBaseIn;
+
+	// count down from 0xFFFFFFFF once per microsecond, forever
+	CPUTimer_stopTimer(timerBase);
+	CPUTimer_setPeriod(timerBase, UINT32_MAX);
+	CPUTimer_setPreScaler(timerBase, (uint16_t)(TICKS_PER_US - 1));
+	CPUTimer_disableInterrupt(timerBase);
+	CPUTimer_setEmulationMode(timerBase, CPUTIMER_EMULATIONMODE_RUNFREE);
+	CPUTimer_reloadTimerCounter(timerBase);
+	CPUTimer_startTimer(timerBase);
+
+	lastCount_us = 0;
+	overflowedCount_us = 0;
+	isInit = true;
 }
 
 
 uint32_t cxa_timeBase_getCount_us(void)
 {
-//	return esp_timer_get_time() % UINT32_MAX;
-    return 0;
+	cxa_assert(isInit);
+
+	// the timer counts down
+	return UINT32_MAX - CPUTimer_getTimerCount(timerBase);
 }
 
 
@@ -42,4 +70,18 @@ uint32_t cxa_timeBase_getMaxCount_us(void)
 }
 
 
+uint64_t cxa_timeBase_getCount64_us(void)
+{
+	// extend the timer by accumulating its overflows
+	cxa_criticalSection_enter();
+	uint32_t currCount_us = cxa_timeBase_getCount_us();
+	if( currCount_us < lastCount_us ) overflowedCount_us += ((uint64_t)UINT32_MAX + 1);
+	lastCount_us = currCount_us;
+	uint64_t retVal = overflowedCount_us + currCount_us;
+	cxa_criticalSection_exit();
+
+	return retVal;
+}
+
+
 // ******** local function implementations ********
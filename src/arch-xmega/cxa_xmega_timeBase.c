@@ -9,6 +9,7 @@
 
 // ******** includes ********
 #include <cxa_assert.h>
+#include <cxa_criticalSection.h>
 
 
 // ******** local macro definitions ********
@@ -23,6 +24,9 @@
 // ********  local variable declarations *********
 static cxa_xmega_timer32_t* timer = NULL;
 
+static uint32_t lastCount_cnts = 0;
+static uint64_t overflowedCount_cnts = 0;
+
 
 // ******** global function implementations ********
 void cxa_xmega_timeBase_init_timer32(cxa_xmega_timer32_t *const timerIn)
@@ -50,4 +54,20 @@ uint32_t cxa_timeBase_getMaxCount_us(void)
 }
 
 
+uint64_t cxa_timeBase_getCount64_us(void)
+{
+	cxa_assert(timer);
+
+	// extend the hardware counter by accumulating its overflows
+	cxa_criticalSection_enter();
+	uint32_t currCount_cnts = cxa_xmega_timer32_getCount(timer);
+	if( currCount_cnts < lastCount_cnts ) overflowedCount_cnts += (uint64_t)cxa_xmega_timer32_getMaxVal_cnts(timer) + 1;
+	lastCount_cnts = currCount_cnts;
+	uint64_t totalCount_cnts = overflowedCount_cnts + currCount_cnts;
+	cxa_criticalSection_exit();
+
+	return totalCount_cnts * (1000000 / cxa_xmega_timer32_getResolution_cntsPerS(timer));
+}
+
+
 // ******** local function implementations ********
@@ -125,6 +125,8 @@ void cxa_blueGiga_btle_client_init(cxa_blueGiga_btle_client_t *const btlecIn, cx
 	cxa_stateMachine_addState(&btlecIn->stateMachine_conn, CONNSTATE_READY, "ready", stateCb_conn_ready_enter, NULL, NULL, (void*)btlecIn);
 	cxa_stateMachine_addState(&btlecIn->stateMachine_conn, CONNSTATE_SCANNING, "scanning", stateCb_conn_scanning_enter, NULL, stateCb_conn_scanning_leave, (void*)btlecIn);
 	cxa_stateMachine_setInitialState(&btlecIn->stateMachine_conn, CONNSTATE_RESET);
+	// we're driven by responses / events from the module (and our timed states)
+	cxa_stateMachine_setSuspendWhenIdle(&btlecIn->stateMachine_conn, true);
 }
 
 
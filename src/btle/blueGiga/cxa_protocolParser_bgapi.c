@@ -71,6 +71,12 @@ void cxa_protocolParser_bgapi_init(cxa_protocolParser_bgapi_t *const ppIn, cxa_i
 	cxa_stateMachine_addState(&ppIn->stateMachine, RX_STATE_PROCESS_PACKET, "processPacket", stateCb_processPacket_enter, NULL, NULL, (void*)ppIn);
 	cxa_stateMachine_addState(&ppIn->stateMachine, RX_STATE_ERROR, "error", stateCb_error_enter, NULL, NULL, (void*)ppIn);
 	cxa_stateMachine_setInitialState(&ppIn->stateMachine, RX_STATE_IDLE);
+
+	// our waiting states only run when the ioStream has data (or times out)
+	cxa_stateMachine_setStateIsPolled(&ppIn->stateMachine, RX_STATE_IDLE, false);
+	cxa_stateMachine_setStateIsPolled(&ppIn->stateMachine, RX_STATE_WAIT_PACKET_START, false);
+	cxa_stateMachine_setStateIsPolled(&ppIn->stateMachine, RX_STATE_WAIT_PACKETRX, false);
+	cxa_protocolParser_setRxStateMachine(&ppIn->super, &ppIn->stateMachine);
 }
 
 
@@ -174,6 +180,9 @@ static void stateCb_idle_state(cxa_stateMachine_t *const smIn, void *userVarIn)
 		cxa_stateMachine_transition(&ppIn->stateMachine, RX_STATE_WAIT_PACKET_START);
 		return;
 	}
+
+	// binding our ioStream or setting a buffer kicks us
+	cxa_protocolParser_continueReading(&ppIn->super, CXA_IOSTREAM_READSTAT_NODATA);
 }
 
 
@@ -203,9 +212,10 @@ static void stateCb_waitPacketStart_state(cxa_stateMachine_t *const smIn, void *
 
 	// try to receive a byte
 	uint8_t rxByte;
+	cxa_ioStream_readStatus_t readStat = CXA_IOSTREAM_READSTAT_NODATA;
 	for( uint8_t i = 0; i < MAX_NUM_RX_BYTES_PER_UPDATE; i++ )
 	{
-		cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(ppIn->super.ioStream, &rxByte);
+		readStat = cxa_ioStream_readByte(ppIn->super.ioStream, &rxByte);
 		if( readStat == CXA_IOSTREAM_READSTAT_ERROR )
 		{
 			cxa_stateMachine_transition(&ppIn->stateMachine, RX_STATE_ERROR);
@@ -230,6 +240,8 @@ static void stateCb_waitPacketStart_state(cxa_stateMachine_t *const smIn, void *
 			break;
 		}
 	}
+
+	cxa_protocolParser_continueReading(&ppIn->super, readStat);
 }
 
 
@@ -250,9 +262,10 @@ static void stateCb_waitPacketRx_state(cxa_stateMachine_t *const smIn, void *use
 
 	// try to receive a byte
 	uint8_t rxByte;
+	cxa_ioStream_readStatus_t readStat = CXA_IOSTREAM_READSTAT_NODATA;
 	for( uint8_t i = 0; i < MAX_NUM_RX_BYTES_PER_UPDATE; i++ )
 	{
-		cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(ppIn->super.ioStream, &rxByte);
+		readStat = cxa_ioStream_readByte(ppIn->super.ioStream, &rxByte);
 		if( readStat == CXA_IOSTREAM_READSTAT_ERROR )
 		{
 			cxa_stateMachine_transition(&ppIn->stateMachine, RX_STATE_ERROR);
@@ -300,6 +313,10 @@ static void stateCb_waitPacketRx_state(cxa_stateMachine_t *const smIn, void *use
 		cxa_stateMachine_transition(&ppIn->stateMachine, RX_STATE_WAIT_PACKET_START);
 		return;
 	}
+
+	// keep reading (and wake up for our reception timeout)
+	cxa_protocolParser_continueReading(&ppIn->super, readStat);
+	cxa_stateMachine_kickAfter(&ppIn->stateMachine, cxa_timeDiff_getRemainingTime_ms(&ppIn->super.td_timeout, RECEPTION_TIMEOUT_MS));
 }
 
 
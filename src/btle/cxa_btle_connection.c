@@ -10,6 +10,7 @@
 // ******** includes ********
 #include <cxa_assert.h>
 #include <cxa_btle_central.h>
+#include <cxa_runLoop.h>
 
 #include <string.h>
 
@@ -18,12 +19,22 @@
 
 
 // ******** local macro definitions ********
+#define PROCEDURE_READ					0x01
+#define PROCEDURE_WRITE					0x02
+#define PROCEDURE_SUBSCRIBE				0x04
+#define PROCEDURE_UNSUBSCRIBE			0x08
 
 
 // ******** local type definitions ********
 
 
 // ******** local function prototypes ********
+static void resetLinkState(cxa_btle_connection_t *const connIn);
+static void notifyLinkChanged(cxa_btle_connection_t *const connIn);
+
+static void markActivity(cxa_btle_connection_t *const connIn);
+static void scheduleIdleCheck(cxa_btle_connection_t *const connIn, uint32_t delay_msIn);
+static void runLoopOneShot_checkIdle(void* userVarIn);
 
 
 // ********  local variable declarations *********
@@ -35,6 +46,7 @@ void cxa_btle_connection_init(cxa_btle_connection_t *const connIn,
 							  cxa_btle_connection_scm_stopConnection_t scm_stopConnectionIn,
 							  cxa_btle_connection_scm_readFromCharacteristic_t scm_readFromCharIn,
 							  cxa_btle_connection_scm_writeToCharacteristic_t scm_writeToCharIn,
+							  cxa_btle_connection_scm_writeToCharacteristic_noResponse_t scm_writeToCharNoRspIn,
 							  cxa_btle_connection_scm_changeNotifications_t scm_changeNotiIndisIn)
 {
 	cxa_assert(connIn);
@@ -42,21 +54,43 @@ void cxa_btle_connection_init(cxa_btle_connection_t *const connIn,
 
 	// save our references
 	connIn->btlec = btlecIn;
+	connIn->attMtu = CXA_BTLE_CONNECTION_DEFAULT_ATT_MTU;
 
 	// save our subclass methods
 	connIn->scms.stopConnection = scm_stopConnectionIn;
 	connIn->scms.readFromCharacteristic = scm_readFromCharIn;
 	connIn->scms.writeToCharacteristic = scm_writeToCharIn;
+	connIn->scms.writeToCharacteristic_noResponse = scm_writeToCharNoRspIn;
 	connIn->scms.changeNotifications = scm_changeNotiIndisIn;
+	connIn->scms.requestParameters = NULL;
+	connIn->scms.requestPhy = NULL;
+	connIn->scms.requestDataLength = NULL;
 
 	// clear out our callbacks
 	memset(&connIn->cbs, 0, sizeof(connIn->cbs));
 
+	// setup our link state
+	connIn->adaptive.isCheckPending = false;
+	resetLinkState(connIn);
+
 	// setup our noti/indi subscriptions
 	cxa_array_initStd(&connIn->notiIndiSubs, connIn->notiIndiSubs_raw);
 }
 
 
+void cxa_btle_connection_setLinkScms(cxa_btle_connection_t *const connIn,
+									 cxa_btle_connection_scm_requestParameters_t scm_requestParamsIn,
+									 cxa_btle_connection_scm_requestPhy_t scm_requestPhyIn,
+									 cxa_btle_connection_scm_requestDataLength_t scm_requestDataLengthIn)
+{
+	cxa_assert(connIn);
+
+	connIn->scms.requestParameters = scm_requestParamsIn;
+	connIn->scms.requestPhy = scm_requestPhyIn;
+	connIn->scms.requestDataLength = scm_requestDataLengthIn;
+}
+
+
 void cxa_btle_connection_setTargetAddress(cxa_btle_connection_t *const connIn,
 										  cxa_eui48_t *const targetAddrIn)
 {
@@ -66,6 +100,9 @@ void cxa_btle_connection_setTargetAddress(cxa_btle_connection_t *const connIn,
 	// set our address
 	cxa_eui48_initFromEui48(&connIn->targetAddr, targetAddrIn);
 
+	// MTU, PHY, etc must be re-negotiated for each connection
+	resetLinkState(connIn);
+
 	// clear out our callbacks
 	memset(&connIn->cbs, 0, sizeof(connIn->cbs));
 
@@ -92,6 +129,134 @@ cxa_eui48_t* cxa_btle_connection_getTargetMacAddress(cxa_btle_connection_t *cons
 }
 
 
+uint16_t cxa_btle_connection_getAttMtu(cxa_btle_connection_t *const connIn)
+{
+	cxa_assert(connIn);
+
+	return connIn->attMtu;
+}
+
+
+size_t cxa_btle_connection_getMaxAttPayloadSize_bytes(cxa_btle_connection_t *const connIn)
+{
+	cxa_assert(connIn);
+
+	return connIn->attMtu - CXA_BTLE_CONNECTION_ATT_WRITE_HEADER_SIZE_BYTES;
+}
+
+
+cxa_btle_connection_linkInfo_t* cxa_btle_connection_getLinkInfo(cxa_btle_connection_t *const connIn)
+{
+	cxa_assert(connIn);
+
+	return &connIn->linkInfo;
+}
+
+
+void cxa_btle_connection_setOnLinkChangedCb(cxa_btle_connection_t *const connIn,
+											cxa_btle_connection_cb_onLinkChanged_t cbIn,
+											void* userVarIn)
+{
+	cxa_assert(connIn);
+
+	// save our callback
+	connIn->cbs.linkChanged.func = cbIn;
+	connIn->cbs.linkChanged.userVar = userVarIn;
+}
+
+
+bool cxa_btle_connection_requestParameters(cxa_btle_connection_t *const connIn,
+										   cxa_btle_connection_parameters_t *const paramsIn)
+{
+	cxa_assert(connIn);
+	cxa_assert(paramsIn);
+
+	if( connIn->scms.requestParameters == NULL ) return false;
+	if( paramsIn->minInterval_us > paramsIn->maxInterval_us ) return false;
+
+	return connIn->scms.requestParameters(connIn, paramsIn);
+}
+
+
+bool cxa_btle_connection_requestPhy(cxa_btle_connection_t *const connIn,
+									uint8_t phyMaskIn)
+{
+	cxa_assert(connIn);
+
+	if( connIn->scms.requestPhy == NULL ) return false;
+	if( phyMaskIn == 0 ) return false;
+
+	return connIn->scms.requestPhy(connIn, phyMaskIn);
+}
+
+
+bool cxa_btle_connection_requestDataLength(cxa_btle_connection_t *const connIn,
+										   uint16_t dataLength_bytesIn)
+{
+	cxa_assert(connIn);
+
+	if( connIn->scms.requestDataLength == NULL ) return false;
+	if( (dataLength_bytesIn < CXA_BTLE_CONNECTION_DEFAULT_DATA_LENGTH_BYTES) ||
+		(dataLength_bytesIn > CXA_BTLE_CONNECTION_MAX_DATA_LENGTH_BYTES) ) return false;
+
+	return connIn->scms.requestDataLength(connIn, dataLength_bytesIn);
+}
+
+
+bool cxa_btle_connection_requestMaxThroughput(cxa_btle_connection_t *const connIn)
+{
+	cxa_assert(connIn);
+
+	// make sure we issue both requests
+	bool wasPhyAccepted = cxa_btle_connection_requestPhy(connIn, CXA_BTLE_CONNECTION_PHY_2M | CXA_BTLE_CONNECTION_PHY_1M);
+	bool wasDleAccepted = cxa_btle_connection_requestDataLength(connIn, CXA_BTLE_CONNECTION_MAX_DATA_LENGTH_BYTES);
+
+	return wasPhyAccepted || wasDleAccepted;
+}
+
+
+void cxa_btle_connection_enableAdaptiveInterval(cxa_btle_connection_t *const connIn,
+												int threadIdIn,
+												cxa_btle_connection_parameters_t *const params_fastIn,
+												cxa_btle_connection_parameters_t *const params_relaxedIn,
+												uint32_t idleTimeout_msIn)
+{
+	cxa_assert(connIn);
+	cxa_assert(params_fastIn);
+	cxa_assert(params_relaxedIn);
+
+	connIn->adaptive.threadId = threadIdIn;
+	connIn->adaptive.params_fast = *params_fastIn;
+	connIn->adaptive.params_relaxed = *params_relaxedIn;
+	connIn->adaptive.idleTimeout_ms = idleTimeout_msIn;
+
+	// assume we're relaxed until we see some activity
+	connIn->adaptive.isFast = false;
+	cxa_timeDiff_init(&connIn->adaptive.td_lastActivity);
+	connIn->adaptive.isEnabled = true;
+
+	// we may already be busy
+	if( connIn->activeProcedures != 0 ) markActivity(connIn);
+}
+
+
+void cxa_btle_connection_disableAdaptiveInterval(cxa_btle_connection_t *const connIn)
+{
+	cxa_assert(connIn);
+
+	// any pending idle check will see this and stop
+	connIn->adaptive.isEnabled = false;
+}
+
+
+bool cxa_btle_connection_hasPendingProcedures(cxa_btle_connection_t *const connIn)
+{
+	cxa_assert(connIn);
+
+	return (connIn->activeProcedures != 0);
+}
+
+
 void cxa_btle_connection_readFromCharacteristic(cxa_btle_connection_t *const connIn,
 												const char *const serviceUuidIn,
 												const char *const characteristicUuidIn,
@@ -114,6 +279,8 @@ void cxa_btle_connection_readFromCharacteristic(cxa_btle_connection_t *const con
 	connIn->cbs.readFromChar.userVar = userVarIn;
 
 	// actually perform the read
+	connIn->activeProcedures |= PROCEDURE_READ;
+	markActivity(connIn);
 	cxa_assert(connIn->scms.readFromCharacteristic);
 	connIn->scms.readFromCharacteristic(connIn, serviceUuidIn, characteristicUuidIn);
 }
@@ -142,6 +309,8 @@ void cxa_btle_connection_writeToCharacteristic(cxa_btle_connection_t *const conn
 	connIn->cbs.writeToChar.userVar = userVarIn;
 
 	// actually perform the write
+	connIn->activeProcedures |= PROCEDURE_WRITE;
+	markActivity(connIn);
 	cxa_assert(connIn->scms.writeToCharacteristic);
 	connIn->scms.writeToCharacteristic(connIn, serviceUuidIn, characteristicUuidIn, dataIn);
 }
@@ -167,6 +336,26 @@ void cxa_btle_connection_writeToCharacteristic_ptr(cxa_btle_connection_t *const
 }
 
 
+bool cxa_btle_connection_writeToCharacteristic_noResponse(cxa_btle_connection_t *const connIn,
+														  const char *const serviceUuidIn,
+														  const char *const characteristicUuidIn,
+														  void *const dataIn,
+														  size_t numBytesIn)
+{
+	cxa_assert(connIn);
+	cxa_assert(serviceUuidIn);
+	cxa_assert(characteristicUuidIn);
+	cxa_assert(dataIn || (numBytesIn == 0));
+
+	// not every backend supports write commands
+	if( connIn->scms.writeToCharacteristic_noResponse == NULL ) return false;
+
+	// no callback for these...just pass straight through
+	markActivity(connIn);
+	return connIn->scms.writeToCharacteristic_noResponse(connIn, serviceUuidIn, characteristicUuidIn, dataIn, numBytesIn);
+}
+
+
 void cxa_btle_connection_subscribeToNotifications(cxa_btle_connection_t *const connIn,
 												  const char *const serviceUuidIn,
 												  const char *const characteristicUuidIn,
@@ -224,6 +413,8 @@ void cxa_btle_connection_subscribeToNotifications(cxa_btle_connection_t *const c
 	newSub->userVar = userVarIn;
 
 	// now actually do the subscribing
+	connIn->activeProcedures |= PROCEDURE_SUBSCRIBE;
+	markActivity(connIn);
 	cxa_assert(connIn->scms.changeNotifications);
 	connIn->scms.changeNotifications(connIn, serviceUuidIn, characteristicUuidIn, true);
 }
@@ -274,6 +465,8 @@ void cxa_btle_connection_unsubscribeToNotifications(cxa_btle_connection_t *const
 	}
 
 	// now actually do the unsubscribing
+	connIn->activeProcedures |= PROCEDURE_UNSUBSCRIBE;
+	markActivity(connIn);
 	cxa_assert(connIn->scms.changeNotifications);
 	connIn->scms.changeNotifications(connIn, serviceUuidIn, characteristicUuidIn, false);
 }
@@ -293,6 +486,10 @@ void cxa_btle_connection_notify_connectionClose(cxa_btle_connection_t *const con
 {
 	cxa_assert(connIn);
 
+	// nothing can be pending on a closed connection
+	connIn->activeProcedures = 0;
+	connIn->adaptive.isEnabled = false;
+
 	// notify our callback
 	if( connIn->cbs.connectionClosed.func != NULL )
 	{
@@ -307,6 +504,55 @@ void cxa_btle_connection_notify_connectionClose(cxa_btle_connection_t *const con
 }
 
 
+void cxa_btle_connection_notify_attMtuChanged(cxa_btle_connection_t *const connIn, uint16_t attMtuIn)
+{
+	cxa_assert(connIn);
+
+	// ignore anything below the spec minimum
+	if( attMtuIn < CXA_BTLE_CONNECTION_DEFAULT_ATT_MTU ) return;
+
+	connIn->attMtu = attMtuIn;
+	notifyLinkChanged(connIn);
+}
+
+
+void cxa_btle_connection_notify_parametersChanged(cxa_btle_connection_t *const connIn,
+												  uint32_t interval_usIn,
+												  uint16_t slaveLatencyIn,
+												  uint16_t supervisionTimeout_msIn)
+{
+	cxa_assert(connIn);
+
+	connIn->linkInfo.interval_us = interval_usIn;
+	connIn->linkInfo.slaveLatency = slaveLatencyIn;
+	connIn->linkInfo.supervisionTimeout_ms = supervisionTimeout_msIn;
+	notifyLinkChanged(connIn);
+}
+
+
+void cxa_btle_connection_notify_phyChanged(cxa_btle_connection_t *const connIn,
+										   cxa_btle_connection_phy_t phyIn)
+{
+	cxa_assert(connIn);
+
+	connIn->linkInfo.phy = phyIn;
+	notifyLinkChanged(connIn);
+}
+
+
+void cxa_btle_connection_notify_dataLengthChanged(cxa_btle_connection_t *const connIn,
+												  uint16_t dataLength_bytesIn)
+{
+	cxa_assert(connIn);
+
+	// ignore anything below the spec minimum
+	if( dataLength_bytesIn < CXA_BTLE_CONNECTION_DEFAULT_DATA_LENGTH_BYTES ) return;
+
+	connIn->linkInfo.dataLength_bytes = dataLength_bytesIn;
+	notifyLinkChanged(connIn);
+}
+
+
 void cxa_btle_connection_notify_writeComplete(cxa_btle_connection_t *const connIn,
 											  const char *const serviceUuidIn,
 											  const char *const characteristicUuidIn,
@@ -316,6 +562,9 @@ void cxa_btle_connection_notify_writeComplete(cxa_btle_connection_t *const connI
 	cxa_assert(serviceUuidIn);
 	cxa_assert(characteristicUuidIn);
 
+	connIn->activeProcedures &= ~PROCEDURE_WRITE;
+	markActivity(connIn);
+
 	// notify our callback
 	if( connIn->cbs.writeToChar.func != NULL )
 	{
@@ -340,6 +589,9 @@ void cxa_btle_connection_notify_readComplete(cxa_btle_connection_t *const connIn
 	cxa_assert(serviceUuidIn);
 	cxa_assert(characteristicUuidIn);
 
+	connIn->activeProcedures &= ~PROCEDURE_READ;
+	markActivity(connIn);
+
 	// notify our callback
 	if( connIn->cbs.readFromChar.func != NULL )
 	{
@@ -364,6 +616,9 @@ void cxa_btle_connection_notify_notiIndiSubscriptionChanged(cxa_btle_connection_
 	cxa_assert(serviceUuidIn);
 	cxa_assert(characteristicUuidIn);
 
+	connIn->activeProcedures &= ~(notificationsEnableIn ? PROCEDURE_SUBSCRIBE : PROCEDURE_UNSUBSCRIBE);
+	markActivity(connIn);
+
 	// notify our callback
 	if( notificationsEnableIn && (connIn->cbs.subscribeToChar.func != NULL) )
 	{
@@ -397,6 +652,9 @@ void cxa_btle_connection_notify_notiIndiRx(cxa_btle_connection_t *const connIn,
 	cxa_assert(serviceUuidIn);
 	cxa_assert(characteristicUuidIn);
 
+	// incoming traffic counts as activity too
+	markActivity(connIn);
+
 	// make sure the UUIDs checkout
 	cxa_btle_uuid_t tmpServiceUuid, tmpCharUuid;
 	if( !cxa_btle_uuid_initFromString(&tmpServiceUuid, serviceUuidIn) ||
@@ -421,3 +679,89 @@ void cxa_btle_connection_notify_notiIndiRx(cxa_btle_connection_t *const connIn,
 
 
 // ******** local function implementations ********
+static void resetLinkState(cxa_btle_connection_t *const connIn)
+{
+	cxa_assert(connIn);
+
+	connIn->attMtu = CXA_BTLE_CONNECTION_DEFAULT_ATT_MTU;
+
+	connIn->linkInfo.interval_us = 0;
+	connIn->linkInfo.slaveLatency = 0;
+	connIn->linkInfo.supervisionTimeout_ms = 0;
+	connIn->linkInfo.phy = CXA_BTLE_CONNECTION_PHY_1M;
+	connIn->linkInfo.dataLength_bytes = CXA_BTLE_CONNECTION_DEFAULT_DATA_LENGTH_BYTES;
+
+	connIn->activeProcedures = 0;
+	connIn->adaptive.isEnabled = false;
+	connIn->adaptive.isFast = false;
+}
+
+
+static void notifyLinkChanged(cxa_btle_connection_t *const connIn)
+{
+	cxa_assert(connIn);
+
+	// this callback persists for the life of the connection
+	if( connIn->cbs.linkChanged.func != NULL ) connIn->cbs.linkChanged.func(connIn, connIn->cbs.linkChanged.userVar);
+}
+
+
+static void markActivity(cxa_btle_connection_t *const connIn)
+{
+	cxa_assert(connIn);
+
+	if( !connIn->adaptive.isEnabled ) return;
+
+	cxa_timeDiff_setStartTime_now(&connIn->adaptive.td_lastActivity);
+
+	// speed up if we're not already fast
+	if( !connIn->adaptive.isFast &&
+		cxa_btle_connection_requestParameters(connIn, &connIn->adaptive.params_fast) )
+	{
+		connIn->adaptive.isFast = true;
+	}
+
+	// make sure we'll eventually relax
+	if( connIn->adaptive.isFast ) scheduleIdleCheck(connIn, connIn->adaptive.idleTimeout_ms);
+}
+
+
+static void scheduleIdleCheck(cxa_btle_connection_t *const connIn, uint32_t delay_msIn)
+{
+	cxa_assert(connIn);
+
+	// one outstanding check is enough...it will reschedule itself as needed
+	if( connIn->adaptive.isCheckPending ) return;
+
+	connIn->adaptive.isCheckPending = true;
+	cxa_runLoop_dispatchAfter(connIn->adaptive.threadId, delay_msIn, runLoopOneShot_checkIdle, (void*)connIn);
+}
+
+
+static void runLoopOneShot_checkIdle(void* userVarIn)
+{
+	cxa_btle_connection_t *const connIn = (cxa_btle_connection_t *const)userVarIn;
+	cxa_assert(connIn);
+
+	connIn->adaptive.isCheckPending = false;
+	if( !connIn->adaptive.isEnabled || !connIn->adaptive.isFast ) return;
+
+	// still busy, or not idle long enough...check again later
+	uint32_t idleTime_ms = cxa_timeDiff_getElapsedTime_ms(&connIn->adaptive.td_lastActivity);
+	if( (connIn->activeProcedures != 0) || (idleTime_ms < connIn->adaptive.idleTimeout_ms) )
+	{
+		uint32_t remainingTime_ms = (connIn->activeProcedures != 0) ? connIn->adaptive.idleTimeout_ms : (connIn->adaptive.idleTimeout_ms - idleTime_ms);
+		scheduleIdleCheck(connIn, remainingTime_ms);
+		return;
+	}
+
+	// we've been idle long enough...relax (retry later if the stack is busy)
+	if( cxa_btle_connection_requestParameters(connIn, &connIn->adaptive.params_relaxed) )
+	{
+		connIn->adaptive.isFast = false;
+	}
+	else
+	{
+		scheduleIdleCheck(connIn, connIn->adaptive.idleTimeout_ms);
+	}
+}
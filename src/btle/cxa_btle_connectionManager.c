@@ -38,6 +38,7 @@ static void notifyListeners_onSubStateTransitionComplete(cxa_btle_connectionMana
 
 static void executeNextSubscriptionEntry(cxa_btle_connectionManager_t *const btleCmIn);
 
+static void btlecCb_onReady(cxa_btle_central_t *const btlecIn, void* userVarIn);
 static void btleCb_onConnectionOpened(bool wasSuccessfulIn, cxa_btle_connection_t *const connectionIn, void* userVarIn);
 static void btleCb_onConnectionClosed(cxa_btle_connection_disconnectReason_t reasonIn, void* userVarIn);
 
@@ -76,6 +77,11 @@ void cxa_btle_connectionManager_init(cxa_btle_connectionManager_t *const btleCmI
 	cxa_stateMachine_addState(&btleCmIn->stateMachine, STATE_DISCONNECTING, "disconnecting", stateCb_disconnecting_entered, NULL, NULL, (void*)btleCmIn);
 	cxa_stateMachine_addState_timed(&btleCmIn->stateMachine, STATE_CONNECT_STANDOFF, "connStandoff", STATE_CONNECTING, CONNECT_STANDOFF_MS, NULL, NULL, NULL, (void*)btleCmIn);
 	cxa_stateMachine_setInitialState(&btleCmIn->stateMachine, STATE_STOPPED);
+
+	// we're driven by our btle client (and our standoff timer)
+	cxa_stateMachine_setStateIsPolled(&btleCmIn->stateMachine, STATE_WAIT_FOR_BTLEC_READY, false);
+	cxa_stateMachine_setSuspendWhenIdle(&btleCmIn->stateMachine, true);
+	cxa_btle_central_addListener(btlecIn, btlecCb_onReady, NULL, (void*)btleCmIn);
 }
 
 
@@ -384,6 +390,15 @@ static void executeNextSubscriptionEntry(cxa_btle_connectionManager_t *const btl
 
 
 
+static void btlecCb_onReady(cxa_btle_central_t *const btlecIn, void* userVarIn)
+{
+	cxa_btle_connectionManager_t *const btleCmIn = (cxa_btle_connectionManager_t *const)userVarIn;
+	cxa_assert(btleCmIn);
+
+	cxa_stateMachine_kick(&btleCmIn->stateMachine);
+}
+
+
 static void btleCb_onConnectionOpened(bool wasSuccessfulIn, cxa_btle_connection_t *const connectionIn, void* userVarIn)
 {
 	cxa_btle_connectionManager_t *const btleCmIn = (cxa_btle_connectionManager_t *const)userVarIn;
@@ -0,0 +1,719 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_btle_connectionScheduler.h"
+
+
+// ******** includes ********
+#include <string.h>
+
+#include <cxa_assert.h>
+
+#define CXA_LOG_LEVEL			CXA_LOG_LEVEL_DEBUG
+#include <cxa_logger_implementation.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+typedef enum
+{
+	STATE_STOPPED,
+	STATE_WAIT_FOR_BTLEC_READY,
+	STATE_IDLE,
+	STATE_CONNECTING,
+	STATE_SCANNING,
+	STATE_STOPPING
+}state_t;
+
+
+// ******** local function prototypes ********
+static bool isTargetPersistent(cxa_btle_connectionScheduler_target_t *const targetIn);
+static cxa_btle_connectionScheduler_target_t* getNextDueTarget(cxa_btle_connectionScheduler_t *const schedIn, uint32_t *const lag_msOut);
+static void checkHoldTimeouts(cxa_btle_connectionScheduler_t *const schedIn);
+static void disconnectTarget(cxa_btle_connectionScheduler_target_t *const targetIn);
+static void executeNextSubscription(cxa_btle_connectionScheduler_target_t *const targetIn);
+static void scheduleNextCheck(cxa_btle_connectionScheduler_t *const schedIn, state_t currStateIn);
+
+static void btlecCb_onReady(cxa_btle_central_t *const btlecIn, void* userVarIn);
+
+static void btleCb_onConnectionOpened(bool wasSuccessfulIn, cxa_btle_connection_t *const connectionIn, void* userVarIn);
+static void btleCb_onConnectionClosed(cxa_btle_connection_disconnectReason_t reasonIn, void* userVarIn);
+static void btleCb_onNotiIndiSubscriptionChanged(const char *const serviceUuidIn, const char *const characteristicUuidIn, bool wasSuccessfulIn, void* userVarIn);
+static void btleCb_onNotiIndiRx(const char *const serviceUuidIn, const char *const characteristicUuidIn, cxa_fixedByteBuffer_t *fbb_readDataIn, void* userVarIn);
+static void btleCb_onScanStart(bool wasSuccessfulIn, void* userVarIn);
+static void btleCb_onScanStop(void* userVarIn);
+static void btleCb_onAdvert(cxa_btle_advPacket_t* packetIn, void* userVarIn);
+
+static void stateCb_waitForBtlecReady_state(cxa_stateMachine_t *const smIn, void *userVarIn);
+static void stateCb_idle_state(cxa_stateMachine_t *const smIn, void *userVarIn);
+static void stateCb_connecting_entered(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
+static void stateCb_connecting_state(cxa_stateMachine_t *const smIn, void *userVarIn);
+static void stateCb_scanning_entered(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
+static void stateCb_scanning_state(cxa_stateMachine_t *const smIn, void *userVarIn);
+static void stateCb_stopping_entered(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
+static void stateCb_stopping_state(cxa_stateMachine_t *const smIn, void *userVarIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_btle_connectionScheduler_init(cxa_btle_connectionScheduler_t *const schedIn, cxa_btle_central_t *const btlecIn, int threadIdIn)
+{
+	cxa_assert(schedIn);
+	cxa_assert(btlecIn);
+
+	// setup our internal state
+	schedIn->btlec = btlecIn;
+	schedIn->isRunning = false;
+	schedIn->connectingTarget = NULL;
+	cxa_array_initStd(&schedIn->targets, schedIn->targets_raw);
+	memset(&schedIn->scan, 0, sizeof(schedIn->scan));
+	cxa_timeDiff_init(&schedIn->scan.td_period);
+	cxa_logger_init(&schedIn->logger, "btleSched");
+
+	// setup our stateMachine
+	cxa_stateMachine_init(&schedIn->stateMachine, "btleSched", threadIdIn);
+	cxa_stateMachine_addState(&schedIn->stateMachine, STATE_STOPPED, "stopped", NULL, NULL, NULL, (void*)schedIn);
+	cxa_stateMachine_addState(&schedIn->stateMachine, STATE_WAIT_FOR_BTLEC_READY, "waitForBtleC", NULL, stateCb_waitForBtlecReady_state, NULL, (void*)schedIn);
+	cxa_stateMachine_addState(&schedIn->stateMachine, STATE_IDLE, "idle", NULL, stateCb_idle_state, NULL, (void*)schedIn);
+	cxa_stateMachine_addState(&schedIn->stateMachine, STATE_CONNECTING, "connecting", stateCb_connecting_entered, stateCb_connecting_state, NULL, (void*)schedIn);
+	cxa_stateMachine_addState(&schedIn->stateMachine, STATE_SCANNING, "scanning", stateCb_scanning_entered, stateCb_scanning_state, NULL, (void*)schedIn);
+	cxa_stateMachine_addState(&schedIn->stateMachine, STATE_STOPPING, "stopping", stateCb_stopping_entered, stateCb_stopping_state, NULL, (void*)schedIn);
+	cxa_stateMachine_setInitialState(&schedIn->stateMachine, STATE_STOPPED);
+
+	// we're driven by our btle client and our timers
+	cxa_stateMachine_setStateIsPolled(&schedIn->stateMachine, STATE_WAIT_FOR_BTLEC_READY, false);
+	cxa_stateMachine_setStateIsPolled(&schedIn->stateMachine, STATE_IDLE, false);
+	cxa_stateMachine_setStateIsPolled(&schedIn->stateMachine, STATE_CONNECTING, false);
+	cxa_stateMachine_setStateIsPolled(&schedIn->stateMachine, STATE_SCANNING, false);
+	cxa_stateMachine_setStateIsPolled(&schedIn->stateMachine, STATE_STOPPING, false);
+	cxa_stateMachine_setSuspendWhenIdle(&schedIn->stateMachine, true);
+	cxa_btle_central_addListener(btlecIn, btlecCb_onReady, NULL, (void*)schedIn);
+}
+
+
+cxa_btle_connectionScheduler_target_t* cxa_btle_connectionScheduler_addTarget(cxa_btle_connectionScheduler_t *const schedIn,
+																			   cxa_eui48_t *const macIn, bool isRandomAddrIn,
+																			   uint32_t pollPeriod_msIn, uint8_t priorityIn,
+																			   cxa_btle_connectionScheduler_cb_onPoll_t cb_onPollIn,
+																			   void* userVarIn)
+{
+	cxa_assert(schedIn);
+	cxa_assert(macIn);
+
+	cxa_btle_connectionScheduler_target_t* retVal = cxa_array_append_empty(&schedIn->targets);
+	if( retVal == NULL ) return NULL;
+
+	memset(retVal, 0, sizeof(*retVal));
+	retVal->parent = schedIn;
+	cxa_eui48_initFromEui48(&retVal->macAddress, macIn);
+	retVal->isRandomAddress = isRandomAddrIn;
+	retVal->pollPeriod_ms = pollPeriod_msIn;
+	retVal->priority = priorityIn;
+	retVal->isEnabled = true;
+	cxa_array_initStd(&retVal->subscriptions, retVal->subscriptions_raw);
+	retVal->state = CXA_BTLE_CONNSCHED_TARGETSTATE_IDLE;
+	retVal->conn = NULL;
+	cxa_timeDiff_init(&retVal->td_lastPoll);
+	cxa_timeDiff_init(&retVal->td_stateChange);
+	retVal->nextPollDelay_ms = 0;			// poll as soon as we start
+	retVal->cb_onPoll = cb_onPollIn;
+	retVal->userVar = userVarIn;
+
+	cxa_stateMachine_kick(&schedIn->stateMachine);
+	return retVal;
+}
+
+
+bool cxa_btle_connectionScheduler_target_addSubscription(cxa_btle_connectionScheduler_target_t *const targetIn,
+														 const char *const serviceUuidIn,
+														 const char *const characteristicUuidIn,
+														 cxa_btle_connection_cb_onNotiIndiRx_t cb_onRxIn,
+														 void* userVarIn)
+{
+	cxa_assert(targetIn);
+	cxa_assert(serviceUuidIn);
+	cxa_assert(characteristicUuidIn);
+
+	cxa_btle_connectionScheduler_subscription_t newSub = {
+			.serviceUuid_str = serviceUuidIn,
+			.characteristicUuid_str = characteristicUuidIn,
+			.cb_onRx = cb_onRxIn,
+			.userVar = userVarIn
+	};
+	return cxa_array_append(&targetIn->subscriptions, &newSub);
+}
+
+
+void cxa_btle_connectionScheduler_target_setEnabled(cxa_btle_connectionScheduler_target_t *const targetIn, bool isEnabledIn)
+{
+	cxa_assert(targetIn);
+
+	targetIn->isEnabled = isEnabledIn;
+	if( !isEnabledIn && (targetIn->state == CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTED) ) disconnectTarget(targetIn);
+	cxa_stateMachine_kick(&targetIn->parent->stateMachine);
+}
+
+
+void cxa_btle_connectionScheduler_target_pollNow(cxa_btle_connectionScheduler_target_t *const targetIn)
+{
+	cxa_assert(targetIn);
+
+	targetIn->nextPollDelay_ms = 0;
+	cxa_stateMachine_kick(&targetIn->parent->stateMachine);
+}
+
+
+void cxa_btle_connectionScheduler_setScanWindow(cxa_btle_connectionScheduler_t *const schedIn,
+												uint32_t period_msIn, uint32_t duration_msIn,
+												cxa_btle_central_cb_onAdvertRx_t cb_onAdvertIn,
+												void* userVarIn)
+{
+	cxa_assert(schedIn);
+
+	schedIn->scan.period_ms = period_msIn;
+	schedIn->scan.duration_ms = duration_msIn;
+	schedIn->scan.cb_onAdvert = cb_onAdvertIn;
+	schedIn->scan.userVar = userVarIn;
+	cxa_timeDiff_setStartTime_now(&schedIn->scan.td_period);
+	cxa_stateMachine_kick(&schedIn->stateMachine);
+}
+
+
+void cxa_btle_connectionScheduler_start(cxa_btle_connectionScheduler_t *const schedIn)
+{
+	cxa_assert(schedIn);
+
+	schedIn->isRunning = true;
+
+	// stopping state will notice the change on its own
+	if( cxa_stateMachine_getCurrentState(&schedIn->stateMachine) == STATE_STOPPED )
+	{
+		cxa_stateMachine_transition(&schedIn->stateMachine, STATE_WAIT_FOR_BTLEC_READY);
+	}
+}
+
+
+void cxa_btle_connectionScheduler_stop(cxa_btle_connectionScheduler_t *const schedIn)
+{
+	cxa_assert(schedIn);
+
+	schedIn->isRunning = false;
+
+	switch( cxa_stateMachine_getCurrentState(&schedIn->stateMachine) )
+	{
+		case STATE_WAIT_FOR_BTLEC_READY:
+			cxa_stateMachine_transition(&schedIn->stateMachine, STATE_STOPPED);
+			break;
+
+		default:
+			// let the internal state checks take care of this
+			cxa_stateMachine_kick(&schedIn->stateMachine);
+			break;
+	}
+}
+
+
+void cxa_btle_connectionScheduler_releaseTarget(cxa_btle_connectionScheduler_target_t *const targetIn, bool wasSuccessfulIn)
+{
+	cxa_assert(targetIn);
+
+	if( targetIn->state != CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTED ) return;
+
+	if( wasSuccessfulIn ) targetIn->stats.numPollsSuccessful++;
+	else targetIn->stats.numPollsFailed++;
+
+	disconnectTarget(targetIn);
+}
+
+
+size_t cxa_btle_connectionScheduler_getNumActiveConnections(cxa_btle_connectionScheduler_t *const schedIn)
+{
+	cxa_assert(schedIn);
+
+	size_t retVal = 0;
+	cxa_array_iterate(&schedIn->targets, currTarget, cxa_btle_connectionScheduler_target_t)
+	{
+		if( currTarget == NULL ) continue;
+
+		if( currTarget->state != CXA_BTLE_CONNSCHED_TARGETSTATE_IDLE ) retVal++;
+	}
+	return retVal;
+}
+
+
+cxa_btle_connection_t* cxa_btle_connectionScheduler_target_getConnection(cxa_btle_connectionScheduler_target_t *const targetIn)
+{
+	cxa_assert(targetIn);
+
+	return (targetIn->state == CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTED) ? targetIn->conn : NULL;
+}
+
+
+cxa_btle_connectionScheduler_targetStats_t* cxa_btle_connectionScheduler_target_getStats(cxa_btle_connectionScheduler_target_t *const targetIn)
+{
+	cxa_assert(targetIn);
+
+	return &targetIn->stats;
+}
+
+
+void cxa_btle_connectionScheduler_resetStats(cxa_btle_connectionScheduler_t *const schedIn)
+{
+	cxa_assert(schedIn);
+
+	cxa_array_iterate(&schedIn->targets, currTarget, cxa_btle_connectionScheduler_target_t)
+	{
+		if( currTarget == NULL ) continue;
+
+		memset(&currTarget->stats, 0, sizeof(currTarget->stats));
+	}
+}
+
+
+// ******** local function implementations ********
+static bool isTargetPersistent(cxa_btle_connectionScheduler_target_t *const targetIn)
+{
+	cxa_assert(targetIn);
+
+	return !cxa_array_isEmpty(&targetIn->subscriptions);
+}
+
+
+static cxa_btle_connectionScheduler_target_t* getNextDueTarget(cxa_btle_connectionScheduler_t *const schedIn, uint32_t *const lag_msOut)
+{
+	cxa_assert(schedIn);
+
+	cxa_btle_connectionScheduler_target_t* retVal = NULL;
+	uint32_t retVal_lag_ms = 0;
+
+	cxa_array_iterate(&schedIn->targets, currTarget, cxa_btle_connectionScheduler_target_t)
+	{
+		if( (currTarget == NULL) || !currTarget->isEnabled || (currTarget->state != CXA_BTLE_CONNSCHED_TARGETSTATE_IDLE) ) continue;
+
+		uint32_t elapsed_ms = cxa_timeDiff_getElapsedTime_ms(&currTarget->td_lastPoll);
+		if( elapsed_ms < currTarget->nextPollDelay_ms ) continue;
+		uint32_t lag_ms = elapsed_ms - currTarget->nextPollDelay_ms;
+
+		// higher priority always wins, most overdue wins a tie
+		if( (retVal == NULL) ||
+			(currTarget->priority > retVal->priority) ||
+			((currTarget->priority == retVal->priority) && (lag_ms > retVal_lag_ms)) )
+		{
+			retVal = currTarget;
+			retVal_lag_ms = lag_ms;
+		}
+	}
+
+	if( lag_msOut != NULL ) *lag_msOut = retVal_lag_ms;
+	return retVal;
+}
+
+
+static void checkHoldTimeouts(cxa_btle_connectionScheduler_t *const schedIn)
+{
+	cxa_assert(schedIn);
+
+	cxa_array_iterate(&schedIn->targets, currTarget, cxa_btle_connectionScheduler_target_t)
+	{
+		if( (currTarget == NULL) ||
+			(currTarget->state != CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTED) ||
+			isTargetPersistent(currTarget) ) continue;
+
+		if( cxa_timeDiff_isElapsed_ms(&currTarget->td_stateChange, CXA_BTLE_CONNECTION_SCHEDULER_MAX_HOLD_MS) )
+		{
+			cxa_eui48_string_t macStr;
+			cxa_eui48_toString(&currTarget->macAddress, &macStr);
+			cxa_logger_warn(&schedIn->logger, "'%s' held too long, disconnecting", macStr.str);
+
+			currTarget->stats.numHoldTimeouts++;
+			disconnectTarget(currTarget);
+		}
+	}
+}
+
+
+static void disconnectTarget(cxa_btle_connectionScheduler_target_t *const targetIn)
+{
+	cxa_assert(targetIn);
+
+	targetIn->state = CXA_BTLE_CONNSCHED_TARGETSTATE_DISCONNECTING;
+	cxa_timeDiff_setStartTime_now(&targetIn->td_stateChange);
+	if( targetIn->conn != NULL ) cxa_btle_connection_stop(targetIn->conn);
+}
+
+
+static void scheduleNextCheck(cxa_btle_connectionScheduler_t *const schedIn, state_t currStateIn)
+{
+	cxa_assert(schedIn);
+
+	bool canStartConnection = (currStateIn == STATE_IDLE) &&
+							  (cxa_btle_connectionScheduler_getNumActiveConnections(schedIn) < CXA_BTLE_CENTRAL_MAXNUM_CONNECTIONS);
+
+	// hold timeouts apply in every running state, polls only when we could start one
+	uint32_t wakeDelay_ms = UINT32_MAX;
+	cxa_array_iterate(&schedIn->targets, currTarget, cxa_btle_connectionScheduler_target_t)
+	{
+		if( currTarget == NULL ) continue;
+
+		uint32_t currDelay_ms = UINT32_MAX;
+		if( (currTarget->state == CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTED) && !isTargetPersistent(currTarget) )
+		{
+			currDelay_ms = cxa_timeDiff_getRemainingTime_ms(&currTarget->td_stateChange, CXA_BTLE_CONNECTION_SCHEDULER_MAX_HOLD_MS);
+		}
+		else if( canStartConnection && currTarget->isEnabled && (currTarget->state == CXA_BTLE_CONNSCHED_TARGETSTATE_IDLE) )
+		{
+			currDelay_ms = cxa_timeDiff_getRemainingTime_ms(&currTarget->td_lastPoll, currTarget->nextPollDelay_ms);
+		}
+		if( currDelay_ms < wakeDelay_ms ) wakeDelay_ms = currDelay_ms;
+	}
+
+	// and our scan window
+	uint32_t scanDelay_ms = UINT32_MAX;
+	if( (currStateIn == STATE_IDLE) && (schedIn->scan.period_ms > 0) )
+	{
+		scanDelay_ms = cxa_timeDiff_getRemainingTime_ms(&schedIn->scan.td_period, schedIn->scan.period_ms);
+	}
+	else if( currStateIn == STATE_SCANNING )
+	{
+		scanDelay_ms = cxa_timeDiff_getRemainingTime_ms(&schedIn->scan.td_period, schedIn->scan.duration_ms);
+	}
+	if( scanDelay_ms < wakeDelay_ms ) wakeDelay_ms = scanDelay_ms;
+
+	// otherwise we'll be kicked by our callbacks / public functions
+	if( wakeDelay_ms != UINT32_MAX ) cxa_stateMachine_kickAfter(&schedIn->stateMachine, wakeDelay_ms);
+}
+
+
+static void executeNextSubscription(cxa_btle_connectionScheduler_target_t *const targetIn)
+{
+	cxa_assert(targetIn);
+
+	if( targetIn->state != CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTED ) return;
+
+	cxa_btle_connectionScheduler_subscription_t* currSub = cxa_array_get(&targetIn->subscriptions, targetIn->currSubscriptionIndex);
+	if( currSub == NULL )
+	{
+		// all subscriptions restored...let the user know we're connected
+		if( targetIn->cb_onPoll != NULL ) targetIn->cb_onPoll(targetIn, targetIn->conn, targetIn->userVar);
+		return;
+	}
+
+	cxa_btle_connection_subscribeToNotifications(targetIn->conn,
+												 currSub->serviceUuid_str,
+												 currSub->characteristicUuid_str,
+												 btleCb_onNotiIndiSubscriptionChanged,
+												 btleCb_onNotiIndiRx,
+												 (void*)targetIn);
+}
+
+
+static void btleCb_onConnectionOpened(bool wasSuccessfulIn, cxa_btle_connection_t *const connectionIn, void* userVarIn)
+{
+	cxa_btle_connectionScheduler_target_t *const targetIn = (cxa_btle_connectionScheduler_target_t *const)userVarIn;
+	cxa_assert(targetIn);
+	cxa_btle_connectionScheduler_t *const schedIn = targetIn->parent;
+	cxa_assert(schedIn);
+
+	schedIn->connectingTarget = NULL;
+
+	if( !wasSuccessfulIn )
+	{
+		cxa_logger_debug(&schedIn->logger, "connection failed, will retry");
+		targetIn->stats.numConnectFailures++;
+		targetIn->state = CXA_BTLE_CONNSCHED_TARGETSTATE_IDLE;
+		targetIn->nextPollDelay_ms = CXA_BTLE_CONNECTION_SCHEDULER_RETRY_STANDOFF_MS;
+		cxa_timeDiff_setStartTime_now(&targetIn->td_lastPoll);
+		cxa_stateMachine_transition(&schedIn->stateMachine, STATE_IDLE);
+		return;
+	}
+
+	// update our latency statistics
+	uint32_t latency_ms = cxa_timeDiff_getElapsedTime_ms(&targetIn->td_stateChange);
+	targetIn->stats.lastConnectLatency_ms = latency_ms;
+	if( latency_ms > targetIn->stats.maxConnectLatency_ms ) targetIn->stats.maxConnectLatency_ms = latency_ms;
+	targetIn->stats.avgConnectLatency_ms = (targetIn->stats.avgConnectLatency_ms == 0) ?
+										   latency_ms :
+										   (((targetIn->stats.avgConnectLatency_ms * 7) + latency_ms) / 8);
+
+	targetIn->conn = connectionIn;
+	targetIn->state = CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTED;
+	cxa_timeDiff_setStartTime_now(&targetIn->td_stateChange);
+	cxa_btle_connection_setOnClosedCb(connectionIn, btleCb_onConnectionClosed, (void*)targetIn);
+	cxa_stateMachine_transition(&schedIn->stateMachine, STATE_IDLE);
+
+	// we may have been stopped / disabled while connecting
+	if( !schedIn->isRunning || !targetIn->isEnabled )
+	{
+		disconnectTarget(targetIn);
+		return;
+	}
+
+	cxa_eui48_string_t macStr;
+	cxa_eui48_toString(&targetIn->macAddress, &macStr);
+	cxa_logger_info(&schedIn->logger, "connected to '%s' in %d ms", macStr.str, latency_ms);
+
+	// restores subscriptions (if any) then notifies the user
+	targetIn->currSubscriptionIndex = 0;
+	executeNextSubscription(targetIn);
+}
+
+
+static void btleCb_onConnectionClosed(cxa_btle_connection_disconnectReason_t reasonIn, void* userVarIn)
+{
+	cxa_btle_connectionScheduler_target_t *const targetIn = (cxa_btle_connectionScheduler_target_t *const)userVarIn;
+	cxa_assert(targetIn);
+	cxa_btle_connectionScheduler_t *const schedIn = targetIn->parent;
+	cxa_assert(schedIn);
+
+	cxa_eui48_string_t macStr;
+	cxa_eui48_toString(&targetIn->macAddress, &macStr);
+	cxa_logger_debug(&schedIn->logger, "'%s' closed reason %d", macStr.str, reasonIn);
+
+	if( targetIn->state != CXA_BTLE_CONNSCHED_TARGETSTATE_DISCONNECTING )
+	{
+		targetIn->stats.numUnexpectedDisconnects++;
+		if( !isTargetPersistent(targetIn) ) targetIn->stats.numPollsFailed++;
+	}
+
+	// persistent targets should reconnect after a short standoff
+	if( isTargetPersistent(targetIn) )
+	{
+		targetIn->nextPollDelay_ms = CXA_BTLE_CONNECTION_SCHEDULER_RETRY_STANDOFF_MS;
+		cxa_timeDiff_setStartTime_now(&targetIn->td_lastPoll);
+	}
+
+	targetIn->conn = NULL;
+	targetIn->state = CXA_BTLE_CONNSCHED_TARGETSTATE_IDLE;
+
+	// we may be able to start another connection (or finish stopping)
+	cxa_stateMachine_kick(&schedIn->stateMachine);
+}
+
+
+static void btleCb_onNotiIndiSubscriptionChanged(const char *const serviceUuidIn, const char *const characteristicUuidIn, bool wasSuccessfulIn, void* userVarIn)
+{
+	cxa_btle_connectionScheduler_target_t *const targetIn = (cxa_btle_connectionScheduler_target_t *const)userVarIn;
+	cxa_assert(targetIn);
+
+	if( !wasSuccessfulIn )
+	{
+		cxa_logger_warn(&targetIn->parent->logger, "failed to subscribe to %s::%s", serviceUuidIn, characteristicUuidIn);
+		if( targetIn->state == CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTED ) disconnectTarget(targetIn);
+		return;
+	}
+
+	targetIn->currSubscriptionIndex++;
+	executeNextSubscription(targetIn);
+}
+
+
+static void btleCb_onNotiIndiRx(const char *const serviceUuidIn, const char *const characteristicUuidIn, cxa_fixedByteBuffer_t *fbb_readDataIn, void* userVarIn)
+{
+	cxa_btle_connectionScheduler_target_t *const targetIn = (cxa_btle_connectionScheduler_target_t *const)userVarIn;
+	cxa_assert(targetIn);
+
+	cxa_btle_uuid_t targetServiceUuid, targetCharUuid;
+	if( !cxa_btle_uuid_initFromString(&targetServiceUuid, serviceUuidIn) ||
+		!cxa_btle_uuid_initFromString(&targetCharUuid, characteristicUuidIn) ) return;
+
+	cxa_array_iterate(&targetIn->subscriptions, currSub, cxa_btle_connectionScheduler_subscription_t)
+	{
+		if( currSub == NULL ) continue;
+
+		if( cxa_btle_uuid_isEqualToString(&targetServiceUuid, currSub->serviceUuid_str) &&
+			cxa_btle_uuid_isEqualToString(&targetCharUuid, currSub->characteristicUuid_str) &&
+			(currSub->cb_onRx != NULL) )
+		{
+			currSub->cb_onRx(serviceUuidIn, characteristicUuidIn, fbb_readDataIn, currSub->userVar);
+		}
+	}
+}
+
+
+static void btleCb_onScanStart(bool wasSuccessfulIn, void* userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	if( !wasSuccessfulIn )
+	{
+		cxa_logger_warn(&schedIn->logger, "scan window failed to start");
+		cxa_stateMachine_transition(&schedIn->stateMachine, STATE_IDLE);
+	}
+}
+
+
+static void btleCb_onScanStop(void* userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	cxa_stateMachine_transition(&schedIn->stateMachine, STATE_IDLE);
+}
+
+
+static void btleCb_onAdvert(cxa_btle_advPacket_t* packetIn, void* userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	if( schedIn->scan.cb_onAdvert != NULL ) schedIn->scan.cb_onAdvert(packetIn, schedIn->scan.userVar);
+}
+
+
+static void btlecCb_onReady(cxa_btle_central_t *const btlecIn, void* userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	cxa_stateMachine_kick(&schedIn->stateMachine);
+}
+
+
+static void stateCb_waitForBtlecReady_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	if( cxa_btle_central_getState(schedIn->btlec) == CXA_BTLE_CENTRAL_STATE_READY )
+	{
+		cxa_stateMachine_transition(&schedIn->stateMachine, STATE_IDLE);
+	}
+}
+
+
+static void stateCb_idle_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	if( !schedIn->isRunning )
+	{
+		cxa_stateMachine_transition(&schedIn->stateMachine, STATE_STOPPING);
+		return;
+	}
+
+	checkHoldTimeouts(schedIn);
+
+	// scan windows take precedence over connections
+	if( (schedIn->scan.period_ms > 0) && cxa_timeDiff_isElapsed_recurring_ms(&schedIn->scan.td_period, schedIn->scan.period_ms) )
+	{
+		cxa_stateMachine_transition(&schedIn->stateMachine, STATE_SCANNING);
+		return;
+	}
+
+	// see if we have a free connection slot and a target that is due
+	uint32_t lag_ms;
+	cxa_btle_connectionScheduler_target_t* nextTarget = NULL;
+	if( (cxa_btle_connectionScheduler_getNumActiveConnections(schedIn) >= CXA_BTLE_CENTRAL_MAXNUM_CONNECTIONS) ||
+		((nextTarget = getNextDueTarget(schedIn, &lag_ms)) == NULL) )
+	{
+		scheduleNextCheck(schedIn, STATE_IDLE);
+		return;
+	}
+
+	nextTarget->stats.lastScheduleLag_ms = lag_ms;
+	if( lag_ms > nextTarget->stats.maxScheduleLag_ms ) nextTarget->stats.maxScheduleLag_ms = lag_ms;
+
+	schedIn->connectingTarget = nextTarget;
+	cxa_stateMachine_transition(&schedIn->stateMachine, STATE_CONNECTING);
+}
+
+
+static void stateCb_connecting_entered(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	cxa_btle_connectionScheduler_target_t* targetIn = schedIn->connectingTarget;
+	cxa_assert(targetIn);
+
+	// the next poll is measured from the start of this one
+	targetIn->state = CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTING;
+	targetIn->nextPollDelay_ms = targetIn->pollPeriod_ms;
+	cxa_timeDiff_setStartTime_now(&targetIn->td_lastPoll);
+	cxa_timeDiff_setStartTime_now(&targetIn->td_stateChange);
+	targetIn->stats.numConnectAttempts++;
+
+	cxa_btle_central_startConnection(schedIn->btlec, &targetIn->macAddress, targetIn->isRandomAddress,
+									 btleCb_onConnectionOpened, (void*)targetIn);
+}
+
+
+static void stateCb_connecting_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	checkHoldTimeouts(schedIn);
+	scheduleNextCheck(schedIn, STATE_CONNECTING);
+}
+
+
+static void stateCb_scanning_entered(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	cxa_btle_central_startScan_passive(schedIn->btlec, btleCb_onScanStart, btleCb_onAdvert, (void*)schedIn);
+}
+
+
+static void stateCb_scanning_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	checkHoldTimeouts(schedIn);
+
+	// scan window period is measured from its start, so the duration is too
+	if( !schedIn->isRunning || cxa_timeDiff_isElapsed_ms(&schedIn->scan.td_period, schedIn->scan.duration_ms) )
+	{
+		cxa_btle_central_stopScan(schedIn->btlec, btleCb_onScanStop, (void*)schedIn);
+		return;
+	}
+
+	scheduleNextCheck(schedIn, STATE_SCANNING);
+}
+
+
+static void stateCb_stopping_entered(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	cxa_logger_debug(&schedIn->logger, "closing all connections");
+
+	cxa_array_iterate(&schedIn->targets, currTarget, cxa_btle_connectionScheduler_target_t)
+	{
+		if( currTarget == NULL ) continue;
+
+		if( currTarget->state == CXA_BTLE_CONNSCHED_TARGETSTATE_CONNECTED ) disconnectTarget(currTarget);
+	}
+}
+
+
+static void stateCb_stopping_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+{
+	cxa_btle_connectionScheduler_t *const schedIn = (cxa_btle_connectionScheduler_t *const)userVarIn;
+	cxa_assert(schedIn);
+
+	// we may have been restarted before everything closed
+	if( schedIn->isRunning )
+	{
+		cxa_stateMachine_transition(&schedIn->stateMachine, STATE_IDLE);
+		return;
+	}
+
+	if( cxa_btle_connectionScheduler_getNumActiveConnections(schedIn) == 0 )
+	{
+		cxa_stateMachine_transition(&schedIn->stateMachine, STATE_STOPPED);
+	}
+}
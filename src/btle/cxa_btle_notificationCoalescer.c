@@ -0,0 +1,364 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_btle_notificationCoalescer.h"
+
+
+// ******** includes ********
+#include <string.h>
+
+#include <cxa_assert.h>
+#include <cxa_btle_uuid.h>
+#include <cxa_runLoop.h>
+
+#define CXA_LOG_LEVEL					CXA_LOG_LEVEL_TRACE
+#include <cxa_logger_implementation.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static cxa_btle_notificationCoalescer_channel_t* getOrAddChannel(cxa_btle_notificationCoalescer_t *const ncIn,
+																  const char *const serviceUuidStrIn,
+																  const char *const charUuidStrIn,
+																  bool isPackedIn);
+static void scheduleFlush(cxa_btle_notificationCoalescer_t *const ncIn);
+static void clearPending(cxa_btle_notificationCoalescer_t *const ncIn, cxa_btle_notificationCoalescer_entry_t *const entryIn);
+static bool sendOnChannel(cxa_btle_notificationCoalescer_t *const ncIn, cxa_btle_notificationCoalescer_channel_t *const channelIn, void *const dataIn, size_t numBytesIn);
+static void flushPackedChannel(cxa_btle_notificationCoalescer_t *const ncIn, cxa_btle_notificationCoalescer_channel_t *const channelIn);
+
+static void cb_onSubscriptionChanged(bool isSubscribedIn, void* userVarIn);
+static void runLoopOneShot_flush(void* userVarIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_btle_notificationCoalescer_init(cxa_btle_notificationCoalescer_t *const ncIn,
+										 cxa_btle_peripheral_t *const btlepIn,
+										 int threadIdIn,
+										 uint32_t maxLatency_msIn)
+{
+	cxa_assert(ncIn);
+	cxa_assert(btlepIn);
+
+	// save our references and setup our internal state
+	ncIn->btlep = btlepIn;
+	ncIn->threadId = threadIdIn;
+	ncIn->maxLatency_ms = maxLatency_msIn;
+	ncIn->numPendingEntries = 0;
+	ncIn->isFlushScheduled = false;
+
+	cxa_array_initStd(&ncIn->channels, ncIn->channels_raw);
+	cxa_array_initStd(&ncIn->entries, ncIn->entries_raw);
+
+	cxa_btle_notificationCoalescer_resetStats(ncIn);
+
+	cxa_logger_init(&ncIn->logger, "btleNotiCoalescer");
+}
+
+
+cxa_btle_notificationCoalescer_entry_t* cxa_btle_notificationCoalescer_addCharacteristic(cxa_btle_notificationCoalescer_t *const ncIn,
+																						 const char *const serviceUuidStrIn,
+																						 const char *const charUuidStrIn,
+																						 cxa_btle_peripheral_cb_onSubscriptionChanged_t cb_onSubChangedIn,
+																						 void* userVarIn)
+{
+	cxa_assert(ncIn);
+	cxa_assert(serviceUuidStrIn);
+	cxa_assert(charUuidStrIn);
+
+	cxa_btle_notificationCoalescer_channel_t* channel = getOrAddChannel(ncIn, serviceUuidStrIn, charUuidStrIn, false);
+	cxa_assert_msg(!channel->isPacked, "characteristic is already a packed carrier");
+	channel->cb_onSubscriptionChanged = cb_onSubChangedIn;
+	channel->userVar = userVarIn;
+
+	cxa_btle_notificationCoalescer_entry_t* newEntry = cxa_array_append_empty(&ncIn->entries);
+	cxa_assert_msg(newEntry, "increase CXA_BTLE_NOTIFICATIONCOALESCER_MAXNUM_ENTRIES");
+	newEntry->channel = channel;
+	newEntry->tag = 0;
+	newEntry->isPending = false;
+	newEntry->valueSize_bytes = 0;
+
+	return newEntry;
+}
+
+
+cxa_btle_notificationCoalescer_entry_t* cxa_btle_notificationCoalescer_addPackedCharacteristic(cxa_btle_notificationCoalescer_t *const ncIn,
+																							   const char *const serviceUuidStrIn,
+																							   const char *const carrierCharUuidStrIn,
+																							   uint8_t tagIn)
+{
+	cxa_assert(ncIn);
+	cxa_assert(serviceUuidStrIn);
+	cxa_assert(carrierCharUuidStrIn);
+
+	cxa_btle_notificationCoalescer_channel_t* channel = getOrAddChannel(ncIn, serviceUuidStrIn, carrierCharUuidStrIn, true);
+	cxa_assert_msg(channel->isPacked, "characteristic is already a direct characteristic");
+
+	// tags must be unique per carrier
+	cxa_array_iterate(&ncIn->entries, currEntry, cxa_btle_notificationCoalescer_entry_t)
+	{
+		if( currEntry == NULL ) continue;
+		cxa_assert_msg(!((currEntry->channel == channel) && (currEntry->tag == tagIn)), "duplicate tag");
+	}
+
+	cxa_btle_notificationCoalescer_entry_t* newEntry = cxa_array_append_empty(&ncIn->entries);
+	cxa_assert_msg(newEntry, "increase CXA_BTLE_NOTIFICATIONCOALESCER_MAXNUM_ENTRIES");
+	newEntry->channel = channel;
+	newEntry->tag = tagIn;
+	newEntry->isPending = false;
+	newEntry->valueSize_bytes = 0;
+
+	return newEntry;
+}
+
+
+bool cxa_btle_notificationCoalescer_update(cxa_btle_notificationCoalescer_t *const ncIn,
+										   cxa_btle_notificationCoalescer_entry_t *const entryIn,
+										   void *const dataIn,
+										   size_t numBytesIn)
+{
+	cxa_assert(ncIn);
+	cxa_assert(entryIn);
+	cxa_assert(dataIn || (numBytesIn == 0));
+
+	// packed values need room for their header
+	size_t maxSize_bytes = entryIn->channel->isPacked ?
+						   (CXA_BTLE_NOTIFICATIONCOALESCER_MAX_NOTIFICATION_SIZE_BYTES - CXA_BTLE_NOTIFICATIONCOALESCER_PACKED_HEADER_SIZE_BYTES) :
+						   CXA_BTLE_NOTIFICATIONCOALESCER_MAX_NOTIFICATION_SIZE_BYTES;
+	if( numBytesIn > maxSize_bytes ) return false;
+
+	ncIn->stats.numUpdates++;
+
+	// the previous value (if any) is stale...replace it
+	if( entryIn->isPending )
+	{
+		ncIn->stats.numValuesSuperseded++;
+		ncIn->stats.numNotificationsSaved++;
+	}
+	else
+	{
+		entryIn->isPending = true;
+		ncIn->numPendingEntries++;
+		if( ncIn->numPendingEntries > ncIn->stats.maxQueueDepth ) ncIn->stats.maxQueueDepth = ncIn->numPendingEntries;
+	}
+	if( numBytesIn > 0 ) memcpy(entryIn->value, dataIn, numBytesIn);
+	entryIn->valueSize_bytes = numBytesIn;
+
+	scheduleFlush(ncIn);
+	return true;
+}
+
+
+void cxa_btle_notificationCoalescer_flush(cxa_btle_notificationCoalescer_t *const ncIn)
+{
+	cxa_assert(ncIn);
+
+	if( ncIn->numPendingEntries == 0 ) return;
+
+	// direct characteristics first
+	cxa_array_iterate(&ncIn->entries, currEntry, cxa_btle_notificationCoalescer_entry_t)
+	{
+		if( (currEntry == NULL) || !currEntry->isPending || currEntry->channel->isPacked ) continue;
+
+		if( !sendOnChannel(ncIn, currEntry->channel, currEntry->value, currEntry->valueSize_bytes) ) ncIn->stats.numValuesDropped++;
+		clearPending(ncIn, currEntry);
+	}
+
+	// now our packed carriers
+	cxa_array_iterate(&ncIn->channels, currChannel, cxa_btle_notificationCoalescer_channel_t)
+	{
+		if( (currChannel == NULL) || !currChannel->isPacked ) continue;
+
+		flushPackedChannel(ncIn, currChannel);
+	}
+}
+
+
+size_t cxa_btle_notificationCoalescer_getQueueDepth(cxa_btle_notificationCoalescer_t *const ncIn)
+{
+	cxa_assert(ncIn);
+
+	return ncIn->numPendingEntries;
+}
+
+
+cxa_btle_notificationCoalescer_stats_t* cxa_btle_notificationCoalescer_getStats(cxa_btle_notificationCoalescer_t *const ncIn)
+{
+	cxa_assert(ncIn);
+
+	return &ncIn->stats;
+}
+
+
+void cxa_btle_notificationCoalescer_resetStats(cxa_btle_notificationCoalescer_t *const ncIn)
+{
+	cxa_assert(ncIn);
+
+	memset(&ncIn->stats, 0, sizeof(ncIn->stats));
+}
+
+
+// ******** local function implementations ********
+static cxa_btle_notificationCoalescer_channel_t* getOrAddChannel(cxa_btle_notificationCoalescer_t *const ncIn,
+																  const char *const serviceUuidStrIn,
+																  const char *const charUuidStrIn,
+																  bool isPackedIn)
+{
+	cxa_assert(ncIn);
+
+	cxa_btle_uuid_t targetServiceUuid, targetCharUuid;
+	bool areUuidsValid = cxa_btle_uuid_initFromString(&targetServiceUuid, serviceUuidStrIn) &&
+						 cxa_btle_uuid_initFromString(&targetCharUuid, charUuidStrIn);
+	cxa_assert_msg(areUuidsValid, "bad uuid");
+
+	// see if we already have this one
+	cxa_btle_uuid_t currServiceUuid, currCharUuid;
+	cxa_array_iterate(&ncIn->channels, currChannel, cxa_btle_notificationCoalescer_channel_t)
+	{
+		if( currChannel == NULL ) continue;
+
+		if( !cxa_btle_uuid_initFromString(&currServiceUuid, currChannel->serviceUuid_str) ||
+			!cxa_btle_uuid_initFromString(&currCharUuid, currChannel->charUuid_str) ) continue;
+
+		if( cxa_btle_uuid_isEqual(&targetServiceUuid, &currServiceUuid) &&
+			cxa_btle_uuid_isEqual(&targetCharUuid, &currCharUuid) )
+		{
+			return currChannel;
+		}
+	}
+
+	// we need a new one
+	cxa_btle_notificationCoalescer_channel_t* newChannel = cxa_array_append_empty(&ncIn->channels);
+	cxa_assert_msg(newChannel, "increase CXA_BTLE_NOTIFICATIONCOALESCER_MAXNUM_CHANNELS");
+	newChannel->parent = ncIn;
+	newChannel->serviceUuid_str = serviceUuidStrIn;
+	newChannel->charUuid_str = charUuidStrIn;
+	newChannel->isPacked = isPackedIn;
+	newChannel->subscriptionState = CXA_BTLE_NOTIFICATIONCOALESCER_SUBSCRIPTION_UNKNOWN;
+	newChannel->cb_onSubscriptionChanged = NULL;
+	newChannel->userVar = NULL;
+
+	// not all backends report subscriptions...until they do, we send unconditionally
+	cxa_btle_peripheral_registerSubscriptionChangedHandler(ncIn->btlep, serviceUuidStrIn, charUuidStrIn, cb_onSubscriptionChanged, (void*)newChannel);
+
+	return newChannel;
+}
+
+
+static void scheduleFlush(cxa_btle_notificationCoalescer_t *const ncIn)
+{
+	cxa_assert(ncIn);
+
+	// the first pending value sets the deadline for everything that follows
+	if( ncIn->isFlushScheduled ) return;
+
+	ncIn->isFlushScheduled = true;
+	if( ncIn->maxLatency_ms == 0 )
+	{
+		cxa_runLoop_dispatchNextIteration(ncIn->threadId, runLoopOneShot_flush, (void*)ncIn);
+	}
+	else
+	{
+		cxa_runLoop_dispatchAfter(ncIn->threadId, ncIn->maxLatency_ms, runLoopOneShot_flush, (void*)ncIn);
+	}
+}
+
+
+static void clearPending(cxa_btle_notificationCoalescer_t *const ncIn, cxa_btle_notificationCoalescer_entry_t *const entryIn)
+{
+	cxa_assert(ncIn);
+	cxa_assert(entryIn);
+
+	if( !entryIn->isPending ) return;
+
+	entryIn->isPending = false;
+	ncIn->numPendingEntries--;
+}
+
+
+static bool sendOnChannel(cxa_btle_notificationCoalescer_t *const ncIn, cxa_btle_notificationCoalescer_channel_t *const channelIn, void *const dataIn, size_t numBytesIn)
+{
+	cxa_assert(ncIn);
+	cxa_assert(channelIn);
+
+	if( channelIn->subscriptionState == CXA_BTLE_NOTIFICATIONCOALESCER_SUBSCRIPTION_UNSUBSCRIBED ) return false;
+
+	cxa_btle_peripheral_sendNotification(ncIn->btlep, channelIn->serviceUuid_str, channelIn->charUuid_str, dataIn, numBytesIn);
+	ncIn->stats.numNotificationsSent++;
+
+	return true;
+}
+
+
+static void flushPackedChannel(cxa_btle_notificationCoalescer_t *const ncIn, cxa_btle_notificationCoalescer_channel_t *const channelIn)
+{
+	cxa_assert(ncIn);
+	cxa_assert(channelIn);
+
+	uint8_t packet[CXA_BTLE_NOTIFICATIONCOALESCER_MAX_NOTIFICATION_SIZE_BYTES];
+	size_t packetSize_bytes = 0;
+	size_t numValuesInPacket = 0;
+
+	cxa_array_iterate(&ncIn->entries, currEntry, cxa_btle_notificationCoalescer_entry_t)
+	{
+		if( (currEntry == NULL) || !currEntry->isPending || (currEntry->channel != channelIn) ) continue;
+
+		// send what we have if this value won't fit
+		size_t recordSize_bytes = CXA_BTLE_NOTIFICATIONCOALESCER_PACKED_HEADER_SIZE_BYTES + currEntry->valueSize_bytes;
+		if( (packetSize_bytes + recordSize_bytes) > sizeof(packet) )
+		{
+			if( sendOnChannel(ncIn, channelIn, packet, packetSize_bytes) ) ncIn->stats.numNotificationsSaved += numValuesInPacket - 1;
+			else ncIn->stats.numValuesDropped += numValuesInPacket;
+
+			packetSize_bytes = 0;
+			numValuesInPacket = 0;
+		}
+
+		packet[packetSize_bytes++] = currEntry->tag;
+		packet[packetSize_bytes++] = (uint8_t)currEntry->valueSize_bytes;
+		memcpy(&packet[packetSize_bytes], currEntry->value, currEntry->valueSize_bytes);
+		packetSize_bytes += currEntry->valueSize_bytes;
+		numValuesInPacket++;
+
+		clearPending(ncIn, currEntry);
+	}
+
+	// send whatever is left over
+	if( numValuesInPacket > 0 )
+	{
+		if( sendOnChannel(ncIn, channelIn, packet, packetSize_bytes) ) ncIn->stats.numNotificationsSaved += numValuesInPacket - 1;
+		else ncIn->stats.numValuesDropped += numValuesInPacket;
+	}
+}
+
+
+static void cb_onSubscriptionChanged(bool isSubscribedIn, void* userVarIn)
+{
+	cxa_btle_notificationCoalescer_channel_t *const channelIn = (cxa_btle_notificationCoalescer_channel_t *const)userVarIn;
+	cxa_assert(channelIn);
+
+	channelIn->subscriptionState = isSubscribedIn ? CXA_BTLE_NOTIFICATIONCOALESCER_SUBSCRIPTION_SUBSCRIBED : CXA_BTLE_NOTIFICATIONCOALESCER_SUBSCRIPTION_UNSUBSCRIBED;
+	cxa_logger_trace(&channelIn->parent->logger, "'%s' %s", channelIn->charUuid_str, isSubscribedIn ? "subscribed" : "unsubscribed");
+
+	if( channelIn->cb_onSubscriptionChanged != NULL ) channelIn->cb_onSubscriptionChanged(isSubscribedIn, channelIn->userVar);
+}
+
+
+static void runLoopOneShot_flush(void* userVarIn)
+{
+	cxa_btle_notificationCoalescer_t *const ncIn = (cxa_btle_notificationCoalescer_t *const)userVarIn;
+	cxa_assert(ncIn);
+
+	ncIn->isFlushScheduled = false;
+	cxa_btle_notificationCoalescer_flush(ncIn);
+}
@@ -0,0 +1,473 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_btle_stream.h"
+
+
+// ******** includes ********
+#include <string.h>
+
+#include <cxa_assert.h>
+#include <cxa_numberUtils.h>
+#include <cxa_runLoop.h>
+
+#define CXA_LOG_LEVEL			CXA_LOG_LEVEL_INFO
+#include <cxa_logger_implementation.h>
+
+
+// ******** local macro definitions ********
+#define PACKET_TYPE_DATA				0x00
+#define PACKET_TYPE_CREDIT				0x01
+
+#define MAX_CREDITS_PER_PACKET			255
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static size_t getPayloadSize_bytes(cxa_btle_stream_t *const streamIn);
+static size_t getRxCreditSize_bytes(cxa_btle_stream_t *const streamIn);
+static void pumpTx(cxa_btle_stream_t *const streamIn);
+static bool grantRxCredits(cxa_btle_stream_t *const streamIn, bool forceIn);
+static void fillPendingPacket(cxa_btle_stream_t *const streamIn);
+static void finishOpening(cxa_btle_stream_t *const streamIn, bool wasSuccessfulIn);
+static void wake(cxa_btle_stream_t *const streamIn);
+
+static void btleCb_onSubscribed(const char *const serviceUuidIn, const char *const characteristicUuidIn, bool wasSuccessfulIn, void* userVarIn);
+static void btleCb_onRx(const char *const serviceUuidIn, const char *const characteristicUuidIn, cxa_fixedByteBuffer_t *fbb_readDataIn, void* userVarIn);
+
+static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn);
+static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+
+static void cb_onRunLoopUpdate(void* userVarIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_btle_stream_init(cxa_btle_stream_t *const streamIn, int threadIdIn)
+{
+	cxa_assert(streamIn);
+
+	// save our references and setup our internal state
+	streamIn->state = CXA_BTLE_STREAM_STATE_CLOSED;
+	streamIn->threadId = threadIdIn;
+	streamIn->conn = NULL;
+	streamIn->cb_onOpened = NULL;
+	streamIn->cb_userVar = NULL;
+	cxa_timeDiff_init(&streamIn->td_open);
+	streamIn->pendingPacketSize_bytes = 0;
+	streamIn->txCredits = 0;
+	streamIn->rxCreditsOutstanding = 0;
+	cxa_btle_stream_resetStats(streamIn);
+	cxa_logger_init(&streamIn->logger, "btleStream");
+
+	// setup our buffers
+	cxa_fixedFifo_initStd(&streamIn->fifo_tx, CXA_FF_ON_FULL_DROP, streamIn->fifo_tx_raw);
+	cxa_fixedFifo_initStd(&streamIn->fifo_rx, CXA_FF_ON_FULL_DROP, streamIn->fifo_rx_raw);
+
+	// setup our ioStream
+	cxa_ioStream_init(&streamIn->ioStream);
+	cxa_ioStream_bind(&streamIn->ioStream, cb_ioStream_readByte, cb_ioStream_writeBytes, (void*)streamIn);
+	cxa_ioStream_setNotifiesDataAvailable(&streamIn->ioStream, true);
+
+	// register for runLoop execution (suspended while there is nothing to retry)
+	streamIn->runLoopEntry = cxa_runLoop_addEntry(threadIdIn, NULL, cb_onRunLoopUpdate, (void*)streamIn);
+	streamIn->isRunLoopEntrySuspended = false;
+}
+
+
+void cxa_btle_stream_open(cxa_btle_stream_t *const streamIn,
+						  cxa_btle_connection_t *const connIn,
+						  const char *const serviceUuidIn,
+						  const char *const txCharUuidIn,
+						  const char *const rxCharUuidIn,
+						  cxa_btle_stream_cb_onOpened_t cb_onOpenedIn,
+						  void* userVarIn)
+{
+	cxa_assert(streamIn);
+	cxa_assert(connIn);
+	cxa_assert(serviceUuidIn);
+	cxa_assert(txCharUuidIn);
+	cxa_assert(rxCharUuidIn);
+
+	if( streamIn->state != CXA_BTLE_STREAM_STATE_CLOSED )
+	{
+		if( cb_onOpenedIn != NULL ) cb_onOpenedIn(streamIn, false, userVarIn);
+		return;
+	}
+
+	// save our references
+	streamIn->conn = connIn;
+	streamIn->serviceUuid = serviceUuidIn;
+	streamIn->txCharUuid = txCharUuidIn;
+	streamIn->rxCharUuid = rxCharUuidIn;
+	streamIn->cb_onOpened = cb_onOpenedIn;
+	streamIn->cb_userVar = userVarIn;
+
+	// peer must grant us credits before we can send
+	streamIn->txCredits = 0;
+	streamIn->rxCreditsOutstanding = 0;
+	streamIn->pendingPacketSize_bytes = 0;
+
+	cxa_logger_debug(&streamIn->logger, "opening");
+	streamIn->state = CXA_BTLE_STREAM_STATE_OPENING;
+	cxa_timeDiff_setStartTime_now(&streamIn->td_open);
+	cxa_btle_connection_subscribeToNotifications(connIn, serviceUuidIn, rxCharUuidIn, btleCb_onSubscribed, btleCb_onRx, (void*)streamIn);
+	wake(streamIn);
+}
+
+
+void cxa_btle_stream_close(cxa_btle_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+
+	if( streamIn->state == CXA_BTLE_STREAM_STATE_CLOSED ) return;
+
+	cxa_logger_debug(&streamIn->logger, "closed");
+	streamIn->state = CXA_BTLE_STREAM_STATE_CLOSED;
+	streamIn->conn = NULL;
+	streamIn->pendingPacketSize_bytes = 0;
+	streamIn->txCredits = 0;
+	streamIn->rxCreditsOutstanding = 0;
+
+	cxa_fixedFifo_clear(&streamIn->fifo_tx);
+	cxa_fixedFifo_clear(&streamIn->fifo_rx);
+}
+
+
+bool cxa_btle_stream_isOpen(cxa_btle_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+
+	return (streamIn->state == CXA_BTLE_STREAM_STATE_OPEN);
+}
+
+
+cxa_ioStream_t* cxa_btle_stream_getIoStream(cxa_btle_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+
+	return &streamIn->ioStream;
+}
+
+
+size_t cxa_btle_stream_getTxFreeSize_bytes(cxa_btle_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+
+	return cxa_fixedFifo_getFreeSize_elems(&streamIn->fifo_tx);
+}
+
+
+cxa_btle_stream_stats_t* cxa_btle_stream_getStats(cxa_btle_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+
+	return &streamIn->stats;
+}
+
+
+void cxa_btle_stream_resetStats(cxa_btle_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+
+	memset(&streamIn->stats, 0, sizeof(streamIn->stats));
+}
+
+
+// ******** local function implementations ********
+static size_t getPayloadSize_bytes(cxa_btle_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+	cxa_assert(streamIn->conn);
+
+	size_t retVal = cxa_btle_connection_getMaxAttPayloadSize_bytes(streamIn->conn) - CXA_BTLE_STREAM_PACKET_HEADER_SIZE_BYTES;
+	return CXA_MIN(retVal, CXA_BTLE_STREAM_MAX_PACKET_SIZE_BYTES);
+}
+
+
+static size_t getRxCreditSize_bytes(cxa_btle_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+	cxa_assert(streamIn->conn);
+
+	// until the (one-time) MTU exchange, the peer's packets may still grow
+	return (cxa_btle_connection_getAttMtu(streamIn->conn) == CXA_BTLE_CONNECTION_DEFAULT_ATT_MTU) ?
+			CXA_BTLE_STREAM_MAX_PACKET_SIZE_BYTES : getPayloadSize_bytes(streamIn);
+}
+
+
+static void pumpTx(cxa_btle_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+
+	if( streamIn->state != CXA_BTLE_STREAM_STATE_OPEN ) return;
+
+	while( true )
+	{
+		if( streamIn->pendingPacketSize_bytes == 0 )
+		{
+			// nothing to send
+			if( cxa_fixedFifo_isEmpty(&streamIn->fifo_tx) ) break;
+
+			// peer can't accept any more right now
+			if( streamIn->txCredits == 0 )
+			{
+				streamIn->stats.numTxStalls_noCredits++;
+				break;
+			}
+
+			fillPendingPacket(streamIn);
+		}
+
+		// if this fails, the stack is out of buffers...we'll retry next iteration
+		if( !cxa_btle_connection_writeToCharacteristic_noResponse(streamIn->conn, streamIn->serviceUuid, streamIn->txCharUuid,
+																  streamIn->pendingPacket, streamIn->pendingPacketSize_bytes) )
+		{
+			streamIn->stats.numTxStalls_stackBusy++;
+			break;
+		}
+
+		streamIn->stats.numPacketsTx++;
+		streamIn->stats.numBytesTx += streamIn->pendingPacketSize_bytes - CXA_BTLE_STREAM_PACKET_HEADER_SIZE_BYTES;
+		streamIn->txCredits--;
+		streamIn->pendingPacketSize_bytes = 0;
+	}
+}
+
+
+static bool grantRxCredits(cxa_btle_stream_t *const streamIn, bool forceIn)
+{
+	cxa_assert(streamIn);
+
+	if( (streamIn->state != CXA_BTLE_STREAM_STATE_OPEN) && (streamIn->state != CXA_BTLE_STREAM_STATE_OPENING_TX) ) return false;
+
+	// figure out how many full packets we can currently absorb
+	size_t creditSize_bytes = getRxCreditSize_bytes(streamIn);
+	size_t numFreeSlots = cxa_fixedFifo_getFreeSize_elems(&streamIn->fifo_rx) / creditSize_bytes;
+	if( numFreeSlots <= streamIn->rxCreditsOutstanding ) return false;
+	size_t numNewCredits = CXA_MIN(numFreeSlots - streamIn->rxCreditsOutstanding, MAX_CREDITS_PER_PACKET);
+
+	// batch our grants to avoid flooding the link with credit packets
+	size_t windowSize = cxa_fixedFifo_getMaxSize_elems(&streamIn->fifo_rx) / creditSize_bytes;
+	if( !forceIn && (streamIn->rxCreditsOutstanding != 0) && (numNewCredits < (windowSize / 2)) ) return false;
+
+	uint8_t creditPacket[] = {PACKET_TYPE_CREDIT, (uint8_t)numNewCredits};
+	if( !cxa_btle_connection_writeToCharacteristic_noResponse(streamIn->conn, streamIn->serviceUuid, streamIn->txCharUuid, creditPacket, sizeof(creditPacket)) ) return false;
+
+	cxa_logger_trace(&streamIn->logger, "granted %d credits", numNewCredits);
+	streamIn->rxCreditsOutstanding += numNewCredits;
+	return true;
+}
+
+
+static void fillPendingPacket(cxa_btle_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+
+	size_t payloadSize_bytes = getPayloadSize_bytes(streamIn);
+
+	streamIn->pendingPacket[0] = PACKET_TYPE_DATA;
+	streamIn->pendingPacketSize_bytes = CXA_BTLE_STREAM_PACKET_HEADER_SIZE_BYTES;
+
+	// at most two contiguous regions (if the fifo has wrapped)
+	for( int i = 0; i < 2; i++ )
+	{
+		size_t numBytesRemaining = (CXA_BTLE_STREAM_PACKET_HEADER_SIZE_BYTES + payloadSize_bytes) - streamIn->pendingPacketSize_bytes;
+		if( numBytesRemaining == 0 ) break;
+
+		void* contiguousBytes;
+		size_t numContiguousBytes = cxa_fixedFifo_bulkDequeue_peek(&streamIn->fifo_tx, &contiguousBytes);
+		if( numContiguousBytes == 0 ) break;
+
+		size_t numBytesToCopy = CXA_MIN(numContiguousBytes, numBytesRemaining);
+		memcpy(&streamIn->pendingPacket[streamIn->pendingPacketSize_bytes], contiguousBytes, numBytesToCopy);
+		cxa_fixedFifo_bulkDequeue(&streamIn->fifo_tx, numBytesToCopy);
+		streamIn->pendingPacketSize_bytes += numBytesToCopy;
+	}
+}
+
+
+static void btleCb_onSubscribed(const char *const serviceUuidIn, const char *const characteristicUuidIn, bool wasSuccessfulIn, void* userVarIn)
+{
+	cxa_btle_stream_t *const streamIn = (cxa_btle_stream_t *const)userVarIn;
+	cxa_assert(streamIn);
+
+	if( streamIn->state != CXA_BTLE_STREAM_STATE_OPENING ) return;
+
+	if( !wasSuccessfulIn )
+	{
+		cxa_logger_warn(&streamIn->logger, "failed to subscribe to rx characteristic");
+		finishOpening(streamIn, false);
+		return;
+	}
+
+	// give the peer its initial window...this fails until the tx characteristic
+	// has been resolved (retried from our runLoop)
+	streamIn->state = CXA_BTLE_STREAM_STATE_OPENING_TX;
+	if( grantRxCredits(streamIn, true) ) finishOpening(streamIn, true);
+	else wake(streamIn);
+}
+
+
+static void finishOpening(cxa_btle_stream_t *const streamIn, bool wasSuccessfulIn)
+{
+	cxa_assert(streamIn);
+
+	if( wasSuccessfulIn )
+	{
+		cxa_logger_info(&streamIn->logger, "open, ATT MTU %d", cxa_btle_connection_getAttMtu(streamIn->conn));
+		streamIn->state = CXA_BTLE_STREAM_STATE_OPEN;
+		pumpTx(streamIn);
+	}
+	else
+	{
+		cxa_btle_stream_close(streamIn);
+	}
+
+	if( streamIn->cb_onOpened != NULL ) streamIn->cb_onOpened(streamIn, wasSuccessfulIn, streamIn->cb_userVar);
+}
+
+
+static void btleCb_onRx(const char *const serviceUuidIn, const char *const characteristicUuidIn, cxa_fixedByteBuffer_t *fbb_readDataIn, void* userVarIn)
+{
+	cxa_btle_stream_t *const streamIn = (cxa_btle_stream_t *const)userVarIn;
+	cxa_assert(streamIn);
+
+	if( (streamIn->state == CXA_BTLE_STREAM_STATE_CLOSED) || (fbb_readDataIn == NULL) ) return;
+
+	size_t packetSize_bytes = cxa_fixedByteBuffer_getSize_bytes(fbb_readDataIn);
+	if( packetSize_bytes < CXA_BTLE_STREAM_PACKET_HEADER_SIZE_BYTES ) return;
+	uint8_t* packet = cxa_fixedByteBuffer_get_pointerToIndex(fbb_readDataIn, 0);
+
+	switch( packet[0] )
+	{
+		case PACKET_TYPE_DATA:
+		{
+			if( streamIn->rxCreditsOutstanding > 0 ) streamIn->rxCreditsOutstanding--;
+
+			size_t payloadSize_bytes = packetSize_bytes - CXA_BTLE_STREAM_PACKET_HEADER_SIZE_BYTES;
+			if( cxa_fixedFifo_getFreeSize_elems(&streamIn->fifo_rx) < payloadSize_bytes )
+			{
+				// peer didn't respect our window
+				streamIn->stats.numRxOverruns++;
+				return;
+			}
+			cxa_fixedFifo_bulkQueue(&streamIn->fifo_rx, &packet[CXA_BTLE_STREAM_PACKET_HEADER_SIZE_BYTES], payloadSize_bytes);
+
+			streamIn->stats.numPacketsRx++;
+			streamIn->stats.numBytesRx += payloadSize_bytes;
+			cxa_ioStream_notify_dataAvailable(&streamIn->ioStream);
+			break;
+		}
+
+		case PACKET_TYPE_CREDIT:
+			if( packetSize_bytes < 2 ) return;
+			streamIn->txCredits += packet[1];
+
+			// don't wait for the next runLoop iteration
+			pumpTx(streamIn);
+			if( streamIn->pendingPacketSize_bytes != 0 ) wake(streamIn);
+			break;
+
+		default:
+			cxa_logger_warn(&streamIn->logger, "unknown packet type: 0x%02X", packet[0]);
+			break;
+	}
+}
+
+
+static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn)
+{
+	cxa_btle_stream_t *const streamIn = (cxa_btle_stream_t *const)userVarIn;
+	cxa_assert(streamIn);
+
+	if( !cxa_fixedFifo_dequeue(&streamIn->fifo_rx, byteOut) ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+	// we may be able to grant more credits now
+	wake(streamIn);
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
+static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
+{
+	cxa_btle_stream_t *const streamIn = (cxa_btle_stream_t *const)userVarIn;
+	cxa_assert(streamIn);
+	if( buffIn == NULL ) return false;
+
+	// all or nothing
+	if( cxa_fixedFifo_getFreeSize_elems(&streamIn->fifo_tx) < bufferSize_bytesIn ) return false;
+	cxa_fixedFifo_bulkQueue(&streamIn->fifo_tx, buffIn, bufferSize_bytesIn);
+
+	// start sending immediately if we can
+	pumpTx(streamIn);
+	if( streamIn->pendingPacketSize_bytes != 0 ) wake(streamIn);
+
+	return true;
+}
+
+
+static void cb_onRunLoopUpdate(void* userVarIn)
+{
+	cxa_btle_stream_t *const streamIn = (cxa_btle_stream_t *const)userVarIn;
+	cxa_assert(streamIn);
+
+	if( streamIn->state == CXA_BTLE_STREAM_STATE_OPENING_TX )
+	{
+		if( grantRxCredits(streamIn, true) ) finishOpening(streamIn, true);
+		else if( cxa_timeDiff_isElapsed_ms(&streamIn->td_open, CXA_BTLE_STREAM_OPEN_TIMEOUT_MS) )
+		{
+			cxa_logger_warn(&streamIn->logger, "unable to send on tx characteristic");
+			finishOpening(streamIn, false);
+		}
+		return;
+	}
+	else if( streamIn->state == CXA_BTLE_STREAM_STATE_OPENING )
+	{
+		if( cxa_timeDiff_isElapsed_ms(&streamIn->td_open, CXA_BTLE_STREAM_OPEN_TIMEOUT_MS) )
+		{
+			cxa_logger_warn(&streamIn->logger, "timed out subscribing to rx characteristic");
+			finishOpening(streamIn, false);
+			return;
+		}
+
+		// the subscription callback wakes us
+		cxa_runLoop_entry_resumeAfter(streamIn->runLoopEntry, cxa_timeDiff_getRemainingTime_ms(&streamIn->td_open, CXA_BTLE_STREAM_OPEN_TIMEOUT_MS));
+		streamIn->isRunLoopEntrySuspended = true;
+		return;
+	}
+
+	if( streamIn->state == CXA_BTLE_STREAM_STATE_OPEN )
+	{
+		pumpTx(streamIn);
+		grantRxCredits(streamIn, false);
+
+		// keep retrying while the stack is busy, or while the peer has no credits
+		// but we have room for them...otherwise the peer / the reader wakes us
+		bool peerIsStalled = (streamIn->rxCreditsOutstanding == 0) &&
+							 (cxa_fixedFifo_getFreeSize_elems(&streamIn->fifo_rx) >= getRxCreditSize_bytes(streamIn));
+		if( (streamIn->pendingPacketSize_bytes != 0) || peerIsStalled ) return;
+	}
+
+	cxa_runLoop_entry_suspend(streamIn->runLoopEntry);
+	streamIn->isRunLoopEntrySuspended = true;
+}
+
+
+static void wake(cxa_btle_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+
+	// resuming takes the runLoop's idle lock, don't do it for every byte read
+	if( !streamIn->isRunLoopEntrySuspended ) return;
+
+	streamIn->isRunLoopEntrySuspended = false;
+	cxa_runLoop_entry_resume(streamIn->runLoopEntry);
+}
@@ -8,10 +8,13 @@
 
 
 // ******** includes ********
+#include <string.h>
+
 #include <cxa_array.h>
 #include <cxa_assert.h>
 #include <cxa_ioStream_peekable.h>
 #include <cxa_runLoop.h>
+#include <cxa_siLabsBgApi_eventDispatcher.h>
 #include <cxa_siLabsBgApi_module.h>
 
 #define CXA_LOG_LEVEL			CXA_LOG_LEVEL_DEBUG
@@ -29,6 +32,17 @@ static cxa_siLabsBgApi_btle_connection_t* getUnusedConnection(cxa_siLabsBgApi_bt
 static cxa_siLabsBgApi_btle_connection_t* getConnectionByAddress(cxa_siLabsBgApi_btle_central_t *const btlecIn, cxa_eui48_t *const targetAddrIn);
 static cxa_siLabsBgApi_btle_connection_t* getConnectionByHandle(cxa_siLabsBgApi_btle_central_t *const btlecIn, uint8_t connHandleIn);
 
+static bool evtCb_connectionOpened(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_connectionClosed(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_procedureCompleted(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_mtuExchanged(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_connectionParameters(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_phyStatus(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_service(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_characteristic(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_characteristicValue(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_scanResponse(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+
 static cxa_btle_central_state_t scm_getState(cxa_btle_central_t *const superIn);
 static void scm_startScan(cxa_btle_central_t *const superIn, bool isActiveIn);
 static void scm_stopScan(cxa_btle_central_t *const superIn);
@@ -49,6 +63,7 @@ void cxa_siLabsBgApi_btle_central_init(cxa_siLabsBgApi_btle_central_t *const btl
 	// save our references and setup our internal state
 	btlecIn->threadId = threadIdIn;
 	btlecIn->isConnectionInProgress = false;
+	memset(btlecIn->connsByHandle, 0, sizeof(btlecIn->connsByHandle));
 
 	// initialize our connections
 	for( size_t i = 0; i < sizeof(btlecIn->conns)/sizeof(*btlecIn->conns); i++ )
@@ -56,6 +71,18 @@ void cxa_siLabsBgApi_btle_central_init(cxa_siLabsBgApi_btle_central_t *const btl
 		cxa_siLabsBgApi_btle_connection_init(&btlecIn->conns[i], &btlecIn->super, threadIdIn);
 	}
 
+	// register for the events we care about
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_le_connection_opened_id, evtCb_connectionOpened, (void*)btlecIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_le_connection_closed_id, evtCb_connectionClosed, (void*)btlecIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_gatt_procedure_completed_id, evtCb_procedureCompleted, (void*)btlecIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_gatt_mtu_exchanged_id, evtCb_mtuExchanged, (void*)btlecIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_le_connection_parameters_id, evtCb_connectionParameters, (void*)btlecIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_le_connection_phy_status_id, evtCb_phyStatus, (void*)btlecIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_gatt_service_id, evtCb_service, (void*)btlecIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_gatt_characteristic_id, evtCb_characteristic, (void*)btlecIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_gatt_characteristic_value_id, evtCb_characteristicValue, (void*)btlecIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_le_gap_scan_response_id, evtCb_scanResponse, (void*)btlecIn);
+
 	// initialize our super class
 	cxa_btle_central_init(&btlecIn->super, scm_getState, scm_startScan, scm_stopScan, scm_startConnection);
 }
@@ -88,7 +115,8 @@ bool cxa_siLabsBgApi_btle_central_setConnectionInterval(cxa_siLabsBgApi_btle_cen
 
 
 	// Interval Max * (Slave Latency + 1) ≤ 2 seconds
-	uint16_t latency = (2.0 / ((float)(max_interval_ms * 1000.0))) - 1.0;
+	// (keep it simple and use no slave latency)
+	uint16_t latency = 0;
 
 
 	// Interval Max * (Slave Latency + 1) * 3 < connSupervisionTimeout
@@ -97,157 +125,18 @@ bool cxa_siLabsBgApi_btle_central_setConnectionInterval(cxa_siLabsBgApi_btle_cen
 	if( timeout_ms < 100 ) timeout_ms = 100;
 
 
-	cxa_logger_info(&btlecIn->super.logger, "setting conn. params   minInt: %d ms   maxIn: %dms  lat: %d  timeout: %d ms", min_interval_ms, max_interval_ms, latency, timeout_ms);
-	struct gecko_msg_le_connection_set_parameters_rsp_t* resp = gecko_cmd_le_connection_set_parameters(targetConn->connHandle,
-																									   (min_interval_ms / 1.25),
-																									   (max_interval_ms / 1.25),
-																									   latency,
-																									   timeout_ms / 10);
-	if( resp->result != 0 )
-	{
-		cxa_logger_warn(&btlecIn->super.logger, "error setting conn. params: 0x%04x", resp->result);
-		return false;
-	}
+	cxa_btle_connection_parameters_t params;
+	params.minInterval_us = (uint32_t)min_interval_ms * 1000;
+	params.maxInterval_us = (uint32_t)max_interval_ms * 1000;
+	params.slaveLatency = latency;
+	params.supervisionTimeout_ms = timeout_ms;
+	if( !cxa_btle_connection_requestParameters(&targetConn->super, &params) ) return false;
 
 	// if we made it here, we were successful;
 	return true;
 }
 
 
-bool cxa_siLabsBgApi_btle_central_handleBgEvent(cxa_siLabsBgApi_btle_central_t *const btlecIn, struct gecko_cmd_packet *evt)
-{
-	cxa_assert(btlecIn);
-
-	if( NULL == evt ) return false;
-
-	// Handle events
-	bool retVal = false;
-	switch( BGLIB_MSG_ID(evt->header) )
-	{
-		case gecko_evt_le_connection_opened_id:
-		{
-			btlecIn->isConnectionInProgress = false;
-
-			cxa_eui48_t connectedAddr;
-			cxa_eui48_init(&connectedAddr, evt->data.evt_le_connection_opened.address.addr);
-
-			cxa_eui48_string_t connectedAddrStr;
-			cxa_eui48_toString(&connectedAddr, &connectedAddrStr);
-
-			// notify our connection
-			cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evt->data.evt_le_connection_opened.connection);
-			if( currConn != NULL )
-			{
-				cxa_logger_debug(&btlecIn->super.logger, "connected to '%s' handle %d", connectedAddrStr.str, evt->data.evt_le_connection_opened.connection);
-				cxa_siLabsBgApi_btle_connection_handleEvent_opened(currConn);
-				retVal = true;
-			}
-			break;
-		}
-
-		case gecko_evt_le_connection_closed_id:
-		{
-			btlecIn->isConnectionInProgress = false;
-
-			cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evt->data.evt_le_connection_closed.connection);
-			if( currConn != NULL )
-			{
-				cxa_logger_debug(&btlecIn->super.logger, "disconnected");
-				cxa_siLabsBgApi_btle_connection_handleEvent_closed(currConn, evt->data.evt_le_connection_closed.reason);
-				retVal = true;
-			}
-			break;
-		}
-
-		case gecko_evt_gatt_procedure_completed_id:
-		{
-			cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evt->data.evt_gatt_procedure_completed.connection);
-			if( currConn != NULL )
-			{
-				cxa_logger_debug(&btlecIn->super.logger, "procedure complete");
-				cxa_siLabsBgApi_btle_connection_handleEvent_procedureComplete(currConn, evt->data.evt_gatt_procedure_completed.result);
-				retVal = true;
-			}
-			break;
-		}
-
-		case gecko_evt_gatt_service_id:
-		{
-			cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evt->data.evt_gatt_service.connection);
-			if( currConn != NULL )
-			{
-				cxa_logger_debug(&btlecIn->super.logger, "resolved service");
-				cxa_btle_uuid_t tmpUuid;
-				if( cxa_btle_uuid_init(&tmpUuid, evt->data.evt_gatt_service.uuid.data, evt->data.evt_gatt_service.uuid.len, true) )
-				{
-					cxa_siLabsBgApi_btle_connection_handleEvent_serviceResolved(currConn, &tmpUuid, evt->data.evt_gatt_service.service);
-				}
-				retVal = true;
-			}
-			break;
-		}
-
-		case gecko_evt_gatt_characteristic_id:
-		{
-			cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evt->data.evt_gatt_characteristic.connection);
-			if( currConn != NULL )
-			{
-				cxa_logger_debug(&btlecIn->super.logger, "resolved characteristic");
-				cxa_btle_uuid_t tmpUuid;
-				if( cxa_btle_uuid_init(&tmpUuid, evt->data.evt_gatt_characteristic.uuid.data, evt->data.evt_gatt_characteristic.uuid.len, true) )
-				{
-					cxa_siLabsBgApi_btle_connection_handleEvent_characteristicResolved(currConn, &tmpUuid, evt->data.evt_gatt_characteristic.characteristic);
-				}
-				retVal = true;
-			}
-			break;
-		}
-
-		case gecko_evt_gatt_characteristic_value_id:
-		{
-			cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evt->data.evt_gatt_characteristic_value.connection);
-			if( currConn != NULL )
-			{
-				cxa_logger_trace(&btlecIn->super.logger, "got characteristic value");
-				cxa_siLabsBgApi_btle_connection_handleEvent_characteristicValueUpdated(currConn, evt->data.evt_gatt_characteristic_value.characteristic, evt->data.evt_gatt_characteristic_value.att_opcode, evt->data.evt_gatt_characteristic_value.value.data, evt->data.evt_gatt_characteristic_value.value.len);
-				retVal = true;
-			}
-			break;
-		}
-
-		case gecko_evt_le_gap_scan_response_id:
-		{
-//			cxa_logger_debug_memDump(&btlecIn->super.logger, "rxBytes: ", evt->data.evt_le_gap_scan_response.data.data, evt->data.evt_le_gap_scan_response.data.len, NULL);
-
-			cxa_btle_advPacket_t rxPacket;
-			if( cxa_btle_advPacket_init(&rxPacket,
-										evt->data.evt_le_gap_scan_response.address.addr,
-										(evt->data.evt_le_gap_scan_response.address_type == le_gap_address_type_random),
-										evt->data.evt_le_gap_scan_response.rssi,
-										evt->data.evt_le_gap_scan_response.data.data,
-										evt->data.evt_le_gap_scan_response.data.len) )
-			{
-				// if we made it here, we parsed the packet successfully...notify our listeners
-				cxa_btle_central_notify_advertRx(&btlecIn->super, &rxPacket);
-			}
-			else
-			{
-				cxa_logger_warn(&btlecIn->super.logger, "malformed advert packet");
-			}
-			retVal = true;
-
-			break;
-		}
-
-		default:
-			cxa_logger_debug(&btlecIn->super.logger, "unhandled event: 0x%08X", BGLIB_MSG_ID(evt->header));
-			break;
-	}
-
-	return retVal;
-}
-
-
 // ******** local function implementations ********
 static cxa_siLabsBgApi_btle_connection_t* getUnusedConnection(cxa_siLabsBgApi_btle_central_t *const btlecIn)
 {
@@ -294,8 +183,17 @@ static cxa_siLabsBgApi_btle_connection_t* getConnectionByHandle(cxa_siLabsBgApi_
 {
 	cxa_assert(btlecIn);
 
-	cxa_siLabsBgApi_btle_connection_t* retVal = NULL;
+	// fast path: handles are small integers assigned by the stack
+	cxa_siLabsBgApi_btle_connection_t* retVal = (connHandleIn < CXA_SILABSBGAPI_BTLE_CENTRAL_MAXNUM_CONN_HANDLES) ? btlecIn->connsByHandle[connHandleIn] : NULL;
+	if( (retVal != NULL) &&
+		cxa_siLabsBgApi_btle_connection_isUsed(retVal) &&
+		(retVal->connHandle == connHandleIn) )
+	{
+		return retVal;
+	}
 
+	// stale or missing...fall back to a search and remember the result
+	retVal = NULL;
 	for( size_t i = 0; i < sizeof(btlecIn->conns)/sizeof(*btlecIn->conns); i++ )
 	{
 		cxa_siLabsBgApi_btle_connection_t* currConn = &btlecIn->conns[i];
@@ -306,11 +204,185 @@ static cxa_siLabsBgApi_btle_connection_t* getConnectionByHandle(cxa_siLabsBgApi_
 			break;
 		}
 	}
+	if( connHandleIn < CXA_SILABSBGAPI_BTLE_CENTRAL_MAXNUM_CONN_HANDLES ) btlecIn->connsByHandle[connHandleIn] = retVal;
 
 	return retVal;
 }
 
 
+static bool evtCb_connectionOpened(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_central_t *const btlecIn = (cxa_siLabsBgApi_btle_central_t *const)userVarIn;
+	cxa_assert(btlecIn);
+
+	btlecIn->isConnectionInProgress = false;
+
+	// notify our connection
+	cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evtIn->data.evt_le_connection_opened.connection);
+	if( currConn == NULL ) return false;
+
+	cxa_eui48_t connectedAddr;
+	cxa_eui48_init(&connectedAddr, evtIn->data.evt_le_connection_opened.address.addr);
+
+	cxa_eui48_string_t connectedAddrStr;
+	cxa_eui48_toString(&connectedAddr, &connectedAddrStr);
+
+	cxa_logger_debug(&btlecIn->super.logger, "connected to '%s' handle %d", connectedAddrStr.str, evtIn->data.evt_le_connection_opened.connection);
+	cxa_siLabsBgApi_btle_connection_handleEvent_opened(currConn);
+	return true;
+}
+
+
+static bool evtCb_connectionClosed(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_central_t *const btlecIn = (cxa_siLabsBgApi_btle_central_t *const)userVarIn;
+	cxa_assert(btlecIn);
+
+	btlecIn->isConnectionInProgress = false;
+
+	cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evtIn->data.evt_le_connection_closed.connection);
+	if( currConn == NULL ) return false;
+
+	cxa_logger_debug(&btlecIn->super.logger, "disconnected");
+	cxa_siLabsBgApi_btle_connection_handleEvent_closed(currConn, evtIn->data.evt_le_connection_closed.reason);
+	return true;
+}
+
+
+static bool evtCb_procedureCompleted(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_central_t *const btlecIn = (cxa_siLabsBgApi_btle_central_t *const)userVarIn;
+	cxa_assert(btlecIn);
+
+	cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evtIn->data.evt_gatt_procedure_completed.connection);
+	if( currConn == NULL ) return false;
+
+	cxa_logger_debug(&btlecIn->super.logger, "procedure complete");
+	cxa_siLabsBgApi_btle_connection_handleEvent_procedureComplete(currConn, evtIn->data.evt_gatt_procedure_completed.result);
+	return true;
+}
+
+
+static bool evtCb_mtuExchanged(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_central_t *const btlecIn = (cxa_siLabsBgApi_btle_central_t *const)userVarIn;
+	cxa_assert(btlecIn);
+
+	cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evtIn->data.evt_gatt_mtu_exchanged.connection);
+	if( currConn == NULL ) return false;
+
+	cxa_siLabsBgApi_btle_connection_handleEvent_mtuExchanged(currConn, evtIn->data.evt_gatt_mtu_exchanged.mtu);
+	return true;
+}
+
+
+static bool evtCb_connectionParameters(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_central_t *const btlecIn = (cxa_siLabsBgApi_btle_central_t *const)userVarIn;
+	cxa_assert(btlecIn);
+
+	struct gecko_msg_le_connection_parameters_evt_t* evt = &evtIn->data.evt_le_connection_parameters;
+	cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evt->connection);
+	if( currConn == NULL ) return false;
+
+	cxa_siLabsBgApi_btle_connection_handleEvent_parametersChanged(currConn, evt->interval, evt->latency, evt->timeout, evt->txsize);
+	return true;
+}
+
+
+static bool evtCb_phyStatus(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_central_t *const btlecIn = (cxa_siLabsBgApi_btle_central_t *const)userVarIn;
+	cxa_assert(btlecIn);
+
+	cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evtIn->data.evt_le_connection_phy_status.connection);
+	if( currConn == NULL ) return false;
+
+	cxa_siLabsBgApi_btle_connection_handleEvent_phyChanged(currConn, evtIn->data.evt_le_connection_phy_status.phy);
+	return true;
+}
+
+
+static bool evtCb_service(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_central_t *const btlecIn = (cxa_siLabsBgApi_btle_central_t *const)userVarIn;
+	cxa_assert(btlecIn);
+
+	cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evtIn->data.evt_gatt_service.connection);
+	if( currConn == NULL ) return false;
+
+	cxa_logger_debug(&btlecIn->super.logger, "resolved service");
+	cxa_btle_uuid_t tmpUuid;
+	if( cxa_btle_uuid_init(&tmpUuid, evtIn->data.evt_gatt_service.uuid.data, evtIn->data.evt_gatt_service.uuid.len, true) )
+	{
+		cxa_siLabsBgApi_btle_connection_handleEvent_serviceResolved(currConn, &tmpUuid, evtIn->data.evt_gatt_service.service);
+	}
+	return true;
+}
+
+
+static bool evtCb_characteristic(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_central_t *const btlecIn = (cxa_siLabsBgApi_btle_central_t *const)userVarIn;
+	cxa_assert(btlecIn);
+
+	cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evtIn->data.evt_gatt_characteristic.connection);
+	if( currConn == NULL ) return false;
+
+	cxa_logger_debug(&btlecIn->super.logger, "resolved characteristic");
+	cxa_btle_uuid_t tmpUuid;
+	if( cxa_btle_uuid_init(&tmpUuid, evtIn->data.evt_gatt_characteristic.uuid.data, evtIn->data.evt_gatt_characteristic.uuid.len, true) )
+	{
+		cxa_siLabsBgApi_btle_connection_handleEvent_characteristicResolved(currConn, &tmpUuid, evtIn->data.evt_gatt_characteristic.characteristic);
+	}
+	return true;
+}
+
+
+static bool evtCb_characteristicValue(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_central_t *const btlecIn = (cxa_siLabsBgApi_btle_central_t *const)userVarIn;
+	cxa_assert(btlecIn);
+
+	cxa_siLabsBgApi_btle_connection_t* currConn = getConnectionByHandle(btlecIn, evtIn->data.evt_gatt_characteristic_value.connection);
+	if( currConn == NULL ) return false;
+
+	// value is passed by reference directly out of the BGLib buffer
+	cxa_logger_trace(&btlecIn->super.logger, "got characteristic value");
+	cxa_siLabsBgApi_btle_connection_handleEvent_characteristicValueUpdated(currConn,
+																		   evtIn->data.evt_gatt_characteristic_value.characteristic,
+																		   evtIn->data.evt_gatt_characteristic_value.att_opcode,
+																		   evtIn->data.evt_gatt_characteristic_value.value.data,
+																		   evtIn->data.evt_gatt_characteristic_value.value.len);
+	return true;
+}
+
+
+static bool evtCb_scanResponse(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_central_t *const btlecIn = (cxa_siLabsBgApi_btle_central_t *const)userVarIn;
+	cxa_assert(btlecIn);
+
+	cxa_btle_advPacket_t rxPacket;
+	if( cxa_btle_advPacket_init(&rxPacket,
+								evtIn->data.evt_le_gap_scan_response.address.addr,
+								(evtIn->data.evt_le_gap_scan_response.address_type == le_gap_address_type_random),
+								evtIn->data.evt_le_gap_scan_response.rssi,
+								evtIn->data.evt_le_gap_scan_response.data.data,
+								evtIn->data.evt_le_gap_scan_response.data.len) )
+	{
+		// if we made it here, we parsed the packet successfully...notify our listeners
+		cxa_btle_central_notify_advertRx(&btlecIn->super, &rxPacket);
+	}
+	else
+	{
+		cxa_logger_warn(&btlecIn->super.logger, "malformed advert packet");
+	}
+
+	return true;
+}
+
+
 static cxa_btle_central_state_t scm_getState(cxa_btle_central_t *const superIn)
 {
 	cxa_siLabsBgApi_btle_central_t *const btlecIn = (cxa_siLabsBgApi_btle_central_t *const)superIn;
@@ -20,6 +20,10 @@
 
 #define DISCONNECT_TIMEOUT_MS			2000
 
+#define CONN_INTERVAL_UNIT_US			1250
+#define SUPERVISION_TIMEOUT_UNIT_MS		10
+#define MAX_CE_LENGTH					0xFFFF
+
 
 // ******** local type definitions ********
 typedef enum
@@ -43,12 +47,62 @@ static cxa_siLabsBgApi_btle_connection_cachedServiceEntry_t* getCachedServiceByU
 static cxa_siLabsBgApi_btle_connection_cachedCharacteristicEntry_t* getCachedCharacteristicByUuid(cxa_siLabsBgApi_btle_connection_t *const connIn, const char *const charUuidStrIn);
 static cxa_siLabsBgApi_btle_connection_cachedCharacteristicEntry_t* getCachedCharacteristicByHandle(cxa_siLabsBgApi_btle_connection_t *const connIn, uint16_t handleIn);
 
+static bool isConnected(cxa_siLabsBgApi_btle_connection_t *const connIn);
 static void handleProcedureComplete(cxa_siLabsBgApi_btle_connection_t *const connIn, bool wasSuccessfulIn);
+static bool sendWriteNoResponse(cxa_siLabsBgApi_btle_connection_t *const connIn, uint16_t charHandleIn, void *const dataIn, size_t numBytesIn);
 
 static void scm_stopConnection(cxa_btle_connection_t *const superIn);
 static void scm_readFromCharacteristic(cxa_btle_connection_t *const superIn, const char *const serviceUuidIn, const char *const characteristicUuidIn);
 static void scm_writeToCharacteristic(cxa_btle_connection_t *const superIn, const char *const serviceUuidIn, const char *const characteristicUuidIn, cxa_fixedByteBuffer_t *const dataIn);
+static bool scm_writeToCharacteristic_noResponse(cxa_btle_connection_t *const superIn, const char *const serviceUuidIn, const char *const characteristicUuidIn, void *const dataIn, size_t numBytesIn);
 static void scm_changeNotifications(cxa_btle_connection_t *const superIn, const char *const serviceUuidIn, const char *const characteristicUuidIn, bool enableNotifications);
+static bool scm_requestParameters(cxa_btle_connection_t *const superIn, cxa_btle_connection_parameters_t *const paramsIn);
+static bool scm_requestPhy(cxa_btle_connection_t *const superIn, uint8_t phyMaskIn);
+
+static bool scm_requestParameters(cxa_btle_connection_t *const superIn, cxa_btle_connection_parameters_t *const paramsIn)
+{
+	cxa_siLabsBgApi_btle_connection_t *const connIn = (cxa_siLabsBgApi_btle_connection_t *const)superIn;
+	cxa_assert(connIn);
+	cxa_assert(paramsIn);
+
+	if( !isConnected(connIn) ) return false;
+
+	cxa_logger_debug(&connIn->logger, "requesting conn. params   minInt: %d us  maxInt: %d us  lat: %d  timeout: %d ms",
+					 paramsIn->minInterval_us, paramsIn->maxInterval_us, paramsIn->slaveLatency, paramsIn->supervisionTimeout_ms);
+	struct gecko_msg_le_connection_set_timing_parameters_rsp_t* rsp = gecko_cmd_le_connection_set_timing_parameters(connIn->connHandle,
+																													paramsIn->minInterval_us / CONN_INTERVAL_UNIT_US,
+																													paramsIn->maxInterval_us / CONN_INTERVAL_UNIT_US,
+																													paramsIn->slaveLatency,
+																													paramsIn->supervisionTimeout_ms / SUPERVISION_TIMEOUT_UNIT_MS,
+																													0, MAX_CE_LENGTH);
+	if( rsp->result != 0 )
+	{
+		cxa_logger_warn(&connIn->logger, "error setting conn. params: 0x%04x", rsp->result);
+		return false;
+	}
+
+	return true;
+}
+
+
+static bool scm_requestPhy(cxa_btle_connection_t *const superIn, uint8_t phyMaskIn)
+{
+	cxa_siLabsBgApi_btle_connection_t *const connIn = (cxa_siLabsBgApi_btle_connection_t *const)superIn;
+	cxa_assert(connIn);
+
+	if( !isConnected(connIn) ) return false;
+
+	// BGAPI uses the same bit values as cxa_btle_connection_phy_t
+	struct gecko_msg_le_connection_set_phy_rsp_t* rsp = gecko_cmd_le_connection_set_phy(connIn->connHandle, phyMaskIn);
+	if( rsp->result != 0 )
+	{
+		cxa_logger_warn(&connIn->logger, "error setting phy: 0x%04x", rsp->result);
+		return false;
+	}
+
+	return true;
+}
+
 
 static void stateCb_unused_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void stateCb_connecting_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
@@ -73,7 +127,9 @@ void cxa_siLabsBgApi_btle_connection_init(cxa_siLabsBgApi_btle_connection_t *con
 	cxa_assert(parentClientIn);
 
 	// initialize our superclass
-	cxa_btle_connection_init(&connIn->super, parentClientIn, scm_stopConnection, scm_readFromCharacteristic, scm_writeToCharacteristic, scm_changeNotifications);
+	cxa_btle_connection_init(&connIn->super, parentClientIn, scm_stopConnection, scm_readFromCharacteristic, scm_writeToCharacteristic, scm_writeToCharacteristic_noResponse, scm_changeNotifications);
+	// data length extension is negotiated by the stack itself (reported via the parameters event)
+	cxa_btle_connection_setLinkScms(&connIn->super, scm_requestParameters, scm_requestPhy, NULL);
 
 	// save our references and setup our internal state
 	cxa_array_initStd(&connIn->cachedServices, connIn->cachedServices_raw);
@@ -97,6 +153,8 @@ void cxa_siLabsBgApi_btle_connection_init(cxa_siLabsBgApi_btle_connection_t *con
 	cxa_stateMachine_addState(&connIn->stateMachine, STATE_CONNECTED_PROCEDURE_TIMEOUT, "procTimeout", stateCb_connProcTimeout_enter, NULL, NULL, (void*)connIn);
 	cxa_stateMachine_addState_timed(&connIn->stateMachine, STATE_DISCONNECTING, "disconnecting", STATE_UNUSED, DISCONNECT_TIMEOUT_MS, stateCb_disconnecting_enter, NULL, NULL, (void*)connIn);
 	cxa_stateMachine_setInitialState(&connIn->stateMachine, STATE_UNUSED);
+	// we're driven by module events (and our timed states)
+	cxa_stateMachine_setSuspendWhenIdle(&connIn->stateMachine, true);
 }
 
 
@@ -272,6 +330,36 @@ void cxa_siLabsBgApi_btle_connection_handleEvent_characteristicValueUpdated(cxa_
 }
 
 
+void cxa_siLabsBgApi_btle_connection_handleEvent_mtuExchanged(cxa_siLabsBgApi_btle_connection_t *const connIn, uint16_t mtuIn)
+{
+	cxa_assert(connIn);
+
+	cxa_logger_debug(&connIn->logger, "ATT MTU is now %d", mtuIn);
+	cxa_btle_connection_notify_attMtuChanged(&connIn->super, mtuIn);
+}
+
+
+void cxa_siLabsBgApi_btle_connection_handleEvent_parametersChanged(cxa_siLabsBgApi_btle_connection_t *const connIn, uint16_t interval_1250usIn, uint16_t latencyIn, uint16_t timeout_10msIn, uint16_t txSize_bytesIn)
+{
+	cxa_assert(connIn);
+
+	cxa_logger_debug(&connIn->logger, "conn. params   int: %d us  lat: %d  timeout: %d ms  txSize: %d",
+					 (uint32_t)interval_1250usIn * CONN_INTERVAL_UNIT_US, latencyIn, timeout_10msIn * SUPERVISION_TIMEOUT_UNIT_MS, txSize_bytesIn);
+	cxa_btle_connection_notify_parametersChanged(&connIn->super, (uint32_t)interval_1250usIn * CONN_INTERVAL_UNIT_US, latencyIn, timeout_10msIn * SUPERVISION_TIMEOUT_UNIT_MS);
+	cxa_btle_connection_notify_dataLengthChanged(&connIn->super, txSize_bytesIn);
+}
+
+
+void cxa_siLabsBgApi_btle_connection_handleEvent_phyChanged(cxa_siLabsBgApi_btle_connection_t *const connIn, uint8_t phyIn)
+{
+	cxa_assert(connIn);
+
+	// BGAPI uses the same bit values as cxa_btle_connection_phy_t
+	cxa_logger_debug(&connIn->logger, "PHY is now 0x%02X", phyIn);
+	cxa_btle_connection_notify_phyChanged(&connIn->super, (cxa_btle_connection_phy_t)phyIn);
+}
+
+
 void cxa_siLabsBgApi_btle_connection_handleEvent_procedureComplete(cxa_siLabsBgApi_btle_connection_t *const connIn, uint16_t resultCodeIn)
 {
 	cxa_assert(connIn);
@@ -306,6 +394,11 @@ void cxa_siLabsBgApi_btle_connection_handleEvent_procedureComplete(cxa_siLabsBgA
 					cxa_stateMachine_transition(&connIn->stateMachine, STATE_CONNECTED_CHANGE_NOTI_INDI);
 					break;
 
+				case CXA_SILABSBGAPI_PROCTYPE_RESOLVE:
+					// handle is now cached (for write commands)...nothing else to do
+					handleProcedureComplete(connIn, true);
+					break;
+
 				default:
 					cxa_logger_warn(&connIn->logger, "unspecified target procedure, aborting");
 					cxa_stateMachine_transitionNow(&connIn->stateMachine, STATE_CONNECTED_IDLE);
@@ -409,6 +502,18 @@ static cxa_siLabsBgApi_btle_connection_cachedCharacteristicEntry_t* getCachedCha
 }
 
 
+static bool isConnected(cxa_siLabsBgApi_btle_connection_t *const connIn)
+{
+	cxa_assert(connIn);
+
+	state_t currState = cxa_stateMachine_getCurrentState(&connIn->stateMachine);
+	return (currState != STATE_UNUSED) &&
+		   (currState != STATE_CONNECTING) &&
+		   (currState != STATE_CONNECTING_TIMEOUT) &&
+		   (currState != STATE_DISCONNECTING);
+}
+
+
 static void handleProcedureComplete(cxa_siLabsBgApi_btle_connection_t *const connIn, bool wasSuccessfulIn)
 {
 	cxa_assert(connIn);
@@ -441,6 +546,22 @@ static void handleProcedureComplete(cxa_siLabsBgApi_btle_connection_t *const con
 }
 
 
+static bool sendWriteNoResponse(cxa_siLabsBgApi_btle_connection_t *const connIn, uint16_t charHandleIn, void *const dataIn, size_t numBytesIn)
+{
+	cxa_assert(connIn);
+
+	struct gecko_msg_gatt_write_characteristic_value_without_response_rsp_t* rsp = gecko_cmd_gatt_write_characteristic_value_without_response(connIn->connHandle, charHandleIn, numBytesIn, dataIn);
+	if( rsp->result != 0 )
+	{
+		// most likely out of tx buffers...caller should retry
+		cxa_logger_trace(&connIn->logger, "write command failed: %d", rsp->result);
+		return false;
+	}
+
+	return (rsp->sent_len == numBytesIn);
+}
+
+
 static void scm_stopConnection(cxa_btle_connection_t *const superIn)
 {
 	cxa_siLabsBgApi_btle_connection_t *const connIn = (cxa_siLabsBgApi_btle_connection_t *const)superIn;
@@ -558,6 +679,39 @@ static void scm_writeToCharacteristic(cxa_btle_connection_t *const superIn, cons
 }
 
 
+static bool scm_writeToCharacteristic_noResponse(cxa_btle_connection_t *const superIn, const char *const serviceUuidIn, const char *const characteristicUuidIn, void *const dataIn, size_t numBytesIn)
+{
+	cxa_siLabsBgApi_btle_connection_t *const connIn = (cxa_siLabsBgApi_btle_connection_t *const)superIn;
+	cxa_assert(connIn);
+	cxa_assert(serviceUuidIn);
+	cxa_assert(characteristicUuidIn);
+
+	if( !isConnected(connIn) ) return false;
+	state_t currState = cxa_stateMachine_getCurrentState(&connIn->stateMachine);
+
+	// write commands may be interleaved with other procedures as long as we already know the handle
+	cxa_siLabsBgApi_btle_connection_cachedCharacteristicEntry_t* cachedCharEntry = getCachedCharacteristicByUuid(connIn, characteristicUuidIn);
+	if( cachedCharEntry != NULL ) return sendWriteNoResponse(connIn, cachedCharEntry->handle, dataIn, numBytesIn);
+
+	// not sent: we need to resolve the characteristic first (so the caller's
+	// retry succeeds)...that requires us to be idle
+	if( (currState != STATE_CONNECTED_IDLE) ||
+		(connIn->targetProcType != CXA_SILABSBGAPI_PROCTYPE_NONE) )
+	{
+		return false;
+	}
+
+	// save our target service and characteristic
+	connIn->targetServiceUuid_str = serviceUuidIn;
+	connIn->targetCharacteristicUuid_str = characteristicUuidIn;
+
+	connIn->targetProcType = CXA_SILABSBGAPI_PROCTYPE_RESOLVE;
+	cxa_stateMachine_transition(&connIn->stateMachine,
+								(getCachedServiceByUuid(connIn, connIn->targetServiceUuid_str) == NULL) ? STATE_CONNECTED_RESOLVE_SERVICE : STATE_CONNECTED_RESOLVE_CHAR);
+	return false;
+}
+
+
 static void scm_changeNotifications(cxa_btle_connection_t *const superIn, const char *const serviceUuidIn, const char *const characteristicUuidIn, bool enableNotificationsIn)
 {
 	cxa_siLabsBgApi_btle_connection_t *const connIn = (cxa_siLabsBgApi_btle_connection_t *const)superIn;
@@ -643,6 +797,10 @@ static void stateCb_connecting_enter(cxa_stateMachine_t *const smIn, int prevSta
 	cxa_eui48_toString(&connIn->super.targetAddr, &targetAddr_str);
 
 	cxa_logger_info(&connIn->logger, "connecting to '%s'", targetAddr_str.str);
+
+	// the stack performs the MTU exchange on connect, up to this limit
+	gecko_cmd_gatt_set_max_mtu(CXA_SILABSBGAPI_BTLE_CONNECTION_MAX_ATT_MTU);
+
 	struct gecko_msg_le_gap_connect_rsp_t* rsp = gecko_cmd_le_gap_connect(targetAddr, le_gap_address_type_public, le_gap_phy_1m);
 	if( rsp->result != 0 )
 	{
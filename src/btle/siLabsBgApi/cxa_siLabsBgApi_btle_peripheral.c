@@ -11,6 +11,7 @@
 #include <stdbool.h>
 
 #include <cxa_assert.h>
+#include <cxa_siLabsBgApi_eventDispatcher.h>
 
 #define CXA_LOG_LEVEL				CXA_LOG_LEVEL_TRACE
 #include <cxa_logger_implementation.h>
@@ -36,6 +37,12 @@ static cxa_siLabsBgApi_btle_handleMacMapEntry_t* getHandleMacEntry_byMac(cxa_siL
 
 static cxa_siLabsBgApi_btle_handleMacMapEntry_t* getHandleMacEntry_byHandle(cxa_siLabsBgApi_btle_peripheral_t *const btlepIn, uint8_t handleIn);
 
+static bool evtCb_connectionOpened(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_connectionClosed(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_userReadRequest(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_userWriteRequest(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_characteristicStatus(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+
 static void scm_sendNotification(cxa_btle_peripheral_t *const superIn, const char *const serviceUuidStrIn, const char *const characteristicUuidStrIn, cxa_fixedByteBuffer_t *const fbb_dataIn);
 static void scm_sendDeferredReadResponse(cxa_btle_peripheral_t *const superIn, cxa_eui48_t *const sourceAddrIn, const char *const serviceUuidStrIn, const char *const characteristicUuidStrIn, cxa_btle_peripheral_readRetVal_t retValIn, cxa_fixedByteBuffer_t *const fbbReadDataIn);
 static void scm_sendDeferredWriteResponse(cxa_btle_peripheral_t *const superIn, cxa_eui48_t *const sourceAddrIn, const char *const serviceUuidStrIn, const char *const characteristicUuidStrIn, cxa_btle_peripheral_writeRetVal_t retValIn);
@@ -58,6 +65,13 @@ void cxa_siLabsBgApi_btle_peripheral_init(cxa_siLabsBgApi_btle_peripheral_t *con
 
 	// initialize our super class
 	cxa_btle_peripheral_init(&btlepIn->super, scm_sendNotification, scm_sendDeferredReadResponse, scm_sendDeferredWriteResponse, scm_setAdvertisingInfo, scm_startAdvertising);
+
+	// register for the events we care about (connection events are shared with the central)
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_le_connection_opened_id, evtCb_connectionOpened, (void*)btlepIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_le_connection_closed_id, evtCb_connectionClosed, (void*)btlepIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_gatt_server_user_read_request_id, evtCb_userReadRequest, (void*)btlepIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_gatt_server_user_write_request_id, evtCb_userWriteRequest, (void*)btlepIn);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_gatt_server_characteristic_status_id, evtCb_characteristicStatus, (void*)btlepIn);
 }
 
 
@@ -85,112 +99,6 @@ void cxa_siLabsBgApi_btle_peripheral_registerHandle(cxa_siLabsBgApi_btle_periphe
 }
 
 
-bool cxa_siLabsBgApi_btle_peripheral_handleBgEvent(cxa_siLabsBgApi_btle_peripheral_t *const btlepIn, struct gecko_cmd_packet *evt)
-{
-	cxa_assert(btlepIn);
-
-	if( NULL == evt ) return false;
-
-	// Handle events
-	bool retVal = false;
-	switch( BGLIB_MSG_ID(evt->header) )
-	{
-		case gecko_evt_le_connection_opened_id:
-		{
-			// we'll handle all of these events (assuming we're second in line to the central)
-			cxa_siLabsBgApi_btle_handleMacMapEntry_t* newEntry = cxa_array_append_empty(&btlepIn->handleMacMap);
-			if( newEntry == NULL )
-			{
-				cxa_logger_warn(&btlepIn->super.logger, "too many connections");
-				return false;
-			}
-			cxa_eui48_init(&newEntry->macAddress, evt->data.evt_le_connection_opened.address.addr);
-			newEntry->handle = evt->data.evt_le_connection_opened.connection;
-
-			cxa_eui48_string_t connectedAddr_str;
-			cxa_eui48_toString(&newEntry->macAddress, &connectedAddr_str);
-
-			cxa_logger_info(&btlepIn->super.logger, "connection from '%s' handle %d", connectedAddr_str.str,
-							evt->data.evt_le_connection_opened.connection);
-
-			cxa_btle_peripheral_notify_connectionOpened(&btlepIn->super, &newEntry->macAddress);
-			retVal = true;
-			break;
-		}
-
-		case gecko_evt_le_connection_closed_id:
-		{
-			// we'll handle all of these events (assuming we're second in line to the central)
-			cxa_siLabsBgApi_btle_handleMacMapEntry_t* macMapEntry = getHandleMacEntry_byHandle(btlepIn, evt->data.evt_le_connection_closed.connection);
-			if( macMapEntry != NULL )
-			{
-				cxa_array_remove(&btlepIn->handleMacMap, macMapEntry);
-				cxa_logger_info(&btlepIn->super.logger, "connection closed handle %d",
-								evt->data.evt_le_connection_closed.connection);
-
-				cxa_btle_peripheral_notify_connectionClosed(&btlepIn->super, &macMapEntry->macAddress);
-			}
-
-			retVal = true;
-			break;
-		}
-
-		case gecko_evt_gatt_server_user_read_request_id:
-		{
-			cxa_siLabsBgApi_btle_handleCharMapEntry_t* charMapEntry = getMappingEntry_byHandle(btlepIn, evt->data.evt_gatt_server_user_read_request.characteristic);
-			cxa_siLabsBgApi_btle_handleMacMapEntry_t* macMapEntry = getHandleMacEntry_byHandle(btlepIn, evt->data.evt_gatt_server_user_read_request.connection);
-			if( (charMapEntry != NULL) && (macMapEntry != NULL) )
-			{
-				cxa_fixedByteBuffer_t tmpFbb;
-				uint8_t tmpFbb_raw[USER_READ_BUFFER_MAX_BYTES];
-				cxa_fixedByteBuffer_initStd(&tmpFbb, tmpFbb_raw);
-
-				cxa_btle_peripheral_readRetVal_t retVal;
-				if( cxa_btle_peripheral_notify_readRequest(&btlepIn->super, &macMapEntry->macAddress, charMapEntry->charEntry->serviceUuid_str, charMapEntry->charEntry->charUuid_str, &tmpFbb, &retVal) )
-				{
-					// I know the last parameter is a weird cast and loses precision...it's just how the BGAPI is written
-					gecko_cmd_gatt_server_send_user_read_response(evt->data.evt_gatt_server_user_read_request.connection, charMapEntry->handle, (uint8_t)retVal, cxa_fixedByteBuffer_getSize_bytes(&tmpFbb), cxa_fixedByteBuffer_get_pointerToStartOfData(&tmpFbb));
-				}
-			}
-			break;
-		}
-
-		case gecko_evt_gatt_server_user_write_request_id:
-		{
-			cxa_siLabsBgApi_btle_handleCharMapEntry_t* charMapEntry = getMappingEntry_byHandle(btlepIn, evt->data.evt_gatt_server_user_write_request.characteristic);
-			cxa_siLabsBgApi_btle_handleMacMapEntry_t* macMapEntry = getHandleMacEntry_byHandle(btlepIn, evt->data.evt_gatt_server_user_read_request.connection);
-			if( (charMapEntry != NULL) && (macMapEntry != NULL) )
-			{
-				cxa_fixedByteBuffer_t tmpFbb;
-				cxa_fixedByteBuffer_init_inPlace(&tmpFbb, evt->data.evt_gatt_server_user_write_request.value.len,
-														  evt->data.evt_gatt_server_user_write_request.value.data,
-														  evt->data.evt_gatt_server_user_write_request.value.len);
-
-				cxa_btle_peripheral_writeRetVal_t retVal;
-				if( cxa_btle_peripheral_notify_writeRequest(&btlepIn->super, &macMapEntry->macAddress, charMapEntry->charEntry->serviceUuid_str, charMapEntry->charEntry->charUuid_str, &tmpFbb, &retVal) )
-				{
-					// I know the last parameter is a weird cast and loses precision...it's just how the BGAPI is written
-					gecko_cmd_gatt_server_send_user_write_response(evt->data.evt_gatt_server_user_write_request.connection, evt->data.evt_gatt_server_user_write_request.characteristic, (uint8_t)retVal);
-				}
-			}
-			break;
-		}
-
-		case gecko_evt_gatt_server_characteristic_status_id:
-		{
-			cxa_siLabsBgApi_btle_handleCharMapEntry_t* charMapEntry = getMappingEntry_byHandle(btlepIn, evt->data.evt_gatt_server_user_write_request.characteristic);
-			if( charMapEntry != NULL )
-			{
-				cxa_btle_peripheral_notify_subscriptionChanged(&btlepIn->super, charMapEntry->charEntry->serviceUuid_str, charMapEntry->charEntry->charUuid_str, (evt->data.evt_gatt_server_characteristic_status.client_config_flags != 0));
-			}
-			break;
-		}
-	}
-
-	return retVal;
-}
-
-
 // ******** local function implementations ********
 static cxa_siLabsBgApi_btle_handleCharMapEntry_t* getMappingEntry_byUuid(cxa_siLabsBgApi_btle_peripheral_t *const btlepIn,
 																		 const char *const serviceUuidStrIn,
@@ -374,3 +282,114 @@ static void scm_startAdvertising(cxa_btle_peripheral_t *const superIn)
 		return;
 	}
 }
+
+
+static bool evtCb_connectionOpened(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_peripheral_t *const btlepIn = (cxa_siLabsBgApi_btle_peripheral_t *const)userVarIn;
+	cxa_assert(btlepIn);
+
+	// we'll handle all of these events (assuming we're second in line to the central)
+	cxa_siLabsBgApi_btle_handleMacMapEntry_t* newEntry = cxa_array_append_empty(&btlepIn->handleMacMap);
+	if( newEntry == NULL )
+	{
+		cxa_logger_warn(&btlepIn->super.logger, "too many connections");
+		return false;
+	}
+	cxa_eui48_init(&newEntry->macAddress, evtIn->data.evt_le_connection_opened.address.addr);
+	newEntry->handle = evtIn->data.evt_le_connection_opened.connection;
+
+	cxa_eui48_string_t connectedAddr_str;
+	cxa_eui48_toString(&newEntry->macAddress, &connectedAddr_str);
+
+	cxa_logger_info(&btlepIn->super.logger, "connection from '%s' handle %d", connectedAddr_str.str,
+					evtIn->data.evt_le_connection_opened.connection);
+
+	cxa_btle_peripheral_notify_connectionOpened(&btlepIn->super, &newEntry->macAddress);
+	return true;
+}
+
+
+static bool evtCb_connectionClosed(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_peripheral_t *const btlepIn = (cxa_siLabsBgApi_btle_peripheral_t *const)userVarIn;
+	cxa_assert(btlepIn);
+
+	// we'll handle all of these events (assuming we're second in line to the central)
+	cxa_siLabsBgApi_btle_handleMacMapEntry_t* macMapEntry = getHandleMacEntry_byHandle(btlepIn, evtIn->data.evt_le_connection_closed.connection);
+	if( macMapEntry != NULL )
+	{
+		// copy the address out before removing the entry
+		cxa_eui48_t closedAddr;
+		cxa_eui48_initFromEui48(&closedAddr, &macMapEntry->macAddress);
+		cxa_array_remove(&btlepIn->handleMacMap, macMapEntry);
+
+		cxa_logger_info(&btlepIn->super.logger, "connection closed handle %d",
+						evtIn->data.evt_le_connection_closed.connection);
+
+		cxa_btle_peripheral_notify_connectionClosed(&btlepIn->super, &closedAddr);
+	}
+
+	return true;
+}
+
+
+static bool evtCb_userReadRequest(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_peripheral_t *const btlepIn = (cxa_siLabsBgApi_btle_peripheral_t *const)userVarIn;
+	cxa_assert(btlepIn);
+
+	cxa_siLabsBgApi_btle_handleCharMapEntry_t* charMapEntry = getMappingEntry_byHandle(btlepIn, evtIn->data.evt_gatt_server_user_read_request.characteristic);
+	cxa_siLabsBgApi_btle_handleMacMapEntry_t* macMapEntry = getHandleMacEntry_byHandle(btlepIn, evtIn->data.evt_gatt_server_user_read_request.connection);
+	if( (charMapEntry == NULL) || (macMapEntry == NULL) ) return false;
+
+	cxa_fixedByteBuffer_t tmpFbb;
+	uint8_t tmpFbb_raw[USER_READ_BUFFER_MAX_BYTES];
+	cxa_fixedByteBuffer_initStd(&tmpFbb, tmpFbb_raw);
+
+	cxa_btle_peripheral_readRetVal_t retVal;
+	if( cxa_btle_peripheral_notify_readRequest(&btlepIn->super, &macMapEntry->macAddress, charMapEntry->charEntry->serviceUuid_str, charMapEntry->charEntry->charUuid_str, &tmpFbb, &retVal) )
+	{
+		// I know the last parameter is a weird cast and loses precision...it's just how the BGAPI is written
+		gecko_cmd_gatt_server_send_user_read_response(evtIn->data.evt_gatt_server_user_read_request.connection, charMapEntry->handle, (uint8_t)retVal, cxa_fixedByteBuffer_getSize_bytes(&tmpFbb), cxa_fixedByteBuffer_get_pointerToStartOfData(&tmpFbb));
+	}
+	return true;
+}
+
+
+static bool evtCb_userWriteRequest(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_peripheral_t *const btlepIn = (cxa_siLabsBgApi_btle_peripheral_t *const)userVarIn;
+	cxa_assert(btlepIn);
+
+	cxa_siLabsBgApi_btle_handleCharMapEntry_t* charMapEntry = getMappingEntry_byHandle(btlepIn, evtIn->data.evt_gatt_server_user_write_request.characteristic);
+	cxa_siLabsBgApi_btle_handleMacMapEntry_t* macMapEntry = getHandleMacEntry_byHandle(btlepIn, evtIn->data.evt_gatt_server_user_write_request.connection);
+	if( (charMapEntry == NULL) || (macMapEntry == NULL) ) return false;
+
+	// written value is passed by reference directly out of the BGLib buffer
+	cxa_fixedByteBuffer_t tmpFbb;
+	cxa_fixedByteBuffer_init_inPlace(&tmpFbb, evtIn->data.evt_gatt_server_user_write_request.value.len,
+											  evtIn->data.evt_gatt_server_user_write_request.value.data,
+											  evtIn->data.evt_gatt_server_user_write_request.value.len);
+
+	cxa_btle_peripheral_writeRetVal_t retVal;
+	if( cxa_btle_peripheral_notify_writeRequest(&btlepIn->super, &macMapEntry->macAddress, charMapEntry->charEntry->serviceUuid_str, charMapEntry->charEntry->charUuid_str, &tmpFbb, &retVal) )
+	{
+		// I know the last parameter is a weird cast and loses precision...it's just how the BGAPI is written
+		gecko_cmd_gatt_server_send_user_write_response(evtIn->data.evt_gatt_server_user_write_request.connection, evtIn->data.evt_gatt_server_user_write_request.characteristic, (uint8_t)retVal);
+	}
+	return true;
+}
+
+
+static bool evtCb_characteristicStatus(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	cxa_siLabsBgApi_btle_peripheral_t *const btlepIn = (cxa_siLabsBgApi_btle_peripheral_t *const)userVarIn;
+	cxa_assert(btlepIn);
+
+	cxa_siLabsBgApi_btle_handleCharMapEntry_t* charMapEntry = getMappingEntry_byHandle(btlepIn, evtIn->data.evt_gatt_server_characteristic_status.characteristic);
+	if( charMapEntry == NULL ) return false;
+
+	cxa_btle_peripheral_notify_subscriptionChanged(&btlepIn->super, charMapEntry->charEntry->serviceUuid_str, charMapEntry->charEntry->charUuid_str, (evtIn->data.evt_gatt_server_characteristic_status.client_config_flags != 0));
+	return true;
+}
@@ -0,0 +1,107 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_siLabsBgApi_eventDispatcher.h"
+
+
+// ******** includes ********
+#include <string.h>
+
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+#define NO_ENTRY						0xFF
+
+#define EVTID_GET_CLASS(id)				(((id) >> 16) & 0xFF)
+#define EVTID_GET_METHOD(id)			(((id) >> 24) & 0xFF)
+
+
+// ******** local type definitions ********
+typedef struct
+{
+	cxa_siLabsBgApi_eventDispatcher_cb_onEvent_t cb;
+	void* userVar;
+
+	uint8_t nextIndex;
+}handlerEntry_t;
+
+
+// ******** local function prototypes ********
+
+
+// ********  local variable declarations *********
+static uint8_t classRows[CXA_SILABSBGAPI_EVENTDISPATCHER_MAX_CLASS_ID + 1];
+static uint8_t numClassRows;
+
+static uint8_t dispatchTable[CXA_SILABSBGAPI_EVENTDISPATCHER_MAXNUM_CLASSES][CXA_SILABSBGAPI_EVENTDISPATCHER_MAX_METHOD_ID + 1];
+
+static handlerEntry_t handlers[CXA_SILABSBGAPI_EVENTDISPATCHER_MAXNUM_HANDLERS];
+static uint8_t numHandlers;
+
+
+// ******** global function implementations ********
+void cxa_siLabsBgApi_eventDispatcher_init(void)
+{
+	memset(classRows, NO_ENTRY, sizeof(classRows));
+	numClassRows = 0;
+
+	memset(dispatchTable, NO_ENTRY, sizeof(dispatchTable));
+	numHandlers = 0;
+}
+
+
+void cxa_siLabsBgApi_eventDispatcher_addHandler(uint32_t evtIdIn, cxa_siLabsBgApi_eventDispatcher_cb_onEvent_t cbIn, void* userVarIn)
+{
+	cxa_assert(cbIn);
+
+	uint8_t classId = EVTID_GET_CLASS(evtIdIn);
+	uint8_t methodId = EVTID_GET_METHOD(evtIdIn);
+	cxa_assert_msg((classId <= CXA_SILABSBGAPI_EVENTDISPATCHER_MAX_CLASS_ID) && (methodId <= CXA_SILABSBGAPI_EVENTDISPATCHER_MAX_METHOD_ID), "unsupported event id");
+
+	// get (or allocate) the row for this class
+	if( classRows[classId] == NO_ENTRY )
+	{
+		cxa_assert_msg((numClassRows < CXA_SILABSBGAPI_EVENTDISPATCHER_MAXNUM_CLASSES), "increase CXA_SILABSBGAPI_EVENTDISPATCHER_MAXNUM_CLASSES");
+		classRows[classId] = numClassRows++;
+	}
+	uint8_t* headIndex = &dispatchTable[classRows[classId]][methodId];
+
+	// setup our new handler
+	cxa_assert_msg((numHandlers < CXA_SILABSBGAPI_EVENTDISPATCHER_MAXNUM_HANDLERS), "increase CXA_SILABSBGAPI_EVENTDISPATCHER_MAXNUM_HANDLERS");
+	uint8_t newIndex = numHandlers++;
+	handlers[newIndex].cb = cbIn;
+	handlers[newIndex].userVar = userVarIn;
+	handlers[newIndex].nextIndex = NO_ENTRY;
+
+	// append to the end of the chain (registration order == dispatch order)
+	while( *headIndex != NO_ENTRY ) headIndex = &handlers[*headIndex].nextIndex;
+	*headIndex = newIndex;
+}
+
+
+bool cxa_siLabsBgApi_eventDispatcher_dispatch(struct gecko_cmd_packet *const evtIn)
+{
+	if( evtIn == NULL ) return false;
+
+	uint32_t evtId = BGLIB_MSG_ID(evtIn->header);
+	uint8_t classId = EVTID_GET_CLASS(evtId);
+	uint8_t methodId = EVTID_GET_METHOD(evtId);
+	if( (classId > CXA_SILABSBGAPI_EVENTDISPATCHER_MAX_CLASS_ID) || (methodId > CXA_SILABSBGAPI_EVENTDISPATCHER_MAX_METHOD_ID) ) return false;
+
+	uint8_t rowIndex = classRows[classId];
+	if( rowIndex == NO_ENTRY ) return false;
+
+	for( uint8_t currIndex = dispatchTable[rowIndex][methodId]; currIndex != NO_ENTRY; currIndex = handlers[currIndex].nextIndex )
+	{
+		if( handlers[currIndex].cb(evtIn, handlers[currIndex].userVar) ) return true;
+	}
+
+	return false;
+}
+
+
+// ******** local function implementations ********
@@ -18,6 +18,7 @@
 
 #include <cxa_assert.h>
 #include <cxa_ioStream_peekable.h>
+#include <cxa_siLabsBgApi_eventDispatcher.h>
 #include <cxa_siLabsBgApi_btle_central.h>
 #include <cxa_siLabsBgApi_btle_peripheral.h>
 #include <cxa_runLoop.h>
@@ -63,6 +64,11 @@ typedef struct
 
 // ******** local function prototypes ********
 static void appHandleEvents(struct gecko_cmd_packet *evt);
+static void registerEventHandlers(void);
+
+static bool evtCb_systemBoot(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_softTimer(struct gecko_cmd_packet *const evtIn, void* userVarIn);
+static bool evtCb_ignore(struct gecko_cmd_packet *const evtIn, void* userVarIn);
 
 #if !defined(CXA_SILABSBGAPI_MODE_SOC) && !defined(CXA_SILABSBGAPI_MODE_SOC_HIGH_POWER)
 static void stateCb_reset_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
@@ -77,6 +83,8 @@ static void stateCb_xxx_state(cxa_stateMachine_t *const smIn, void *userVarIn);
 static void bglib_cb_output(uint32_t numBytesIn, uint8_t* dataIn);
 static int32_t bglib_cb_input(uint32_t numBytesToReadIn, uint8_t* dataOut);
 static int32_t bglib_cb_peek(void);
+
+static void ioStreamCb_onDataAvailable(cxa_ioStream_t *const ioStreamIn, void *const userVarIn);
 #endif
 
 
@@ -111,9 +119,15 @@ void cxa_siLabsBgApi_module_init(void)
 	cxa_stateMachine_addState(&stateMachine, RADIOSTATE_READY, "ready", stateCb_ready_enter, stateCb_xxx_state, NULL, NULL);
 	cxa_stateMachine_setInitialState(&stateMachine, RADIOSTATE_WAIT_BOOT);
 
+	// setup our event dispatch (central has priority over peripheral for shared events)
+	cxa_siLabsBgApi_eventDispatcher_init();
+
 	// setup our btle client and peripheral
 	cxa_siLabsBgApi_btle_central_init(&btlec, CXA_RUNLOOP_THREADID_DEFAULT);
 	cxa_siLabsBgApi_btle_peripheral_init(&btlep, CXA_RUNLOOP_THREADID_DEFAULT);
+
+	// our handlers go last (so they only see what nobody else wants)
+	registerEventHandlers();
 }
 
 #else
@@ -136,12 +150,24 @@ void cxa_siLabsBgApi_module_init(cxa_ioStream_t *const ioStreamIn, int threadIdI
 	cxa_stateMachine_addState(&stateMachine, RADIOSTATE_READY, "ready", stateCb_ready_enter, stateCb_xxx_state, NULL, NULL);
 	cxa_stateMachine_setInitialState(&stateMachine, RADIOSTATE_RESET);
 
+	// we only need to run when the module sends us something (events, including soft timers)
+	cxa_stateMachine_setStateIsPolled(&stateMachine, RADIOSTATE_WAIT_BOOT, false);
+	cxa_stateMachine_setStateIsPolled(&stateMachine, RADIOSTATE_READY, false);
+	cxa_stateMachine_setSuspendWhenIdle(&stateMachine, true);
+	cxa_ioStream_setDataAvailableListener(ioStreamIn, ioStreamCb_onDataAvailable, NULL);
+
 	// setup our BGLib
 	BGLIB_INITIALIZE_NONBLOCK(bglib_cb_output, bglib_cb_input, bglib_cb_peek);
 
+	// setup our event dispatch (central has priority over peripheral for shared events)
+	cxa_siLabsBgApi_eventDispatcher_init();
+
 	// setup our btle client and peripheral
 	cxa_siLabsBgApi_btle_central_init(&btlec, threadIdIn);
 	cxa_siLabsBgApi_btle_peripheral_init(&btlep, threadIdIn);
+
+	// our handlers go last (so they only see what nobody else wants)
+	registerEventHandlers();
 }
 
 #endif
@@ -219,63 +245,59 @@ static void appHandleEvents(struct gecko_cmd_packet *evt)
 {
 	if( NULL == evt ) return;
 
-	radioState_t currConnState = cxa_stateMachine_getCurrentState(&stateMachine);
-
 	cxa_logger_trace(&logger, "event: 0x%08X", BGLIB_MSG_ID(evt->header));
 
-	// Handle events
-	switch( BGLIB_MSG_ID(evt->header) )
+	if( !cxa_siLabsBgApi_eventDispatcher_dispatch(evt) )
 	{
-		case gecko_evt_system_boot_id:
-		{
-			if( currConnState == RADIOSTATE_WAIT_BOOT )
-			{
-				cxa_logger_debug(&logger, "radio booted");
-			}
-			else
-			{
-				cxa_logger_warn(&logger, "unexpected radio boot");
-			}
-			cxa_stateMachine_transition(&stateMachine, RADIOSTATE_READY);
-			break;
-		}
+		cxa_logger_debug(&logger, "unhandled event: 0x%08X", BGLIB_MSG_ID(evt->header));
+	}
+}
 
-		case gecko_evt_le_connection_opened_id:
-		case gecko_evt_le_connection_closed_id:
-		case gecko_evt_gatt_procedure_completed_id:
-		case gecko_evt_gatt_service_id:
-		case gecko_evt_gatt_characteristic_id:
-		case gecko_evt_gatt_characteristic_value_id:
-		case gecko_evt_le_gap_scan_response_id:
-		case gecko_evt_gatt_server_characteristic_status_id:
-			if( !cxa_siLabsBgApi_btle_central_handleBgEvent(&btlec, evt) ) cxa_siLabsBgApi_btle_peripheral_handleBgEvent(&btlep, evt);
-			break;
 
-		case gecko_evt_gatt_server_user_read_request_id:
-		case gecko_evt_gatt_server_user_write_request_id:
-			cxa_siLabsBgApi_btle_peripheral_handleBgEvent(&btlep, evt);
-			break;
+static void registerEventHandlers(void)
+{
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_system_boot_id, evtCb_systemBoot, NULL);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_hardware_soft_timer_id, evtCb_softTimer, NULL);
 
-		case gecko_evt_le_connection_parameters_id:
-		case gecko_evt_le_connection_phy_status_id:
-		case gecko_evt_gatt_mtu_exchanged_id:
-			break;
+	// peripheral-role connections don't track these
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_le_connection_parameters_id, evtCb_ignore, NULL);
+	cxa_siLabsBgApi_eventDispatcher_addHandler(gecko_evt_le_connection_phy_status_id, evtCb_ignore, NULL);
+}
 
-		case gecko_evt_hardware_soft_timer_id:
-			for( size_t i = 0; i < sizeof(timerCallbackEntries)/sizeof(*timerCallbackEntries); i++ )
-			{
-				if( (i == evt->data.evt_hardware_soft_timer.handle) &&
-					timerCallbackEntries[i].isUsed )
-				{
-					if( timerCallbackEntries[i].cb != NULL ) timerCallbackEntries[i].cb(timerCallbackEntries[i].userVarIn);
-				}
-			}
-			break;
 
-		default:
-			cxa_logger_debug(&logger, "unhandled event: 0x%08X", BGLIB_MSG_ID(evt->header));
-			break;
+static bool evtCb_systemBoot(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	if( cxa_stateMachine_getCurrentState(&stateMachine) == RADIOSTATE_WAIT_BOOT )
+	{
+		cxa_logger_debug(&logger, "radio booted");
 	}
+	else
+	{
+		cxa_logger_warn(&logger, "unexpected radio boot");
+	}
+	cxa_stateMachine_transition(&stateMachine, RADIOSTATE_READY);
+
+	return true;
+}
+
+
+static bool evtCb_softTimer(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	uint8_t handle = evtIn->data.evt_hardware_soft_timer.handle;
+	if( (handle < (sizeof(timerCallbackEntries)/sizeof(*timerCallbackEntries))) &&
+		timerCallbackEntries[handle].isUsed &&
+		(timerCallbackEntries[handle].cb != NULL) )
+	{
+		timerCallbackEntries[handle].cb(timerCallbackEntries[handle].userVarIn);
+	}
+
+	return true;
+}
+
+
+static bool evtCb_ignore(struct gecko_cmd_packet *const evtIn, void* userVarIn)
+{
+	return true;
 }
 
 
@@ -329,8 +351,14 @@ static void stateCb_xxx_state(cxa_stateMachine_t *const smIn, void *userVarIn)
 {
 #if defined(CXA_SILABSBGAPI_MODE_SOC)
 	appHandleEvents(gecko_wait_event());
-#else
+#elif defined(CXA_SILABSBGAPI_MODE_SOC_HIGH_POWER)
 	appHandleEvents(gecko_peek_event());
+#else
+	struct gecko_cmd_packet* evt = gecko_peek_event();
+	appHandleEvents(evt);
+
+	// there may be more events waiting (or we can't be told when there are)
+	if( (evt != NULL) || !cxa_ioStream_notifiesDataAvailable(ios_usart.underlyingStream) ) cxa_stateMachine_kick(&stateMachine);
 #endif
 }
 
@@ -378,4 +406,10 @@ static int32_t bglib_cb_peek(void)
 {
 	return cxa_ioStream_peekable_hasBytesAvailable(&ios_usart);
 }
+
+
+static void ioStreamCb_onDataAvailable(cxa_ioStream_t *const ioStreamIn, void *const userVarIn)
+{
+	cxa_stateMachine_kick(&stateMachine);
+}
 #endif
@@ -21,6 +21,8 @@
 
 
 // ******** local function prototypes ********
+static size_t getBound(cxa_array_t *const arrIn, const void *const keyIn, cxa_array_compareCb_t cb_compareIn, bool isUpperBoundIn);
+static void hashIndex_add(cxa_array_hashIndex_t *const indexIn, size_t elemIndexIn);
 
 
 // ********  local variable declarations *********
@@ -106,7 +108,7 @@ bool cxa_array_remove_atIndex(cxa_array_t *const arrIn, const size_t indexIn)
 
 	// if we made it here, we have some data to move around
 	void *dest = (void*)(((uint8_t*)arrIn->bufferLoc) + (indexIn * arrIn->datatypeSize_bytes));
-	void *src = (void*)(((uint8_t*)arrIn->bufferLoc) + (indexIn+1 * arrIn->datatypeSize_bytes));
+	void *src = (void*)(((uint8_t*)arrIn->bufferLoc) + ((indexIn+1) * arrIn->datatypeSize_bytes));
 
 	memmove(dest, src, ((arrIn->insertIndex-(indexIn+1)) * arrIn->datatypeSize_bytes));
 	arrIn->insertIndex--;
@@ -118,17 +120,14 @@ bool cxa_array_remove_atIndex(cxa_array_t *const arrIn, const size_t indexIn)
 bool cxa_array_remove(cxa_array_t *const arrIn, void *const itemLocIn)
 {
 	cxa_assert(arrIn);
-	if( itemLocIn == NULL ) return false;
+	if( (itemLocIn == NULL) || (arrIn->bufferLoc == NULL) ) return false;
 
-	for( size_t i = 0; i < cxa_array_getSize_elems(arrIn); i++ )
-	{
-		if( cxa_array_get(arrIn, i) == itemLocIn )
-		{
-			return cxa_array_remove_atIndex(arrIn, i);
-		}
-	}
+	// the index comes straight from the address (as long as it's really one of ours)
+	if( (uint8_t*)itemLocIn < (uint8_t*)arrIn->bufferLoc ) return false;
+	size_t offset_bytes = (size_t)((uint8_t*)itemLocIn - (uint8_t*)arrIn->bufferLoc);
+	if( (offset_bytes % arrIn->datatypeSize_bytes) != 0 ) return false;
 
-	return false;
+	return cxa_array_remove_atIndex(arrIn, offset_bytes / arrIn->datatypeSize_bytes);
 }
 
 
@@ -245,4 +244,155 @@ void cxa_array_clear(cxa_array_t *const arrIn)
 }
 
 
+bool cxa_array_insert_sorted(cxa_array_t *const arrIn, void *const itemLocIn, cxa_array_compareCb_t cb_compareIn)
+{
+	cxa_assert(arrIn);
+	cxa_assert(itemLocIn);
+	cxa_assert(cb_compareIn);
+
+	return cxa_array_insert(arrIn, getBound(arrIn, itemLocIn, cb_compareIn, true), itemLocIn);
+}
+
+
+size_t cxa_array_getLowerBound_sorted(cxa_array_t *const arrIn, const void *const keyIn, cxa_array_compareCb_t cb_compareIn)
+{
+	cxa_assert(arrIn);
+	cxa_assert(cb_compareIn);
+
+	return getBound(arrIn, keyIn, cb_compareIn, false);
+}
+
+
+void* cxa_array_find_sorted(cxa_array_t *const arrIn, const void *const keyIn, cxa_array_compareCb_t cb_compareIn)
+{
+	cxa_assert(arrIn);
+	cxa_assert(cb_compareIn);
+
+	size_t index = getBound(arrIn, keyIn, cb_compareIn, false);
+	if( index >= arrIn->insertIndex ) return NULL;
+
+	void* retVal = cxa_array_get_unchecked(arrIn, index * arrIn->datatypeSize_bytes, uint8_t);
+	return (cb_compareIn(keyIn, retVal) == 0) ? retVal : NULL;
+}
+
+
+void cxa_array_hashIndex_init(cxa_array_hashIndex_t *const indexIn, cxa_array_t *const arrIn, uint16_t *const slotsIn, size_t numSlotsIn,
+							  cxa_array_getKeyCb_t cb_getKeyIn, cxa_array_hashCb_t cb_hashIn, cxa_array_compareCb_t cb_compareIn)
+{
+	cxa_assert(indexIn);
+	cxa_assert(arrIn);
+	cxa_assert(slotsIn);
+	cxa_assert(cb_getKeyIn);
+	cxa_assert(cb_hashIn);
+	cxa_assert(cb_compareIn);
+
+	// power of 2 (so we can mask) with at least one empty slot (so probes terminate)
+	cxa_assert((numSlotsIn & (numSlotsIn - 1)) == 0);
+	cxa_assert(numSlotsIn > arrIn->maxNumElements);
+	cxa_assert(arrIn->maxNumElements < CXA_ARRAY_HASHINDEX_EMPTY);
+
+	// save our references
+	indexIn->arr = arrIn;
+	indexIn->slots = slotsIn;
+	indexIn->numSlots = numSlotsIn;
+	indexIn->cb_getKey = cb_getKeyIn;
+	indexIn->cb_hash = cb_hashIn;
+	indexIn->cb_compare = cb_compareIn;
+
+	cxa_array_hashIndex_rebuild(indexIn);
+}
+
+
+void cxa_array_hashIndex_rebuild(cxa_array_hashIndex_t *const indexIn)
+{
+	cxa_assert(indexIn);
+
+	for( size_t i = 0; i < indexIn->numSlots; i++ ) indexIn->slots[i] = CXA_ARRAY_HASHINDEX_EMPTY;
+	for( size_t i = 0; i < indexIn->arr->insertIndex; i++ ) hashIndex_add(indexIn, i);
+}
+
+
+bool cxa_array_hashIndex_append(cxa_array_hashIndex_t *const indexIn, void *const itemLocIn)
+{
+	cxa_assert(indexIn);
+
+	if( !cxa_array_append(indexIn->arr, itemLocIn) ) return false;
+
+	hashIndex_add(indexIn, indexIn->arr->insertIndex - 1);
+	return true;
+}
+
+
+bool cxa_array_hashIndex_remove(cxa_array_hashIndex_t *const indexIn, void *const itemLocIn)
+{
+	cxa_assert(indexIn);
+
+	// following elements move down, so every index after this one changes
+	if( !cxa_array_remove(indexIn->arr, itemLocIn) ) return false;
+
+	cxa_array_hashIndex_rebuild(indexIn);
+	return true;
+}
+
+
+void* cxa_array_hashIndex_find(cxa_array_hashIndex_t *const indexIn, const void *const keyIn)
+{
+	cxa_assert(indexIn);
+
+	cxa_array_t *const arr = indexIn->arr;
+	size_t mask = indexIn->numSlots - 1;
+	for( size_t currSlot = indexIn->cb_hash(keyIn) & mask; indexIn->slots[currSlot] != CXA_ARRAY_HASHINDEX_EMPTY; currSlot = (currSlot + 1) & mask )
+	{
+		void* currElem = cxa_array_get_unchecked(arr, indexIn->slots[currSlot] * arr->datatypeSize_bytes, uint8_t);
+		if( indexIn->cb_compare(keyIn, currElem) == 0 ) return currElem;
+	}
+
+	return NULL;
+}
+
+
+uint32_t cxa_array_hashIndex_hashBytes(const void *const bytesIn, size_t numBytesIn)
+{
+	cxa_assert(bytesIn || (numBytesIn == 0));
+
+	uint32_t retVal = 2166136261u;
+	for( size_t i = 0; i < numBytesIn; i++ )
+	{
+		retVal ^= ((const uint8_t*)bytesIn)[i];
+		retVal *= 16777619u;
+	}
+
+	return retVal;
+}
+
+
 // ******** local function implementations ********
+static size_t getBound(cxa_array_t *const arrIn, const void *const keyIn, cxa_array_compareCb_t cb_compareIn, bool isUpperBoundIn)
+{
+	// lower bound: first element >= key, upper bound: first element > key
+	size_t low = 0;
+	size_t high = arrIn->insertIndex;
+	while( low < high )
+	{
+		size_t mid = low + ((high - low) / 2);
+		int cmp = cb_compareIn(keyIn, cxa_array_get_unchecked(arrIn, mid * arrIn->datatypeSize_bytes, uint8_t));
+		if( (cmp > 0) || (isUpperBoundIn && (cmp == 0)) ) low = mid + 1;
+		else high = mid;
+	}
+
+	return low;
+}
+
+
+static void hashIndex_add(cxa_array_hashIndex_t *const indexIn, size_t elemIndexIn)
+{
+	cxa_array_t *const arr = indexIn->arr;
+	const void* key = indexIn->cb_getKey(cxa_array_get_unchecked(arr, elemIndexIn * arr->datatypeSize_bytes, uint8_t));
+
+	// linear probing (numSlots > maxNumElements, so there's always an empty slot)
+	size_t mask = indexIn->numSlots - 1;
+	size_t currSlot = indexIn->cb_hash(key) & mask;
+	while( indexIn->slots[currSlot] != CXA_ARRAY_HASHINDEX_EMPTY ) currSlot = (currSlot + 1) & mask;
+
+	indexIn->slots[currSlot] = (uint16_t)elemIndexIn;
+}
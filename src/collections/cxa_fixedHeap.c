@@ -0,0 +1,269 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_fixedHeap.h"
+
+
+// ******** includes ********
+#include <string.h>
+
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+#if (CXA_FIXEDHEAP_ARITY != 2) && (CXA_FIXEDHEAP_ARITY != 4)
+	#error "CXA_FIXEDHEAP_ARITY must be 2 or 4"
+#endif
+
+#define GET_SLOT_ELEM(heapIn, slotIn)			((void*)(((uint8_t*)(heapIn)->bufferLoc) + ((slotIn) * (heapIn)->datatypeSize_bytes)))
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static bool getSlotForHandle(cxa_fixedHeap_t *const heapIn, void *const handleIn, size_t *const slotOut);
+static void removeAtPosition(cxa_fixedHeap_t *const heapIn, size_t posIn);
+static bool siftUp(cxa_fixedHeap_t *const heapIn, size_t posIn);
+static void siftDown(cxa_fixedHeap_t *const heapIn, size_t posIn);
+static inline void placeSlot(cxa_fixedHeap_t *const heapIn, uint16_t slotIn, size_t posIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_fixedHeap_init(cxa_fixedHeap_t *const heapIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+						uint16_t *const indexBufferIn, const size_t indexBufferSize_bytesIn, cxa_fixedHeap_compareCb_t cb_compareIn)
+{
+	cxa_assert(heapIn);
+	cxa_assert(datatypeSize_bytesIn > 0);
+	cxa_assert(bufferLocIn);
+	cxa_assert(indexBufferIn);
+	cxa_assert(cb_compareIn);
+
+	size_t maxNumElements = bufferMaxSize_bytesIn / datatypeSize_bytesIn;
+	cxa_assert(maxNumElements <= UINT16_MAX);
+	cxa_assert((indexBufferSize_bytesIn / sizeof(*indexBufferIn)) >= CXA_FIXEDHEAP_INDEXBUFFER_NUMELEMS(maxNumElements));
+
+	// save our references
+	heapIn->bufferLoc = bufferLocIn;
+	heapIn->datatypeSize_bytes = datatypeSize_bytesIn;
+	heapIn->maxNumElements = maxNumElements;
+	heapIn->heapOrder = indexBufferIn;
+	heapIn->heapPositions = &indexBufferIn[maxNumElements];
+	heapIn->cb_compare = cb_compareIn;
+
+	cxa_fixedHeap_clear(heapIn);
+}
+
+
+void* cxa_fixedHeap_insert(cxa_fixedHeap_t *const heapIn, void *const itemLocIn)
+{
+	cxa_assert(heapIn);
+	cxa_assert(itemLocIn);
+
+	if( heapIn->numElements >= heapIn->maxNumElements ) return NULL;
+
+	// the first free slot is just past the end of the heap
+	size_t pos = heapIn->numElements++;
+	void* retVal = GET_SLOT_ELEM(heapIn, heapIn->heapOrder[pos]);
+	memcpy(retVal, itemLocIn, heapIn->datatypeSize_bytes);
+
+	siftUp(heapIn, pos);
+
+	return retVal;
+}
+
+
+void* cxa_fixedHeap_peek(cxa_fixedHeap_t *const heapIn)
+{
+	cxa_assert(heapIn);
+
+	return (heapIn->numElements > 0) ? GET_SLOT_ELEM(heapIn, heapIn->heapOrder[0]) : NULL;
+}
+
+
+bool cxa_fixedHeap_pop(cxa_fixedHeap_t *const heapIn, void *const itemOut)
+{
+	cxa_assert(heapIn);
+
+	if( heapIn->numElements == 0 ) return false;
+
+	if( itemOut != NULL ) memcpy(itemOut, GET_SLOT_ELEM(heapIn, heapIn->heapOrder[0]), heapIn->datatypeSize_bytes);
+	removeAtPosition(heapIn, 0);
+
+	return true;
+}
+
+
+bool cxa_fixedHeap_remove(cxa_fixedHeap_t *const heapIn, void *const handleIn)
+{
+	cxa_assert(heapIn);
+
+	size_t slot;
+	if( !getSlotForHandle(heapIn, handleIn, &slot) ) return false;
+
+	removeAtPosition(heapIn, heapIn->heapPositions[slot]);
+	return true;
+}
+
+
+bool cxa_fixedHeap_update(cxa_fixedHeap_t *const heapIn, void *const handleIn)
+{
+	cxa_assert(heapIn);
+
+	size_t slot;
+	if( !getSlotForHandle(heapIn, handleIn, &slot) ) return false;
+
+	// the key may have moved either way
+	size_t pos = heapIn->heapPositions[slot];
+	if( !siftUp(heapIn, pos) ) siftDown(heapIn, pos);
+
+	return true;
+}
+
+
+size_t cxa_fixedHeap_getSize_elems(cxa_fixedHeap_t *const heapIn)
+{
+	cxa_assert(heapIn);
+
+	return heapIn->numElements;
+}
+
+
+size_t cxa_fixedHeap_getMaxSize_elems(cxa_fixedHeap_t *const heapIn)
+{
+	cxa_assert(heapIn);
+
+	return heapIn->maxNumElements;
+}
+
+
+bool cxa_fixedHeap_isEmpty(cxa_fixedHeap_t *const heapIn)
+{
+	cxa_assert(heapIn);
+
+	return (heapIn->numElements == 0);
+}
+
+
+bool cxa_fixedHeap_isFull(cxa_fixedHeap_t *const heapIn)
+{
+	cxa_assert(heapIn);
+
+	return (heapIn->numElements >= heapIn->maxNumElements);
+}
+
+
+void cxa_fixedHeap_clear(cxa_fixedHeap_t *const heapIn)
+{
+	cxa_assert(heapIn);
+
+	// every slot is free
+	for( size_t i = 0; i < heapIn->maxNumElements; i++ )
+	{
+		heapIn->heapOrder[i] = (uint16_t)i;
+		heapIn->heapPositions[i] = (uint16_t)i;
+	}
+	heapIn->numElements = 0;
+}
+
+
+// ******** local function implementations ********
+static bool getSlotForHandle(cxa_fixedHeap_t *const heapIn, void *const handleIn, size_t *const slotOut)
+{
+	if( ((uint8_t*)handleIn < (uint8_t*)heapIn->bufferLoc) ) return false;
+
+	size_t offset_bytes = (size_t)((uint8_t*)handleIn - (uint8_t*)heapIn->bufferLoc);
+	if( (offset_bytes % heapIn->datatypeSize_bytes) != 0 ) return false;
+
+	size_t slot = offset_bytes / heapIn->datatypeSize_bytes;
+	if( (slot >= heapIn->maxNumElements) || (heapIn->heapPositions[slot] >= heapIn->numElements) ) return false;
+
+	*slotOut = slot;
+	return true;
+}
+
+
+static void removeAtPosition(cxa_fixedHeap_t *const heapIn, size_t posIn)
+{
+	// swap with the last element of the heap, so the removed slot lands
+	// in the free region
+	size_t lastPos = --heapIn->numElements;
+	uint16_t removedSlot = heapIn->heapOrder[posIn];
+	uint16_t lastSlot = heapIn->heapOrder[lastPos];
+	placeSlot(heapIn, removedSlot, lastPos);
+	if( posIn == lastPos ) return;
+
+	placeSlot(heapIn, lastSlot, posIn);
+	if( !siftUp(heapIn, posIn) ) siftDown(heapIn, posIn);
+}
+
+
+static bool siftUp(cxa_fixedHeap_t *const heapIn, size_t posIn)
+{
+	// move parents down into the hole until we find our spot
+	uint16_t slot = heapIn->heapOrder[posIn];
+	void* elem = GET_SLOT_ELEM(heapIn, slot);
+
+	size_t pos = posIn;
+	while( pos > 0 )
+	{
+		size_t parentPos = (pos - 1) / CXA_FIXEDHEAP_ARITY;
+		uint16_t parentSlot = heapIn->heapOrder[parentPos];
+		if( heapIn->cb_compare(elem, GET_SLOT_ELEM(heapIn, parentSlot)) >= 0 ) break;
+
+		placeSlot(heapIn, parentSlot, pos);
+		pos = parentPos;
+	}
+	placeSlot(heapIn, slot, pos);
+
+	return (pos != posIn);
+}
+
+
+static void siftDown(cxa_fixedHeap_t *const heapIn, size_t posIn)
+{
+	// move the best child up into the hole until we find our spot
+	uint16_t slot = heapIn->heapOrder[posIn];
+	void* elem = GET_SLOT_ELEM(heapIn, slot);
+
+	size_t pos = posIn;
+	while( 1 )
+	{
+		size_t firstChildPos = (pos * CXA_FIXEDHEAP_ARITY) + 1;
+		if( firstChildPos >= heapIn->numElements ) break;
+
+		size_t lastChildPos = firstChildPos + CXA_FIXEDHEAP_ARITY;
+		if( lastChildPos > heapIn->numElements ) lastChildPos = heapIn->numElements;
+
+		size_t bestChildPos = firstChildPos;
+		void* bestChild = GET_SLOT_ELEM(heapIn, heapIn->heapOrder[firstChildPos]);
+		for( size_t i = firstChildPos + 1; i < lastChildPos; i++ )
+		{
+			void* currChild = GET_SLOT_ELEM(heapIn, heapIn->heapOrder[i]);
+			if( heapIn->cb_compare(currChild, bestChild) < 0 )
+			{
+				bestChildPos = i;
+				bestChild = currChild;
+			}
+		}
+
+		if( heapIn->cb_compare(bestChild, elem) >= 0 ) break;
+
+		placeSlot(heapIn, heapIn->heapOrder[bestChildPos], pos);
+		pos = bestChildPos;
+	}
+	placeSlot(heapIn, slot, pos);
+}
+
+
+static inline void placeSlot(cxa_fixedHeap_t *const heapIn, uint16_t slotIn, size_t posIn)
+{
+	heapIn->heapOrder[posIn] = slotIn;
+	heapIn->heapPositions[slotIn] = (uint16_t)posIn;
+}
@@ -15,19 +15,23 @@
 
 
 // ******** local macro definitions ********
+#define ORDINAL_NONE						SIZE_MAX
 
 
 // ******** local type definitions ********
 
 
 // ******** local function prototypes ********
-static cxa_fixedByteBuffer_t* getParentBufferFromChild(cxa_linkedField_t *const fbbLfIn);
-static size_t getLengthOfAllFixedFields_bytes(cxa_linkedField_t *const fbbLfIn, bool isFirstCallIn);
-static size_t getStartIndexInParent(cxa_linkedField_t *const fbbLfIn, bool isFirstCallIn);
-static cxa_linkedField_t* getEndOfChain(cxa_linkedField_t *const fbbLfIn);
-static bool validateChain(cxa_linkedField_t *const fbbLfIn, bool isFirstCallIn);
-static bool isUnfilledFixedLengthFieldUpChain(cxa_linkedField_t *const fbbLfIn, bool isFirstCallIn);
-static bool isNonEmptyFieldDownChain(cxa_linkedField_t *const fbbLfIn, bool isFirstCallIn);
+static void linkChild(cxa_linkedField_t *const fbbLfIn, cxa_linkedField_t *const prevFbbLfIn);
+static void unlinkChild(cxa_linkedField_t *const fbbLfIn);
+static void growField(cxa_linkedField_t *const fbbLfIn, const size_t numBytesIn);
+static void shrinkField(cxa_linkedField_t *const fbbLfIn, const size_t numBytesIn);
+static bool isUnfilledFixedLengthField(cxa_linkedField_t *const fbbLfIn);
+static void updateUnfilledFixedLengthTracking(cxa_linkedField_t *const fbbLfIn);
+static size_t getLengthOfAllFixedFields_bytes(cxa_linkedField_t *const fbbLfIn);
+static bool validateChain(cxa_linkedField_t *const fbbLfIn);
+static bool isUnfilledFixedLengthFieldUpChain(cxa_linkedField_t *const fbbLfIn);
+static bool isNonEmptyFieldDownChain(cxa_linkedField_t *const fbbLfIn);
 
 
 // ********  local variable declarations *********
@@ -41,12 +45,17 @@ bool cxa_linkedField_initRoot(cxa_linkedField_t *const fbbLfIn, cxa_fixedByteBuf
 
 	// save our internal state
 	fbbLfIn->parent = parentFbbIn;
+	fbbLfIn->root = fbbLfIn;
 	fbbLfIn->prev = NULL;
 	fbbLfIn->next = NULL;
 	fbbLfIn->startIndex = startIndexInParentIn;
+	fbbLfIn->ordinal = 0;
+	fbbLfIn->fixedFieldsLen_bytes = 0;
 	fbbLfIn->isFixedLength = false;
 	fbbLfIn->maxFixedLength_bytes = 0;
 	fbbLfIn->currSize_bytes = initialSize_bytesIn;
+	fbbLfIn->tail = fbbLfIn;
+	fbbLfIn->firstUnfilledFixedOrdinal = ORDINAL_NONE;
 
 	// make sure the start index isn't outside the max bounds for the parent
 	if( startIndexInParentIn+initialSize_bytesIn > cxa_fixedByteBuffer_getMaxSize_bytes(parentFbbIn) ) return false;
@@ -62,12 +71,17 @@ bool cxa_linkedField_initRoot_fixedLen(cxa_linkedField_t *const fbbLfIn, cxa_fix
 
 	// save our internal state
 	fbbLfIn->parent = parentFbbIn;
+	fbbLfIn->root = fbbLfIn;
 	fbbLfIn->prev = NULL;
 	fbbLfIn->next = NULL;
 	fbbLfIn->startIndex = startIndexInParentIn;
+	fbbLfIn->ordinal = 0;
+	fbbLfIn->fixedFieldsLen_bytes = maxLen_bytesIn;
 	fbbLfIn->isFixedLength = true;
 	fbbLfIn->maxFixedLength_bytes = maxLen_bytesIn;
 	fbbLfIn->currSize_bytes = CXA_MIN(maxLen_bytesIn, cxa_fixedByteBuffer_getSize_bytes(parentFbbIn));
+	fbbLfIn->tail = fbbLfIn;
+	fbbLfIn->firstUnfilledFixedOrdinal = isUnfilledFixedLengthField(fbbLfIn) ? 0 : ORDINAL_NONE;
 
 	// make sure that our fixed size (with index) isn't bigger than the parent's capacity
 	if( (startIndexInParentIn + maxLen_bytesIn) > cxa_fixedByteBuffer_getMaxSize_bytes(parentFbbIn) ) return false;
@@ -78,28 +92,21 @@ bool cxa_linkedField_initRoot_fixedLen(cxa_linkedField_t *const fbbLfIn, cxa_fix
 bool cxa_linkedField_initChild(cxa_linkedField_t *const fbbLfIn, cxa_linkedField_t *const prevFbbLfIn, const size_t initialSize_bytesIn)
 {
 	cxa_assert(fbbLfIn);
+	cxa_assert(prevFbbLfIn);
 
-	// save our internal state
-	fbbLfIn->prev = prevFbbLfIn;
-	fbbLfIn->next = NULL;
-	prevFbbLfIn->next = fbbLfIn;
-	fbbLfIn->parent = NULL;
-	fbbLfIn->parent = getParentBufferFromChild(fbbLfIn);
-	if( fbbLfIn->parent == NULL )
-	{
-		// we failed to initialize properly
-		prevFbbLfIn->next = NULL;
-		return false;
-	}
+	// can't attach to an uninitialized field
+	if( (prevFbbLfIn->parent == NULL) || (prevFbbLfIn->root == NULL) ) return false;
 
+	// save our internal state
 	fbbLfIn->isFixedLength = false;
 	fbbLfIn->maxFixedLength_bytes = 0;
 	fbbLfIn->currSize_bytes = initialSize_bytesIn;
+	linkChild(fbbLfIn, prevFbbLfIn);
 
-	if( ((getStartIndexInParent(fbbLfIn, true) + fbbLfIn->currSize_bytes) > cxa_fixedByteBuffer_getSize_bytes(fbbLfIn->parent)) || !validateChain(fbbLfIn, true) )
+	if( ((fbbLfIn->startIndex + fbbLfIn->currSize_bytes) > cxa_fixedByteBuffer_getSize_bytes(fbbLfIn->parent)) || !validateChain(fbbLfIn) )
 	{
 		// we failed to initialize properly
-		prevFbbLfIn->next = NULL;
+		unlinkChild(fbbLfIn);
 		return false;
 	}
 
@@ -110,23 +117,23 @@ bool cxa_linkedField_initChild(cxa_linkedField_t *const fbbLfIn, cxa_linkedField
 bool cxa_linkedField_initChild_fixedLen(cxa_linkedField_t *const fbbLfIn, cxa_linkedField_t *const prevFbbLfIn, const size_t maxLen_bytesIn)
 {
 	cxa_assert(fbbLfIn);
+	cxa_assert(prevFbbLfIn);
 
-	// save our internal state
-	fbbLfIn->prev = prevFbbLfIn;
-	fbbLfIn->next = NULL;
-	prevFbbLfIn->next = fbbLfIn;
-	fbbLfIn->parent = NULL;
-	fbbLfIn->parent = getParentBufferFromChild(fbbLfIn);
-	if( fbbLfIn->parent == NULL ) return false;
+	// can't attach to an uninitialized field
+	if( (prevFbbLfIn->parent == NULL) || (prevFbbLfIn->root == NULL) ) return false;
 
+	// save our internal state
 	fbbLfIn->isFixedLength = true;
 	fbbLfIn->maxFixedLength_bytes = maxLen_bytesIn;
-	fbbLfIn->currSize_bytes = CXA_MIN(maxLen_bytesIn, (cxa_fixedByteBuffer_getSize_bytes(fbbLfIn->parent) - getStartIndexInParent(fbbLfIn, true)));
+	size_t startIndex = prevFbbLfIn->startIndex + prevFbbLfIn->currSize_bytes;
+	size_t parentSize_bytes = cxa_fixedByteBuffer_getSize_bytes(prevFbbLfIn->parent);
+	fbbLfIn->currSize_bytes = CXA_MIN(maxLen_bytesIn, (parentSize_bytes - startIndex));
+	linkChild(fbbLfIn, prevFbbLfIn);
 
 	// make sure that that sizes of all fixed-length fields aren't too big...
-	if( getLengthOfAllFixedFields_bytes(fbbLfIn, true) > cxa_fixedByteBuffer_getMaxSize_bytes(fbbLfIn->parent) ) return false;
+	if( getLengthOfAllFixedFields_bytes(fbbLfIn) > cxa_fixedByteBuffer_getMaxSize_bytes(fbbLfIn->parent) ) return false;
 
-	return validateChain(fbbLfIn, true);
+	return validateChain(fbbLfIn);
 }
 
 
@@ -156,18 +163,18 @@ bool cxa_linkedField_remove(cxa_linkedField_t *const fbbLfIn, const size_t index
 	cxa_assert(fbbLfIn);
 
 	// ensure our chain is valid
-	if( !validateChain(fbbLfIn, true) ) return false;
+	if( !validateChain(fbbLfIn) ) return false;
 
 	// we can't be removed if there is stuff after us and we are fixed length...
-	if( fbbLfIn->isFixedLength && isNonEmptyFieldDownChain(fbbLfIn, true) ) return false;
+	if( fbbLfIn->isFixedLength && isNonEmptyFieldDownChain(fbbLfIn) ) return false;
 
 	// make sure the index is in bounds
-	size_t removeIndex = getStartIndexInParent(fbbLfIn, true) + indexIn;
+	size_t removeIndex = fbbLfIn->startIndex + indexIn;
 	if( ((indexIn + numBytesIn) > fbbLfIn->currSize_bytes) || ((removeIndex+ numBytesIn) > cxa_fixedByteBuffer_getSize_bytes(fbbLfIn->parent)) ) return false;
 
 	// if we made it here, we can try the remove
 	if( !cxa_fixedByteBuffer_remove(fbbLfIn->parent, removeIndex , numBytesIn) ) return false;
-	fbbLfIn->currSize_bytes -= numBytesIn;
+	shrinkField(fbbLfIn, numBytesIn);
 
 	return true;
 }
@@ -178,7 +185,7 @@ bool cxa_linkedField_remove_cString(cxa_linkedField_t *const fbbLfIn, const size
 	cxa_assert(fbbLfIn);
 
 	// ensure our chain is valid
-	if( !validateChain(fbbLfIn, true) ) return false;
+	if( !validateChain(fbbLfIn) ) return false;
 
 	// get our target string
 	uint8_t* targetString = cxa_linkedField_get_pointerToIndex(fbbLfIn, indexIn);
@@ -221,10 +228,10 @@ uint8_t* cxa_linkedField_get_pointerToIndex(cxa_linkedField_t *const fbbLfIn, co
 	cxa_assert(fbbLfIn);
 
 	// ensure our chain is valid
-	if( !validateChain(fbbLfIn, true) ) return NULL;
+	if( !validateChain(fbbLfIn) ) return NULL;
 
 	// we need an index
-	size_t parentIndex = getStartIndexInParent(fbbLfIn, true) + indexIn;
+	size_t parentIndex = fbbLfIn->startIndex + indexIn;
 
 	return cxa_fixedByteBuffer_get_pointerToIndex(fbbLfIn->parent, parentIndex);
 }
@@ -235,13 +242,13 @@ bool cxa_linkedField_get(cxa_linkedField_t *const fbbLfIn, const size_t indexIn,
 	cxa_assert(fbbLfIn);
 
 	// ensure our chain is valid
-	if( !validateChain(fbbLfIn, true) ) return false;
+	if( !validateChain(fbbLfIn) ) return false;
 
 	// make sure that we have enough bytes in _our_ buffer
 	if( numBytesIn > fbbLfIn->currSize_bytes ) return false;
 
 	// we need an index
-	size_t parentIndex = getStartIndexInParent(fbbLfIn, true) + indexIn;
+	size_t parentIndex = fbbLfIn->startIndex + indexIn;
 
 	return cxa_fixedByteBuffer_get(fbbLfIn->parent, parentIndex, transposeIn, valOut, numBytesIn);
 }
@@ -252,7 +259,7 @@ bool cxa_linkedField_get_cstring(cxa_linkedField_t *const fbbLfIn, const size_t
 	cxa_assert(fbbLfIn);
 
 	// ensure our chain is valid
-	if( !validateChain(fbbLfIn, true) ) return false;
+	if( !validateChain(fbbLfIn) ) return false;
 
 	// get our target string
 	char* targetString = (char*)cxa_linkedField_get_pointerToIndex(fbbLfIn, indexIn);
@@ -264,7 +271,7 @@ bool cxa_linkedField_get_cstring(cxa_linkedField_t *const fbbLfIn, const size_t
 	// make sure that we have enough bytes in _our_ buffer
 	if( targetStringLen_bytes > fbbLfIn->currSize_bytes ) return false;
 
-	size_t parentIndex = getStartIndexInParent(fbbLfIn, true) + indexIn;
+	size_t parentIndex = fbbLfIn->startIndex + indexIn;
 	return cxa_fixedByteBuffer_get_cString(fbbLfIn->parent, parentIndex, stringOut, maxOutputSize_bytes);
 }
 
@@ -274,13 +281,13 @@ bool cxa_linkedField_get_cstring_inPlace(cxa_linkedField_t *const fbbLfIn, const
 	cxa_assert(fbbLfIn);
 
 	// ensure our chain is valid
-	if( !validateChain(fbbLfIn, true) ) return false;
+	if( !validateChain(fbbLfIn) ) return false;
 
 	// get our target string
 	char* targetString = (char*)cxa_linkedField_get_pointerToIndex(fbbLfIn, indexIn);
 	if( targetString == NULL ) return false;
 
-	size_t parentIndex = getStartIndexInParent(fbbLfIn, true) + indexIn;
+	size_t parentIndex = fbbLfIn->startIndex + indexIn;
 	return cxa_fixedByteBuffer_get_cString_inPlace(fbbLfIn->parent, parentIndex, stringOut, strLen_bytesOut);
 }
 
@@ -310,13 +317,13 @@ bool cxa_linkedField_replace(cxa_linkedField_t *const fbbLfIn, const size_t inde
 	cxa_assert(fbbLfIn);
 
 	// ensure our chain is valid
-	if( !validateChain(fbbLfIn, true) ) return false;
+	if( !validateChain(fbbLfIn) ) return false;
 
 	// make sure that we have enough bytes in _our_ buffer
 	if( numBytesIn > fbbLfIn->currSize_bytes ) return false;
 
 	// we need an index
-	size_t parentIndex = getStartIndexInParent(fbbLfIn, true) + indexIn;
+	size_t parentIndex = fbbLfIn->startIndex + indexIn;
 	return cxa_fixedByteBuffer_replace(fbbLfIn->parent, parentIndex, ptrIn, numBytesIn);
 }
 
@@ -354,16 +361,16 @@ bool cxa_linkedField_insert(cxa_linkedField_t *const fbbLfIn, const size_t index
 	cxa_assert(ptrIn);
 
 	// ensure our chain is valid
-	if( !validateChain(fbbLfIn, true) ) return false;
+	if( !validateChain(fbbLfIn) ) return false;
 
 	// make sure there aren't any unfilled fixed-length fields before us
-	if( isUnfilledFixedLengthFieldUpChain(fbbLfIn, true) ) return false;
+	if( isUnfilledFixedLengthFieldUpChain(fbbLfIn) ) return false;
 
 	// if we made it here, we can at least try to insert the item...
-	size_t parentIndex = getStartIndexInParent(fbbLfIn, true) + indexIn;
+	size_t parentIndex = fbbLfIn->startIndex + indexIn;
 	if( !cxa_fixedByteBuffer_insert(fbbLfIn->parent, parentIndex, ptrIn, numBytesIn) ) return false;
 
-	fbbLfIn->currSize_bytes += numBytesIn;
+	growField(fbbLfIn, numBytesIn);
 
 	return true;
 }
@@ -372,7 +379,7 @@ bool cxa_linkedField_insert(cxa_linkedField_t *const fbbLfIn, const size_t index
 size_t cxa_linkedField_getSize_bytes(cxa_linkedField_t *const fbbLfIn)
 {
 	cxa_assert(fbbLfIn);
-	if( !validateChain(fbbLfIn, true) ) return 0;
+	if( !validateChain(fbbLfIn) ) return 0;
 
 	return fbbLfIn->currSize_bytes;
 }
@@ -400,12 +407,12 @@ bool cxa_linkedField_prependTo_lengthPrefixedField_uint16BE(cxa_linkedField_t *c
 size_t cxa_linkedField_getMaxSize_bytes(cxa_linkedField_t *const fbbLfIn)
 {
 	cxa_assert(fbbLfIn);
-	if( !validateChain(fbbLfIn, true) ) return 0;
+	if( !validateChain(fbbLfIn) ) return 0;
 
 	if( fbbLfIn->isFixedLength ) return fbbLfIn->maxFixedLength_bytes;
 
 	// if we made it here, this is a little more complicated...
-	return cxa_fixedByteBuffer_getMaxSize_bytes(fbbLfIn->parent) - getLengthOfAllFixedFields_bytes(fbbLfIn, true);
+	return cxa_fixedByteBuffer_getMaxSize_bytes(fbbLfIn->parent) - getLengthOfAllFixedFields_bytes(fbbLfIn);
 }
 
 
@@ -421,134 +428,150 @@ size_t cxa_linkedField_getStartIndexInParent(cxa_linkedField_t *const fbbLfIn)
 {
 	cxa_assert(fbbLfIn);
 
-	return getStartIndexInParent(fbbLfIn, true);
+	return fbbLfIn->startIndex;
 }
 
 
 // ******** local function implementations ********
-static cxa_fixedByteBuffer_t* getParentBufferFromChild(cxa_linkedField_t *const fbbLfIn)
+static void linkChild(cxa_linkedField_t *const fbbLfIn, cxa_linkedField_t *const prevFbbLfIn)
 {
 	cxa_assert(fbbLfIn);
+	cxa_assert(prevFbbLfIn);
 
-	if( fbbLfIn->parent != NULL ) return fbbLfIn->parent;
+	cxa_linkedField_t* root = prevFbbLfIn->root;
 
-	// if we made it here, we need to recurse a little bit
-	if( fbbLfIn->prev != NULL ) return getParentBufferFromChild(fbbLfIn->prev);
+	// anything previously linked after prevFbbLfIn is dropped from the chain
+	fbbLfIn->parent = prevFbbLfIn->parent;
+	fbbLfIn->root = root;
+	fbbLfIn->prev = prevFbbLfIn;
+	fbbLfIn->next = NULL;
+	prevFbbLfIn->next = fbbLfIn;
+	root->tail = fbbLfIn;
 
-	// if we made it here, we're out of luck
-	return NULL;
+	// we start immediately after the previous field
+	fbbLfIn->startIndex = prevFbbLfIn->startIndex + prevFbbLfIn->currSize_bytes;
+	fbbLfIn->ordinal = prevFbbLfIn->ordinal + 1;
+	fbbLfIn->fixedFieldsLen_bytes = prevFbbLfIn->fixedFieldsLen_bytes + (fbbLfIn->isFixedLength ? fbbLfIn->maxFixedLength_bytes : 0);
+	fbbLfIn->tail = NULL;
+	fbbLfIn->firstUnfilledFixedOrdinal = ORDINAL_NONE;
+
+	if( root->firstUnfilledFixedOrdinal >= fbbLfIn->ordinal )
+	{
+		root->firstUnfilledFixedOrdinal = isUnfilledFixedLengthField(fbbLfIn) ? fbbLfIn->ordinal : ORDINAL_NONE;
+	}
 }
 
 
-static size_t getLengthOfAllFixedFields_bytes(cxa_linkedField_t *const fbbLfIn, bool isFirstCallIn)
+static void unlinkChild(cxa_linkedField_t *const fbbLfIn)
 {
 	cxa_assert(fbbLfIn);
+	cxa_assert(fbbLfIn->prev);
 
-	if( isFirstCallIn )
-	{
-		cxa_linkedField_t *endOfChain = getEndOfChain(fbbLfIn);
-		if( endOfChain == NULL ) return 0;
-
-		return getLengthOfAllFixedFields_bytes(endOfChain, false);
-	}
-
-	// if we made it here, this isn't our first call...
-	size_t retVal = (fbbLfIn->isFixedLength) ? fbbLfIn->maxFixedLength_bytes : 0;
-	if( fbbLfIn->prev != NULL ) retVal += getLengthOfAllFixedFields_bytes(fbbLfIn->prev, false);
+	cxa_linkedField_t* root = fbbLfIn->root;
 
-	return retVal;
+	fbbLfIn->prev->next = NULL;
+	root->tail = fbbLfIn->prev;
+	if( root->firstUnfilledFixedOrdinal >= fbbLfIn->ordinal ) root->firstUnfilledFixedOrdinal = ORDINAL_NONE;
 }
 
 
-static size_t getStartIndexInParent(cxa_linkedField_t *const fbbLfIn, bool isFirstCallIn)
+static void growField(cxa_linkedField_t *const fbbLfIn, const size_t numBytesIn)
 {
 	cxa_assert(fbbLfIn);
 
-	size_t retVal = 0;
+	fbbLfIn->currSize_bytes += numBytesIn;
+	for( cxa_linkedField_t* currField = fbbLfIn->next; currField != NULL; currField = currField->next )
+	{
+		currField->startIndex += numBytesIn;
+	}
+
+	if( fbbLfIn->isFixedLength ) updateUnfilledFixedLengthTracking(fbbLfIn);
+}
+
 
-	// add from the previous field
-	if( fbbLfIn->prev != NULL ) retVal += getStartIndexInParent(fbbLfIn->prev, false);
+static void shrinkField(cxa_linkedField_t *const fbbLfIn, const size_t numBytesIn)
+{
+	cxa_assert(fbbLfIn);
 
-	// now add ourselves
-	if( fbbLfIn->prev == NULL ) retVal += fbbLfIn->startIndex;
-	if( !isFirstCallIn) retVal += fbbLfIn->currSize_bytes;
+	fbbLfIn->currSize_bytes -= numBytesIn;
+	for( cxa_linkedField_t* currField = fbbLfIn->next; currField != NULL; currField = currField->next )
+	{
+		currField->startIndex -= numBytesIn;
+	}
 
-	return retVal;
+	if( fbbLfIn->isFixedLength ) updateUnfilledFixedLengthTracking(fbbLfIn);
 }
 
 
-static cxa_linkedField_t* getEndOfChain(cxa_linkedField_t *const fbbLfIn)
+static bool isUnfilledFixedLengthField(cxa_linkedField_t *const fbbLfIn)
 {
 	cxa_assert(fbbLfIn);
 
-	return (fbbLfIn->next != NULL) ? getEndOfChain(fbbLfIn->next) : fbbLfIn;
+	return fbbLfIn->isFixedLength && (fbbLfIn->currSize_bytes != fbbLfIn->maxFixedLength_bytes);
 }
 
 
-static bool validateChain(cxa_linkedField_t *const fbbLfIn, bool isFirstCallIn)
+static void updateUnfilledFixedLengthTracking(cxa_linkedField_t *const fbbLfIn)
 {
 	cxa_assert(fbbLfIn);
 
-	// if we were the first...
-	if( isFirstCallIn )
-	{
-		// start the recursion from the end of the chain
-		cxa_linkedField_t* endOfChain = getEndOfChain(fbbLfIn);
-		if( endOfChain == NULL ) return false;
+	cxa_linkedField_t* root = fbbLfIn->root;
 
-		// now that we found the end of the chain, calculate sizes for it
-		size_t calcSize_bytes = getStartIndexInParent(endOfChain, true) + endOfChain->currSize_bytes;
-		size_t actualSize_bytes = cxa_fixedByteBuffer_getSize_bytes(endOfChain->parent);
+	if( isUnfilledFixedLengthField(fbbLfIn) )
+	{
+		if( fbbLfIn->ordinal < root->firstUnfilledFixedOrdinal ) root->firstUnfilledFixedOrdinal = fbbLfIn->ordinal;
+		return;
+	}
 
-		if( calcSize_bytes > actualSize_bytes ) return false;
+	// we were the first unfilled field...find the next one (fields are usually filled in order)
+	if( fbbLfIn->ordinal != root->firstUnfilledFixedOrdinal ) return;
 
-		return validateChain(endOfChain, false);
+	root->firstUnfilledFixedOrdinal = ORDINAL_NONE;
+	for( cxa_linkedField_t* currField = fbbLfIn->next; currField != NULL; currField = currField->next )
+	{
+		if( isUnfilledFixedLengthField(currField) )
+		{
+			root->firstUnfilledFixedOrdinal = currField->ordinal;
+			break;
+		}
 	}
+}
 
-	// if we made it here, we're not the first...do basic checks
-	// make sure we have a parent
-	if( fbbLfIn->parent == NULL ) return false;
 
-	// now validate the previous field (if applicable)
-	return (fbbLfIn->prev != NULL) ? validateChain(fbbLfIn->prev, false) : true;
+static size_t getLengthOfAllFixedFields_bytes(cxa_linkedField_t *const fbbLfIn)
+{
+	cxa_assert(fbbLfIn);
+
+	return fbbLfIn->root->tail->fixedFieldsLen_bytes;
 }
 
 
-static bool isUnfilledFixedLengthFieldUpChain(cxa_linkedField_t *const fbbLfIn, bool isFirstCallIn)
+static bool validateChain(cxa_linkedField_t *const fbbLfIn)
 {
 	cxa_assert(fbbLfIn);
 
-	// check ourselves (if we're not first)
-	if( !isFirstCallIn )
-	{
-		if( fbbLfIn->isFixedLength && (fbbLfIn->currSize_bytes != fbbLfIn->maxFixedLength_bytes) ) return true;
-	}
+	// make sure we have a parent (and have been initialized)
+	if( (fbbLfIn->parent == NULL) || (fbbLfIn->root == NULL) ) return false;
 
-	// check the previous field
-	if( fbbLfIn->prev != NULL)
-	{
-		if( isUnfilledFixedLengthFieldUpChain(fbbLfIn->prev, false) ) return true;
-	}
-
-	return false;
+	// the end of the chain must lie within the parent
+	cxa_linkedField_t* endOfChain = fbbLfIn->root->tail;
+	return ((endOfChain->startIndex + endOfChain->currSize_bytes) <= cxa_fixedByteBuffer_getSize_bytes(endOfChain->parent));
 }
 
 
-static bool isNonEmptyFieldDownChain(cxa_linkedField_t *const fbbLfIn, bool isFirstCallIn)
+static bool isUnfilledFixedLengthFieldUpChain(cxa_linkedField_t *const fbbLfIn)
 {
 	cxa_assert(fbbLfIn);
 
-	// check ourselves (if we're not first)
-	if( !isFirstCallIn )
-	{
-		if( fbbLfIn->currSize_bytes != 0 ) return true;
-	}
+	return (fbbLfIn->root->firstUnfilledFixedOrdinal < fbbLfIn->ordinal);
+}
 
-	// check the next field
-	if( fbbLfIn->next != NULL )
-	{
-		if( isNonEmptyFieldDownChain(fbbLfIn->next, false) ) return true;
-	}
 
-	return false;
+static bool isNonEmptyFieldDownChain(cxa_linkedField_t *const fbbLfIn)
+{
+	cxa_assert(fbbLfIn);
+
+	// downstream fields are contiguous, so they're all empty iff the chain ends where we do
+	cxa_linkedField_t* endOfChain = fbbLfIn->root->tail;
+	return ((endOfChain->startIndex + endOfChain->currSize_bytes) != (fbbLfIn->startIndex + fbbLfIn->currSize_bytes));
 }
@@ -13,6 +13,7 @@
 #include <inttypes.h>
 #include <cxa_assert.h>
 #include <cxa_config.h>
+#include <cxa_encodingUtils.h>
 #include <cxa_mutex.h>
 #include <cxa_numberUtils.h>
 #include <cxa_stringUtils.h>
@@ -190,11 +191,7 @@ void cxa_logger_log_memdump_impl(cxa_logger_t *const loggerIn, const uint8_t lev
 	// write our message
 	if( prefixIn != NULL ) cxa_ioStream_writeString(ioStream, (char *const)prefixIn);
 	cxa_ioStream_writeString(ioStream, "{");
-	for( size_t i = 0; i < ptrLen_bytes; i++ )
-	{
-		cxa_ioStream_writeFormattedString(ioStream, "%02X", ((uint8_t*)ptrIn)[i]);
-		if( i != (ptrLen_bytes-1) ) cxa_ioStream_writeString(ioStream, ", ");
-	}
+	cxa_encodingUtils_hex_writeToIoStream(ioStream, ptrIn, ptrLen_bytes, ", ");
 	cxa_ioStream_writeString(ioStream, "}");
 	if( postFixIn != NULL ) cxa_ioStream_writeString(ioStream, (char *const)postFixIn);
 
@@ -237,7 +234,10 @@ void cxa_logger_stepDebug_formattedString_impl(const char* fileIn, const int lin
 	writeHeader(&sysLog, CXA_LOG_LEVEL_DEBUG);
 
 	// print our location
-	cxa_ioStream_writeFormattedString(ioStream, ((formatIn != NULL) ? "%s::%d - " : "%s::%d"), fileIn, lineNumIn);
+	cxa_ioStream_writeString(ioStream, fileIn);
+	cxa_ioStream_writeString(ioStream, "::");
+	cxa_ioStream_writeInt32(ioStream, lineNumIn);
+	if( formatIn != NULL ) cxa_ioStream_writeString(ioStream, " - ");
 
 	// now do our VARARGS
 	if( formatIn != NULL )
@@ -287,17 +287,16 @@ void cxa_logger_stepDebug_memDump_impl(const char* fileIn, const int lineNumIn,
 	writeHeader(&sysLog, CXA_LOG_LEVEL_DEBUG);
 
 	// print our location
-	cxa_ioStream_writeFormattedString(ioStream,  "%s::%d - ", fileIn, lineNumIn);
+	cxa_ioStream_writeString(ioStream, fileIn);
+	cxa_ioStream_writeString(ioStream, "::");
+	cxa_ioStream_writeInt32(ioStream, lineNumIn);
+	cxa_ioStream_writeString(ioStream, " - ");
 
 	// print our message
 	cxa_ioStream_writeString(ioStream, msgIn);
 
 	cxa_ioStream_writeString(ioStream, "{");
-	for( size_t i = 0; i < numBytesIn; i++ )
-	{
-		cxa_ioStream_writeFormattedString(ioStream, "%02X", ((uint8_t*)bytesIn)[i]);
-		if( i != (numBytesIn-1) ) cxa_ioStream_writeString(ioStream, ", ");
-	}
+	cxa_encodingUtils_hex_writeToIoStream(ioStream, bytesIn, numBytesIn, ", ");
 	cxa_ioStream_writeString(ioStream, "}");
 
 
@@ -380,9 +379,14 @@ static void writeField(const char *const stringIn, size_t maxFieldLenIn)
 	else
 	{
 		cxa_ioStream_writeString(ioStream, (char*)stringIn);
-		for( size_t i = stringLen_bytes; i < maxFieldLenIn; i++ )
+
+		// pad a chunk at a time
+		static const char PADDING[] = "        ";
+		for( size_t numPad = maxFieldLenIn - stringLen_bytes; numPad > 0; )
 		{
-			cxa_ioStream_writeByte(ioStream, ' ');
+			size_t currNumPad = CXA_MIN(numPad, sizeof(PADDING)-1);
+			cxa_ioStream_writeBytes(ioStream, (void*)PADDING, currNumPad);
+			numPad -= currNumPad;
 		}
 	}
 }
@@ -423,7 +427,7 @@ static void writeHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn)
 
 	// print the time (if enabled)
 	#ifdef CXA_LOGGER_TIME_ENABLE
-		snprintf(buff, sizeof(buff), "%-8" PRIx32, cxa_timeBase_getCount_us());
+		cxa_stringUtils_formatHex(cxa_timeBase_getCount_us(), 0, buff, sizeof(buff));
 		// 32-bit integer +space
 		writeField(buff, 9);
 	#endif
@@ -433,7 +437,16 @@ static void writeHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn)
 	writeField(loggerIn->name, largestloggerName_bytes);
 
 	// pointer (id of logger)
-	snprintf(buff, sizeof(buff), "[%p]", loggerIn);
+	uintptr_t loggerId = (uintptr_t)loggerIn;
+	size_t idLen_bytes = 3;
+	memcpy(buff, "[0x", idLen_bytes);
+#if UINTPTR_MAX > UINT32_MAX
+	idLen_bytes += cxa_stringUtils_formatHex((uint32_t)(loggerId >> 32), 8, &buff[idLen_bytes], sizeof(buff) - idLen_bytes);
+	idLen_bytes += cxa_stringUtils_formatHex((uint32_t)loggerId, 8, &buff[idLen_bytes], sizeof(buff) - idLen_bytes);
+#else
+	idLen_bytes += cxa_stringUtils_formatHex((uint32_t)loggerId, 2*sizeof(void*), &buff[idLen_bytes], sizeof(buff) - idLen_bytes);
+#endif
+	cxa_stringUtils_concat(buff, "]", sizeof(buff));
 	writeField(buff, 5+(2*sizeof(void*)));
 
 	// level text
@@ -0,0 +1,547 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_encodingUtils.h"
+
+
+// ******** includes ********
+#include <string.h>
+
+#include <cxa_assert.h>
+
+#if defined(__SSSE3__)
+	#include <tmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+	#include <arm_neon.h>
+#endif
+
+
+// ******** local macro definitions ********
+#define DECODE_INVALID						0xFF
+#define DECODE_WHITESPACE					0xFE
+#define DECODE_PAD							0xFD
+
+#if (CXA_ENCODINGUTILS_STREAM_BUFFERLEN_BYTES < 16)
+	#error "CXA_ENCODINGUTILS_STREAM_BUFFERLEN_BYTES must be at least 16"
+#endif
+
+// input chunk sizes that are guaranteed to fit in the stream's output buffer
+// (including anything completed from a carried partial quantum)
+#define HEX_ENCODE_CHUNKLEN					(CXA_ENCODINGUTILS_STREAM_BUFFERLEN_BYTES / 2)
+#define HEX_DECODE_CHUNKLEN					((CXA_ENCODINGUTILS_STREAM_BUFFERLEN_BYTES - 1) * 2)
+#define BASE64_ENCODE_CHUNKLEN				(((CXA_ENCODINGUTILS_STREAM_BUFFERLEN_BYTES / 4) - 1) * 3)
+#define BASE64_DECODE_CHUNKLEN				(((CXA_ENCODINGUTILS_STREAM_BUFFERLEN_BYTES / 3) - 1) * 4)
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static void initCommon(cxa_encodingUtils_stream_t *const streamIn, cxa_encodingUtils_type_t typeIn, bool isEncoderIn);
+static bool writeOutput(cxa_encodingUtils_stream_t *const streamIn, const uint8_t *const bytesIn, size_t numBytesIn);
+
+static void encodeHex(const uint8_t* bytesIn, size_t numBytesIn, char* hexOut);
+static bool decodeHex_chunk(cxa_encodingUtils_stream_t *const streamIn, const uint8_t* charsIn, size_t numCharsIn, uint8_t *const bytesOut, size_t maxNumBytesIn, size_t *const numBytesOut);
+
+static size_t encodeBase64_chunk(cxa_encodingUtils_stream_t *const streamIn, const uint8_t* bytesIn, size_t numBytesIn, char* charsOut);
+static size_t encodeBase64_finish(cxa_encodingUtils_stream_t *const streamIn, char* charsOut);
+static bool decodeBase64_chunk(cxa_encodingUtils_stream_t *const streamIn, const uint8_t* charsIn, size_t numCharsIn, uint8_t *const bytesOut, size_t maxNumBytesIn, size_t *const numBytesOut);
+static bool decodeBase64_finish(cxa_encodingUtils_stream_t *const streamIn, uint8_t *const bytesOut, size_t maxNumBytesIn, size_t *const numBytesOut);
+
+
+// ********  local variable declarations *********
+static const char HEX_ENCODE_TABLE[16] = "0123456789ABCDEF";
+static const char BASE64_ENCODE_TABLE[64] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// DECODE_INVALID, DECODE_WHITESPACE, DECODE_PAD or the value of the character
+static const uint8_t HEX_DECODE_TABLE[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+static const uint8_t BASE64_DECODE_TABLE[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFD, 0xFF, 0xFF,
+	0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+	0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+
+// ******** global function implementations ********
+size_t cxa_encodingUtils_hex_encode(const void *const bytesIn, size_t numBytesIn, char *const hexOut)
+{
+	cxa_assert(bytesIn || (numBytesIn == 0));
+	cxa_assert(hexOut || (numBytesIn == 0));
+
+	encodeHex((const uint8_t*)bytesIn, numBytesIn, hexOut);
+	return CXA_ENCODINGUTILS_HEX_ENCODEDLEN(numBytesIn);
+}
+
+
+bool cxa_encodingUtils_hex_decode(const char *const hexIn, size_t numCharsIn, uint8_t *const bytesOut)
+{
+	cxa_assert(hexIn || (numCharsIn == 0));
+	cxa_assert(bytesOut || (numCharsIn == 0));
+
+	if( (numCharsIn % 2) != 0 ) return false;
+
+	const uint8_t* currChar = (const uint8_t*)hexIn;
+	for( size_t i = 0; i < (numCharsIn / 2); i++ )
+	{
+		uint8_t hi = HEX_DECODE_TABLE[*currChar++];
+		uint8_t lo = HEX_DECODE_TABLE[*currChar++];
+		if( (hi | lo) > 0x0F ) return false;
+
+		bytesOut[i] = (hi << 4) | lo;
+	}
+
+	return true;
+}
+
+
+bool cxa_encodingUtils_hex_writeToIoStream(cxa_ioStream_t *const ioStreamIn, const void *const bytesIn, size_t numBytesIn, const char *const separatorIn)
+{
+	cxa_assert(ioStreamIn);
+	cxa_assert(bytesIn || (numBytesIn == 0));
+
+	char outBuff[CXA_ENCODINGUTILS_STREAM_BUFFERLEN_BYTES];
+	const uint8_t* currByte = (const uint8_t*)bytesIn;
+
+	size_t sepLen_bytes = (separatorIn != NULL) ? strlen(separatorIn) : 0;
+	if( sepLen_bytes == 0 )
+	{
+		// straight encode, chunk at a time
+		while( numBytesIn > 0 )
+		{
+			size_t chunkLen_bytes = (numBytesIn < HEX_ENCODE_CHUNKLEN) ? numBytesIn : HEX_ENCODE_CHUNKLEN;
+			encodeHex(currByte, chunkLen_bytes, outBuff);
+			if( !cxa_ioStream_writeBytes(ioStreamIn, outBuff, CXA_ENCODINGUTILS_HEX_ENCODEDLEN(chunkLen_bytes)) ) return false;
+
+			currByte += chunkLen_bytes;
+			numBytesIn -= chunkLen_bytes;
+		}
+		return true;
+	}
+
+	// separator is written between bytes (not after the last one)
+	cxa_assert((2 + sepLen_bytes) <= sizeof(outBuff));
+	size_t numOut = 0;
+	for( size_t i = 0; i < numBytesIn; i++ )
+	{
+		if( (numOut + 2 + sepLen_bytes) > sizeof(outBuff) )
+		{
+			if( !cxa_ioStream_writeBytes(ioStreamIn, outBuff, numOut) ) return false;
+			numOut = 0;
+		}
+
+		outBuff[numOut++] = HEX_ENCODE_TABLE[currByte[i] >> 4];
+		outBuff[numOut++] = HEX_ENCODE_TABLE[currByte[i] & 0x0F];
+		if( i != (numBytesIn - 1) )
+		{
+			memcpy(&outBuff[numOut], separatorIn, sepLen_bytes);
+			numOut += sepLen_bytes;
+		}
+	}
+
+	return (numOut > 0) ? cxa_ioStream_writeBytes(ioStreamIn, outBuff, numOut) : true;
+}
+
+
+size_t cxa_encodingUtils_base64_encode(const void *const bytesIn, size_t numBytesIn, char *const charsOut)
+{
+	cxa_assert(bytesIn || (numBytesIn == 0));
+	cxa_assert(charsOut || (numBytesIn == 0));
+
+	cxa_encodingUtils_stream_t tmpStream;
+	initCommon(&tmpStream, CXA_ENCODINGUTILS_TYPE_BASE64, true);
+
+	size_t numChars = encodeBase64_chunk(&tmpStream, (const uint8_t*)bytesIn, numBytesIn, charsOut);
+	numChars += encodeBase64_finish(&tmpStream, &charsOut[numChars]);
+	return numChars;
+}
+
+
+bool cxa_encodingUtils_base64_decode(const char *const charsIn, size_t numCharsIn, uint8_t *const bytesOut, size_t maxNumBytesIn, size_t *const numBytesOut)
+{
+	cxa_assert(charsIn || (numCharsIn == 0));
+	cxa_assert(bytesOut || (maxNumBytesIn == 0));
+
+	cxa_encodingUtils_stream_t tmpStream;
+	initCommon(&tmpStream, CXA_ENCODINGUTILS_TYPE_BASE64, false);
+
+	size_t numBytes = 0;
+	bool retVal = decodeBase64_chunk(&tmpStream, (const uint8_t*)charsIn, numCharsIn, bytesOut, maxNumBytesIn, &numBytes) &&
+				  decodeBase64_finish(&tmpStream, bytesOut, maxNumBytesIn, &numBytes);
+
+	if( numBytesOut != NULL ) *numBytesOut = numBytes;
+	return retVal;
+}
+
+
+void cxa_encodingUtils_stream_init_ioStream(cxa_encodingUtils_stream_t *const streamIn, cxa_encodingUtils_type_t typeIn, bool isEncoderIn, cxa_ioStream_t *const ioStreamIn)
+{
+	cxa_assert(streamIn);
+	cxa_assert(ioStreamIn);
+
+	initCommon(streamIn, typeIn, isEncoderIn);
+	streamIn->ioStream = ioStreamIn;
+}
+
+
+void cxa_encodingUtils_stream_init_fbb(cxa_encodingUtils_stream_t *const streamIn, cxa_encodingUtils_type_t typeIn, bool isEncoderIn, cxa_fixedByteBuffer_t *const fbbIn)
+{
+	cxa_assert(streamIn);
+	cxa_assert(fbbIn);
+
+	initCommon(streamIn, typeIn, isEncoderIn);
+	streamIn->fbb = fbbIn;
+}
+
+
+bool cxa_encodingUtils_stream_update(cxa_encodingUtils_stream_t *const streamIn, const void *const dataIn, size_t numBytesIn)
+{
+	cxa_assert(streamIn);
+	cxa_assert(dataIn || (numBytesIn == 0));
+
+	if( streamIn->hasError ) return false;
+
+	uint8_t outBuff[CXA_ENCODINGUTILS_STREAM_BUFFERLEN_BYTES];
+	const uint8_t* currData = (const uint8_t*)dataIn;
+	while( numBytesIn > 0 )
+	{
+		size_t chunkLen_bytes = 0;
+		size_t numOut = 0;
+		bool wasChunkValid = true;
+
+		switch( streamIn->type )
+		{
+			case CXA_ENCODINGUTILS_TYPE_HEX:
+				if( streamIn->isEncoder )
+				{
+					chunkLen_bytes = (numBytesIn < HEX_ENCODE_CHUNKLEN) ? numBytesIn : HEX_ENCODE_CHUNKLEN;
+					encodeHex(currData, chunkLen_bytes, (char*)outBuff);
+					numOut = CXA_ENCODINGUTILS_HEX_ENCODEDLEN(chunkLen_bytes);
+				}
+				else
+				{
+					chunkLen_bytes = (numBytesIn < HEX_DECODE_CHUNKLEN) ? numBytesIn : HEX_DECODE_CHUNKLEN;
+					wasChunkValid = decodeHex_chunk(streamIn, currData, chunkLen_bytes, outBuff, sizeof(outBuff), &numOut);
+				}
+				break;
+
+			case CXA_ENCODINGUTILS_TYPE_BASE64:
+				if( streamIn->isEncoder )
+				{
+					chunkLen_bytes = (numBytesIn < BASE64_ENCODE_CHUNKLEN) ? numBytesIn : BASE64_ENCODE_CHUNKLEN;
+					numOut = encodeBase64_chunk(streamIn, currData, chunkLen_bytes, (char*)outBuff);
+				}
+				else
+				{
+					chunkLen_bytes = (numBytesIn < BASE64_DECODE_CHUNKLEN) ? numBytesIn : BASE64_DECODE_CHUNKLEN;
+					wasChunkValid = decodeBase64_chunk(streamIn, currData, chunkLen_bytes, outBuff, sizeof(outBuff), &numOut);
+				}
+				break;
+		}
+
+		if( !wasChunkValid || !writeOutput(streamIn, outBuff, numOut) )
+		{
+			streamIn->hasError = true;
+			return false;
+		}
+
+		currData += chunkLen_bytes;
+		numBytesIn -= chunkLen_bytes;
+	}
+
+	return true;
+}
+
+
+bool cxa_encodingUtils_stream_finish(cxa_encodingUtils_stream_t *const streamIn)
+{
+	cxa_assert(streamIn);
+
+	if( streamIn->hasError ) return false;
+
+	uint8_t outBuff[4];
+	size_t numOut = 0;
+	bool wasValid = true;
+
+	switch( streamIn->type )
+	{
+		case CXA_ENCODINGUTILS_TYPE_HEX:
+			// a dangling nibble means we were given half a byte
+			wasValid = streamIn->isEncoder || (streamIn->numAccum == 0);
+			break;
+
+		case CXA_ENCODINGUTILS_TYPE_BASE64:
+			if( streamIn->isEncoder ) numOut = encodeBase64_finish(streamIn, (char*)outBuff);
+			else wasValid = decodeBase64_finish(streamIn, outBuff, sizeof(outBuff), &numOut);
+			break;
+	}
+
+	if( !wasValid || !writeOutput(streamIn, outBuff, numOut) ) streamIn->hasError = true;
+
+	// ready for another stream (to the same output)
+	streamIn->accum = 0;
+	streamIn->numAccum = 0;
+	streamIn->numPadChars = 0;
+
+	return !streamIn->hasError;
+}
+
+
+// ******** local function implementations ********
+static void initCommon(cxa_encodingUtils_stream_t *const streamIn, cxa_encodingUtils_type_t typeIn, bool isEncoderIn)
+{
+	streamIn->type = typeIn;
+	streamIn->isEncoder = isEncoderIn;
+	streamIn->ioStream = NULL;
+	streamIn->fbb = NULL;
+	streamIn->accum = 0;
+	streamIn->numAccum = 0;
+	streamIn->numPadChars = 0;
+	streamIn->hasError = false;
+}
+
+
+static bool writeOutput(cxa_encodingUtils_stream_t *const streamIn, const uint8_t *const bytesIn, size_t numBytesIn)
+{
+	if( numBytesIn == 0 ) return true;
+
+	return (streamIn->ioStream != NULL) ?
+			cxa_ioStream_writeBytes(streamIn->ioStream, (void*)bytesIn, numBytesIn) :
+			cxa_fixedByteBuffer_append(streamIn->fbb, (uint8_t*)bytesIn, numBytesIn);
+}
+
+
+static void encodeHex(const uint8_t* bytesIn, size_t numBytesIn, char* hexOut)
+{
+#if defined(__SSSE3__)
+	// split each byte into nibbles, look both up at once, then interleave hi/lo
+	const __m128i lut = _mm_loadu_si128((const __m128i*)HEX_ENCODE_TABLE);
+	const __m128i mask = _mm_set1_epi8(0x0F);
+	for( ; numBytesIn >= 16; numBytesIn -= 16, bytesIn += 16, hexOut += 32 )
+	{
+		__m128i in = _mm_loadu_si128((const __m128i*)bytesIn);
+		__m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+		__m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(in, mask));
+		_mm_storeu_si128((__m128i*)&hexOut[0], _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i*)&hexOut[16], _mm_unpackhi_epi8(hi, lo));
+	}
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+	const uint8x16_t lut = vld1q_u8((const uint8_t*)HEX_ENCODE_TABLE);
+	for( ; numBytesIn >= 16; numBytesIn -= 16, bytesIn += 16, hexOut += 32 )
+	{
+		uint8x16_t in = vld1q_u8(bytesIn);
+		uint8x16x2_t out;
+		out.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(in, 4));
+		out.val[1] = vqtbl1q_u8(lut, vandq_u8(in, vdupq_n_u8(0x0F)));
+		vst2q_u8((uint8_t*)hexOut, out);
+	}
+#endif
+
+	for( size_t i = 0; i < numBytesIn; i++ )
+	{
+		*hexOut++ = HEX_ENCODE_TABLE[bytesIn[i] >> 4];
+		*hexOut++ = HEX_ENCODE_TABLE[bytesIn[i] & 0x0F];
+	}
+}
+
+
+static bool decodeHex_chunk(cxa_encodingUtils_stream_t *const streamIn, const uint8_t* charsIn, size_t numCharsIn, uint8_t *const bytesOut, size_t maxNumBytesIn, size_t *const numBytesOut)
+{
+	size_t numOut = *numBytesOut;
+
+	for( size_t i = 0; i < numCharsIn; i++ )
+	{
+		uint8_t currVal = HEX_DECODE_TABLE[charsIn[i]];
+		if( currVal == DECODE_WHITESPACE ) continue;
+		if( currVal > 0x0F ) return false;
+
+		streamIn->accum = (streamIn->accum << 4) | currVal;
+		if( ++streamIn->numAccum == 2 )
+		{
+			if( numOut >= maxNumBytesIn ) return false;
+			bytesOut[numOut++] = (uint8_t)streamIn->accum;
+			streamIn->accum = 0;
+			streamIn->numAccum = 0;
+		}
+	}
+
+	*numBytesOut = numOut;
+	return true;
+}
+
+
+static size_t encodeBase64_chunk(cxa_encodingUtils_stream_t *const streamIn, const uint8_t* bytesIn, size_t numBytesIn, char* charsOut)
+{
+	char *const charsOut_start = charsOut;
+
+	// complete any partial group from the last chunk
+	while( (streamIn->numAccum > 0) && (numBytesIn > 0) )
+	{
+		streamIn->accum = (streamIn->accum << 8) | *bytesIn++;
+		numBytesIn--;
+		if( ++streamIn->numAccum == 3 )
+		{
+			uint32_t group = streamIn->accum;
+			*charsOut++ = BASE64_ENCODE_TABLE[(group >> 18) & 0x3F];
+			*charsOut++ = BASE64_ENCODE_TABLE[(group >> 12) & 0x3F];
+			*charsOut++ = BASE64_ENCODE_TABLE[(group >> 6) & 0x3F];
+			*charsOut++ = BASE64_ENCODE_TABLE[group & 0x3F];
+			streamIn->accum = 0;
+			streamIn->numAccum = 0;
+		}
+	}
+
+	// whole groups
+	for( ; numBytesIn >= 3; numBytesIn -= 3, bytesIn += 3 )
+	{
+		uint32_t group = ((uint32_t)bytesIn[0] << 16) | ((uint32_t)bytesIn[1] << 8) | bytesIn[2];
+		*charsOut++ = BASE64_ENCODE_TABLE[(group >> 18) & 0x3F];
+		*charsOut++ = BASE64_ENCODE_TABLE[(group >> 12) & 0x3F];
+		*charsOut++ = BASE64_ENCODE_TABLE[(group >> 6) & 0x3F];
+		*charsOut++ = BASE64_ENCODE_TABLE[group & 0x3F];
+	}
+
+	// carry the remainder
+	for( ; numBytesIn > 0; numBytesIn-- )
+	{
+		streamIn->accum = (streamIn->accum << 8) | *bytesIn++;
+		streamIn->numAccum++;
+	}
+
+	return (size_t)(charsOut - charsOut_start);
+}
+
+
+static size_t encodeBase64_finish(cxa_encodingUtils_stream_t *const streamIn, char* charsOut)
+{
+	if( streamIn->numAccum == 0 ) return 0;
+
+	// left-align the remaining bits in a 24-bit group
+	uint32_t group = streamIn->accum << ((3 - streamIn->numAccum) * 8);
+	charsOut[0] = BASE64_ENCODE_TABLE[(group >> 18) & 0x3F];
+	charsOut[1] = BASE64_ENCODE_TABLE[(group >> 12) & 0x3F];
+	charsOut[2] = (streamIn->numAccum == 2) ? BASE64_ENCODE_TABLE[(group >> 6) & 0x3F] : '=';
+	charsOut[3] = '=';
+
+	streamIn->accum = 0;
+	streamIn->numAccum = 0;
+	return 4;
+}
+
+
+static bool decodeBase64_chunk(cxa_encodingUtils_stream_t *const streamIn, const uint8_t* charsIn, size_t numCharsIn, uint8_t *const bytesOut, size_t maxNumBytesIn, size_t *const numBytesOut)
+{
+	size_t numOut = *numBytesOut;
+
+	for( size_t i = 0; i < numCharsIn; i++ )
+	{
+		// fast path: a whole group of data characters at a group boundary
+		if( (streamIn->numAccum == 0) && (streamIn->numPadChars == 0) && ((numCharsIn - i) >= 4) )
+		{
+			uint8_t v0 = BASE64_DECODE_TABLE[charsIn[i]];
+			uint8_t v1 = BASE64_DECODE_TABLE[charsIn[i+1]];
+			uint8_t v2 = BASE64_DECODE_TABLE[charsIn[i+2]];
+			uint8_t v3 = BASE64_DECODE_TABLE[charsIn[i+3]];
+			if( (v0 | v1 | v2 | v3) < 64 )
+			{
+				if( (numOut + 3) > maxNumBytesIn ) return false;
+				uint32_t group = ((uint32_t)v0 << 18) | ((uint32_t)v1 << 12) | ((uint32_t)v2 << 6) | v3;
+				bytesOut[numOut++] = (uint8_t)(group >> 16);
+				bytesOut[numOut++] = (uint8_t)(group >> 8);
+				bytesOut[numOut++] = (uint8_t)group;
+				i += 3;
+				continue;
+			}
+		}
+
+		uint8_t currVal = BASE64_DECODE_TABLE[charsIn[i]];
+		if( currVal == DECODE_WHITESPACE ) continue;
+		if( currVal == DECODE_INVALID ) return false;
+
+		if( currVal == DECODE_PAD )
+		{
+			// padding may only complete a group with at least 2 data characters
+			if( (streamIn->numAccum < 2) || ((streamIn->numAccum + streamIn->numPadChars) >= 4) ) return false;
+			streamIn->numPadChars++;
+			continue;
+		}
+
+		// nothing but padding/whitespace may follow padding
+		if( streamIn->numPadChars > 0 ) return false;
+
+		streamIn->accum = (streamIn->accum << 6) | currVal;
+		if( ++streamIn->numAccum == 4 )
+		{
+			if( (numOut + 3) > maxNumBytesIn ) return false;
+			bytesOut[numOut++] = (uint8_t)(streamIn->accum >> 16);
+			bytesOut[numOut++] = (uint8_t)(streamIn->accum >> 8);
+			bytesOut[numOut++] = (uint8_t)streamIn->accum;
+			streamIn->accum = 0;
+			streamIn->numAccum = 0;
+		}
+	}
+
+	*numBytesOut = numOut;
+	return true;
+}
+
+
+static bool decodeBase64_finish(cxa_encodingUtils_stream_t *const streamIn, uint8_t *const bytesOut, size_t maxNumBytesIn, size_t *const numBytesOut)
+{
+	// padding is optional, but if present it must complete the group
+	if( (streamIn->numPadChars > 0) && ((streamIn->numAccum + streamIn->numPadChars) != 4) ) return false;
+
+	switch( streamIn->numAccum )
+	{
+		case 0:
+			return true;
+
+		case 2:
+			if( (*numBytesOut + 1) > maxNumBytesIn ) return false;
+			bytesOut[(*numBytesOut)++] = (uint8_t)(streamIn->accum >> 4);
+			return true;
+
+		case 3:
+			if( (*numBytesOut + 2) > maxNumBytesIn ) return false;
+			bytesOut[(*numBytesOut)++] = (uint8_t)(streamIn->accum >> 10);
+			bytesOut[(*numBytesOut)++] = (uint8_t)(streamIn->accum >> 2);
+			return true;
+
+		default:
+			// a single trailing character can't encode a whole byte
+			return false;
+	}
+}
@@ -10,20 +10,18 @@
 // ******** includes ********
 #include <ctype.h>
 #include <errno.h>
+#include <limits.h>
 #include <string.h>
 #include <stdarg.h>
 #include <stdlib.h>
 
 #include <cxa_assert.h>
+#include <cxa_encodingUtils.h>
 #include <cxa_numberUtils.h>
 
-#if defined(__XC) || defined(BGM_BUILD)
-    // for toolchains that don't have a native implementation
-    #include <strtok.h>
-#endif
-
 
 // ******** local macro definitions ********
+#define MAX_FIXED_FRAC_DIGITS					9
 
 
 // ******** local type definitions ********
@@ -39,8 +37,16 @@ typedef struct
 double strtod (const char* str, char** endptr);     // disable for pic32
 #endif
 
+static const char* findFirst(const char* haystackIn, size_t haystackLen_bytesIn, const char* needleIn, size_t needleLen_bytesIn);
+static size_t writeDigitsReversed(bool isNegativeIn, const char *const digitsIn, size_t numDigitsIn, char *const strOut, size_t maxLen_bytesIn);
+static bool parseDecimal(const char* strIn, size_t strLen_bytesIn, unsigned long maxPositiveIn, unsigned long maxNegativeIn, bool *const isNegativeOut, unsigned long *const magnitudeOut);
+
 
 // ********  local variable declarations *********
+static const char HEX_DIGITS[16] = "0123456789ABCDEF";
+
+static const uint32_t POWERS_OF_TEN[MAX_FIXED_FRAC_DIGITS+1] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
 static dataType_string_mapEntry_t DT_STRING_MAP[] =
 {
 		{CXA_STRINGUTILS_DATATYPE_DOUBLE,  "double"},
@@ -64,15 +70,9 @@ bool cxa_stringUtils_startsWith_withLengths(const char* targetStringIn, size_t t
 {
 	// make sure we have enough chars in our target string
 	if( prefixStringLen_bytesIn > targetStringLen_bytesIn ) return false;
+	if( prefixStringLen_bytesIn == 0 ) return true;
 
-	// iterate our characters
-	for( size_t i = 0; i < prefixStringLen_bytesIn; i++ )
-	{
-		if( targetStringIn[i] != prefixStringIn[i] ) return false;
-	}
-
-	// if we made it here, target string starts with prefix string
-	return true;
+	return (memcmp(targetStringIn, prefixStringIn, prefixStringLen_bytesIn) == 0);
 }
 
 
@@ -87,14 +87,7 @@ bool cxa_stringUtils_endsWith_withLengths(const char* targetStringIn, size_t tar
 	size_t suffixStringLen_bytes = strlen(suffixStringIn);
 	if( suffixStringLen_bytes > targetStringLen_bytesIn ) return false;
 
-	// iterate our characters
-	for( size_t i = 0; i < suffixStringLen_bytes; i++ )
-	{
-		if( targetStringIn[targetStringLen_bytesIn-1-i] != suffixStringIn[suffixStringLen_bytes-1-i] ) return false;
-	}
-
-	// if we made it here, target string starts with prefix string
-	return true;
+	return (memcmp(&targetStringIn[targetStringLen_bytesIn - suffixStringLen_bytes], suffixStringIn, suffixStringLen_bytes) == 0);
 }
 
 
@@ -299,12 +292,17 @@ size_t cxa_stringUtils_countOccurences_withLengths(const char* targetStringIn, s
 	cxa_assert(targetStringIn);
 	cxa_assert(elementIn);
 
-	if( elementStringLen_bytesIn > targetStringLen_bytesIn ) return 0;
+	if( (elementStringLen_bytesIn == 0) || (elementStringLen_bytesIn > targetStringLen_bytesIn) ) return 0;
 
+	// (overlapping occurrences are counted)
 	size_t retVal = 0;
-	for( size_t i = 0; i < targetStringLen_bytesIn - elementStringLen_bytesIn; i++ )
+	const char* currPos = targetStringIn;
+	const char* endPos = targetStringIn + targetStringLen_bytesIn;
+	const char* match;
+	while( (match = findFirst(currPos, (endPos - currPos), elementIn, elementStringLen_bytesIn)) != NULL )
 	{
-		if( cxa_stringUtils_equals_withLengths(&targetStringIn[i], elementStringLen_bytesIn, elementIn, elementStringLen_bytesIn) ) retVal++;
+		retVal++;
+		currPos = match + 1;
 	}
 
 	return retVal;
@@ -315,14 +313,37 @@ ssize_t cxa_stringUtils_indexOfFirstOccurence_withLengths(const char* targetStri
 {
 	if( (targetStringIn == NULL) || (elementIn == NULL) ) return -2;
 
-	for( size_t i = 0; i < targetStringLen_bytesIn; i++ )
+	const char* match = findFirst(targetStringIn, targetStringLen_bytesIn, elementIn, elementLen_bytesIn);
+	return (match != NULL) ? (match - targetStringIn) : -1;
+}
+
+
+size_t cxa_stringUtils_split_withLengths(const char* targetStringIn, size_t targetStringLen_bytesIn, char separatorIn,
+										 cxa_stringUtils_token_t *const tokensOut, size_t maxNumTokensIn)
+{
+	cxa_assert(targetStringIn);
+	cxa_assert(tokensOut || (maxNumTokensIn == 0));
+
+	size_t numTokens = 0;
+	const char* currPos = targetStringIn;
+	const char* endPos = targetStringIn + targetStringLen_bytesIn;
+	while( true )
 	{
-		if( (i + elementLen_bytesIn) > targetStringLen_bytesIn ) break;
+		const char* sep = (currPos < endPos) ? memchr(currPos, separatorIn, (endPos - currPos)) : NULL;
+		const char* tokenEnd = (sep != NULL) ? sep : endPos;
 
-		if( strncmp(&targetStringIn[i], elementIn, elementLen_bytesIn) == 0 ) return i;
+		if( numTokens < maxNumTokensIn )
+		{
+			tokensOut[numTokens].str = currPos;
+			tokensOut[numTokens].len_bytes = tokenEnd - currPos;
+		}
+		numTokens++;
+
+		if( sep == NULL ) break;
+		currPos = sep + 1;
 	}
 
-	return -1;
+	return numTokens;
 }
 
 
@@ -415,15 +436,22 @@ bool cxa_stringUtils_bytesToHexString(uint8_t* bytesIn, size_t numBytesIn, bool
 	cxa_assert(bytesIn);
 	cxa_assert(hexStringOut);
 
+	if( maxLenHexString_bytesIn == 0 ) return false;
 	hexStringOut[0] = 0;
+	if( maxLenHexString_bytesIn < (CXA_ENCODINGUTILS_HEX_ENCODEDLEN(numBytesIn) + 1) ) return false;
 
-	for( size_t i = 0; i < numBytesIn; i++ )
+	if( transposeIn )
 	{
-		char currHexByteStr[3];
-		snprintf(currHexByteStr, sizeof(currHexByteStr), "%02X", bytesIn[(transposeIn ? (numBytesIn - i - 1) : i)]);
-
-		if( !cxa_stringUtils_concat(hexStringOut, currHexByteStr, maxLenHexString_bytesIn) ) return false;
+		for( size_t i = 0; i < numBytesIn; i++ )
+		{
+			cxa_encodingUtils_hex_encode(&bytesIn[numBytesIn - i - 1], 1, &hexStringOut[i * 2]);
+		}
+	}
+	else
+	{
+		cxa_encodingUtils_hex_encode(bytesIn, numBytesIn, hexStringOut);
 	}
+	hexStringOut[CXA_ENCODINGUTILS_HEX_ENCODEDLEN(numBytesIn)] = 0;
 
 	return true;
 }
@@ -436,41 +464,15 @@ bool cxa_stringUtils_hexStringToBytes(const char *const hexStringIn, size_t numB
 	size_t strLength_bytes = strlen(hexStringIn);
 	if( (strLength_bytes / 2) < numBytesIn ) return false;
 
-	memset(bytesOut, 0, numBytesIn);
+	if( !cxa_encodingUtils_hex_decode(hexStringIn, CXA_ENCODINGUTILS_HEX_ENCODEDLEN(numBytesIn), bytesOut) ) return false;
 
-	for( size_t i = 0; i < strLength_bytes; i++ )
+	if( transposeIn )
 	{
-		uint8_t currChar = hexStringIn[i];
-
-		// keep all alpha characters upper case
-		if( islower(currChar) ) currChar = toupper(currChar);
-
-		// convert to a value
-		uint8_t currVal = 0;
-		if( (48 <= currChar) && (currChar <= 57) )
-		{
-			currVal = currChar - 48;				// 0-9
-		}
-		else if( (65 <= currChar) && (currChar <= 70) )
-		{
-			currVal = (currChar - 65) + 10;			// A-F
-		}
-		else
-		{
-			return false;
-		}
-
-		size_t currByte = i / 2;
-		if( transposeIn ) currByte = numBytesIn - currByte - 1;
-		if( i % 2 )
+		for( size_t i = 0; i < (numBytesIn / 2); i++ )
 		{
-			// lower nibble
-			bytesOut[currByte] |= (currVal << 0);
-		}
-		else
-		{
-			// upper nibble
-			bytesOut[currByte] |= (currVal << 4);
+			uint8_t tmp = bytesOut[i];
+			bytesOut[i] = bytesOut[numBytesIn - i - 1];
+			bytesOut[numBytesIn - i - 1] = tmp;
 		}
 	}
 
@@ -482,35 +484,20 @@ bool cxa_stringUtils_ipStringToUint32(const char *const ipStringIn, uint32_t *co
 {
 	if( ipStringIn == NULL ) return false;
 
-	cxa_stringUtils_parseResult_t parseResult;
-	char* tokSavePtr;
-	char* targetStr;
-
-	if( ((targetStr = strtok_r((char*)ipStringIn, ".", &tokSavePtr)) == NULL) ||
-		!cxa_stringUtils_parseString(targetStr, &parseResult) ||
-		(parseResult.dataType != CXA_STRINGUTILS_DATATYPE_INTEGER) ||
-		(parseResult.val_uint > 255) ) return false;
-	uint8_t byte0 = parseResult.val_uint;
-
-	if( ((targetStr = strtok_r(NULL, ".", &tokSavePtr)) == NULL) ||
-		!cxa_stringUtils_parseString(targetStr, &parseResult) ||
-		(parseResult.dataType != CXA_STRINGUTILS_DATATYPE_INTEGER) ||
-		(parseResult.val_uint > 255) ) return false;
-	uint8_t byte1 = parseResult.val_uint;
+	cxa_stringUtils_token_t octets[4];
+	if( cxa_stringUtils_split_withLengths(ipStringIn, strlen(ipStringIn), '.', octets, 4) != 4 ) return false;
 
-	if( ((targetStr = strtok_r(NULL, ".", &tokSavePtr)) == NULL) ||
-		!cxa_stringUtils_parseString(targetStr, &parseResult) ||
-		(parseResult.dataType != CXA_STRINGUTILS_DATATYPE_INTEGER) ||
-		(parseResult.val_uint > 255) ) return false;
-	uint8_t byte2 = parseResult.val_uint;
-
-	if( ((targetStr = strtok_r(NULL, ".", &tokSavePtr)) == NULL) ||
-		!cxa_stringUtils_parseString(targetStr, &parseResult) ||
-		(parseResult.dataType != CXA_STRINGUTILS_DATATYPE_INTEGER) ||
-		(parseResult.val_uint > 255) ) return false;
-	uint8_t byte3 = parseResult.val_uint;
+	uint32_t ipBytes = 0;
+	for( size_t i = 0; i < 4; i++ )
+	{
+		uint32_t currOctet;
+		if( (octets[i].len_bytes > 3) ||
+			!cxa_stringUtils_parseUint32_withLength(octets[i].str, octets[i].len_bytes, &currOctet) ||
+			(currOctet > 255) ) return false;
+		ipBytes |= (currOctet << (8 * i));
+	}
 
-	if( ipBytesOut != NULL ) *ipBytesOut = ((uint32_t)byte3 << 24) | ((uint32_t)byte2 << 16) | ((uint32_t)byte1 << 8) | ((uint32_t)byte0 << 0);
+	if( ipBytesOut != NULL ) *ipBytesOut = ipBytes;
 
 	return true;
 }
@@ -555,11 +542,13 @@ bool cxa_stringUtils_parseString(char *const strIn, cxa_stringUtils_parseResult_
 	}
 	else
 	{
-		// this may be a signed integer or a string
-		char* p = strIn;
-		errno = 0;
-		long val = strtol(strIn, &p, 10);
-		if( (errno != 0) || (strIn == p) || (*p != 0) )
+		// this may be a signed integer or a string (leading whitespace is ignored)
+		const char* p = strIn;
+		while( isspace((int)*p) ) p++;
+
+		bool isNegative;
+		unsigned long magnitude;
+		if( !parseDecimal(p, strlen(p), LONG_MAX, ((unsigned long)LONG_MAX) + 1, &isNegative, &magnitude) )
 		{
 			// couldn't parse an integer...must be a string
 			parseSuccess = true;
@@ -576,7 +565,7 @@ bool cxa_stringUtils_parseString(char *const strIn, cxa_stringUtils_parseResult_
 			if( parseResultOut != NULL )
 			{
 				parseResultOut->dataType = CXA_STRINGUTILS_DATATYPE_INTEGER;
-				parseResultOut->val_int = val;
+				parseResultOut->val_int = (isNegative && (magnitude > 0)) ? (-(long)(magnitude - 1) - 1) : (long)magnitude;
 			}
 		}
 	}
@@ -585,6 +574,218 @@ bool cxa_stringUtils_parseString(char *const strIn, cxa_stringUtils_parseResult_
 }
 
 
+size_t cxa_stringUtils_formatUint32(uint32_t valIn, char *const strOut, size_t maxLen_bytesIn)
+{
+	cxa_assert(strOut);
+
+	char digits[10];
+	size_t numDigits = 0;
+	do
+	{
+		digits[numDigits++] = '0' + (valIn % 10);
+		valIn /= 10;
+	} while( valIn > 0 );
+
+	return writeDigitsReversed(false, digits, numDigits, strOut, maxLen_bytesIn);
+}
+
+
+size_t cxa_stringUtils_formatInt32(int32_t valIn, char *const strOut, size_t maxLen_bytesIn)
+{
+	cxa_assert(strOut);
+
+	// unsigned negate so INT32_MIN doesn't overflow
+	uint32_t magnitude = (valIn < 0) ? (0 - (uint32_t)valIn) : (uint32_t)valIn;
+
+	char digits[10];
+	size_t numDigits = 0;
+	do
+	{
+		digits[numDigits++] = '0' + (magnitude % 10);
+		magnitude /= 10;
+	} while( magnitude > 0 );
+
+	return writeDigitsReversed((valIn < 0), digits, numDigits, strOut, maxLen_bytesIn);
+}
+
+
+size_t cxa_stringUtils_formatHex(uint32_t valIn, uint8_t minNumDigitsIn, char *const strOut, size_t maxLen_bytesIn)
+{
+	cxa_assert(strOut);
+	cxa_assert(minNumDigitsIn <= 8);
+
+	char digits[8];
+	size_t numDigits = 0;
+	do
+	{
+		digits[numDigits++] = HEX_DIGITS[valIn & 0x0F];
+		valIn >>= 4;
+	} while( valIn > 0 );
+	while( numDigits < minNumDigitsIn ) digits[numDigits++] = '0';
+
+	return writeDigitsReversed(false, digits, numDigits, strOut, maxLen_bytesIn);
+}
+
+
+size_t cxa_stringUtils_formatFixed(int32_t valIn, uint8_t numFracDigitsIn, char *const strOut, size_t maxLen_bytesIn)
+{
+	cxa_assert(strOut);
+	cxa_assert(numFracDigitsIn <= MAX_FIXED_FRAC_DIGITS);
+
+	uint32_t magnitude = (valIn < 0) ? (0 - (uint32_t)valIn) : (uint32_t)valIn;
+
+	// fractional digits (always all of them), then the point, then at least one integer digit
+	char digits[MAX_FIXED_FRAC_DIGITS + 1 + 10];
+	size_t numDigits = 0;
+	for( uint8_t i = 0; i < numFracDigitsIn; i++ )
+	{
+		digits[numDigits++] = '0' + (magnitude % 10);
+		magnitude /= 10;
+	}
+	if( numFracDigitsIn > 0 ) digits[numDigits++] = '.';
+	do
+	{
+		digits[numDigits++] = '0' + (magnitude % 10);
+		magnitude /= 10;
+	} while( magnitude > 0 );
+
+	return writeDigitsReversed((valIn < 0), digits, numDigits, strOut, maxLen_bytesIn);
+}
+
+
+bool cxa_stringUtils_parseUint32(const char *const strIn, uint32_t *const valOut)
+{
+	if( strIn == NULL ) return false;
+
+	return cxa_stringUtils_parseUint32_withLength(strIn, strlen(strIn), valOut);
+}
+
+
+bool cxa_stringUtils_parseUint32_withLength(const char *const strIn, size_t strLen_bytesIn, uint32_t *const valOut)
+{
+	if( (strIn == NULL) || (strLen_bytesIn == 0) || (strIn[0] == '-') || (strIn[0] == '+') ) return false;
+
+	bool isNegative;
+	unsigned long magnitude;
+	if( !parseDecimal(strIn, strLen_bytesIn, UINT32_MAX, 0, &isNegative, &magnitude) ) return false;
+
+	if( valOut != NULL ) *valOut = (uint32_t)magnitude;
+	return true;
+}
+
+
+bool cxa_stringUtils_parseInt32(const char *const strIn, int32_t *const valOut)
+{
+	if( strIn == NULL ) return false;
+
+	return cxa_stringUtils_parseInt32_withLength(strIn, strlen(strIn), valOut);
+}
+
+
+bool cxa_stringUtils_parseInt32_withLength(const char *const strIn, size_t strLen_bytesIn, int32_t *const valOut)
+{
+	if( strIn == NULL ) return false;
+
+	bool isNegative;
+	unsigned long magnitude;
+	if( !parseDecimal(strIn, strLen_bytesIn, INT32_MAX, ((unsigned long)INT32_MAX) + 1, &isNegative, &magnitude) ) return false;
+
+	if( valOut != NULL ) *valOut = isNegative ? (int32_t)(0 - (uint32_t)magnitude) : (int32_t)magnitude;
+	return true;
+}
+
+
+bool cxa_stringUtils_parseHex(const char *const strIn, uint32_t *const valOut)
+{
+	if( strIn == NULL ) return false;
+
+	return cxa_stringUtils_parseHex_withLength(strIn, strlen(strIn), valOut);
+}
+
+
+bool cxa_stringUtils_parseHex_withLength(const char *const strIn, size_t strLen_bytesIn, uint32_t *const valOut)
+{
+	if( strIn == NULL ) return false;
+
+	size_t i = 0;
+	if( (strLen_bytesIn >= 2) && (strIn[0] == '0') && ((strIn[1] == 'x') || (strIn[1] == 'X')) ) i = 2;
+	if( i == strLen_bytesIn ) return false;
+
+	uint32_t val = 0;
+	for( ; i < strLen_bytesIn; i++ )
+	{
+		char currChar = strIn[i];
+		uint8_t currNibble;
+		if( (currChar >= '0') && (currChar <= '9') ) currNibble = currChar - '0';
+		else if( (currChar >= 'A') && (currChar <= 'F') ) currNibble = currChar - 'A' + 10;
+		else if( (currChar >= 'a') && (currChar <= 'f') ) currNibble = currChar - 'a' + 10;
+		else return false;
+
+		if( val > (UINT32_MAX >> 4) ) return false;
+		val = (val << 4) | currNibble;
+	}
+
+	if( valOut != NULL ) *valOut = val;
+	return true;
+}
+
+
+bool cxa_stringUtils_parseFixed(const char *const strIn, uint8_t numFracDigitsIn, int32_t *const valOut)
+{
+	if( strIn == NULL ) return false;
+
+	return cxa_stringUtils_parseFixed_withLength(strIn, strlen(strIn), numFracDigitsIn, valOut);
+}
+
+
+bool cxa_stringUtils_parseFixed_withLength(const char *const strIn, size_t strLen_bytesIn, uint8_t numFracDigitsIn, int32_t *const valOut)
+{
+	cxa_assert(numFracDigitsIn <= MAX_FIXED_FRAC_DIGITS);
+	if( strIn == NULL ) return false;
+
+	size_t i = 0;
+	bool isNegative = false;
+	if( (strLen_bytesIn > 0) && ((strIn[0] == '-') || (strIn[0] == '+')) )
+	{
+		isNegative = (strIn[0] == '-');
+		i++;
+	}
+
+	// accumulate the integer part, then up to numFracDigitsIn fractional digits
+	uint64_t magnitude = 0;
+	size_t numDigits = 0;
+	uint8_t numFracDigits = 0;
+	bool hasPoint = false;
+	for( ; i < strLen_bytesIn; i++ )
+	{
+		char currChar = strIn[i];
+		if( (currChar == '.') && !hasPoint )
+		{
+			hasPoint = true;
+			continue;
+		}
+		if( (currChar < '0') || (currChar > '9') ) return false;
+		numDigits++;
+
+		// extra fractional digits are truncated (but must still be digits)
+		if( hasPoint && (numFracDigits >= numFracDigitsIn) ) continue;
+		if( hasPoint ) numFracDigits++;
+
+		// scaling below only grows the magnitude, so we can bail early
+		magnitude = (magnitude * 10) + (currChar - '0');
+		if( magnitude > ((uint64_t)INT32_MAX + 1) ) return false;
+	}
+	if( numDigits == 0 ) return false;
+
+	// scale up for any fractional digits that weren't given
+	magnitude *= POWERS_OF_TEN[numFracDigitsIn - numFracDigits];
+	if( magnitude > ((uint64_t)INT32_MAX + (isNegative ? 1 : 0)) ) return false;
+
+	if( valOut != NULL ) *valOut = isNegative ? (int32_t)(0 - (uint32_t)magnitude) : (int32_t)magnitude;
+	return true;
+}
+
+
 const char* cxa_stringUtils_getStringForDataType(cxa_stringUtils_dataType_t dataTypeIn)
 {
 	for(size_t i = 0; i < (sizeof(DT_STRING_MAP)/sizeof(*DT_STRING_MAP)); i++ )
@@ -597,3 +798,70 @@ const char* cxa_stringUtils_getStringForDataType(cxa_stringUtils_dataType_t data
 
 
 // ******** local function implementations ********
+static const char* findFirst(const char* haystackIn, size_t haystackLen_bytesIn, const char* needleIn, size_t needleLen_bytesIn)
+{
+	if( needleLen_bytesIn > haystackLen_bytesIn ) return NULL;
+	if( needleLen_bytesIn == 0 ) return (haystackLen_bytesIn > 0) ? haystackIn : NULL;
+
+	// let memchr (vectorized or word-at-a-time in most libcs) skip to candidates for the first character
+	const char* currPos = haystackIn;
+	const char* lastStartPos = haystackIn + (haystackLen_bytesIn - needleLen_bytesIn);
+	while( currPos <= lastStartPos )
+	{
+		currPos = memchr(currPos, needleIn[0], (lastStartPos - currPos) + 1);
+		if( currPos == NULL ) return NULL;
+
+		if( memcmp(currPos + 1, needleIn + 1, needleLen_bytesIn - 1) == 0 ) return currPos;
+		currPos++;
+	}
+
+	return NULL;
+}
+
+
+static size_t writeDigitsReversed(bool isNegativeIn, const char *const digitsIn, size_t numDigitsIn, char *const strOut, size_t maxLen_bytesIn)
+{
+	if( maxLen_bytesIn == 0 ) return 0;
+
+	size_t numChars = numDigitsIn + (isNegativeIn ? 1 : 0);
+	if( (numChars + 1) > maxLen_bytesIn )
+	{
+		strOut[0] = 0;
+		return 0;
+	}
+
+	char* currChar = strOut;
+	if( isNegativeIn ) *currChar++ = '-';
+	for( size_t i = numDigitsIn; i > 0; i-- ) *currChar++ = digitsIn[i-1];
+	*currChar = 0;
+
+	return numChars;
+}
+
+
+static bool parseDecimal(const char* strIn, size_t strLen_bytesIn, unsigned long maxPositiveIn, unsigned long maxNegativeIn, bool *const isNegativeOut, unsigned long *const magnitudeOut)
+{
+	size_t i = 0;
+	bool isNegative = false;
+	if( (strLen_bytesIn > 0) && ((strIn[0] == '-') || (strIn[0] == '+')) )
+	{
+		isNegative = (strIn[0] == '-');
+		i++;
+	}
+	if( i == strLen_bytesIn ) return false;
+
+	unsigned long maxMagnitude = isNegative ? maxNegativeIn : maxPositiveIn;
+	unsigned long magnitude = 0;
+	for( ; i < strLen_bytesIn; i++ )
+	{
+		if( (strIn[i] < '0') || (strIn[i] > '9') ) return false;
+
+		unsigned long currDigit = strIn[i] - '0';
+		if( magnitude > ((maxMagnitude - currDigit) / 10) ) return false;
+		magnitude = (magnitude * 10) + currDigit;
+	}
+
+	*isNegativeOut = isNegative;
+	*magnitudeOut = magnitude;
+	return true;
+}
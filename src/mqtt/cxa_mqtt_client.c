@@ -111,6 +111,11 @@ void cxa_mqtt_client_init(cxa_mqtt_client_t *const clientIn, cxa_ioStream_t *con
 	cxa_stateMachine_addState(&clientIn->stateMachine, MQTT_STATE_CONNECTING, "connecting", stateCb_connecting_enter, stateCb_connecting_state, NULL, (void*)clientIn);
 	cxa_stateMachine_addState(&clientIn->stateMachine, MQTT_STATE_CONNECTED, "connected", stateCb_connected_enter, stateCb_connected_state, NULL, (void*)clientIn);
 	cxa_stateMachine_setInitialState(&clientIn->stateMachine, MQTT_STATE_IDLE);
+
+	// we're driven by our transport, our protocolParser and our timeouts
+	cxa_stateMachine_setStateIsPolled(&clientIn->stateMachine, MQTT_STATE_CONNECTING, false);
+	cxa_stateMachine_setStateIsPolled(&clientIn->stateMachine, MQTT_STATE_CONNECTED, false);
+	cxa_stateMachine_setSuspendWhenIdle(&clientIn->stateMachine, true);
 }
 
 
@@ -403,6 +408,8 @@ static void stateCb_connecting_state(cxa_stateMachine_t *const smIn, void *userV
 		cxa_stateMachine_transition(&clientIn->stateMachine, MQTT_STATE_IDLE);
 		return;
 	}
+
+	cxa_stateMachine_kickAfter(&clientIn->stateMachine, cxa_timeDiff_getRemainingTime_ms(&clientIn->td_timeout, CXA_MQTT_CONNACK_TIMEOUT_MS));
 }
 
 
@@ -472,7 +479,14 @@ static void stateCb_connected_state(cxa_stateMachine_t *const smIn, void *userVa
 
 		// let our lower-level connection know that we're disconnecting
 		if( clientIn->scm_onDisconnect != NULL ) clientIn->scm_onDisconnect(clientIn);
-		return;
+	}
+
+	// wake up for whichever keepalive comes due first
+	if( clientIn->keepAliveTimeout_s != 0 )
+	{
+		uint32_t untilSend_ms = cxa_timeDiff_getRemainingTime_ms(&clientIn->td_sendKeepAlive, (clientIn->keepAliveTimeout_s * 1000));
+		uint32_t untilReceive_ms = cxa_timeDiff_getRemainingTime_ms(&clientIn->td_receiveKeepAlive, (clientIn->keepAliveTimeout_s * 1000 * 2));
+		cxa_stateMachine_kickAfter(&clientIn->stateMachine, (untilSend_ms < untilReceive_ms) ? untilSend_ms : untilReceive_ms);
 	}
 }
 
@@ -118,6 +118,10 @@ void cxa_mqtt_connManager_init(char *const hostNameIn, uint16_t portNumIn, int t
 	cxa_stateMachine_addState(&stateMachine, STATE_CONNECT_STANDOFF, "standOff", stateCb_connectStandOff_enter, stateCb_connectStandOff_state, NULL, NULL);
 	cxa_stateMachine_setInitialState(&stateMachine, STATE_IDLE);
 
+	// we're driven by our mqtt client (and our standoff timer)
+	cxa_stateMachine_setStateIsPolled(&stateMachine, STATE_CONNECT_STANDOFF, false);
+	cxa_stateMachine_setSuspendWhenIdle(&stateMachine, true);
+
 	// and our mqtt client
 	cxa_mqtt_client_network_init(&mqttClient, cxa_uniqueId_getHexString(), threadIdIn);
 	cxa_mqtt_client_addListener(&mqttClient.super, mqttClientCb_onConnect, mqttClientCb_onConnectFail, mqttClientCb_onDisconnect, NULL, NULL);
@@ -276,7 +280,10 @@ static void stateCb_connectStandOff_state(cxa_stateMachine_t *const smIn, void *
 		{
 			cxa_stateMachine_transition(&stateMachine, STATE_CONNECT_STANDOFF);
 		}
+		return;
 	}
+
+	cxa_stateMachine_kickAfter(&stateMachine, cxa_timeDiff_getRemainingTime_ms(&td_connStandoff, connStandoff_ms));
 }
 
 
@@ -337,34 +344,36 @@ static bool receiveCString(cxa_ioStream_t *const ioStreamIn, uint8_t *const targ
 	cxa_timeDiff_t td_timeout;
 	cxa_timeDiff_init(&td_timeout);
 
-	uint8_t rxByte;
 	bool isStringNullTerminated = false;
-	while( numRxBytes < expectedNumBytesIn )
+	while( (numRxBytes < expectedNumBytesIn) && !isStringNullTerminated )
 	{
-		cxa_ioStream_readStatus_t rs = cxa_ioStream_readByte(ioStreamIn, &rxByte);
-		if( rs == CXA_IOSTREAM_READSTAT_GOTDATA )
+		// drain everything that has already arrived before touching the timeBase
+		// (a certificate arrives as one long burst)
+		size_t numRxBytes_burstStart = numRxBytes;
+		cxa_ioStream_readStatus_t rs = CXA_IOSTREAM_READSTAT_NODATA;
+		while( (numRxBytes < expectedNumBytesIn) &&
+			   ((rs = cxa_ioStream_readByte(ioStreamIn, &targetBufferIn[numRxBytes])) == CXA_IOSTREAM_READSTAT_GOTDATA) )
 		{
-			// save the byte
-			targetBufferIn[numRxBytes++] = rxByte;
-
 			// if we get a null byte, we're done
-			if( rxByte == 0 )
+			if( targetBufferIn[numRxBytes++] == 0 )
 			{
 				isStringNullTerminated = true;
 				break;
 			}
-
-			// if we made it here, continue receiving bytes
-			cxa_timeDiff_setStartTime_now(&td_timeout);
 		}
-		else if( rs == CXA_IOSTREAM_READSTAT_ERROR )
+
+		if( rs == CXA_IOSTREAM_READSTAT_ERROR )
 		{
 			cxa_ioStream_writeLine(ioStreamIn, "NO");
 			return false;
 		}
 
-		// make sure we haven't timed out
-		if( cxa_timeDiff_isElapsed_ms(&td_timeout, SET_CREDS_TIMEOUT_MS) )
+		// the timeout only restarts once per burst
+		if( numRxBytes != numRxBytes_burstStart )
+		{
+			cxa_timeDiff_setStartTime_now(&td_timeout);
+		}
+		else if( cxa_timeDiff_isElapsed_ms(&td_timeout, SET_CREDS_TIMEOUT_MS) )
 		{
 			cxa_ioStream_writeLine(ioStreamIn, "NO");
 			return false;
@@ -79,6 +79,13 @@ void cxa_protocolParser_mqtt_init(cxa_protocolParser_mqtt_t *const mppIn, cxa_io
 	cxa_stateMachine_addState(&mppIn->stateMachine, RX_STATE_PROCESS_PACKET, "processPacket", rxStateCb_processPacket_enter, NULL, NULL, (void*)mppIn);
 	cxa_stateMachine_addState(&mppIn->stateMachine, RX_STATE_ERROR, "error", rxState_cb_error_enter, NULL, NULL, (void*)mppIn);
 	cxa_stateMachine_setInitialState(&mppIn->stateMachine, RX_STATE_IDLE);
+
+	// our waiting states only run when the ioStream has data (or times out)
+	cxa_stateMachine_setStateIsPolled(&mppIn->stateMachine, RX_STATE_IDLE, false);
+	cxa_stateMachine_setStateIsPolled(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1, false);
+	cxa_stateMachine_setStateIsPolled(&mppIn->stateMachine, RX_STATE_WAIT_REMAINING_LEN, false);
+	cxa_stateMachine_setStateIsPolled(&mppIn->stateMachine, RX_STATE_WAIT_DATABYTES, false);
+	cxa_protocolParser_setRxStateMachine(&mppIn->super, &mppIn->stateMachine);
 }
 
 
@@ -160,6 +167,9 @@ static void rxState_cb_idle_state(cxa_stateMachine_t *const smIn, void *userVarI
 		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
 		return;
 	}
+
+	// binding our ioStream (or setting a buffer) kicks us
+	cxa_protocolParser_continueReading(&mppIn->super, CXA_IOSTREAM_READSTAT_NODATA);
 }
 
 
@@ -205,6 +215,7 @@ static void rxStateCb_waitFixedHeader1_state(cxa_stateMachine_t *const smIn, voi
 
 			default:
 				cxa_logger_warn(&mppIn->super.logger, "unknown header byte: 0x%02X", rxByte);
+				cxa_protocolParser_continueReading(&mppIn->super, readStat);
 				return;
 		}
 
@@ -230,6 +241,8 @@ static void rxStateCb_waitFixedHeader1_state(cxa_stateMachine_t *const smIn, voi
 		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_ERROR);
 		return;
 	}
+
+	cxa_protocolParser_continueReading(&mppIn->super, readStat);
 }
 
 
@@ -284,6 +297,10 @@ static void rxStateCb_waitRemainingLen_state(cxa_stateMachine_t *const smIn, voi
 		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
 		return;
 	}
+
+	// keep reading (and wake up for our reception timeout)
+	cxa_protocolParser_continueReading(&mppIn->super, readStat);
+	cxa_stateMachine_kickAfter(&mppIn->stateMachine, cxa_timeDiff_getRemainingTime_ms(&mppIn->super.td_timeout, RECEPTION_TIMEOUT_MS));
 }
 
 
@@ -329,6 +346,10 @@ static void rxStateCb_waitDataBytes_state(cxa_stateMachine_t *const smIn, void *
 		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
 		return;
 	}
+
+	// keep reading (and wake up for our reception timeout)
+	cxa_protocolParser_continueReading(&mppIn->super, readStat);
+	cxa_stateMachine_kickAfter(&mppIn->stateMachine, cxa_timeDiff_getRemainingTime_ms(&mppIn->super.td_timeout, RECEPTION_TIMEOUT_MS));
 }
 
 
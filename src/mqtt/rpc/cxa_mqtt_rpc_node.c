@@ -108,7 +108,7 @@ void cxa_mqtt_rpc_node_vinit2(cxa_mqtt_rpc_node_t *const nodeIn, cxa_mqtt_rpc_no
 	// register for run loop execution
 	cxa_mqtt_client_t* mqttClient = cxa_mqtt_rpc_node_getClient(nodeIn);
 	cxa_assert(mqttClient);
-	cxa_runLoop_addEntry(cxa_mqtt_client_getThreadId(mqttClient), NULL, cb_onRunLoopUpdate, (void*)nodeIn);
+	nodeIn->runLoopEntry = cxa_runLoop_addEntry(cxa_mqtt_client_getThreadId(mqttClient), NULL, cb_onRunLoopUpdate, (void*)nodeIn);
 }
 
 
@@ -208,6 +208,9 @@ bool cxa_mqtt_rpc_node_executeMethod(cxa_mqtt_rpc_node_t *const nodeIn,
 			cxa_mqtt_messageFactory_decrementMessageRefCount(msg);
 			return false;
 		}
+
+		// we've got a timeout to watch now
+		cxa_runLoop_entry_resume(nodeIn->runLoopEntry);
 	}
 
 	// excellent...now we need to figure out where this message is headed...
@@ -380,8 +383,8 @@ static bool scm_handleRequest_downstream(cxa_mqtt_rpc_node_t *const superIn,
 		currTopicLen_bytes--;
 	}
 
-	// count our remaining separators to tell us if the message is bound for one of our methods
-	if( cxa_stringUtils_countOccurences_withLengths(currTopic, currTopicLen_bytes, "/", 1) == 0 )
+	// if there are no more separators, the message is bound for one of our methods
+	if( cxa_stringUtils_indexOfFirstOccurence_withLengths(currTopic, currTopicLen_bytes, "/", 1) < 0 )
 	{
 		// no more separators...start looking for a method
 		cxa_array_iterate(&superIn->methods, currMethodEntry, cxa_mqtt_rpc_node_methodEntry_t)
@@ -454,6 +457,18 @@ static void cb_onRunLoopUpdate(void* userVarIn)
 		}
 	}
 
+	// sleep until our next request times out (or indefinitely if we have none)
+	uint32_t wakeDelay_ms = UINT32_MAX;
+	cxa_array_iterate(&nodeIn->outstandingRequests, currRequest, cxa_mqtt_rpc_node_outstandingRequest_t)
+	{
+		if( currRequest == NULL ) continue;
+
+		uint32_t remaining_ms = cxa_timeDiff_getRemainingTime_ms(&currRequest->td_timeout, REQUEST_TIMEOUT_MS);
+		if( remaining_ms < wakeDelay_ms ) wakeDelay_ms = remaining_ms;
+	}
+	if( wakeDelay_ms == UINT32_MAX ) cxa_runLoop_entry_suspend(nodeIn->runLoopEntry);
+	else cxa_runLoop_entry_resumeAfter(nodeIn->runLoopEntry, wakeDelay_ms);
+
 	// iterate through our subnodes and update them as well
 	cxa_array_iterate(&nodeIn->subNodes, currSubNode, cxa_mqtt_rpc_node_t*)
 	{
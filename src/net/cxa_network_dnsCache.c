@@ -0,0 +1,365 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_network_dnsCache.h"
+
+
+// ******** includes ********
+#include <ctype.h>
+#include <string.h>
+
+#include <cxa_assert.h>
+#include <cxa_criticalSection.h>
+#include <cxa_runLoop.h>
+#include <cxa_stringUtils.h>
+
+#define CXA_LOG_LEVEL			CXA_LOG_LEVEL_INFO
+#include <cxa_logger_implementation.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static bool isNumericAddress(const char *const hostNameIn);
+static cxa_network_dnsCache_entry_t* getEntry_byHostName(const char *const hostNameIn);
+static cxa_network_dnsCache_entry_t* reserveEntry(const char *const hostNameIn);
+static void setEntryState(cxa_network_dnsCache_entry_t *const entryIn, cxa_network_dnsCache_entryState_t stateIn);
+static bool isEntryExpired(cxa_network_dnsCache_entry_t *const entryIn);
+
+static void cb_onRunLoopUpdate(void* userVarIn);
+static void scheduleNextUpdate(void);
+
+
+// ********  local variable declarations *********
+static bool isInit = false;
+static cxa_network_dnsCache_scm_startResolve_t scm_startResolve = NULL;
+static cxa_network_dnsCache_entry_t entries[CXA_NETWORK_DNSCACHE_MAXNUM_ENTRIES];
+static cxa_logger_t logger;
+static cxa_runLoop_entryHandle_t runLoopEntry = CXA_RUNLOOP_ENTRYHANDLE_INVALID;
+
+
+// ******** global function implementations ********
+void cxa_network_dnsCache_init(int threadIdIn, cxa_network_dnsCache_scm_startResolve_t scm_startResolveIn)
+{
+	cxa_assert(!isInit);
+	cxa_assert(scm_startResolveIn);
+
+	scm_startResolve = scm_startResolveIn;
+	for( size_t i = 0; i < (sizeof(entries)/sizeof(*entries)); i++ )
+	{
+		entries[i].state = CXA_NETWORK_DNSCACHE_ENTRYSTATE_EMPTY;
+		entries[i].isPinned = false;
+		entries[i].hostName[0] = 0;
+		entries[i].address[0] = 0;
+		entries[i].isResultReady = false;
+		cxa_timeDiff_init(&entries[i].td_stateChange);
+		cxa_timeDiff_init(&entries[i].td_lastUsed);
+	}
+
+	cxa_logger_init(&logger, "dnsCache");
+	runLoopEntry = cxa_runLoop_addEntry(threadIdIn, NULL, cb_onRunLoopUpdate, NULL);
+
+	isInit = true;
+}
+
+
+bool cxa_network_dnsCache_isInit(void)
+{
+	return isInit;
+}
+
+
+cxa_network_dnsCache_lookupResult_t cxa_network_dnsCache_lookup(const char *const hostNameIn, char *const addressOut, size_t maxAddressLen_bytesIn)
+{
+	cxa_assert(isInit);
+	cxa_assert(hostNameIn);
+	cxa_assert(addressOut);
+
+	// nothing to resolve
+	if( isNumericAddress(hostNameIn) )
+	{
+		return cxa_stringUtils_copy(addressOut, hostNameIn, maxAddressLen_bytesIn) ? CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED : CXA_NETWORK_DNSCACHE_LOOKUP_FAILED;
+	}
+
+	cxa_network_dnsCache_entry_t* entry = getEntry_byHostName(hostNameIn);
+	if( (entry != NULL) && isEntryExpired(entry) )
+	{
+		cxa_logger_debug(&logger, "'%s' expired", entry->hostName);
+		setEntryState(entry, CXA_NETWORK_DNSCACHE_ENTRYSTATE_QUEUED);
+	}
+
+	if( entry == NULL )
+	{
+		entry = reserveEntry(hostNameIn);
+		if( entry == NULL )
+		{
+			cxa_logger_warn(&logger, "no room for '%s'", hostNameIn);
+			return CXA_NETWORK_DNSCACHE_LOOKUP_PENDING;
+		}
+		entry->isPinned = false;
+	}
+	cxa_timeDiff_setStartTime_now(&entry->td_lastUsed);
+
+	switch( entry->state )
+	{
+		case CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVED:
+			return cxa_stringUtils_copy(addressOut, entry->address, maxAddressLen_bytesIn) ? CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED : CXA_NETWORK_DNSCACHE_LOOKUP_FAILED;
+
+		case CXA_NETWORK_DNSCACHE_ENTRYSTATE_FAILED:
+			return CXA_NETWORK_DNSCACHE_LOOKUP_FAILED;
+
+		default:
+			return CXA_NETWORK_DNSCACHE_LOOKUP_PENDING;
+	}
+}
+
+
+bool cxa_network_dnsCache_preResolve(const char *const hostNameIn)
+{
+	cxa_assert(isInit);
+	cxa_assert(hostNameIn);
+
+	if( isNumericAddress(hostNameIn) ) return true;
+
+	cxa_network_dnsCache_entry_t* entry = getEntry_byHostName(hostNameIn);
+	if( entry == NULL ) entry = reserveEntry(hostNameIn);
+	if( entry == NULL )
+	{
+		cxa_logger_warn(&logger, "no room to pre-resolve '%s'", hostNameIn);
+		return false;
+	}
+
+	entry->isPinned = true;
+	return true;
+}
+
+
+void cxa_network_dnsCache_invalidate(const char *const hostNameIn)
+{
+	cxa_assert(isInit);
+	cxa_assert(hostNameIn);
+
+	cxa_network_dnsCache_entry_t* entry = getEntry_byHostName(hostNameIn);
+	if( (entry == NULL) || (entry->state != CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVED) ) return;
+
+	cxa_logger_debug(&logger, "invalidating '%s'", entry->hostName);
+	setEntryState(entry, CXA_NETWORK_DNSCACHE_ENTRYSTATE_QUEUED);
+}
+
+
+void cxa_network_dnsCache_entry_setResult(cxa_network_dnsCache_entry_t *const entryIn, const char *const hostNameIn, const char *const addressIn, uint32_t ttl_sIn)
+{
+	cxa_assert(entryIn);
+	cxa_assert(hostNameIn);
+
+	// this may be called from another context, so we just stage the
+	// result here and let our runLoop pick it up
+	cxa_criticalSection_enter();
+	if( (entryIn->state == CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVING) && cxa_stringUtils_equals_ignoreCase(entryIn->hostName, hostNameIn) )
+	{
+		entryIn->wasResultSuccessful = (addressIn != NULL) && cxa_stringUtils_copy(entryIn->resultAddress, addressIn, sizeof(entryIn->resultAddress));
+		entryIn->resultTtl_s = ttl_sIn;
+		entryIn->isResultReady = true;
+	}
+	cxa_criticalSection_exit();
+
+	cxa_runLoop_entry_resume(runLoopEntry);
+}
+
+
+// ******** local function implementations ********
+static bool isNumericAddress(const char *const hostNameIn)
+{
+	cxa_assert(hostNameIn);
+
+	// any IPv6 literal (host names can't contain ':', and literals may start with a hex letter)
+	if( strchr(hostNameIn, ':') != NULL ) return true;
+
+	// dotted-quad IPv4
+	bool hasDot = false;
+	for( const char* currChar = hostNameIn; *currChar != 0; currChar++ )
+	{
+		if( *currChar == '.' ) hasDot = true;
+		else if( !isdigit((unsigned char)*currChar) ) return false;
+	}
+	return hasDot;
+}
+
+
+static cxa_network_dnsCache_entry_t* getEntry_byHostName(const char *const hostNameIn)
+{
+	for( size_t i = 0; i < (sizeof(entries)/sizeof(*entries)); i++ )
+	{
+		if( entries[i].state == CXA_NETWORK_DNSCACHE_ENTRYSTATE_EMPTY ) continue;
+		if( cxa_stringUtils_equals_ignoreCase(entries[i].hostName, hostNameIn) ) return &entries[i];
+	}
+	return NULL;
+}
+
+
+static cxa_network_dnsCache_entry_t* reserveEntry(const char *const hostNameIn)
+{
+	if( strlen(hostNameIn) > CXA_NETWORK_DNSCACHE_MAXHOSTNAMELEN_BYTES ) return NULL;
+
+	// prefer an empty entry, otherwise evict the least-recently-used
+	// completed entry (resolving and pinned entries are never evicted)
+	cxa_network_dnsCache_entry_t* retVal = NULL;
+	uint32_t maxIdleTime_ms = 0;
+	for( size_t i = 0; i < (sizeof(entries)/sizeof(*entries)); i++ )
+	{
+		cxa_network_dnsCache_entry_t* currEntry = &entries[i];
+		if( currEntry->state == CXA_NETWORK_DNSCACHE_ENTRYSTATE_EMPTY ) { retVal = currEntry; break; }
+		if( currEntry->isPinned ) continue;
+		if( (currEntry->state != CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVED) && (currEntry->state != CXA_NETWORK_DNSCACHE_ENTRYSTATE_FAILED) ) continue;
+
+		uint32_t currIdleTime_ms = cxa_timeDiff_getElapsedTime_ms(&currEntry->td_lastUsed);
+		if( (retVal == NULL) || (currIdleTime_ms > maxIdleTime_ms) )
+		{
+			retVal = currEntry;
+			maxIdleTime_ms = currIdleTime_ms;
+		}
+	}
+	if( retVal == NULL ) return NULL;
+
+	cxa_stringUtils_copy(retVal->hostName, hostNameIn, sizeof(retVal->hostName));
+	cxa_timeDiff_setStartTime_now(&retVal->td_lastUsed);
+	setEntryState(retVal, CXA_NETWORK_DNSCACHE_ENTRYSTATE_QUEUED);
+
+	return retVal;
+}
+
+
+static void setEntryState(cxa_network_dnsCache_entry_t *const entryIn, cxa_network_dnsCache_entryState_t stateIn)
+{
+	cxa_assert(entryIn);
+
+	if( stateIn != CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVED ) entryIn->address[0] = 0;
+	entryIn->isResultReady = false;
+	entryIn->state = stateIn;
+	cxa_timeDiff_setStartTime_now(&entryIn->td_stateChange);
+
+	if( stateIn == CXA_NETWORK_DNSCACHE_ENTRYSTATE_QUEUED ) cxa_runLoop_entry_resume(runLoopEntry);
+}
+
+
+static bool isEntryExpired(cxa_network_dnsCache_entry_t *const entryIn)
+{
+	cxa_assert(entryIn);
+
+	if( (entryIn->state != CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVED) && (entryIn->state != CXA_NETWORK_DNSCACHE_ENTRYSTATE_FAILED) ) return false;
+
+	return cxa_timeDiff_isElapsed_ms(&entryIn->td_stateChange, entryIn->ttl_s * 1000);
+}
+
+
+static void cb_onRunLoopUpdate(void* userVarIn)
+{
+	for( size_t i = 0; i < (sizeof(entries)/sizeof(*entries)); i++ )
+	{
+		cxa_network_dnsCache_entry_t* currEntry = &entries[i];
+
+		// results are collected first so a synchronous result from
+		// startResolve (below) is picked up on the next iteration
+		if( currEntry->state == CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVING )
+		{
+			// the backend may be staging a result from another context
+			cxa_criticalSection_enter();
+			bool isResultReady = currEntry->isResultReady;
+			bool wasResultSuccessful = isResultReady && currEntry->wasResultSuccessful;
+			uint32_t ttl_s = (currEntry->resultTtl_s != 0) ? currEntry->resultTtl_s : CXA_NETWORK_DNSCACHE_DEFAULT_TTL_S;
+			bool hasTimedOut = !isResultReady && cxa_timeDiff_isElapsed_ms(&currEntry->td_stateChange, CXA_NETWORK_DNSCACHE_RESOLVE_TIMEOUT_MS);
+			if( wasResultSuccessful )
+			{
+				memcpy(currEntry->address, currEntry->resultAddress, sizeof(currEntry->address));
+				setEntryState(currEntry, CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVED);
+			}
+			else if( isResultReady || hasTimedOut ) setEntryState(currEntry, CXA_NETWORK_DNSCACHE_ENTRYSTATE_FAILED);
+			cxa_criticalSection_exit();
+
+			if( wasResultSuccessful )
+			{
+				if( ttl_s > CXA_NETWORK_DNSCACHE_MAX_TTL_S ) ttl_s = CXA_NETWORK_DNSCACHE_MAX_TTL_S;
+				currEntry->ttl_s = ttl_s;
+				cxa_logger_info(&logger, "'%s' -> %s (%lus)", currEntry->hostName, currEntry->address, (unsigned long)ttl_s);
+			}
+			else if( isResultReady || hasTimedOut )
+			{
+				currEntry->ttl_s = CXA_NETWORK_DNSCACHE_NEGATIVE_TTL_S;
+				cxa_logger_warn(&logger, "'%s' %s", currEntry->hostName, hasTimedOut ? "timed out" : "failed to resolve");
+			}
+		}
+		else if( currEntry->state == CXA_NETWORK_DNSCACHE_ENTRYSTATE_QUEUED )
+		{
+			cxa_logger_debug(&logger, "resolving '%s'", currEntry->hostName);
+			cxa_criticalSection_enter();
+			setEntryState(currEntry, CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVING);
+			cxa_criticalSection_exit();
+
+			// must be called outside of the critical section (a result may
+			// be set synchronously)
+			if( !scm_startResolve(currEntry, currEntry->hostName) )
+			{
+				cxa_criticalSection_enter();
+				setEntryState(currEntry, CXA_NETWORK_DNSCACHE_ENTRYSTATE_FAILED);
+				cxa_criticalSection_exit();
+				currEntry->ttl_s = CXA_NETWORK_DNSCACHE_NEGATIVE_TTL_S;
+				cxa_logger_warn(&logger, "failed to start resolving '%s'", currEntry->hostName);
+			}
+		}
+		else if( currEntry->isPinned && isEntryExpired(currEntry) )
+		{
+			// keep our pre-resolved hosts fresh
+			setEntryState(currEntry, CXA_NETWORK_DNSCACHE_ENTRYSTATE_QUEUED);
+		}
+	}
+
+	scheduleNextUpdate();
+}
+
+
+static void scheduleNextUpdate(void)
+{
+	// we only need to run for queued entries, resolve timeouts and refreshing
+	// pinned entries (lookups and results resume us)
+	uint32_t wakeDelay_ms = UINT32_MAX;
+	for( size_t i = 0; i < (sizeof(entries)/sizeof(*entries)); i++ )
+	{
+		cxa_network_dnsCache_entry_t* currEntry = &entries[i];
+
+		uint32_t currPeriod_ms;
+		if( currEntry->state == CXA_NETWORK_DNSCACHE_ENTRYSTATE_QUEUED ) return;
+		else if( currEntry->state == CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVING ) currPeriod_ms = CXA_NETWORK_DNSCACHE_RESOLVE_TIMEOUT_MS;
+		else if( currEntry->isPinned &&
+				 ((currEntry->state == CXA_NETWORK_DNSCACHE_ENTRYSTATE_RESOLVED) || (currEntry->state == CXA_NETWORK_DNSCACHE_ENTRYSTATE_FAILED)) ) currPeriod_ms = currEntry->ttl_s * 1000;
+		else continue;
+
+		uint32_t elapsed_ms = cxa_timeDiff_getElapsedTime_ms(&currEntry->td_stateChange);
+		uint32_t currDelay_ms = (elapsed_ms < currPeriod_ms) ? (currPeriod_ms - elapsed_ms) : 0;
+		if( currDelay_ms < wakeDelay_ms ) wakeDelay_ms = currDelay_ms;
+	}
+
+	if( wakeDelay_ms == 0 ) return;
+	if( wakeDelay_ms == UINT32_MAX ) cxa_runLoop_entry_suspend(runLoopEntry);
+	else cxa_runLoop_entry_resumeAfter(runLoopEntry, wakeDelay_ms);
+
+	// a result may have been staged from another context while we were suspending
+	for( size_t i = 0; i < (sizeof(entries)/sizeof(*entries)); i++ )
+	{
+		cxa_criticalSection_enter();
+		bool isResultReady = entries[i].isResultReady;
+		cxa_criticalSection_exit();
+
+		if( isResultReady )
+		{
+			cxa_runLoop_entry_resume(runLoopEntry);
+			break;
+		}
+	}
+}
@@ -18,6 +18,7 @@
 
 
 // ******** local function prototypes ********
+static void resetConnectTiming(cxa_network_tcpClient_t *const netClientIn);
 
 
 // ********  local variable declarations *********
@@ -46,6 +47,10 @@ void cxa_network_tcpClient_init(cxa_network_tcpClient_t *const netClientIn,
 
 	// setup our timediff for future use
 	cxa_timeDiff_init(&netClientIn->td_genPurp);
+	cxa_timeDiff_init(&netClientIn->connectTiming.td_connect);
+	netClientIn->connectTiming.tcpConnect_ms = 0;
+	netClientIn->connectTiming.tlsHandshake_ms = 0;
+	netClientIn->connectTiming.isTlsHandshaking = false;
 
 	// setup our listener array
 	cxa_array_initStd(&netClientIn->listeners, netClientIn->listeners_raw);
@@ -74,6 +79,7 @@ bool cxa_network_tcpClient_connectToHost(cxa_network_tcpClient_t *const netClien
 	cxa_assert(hostNameIn);
 	cxa_assert(netClientIn->scm_connToHost);
 
+	resetConnectTiming(netClientIn);
 	return netClientIn->scm_connToHost(netClientIn, hostNameIn, portNumIn, useTlsIn, timeout_msIn);
 }
 
@@ -88,6 +94,7 @@ bool cxa_network_tcpClient_connectToHost_clientCert(cxa_network_tcpClient_t *con
 	cxa_assert(hostNameIn);
 	cxa_assert(netClientIn->scm_connToHost_clientCert);
 
+	resetConnectTiming(netClientIn);
 	return netClientIn->scm_connToHost_clientCert(netClientIn, hostNameIn, portNumIn, serverRootCertIn, serverRootCertLen_bytesIn, clientCertIn, clientCertLen_bytesIn, clientPrivateKeyIn, clientPrivateKeyLen_bytesIn, timeout_msIn);
 }
 
@@ -116,10 +123,27 @@ cxa_ioStream_t* cxa_network_tcpClient_getIoStream(cxa_network_tcpClient_t *const
 }
 
 
+void cxa_network_tcpClient_getConnectTiming(cxa_network_tcpClient_t *const netClientIn, uint32_t *const tcpConnect_msOut, uint32_t *const tlsHandshake_msOut)
+{
+	cxa_assert(netClientIn);
+
+	if( tcpConnect_msOut != NULL ) *tcpConnect_msOut = netClientIn->connectTiming.tcpConnect_ms;
+	if( tlsHandshake_msOut != NULL ) *tlsHandshake_msOut = netClientIn->connectTiming.tlsHandshake_ms;
+}
+
+
 void cxa_network_tcpClient_notify_connect(cxa_network_tcpClient_t *const netClientIn)
 {
 	cxa_assert(netClientIn);
 
+	uint32_t elapsed_ms = cxa_timeDiff_getElapsedTime_ms(&netClientIn->connectTiming.td_connect);
+	if( netClientIn->connectTiming.isTlsHandshaking )
+	{
+		netClientIn->connectTiming.tlsHandshake_ms = elapsed_ms - netClientIn->connectTiming.tcpConnect_ms;
+		netClientIn->connectTiming.isTlsHandshaking = false;
+	}
+	else netClientIn->connectTiming.tcpConnect_ms = elapsed_ms;
+
 	cxa_array_iterate(&netClientIn->listeners, currListener, cxa_network_tcpClient_listenerEntry_t)
 	{
 		if( currListener == NULL ) continue;
@@ -128,6 +152,15 @@ void cxa_network_tcpClient_notify_connect(cxa_network_tcpClient_t *const netClie
 }
 
 
+void cxa_network_tcpClient_notify_tlsHandshakeStarting(cxa_network_tcpClient_t *const netClientIn)
+{
+	cxa_assert(netClientIn);
+
+	netClientIn->connectTiming.tcpConnect_ms = cxa_timeDiff_getElapsedTime_ms(&netClientIn->connectTiming.td_connect);
+	netClientIn->connectTiming.isTlsHandshaking = true;
+}
+
+
 void cxa_network_tcpClient_notify_connectFail(cxa_network_tcpClient_t *const netClientIn)
 {
 	cxa_assert(netClientIn);
@@ -153,3 +186,12 @@ void cxa_network_tcpClient_notify_disconnect(cxa_network_tcpClient_t *const netC
 
 
 // ******** local function implementations ********
+static void resetConnectTiming(cxa_network_tcpClient_t *const netClientIn)
+{
+	cxa_assert(netClientIn);
+
+	cxa_timeDiff_setStartTime_now(&netClientIn->connectTiming.td_connect);
+	netClientIn->connectTiming.tcpConnect_ms = 0;
+	netClientIn->connectTiming.tlsHandshake_ms = 0;
+	netClientIn->connectTiming.isTlsHandshaking = false;
+}
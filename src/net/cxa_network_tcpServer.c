@@ -43,6 +43,12 @@ void cxa_network_tcpServer_init(cxa_network_tcpServer_t *const tcpServerIn,
 
 	// setup our listener array
 	cxa_array_initStd(&tcpServerIn->listeners, tcpServerIn->listeners_raw);
+
+	// and our statistics
+	tcpServerIn->isAcceptPaused = false;
+	cxa_timeDiff_init(&tcpServerIn->td_acceptPaused);
+	tcpServerIn->stats.numConnectedClients = 0;
+	cxa_network_tcpServer_resetStats(tcpServerIn);
 }
 
 
@@ -76,10 +82,34 @@ void cxa_network_tcpServer_stopListening(cxa_network_tcpServer_t *const tcpServe
 }
 
 
+cxa_network_tcpServer_stats_t* cxa_network_tcpServer_getStats(cxa_network_tcpServer_t *const tcpServerIn)
+{
+	cxa_assert(tcpServerIn);
+
+	return &tcpServerIn->stats;
+}
+
+
+void cxa_network_tcpServer_resetStats(cxa_network_tcpServer_t *const tcpServerIn)
+{
+	cxa_assert(tcpServerIn);
+
+	tcpServerIn->stats.numAccepted = 0;
+	tcpServerIn->stats.numDisconnected = 0;
+	tcpServerIn->stats.maxNumConnectedClients = tcpServerIn->stats.numConnectedClients;
+	tcpServerIn->stats.numAcceptPauses = 0;
+	tcpServerIn->stats.maxAcceptPause_ms = 0;
+}
+
+
 void cxa_network_tcpServer_notifyConnect(cxa_network_tcpServer_t *const tcpServerIn, cxa_network_tcpServer_connectedClient_t* clientIn)
 {
 	cxa_assert(tcpServerIn);
 
+	tcpServerIn->stats.numAccepted++;
+	tcpServerIn->stats.numConnectedClients++;
+	if( tcpServerIn->stats.numConnectedClients > tcpServerIn->stats.maxNumConnectedClients ) tcpServerIn->stats.maxNumConnectedClients = tcpServerIn->stats.numConnectedClients;
+
 	cxa_array_iterate(&tcpServerIn->listeners, currListener, cxa_network_tcpServer_listenerEntry_t)
 	{
 		if( currListener == NULL ) continue;
@@ -89,4 +119,33 @@ void cxa_network_tcpServer_notifyConnect(cxa_network_tcpServer_t *const tcpServe
 }
 
 
+void cxa_network_tcpServer_notifyClientReleased(cxa_network_tcpServer_t *const tcpServerIn)
+{
+	cxa_assert(tcpServerIn);
+
+	tcpServerIn->stats.numDisconnected++;
+	if( tcpServerIn->stats.numConnectedClients > 0 ) tcpServerIn->stats.numConnectedClients--;
+}
+
+
+void cxa_network_tcpServer_notifyAcceptPaused(cxa_network_tcpServer_t *const tcpServerIn, bool isPausedIn)
+{
+	cxa_assert(tcpServerIn);
+
+	if( tcpServerIn->isAcceptPaused == isPausedIn ) return;
+	tcpServerIn->isAcceptPaused = isPausedIn;
+
+	if( isPausedIn )
+	{
+		tcpServerIn->stats.numAcceptPauses++;
+		cxa_timeDiff_setStartTime_now(&tcpServerIn->td_acceptPaused);
+	}
+	else
+	{
+		uint32_t pause_ms = cxa_timeDiff_getElapsedTime_ms(&tcpServerIn->td_acceptPaused);
+		if( pause_ms > tcpServerIn->stats.maxAcceptPause_ms ) tcpServerIn->stats.maxAcceptPause_ms = pause_ms;
+	}
+}
+
+
 // ******** local function implementations ********
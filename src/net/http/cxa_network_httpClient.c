@@ -8,6 +8,9 @@
 
 
 // ******** includes ********
+#include <ctype.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <cxa_assert.h>
@@ -19,7 +22,7 @@
 
 
 // ******** local macro definitions ********
-#define MAXNUM_RX_BYTES_PER_ITERATION			8
+#define MAXNUM_RX_BYTES_PER_ITERATION			64
 
 
 // ******** local type definitions ********
@@ -33,17 +36,69 @@ typedef enum
 	STATE_CONNECTED_GEN_USER_HEADERS,
 	STATE_CONNECTED_GEN_USER_BODY,
 	STATE_CONNECTED_PARSE_STATUS_CODE,
-	STATE_CONNECTED_PARSE_CONTENT_LENGTH,
-	STATE_CONNECTED_FORWARD_TO_BODY,
+	STATE_CONNECTED_PARSE_HEADERS,
 	STATE_CONNECTED_READ_BODY,
 	STATE_WAIT_DISCONNECT,
 	STATE_TRANSACTION_ERROR,
 }state_t;
 
 
+typedef enum
+{
+	CHUNKSTATE_SIZE,
+	CHUNKSTATE_SIZE_EXT,
+	CHUNKSTATE_SIZE_LF,
+	CHUNKSTATE_DATA,
+	CHUNKSTATE_DATA_CR,
+	CHUNKSTATE_DATA_LF,
+	CHUNKSTATE_TRAILER_START,
+	CHUNKSTATE_TRAILER,
+	CHUNKSTATE_FINAL_LF
+}chunkState_t;
+
+
+typedef enum
+{
+	HDRSCAN_NAME,
+	HDRSCAN_VALUE_LWS,
+	HDRSCAN_VALUE,
+	HDRSCAN_SKIP
+}headerScanState_t;
+
+
+typedef enum
+{
+	BODYSTAT_CONTINUE,
+	BODYSTAT_DONE,
+	BODYSTAT_ERROR
+}bodyStatus_t;
+
+
 // ******** local function prototypes ********
+static void startRequest(cxa_network_httpClient_t *const netClientIn, const char *const methodIn, bool hasBodyIn,
+						 char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+						 const char *const urlIn, uint32_t timeout_msIn, bool keepOpenIn,
+						 cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+						 cxa_network_httpClient_cb_postAsyncGenBody_t cb_genBodyIn,
+						 cxa_network_httpClient_cb_onPostComplete_t cb_completeIn,
+						 uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+						 void* userVarIn);
+static void resetDownload(cxa_network_httpClient_t *const netClientIn);
+static bool beginResponseBody(cxa_network_httpClient_t *const netClientIn);
+static bool parseContentRangeStart(const char *const valueIn, size_t *const startOut);
 static bool parseStatusCodeFromString(char *const lineIn, uint16_t* statusCodeOut);
-static bool parseContentLengthFromString(char *const lineIn, size_t *const contentLength_bytesOut);
+static void resetHeaderScan(cxa_network_httpClient_t *const netClientIn);
+static bool scanStatusLineByte(cxa_network_httpClient_t *const netClientIn, uint8_t byteIn);
+static bool scanHeaderByte(cxa_network_httpClient_t *const netClientIn, uint8_t byteIn);
+static bool isHeaderOfInterest(cxa_network_httpClient_t *const netClientIn, const char *const nameIn);
+static void processResponseHeader(cxa_network_httpClient_t *const netClientIn, const char *const nameIn, char *const valueIn);
+
+static bool writeChunk(cxa_network_httpClient_t *const netClientIn);
+static bool storeBodyByte(cxa_network_httpClient_t *const netClientIn, uint8_t byteIn);
+static bool flushStreamedBody(cxa_network_httpClient_t *const netClientIn);
+static bodyStatus_t processChunkedBodyByte(cxa_network_httpClient_t *const netClientIn, uint8_t byteIn);
+static void completeTransaction(cxa_network_httpClient_t *const netClientIn);
+static void continueReading(cxa_network_httpClient_t *const netClientIn, cxa_ioStream_readStatus_t lastReadStatIn);
 
 static void stateCb_idle_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void stateCb_connecting_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
@@ -53,9 +108,8 @@ static void stateCb_calcUserBody_enter(cxa_stateMachine_t *const smIn, int prevS
 static void stateCb_genUserBody_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void stateCb_xxxUserBody_state(cxa_stateMachine_t *const smIn, void *userVarIn);
 static void stateCb_parseStatusCode_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
-static void stateCb_xxxCheckTimeout_state(cxa_stateMachine_t *const smIn, void *userVarIn);
-static void stateCb_parseContentLength_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
-static void stateCb_forwardToBody_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
+static void stateCb_xxxParseResponseHead_state(cxa_stateMachine_t *const smIn, void *userVarIn);
+static void stateCb_parseHeaders_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void stateCb_readBody_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void stateCb_readBody_state(cxa_stateMachine_t *const smIn, void *userVarIn);
 static void stateCb_waitDisconnect_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
@@ -65,10 +119,10 @@ static void stateCb_transactionError_enter(cxa_stateMachine_t *const smIn, int p
 static void cb_tcpClient_onConnect(cxa_network_tcpClient_t *const superIn, void* userVarIn);
 static void cb_tcpClient_onConnectFail(cxa_network_tcpClient_t *const tcpClientIn, void* userVarIn);
 static void cb_tcpClient_onDisconnect(cxa_network_tcpClient_t *const superIn, void* userVarIn);
+static void cb_tcpClient_onDataAvailable(cxa_ioStream_t *const ioStreamIn, void *const userVarIn);
 
-static void cb_headerParser_onIoException(void *const userVarIn);
-static void cb_headerParser_onReceptionTimeout(cxa_fixedByteBuffer_t *const incompletePacketIn, void *const userVarIn);
-static void cb_headerParser_onPacketReceived(cxa_fixedByteBuffer_t *const packetIn, void *const userVarIn);
+static cxa_ioStream_readStatus_t cb_chunkedBody_readByte(uint8_t *const byteOut, void *const userVarIn);
+static bool cb_chunkedBody_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 
 
 // ********  local variable declarations *********
@@ -85,16 +139,25 @@ void cxa_network_httpClient_init(cxa_network_httpClient_t *const netClientIn, in
 	netClientIn->tcpClient = cxa_network_factory_reserveTcpClient(threadIdIn);
 	cxa_assert(netClientIn->tcpClient);
 	cxa_network_tcpClient_addListener(netClientIn->tcpClient, cb_tcpClient_onConnect, cb_tcpClient_onConnectFail, cb_tcpClient_onDisconnect, (void*)netClientIn);
+	cxa_ioStream_setDataAvailableListener(cxa_network_tcpClient_getIoStream(netClientIn->tcpClient), cb_tcpClient_onDataAvailable, (void*)netClientIn);
 
 	// setup for body generation
 	cxa_ioStream_nullablePassthrough_init(&netClientIn->ios_bodyGeneration);
+	netClientIn->useChunkedRequests = false;
+	netClientIn->reconnectAfterDisconnect = false;
+	cxa_ioStream_init(&netClientIn->ios_chunkedBody);
+	cxa_ioStream_bind(&netClientIn->ios_chunkedBody, cb_chunkedBody_readByte, cb_chunkedBody_writeBytes, (void*)netClientIn);
+	netClientIn->chunkBuffer_numBytes = 0;
 
 	// setup for responses
-	cxa_fixedByteBuffer_initStd(&netClientIn->headerLineBuffer, netClientIn->headerLineBuffer_raw);
-	cxa_protocolParser_crlf_init(&netClientIn->headerLineParser, cxa_network_tcpClient_getIoStream(netClientIn->tcpClient), &netClientIn->headerLineBuffer, threadIdIn);
-	cxa_protocolParser_addProtocolListener(&netClientIn->headerLineParser.super, cb_headerParser_onIoException, cb_headerParser_onReceptionTimeout, (void*)netClientIn);
-	cxa_protocolParser_addPacketListener(&netClientIn->headerLineParser.super, cb_headerParser_onPacketReceived, (void*)netClientIn);
+	resetHeaderScan(netClientIn);
+	cxa_array_initStd(&netClientIn->responseHeaderListeners, netClientIn->responseHeaderListeners_raw);
+	netClientIn->cb_onResponseBodyData = NULL;
+	netClientIn->isResponseComplete = false;
+	resetDownload(netClientIn);
 	cxa_timeDiff_init(&netClientIn->td_receptionTimeout);
+	cxa_timeDiff_init(&netClientIn->td_request);
+	memset(&netClientIn->lastTiming, 0, sizeof(netClientIn->lastTiming));
 
 	// setup our state machine
 	cxa_stateMachine_init(&netClientIn->stateMachine, "httpClient", threadIdIn);
@@ -105,13 +168,18 @@ void cxa_network_httpClient_init(cxa_network_httpClient_t *const netClientIn, in
 	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTED_CALC_USER_BODY, "calcBody", stateCb_calcUserBody_enter, stateCb_xxxUserBody_state, NULL, (void*)netClientIn);
 	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTED_GEN_USER_HEADERS, "genHeaders", NULL, stateCb_genUserHeaders_state, NULL, (void*)netClientIn);
 	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTED_GEN_USER_BODY, "genBody", stateCb_genUserBody_enter, stateCb_xxxUserBody_state, NULL, (void*)netClientIn);
-	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTED_PARSE_STATUS_CODE, "parseStatusCode", stateCb_parseStatusCode_enter, stateCb_xxxCheckTimeout_state, NULL, (void*)netClientIn);
-	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTED_PARSE_CONTENT_LENGTH, "parseContentLength", stateCb_parseContentLength_enter, stateCb_xxxCheckTimeout_state, NULL, (void*)netClientIn);
-	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTED_FORWARD_TO_BODY, "forwardToBody", stateCb_forwardToBody_enter, stateCb_xxxCheckTimeout_state, NULL, (void*)netClientIn);
+	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTED_PARSE_STATUS_CODE, "parseStatusCode", stateCb_parseStatusCode_enter, stateCb_xxxParseResponseHead_state, NULL, (void*)netClientIn);
+	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTED_PARSE_HEADERS, "parseHeaders", stateCb_parseHeaders_enter, stateCb_xxxParseResponseHead_state, NULL, (void*)netClientIn);
 	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTED_READ_BODY, "readBody", stateCb_readBody_enter, stateCb_readBody_state, NULL, (void*)netClientIn);
 	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_WAIT_DISCONNECT, "waitDisconn", stateCb_waitDisconnect_enter, stateCb_waitDisconnect_state, NULL, (void*)netClientIn);
 	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR, "transError", stateCb_transactionError_enter, NULL, NULL, (void*)netClientIn);
 	cxa_stateMachine_setInitialState(&netClientIn->stateMachine, STATE_IDLE_DISCONNECTED);
+
+	// response states only run when our tcpClient has data (or we time out)
+	cxa_stateMachine_setStateIsPolled(&netClientIn->stateMachine, STATE_CONNECTED_PARSE_STATUS_CODE, false);
+	cxa_stateMachine_setStateIsPolled(&netClientIn->stateMachine, STATE_CONNECTED_PARSE_HEADERS, false);
+	cxa_stateMachine_setStateIsPolled(&netClientIn->stateMachine, STATE_CONNECTED_READ_BODY, false);
+	cxa_stateMachine_setSuspendWhenIdle(&netClientIn->stateMachine, true);
 }
 
 
@@ -125,14 +193,154 @@ void cxa_network_httpClient_post_async(cxa_network_httpClient_t *const netClient
 									   void* userVarIn)
 {
 	cxa_assert(netClientIn);
+
+	resetDownload(netClientIn);
+	startRequest(netClientIn, "POST", true, hostNameIn, portNumIn, useTlsIn, urlIn, timeout_msIn, keepOpenIn,
+				 cb_genHeadersIn, cb_genBodyIn, cb_postCompleteIn, responseBodyBufferIn, responseBody_maxSize_bytesIn, userVarIn);
+}
+
+
+void cxa_network_httpClient_put_async(cxa_network_httpClient_t *const netClientIn,
+									  char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+									  const char *const urlIn, uint32_t timeout_msIn, bool keepOpenIn,
+									  cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+									  cxa_network_httpClient_cb_postAsyncGenBody_t cb_genBodyIn,
+									  cxa_network_httpClient_cb_onPostComplete_t cb_putCompleteIn,
+									  uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+									  void* userVarIn)
+{
+	cxa_assert(netClientIn);
+
+	resetDownload(netClientIn);
+	startRequest(netClientIn, "PUT", true, hostNameIn, portNumIn, useTlsIn, urlIn, timeout_msIn, keepOpenIn,
+				 cb_genHeadersIn, cb_genBodyIn, cb_putCompleteIn, responseBodyBufferIn, responseBody_maxSize_bytesIn, userVarIn);
+}
+
+
+void cxa_network_httpClient_get_async(cxa_network_httpClient_t *const netClientIn,
+									  char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+									  const char *const urlIn, uint32_t timeout_msIn, bool keepOpenIn,
+									  cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+									  cxa_network_httpClient_cb_onPostComplete_t cb_getCompleteIn,
+									  uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+									  void* userVarIn)
+{
+	cxa_assert(netClientIn);
+
+	resetDownload(netClientIn);
+	startRequest(netClientIn, "GET", false, hostNameIn, portNumIn, useTlsIn, urlIn, timeout_msIn, keepOpenIn,
+				 cb_genHeadersIn, NULL, cb_getCompleteIn, responseBodyBufferIn, responseBody_maxSize_bytesIn, userVarIn);
+}
+
+
+void cxa_network_httpClient_download_async(cxa_network_httpClient_t *const netClientIn,
+										   char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+										   const char *const urlIn, uint32_t timeout_msIn,
+										   cxa_ioStream_t *const sinkIn, size_t offset_bytesIn,
+										   cxa_network_httpClient_cb_onDownloadComplete_t cb_onCompleteIn,
+										   void* userVarIn)
+{
+	cxa_assert(netClientIn);
+	cxa_assert(sinkIn);
+
+	resetDownload(netClientIn);
+	netClientIn->download.sink = sinkIn;
+	netClientIn->download.cb_onComplete = cb_onCompleteIn;
+	netClientIn->download.offset_bytes = offset_bytesIn;
+	netClientIn->download.attemptOffset_bytes = offset_bytesIn;
+
+	startRequest(netClientIn, "GET", false, hostNameIn, portNumIn, useTlsIn, urlIn, timeout_msIn, false,
+				 NULL, NULL, NULL, NULL, 0, userVarIn);
+}
+
+
+void cxa_network_httpClient_setUseChunkedRequests(cxa_network_httpClient_t *const netClientIn, bool useChunkedRequestsIn)
+{
+	cxa_assert(netClientIn);
+
+	netClientIn->useChunkedRequests = useChunkedRequestsIn;
+}
+
+
+void cxa_network_httpClient_setResponseBodyCallback(cxa_network_httpClient_t *const netClientIn,
+													cxa_network_httpClient_cb_onResponseBodyData_t cb_onResponseBodyDataIn)
+{
+	cxa_assert(netClientIn);
+
+	netClientIn->cb_onResponseBodyData = cb_onResponseBodyDataIn;
+}
+
+
+void cxa_network_httpClient_addResponseHeaderListener(cxa_network_httpClient_t *const netClientIn,
+													  const char *const headerNameIn,
+													  cxa_network_httpClient_cb_onResponseHeader_t cbIn,
+													  void* userVarIn)
+{
+	cxa_assert(netClientIn);
+	cxa_assert(headerNameIn);
+
+	cxa_network_httpClient_responseHeaderListener_t newEntry = {.headerName=headerNameIn, .cb=cbIn, .userVar=userVarIn};
+	cxa_assert( cxa_array_append(&netClientIn->responseHeaderListeners, &newEntry) );
+}
+
+
+bool cxa_network_httpClient_isIdle(cxa_network_httpClient_t *const netClientIn)
+{
+	cxa_assert(netClientIn);
+
+	// a failed transaction remains in the error state until the next request
+	state_t currState = cxa_stateMachine_getCurrentState(&netClientIn->stateMachine);
+	return (currState == STATE_IDLE_DISCONNECTED) || (currState == STATE_IDLE_CONNECTED) || (currState == STATE_TRANSACTION_ERROR);
+}
+
+
+bool cxa_network_httpClient_isConnectedTo(cxa_network_httpClient_t *const netClientIn,
+										  const char *const hostNameIn, uint16_t portNumIn, bool useTlsIn)
+{
+	cxa_assert(netClientIn);
+	cxa_assert(hostNameIn);
+
+	return (cxa_stateMachine_getCurrentState(&netClientIn->stateMachine) == STATE_IDLE_CONNECTED) &&
+		   cxa_network_tcpClient_isConnected(netClientIn->tcpClient) &&
+		   (netClientIn->portNum == portNumIn) &&
+		   (netClientIn->useTls == useTlsIn) &&
+		   cxa_stringUtils_equals(netClientIn->hostname, hostNameIn);
+}
+
+
+cxa_network_httpClient_timing_t* cxa_network_httpClient_getLastTiming(cxa_network_httpClient_t *const netClientIn)
+{
+	cxa_assert(netClientIn);
+
+	return &netClientIn->lastTiming;
+}
+
+
+// ******** local function implementations ********
+static void startRequest(cxa_network_httpClient_t *const netClientIn, const char *const methodIn, bool hasBodyIn,
+						 char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+						 const char *const urlIn, uint32_t timeout_msIn, bool keepOpenIn,
+						 cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+						 cxa_network_httpClient_cb_postAsyncGenBody_t cb_genBodyIn,
+						 cxa_network_httpClient_cb_onPostComplete_t cb_completeIn,
+						 uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+						 void* userVarIn)
+{
+	cxa_assert(netClientIn);
 	cxa_assert(hostNameIn);
 	cxa_assert(urlIn);
-	if( responseBody_maxSize_bytesIn > 0 ) cxa_assert(responseBodyBufferIn);
+	if( responseBody_maxSize_bytesIn > 0 ) { cxa_assert(responseBodyBufferIn); }
+
+	// must be checked before we overwrite our target
+	bool canReuseConnection = cxa_network_httpClient_isConnectedTo(netClientIn, hostNameIn, portNumIn, useTlsIn);
 
 	// save our info for later
+	netClientIn->method = methodIn;
+	netClientIn->requestHasBody = hasBodyIn;
+	netClientIn->isRequestChunked = hasBodyIn && netClientIn->useChunkedRequests;
 	netClientIn->cbs.genHeaders = cb_genHeadersIn;
 	netClientIn->cbs.genBody = cb_genBodyIn;
-	netClientIn->cbs.postComplete = cb_postCompleteIn;
+	netClientIn->cbs.postComplete = cb_completeIn;
 	netClientIn->cbs.userVar = userVarIn;
 
 	cxa_assert(cxa_stringUtils_copy(netClientIn->hostname, hostNameIn, sizeof(netClientIn->hostname)));
@@ -141,16 +349,101 @@ void cxa_network_httpClient_post_async(cxa_network_httpClient_t *const netClient
 	cxa_assert(cxa_stringUtils_copy(netClientIn->url, urlIn, sizeof(netClientIn->url)));
 	netClientIn->timeout_ms = timeout_msIn;
 	netClientIn->keepOpen = keepOpenIn;
+	netClientIn->isResponseComplete = false;
 
-	netClientIn->responseBodyBuffer = responseBodyBufferIn;
-	netClientIn->responseBody_maxSize_bytes = responseBody_maxSize_bytesIn;
+	// streamed responses never touch the caller's buffer
+	netClientIn->responseBodyBuffer = (netClientIn->cb_onResponseBodyData == NULL) ? responseBodyBufferIn : NULL;
+	netClientIn->responseBody_maxSize_bytes = (netClientIn->cb_onResponseBodyData == NULL) ? responseBody_maxSize_bytesIn : 0;
 
-	// start our connection process
-	cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTING);
+	// reset our timing
+	cxa_timeDiff_setStartTime_now(&netClientIn->td_request);
+	memset(&netClientIn->lastTiming, 0, sizeof(netClientIn->lastTiming));
+	netClientIn->lastTiming.wasConnectionReused = canReuseConnection;
+
+	if( canReuseConnection )
+	{
+		cxa_logger_debug(&netClientIn->logger, "reusing connection to %s::%d", netClientIn->hostname, netClientIn->portNum);
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_SEND_DEFAULT_HEADERS);
+	}
+	else if( cxa_network_tcpClient_isConnected(netClientIn->tcpClient) )
+	{
+		// connected to a different host...must disconnect first
+		netClientIn->reconnectAfterDisconnect = true;
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_WAIT_DISCONNECT);
+	}
+	else
+	{
+		// start our connection process
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTING);
+	}
+}
+
+
+static void resetDownload(cxa_network_httpClient_t *const netClientIn)
+{
+	cxa_assert(netClientIn);
+
+	netClientIn->download.sink = NULL;
+	netClientIn->download.cb_onComplete = NULL;
+	netClientIn->download.offset_bytes = 0;
+	netClientIn->download.attemptOffset_bytes = 0;
+	netClientIn->download.numBytesToSkip = 0;
+	netClientIn->download.numResumesRemaining = CXA_NETWORK_HTTPCLIENT_DOWNLOAD_MAXNUM_RESUMES;
+	netClientIn->download.isResumable = true;
+	netClientIn->download.isWritingToSink = false;
+	netClientIn->download.hasContentRange = false;
+	netClientIn->download.contentRangeStart_bytes = 0;
+}
+
+
+static bool beginResponseBody(cxa_network_httpClient_t *const netClientIn)
+{
+	cxa_assert(netClientIn);
+
+	netClientIn->download.isWritingToSink = false;
+	netClientIn->download.numBytesToSkip = 0;
+	if( netClientIn->download.sink == NULL ) return true;
+
+	if( netClientIn->responseStatusCode == 206 )
+	{
+		// server must start exactly where we asked it to
+		if( !netClientIn->download.hasContentRange || (netClientIn->download.contentRangeStart_bytes != netClientIn->download.offset_bytes) )
+		{
+			cxa_logger_warn(&netClientIn->logger, "unexpected Content-Range (wanted %lu)", (unsigned long)netClientIn->download.offset_bytes);
+			netClientIn->download.isResumable = false;
+			return false;
+		}
+		netClientIn->download.isWritingToSink = true;
+	}
+	else if( netClientIn->responseStatusCode == 200 )
+	{
+		// server ignored our range (or we didn't send one)...discard what we already have
+		if( netClientIn->download.offset_bytes > 0 ) cxa_logger_debug(&netClientIn->logger, "range ignored, skipping %lu bytes", (unsigned long)netClientIn->download.offset_bytes);
+		netClientIn->download.numBytesToSkip = netClientIn->download.offset_bytes;
+		netClientIn->download.isWritingToSink = true;
+	}
+
+	return true;
+}
+
+
+static bool parseContentRangeStart(const char *const valueIn, size_t *const startOut)
+{
+	cxa_assert(valueIn);
+	cxa_assert(startOut);
+
+	// "bytes <start>-<end>/<total>"
+	if( !cxa_stringUtils_startsWith(valueIn, "bytes ") ) return false;
+
+	const char* currChar = valueIn + 6;
+	if( !isdigit((unsigned char)*currChar) ) return false;
+
+	char* endPtr;
+	*startOut = (size_t)strtoul(currChar, &endPtr, 10);
+	return (*endPtr == '-');
 }
 
 
-// ******** local function implementations ********
 static bool parseStatusCodeFromString(char *const lineIn, uint16_t* statusCodeOut)
 {
 	char* save_ptr;
@@ -174,37 +467,359 @@ static bool parseStatusCodeFromString(char *const lineIn, uint16_t* statusCodeOu
 }
 
 
-static bool parseContentLengthFromString(char *const lineIn, size_t *const contentLength_bytesOut)
+static void resetHeaderScan(cxa_network_httpClient_t *const netClientIn)
 {
-	const char contentLenStr[] = "Content-Length:";
+	cxa_assert(netClientIn);
 
-	// if we made it here we got a line...see if it starts with the right string
+	netClientIn->headerScan.numBytes = 0;
+	netClientIn->headerScan.nameLen_bytes = 0;
+	netClientIn->headerScan.state = HDRSCAN_NAME;
+}
 
-	if( !cxa_stringUtils_startsWith(lineIn, contentLenStr) ) return false;
 
-	// if we made it here, we got the right line...parse it
-	char* save_ptr;
-	char* currToken = strtok_r(lineIn, " ", &save_ptr);
-	if( currToken == NULL ) return false;
+static bool scanStatusLineByte(cxa_network_httpClient_t *const netClientIn, uint8_t byteIn)
+{
+	cxa_assert(netClientIn);
 
-	// one more tokenization should give us the value
-	currToken = strtok_r(NULL, " ", &save_ptr);
-	if( currToken == NULL ) return false;
+	if( byteIn == '\n' )
+	{
+		netClientIn->headerScan.line[netClientIn->headerScan.numBytes] = 0;
+		return true;
+	}
+
+	// we only need the start of the line (the reason phrase may be arbitrarily long)
+	if( (byteIn != '\r') && (netClientIn->headerScan.numBytes < (sizeof(netClientIn->headerScan.line)-1)) )
+	{
+		netClientIn->headerScan.line[netClientIn->headerScan.numBytes++] = byteIn;
+	}
+	return false;
+}
+
+
+static bool scanHeaderByte(cxa_network_httpClient_t *const netClientIn, uint8_t byteIn)
+{
+	cxa_assert(netClientIn);
+
+	const size_t maxNumBytes = sizeof(netClientIn->headerScan.line) - 1;
+	char *const line = netClientIn->headerScan.line;
+
+	switch( netClientIn->headerScan.state )
+	{
+		case HDRSCAN_NAME:
+			if( byteIn == '\r' ) break;
+			if( byteIn == '\n' )
+			{
+				// an empty line ends the headers (a line without a colon is ignored)
+				bool isEndOfHeaders = (netClientIn->headerScan.numBytes == 0);
+				resetHeaderScan(netClientIn);
+				return isEndOfHeaders;
+			}
+			if( byteIn == ':' )
+			{
+				line[netClientIn->headerScan.numBytes] = 0;
+				netClientIn->headerScan.nameLen_bytes = netClientIn->headerScan.numBytes++;
+
+				// don't bother buffering values we don't care about
+				netClientIn->headerScan.state = isHeaderOfInterest(netClientIn, line) ? HDRSCAN_VALUE_LWS : HDRSCAN_SKIP;
+				break;
+			}
 
-	long contentLength = strtol(currToken, NULL, 10);
+			// names longer than our buffer can't be one we're interested in
+			if( netClientIn->headerScan.numBytes >= maxNumBytes ) netClientIn->headerScan.state = HDRSCAN_SKIP;
+			else line[netClientIn->headerScan.numBytes++] = byteIn;
+			break;
+
+		case HDRSCAN_VALUE_LWS:
+			if( (byteIn == ' ') || (byteIn == '\t') ) break;
+			netClientIn->headerScan.state = HDRSCAN_VALUE;
+			// fallthrough
 
-	if( contentLength_bytesOut != NULL ) *contentLength_bytesOut = (size_t)contentLength;
+		case HDRSCAN_VALUE:
+			if( byteIn == '\r' ) break;
+			if( byteIn == '\n' )
+			{
+				line[netClientIn->headerScan.numBytes] = 0;
+				char *const value = &line[netClientIn->headerScan.nameLen_bytes+1];
+				cxa_stringUtils_trim(value);
+				processResponseHeader(netClientIn, line, value);
+				resetHeaderScan(netClientIn);
+				break;
+			}
+
+			if( netClientIn->headerScan.numBytes >= maxNumBytes )
+			{
+				cxa_logger_warn(&netClientIn->logger, "header '%s' too long, skipping", line);
+				netClientIn->headerScan.state = HDRSCAN_SKIP;
+			}
+			else line[netClientIn->headerScan.numBytes++] = byteIn;
+			break;
+
+		case HDRSCAN_SKIP:
+		default:
+			if( byteIn == '\n' ) resetHeaderScan(netClientIn);
+			break;
+	}
+
+	return false;
+}
+
+
+static bool isHeaderOfInterest(cxa_network_httpClient_t *const netClientIn, const char *const nameIn)
+{
+	cxa_assert(netClientIn);
+	cxa_assert(nameIn);
+
+	// needed for framing the response
+	if( cxa_stringUtils_equals_ignoreCase(nameIn, "Content-Length") ||
+		cxa_stringUtils_equals_ignoreCase(nameIn, "Transfer-Encoding") ||
+		cxa_stringUtils_equals_ignoreCase(nameIn, "Connection") ) return true;
+	if( (netClientIn->download.sink != NULL) && cxa_stringUtils_equals_ignoreCase(nameIn, "Content-Range") ) return true;
+
+	cxa_array_iterate(&netClientIn->responseHeaderListeners, currListener, cxa_network_httpClient_responseHeaderListener_t)
+	{
+		if( currListener == NULL ) continue;
+		if( cxa_stringUtils_equals_ignoreCase(nameIn, currListener->headerName) ) return true;
+	}
+	return false;
+}
+
+
+static void processResponseHeader(cxa_network_httpClient_t *const netClientIn, const char *const nameIn, char *const valueIn)
+{
+	cxa_assert(netClientIn);
+	cxa_assert(nameIn);
+	cxa_assert(valueIn);
+
+	cxa_logger_trace(&netClientIn->logger, "rx header: '%s: %s'", nameIn, valueIn);
+
+	if( cxa_stringUtils_equals_ignoreCase(nameIn, "Content-Length") )
+	{
+		netClientIn->responseContentLength_bytes = (size_t)strtoul(valueIn, NULL, 10);
+		netClientIn->hasResponseContentLength = true;
+		cxa_logger_debug(&netClientIn->logger, "expecting %d bytes", netClientIn->responseContentLength_bytes);
+	}
+	else if( cxa_stringUtils_equals_ignoreCase(nameIn, "Transfer-Encoding") )
+	{
+		// chunked takes precedence over any content length (RFC7230 3.3.3)
+		if( cxa_stringUtils_contains(valueIn, "chunked") )
+		{
+			netClientIn->isResponseChunked = true;
+			cxa_logger_debug(&netClientIn->logger, "chunked response");
+		}
+	}
+	else if( cxa_stringUtils_equals_ignoreCase(nameIn, "Connection") )
+	{
+		if( cxa_stringUtils_contains(valueIn, "close") ) netClientIn->responseRequestsClose = true;
+	}
+	else if( cxa_stringUtils_equals_ignoreCase(nameIn, "Content-Range") )
+	{
+		netClientIn->download.hasContentRange = parseContentRangeStart(valueIn, &netClientIn->download.contentRangeStart_bytes);
+	}
+
+	cxa_array_iterate(&netClientIn->responseHeaderListeners, currListener, cxa_network_httpClient_responseHeaderListener_t)
+	{
+		if( currListener == NULL ) continue;
+		if( (currListener->cb != NULL) && cxa_stringUtils_equals_ignoreCase(nameIn, currListener->headerName) )
+		{
+			currListener->cb(netClientIn, nameIn, valueIn, currListener->userVar);
+		}
+	}
+}
+
+
+static bool writeChunk(cxa_network_httpClient_t *const netClientIn)
+{
+	cxa_assert(netClientIn);
+
+	// a zero-length chunk would terminate the body
+	if( netClientIn->chunkBuffer_numBytes == 0 ) return true;
+
+	cxa_ioStream_t* ios = cxa_network_tcpClient_getIoStream(netClientIn->tcpClient);
+	bool retVal = cxa_ioStream_writeFormattedLine(ios, "%X", (unsigned int)netClientIn->chunkBuffer_numBytes) &&
+				  cxa_ioStream_writeBytes(ios, netClientIn->chunkBuffer, netClientIn->chunkBuffer_numBytes) &&
+				  cxa_ioStream_writeString(ios, "\r\n");
+	netClientIn->chunkBuffer_numBytes = 0;
+
+	return retVal;
+}
+
+
+static bool storeBodyByte(cxa_network_httpClient_t *const netClientIn, uint8_t byteIn)
+{
+	cxa_assert(netClientIn);
+
+	// streamed bodies are staged in our (otherwise idle) request chunk buffer
+	if( netClientIn->download.numBytesToSkip > 0 )
+	{
+		netClientIn->download.numBytesToSkip--;
+	}
+	else if( netClientIn->download.isWritingToSink || (netClientIn->cb_onResponseBodyData != NULL) )
+	{
+		if( (netClientIn->chunkBuffer_numBytes == sizeof(netClientIn->chunkBuffer)) && !flushStreamedBody(netClientIn) ) return false;
+		netClientIn->chunkBuffer[netClientIn->chunkBuffer_numBytes++] = byteIn;
+	}
+	// otherwise store to our buffer if we have one
+	else if( netClientIn->responseBodyBuffer != NULL )
+	{
+		// make sure we won't overflow (-1 is for null term)
+		if( netClientIn->responseBody_currSize_bytes >= (netClientIn->responseBody_maxSize_bytes-1) ) return false;
+
+		netClientIn->responseBodyBuffer[netClientIn->responseBody_currSize_bytes] = byteIn;
+	}
+	netClientIn->responseBody_currSize_bytes++;
 
 	return true;
 }
 
 
+static bool flushStreamedBody(cxa_network_httpClient_t *const netClientIn)
+{
+	cxa_assert(netClientIn);
+
+	if( netClientIn->chunkBuffer_numBytes == 0 ) return true;
+
+	size_t numBytes = netClientIn->chunkBuffer_numBytes;
+	netClientIn->chunkBuffer_numBytes = 0;
+
+	if( netClientIn->download.isWritingToSink )
+	{
+		if( !cxa_ioStream_writeBytes(netClientIn->download.sink, netClientIn->chunkBuffer, numBytes) )
+		{
+			cxa_logger_warn(&netClientIn->logger, "error writing to download sink");
+			netClientIn->download.isResumable = false;
+			return false;
+		}
+		netClientIn->download.offset_bytes += numBytes;
+		return true;
+	}
+
+	return (netClientIn->cb_onResponseBodyData == NULL) ? true : netClientIn->cb_onResponseBodyData(netClientIn, netClientIn->responseStatusCode, netClientIn->chunkBuffer, numBytes, netClientIn->cbs.userVar);
+}
+
+
+static bodyStatus_t processChunkedBodyByte(cxa_network_httpClient_t *const netClientIn, uint8_t byteIn)
+{
+	cxa_assert(netClientIn);
+
+	switch( netClientIn->responseChunkState )
+	{
+		case CHUNKSTATE_SIZE:
+			if( isxdigit(byteIn) )
+			{
+				if( netClientIn->responseChunk_remainingBytes > (SIZE_MAX >> 4) ) return BODYSTAT_ERROR;
+				netClientIn->responseChunk_remainingBytes = (netClientIn->responseChunk_remainingBytes << 4) |
+															(isdigit(byteIn) ? (byteIn - '0') : (tolower(byteIn) - 'a' + 10));
+			}
+			else if( (byteIn == ';') || (byteIn == ' ') || (byteIn == '\t') ) netClientIn->responseChunkState = CHUNKSTATE_SIZE_EXT;
+			else if( byteIn == '\r' ) netClientIn->responseChunkState = CHUNKSTATE_SIZE_LF;
+			else return BODYSTAT_ERROR;
+			break;
+
+		case CHUNKSTATE_SIZE_EXT:
+			// chunk extensions are ignored
+			if( byteIn == '\r' ) netClientIn->responseChunkState = CHUNKSTATE_SIZE_LF;
+			break;
+
+		case CHUNKSTATE_SIZE_LF:
+			if( byteIn != '\n' ) return BODYSTAT_ERROR;
+			netClientIn->responseChunkState = (netClientIn->responseChunk_remainingBytes == 0) ? CHUNKSTATE_TRAILER_START : CHUNKSTATE_DATA;
+			break;
+
+		case CHUNKSTATE_DATA:
+			if( !storeBodyByte(netClientIn, byteIn) ) return BODYSTAT_ERROR;
+			if( --netClientIn->responseChunk_remainingBytes == 0 ) netClientIn->responseChunkState = CHUNKSTATE_DATA_CR;
+			break;
+
+		case CHUNKSTATE_DATA_CR:
+			if( byteIn != '\r' ) return BODYSTAT_ERROR;
+			netClientIn->responseChunkState = CHUNKSTATE_DATA_LF;
+			break;
+
+		case CHUNKSTATE_DATA_LF:
+			if( byteIn != '\n' ) return BODYSTAT_ERROR;
+			netClientIn->responseChunkState = CHUNKSTATE_SIZE;
+			break;
+
+		case CHUNKSTATE_TRAILER_START:
+			// an empty line ends the trailers (and the body)
+			netClientIn->responseChunkState = (byteIn == '\r') ? CHUNKSTATE_FINAL_LF : CHUNKSTATE_TRAILER;
+			break;
+
+		case CHUNKSTATE_TRAILER:
+			// trailers are ignored
+			if( byteIn == '\n' ) netClientIn->responseChunkState = CHUNKSTATE_TRAILER_START;
+			break;
+
+		case CHUNKSTATE_FINAL_LF:
+			return (byteIn == '\n') ? BODYSTAT_DONE : BODYSTAT_ERROR;
+
+		default:
+			return BODYSTAT_ERROR;
+	}
+
+	return BODYSTAT_CONTINUE;
+}
+
+
+static void completeTransaction(cxa_network_httpClient_t *const netClientIn)
+{
+	cxa_assert(netClientIn);
+
+	// deliver the tail of a streamed body
+	if( !flushStreamedBody(netClientIn) )
+	{
+		cxa_logger_warn(&netClientIn->logger, "aborted by body callback");
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
+		return;
+	}
+
+	netClientIn->lastTiming.total_ms = cxa_timeDiff_getElapsedTime_ms(&netClientIn->td_request);
+	cxa_logger_debug(&netClientIn->logger, "done reading body (%d bytes) in %d ms", netClientIn->responseBody_currSize_bytes, netClientIn->lastTiming.total_ms);
+
+	// null term our body for ease-of-use
+	if( netClientIn->responseBodyBuffer != NULL ) netClientIn->responseBodyBuffer[netClientIn->responseBody_currSize_bytes] = '\0';
+
+	// our transition to idle is deferred, so the server may close the
+	// connection (eg. "Connection: close") before we get there
+	netClientIn->isResponseComplete = true;
+
+	// call our callback (if any)
+	if( netClientIn->cbs.postComplete != NULL )
+	{
+		netClientIn->cbs.postComplete(netClientIn, true, netClientIn->responseStatusCode, (char*)netClientIn->responseBodyBuffer, netClientIn->responseBody_currSize_bytes, netClientIn->cbs.userVar);
+	}
+	if( netClientIn->download.cb_onComplete != NULL )
+	{
+		netClientIn->download.cb_onComplete(netClientIn, true, netClientIn->responseStatusCode, netClientIn->download.offset_bytes, netClientIn->cbs.userVar);
+	}
+
+	// move on
+	cxa_stateMachine_transition(&netClientIn->stateMachine, (netClientIn->keepOpen && !netClientIn->responseRequestsClose) ? STATE_IDLE_CONNECTED : STATE_IDLE_DISCONNECTED);
+}
+
+
+static void continueReading(cxa_network_httpClient_t *const netClientIn, cxa_ioStream_readStatus_t lastReadStatIn)
+{
+	cxa_assert(netClientIn);
+
+	// run again right away if there may be more to read (or we can't be told when there is)...
+	if( (lastReadStatIn == CXA_IOSTREAM_READSTAT_GOTDATA) || !cxa_ioStream_notifiesDataAvailable(cxa_network_tcpClient_getIoStream(netClientIn->tcpClient)) )
+	{
+		cxa_stateMachine_kick(&netClientIn->stateMachine);
+	}
+
+	// ...and, regardless, when our reception timeout expires
+	cxa_stateMachine_kickAfter(&netClientIn->stateMachine, cxa_timeDiff_getRemainingTime_ms(&netClientIn->td_receptionTimeout, netClientIn->timeout_ms));
+}
+
+
 static void stateCb_idle_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
 {
 	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
 	state_t currState = cxa_stateMachine_getCurrentState(&netClientIn->stateMachine);
+	netClientIn->reconnectAfterDisconnect = false;
 
 	// see if we need to disconnect
 	if( (currState == STATE_IDLE_DISCONNECTED) && cxa_network_tcpClient_isConnected(netClientIn->tcpClient) )
@@ -223,6 +838,8 @@ static void stateCb_connecting_enter(cxa_stateMachine_t *const smIn, int prevSta
 	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
+	netClientIn->reconnectAfterDisconnect = false;
+
 	cxa_logger_info(&netClientIn->logger, "connecting to %s::%d", netClientIn->hostname, netClientIn->portNum);
 	if( !cxa_network_tcpClient_connectToHost(netClientIn->tcpClient, netClientIn->hostname, netClientIn->portNum, netClientIn->useTls, netClientIn->timeout_ms) )
 	{
@@ -244,9 +861,27 @@ static void stateCb_sendDefaultHeaders_enter(cxa_stateMachine_t *const smIn, int
 
 	cxa_ioStream_t* ios = cxa_network_tcpClient_getIoStream(netClientIn->tcpClient);
 
-	cxa_ioStream_writeFormattedLine(ios, "POST %s HTTP/1.1", netClientIn->url);
+	cxa_ioStream_writeFormattedLine(ios, "%s %s HTTP/1.1", netClientIn->method, netClientIn->url);
 	cxa_ioStream_writeFormattedLine(ios, "Host: %s", netClientIn->hostname);
-	cxa_ioStream_writeLine(ios, "Content-Type: application/json");
+	if( netClientIn->requestHasBody ) cxa_ioStream_writeLine(ios, "Content-Type: application/json");
+	if( !netClientIn->keepOpen ) cxa_ioStream_writeLine(ios, "Connection: close");
+	if( (netClientIn->download.sink != NULL) && (netClientIn->download.offset_bytes > 0) )
+	{
+		cxa_ioStream_writeFormattedLine(ios, "Range: bytes=%lu-", (unsigned long)netClientIn->download.offset_bytes);
+	}
+
+	// requests without a body (and chunked requests) don't need to know the size of the body up front
+	if( !netClientIn->requestHasBody )
+	{
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_GEN_USER_HEADERS);
+		return;
+	}
+	if( netClientIn->isRequestChunked )
+	{
+		cxa_ioStream_writeLine(ios, "Transfer-Encoding: chunked");
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_GEN_USER_HEADERS);
+		return;
+	}
 
 	cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_CALC_USER_BODY);
 }
@@ -289,12 +924,20 @@ static void stateCb_genUserBody_enter(cxa_stateMachine_t *const smIn, int prevSt
 	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
-	cxa_logger_debug(&netClientIn->logger, "generating user body size (2nd pass)");
-
 	cxa_ioStream_t* ios = cxa_network_tcpClient_getIoStream(netClientIn->tcpClient);
 
 	// make our body generation stream nonnull so we actually generate and send the body
-	cxa_ioStream_nullablePassthrough_setNullableStream(&netClientIn->ios_bodyGeneration, ios);
+	if( netClientIn->isRequestChunked )
+	{
+		cxa_logger_debug(&netClientIn->logger, "generating chunked user body");
+		netClientIn->chunkBuffer_numBytes = 0;
+		cxa_ioStream_nullablePassthrough_setNullableStream(&netClientIn->ios_bodyGeneration, &netClientIn->ios_chunkedBody);
+	}
+	else
+	{
+		cxa_logger_debug(&netClientIn->logger, "generating user body (2nd pass)");
+		cxa_ioStream_nullablePassthrough_setNullableStream(&netClientIn->ios_bodyGeneration, ios);
+	}
 	cxa_ioStream_nullablePassthrough_resetNumByesWritten(&netClientIn->ios_bodyGeneration);
 
 	// need to send our end-of-header
@@ -327,6 +970,16 @@ static void stateCb_xxxUserBody_state(cxa_stateMachine_t *const smIn, void *user
 		}
 		else
 		{
+			// flush any partial chunk and terminate the body
+			if( netClientIn->isRequestChunked &&
+				!(writeChunk(netClientIn) && cxa_ioStream_writeString(cxa_network_tcpClient_getIoStream(netClientIn->tcpClient), "0\r\n\r\n")) )
+			{
+				cxa_logger_warn(&netClientIn->logger, "error sending chunked body");
+				cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
+				return;
+			}
+
+			cxa_logger_debug(&netClientIn->logger, "user body sent (%d bytes)", cxa_ioStream_nullablePassthrough_getNumBytesWritten(&netClientIn->ios_bodyGeneration));
 			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_PARSE_STATUS_CODE);
 		}
 	}
@@ -341,50 +994,95 @@ static void stateCb_parseStatusCode_enter(cxa_stateMachine_t *const smIn, int pr
 	cxa_logger_debug(&netClientIn->logger, "waiting for status code");
 	cxa_timeDiff_setStartTime_now(&netClientIn->td_receptionTimeout);
 
-	// turn on our header parser
-	cxa_protocolParser_crlf_resume(&netClientIn->headerLineParser);
+	// reset our response framing
+	netClientIn->responseContentLength_bytes = 0;
+	netClientIn->hasResponseContentLength = false;
+	netClientIn->isResponseChunked = false;
+	netClientIn->responseRequestsClose = false;
 
-	// wait for protocol parser callbacks
+	// start scanning for our status line
+	resetHeaderScan(netClientIn);
+	netClientIn->download.hasContentRange = false;
 }
 
 
-static void stateCb_xxxCheckTimeout_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+static void stateCb_xxxParseResponseHead_state(cxa_stateMachine_t *const smIn, void *userVarIn)
 {
 	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
+	state_t currState = cxa_stateMachine_getCurrentState(&netClientIn->stateMachine);
+	cxa_ioStream_readStatus_t readState = CXA_IOSTREAM_READSTAT_NODATA;
+	for( int i = 0; i < MAXNUM_RX_BYTES_PER_ITERATION; i++ )
+	{
+		uint8_t rxByte;
+		readState = cxa_ioStream_readByte(cxa_network_tcpClient_getIoStream(netClientIn->tcpClient), &rxByte);
+		if( readState == CXA_IOSTREAM_READSTAT_ERROR )
+		{
+			cxa_logger_warn(&netClientIn->logger, "error reading response");
+			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
+			return;
+		}
+		else if( readState != CXA_IOSTREAM_READSTAT_GOTDATA ) break;
+
+		cxa_timeDiff_setStartTime_now(&netClientIn->td_receptionTimeout);
+
+		if( (currState == STATE_CONNECTED_PARSE_STATUS_CODE) && scanStatusLineByte(netClientIn, rxByte) )
+		{
+			// status code MUST be the first line received from the server...
+			uint16_t statusCode;
+			if( !parseStatusCodeFromString(netClientIn->headerScan.line, &statusCode) )
+			{
+				cxa_logger_warn(&netClientIn->logger, "invalid status line received");
+				cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
+				return;
+			}
+
+			netClientIn->responseStatusCode = statusCode;
+			netClientIn->lastTiming.firstByte_ms = cxa_timeDiff_getElapsedTime_ms(&netClientIn->td_request);
+			cxa_logger_debug(&netClientIn->logger, "got status code: %d", netClientIn->responseStatusCode);
+			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_PARSE_HEADERS);
+			return;
+		}
+		else if( (currState == STATE_CONNECTED_PARSE_HEADERS) && scanHeaderByte(netClientIn, rxByte) )
+		{
+			if( !netClientIn->isResponseChunked && !netClientIn->hasResponseContentLength )
+			{
+				cxa_logger_warn(&netClientIn->logger, "end of headers before content length received");
+				cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
+				return;
+			}
+			if( !beginResponseBody(netClientIn) )
+			{
+				cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
+				return;
+			}
+
+			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_READ_BODY);
+			return;
+		}
+	}
+
 	if( cxa_timeDiff_isElapsed_ms(&netClientIn->td_receptionTimeout, netClientIn->timeout_ms) )
 	{
 		cxa_logger_warn(&netClientIn->logger, "reception timeout");
 		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
 		return;
 	}
-}
 
-
-
-static void stateCb_parseContentLength_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
-{
-	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
-	cxa_assert(netClientIn);
-
-	cxa_logger_debug(&netClientIn->logger, "waiting for content length");
-	cxa_timeDiff_setStartTime_now(&netClientIn->td_receptionTimeout);
-
-	// header parser should still be on at this point
-	// wait for protocol parser callbacks
+	continueReading(netClientIn, readState);
 }
 
 
-static void stateCb_forwardToBody_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
+static void stateCb_parseHeaders_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
 {
 	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
-	cxa_logger_debug(&netClientIn->logger, "waiting for start of body");
+	cxa_logger_debug(&netClientIn->logger, "waiting for end of headers");
 	cxa_timeDiff_setStartTime_now(&netClientIn->td_receptionTimeout);
 
-	// wait for protocol parser callbacks
+	resetHeaderScan(netClientIn);
 }
 
 
@@ -395,16 +1093,24 @@ static void stateCb_readBody_enter(cxa_stateMachine_t *const smIn, int prevState
 
 	// reset our response body buffer
 	netClientIn->responseBody_currSize_bytes = 0;
+	netClientIn->chunkBuffer_numBytes = 0;
 	if(netClientIn->responseBodyBuffer != NULL) memset(netClientIn->responseBodyBuffer, 0, netClientIn->responseBody_maxSize_bytes);
 	cxa_timeDiff_setStartTime_now(&netClientIn->td_receptionTimeout);
 
+	if( netClientIn->isResponseChunked )
+	{
+		cxa_logger_debug(&netClientIn->logger, "expecting chunked body");
+		netClientIn->responseChunkState = CHUNKSTATE_SIZE;
+		netClientIn->responseChunk_remainingBytes = 0;
+		return;
+	}
+
 	cxa_logger_debug(&netClientIn->logger, "expecting body of %d bytes", netClientIn->responseContentLength_bytes);
 
 	// make sure we have a body to receive
 	if( netClientIn->responseContentLength_bytes == 0 )
 	{
-		cxa_logger_debug(&netClientIn->logger, "done reading body");
-		cxa_stateMachine_transition(&netClientIn->stateMachine, netClientIn->keepOpen ? STATE_IDLE_CONNECTED : STATE_IDLE_DISCONNECTED);
+		completeTransaction(netClientIn);
 		return;
 	}
 }
@@ -415,10 +1121,11 @@ static void stateCb_readBody_state(cxa_stateMachine_t *const smIn, void *userVar
 	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
+	cxa_ioStream_readStatus_t readState = CXA_IOSTREAM_READSTAT_NODATA;
 	for( int i = 0; i < MAXNUM_RX_BYTES_PER_ITERATION; i++ )
 	{
 		uint8_t rxByte;
-		cxa_ioStream_readStatus_t readState = cxa_ioStream_readByte(cxa_network_tcpClient_getIoStream(netClientIn->tcpClient), &rxByte);
+		readState = cxa_ioStream_readByte(cxa_network_tcpClient_getIoStream(netClientIn->tcpClient), &rxByte);
 		if( readState == CXA_IOSTREAM_READSTAT_ERROR )
 		{
 			cxa_logger_warn(&netClientIn->logger, "error reading body");
@@ -430,39 +1137,26 @@ static void stateCb_readBody_state(cxa_stateMachine_t *const smIn, void *userVar
 			// reset our reception timeout
 			cxa_timeDiff_setStartTime_now(&netClientIn->td_receptionTimeout);
 
-			// store to our buffer if we have one
-			if( netClientIn->responseBodyBuffer != NULL )
+			bodyStatus_t bodyStat;
+			if( netClientIn->isResponseChunked )
 			{
-				netClientIn->responseBodyBuffer[netClientIn->responseBody_currSize_bytes] = rxByte;
+				bodyStat = processChunkedBodyByte(netClientIn, rxByte);
 			}
-			netClientIn->responseBody_currSize_bytes++;
-
-			// see if we're done
-			if( netClientIn->responseBody_currSize_bytes == netClientIn->responseContentLength_bytes )
+			else
 			{
-				// we're done!
-				cxa_logger_debug(&netClientIn->logger, "done reading body (%d bytes) %d", netClientIn->responseBody_currSize_bytes);
-
-				// null term our body for ease-of-use
-				if( netClientIn->responseBodyBuffer != NULL ) netClientIn->responseBodyBuffer[netClientIn->responseBody_currSize_bytes] = '\0';
-
-				// call our callback (if any)
-				if( netClientIn->cbs.postComplete != NULL )
-				{
-					netClientIn->cbs.postComplete(netClientIn, true, netClientIn->responseStatusCode, (char*)netClientIn->responseBodyBuffer, netClientIn->responseBody_currSize_bytes, netClientIn->cbs.userVar);
-				}
+				bodyStat = !storeBodyByte(netClientIn, rxByte) ? BODYSTAT_ERROR :
+						   (netClientIn->responseBody_currSize_bytes == netClientIn->responseContentLength_bytes) ? BODYSTAT_DONE :
+						   BODYSTAT_CONTINUE;
+			}
 
-				// move on
-				cxa_stateMachine_transition(&netClientIn->stateMachine, netClientIn->keepOpen ? STATE_IDLE_CONNECTED : STATE_IDLE_DISCONNECTED);
+			if( bodyStat == BODYSTAT_DONE )
+			{
+				completeTransaction(netClientIn);
 				return;
 			}
-			// if we made it here, we've got more bytes to receive
-
-			// make sure we won't overflow (-1 is for null term)
-			if( (netClientIn->responseBodyBuffer != NULL) &&
-				(netClientIn->responseBody_currSize_bytes >= (netClientIn->responseBody_maxSize_bytes-1)) )
+			else if( bodyStat == BODYSTAT_ERROR )
 			{
-				cxa_logger_warn(&netClientIn->logger, "body too big for response buffer");
+				cxa_logger_warn(&netClientIn->logger, "body too big for response buffer, malformed, or aborted");
 				cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
 				return;
 			}
@@ -476,6 +1170,16 @@ static void stateCb_readBody_state(cxa_stateMachine_t *const smIn, void *userVar
 			return;
 		}
 	}
+
+	// hand over whatever arrived this iteration
+	if( !flushStreamedBody(netClientIn) )
+	{
+		cxa_logger_warn(&netClientIn->logger, "aborted by body callback");
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
+		return;
+	}
+
+	continueReading(netClientIn, readState);
 }
 
 
@@ -497,9 +1201,9 @@ static void stateCb_waitDisconnect_state(cxa_stateMachine_t *const smIn, void *u
 	cxa_assert(netClientIn);
 
 	// transition can happen here OR in tcpClient callback
-	if( cxa_network_tcpClient_isConnected(netClientIn->tcpClient) )
+	if( !cxa_network_tcpClient_isConnected(netClientIn->tcpClient) )
 	{
-		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_IDLE_DISCONNECTED);
+		cxa_stateMachine_transition(&netClientIn->stateMachine, netClientIn->reconnectAfterDisconnect ? STATE_CONNECTING : STATE_IDLE_DISCONNECTED);
 	}
 }
 
@@ -509,10 +1213,40 @@ static void stateCb_transactionError_enter(cxa_stateMachine_t *const smIn, int p
 	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
+	netClientIn->lastTiming.total_ms = cxa_timeDiff_getElapsedTime_ms(&netClientIn->td_request);
+
+	// keep whatever (valid) body we received before the failure
+	if( netClientIn->download.isWritingToSink ) flushStreamedBody(netClientIn);
+
+	if( (netClientIn->download.sink != NULL) && netClientIn->download.isResumable )
+	{
+		// only give up if we keep failing without making any progress
+		if( netClientIn->download.offset_bytes != netClientIn->download.attemptOffset_bytes )
+		{
+			netClientIn->download.numResumesRemaining = CXA_NETWORK_HTTPCLIENT_DOWNLOAD_MAXNUM_RESUMES;
+		}
+
+		if( netClientIn->download.numResumesRemaining > 0 )
+		{
+			netClientIn->download.numResumesRemaining--;
+			netClientIn->download.attemptOffset_bytes = netClientIn->download.offset_bytes;
+			netClientIn->download.isWritingToSink = false;
+			cxa_logger_info(&netClientIn->logger, "resuming download at %lu bytes", (unsigned long)netClientIn->download.offset_bytes);
+
+			netClientIn->reconnectAfterDisconnect = true;
+			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_WAIT_DISCONNECT);
+			return;
+		}
+	}
+
 	if( netClientIn->cbs.postComplete != NULL )
 	{
 		netClientIn->cbs.postComplete(netClientIn, false, 0, NULL, 0, netClientIn->cbs.userVar);
 	}
+	if( netClientIn->download.cb_onComplete != NULL )
+	{
+		netClientIn->download.cb_onComplete(netClientIn, false, 0, netClientIn->download.offset_bytes, netClientIn->cbs.userVar);
+	}
 }
 
 
@@ -521,6 +1255,8 @@ static void cb_tcpClient_onConnect(cxa_network_tcpClient_t *const superIn, void*
 	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
+	cxa_network_tcpClient_getConnectTiming(netClientIn->tcpClient, &netClientIn->lastTiming.connect_ms, &netClientIn->lastTiming.tls_ms);
+
 	cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_SEND_DEFAULT_HEADERS);
 }
 
@@ -548,6 +1284,10 @@ static void cb_tcpClient_onDisconnect(cxa_network_tcpClient_t *const superIn, vo
 
 		case STATE_WAIT_DISCONNECT:
 		case STATE_TRANSACTION_ERROR:
+			// a download may be resuming
+			cxa_stateMachine_transition(&netClientIn->stateMachine, netClientIn->reconnectAfterDisconnect ? STATE_CONNECTING : STATE_IDLE_DISCONNECTED);
+			break;
+
 		case STATE_IDLE_CONNECTED:
 			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_IDLE_DISCONNECTED);
 			break;
@@ -558,94 +1298,50 @@ static void cb_tcpClient_onDisconnect(cxa_network_tcpClient_t *const superIn, vo
 		case STATE_CONNECTED_GEN_USER_HEADERS:
 		case STATE_CONNECTED_GEN_USER_BODY:
 		case STATE_CONNECTED_PARSE_STATUS_CODE:
-		case STATE_CONNECTED_PARSE_CONTENT_LENGTH:
-		case STATE_CONNECTED_FORWARD_TO_BODY:
+		case STATE_CONNECTED_PARSE_HEADERS:
 		case STATE_CONNECTED_READ_BODY:
-			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
+			// a completed response has already been reported...just don't stay connected
+			cxa_stateMachine_transition(&netClientIn->stateMachine, netClientIn->isResponseComplete ? STATE_IDLE_DISCONNECTED : STATE_TRANSACTION_ERROR);
 			break;
 	}
 }
 
 
-static void cb_headerParser_onIoException(void *const userVarIn)
+static void cb_tcpClient_onDataAvailable(cxa_ioStream_t *const ioStreamIn, void *const userVarIn)
 {
 	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
-	cxa_logger_warn(&netClientIn->logger, "ioException");
-	cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
+	cxa_stateMachine_kick(&netClientIn->stateMachine);
 }
 
 
-static void cb_headerParser_onReceptionTimeout(cxa_fixedByteBuffer_t *const incompletePacketIn, void *const userVarIn)
+static cxa_ioStream_readStatus_t cb_chunkedBody_readByte(uint8_t *const byteOut, void *const userVarIn)
 {
-	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
-	cxa_assert(netClientIn);
-
-	cxa_logger_warn(&netClientIn->logger, "reception timeout");
-//	cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
+	// body generation is write-only
+	return CXA_IOSTREAM_READSTAT_NODATA;
 }
 
 
-static void cb_headerParser_onPacketReceived(cxa_fixedByteBuffer_t *const packetIn, void *const userVarIn)
+static bool cb_chunkedBody_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_network_httpClient_t *const netClientIn = (cxa_network_httpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
-	state_t currState = cxa_stateMachine_getCurrentState(&netClientIn->stateMachine);
-	char *const currLine = (char *const)cxa_fixedByteBuffer_get_pointerToIndex(packetIn, 0);
+	uint8_t* currByte = (uint8_t*)buffIn;
+	while( bufferSize_bytesIn > 0 )
+	{
+		size_t numBytesToCopy = sizeof(netClientIn->chunkBuffer) - netClientIn->chunkBuffer_numBytes;
+		if( numBytesToCopy > bufferSize_bytesIn ) numBytesToCopy = bufferSize_bytesIn;
 
-	cxa_logger_trace(&netClientIn->logger, "rx header: '%s'", currLine);
+		memcpy(&netClientIn->chunkBuffer[netClientIn->chunkBuffer_numBytes], currByte, numBytesToCopy);
+		netClientIn->chunkBuffer_numBytes += numBytesToCopy;
+		currByte += numBytesToCopy;
+		bufferSize_bytesIn -= numBytesToCopy;
 
-	if( currState == STATE_CONNECTED_PARSE_STATUS_CODE )
-	{
-		// we've received the line that should contain the status code...now try to parse the status code
-		uint16_t statusCode;
-		if( parseStatusCodeFromString(currLine, &statusCode) )
-		{
-			netClientIn->responseStatusCode = statusCode;
-			cxa_logger_debug(&netClientIn->logger, "got status code: %d", netClientIn->responseStatusCode);
-			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_PARSE_CONTENT_LENGTH);
-			return;
-		}
-		else
-		{
-			// status code MUST be the first line received from the server...
-			cxa_logger_warn(&netClientIn->logger, "invalid status line received");
-			cxa_protocolParser_crlf_pause(&netClientIn->headerLineParser);
-			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
-			return;
-		}
+		// send full chunks as we go
+		if( (netClientIn->chunkBuffer_numBytes == sizeof(netClientIn->chunkBuffer)) && !writeChunk(netClientIn) ) return false;
 	}
-	else if( currState == STATE_CONNECTED_PARSE_CONTENT_LENGTH )
-	{
-		// always look for end of headers
-		if( strlen(currLine) == 0 )
-		{
-			cxa_logger_warn(&netClientIn->logger, "end of headers before content length received");
-			cxa_protocolParser_crlf_pause(&netClientIn->headerLineParser);
-			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_TRANSACTION_ERROR);
-			return;
-		}
 
-		// see if we can parse the content length from this line...
-		size_t contentLength_bytes;
-		if( parseContentLengthFromString(currLine, &contentLength_bytes) )
-		{
-			netClientIn->responseContentLength_bytes = contentLength_bytes;
-			cxa_logger_debug(&netClientIn->logger, "expecting %d bytes", netClientIn->responseContentLength_bytes);
-			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_FORWARD_TO_BODY);
-			return;
-		}
-	}
-	else if( currState == STATE_CONNECTED_FORWARD_TO_BODY )
-	{
-		if( strlen(currLine) == 0 )
-		{
-			// looking for crlf line
-			cxa_protocolParser_crlf_pause(&netClientIn->headerLineParser);
-			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED_READ_BODY);
-			return;
-		}
-	}
+	return true;
 }
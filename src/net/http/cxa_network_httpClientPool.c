@@ -0,0 +1,390 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_network_httpClientPool.h"
+
+
+// ******** includes ********
+#include <string.h>
+
+#include <cxa_assert.h>
+#include <cxa_runLoop.h>
+#include <cxa_stringUtils.h>
+
+#define CXA_LOG_LEVEL CXA_LOG_LEVEL_TRACE
+#include <cxa_logger_implementation.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static bool queueRequest(cxa_network_httpClientPool_t *const poolIn, cxa_network_httpClientPool_method_t methodIn,
+						 const char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+						 const char *const urlIn, uint32_t timeout_msIn,
+						 cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+						 cxa_network_httpClient_cb_postAsyncGenBody_t cb_genBodyIn,
+						 cxa_network_httpClient_cb_onPostComplete_t cb_completeIn,
+						 uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+						 void* userVarIn);
+static cxa_network_httpClientPool_slot_t* getSlotForRequest(cxa_network_httpClientPool_t *const poolIn, cxa_network_httpClientPool_request_t *const requestIn, bool hitsOnlyIn, bool *const isHitOut);
+static void startRequest(cxa_network_httpClientPool_t *const poolIn, cxa_network_httpClientPool_slot_t *const slotIn, cxa_network_httpClientPool_request_t *const requestIn, bool isHitIn);
+
+static void cb_onRunLoopUpdate(void* userVarIn);
+
+static bool cb_genHeaders(cxa_network_httpClient_t *const clientIn, cxa_ioStream_t *const iosIn, void* userVarIn);
+static bool cb_genBody(cxa_network_httpClient_t *const clientIn, cxa_ioStream_t *const iosIn, void* userVarIn);
+static void cb_postComplete(cxa_network_httpClient_t *const clientIn, bool didCompleteSuccessfullyIn,
+							uint16_t statusIn, char *const bodyIn, size_t bodySize_bytesIn,
+							void* userVarIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_network_httpClientPool_init(cxa_network_httpClientPool_t *const poolIn, int threadIdIn)
+{
+	cxa_assert(poolIn);
+
+	cxa_logger_init(&poolIn->logger, "httpPool");
+
+	for( size_t i = 0; i < CXA_NETWORK_HTTPCLIENTPOOL_MAXNUM_CLIENTS; i++ )
+	{
+		cxa_network_httpClientPool_slot_t* currSlot = &poolIn->slots[i];
+
+		currSlot->parent = poolIn;
+		currSlot->isBusy = false;
+		currSlot->wasHit = false;
+		cxa_timeDiff_init(&currSlot->td_lastUsed);
+		cxa_network_httpClient_init(&currSlot->client, threadIdIn);
+	}
+
+	cxa_array_initStd(&poolIn->requestQueue, poolIn->requestQueue_raw);
+	cxa_network_httpClientPool_resetStats(poolIn);
+
+	poolIn->runLoopEntry = cxa_runLoop_addEntry(threadIdIn, NULL, cb_onRunLoopUpdate, (void*)poolIn);
+}
+
+
+bool cxa_network_httpClientPool_post_async(cxa_network_httpClientPool_t *const poolIn,
+										   const char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+										   const char *const urlIn, uint32_t timeout_msIn,
+										   cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+										   cxa_network_httpClient_cb_postAsyncGenBody_t cb_genBodyIn,
+										   cxa_network_httpClient_cb_onPostComplete_t cb_postCompleteIn,
+										   uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+										   void* userVarIn)
+{
+	return queueRequest(poolIn, CXA_NETWORK_HTTPCLIENTPOOL_METHOD_POST, hostNameIn, portNumIn, useTlsIn, urlIn, timeout_msIn,
+						cb_genHeadersIn, cb_genBodyIn, cb_postCompleteIn, responseBodyBufferIn, responseBody_maxSize_bytesIn, userVarIn);
+}
+
+
+bool cxa_network_httpClientPool_put_async(cxa_network_httpClientPool_t *const poolIn,
+										  const char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+										  const char *const urlIn, uint32_t timeout_msIn,
+										  cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+										  cxa_network_httpClient_cb_postAsyncGenBody_t cb_genBodyIn,
+										  cxa_network_httpClient_cb_onPostComplete_t cb_putCompleteIn,
+										  uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+										  void* userVarIn)
+{
+	return queueRequest(poolIn, CXA_NETWORK_HTTPCLIENTPOOL_METHOD_PUT, hostNameIn, portNumIn, useTlsIn, urlIn, timeout_msIn,
+						cb_genHeadersIn, cb_genBodyIn, cb_putCompleteIn, responseBodyBufferIn, responseBody_maxSize_bytesIn, userVarIn);
+}
+
+
+bool cxa_network_httpClientPool_get_async(cxa_network_httpClientPool_t *const poolIn,
+										  const char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+										  const char *const urlIn, uint32_t timeout_msIn,
+										  cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+										  cxa_network_httpClient_cb_onPostComplete_t cb_getCompleteIn,
+										  uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+										  void* userVarIn)
+{
+	return queueRequest(poolIn, CXA_NETWORK_HTTPCLIENTPOOL_METHOD_GET, hostNameIn, portNumIn, useTlsIn, urlIn, timeout_msIn,
+						cb_genHeadersIn, NULL, cb_getCompleteIn, responseBodyBufferIn, responseBody_maxSize_bytesIn, userVarIn);
+}
+
+
+void cxa_network_httpClientPool_setUseChunkedRequests(cxa_network_httpClientPool_t *const poolIn, bool useChunkedRequestsIn)
+{
+	cxa_assert(poolIn);
+
+	for( size_t i = 0; i < CXA_NETWORK_HTTPCLIENTPOOL_MAXNUM_CLIENTS; i++ )
+	{
+		cxa_network_httpClient_setUseChunkedRequests(&poolIn->slots[i].client, useChunkedRequestsIn);
+	}
+}
+
+
+size_t cxa_network_httpClientPool_getQueueDepth(cxa_network_httpClientPool_t *const poolIn)
+{
+	cxa_assert(poolIn);
+
+	return cxa_array_getSize_elems(&poolIn->requestQueue);
+}
+
+
+uint8_t cxa_network_httpClientPool_getHitRate_pct(cxa_network_httpClientPool_t *const poolIn)
+{
+	cxa_assert(poolIn);
+
+	if( poolIn->stats.numRequests == 0 ) return 0;
+	return (uint8_t)(((uint64_t)poolIn->stats.numPoolHits * 100) / poolIn->stats.numRequests);
+}
+
+
+cxa_network_httpClientPool_stats_t* cxa_network_httpClientPool_getStats(cxa_network_httpClientPool_t *const poolIn)
+{
+	cxa_assert(poolIn);
+
+	return &poolIn->stats;
+}
+
+
+void cxa_network_httpClientPool_resetStats(cxa_network_httpClientPool_t *const poolIn)
+{
+	cxa_assert(poolIn);
+
+	memset(&poolIn->stats, 0, sizeof(poolIn->stats));
+}
+
+
+// ******** local function implementations ********
+static bool queueRequest(cxa_network_httpClientPool_t *const poolIn, cxa_network_httpClientPool_method_t methodIn,
+						 const char *const hostNameIn, uint16_t portNumIn, bool useTlsIn,
+						 const char *const urlIn, uint32_t timeout_msIn,
+						 cxa_network_httpClient_cb_asyncGenHeaders_t cb_genHeadersIn,
+						 cxa_network_httpClient_cb_postAsyncGenBody_t cb_genBodyIn,
+						 cxa_network_httpClient_cb_onPostComplete_t cb_completeIn,
+						 uint8_t *const responseBodyBufferIn, size_t responseBody_maxSize_bytesIn,
+						 void* userVarIn)
+{
+	cxa_assert(poolIn);
+	cxa_assert(hostNameIn);
+	cxa_assert(urlIn);
+	if( responseBody_maxSize_bytesIn > 0 ) cxa_assert(responseBodyBufferIn);
+
+	cxa_network_httpClientPool_request_t* newRequest = (cxa_network_httpClientPool_request_t*)cxa_array_append_empty(&poolIn->requestQueue);
+	if( newRequest == NULL )
+	{
+		cxa_logger_warn(&poolIn->logger, "request queue full");
+		poolIn->stats.numRejected++;
+		return false;
+	}
+
+	newRequest->method = methodIn;
+	cxa_assert(cxa_stringUtils_copy(newRequest->hostname, hostNameIn, sizeof(newRequest->hostname)));
+	cxa_assert(cxa_stringUtils_copy(newRequest->url, urlIn, sizeof(newRequest->url)));
+	newRequest->portNum = portNumIn;
+	newRequest->useTls = useTlsIn;
+	newRequest->timeout_ms = timeout_msIn;
+
+	newRequest->cb_genHeaders = cb_genHeadersIn;
+	newRequest->cb_genBody = cb_genBodyIn;
+	newRequest->cb_postComplete = cb_completeIn;
+	newRequest->userVar = userVarIn;
+
+	newRequest->responseBodyBuffer = responseBodyBufferIn;
+	newRequest->responseBody_maxSize_bytes = responseBody_maxSize_bytesIn;
+
+	size_t queueDepth = cxa_array_getSize_elems(&poolIn->requestQueue);
+	if( queueDepth > poolIn->stats.maxQueueDepth ) poolIn->stats.maxQueueDepth = queueDepth;
+
+	// dispatched in our runLoop update
+	cxa_runLoop_entry_resume(poolIn->runLoopEntry);
+	return true;
+}
+
+
+static cxa_network_httpClientPool_slot_t* getSlotForRequest(cxa_network_httpClientPool_t *const poolIn, cxa_network_httpClientPool_request_t *const requestIn, bool hitsOnlyIn, bool *const isHitOut)
+{
+	cxa_assert(poolIn);
+	cxa_assert(requestIn);
+	cxa_assert(isHitOut);
+
+	cxa_network_httpClientPool_slot_t* disconnectedSlot = NULL;
+	cxa_network_httpClientPool_slot_t* lruSlot = NULL;
+	uint32_t lruIdleTime_ms = 0;
+
+	for( size_t i = 0; i < CXA_NETWORK_HTTPCLIENTPOOL_MAXNUM_CLIENTS; i++ )
+	{
+		cxa_network_httpClientPool_slot_t* currSlot = &poolIn->slots[i];
+		if( currSlot->isBusy || !cxa_network_httpClient_isIdle(&currSlot->client) ) continue;
+
+		// best case, we already have a connection
+		if( cxa_network_httpClient_isConnectedTo(&currSlot->client, requestIn->hostname, requestIn->portNum, requestIn->useTls) )
+		{
+			*isHitOut = true;
+			return currSlot;
+		}
+
+		if( !cxa_network_tcpClient_isConnected(currSlot->client.tcpClient) )
+		{
+			if( disconnectedSlot == NULL ) disconnectedSlot = currSlot;
+			continue;
+		}
+
+		uint32_t currIdleTime_ms = cxa_timeDiff_getElapsedTime_ms(&currSlot->td_lastUsed);
+		if( (lruSlot == NULL) || (currIdleTime_ms > lruIdleTime_ms) )
+		{
+			lruSlot = currSlot;
+			lruIdleTime_ms = currIdleTime_ms;
+		}
+	}
+
+	*isHitOut = false;
+	if( hitsOnlyIn ) return NULL;
+	return (disconnectedSlot != NULL) ? disconnectedSlot : lruSlot;
+}
+
+
+static void startRequest(cxa_network_httpClientPool_t *const poolIn, cxa_network_httpClientPool_slot_t *const slotIn, cxa_network_httpClientPool_request_t *const requestIn, bool isHitIn)
+{
+	cxa_assert(poolIn);
+	cxa_assert(slotIn);
+	cxa_assert(requestIn);
+
+	poolIn->stats.numRequests++;
+	if( isHitIn ) poolIn->stats.numPoolHits++;
+	else if( cxa_network_tcpClient_isConnected(slotIn->client.tcpClient) ) poolIn->stats.numEvictions++;
+
+	cxa_logger_debug(&poolIn->logger, "%s %s::%d%s", isHitIn ? "hit" : "miss", requestIn->hostname, requestIn->portNum, requestIn->url);
+
+	memcpy(&slotIn->request, requestIn, sizeof(slotIn->request));
+	slotIn->isBusy = true;
+	slotIn->wasHit = isHitIn;
+
+	cxa_network_httpClientPool_request_t* req = &slotIn->request;
+	switch( req->method )
+	{
+		case CXA_NETWORK_HTTPCLIENTPOOL_METHOD_GET:
+			cxa_network_httpClient_get_async(&slotIn->client, req->hostname, req->portNum, req->useTls, req->url, req->timeout_ms, true,
+											 cb_genHeaders, cb_postComplete,
+											 req->responseBodyBuffer, req->responseBody_maxSize_bytes, (void*)slotIn);
+			break;
+
+		case CXA_NETWORK_HTTPCLIENTPOOL_METHOD_POST:
+			cxa_network_httpClient_post_async(&slotIn->client, req->hostname, req->portNum, req->useTls, req->url, req->timeout_ms, true,
+											  cb_genHeaders, cb_genBody, cb_postComplete,
+											  req->responseBodyBuffer, req->responseBody_maxSize_bytes, (void*)slotIn);
+			break;
+
+		case CXA_NETWORK_HTTPCLIENTPOOL_METHOD_PUT:
+			cxa_network_httpClient_put_async(&slotIn->client, req->hostname, req->portNum, req->useTls, req->url, req->timeout_ms, true,
+											 cb_genHeaders, cb_genBody, cb_postComplete,
+											 req->responseBodyBuffer, req->responseBody_maxSize_bytes, (void*)slotIn);
+			break;
+	}
+}
+
+
+static void cb_onRunLoopUpdate(void* userVarIn)
+{
+	cxa_network_httpClientPool_t* poolIn = (cxa_network_httpClientPool_t*)userVarIn;
+	cxa_assert(poolIn);
+
+	// first pass: requests that can reuse an open connection (so we don't
+	// evict a connection that a later request in the queue could use)
+	size_t currIndex = 0;
+	while( currIndex < cxa_array_getSize_elems(&poolIn->requestQueue) )
+	{
+		cxa_network_httpClientPool_request_t* currRequest = (cxa_network_httpClientPool_request_t*)cxa_array_get(&poolIn->requestQueue, currIndex);
+		cxa_assert(currRequest);
+
+		bool isHit;
+		cxa_network_httpClientPool_slot_t* targetSlot = getSlotForRequest(poolIn, currRequest, true, &isHit);
+		if( targetSlot == NULL )
+		{
+			currIndex++;
+			continue;
+		}
+
+		startRequest(poolIn, targetSlot, currRequest, isHit);
+		cxa_array_remove_atIndex(&poolIn->requestQueue, currIndex);
+	}
+
+	// second pass: remaining requests in order, on any idle client
+	while( !cxa_array_isEmpty(&poolIn->requestQueue) )
+	{
+		cxa_network_httpClientPool_request_t* currRequest = (cxa_network_httpClientPool_request_t*)cxa_array_get(&poolIn->requestQueue, 0);
+		cxa_assert(currRequest);
+
+		bool isHit;
+		cxa_network_httpClientPool_slot_t* targetSlot = getSlotForRequest(poolIn, currRequest, false, &isHit);
+		if( targetSlot == NULL ) break;
+
+		startRequest(poolIn, targetSlot, currRequest, isHit);
+		cxa_array_remove_atIndex(&poolIn->requestQueue, 0);
+	}
+
+	// keep checking for a free client while requests are waiting, otherwise
+	// sleep until the next one is queued
+	if( cxa_array_isEmpty(&poolIn->requestQueue) ) cxa_runLoop_entry_suspend(poolIn->runLoopEntry);
+}
+
+
+static bool cb_genHeaders(cxa_network_httpClient_t *const clientIn, cxa_ioStream_t *const iosIn, void* userVarIn)
+{
+	cxa_network_httpClientPool_slot_t* slotIn = (cxa_network_httpClientPool_slot_t*)userVarIn;
+	cxa_assert(slotIn);
+
+	return (slotIn->request.cb_genHeaders != NULL) ?
+			slotIn->request.cb_genHeaders(clientIn, iosIn, slotIn->request.userVar) :
+			false;
+}
+
+
+static bool cb_genBody(cxa_network_httpClient_t *const clientIn, cxa_ioStream_t *const iosIn, void* userVarIn)
+{
+	cxa_network_httpClientPool_slot_t* slotIn = (cxa_network_httpClientPool_slot_t*)userVarIn;
+	cxa_assert(slotIn);
+
+	return (slotIn->request.cb_genBody != NULL) ?
+			slotIn->request.cb_genBody(clientIn, iosIn, slotIn->request.userVar) :
+			false;
+}
+
+
+static void cb_postComplete(cxa_network_httpClient_t *const clientIn, bool didCompleteSuccessfullyIn,
+							uint16_t statusIn, char *const bodyIn, size_t bodySize_bytesIn,
+							void* userVarIn)
+{
+	cxa_network_httpClientPool_slot_t* slotIn = (cxa_network_httpClientPool_slot_t*)userVarIn;
+	cxa_assert(slotIn);
+	cxa_network_httpClientPool_t* poolIn = slotIn->parent;
+	cxa_assert(poolIn);
+
+	// record our stats
+	if( didCompleteSuccessfullyIn )
+	{
+		cxa_network_httpClient_timing_t* timing = cxa_network_httpClient_getLastTiming(clientIn);
+		poolIn->stats.numSuccesses++;
+		poolIn->stats.sumConnect_ms += timing->connect_ms;
+		poolIn->stats.sumTls_ms += timing->tls_ms;
+		poolIn->stats.sumFirstByte_ms += timing->firstByte_ms;
+		poolIn->stats.sumTotal_ms += timing->total_ms;
+	}
+	else
+	{
+		cxa_logger_warn(&poolIn->logger, "request to %s failed (%s connection)", slotIn->request.hostname, slotIn->wasHit ? "reused" : "new");
+		poolIn->stats.numFailures++;
+	}
+
+	// slot is available again once the client has returned to idle
+	slotIn->isBusy = false;
+	cxa_timeDiff_setStartTime_now(&slotIn->td_lastUsed);
+
+	if( slotIn->request.cb_postComplete != NULL )
+	{
+		slotIn->request.cb_postComplete(clientIn, didCompleteSuccessfullyIn, statusIn, bodyIn, bodySize_bytesIn, slotIn->request.userVar);
+	}
+}
@@ -10,7 +10,13 @@
 // ******** includes ********
 #include <stdbool.h>
 
+#include <cxa_assert.h>
 #include <cxa_config.h>
+#include <cxa_network_dnsCache.h>
+
+#include <lwip/dns.h>
+#include <lwip/ip_addr.h>
+#include <lwip/tcpip.h>
 
 
 // ******** local macro definitions ********
@@ -50,7 +56,10 @@ typedef struct
 
 
 // ******** local function prototypes ********
-static void cxa_network_factory_init(void);
+static void cxa_network_factory_init(int threadIdIn);
+
+static bool scm_startDnsResolve(cxa_network_dnsCache_entry_t *const entryIn, const char *const hostNameIn);
+static void cb_lwip_onDnsFound(const char *nameIn, const ip_addr_t *ipAddrIn, void *userVarIn);
 
 
 // ********  local variable declarations *********
@@ -68,7 +77,7 @@ static tcpServer_entry_t tcpServerMap[CXA_LWIPMBEDTLS_MAXNUM_TCP_SERVERS];
 // ******** global function implementations ********
 cxa_network_tcpClient_t* cxa_network_factory_reserveTcpClient(int threadIdIn)
 {
-	if( !isInit ) cxa_network_factory_init();
+	if( !isInit ) cxa_network_factory_init(threadIdIn);
 
 	cxa_network_tcpClient_t* retVal = NULL;
 
@@ -106,7 +115,7 @@ void cxa_network_factory_freeTcpClient(cxa_network_tcpClient_t *const clientIn)
 
 cxa_network_tcpServer_t* cxa_network_factory_reserveTcpServer(int threadIdIn)
 {
-	if( !isInit ) cxa_network_factory_init();
+	if( !isInit ) cxa_network_factory_init(threadIdIn);
 
 	cxa_network_tcpServer_t* retVal = NULL;
 
@@ -142,9 +151,19 @@ void cxa_network_factory_freeTcpServer(cxa_network_tcpServer_t *const serverIn)
 }
 
 
+bool cxa_network_factory_preResolveHost(int threadIdIn, const char *const hostNameIn)
+{
+	if( !isInit ) cxa_network_factory_init(threadIdIn);
+
+	return cxa_network_dnsCache_preResolve(hostNameIn);
+}
+
+
 // ******** local function implementations ********
-static void cxa_network_factory_init(void)
+static void cxa_network_factory_init(int threadIdIn)
 {
+	cxa_network_dnsCache_init(threadIdIn, scm_startDnsResolve);
+
 #if CXA_LWIPMBEDTLS_MAXNUM_TCP_CLIENTS > 0
 	for( size_t i = 0; i < (sizeof(tcpClientMap)/sizeof(*tcpClientMap)); i++ )
 	{
@@ -161,3 +180,39 @@ static void cxa_network_factory_init(void)
 
 	isInit = true;
 }
+
+
+static bool scm_startDnsResolve(cxa_network_dnsCache_entry_t *const entryIn, const char *const hostNameIn)
+{
+	cxa_assert(entryIn);
+	cxa_assert(hostNameIn);
+
+	ip_addr_t resolvedAddr;
+
+#if LWIP_TCPIP_CORE_LOCKING
+	LOCK_TCPIP_CORE();
+#endif
+	err_t err = dns_gethostbyname(hostNameIn, &resolvedAddr, cb_lwip_onDnsFound, (void*)entryIn);
+#if LWIP_TCPIP_CORE_LOCKING
+	UNLOCK_TCPIP_CORE();
+#endif
+
+	// answered from lwIP's own table (or a literal)
+	if( err == ERR_OK ) cb_lwip_onDnsFound(hostNameIn, &resolvedAddr, (void*)entryIn);
+
+	return (err == ERR_OK) || (err == ERR_INPROGRESS);
+}
+
+
+static void cb_lwip_onDnsFound(const char *nameIn, const ip_addr_t *ipAddrIn, void *userVarIn)
+{
+	cxa_network_dnsCache_entry_t* entryIn = (cxa_network_dnsCache_entry_t*)userVarIn;
+	cxa_assert(entryIn);
+
+	// note: this is called from the tcpip thread
+	char address[CXA_NETWORK_DNSCACHE_MAXADDRESSLEN_BYTES+1];
+	bool didConvert = (ipAddrIn != NULL) && (ipaddr_ntoa_r(ipAddrIn, address, sizeof(address)) != NULL);
+
+	// lwIP doesn't expose the record TTL...use the default
+	cxa_network_dnsCache_entry_setResult(entryIn, nameIn, didConvert ? address : NULL, 0);
+}
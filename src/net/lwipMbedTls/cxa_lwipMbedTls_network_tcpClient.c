@@ -11,6 +11,7 @@
 #include <string.h>
 
 #include <cxa_assert.h>
+#include <cxa_network_dnsCache.h>
 #include <cxa_numberUtils.h>
 #include <cxa_stringUtils.h>
 #include <cxa_uniqueId.h>
@@ -76,6 +77,8 @@ void cxa_lwipMbedTls_network_tcpClient_init(cxa_lwipMbedTls_network_tcpClient_t
 	netClientIn->targetHostName[0] = 0;
 	netClientIn->targetPortNum[0] = 0;
 	netClientIn->useClientCert = false;
+	netClientIn->rxBuffer.readIndex = 0;
+	netClientIn->rxBuffer.numBytes = 0;
 
 	cxa_timeDiff_init(&netClientIn->td_writeTimeout);
 
@@ -356,16 +359,34 @@ static void stateCb_connecting_state(cxa_stateMachine_t *const smIn, void *userV
 	cxa_lwipMbedTls_network_tcpClient_t* netClientIn = (cxa_lwipMbedTls_network_tcpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
+	// resolve through the cache so we never block the runLoop on DNS
+	// (the TLS hostname is still set from targetHostName)
+	char address[CXA_NETWORK_DNSCACHE_MAXADDRESSLEN_BYTES+1];
+	switch( cxa_network_dnsCache_lookup(netClientIn->targetHostName, address, sizeof(address)) )
+	{
+		case CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED:
+			break;
+
+		case CXA_NETWORK_DNSCACHE_LOOKUP_FAILED:
+			cxa_logger_warn(&netClientIn->super.logger, "resolve failed");
+			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
+			return;
+
+		default:
+			return;
+	}
+
 	if( netClientIn->useClientCert )
 	{
 		int tmpRet;
 		mbedtls_net_init(&netClientIn->tls.server_fd);
 
-		cxa_logger_info(&netClientIn->super.logger, "connecting to '%s:%s", netClientIn->targetHostName, netClientIn->targetPortNum);
-		tmpRet = mbedtls_net_connect(&netClientIn->tls.server_fd, netClientIn->targetHostName, netClientIn->targetPortNum, MBEDTLS_NET_PROTO_TCP);
+		cxa_logger_info(&netClientIn->super.logger, "connecting to '%s:%s' (%s)", netClientIn->targetHostName, netClientIn->targetPortNum, address);
+		tmpRet = mbedtls_net_connect(&netClientIn->tls.server_fd, address, netClientIn->targetPortNum, MBEDTLS_NET_PROTO_TCP);
 		if( tmpRet < 0 )
 		{
 			cxa_logger_warn(&netClientIn->super.logger, "connect failed: %d", tmpRet);
+			cxa_network_dnsCache_invalidate(netClientIn->targetHostName);
 			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
 			return;
 		}
@@ -373,6 +394,7 @@ static void stateCb_connecting_state(cxa_stateMachine_t *const smIn, void *userV
 		// set the byte IO callbacks for our context/descriptor
 		mbedtls_ssl_set_bio(&netClientIn->tls.sslContext, &netClientIn->tls.server_fd, mbedtls_net_send, mbedtls_net_recv, NULL);
 
+		cxa_network_tcpClient_notify_tlsHandshakeStarting(&netClientIn->super);
 		cxa_logger_trace(&netClientIn->super.logger, "performing TLS handshake");
 		while( (tmpRet = mbedtls_ssl_handshake(&netClientIn->tls.sslContext)) != 0 )
 		{
@@ -402,11 +424,12 @@ static void stateCb_connecting_state(cxa_stateMachine_t *const smIn, void *userV
 		int tmpRet;
 		mbedtls_net_init(&netClientIn->tls.server_fd);
 
-		cxa_logger_info(&netClientIn->super.logger, "connecting to '%s:%s", netClientIn->targetHostName, netClientIn->targetPortNum);
-		tmpRet = mbedtls_net_connect(&netClientIn->tls.server_fd, netClientIn->targetHostName, netClientIn->targetPortNum, MBEDTLS_NET_PROTO_TCP);
+		cxa_logger_info(&netClientIn->super.logger, "connecting to '%s:%s' (%s)", netClientIn->targetHostName, netClientIn->targetPortNum, address);
+		tmpRet = mbedtls_net_connect(&netClientIn->tls.server_fd, address, netClientIn->targetPortNum, MBEDTLS_NET_PROTO_TCP);
 		if( tmpRet < 0 )
 		{
 			cxa_logger_warn(&netClientIn->super.logger, "connect failed: %d", tmpRet);
+			cxa_network_dnsCache_invalidate(netClientIn->targetHostName);
 			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
 			return;
 		}
@@ -414,6 +437,7 @@ static void stateCb_connecting_state(cxa_stateMachine_t *const smIn, void *userV
 		// set the byte IO callbacks for our context/descriptor
 		mbedtls_ssl_set_bio(&netClientIn->tls.sslContext, &netClientIn->tls.server_fd, mbedtls_net_send, mbedtls_net_recv, NULL);
 
+		cxa_network_tcpClient_notify_tlsHandshakeStarting(&netClientIn->super);
 		cxa_logger_trace(&netClientIn->super.logger, "performing TLS handshake");
 		while( (tmpRet = mbedtls_ssl_handshake(&netClientIn->tls.sslContext)) != 0 )
 		{
@@ -445,6 +469,8 @@ static void stateCb_connected_enter(cxa_stateMachine_t *const smIn, int prevStat
 	}
 
 	// bind our ioStream
+	netClientIn->rxBuffer.readIndex = 0;
+	netClientIn->rxBuffer.numBytes = 0;
 	cxa_ioStream_bind(&netClientIn->super.ioStream, cb_ioStream_readByte, cb_ioStream_writeBytes, (void*)netClientIn);
 
 	cxa_logger_trace(&netClientIn->super.logger, "connected");
@@ -497,15 +523,26 @@ static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, vo
 	cxa_lwipMbedTls_network_tcpClient_t* netClientIn = (cxa_lwipMbedTls_network_tcpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
-	int tmpRet = mbedtls_ssl_read(&netClientIn->tls.sslContext, byteOut, 1);
-	if( (tmpRet < 0) && (tmpRet != MBEDTLS_ERR_SSL_WANT_READ) )
+	// refill our buffer (running the TLS read path once per record rather than once per byte)
+	if( netClientIn->rxBuffer.readIndex >= netClientIn->rxBuffer.numBytes )
 	{
-		cxa_logger_warn(&netClientIn->super.logger, "error during read: %d", tmpRet);
-		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_IDLE);
-		return CXA_IOSTREAM_READSTAT_ERROR;
+		int tmpRet = mbedtls_ssl_read(&netClientIn->tls.sslContext, netClientIn->rxBuffer.buffer, sizeof(netClientIn->rxBuffer.buffer));
+		if( (tmpRet < 0) && (tmpRet != MBEDTLS_ERR_SSL_WANT_READ) && (tmpRet != MBEDTLS_ERR_SSL_WANT_WRITE) )
+		{
+			cxa_logger_warn(&netClientIn->super.logger, "error during read: %d", tmpRet);
+			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_IDLE);
+			return CXA_IOSTREAM_READSTAT_ERROR;
+		}
+		if( tmpRet <= 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+		netClientIn->rxBuffer.readIndex = 0;
+		netClientIn->rxBuffer.numBytes = (size_t)tmpRet;
 	}
 
-	return (tmpRet > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_NODATA;
+	uint8_t rxByte = netClientIn->rxBuffer.buffer[netClientIn->rxBuffer.readIndex++];
+	if( byteOut != NULL ) *byteOut = rxByte;
+
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
 }
 
 
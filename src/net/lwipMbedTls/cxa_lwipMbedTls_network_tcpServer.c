@@ -26,7 +26,8 @@
 
 
 // ******** local macro definitions ********
-#define CONNECTION_BACKLOG			1
+// connections beyond our free clients wait here until a client frees up
+#define CONNECTION_BACKLOG			CXA_LWIPMBEDTLS_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS
 
 
 // ******** local type definitions ********
@@ -39,9 +40,9 @@ typedef enum
 
 
 // ******** local function prototypes ********
-static bool hasFreeConnectedClient(cxa_lwipMbedTls_network_tcpServer_t *const netServerIn);
-static bool reserveAndSetupFreeConnectedClient(cxa_lwipMbedTls_network_tcpServer_t *const netServerIn,
-												int socketIn, struct sockaddr_in * clientAddressIn);
+static cxa_lwipMbedTls_network_tcpServer_connectedClient_t* reserveFreeConnectedClient(cxa_lwipMbedTls_network_tcpServer_t *const netServerIn);
+static void releaseConnectedClient(cxa_lwipMbedTls_network_tcpServer_t *const netServerIn, cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn);
+static void acceptPendingConnections(cxa_lwipMbedTls_network_tcpServer_t *const netServerIn);
 static void closeAllSockets(cxa_lwipMbedTls_network_tcpServer_t *const netServerIn);
 
 static bool scm_listen(cxa_network_tcpServer_t *const superIn, uint16_t portNumIn);
@@ -52,6 +53,8 @@ static void stateCb_listen_state(cxa_stateMachine_t *const smIn, void *userVarIn
 static void stateCb_listen_leave(cxa_stateMachine_t *const smIn, int nextStateIdIn, void* userVarIn);
 static void stateCb_listenFail_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 
+static void cb_onConnectedClientUnbound(cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn, void* userVarIn);
+
 
 // ********  local variable declarations *********
 
@@ -61,10 +64,14 @@ void cxa_lwipMbedTls_network_tcpServer_init(cxa_lwipMbedTls_network_tcpServer_t
 {
 	cxa_assert(netServerIn);
 
-	// initialize our client connections
+	netServerIn->listenSocket = -1;
+
+	// initialize our client connections (all free)
+	netServerIn->numFreeClients = 0;
 	for( size_t i = 0; i < sizeof(netServerIn->connectedClients)/sizeof(*netServerIn->connectedClients); i++ )
 	{
-		cxa_lwipMbedTls_network_tcpServer_connectedClient_initUnbound(&netServerIn->connectedClients[i]);
+		cxa_lwipMbedTls_network_tcpServer_connectedClient_initUnbound(&netServerIn->connectedClients[i], cb_onConnectedClientUnbound, (void*)netServerIn);
+		releaseConnectedClient(netServerIn, &netServerIn->connectedClients[i]);
 	}
 
 	// setup our state machine
@@ -80,44 +87,53 @@ void cxa_lwipMbedTls_network_tcpServer_init(cxa_lwipMbedTls_network_tcpServer_t
 
 
 // ******** local function implementations ********
-static bool hasFreeConnectedClient(cxa_lwipMbedTls_network_tcpServer_t *const netServerIn)
+static cxa_lwipMbedTls_network_tcpServer_connectedClient_t* reserveFreeConnectedClient(cxa_lwipMbedTls_network_tcpServer_t *const netServerIn)
 {
 	cxa_assert(netServerIn);
 
-	for( size_t i = 0; i < sizeof(netServerIn->connectedClients)/sizeof(*netServerIn->connectedClients); i++ )
-	{
-		if( netServerIn->connectedClients[i].socket == -1 ) return true;
-	}
+	if( netServerIn->numFreeClients == 0 ) return NULL;
 
-	return false;
+	return &netServerIn->connectedClients[netServerIn->freeClientIndices[--netServerIn->numFreeClients]];
 }
 
 
-static bool reserveAndSetupFreeConnectedClient(cxa_lwipMbedTls_network_tcpServer_t *const netServerIn,
-												int socketIn, struct sockaddr_in * clientAddressIn)
+static void releaseConnectedClient(cxa_lwipMbedTls_network_tcpServer_t *const netServerIn, cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn)
 {
 	cxa_assert(netServerIn);
-	cxa_assert(clientAddressIn);
+	cxa_assert(ccIn);
+	cxa_assert(netServerIn->numFreeClients < CXA_LWIPMBEDTLS_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS);
 
-	// find a free client
-	cxa_lwipMbedTls_network_tcpServer_connectedClient_t* targetClient = NULL;
-	for( size_t i = 0; i < sizeof(netServerIn->connectedClients)/sizeof(*netServerIn->connectedClients); i++ )
+	netServerIn->freeClientIndices[netServerIn->numFreeClients++] = (size_t)(ccIn - netServerIn->connectedClients);
+}
+
+
+static void acceptPendingConnections(cxa_lwipMbedTls_network_tcpServer_t *const netServerIn)
+{
+	cxa_assert(netServerIn);
+
+	cxa_lwipMbedTls_network_tcpServer_connectedClient_t* targetClient;
+	while( (targetClient = reserveFreeConnectedClient(netServerIn)) != NULL )
 	{
-		if( !cxa_network_tcpServer_connectedClient_isBound(&netServerIn->connectedClients[i].super) )
+		struct sockaddr_in clientAddress;
+		socklen_t clientAddressLength = sizeof(clientAddress);
+		int clientSock = accept(netServerIn->listenSocket, (struct sockaddr *)&clientAddress, &clientAddressLength);
+		if( clientSock < 0 )
 		{
-			targetClient = &netServerIn->connectedClients[i];
-			break;
-		}
-	}
-	if( targetClient == NULL ) return false;
-	// if we made it here, we have a free client to configure
+			releaseConnectedClient(netServerIn, targetClient);
+			if( errno == EWOULDBLOCK ) return;
 
-	cxa_lwipMbedTls_network_tcpServer_connectedClient_bindToSocket(targetClient, socketIn, clientAddressIn);
+			// error listening
+			cxa_logger_error(&netServerIn->super.logger, "error listening accept: %d %d %s", netServerIn->listenSocket, errno, strerror(errno));
+			cxa_stateMachine_transition(&netServerIn->stateMachine, STATE_LISTENING_FAIL);
+			return;
+		}
 
-	// notify our listeners
-	cxa_network_tcpServer_notifyConnect(&netServerIn->super, &targetClient->super);
+		cxa_lwipMbedTls_network_tcpServer_connectedClient_bindToSocket(targetClient, clientSock, &clientAddress);
+		cxa_logger_info(&netServerIn->super.logger, "got connection from %s", targetClient->descriptiveString);
 
-	return true;
+		// notify our listeners
+		cxa_network_tcpServer_notifyConnect(&netServerIn->super, &targetClient->super);
+	}
 }
 
 
@@ -128,14 +144,13 @@ static void closeAllSockets(cxa_lwipMbedTls_network_tcpServer_t *const netServer
 	// first our clients
 	for( size_t i = 0; i < sizeof(netServerIn->connectedClients)/sizeof(*netServerIn->connectedClients); i++ )
 	{
-		if( netServerIn->connectedClients[i].socket != -1 )
-		{
-			cxa_network_tcpServer_connectedClient_unbindAndClose(&netServerIn->connectedClients[i].super);
-		}
+		cxa_network_tcpServer_connectedClient_unbindAndClose(&netServerIn->connectedClients[i].super);
 	}
 
 	// now our server
-	close(netServerIn->listenSocket);
+	if( netServerIn->listenSocket >= 0 ) close(netServerIn->listenSocket);
+	netServerIn->listenSocket = -1;
+	cxa_network_tcpServer_notifyAcceptPaused(&netServerIn->super, false);
 }
 
 
@@ -227,35 +242,52 @@ static void stateCb_listen_state(cxa_stateMachine_t *const smIn, void *userVarIn
 	cxa_lwipMbedTls_network_tcpServer_t *netServerIn = (cxa_lwipMbedTls_network_tcpServer_t*)userVarIn;
 	cxa_assert(netServerIn);
 
-	struct sockaddr_in clientAddress;
-	char str[INET_ADDRSTRLEN];
+	// one readiness poll for the listen socket and all of our clients
+	fd_set readFds;
+	FD_ZERO(&readFds);
+	int maxFd = -1;
 
-	// before we listen, see if we have a clientConnection for a potential connection
-	if( hasFreeConnectedClient(netServerIn) )
+	// only watch the listen socket while we have a client to give a new connection
+	// (otherwise connections wait in the backlog)
+	bool canAccept = (netServerIn->numFreeClients > 0);
+	cxa_network_tcpServer_notifyAcceptPaused(&netServerIn->super, !canAccept);
+	if( canAccept )
 	{
-		// listen for a new client connection
-		socklen_t clientAddressLength = sizeof(clientAddress);
-		int clientSock = accept(netServerIn->listenSocket, (struct sockaddr *)&clientAddress, &clientAddressLength);
-		if( clientSock >= 0 )
-		{
-			// got a client connection
-			inet_ntop(AF_INET, &clientAddress.sin_addr, str, INET_ADDRSTRLEN);
-			cxa_logger_info(&netServerIn->super.logger, "got connection from %s, configuring client", str);
+		FD_SET(netServerIn->listenSocket, &readFds);
+		maxFd = netServerIn->listenSocket;
+	}
 
-			reserveAndSetupFreeConnectedClient(netServerIn, clientSock, &clientAddress);
-		}
-		else if( errno == EWOULDBLOCK )
-		{
-			// no connection, but keep trying (non-blocking)
-		}
-		else
-		{
-			// error listening
-			cxa_logger_error(&netServerIn->super.logger, "error listening accept: %d %d %s", netServerIn->listenSocket, errno, strerror(errno));
-			cxa_stateMachine_transition(&netServerIn->stateMachine, STATE_LISTENING_FAIL);
-			return;
-		}
+	// clients with full receive buffers aren't polled until they are read
+	for( size_t i = 0; i < sizeof(netServerIn->connectedClients)/sizeof(*netServerIn->connectedClients); i++ )
+	{
+		cxa_lwipMbedTls_network_tcpServer_connectedClient_t* currClient = &netServerIn->connectedClients[i];
+		if( !cxa_lwipMbedTls_network_tcpServer_connectedClient_wantsRead(currClient) ) continue;
+
+		FD_SET(currClient->socket, &readFds);
+		if( currClient->socket > maxFd ) maxFd = currClient->socket;
+	}
+	if( maxFd < 0 ) return;
+
+	struct timeval timeout = {.tv_sec = 0, .tv_usec = 0};
+	int rc = select(maxFd+1, &readFds, NULL, NULL, &timeout);
+	if( rc < 0 )
+	{
+		if( errno == EINTR ) return;
+
+		cxa_logger_error(&netServerIn->super.logger, "error listening select: %d %s", errno, strerror(errno));
+		cxa_stateMachine_transition(&netServerIn->stateMachine, STATE_LISTENING_FAIL);
+		return;
+	}
+	else if( rc == 0 ) return;
+
+	// service reads before accepting so newly accepted sockets aren't tested against this poll
+	for( size_t i = 0; i < sizeof(netServerIn->connectedClients)/sizeof(*netServerIn->connectedClients); i++ )
+	{
+		cxa_lwipMbedTls_network_tcpServer_connectedClient_t* currClient = &netServerIn->connectedClients[i];
+		if( (currClient->socket >= 0) && FD_ISSET(currClient->socket, &readFds) ) cxa_lwipMbedTls_network_tcpServer_connectedClient_serviceRead(currClient);
 	}
+
+	if( canAccept && FD_ISSET(netServerIn->listenSocket, &readFds) ) acceptPendingConnections(netServerIn);
 }
 
 
@@ -273,3 +305,13 @@ static void stateCb_listenFail_enter(cxa_stateMachine_t *const smIn, int prevSta
 	cxa_lwipMbedTls_network_tcpServer_t *netServerIn = (cxa_lwipMbedTls_network_tcpServer_t*)userVarIn;
 	cxa_assert(netServerIn);
 }
+
+
+static void cb_onConnectedClientUnbound(cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn, void* userVarIn)
+{
+	cxa_lwipMbedTls_network_tcpServer_t *netServerIn = (cxa_lwipMbedTls_network_tcpServer_t*)userVarIn;
+	cxa_assert(netServerIn);
+
+	releaseConnectedClient(netServerIn, ccIn);
+	cxa_network_tcpServer_notifyClientReleased(&netServerIn->super);
+}
@@ -37,14 +37,22 @@ static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void
 
 
 // ******** global function implementations ********
-void cxa_lwipMbedTls_network_tcpServer_connectedClient_initUnbound(cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn)
+void cxa_lwipMbedTls_network_tcpServer_connectedClient_initUnbound(cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn,
+																	cxa_lwipMbedTls_network_tcpServer_connectedClient_cb_onUnbound_t cb_onUnboundIn,
+																	void* userVarIn)
 {
 	cxa_assert(ccIn);
 
 	cxa_network_tcpServer_connectedClient_initUnbound(&ccIn->super, scm_isBound, scm_unbindAndClose, scm_getDescriptiveString);
 
 	ccIn->socket = -1;
+	ccIn->rxRing.readIndex = 0;
+	ccIn->rxRing.numBytes = 0;
+	ccIn->isPeerClosed = false;
 	cxa_timeDiff_init(&ccIn->td_writeTimeout);
+
+	ccIn->cb_onUnbound = cb_onUnboundIn;
+	ccIn->userVar = userVarIn;
 }
 
 
@@ -57,6 +65,9 @@ void cxa_lwipMbedTls_network_tcpServer_connectedClient_bindToSocket(cxa_lwipMbed
 	if( cxa_network_tcpServer_connectedClient_isBound(&ccIn->super) ) return;
 
 	ccIn->socket = socketIn;
+	ccIn->rxRing.readIndex = 0;
+	ccIn->rxRing.numBytes = 0;
+	ccIn->isPeerClosed = false;
 	cxa_ioStream_bind(&ccIn->super.ioStream, cb_ioStream_readByte, cb_ioStream_writeBytes, (void*)ccIn);
 
 	ccIn->descriptiveString[0] = 0;
@@ -67,6 +78,48 @@ void cxa_lwipMbedTls_network_tcpServer_connectedClient_bindToSocket(cxa_lwipMbed
 }
 
 
+bool cxa_lwipMbedTls_network_tcpServer_connectedClient_wantsRead(cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn)
+{
+	cxa_assert(ccIn);
+
+	return (ccIn->socket >= 0) && !ccIn->isPeerClosed && (ccIn->rxRing.numBytes < sizeof(ccIn->rxRing.buffer));
+}
+
+
+void cxa_lwipMbedTls_network_tcpServer_connectedClient_serviceRead(cxa_lwipMbedTls_network_tcpServer_connectedClient_t *const ccIn)
+{
+	cxa_assert(ccIn);
+
+	if( !cxa_lwipMbedTls_network_tcpServer_connectedClient_wantsRead(ccIn) ) return;
+
+	// figure out the contiguous free space after our write index
+	size_t writeIndex = (ccIn->rxRing.readIndex + ccIn->rxRing.numBytes) % sizeof(ccIn->rxRing.buffer);
+	size_t numFree_bytes = sizeof(ccIn->rxRing.buffer) - ccIn->rxRing.numBytes;
+	size_t numContiguous_bytes = sizeof(ccIn->rxRing.buffer) - writeIndex;
+	if( numContiguous_bytes > numFree_bytes ) numContiguous_bytes = numFree_bytes;
+
+	int rc = recv(ccIn->socket, (void*)&ccIn->rxRing.buffer[writeIndex], numContiguous_bytes, MSG_DONTWAIT);
+	if( rc > 0 )
+	{
+		ccIn->rxRing.numBytes += rc;
+	}
+	else if( rc == 0 )
+	{
+		// per man page: For TCP sockets, the return value 0 means the peer has closed its half side of the connection.
+		cxa_logger_debug(&ccIn->super.logger, "connection closed");
+		ccIn->isPeerClosed = true;
+	}
+	else if( (errno != EAGAIN) && (errno != EWOULDBLOCK) )
+	{
+		cxa_logger_warn(&ccIn->super.logger, "unexpected read error: %d", errno);
+		ccIn->isPeerClosed = true;
+	}
+
+	// anything we've already received is still handed out (by readByte) before we close
+	if( ccIn->isPeerClosed && (ccIn->rxRing.numBytes == 0) ) scm_unbindAndClose(&ccIn->super);
+}
+
+
 // ******** local function implementations ********
 static bool scm_isBound(cxa_network_tcpServer_connectedClient_t *const superIn)
 {
@@ -82,14 +135,20 @@ static void scm_unbindAndClose(cxa_network_tcpServer_connectedClient_t *const su
 	cxa_lwipMbedTls_network_tcpServer_connectedClient_t* ccIn = (cxa_lwipMbedTls_network_tcpServer_connectedClient_t*)superIn;
 	cxa_assert(ccIn);
 
+	if( ccIn->socket < 0 ) return;
+
 	cxa_logger_debug(&ccIn->super.logger, "unbinding and closing");
 
 	cxa_ioStream_unbind(&ccIn->super.ioStream);
-	if( ccIn->socket >= 0 ) close(ccIn->socket);
+	close(ccIn->socket);
 	ccIn->socket = -1;
+	ccIn->rxRing.numBytes = 0;
 
 	// notify our listeners
 	cxa_network_tcpServer_connectedClient_notifyDisconnected(&ccIn->super);
+
+	// and finally our server (we're free for reuse now)
+	if( ccIn->cb_onUnbound != NULL ) ccIn->cb_onUnbound(ccIn, ccIn->userVar);
 }
 
 
@@ -107,29 +166,25 @@ static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, vo
 	cxa_lwipMbedTls_network_tcpServer_connectedClient_t* ccIn = (cxa_lwipMbedTls_network_tcpServer_connectedClient_t*)userVarIn;
 	cxa_assert(ccIn);
 
-	uint8_t rxByte;
-	int rc = recv(ccIn->socket, (void*)&rxByte, 1, 0);
-	if( (rc == 0) || ((rc == -1) && (errno != ENOTCONN)) )
-	{
-		// the connection has been closed
-		// per man page: For TCP sockets, the return value 0 means the peer has closed its half side of the connection.
-		cxa_logger_debug(&ccIn->super.logger, "connection closed", errno);
-		scm_unbindAndClose(&ccIn->super);
-		return CXA_IOSTREAM_READSTAT_ERROR;
-	}
-	if( (rc == -1) && (errno != EAGAIN) )
+	if( ccIn->socket < 0 ) return CXA_IOSTREAM_READSTAT_ERROR;
+
+	// our server fills the buffer when the socket is readable
+	if( ccIn->rxRing.numBytes == 0 )
 	{
-		// per man page: For TCP sockets, the return value 0 means the peer has closed its half side of the connection.
-		// otherwise a -1 and non EAGAIN errno means an error occurred
-		cxa_logger_warn(&ccIn->super.logger, "unexpected read error: %d", errno);
+		if( !ccIn->isPeerClosed ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+		// drained everything the peer sent before closing
 		scm_unbindAndClose(&ccIn->super);
 		return CXA_IOSTREAM_READSTAT_ERROR;
 	}
-	// if we made it here one of two things are true: rc==-1 -> no data...rc>0 -> data
 
-	if( (rc > 0) && (byteOut != NULL) ) *byteOut = rxByte;
+	uint8_t rxByte = ccIn->rxRing.buffer[ccIn->rxRing.readIndex];
+	ccIn->rxRing.readIndex = (ccIn->rxRing.readIndex + 1) % sizeof(ccIn->rxRing.buffer);
+	ccIn->rxRing.numBytes--;
+
+	if( byteOut != NULL ) *byteOut = rxByte;
 
-	return (rc > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_NODATA;
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
 }
 
 
@@ -0,0 +1,202 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_posix_network_epoll.h"
+
+
+// ******** includes ********
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cxa_assert.h>
+#include <cxa_runLoop.h>
+
+#define CXA_LOG_LEVEL			CXA_LOG_LEVEL_INFO
+#include <cxa_logger_implementation.h>
+
+
+// ******** local macro definitions ********
+#define EVENTDATA_PACK(indexIn, generationIn)		((((uint64_t)(generationIn)) << 32) | ((uint64_t)(indexIn)))
+#define EVENTDATA_GET_INDEX(dataIn)					((size_t)((dataIn) & 0xFFFFFFFF))
+#define EVENTDATA_GET_GENERATION(dataIn)			((uint32_t)((dataIn) >> 32))
+
+#define EVENTDATA_WAKE								UINT64_MAX
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static void init(int threadIdIn);
+static void cb_runLoop_waitForEvents(uint32_t timeout_msIn, void* userVarIn);
+static void cb_runLoop_wake(void* userVarIn);
+
+
+// ********  local variable declarations *********
+static bool isInit = false;
+static int threadId;
+static int epollFd = -1;
+static int wakeFd = -1;
+
+static cxa_posix_network_epoll_entry_t entries[CXA_POSIX_NETWORK_EPOLL_MAXNUM_ENTRIES];
+static size_t freeIndices[CXA_POSIX_NETWORK_EPOLL_MAXNUM_ENTRIES];
+static size_t numFreeIndices;
+
+static cxa_logger_t logger;
+
+
+// ******** global function implementations ********
+cxa_posix_network_epoll_entry_t* cxa_posix_network_epoll_add(int threadIdIn, int fdIn, uint32_t eventsIn,
+															 cxa_posix_network_epoll_cb_onEvents_t cb_onEventsIn, void* userVarIn)
+{
+	cxa_assert(fdIn >= 0);
+	cxa_assert(cb_onEventsIn);
+
+	if( !isInit ) init(threadIdIn);
+	cxa_assert_msg((threadIdIn == threadId), "all posix sockets must share a runLoop thread");
+
+	if( numFreeIndices == 0 )
+	{
+		cxa_logger_warn(&logger, "too many fds, increase CXA_POSIX_NETWORK_EPOLL_MAXNUM_ENTRIES");
+		return NULL;
+	}
+	size_t index = freeIndices[--numFreeIndices];
+	cxa_posix_network_epoll_entry_t* entry = &entries[index];
+
+	struct epoll_event evt;
+	memset(&evt, 0, sizeof(evt));
+	evt.events = eventsIn;
+	evt.data.u64 = EVENTDATA_PACK(index, entry->generation);
+	if( epoll_ctl(epollFd, EPOLL_CTL_ADD, fdIn, &evt) != 0 )
+	{
+		cxa_logger_warn(&logger, "error adding fd %d: %s", fdIn, strerror(errno));
+		freeIndices[numFreeIndices++] = index;
+		return NULL;
+	}
+
+	entry->fd = fdIn;
+	entry->cb_onEvents = cb_onEventsIn;
+	entry->userVar = userVarIn;
+
+	return entry;
+}
+
+
+bool cxa_posix_network_epoll_modify(cxa_posix_network_epoll_entry_t *const entryIn, uint32_t eventsIn)
+{
+	cxa_assert(entryIn);
+	cxa_assert(entryIn->fd >= 0);
+
+	struct epoll_event evt;
+	memset(&evt, 0, sizeof(evt));
+	evt.events = eventsIn;
+	evt.data.u64 = EVENTDATA_PACK(entryIn - entries, entryIn->generation);
+	if( epoll_ctl(epollFd, EPOLL_CTL_MOD, entryIn->fd, &evt) != 0 )
+	{
+		cxa_logger_warn(&logger, "error modifying fd %d: %s", entryIn->fd, strerror(errno));
+		return false;
+	}
+
+	return true;
+}
+
+
+void cxa_posix_network_epoll_remove(cxa_posix_network_epoll_entry_t *const entryIn)
+{
+	cxa_assert(entryIn);
+	if( entryIn->fd < 0 ) return;
+
+	epoll_ctl(epollFd, EPOLL_CTL_DEL, entryIn->fd, NULL);
+
+	// bumping the generation invalidates any events already collected for this entry
+	entryIn->generation++;
+	entryIn->fd = -1;
+	entryIn->cb_onEvents = NULL;
+	entryIn->userVar = NULL;
+
+	freeIndices[numFreeIndices++] = (size_t)(entryIn - entries);
+}
+
+
+// ******** local function implementations ********
+static void init(int threadIdIn)
+{
+	cxa_logger_init(&logger, "epoll");
+
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	cxa_assert_msg((epollFd >= 0), "epoll_create1 failed");
+
+	for( size_t i = 0; i < CXA_POSIX_NETWORK_EPOLL_MAXNUM_ENTRIES; i++ )
+	{
+		entries[i].fd = -1;
+		entries[i].generation = 0;
+		entries[i].cb_onEvents = NULL;
+		entries[i].userVar = NULL;
+
+		// hand out the lowest indices first
+		freeIndices[i] = CXA_POSIX_NETWORK_EPOLL_MAXNUM_ENTRIES - 1 - i;
+	}
+	numFreeIndices = CXA_POSIX_NETWORK_EPOLL_MAXNUM_ENTRIES;
+
+	// lets the runLoop interrupt our wait when one of its entries is resumed
+	wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	cxa_assert_msg((wakeFd >= 0), "eventfd failed");
+	struct epoll_event evt;
+	memset(&evt, 0, sizeof(evt));
+	evt.events = EPOLLIN;
+	evt.data.u64 = EVENTDATA_WAKE;
+	cxa_assert_msg((epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &evt) == 0), "error adding wake fd");
+
+	// the runLoop sleeps in our epoll_wait (rather than us polling every iteration)
+	threadId = threadIdIn;
+	cxa_runLoop_setEventSource(threadId, cb_runLoop_waitForEvents, cb_runLoop_wake, NULL);
+
+	isInit = true;
+}
+
+
+static void cb_runLoop_waitForEvents(uint32_t timeout_msIn, void* userVarIn)
+{
+	struct epoll_event events[CXA_POSIX_NETWORK_EPOLL_MAXNUM_EVENTS_PER_ITERATION];
+
+	int timeout_ms = (timeout_msIn > INT32_MAX) ? -1 : (int)timeout_msIn;
+	int numEvents = epoll_wait(epollFd, events, CXA_POSIX_NETWORK_EPOLL_MAXNUM_EVENTS_PER_ITERATION, timeout_ms);
+	if( numEvents < 0 )
+	{
+		if( errno != EINTR ) cxa_logger_warn(&logger, "epoll_wait error: %s", strerror(errno));
+		return;
+	}
+
+	for( int i = 0; i < numEvents; i++ )
+	{
+		if( events[i].data.u64 == EVENTDATA_WAKE )
+		{
+			uint64_t count;
+			while( read(wakeFd, &count, sizeof(count)) > 0 );
+			continue;
+		}
+
+		size_t index = EVENTDATA_GET_INDEX(events[i].data.u64);
+		if( index >= CXA_POSIX_NETWORK_EPOLL_MAXNUM_ENTRIES ) continue;
+
+		// a previous callback may have removed (or removed and re-used) this entry
+		cxa_posix_network_epoll_entry_t* currEntry = &entries[index];
+		if( (currEntry->generation != EVENTDATA_GET_GENERATION(events[i].data.u64)) || (currEntry->cb_onEvents == NULL) ) continue;
+
+		currEntry->cb_onEvents(events[i].events, currEntry->userVar);
+	}
+}
+
+
+static void cb_runLoop_wake(void* userVarIn)
+{
+	// may be called from any thread...a failed write means we're already signalled
+	uint64_t one = 1;
+	ssize_t numBytesWritten = write(wakeFd, &one, sizeof(one));
+	(void)numBytesWritten;
+}
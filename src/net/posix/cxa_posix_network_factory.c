@@ -0,0 +1,276 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_network_factory.h"
+
+
+// ******** includes ********
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <cxa_assert.h>
+#include <cxa_config.h>
+#include <cxa_network_dnsCache.h>
+#include <cxa_stringUtils.h>
+
+
+// ******** local macro definitions ********
+#ifndef CXA_POSIX_NETWORK_MAXNUM_TCP_CLIENTS
+	#define CXA_POSIX_NETWORK_MAXNUM_TCP_CLIENTS		4
+#endif
+
+#ifndef CXA_POSIX_NETWORK_MAXNUM_TCP_SERVERS
+	#define CXA_POSIX_NETWORK_MAXNUM_TCP_SERVERS		1
+#endif
+
+#ifndef CXA_POSIX_NETWORK_MAXNUM_QUEUED_RESOLVES
+	#define CXA_POSIX_NETWORK_MAXNUM_QUEUED_RESOLVES	CXA_NETWORK_DNSCACHE_MAXNUM_ENTRIES
+#endif
+
+// do these includes after macro definitions
+#if CXA_POSIX_NETWORK_MAXNUM_TCP_CLIENTS > 0
+#include <cxa_posix_network_tcpClient.h>
+#endif
+
+#if CXA_POSIX_NETWORK_MAXNUM_TCP_SERVERS > 0
+#include <cxa_posix_network_tcpServer.h>
+#endif
+
+
+// ******** local type definitions ********
+typedef struct
+{
+	cxa_posix_network_tcpClient_t client;
+	bool isReserved;
+}tcpClient_entry_t;
+
+
+#if CXA_POSIX_NETWORK_MAXNUM_TCP_SERVERS > 0
+typedef struct
+{
+	cxa_posix_network_tcpServer_t server;
+	bool isReserved;
+}tcpServer_entry_t;
+#endif
+
+
+typedef struct
+{
+	cxa_network_dnsCache_entry_t* entry;
+	char hostName[CXA_NETWORK_DNSCACHE_MAXHOSTNAMELEN_BYTES+1];
+}dnsRequest_t;
+
+
+// ******** local function prototypes ********
+static void cxa_network_factory_init(int threadIdIn);
+
+static bool scm_startDnsResolve(cxa_network_dnsCache_entry_t *const entryIn, const char *const hostNameIn);
+static bool resolveHost(const char *const hostNameIn, char *const addressOut, size_t maxAddressLen_bytesIn);
+static void* dnsThread_run(void* userVarIn);
+
+
+// ********  local variable declarations *********
+static bool isInit = false;
+
+static pthread_t dnsThread;
+static pthread_mutex_t dnsMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t dnsCond = PTHREAD_COND_INITIALIZER;
+static dnsRequest_t dnsQueue[CXA_POSIX_NETWORK_MAXNUM_QUEUED_RESOLVES];
+static size_t dnsQueue_headIndex = 0;
+static size_t dnsQueue_numRequests = 0;
+
+#if CXA_POSIX_NETWORK_MAXNUM_TCP_CLIENTS > 0
+static tcpClient_entry_t tcpClientMap[CXA_POSIX_NETWORK_MAXNUM_TCP_CLIENTS];
+#endif
+
+#if CXA_POSIX_NETWORK_MAXNUM_TCP_SERVERS > 0
+static tcpServer_entry_t tcpServerMap[CXA_POSIX_NETWORK_MAXNUM_TCP_SERVERS];
+#endif
+
+
+// ******** global function implementations ********
+cxa_network_tcpClient_t* cxa_network_factory_reserveTcpClient(int threadIdIn)
+{
+	if( !isInit ) cxa_network_factory_init(threadIdIn);
+
+	cxa_network_tcpClient_t* retVal = NULL;
+
+#if CXA_POSIX_NETWORK_MAXNUM_TCP_CLIENTS > 0
+	for( size_t i = 0; i < (sizeof(tcpClientMap)/sizeof(*tcpClientMap)); i++ )
+	{
+		if( !tcpClientMap[i].isReserved )
+		{
+			tcpClientMap[i].isReserved = true;
+			cxa_posix_network_tcpClient_init(&tcpClientMap[i].client, threadIdIn);
+			retVal = &tcpClientMap[i].client.super;
+			break;
+		}
+	}
+#endif
+
+	return retVal;
+}
+
+
+void cxa_network_factory_freeTcpClient(cxa_network_tcpClient_t *const clientIn)
+{
+#if CXA_POSIX_NETWORK_MAXNUM_TCP_CLIENTS > 0
+	for( size_t i = 0; i < (sizeof(tcpClientMap)/sizeof(*tcpClientMap)); i++ )
+	{
+		if( &tcpClientMap[i].client.super == clientIn )
+		{
+			tcpClientMap[i].isReserved = false;
+			break;
+		}
+	}
+#endif
+}
+
+
+cxa_network_tcpServer_t* cxa_network_factory_reserveTcpServer(int threadIdIn)
+{
+	if( !isInit ) cxa_network_factory_init(threadIdIn);
+
+	cxa_network_tcpServer_t* retVal = NULL;
+
+#if CXA_POSIX_NETWORK_MAXNUM_TCP_SERVERS > 0
+	for( size_t i = 0; i < (sizeof(tcpServerMap)/sizeof(*tcpServerMap)); i++ )
+	{
+		if( !tcpServerMap[i].isReserved )
+		{
+			tcpServerMap[i].isReserved = true;
+			cxa_posix_network_tcpServer_init(&tcpServerMap[i].server, threadIdIn);
+			retVal = &tcpServerMap[i].server.super;
+			break;
+		}
+	}
+#endif
+
+	return retVal;
+}
+
+
+void cxa_network_factory_freeTcpServer(cxa_network_tcpServer_t *const serverIn)
+{
+#if CXA_POSIX_NETWORK_MAXNUM_TCP_SERVERS > 0
+	for( size_t i = 0; i < (sizeof(tcpServerMap)/sizeof(*tcpServerMap)); i++ )
+	{
+		if( &tcpServerMap[i].server.super == serverIn )
+		{
+			tcpServerMap[i].isReserved = false;
+			break;
+		}
+	}
+#endif
+}
+
+
+bool cxa_network_factory_preResolveHost(int threadIdIn, const char *const hostNameIn)
+{
+	if( !isInit ) cxa_network_factory_init(threadIdIn);
+
+	return cxa_network_dnsCache_preResolve(hostNameIn);
+}
+
+
+// ******** local function implementations ********
+static void cxa_network_factory_init(int threadIdIn)
+{
+	// getaddrinfo blocks, so it gets its own thread
+	cxa_assert(pthread_create(&dnsThread, NULL, dnsThread_run, NULL) == 0);
+	pthread_detach(dnsThread);
+
+	cxa_network_dnsCache_init(threadIdIn, scm_startDnsResolve);
+
+#if CXA_POSIX_NETWORK_MAXNUM_TCP_CLIENTS > 0
+	for( size_t i = 0; i < (sizeof(tcpClientMap)/sizeof(*tcpClientMap)); i++ )
+	{
+		tcpClientMap[i].isReserved = false;
+	}
+#endif
+
+#if CXA_POSIX_NETWORK_MAXNUM_TCP_SERVERS > 0
+	for( size_t i = 0; i < (sizeof(tcpServerMap)/sizeof(*tcpServerMap)); i++ )
+	{
+		tcpServerMap[i].isReserved = false;
+	}
+#endif
+
+	isInit = true;
+}
+
+
+static bool scm_startDnsResolve(cxa_network_dnsCache_entry_t *const entryIn, const char *const hostNameIn)
+{
+	cxa_assert(entryIn);
+	cxa_assert(hostNameIn);
+
+	// hand off to our resolver thread
+	bool retVal = false;
+	pthread_mutex_lock(&dnsMutex);
+	if( dnsQueue_numRequests < (sizeof(dnsQueue)/sizeof(*dnsQueue)) )
+	{
+		dnsRequest_t* newRequest = &dnsQueue[(dnsQueue_headIndex + dnsQueue_numRequests) % (sizeof(dnsQueue)/sizeof(*dnsQueue))];
+		newRequest->entry = entryIn;
+		retVal = cxa_stringUtils_copy(newRequest->hostName, hostNameIn, sizeof(newRequest->hostName));
+		if( retVal )
+		{
+			dnsQueue_numRequests++;
+			pthread_cond_signal(&dnsCond);
+		}
+	}
+	pthread_mutex_unlock(&dnsMutex);
+
+	return retVal;
+}
+
+
+static bool resolveHost(const char *const hostNameIn, char *const addressOut, size_t maxAddressLen_bytesIn)
+{
+	cxa_assert(hostNameIn);
+	cxa_assert(addressOut);
+
+	struct addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+
+	struct addrinfo* addrs = NULL;
+	if( (getaddrinfo(hostNameIn, NULL, &hints, &addrs) != 0) || (addrs == NULL) ) return false;
+
+	const void* rawAddr = (addrs->ai_family == AF_INET6) ? (const void*)&((struct sockaddr_in6*)addrs->ai_addr)->sin6_addr :
+														   (const void*)&((struct sockaddr_in*)addrs->ai_addr)->sin_addr;
+	bool retVal = (inet_ntop(addrs->ai_family, rawAddr, addressOut, maxAddressLen_bytesIn) != NULL);
+	freeaddrinfo(addrs);
+
+	return retVal;
+}
+
+
+static void* dnsThread_run(void* userVarIn)
+{
+	while( 1 )
+	{
+		pthread_mutex_lock(&dnsMutex);
+		while( dnsQueue_numRequests == 0 ) pthread_cond_wait(&dnsCond, &dnsMutex);
+		dnsRequest_t currRequest = dnsQueue[dnsQueue_headIndex];
+		dnsQueue_headIndex = (dnsQueue_headIndex + 1) % (sizeof(dnsQueue)/sizeof(*dnsQueue));
+		dnsQueue_numRequests--;
+		pthread_mutex_unlock(&dnsMutex);
+
+		// getaddrinfo doesn't expose the record TTL...use the default
+		char address[INET6_ADDRSTRLEN];
+		bool didResolve = resolveHost(currRequest.hostName, address, sizeof(address));
+		cxa_network_dnsCache_entry_setResult(currRequest.entry, currRequest.hostName, didResolve ? address : NULL, 0);
+	}
+
+	return NULL;
+}
@@ -0,0 +1,263 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_posix_network_socket.h"
+
+
+// ******** includes ********
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <cxa_assert.h>
+
+#define CXA_LOG_LEVEL			CXA_LOG_LEVEL_INFO
+#include <cxa_logger_implementation.h>
+
+
+// ******** local macro definitions ********
+#define EVENTS_CONNECTING				(EPOLLOUT)
+#define EVENTS_CONNECTED				(EPOLLIN | EPOLLRDHUP)
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static cxa_ioStream_readStatus_t fillRxBuffer(cxa_posix_network_socket_t *const sockIn);
+static void closeAndNotify(cxa_posix_network_socket_t *const sockIn);
+
+static void cb_onEpollEvents(uint32_t eventsIn, void* userVarIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_posix_network_socket_init(cxa_posix_network_socket_t *const sockIn,
+								   cxa_posix_network_socket_cb_onConnectComplete_t cb_onConnectCompleteIn,
+								   cxa_posix_network_socket_cb_onClosed_t cb_onClosedIn,
+								   void* userVarIn,
+								   cxa_ioStream_t *const ioStreamIn,
+								   cxa_logger_t *const loggerIn)
+{
+	cxa_assert(sockIn);
+	cxa_assert(ioStreamIn);
+	cxa_assert(loggerIn);
+
+	sockIn->fd = -1;
+	sockIn->epollEntry = NULL;
+	sockIn->isConnectPending = false;
+	sockIn->isReadable = false;
+	sockIn->rxBuffer_numBytes = 0;
+	sockIn->rxBuffer_readIndex = 0;
+
+	sockIn->cb_onConnectComplete = cb_onConnectCompleteIn;
+	sockIn->cb_onClosed = cb_onClosedIn;
+	sockIn->userVar = userVarIn;
+	sockIn->ioStream = ioStreamIn;
+	sockIn->logger = loggerIn;
+}
+
+
+bool cxa_posix_network_socket_attach(cxa_posix_network_socket_t *const sockIn, int threadIdIn, int fdIn, bool isConnectPendingIn)
+{
+	cxa_assert(sockIn);
+	cxa_assert(fdIn >= 0);
+
+	// make sure we don't leak a previous socket
+	cxa_posix_network_socket_close(sockIn);
+
+	sockIn->fd = fdIn;
+	sockIn->isConnectPending = isConnectPendingIn;
+	sockIn->epollEntry = cxa_posix_network_epoll_add(threadIdIn, fdIn, (isConnectPendingIn ? EVENTS_CONNECTING : EVENTS_CONNECTED), cb_onEpollEvents, (void*)sockIn);
+	if( sockIn->epollEntry == NULL )
+	{
+		cxa_posix_network_socket_close(sockIn);
+		return false;
+	}
+
+	return true;
+}
+
+
+void cxa_posix_network_socket_close(cxa_posix_network_socket_t *const sockIn)
+{
+	cxa_assert(sockIn);
+
+	if( sockIn->epollEntry != NULL ) cxa_posix_network_epoll_remove(sockIn->epollEntry);
+	sockIn->epollEntry = NULL;
+
+	if( sockIn->fd >= 0 ) close(sockIn->fd);
+	sockIn->fd = -1;
+
+	sockIn->isConnectPending = false;
+	sockIn->isReadable = false;
+	sockIn->rxBuffer_numBytes = 0;
+	sockIn->rxBuffer_readIndex = 0;
+}
+
+
+bool cxa_posix_network_socket_isOpen(cxa_posix_network_socket_t *const sockIn)
+{
+	cxa_assert(sockIn);
+
+	return (sockIn->fd >= 0);
+}
+
+
+cxa_ioStream_readStatus_t cxa_posix_network_socket_readByte(cxa_posix_network_socket_t *const sockIn, uint8_t *const byteOut)
+{
+	cxa_assert(sockIn);
+
+	if( sockIn->fd < 0 ) return CXA_IOSTREAM_READSTAT_ERROR;
+
+	if( sockIn->rxBuffer_readIndex >= sockIn->rxBuffer_numBytes )
+	{
+		// buffer is empty...don't bother the kernel unless epoll says there is something to read
+		if( !sockIn->isReadable ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+		cxa_ioStream_readStatus_t retVal = fillRxBuffer(sockIn);
+		if( retVal != CXA_IOSTREAM_READSTAT_GOTDATA ) return retVal;
+	}
+
+	uint8_t rxByte = sockIn->rxBuffer[sockIn->rxBuffer_readIndex++];
+	if( byteOut != NULL ) *byteOut = rxByte;
+
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
+bool cxa_posix_network_socket_writeBytes(cxa_posix_network_socket_t *const sockIn, void* buffIn, size_t bufferSize_bytesIn, uint32_t timeout_msIn)
+{
+	cxa_assert(sockIn);
+
+	// handle a zero-size buffer appropriately
+	if( bufferSize_bytesIn != 0 ) { cxa_assert(buffIn); }
+	else { return true; }
+
+	if( (sockIn->fd < 0) || sockIn->isConnectPending ) return false;
+
+	uint8_t* buf = buffIn;
+	while( bufferSize_bytesIn > 0 )
+	{
+		ssize_t rc = send(sockIn->fd, (void*)buf, bufferSize_bytesIn, MSG_NOSIGNAL);
+		if( rc > 0 )
+		{
+			buf += rc;
+			bufferSize_bytesIn -= rc;
+		}
+		else if( (rc < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)) )
+		{
+			// send buffer is full, wait for it to drain (rather than spinning)
+			struct pollfd pfd = {.fd = sockIn->fd, .events = POLLOUT, .revents = 0};
+			int pollRc = poll(&pfd, 1, (int)timeout_msIn);
+			if( pollRc == 0 )
+			{
+				cxa_logger_warn(sockIn->logger, "timeout during write");
+				closeAndNotify(sockIn);
+				return false;
+			}
+			else if( (pollRc < 0) && (errno != EINTR) )
+			{
+				cxa_logger_warn(sockIn->logger, "error waiting for write: %s", strerror(errno));
+				closeAndNotify(sockIn);
+				return false;
+			}
+		}
+		else if( (rc < 0) && (errno == EINTR) )
+		{
+			// try again
+		}
+		else
+		{
+			cxa_logger_warn(sockIn->logger, "error during write: %s", strerror(errno));
+			closeAndNotify(sockIn);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+// ******** local function implementations ********
+static cxa_ioStream_readStatus_t fillRxBuffer(cxa_posix_network_socket_t *const sockIn)
+{
+	cxa_assert(sockIn);
+
+	sockIn->rxBuffer_numBytes = 0;
+	sockIn->rxBuffer_readIndex = 0;
+
+	ssize_t rc = recv(sockIn->fd, (void*)sockIn->rxBuffer, sizeof(sockIn->rxBuffer), 0);
+	if( rc > 0 )
+	{
+		sockIn->rxBuffer_numBytes = (size_t)rc;
+		return CXA_IOSTREAM_READSTAT_GOTDATA;
+	}
+	else if( rc == 0 )
+	{
+		// per man page: For TCP sockets, the return value 0 means the peer has closed its half side of the connection.
+		cxa_logger_debug(sockIn->logger, "connection closed by peer");
+		closeAndNotify(sockIn);
+		return CXA_IOSTREAM_READSTAT_ERROR;
+	}
+	else if( (errno == EAGAIN) || (errno == EWOULDBLOCK) )
+	{
+		// drained...wait for epoll to tell us there is more
+		sockIn->isReadable = false;
+		return CXA_IOSTREAM_READSTAT_NODATA;
+	}
+	else if( errno == EINTR )
+	{
+		return CXA_IOSTREAM_READSTAT_NODATA;
+	}
+
+	cxa_logger_warn(sockIn->logger, "unexpected read error: %s", strerror(errno));
+	closeAndNotify(sockIn);
+	return CXA_IOSTREAM_READSTAT_ERROR;
+}
+
+
+static void closeAndNotify(cxa_posix_network_socket_t *const sockIn)
+{
+	cxa_assert(sockIn);
+
+	cxa_posix_network_socket_close(sockIn);
+	if( sockIn->cb_onClosed != NULL ) sockIn->cb_onClosed(sockIn, sockIn->userVar);
+}
+
+
+static void cb_onEpollEvents(uint32_t eventsIn, void* userVarIn)
+{
+	cxa_posix_network_socket_t* sockIn = (cxa_posix_network_socket_t*)userVarIn;
+	cxa_assert(sockIn);
+
+	if( sockIn->isConnectPending )
+	{
+		// writable (or error) means the non-blocking connect has finished
+		int sockErr = 0;
+		socklen_t sockErr_len = sizeof(sockErr);
+		if( getsockopt(sockIn->fd, SOL_SOCKET, SO_ERROR, &sockErr, &sockErr_len) != 0 ) sockErr = errno;
+
+		sockIn->isConnectPending = false;
+		if( (sockErr == 0) && !cxa_posix_network_epoll_modify(sockIn->epollEntry, EVENTS_CONNECTED) ) sockErr = EIO;
+
+		if( sockIn->cb_onConnectComplete != NULL ) sockIn->cb_onConnectComplete(sockIn, sockErr, sockIn->userVar);
+		return;
+	}
+
+	// any of EPOLLIN, EPOLLRDHUP, EPOLLHUP, EPOLLERR will be resolved by the next recv
+	sockIn->isReadable = true;
+
+	// prefetch if our buffer is empty (also catches a peer closing while we're not reading)
+	if( sockIn->rxBuffer_readIndex >= sockIn->rxBuffer_numBytes ) fillRxBuffer(sockIn);
+
+	// wake our reader (unless the prefetch found the socket closed)
+	if( sockIn->fd >= 0 ) cxa_ioStream_notify_dataAvailable(sockIn->ioStream);
+}
@@ -0,0 +1,345 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include <cxa_posix_network_tcpClient.h>
+
+
+// ******** includes ********
+#include <errno.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <cxa_assert.h>
+#include <cxa_network_dnsCache.h>
+#include <cxa_stringUtils.h>
+
+#define CXA_LOG_LEVEL			CXA_LOG_LEVEL_INFO
+#include <cxa_logger_implementation.h>
+
+
+// ******** local macro definitions ********
+#define WRITE_TIMEOUT_MS					20000
+
+
+// ******** local type definitions ********
+typedef enum
+{
+	STATE_IDLE,
+	STATE_CONNECTING,
+	STATE_CONNECTED,
+	STATE_CONNECT_FAIL
+}state_t;
+
+
+// ******** local function prototypes ********
+static bool scm_connectToHost(cxa_network_tcpClient_t *const superIn, char *const hostNameIn, uint16_t portNumIn, bool useTlsIn, uint32_t timeout_msIn);
+static void scm_disconnectFromHost(cxa_network_tcpClient_t *const superIn);
+static bool scm_isConnected(cxa_network_tcpClient_t *const superIn);
+
+static void stateCb_connecting_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
+static void stateCb_connecting_state(cxa_stateMachine_t *const smIn, void *userVarIn);
+static void stateCb_connected_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
+static void stateCb_connected_leave(cxa_stateMachine_t *const smIn, int nextStateIdIn, void* userVarIn);
+static void stateCb_connectFail_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
+
+static void startConnect(cxa_posix_network_tcpClient_t *const netClientIn, const char *const addressIn);
+
+static void cb_socket_onConnectComplete(cxa_posix_network_socket_t *const sockIn, int errorIn, void* userVarIn);
+static void cb_socket_onClosed(cxa_posix_network_socket_t *const sockIn, void* userVarIn);
+
+static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn);
+static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_posix_network_tcpClient_init(cxa_posix_network_tcpClient_t *const netClientIn, int threadIdIn)
+{
+	cxa_assert(netClientIn);
+
+	// set some defaults
+	netClientIn->targetHostName[0] = 0;
+	netClientIn->targetPortNum = 0;
+	netClientIn->connectTimeout_ms = 0;
+	netClientIn->threadId = threadIdIn;
+
+	cxa_timeDiff_init(&netClientIn->td_connectTimeout);
+
+	cxa_stateMachine_init(&netClientIn->stateMachine, "tcpClient", threadIdIn);
+	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_IDLE, "idle", NULL, NULL, NULL, (void*)netClientIn);
+	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTING, "connecting", stateCb_connecting_enter, stateCb_connecting_state, NULL, (void*)netClientIn);
+	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTED, "connected", stateCb_connected_enter, NULL, stateCb_connected_leave, (void*)netClientIn);
+	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECT_FAIL, "connFail", stateCb_connectFail_enter, NULL, NULL, (void*)netClientIn);
+	cxa_stateMachine_setInitialState(&netClientIn->stateMachine, STATE_IDLE);
+
+	// only connecting is polled (dns and timeout), the rest is driven by our socket
+	cxa_stateMachine_setSuspendWhenIdle(&netClientIn->stateMachine, true);
+
+	// initialize our super class (no TLS support, so no client certificates)
+	cxa_network_tcpClient_init(&netClientIn->super, scm_connectToHost, NULL, scm_disconnectFromHost, scm_isConnected);
+
+	// our socket logs through our super class' logger
+	cxa_posix_network_socket_init(&netClientIn->socket, cb_socket_onConnectComplete, cb_socket_onClosed, (void*)netClientIn, &netClientIn->super.ioStream, &netClientIn->super.logger);
+}
+
+
+// ******** local function implementations ********
+static bool scm_connectToHost(cxa_network_tcpClient_t *const superIn, char *const hostNameIn, uint16_t portNumIn, bool useTlsIn, uint32_t timeout_msIn)
+{
+	cxa_assert(hostNameIn);
+
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)superIn;
+	cxa_assert(netClientIn);
+
+	if( useTlsIn )
+	{
+		cxa_logger_warn(&netClientIn->super.logger, "TLS is not supported by this client");
+		return false;
+	}
+
+	// make sure we are currently idle
+	if( cxa_stateMachine_getCurrentState(&netClientIn->stateMachine) != STATE_IDLE )
+	{
+		cxa_logger_trace(&netClientIn->super.logger, "not idle, cannot connect");
+		return false;
+	}
+
+	if( !cxa_stringUtils_copy(netClientIn->targetHostName, hostNameIn, sizeof(netClientIn->targetHostName)) )
+	{
+		cxa_logger_warn(&netClientIn->super.logger, "hostname too long");
+		return false;
+	}
+	netClientIn->targetPortNum = portNumIn;
+	netClientIn->connectTimeout_ms = timeout_msIn;
+
+	// start the connection
+	cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTING);
+
+	return true;
+}
+
+
+static void scm_disconnectFromHost(cxa_network_tcpClient_t *const superIn)
+{
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)superIn;
+	cxa_assert(netClientIn);
+
+	cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_IDLE);
+}
+
+
+static bool scm_isConnected(cxa_network_tcpClient_t *const superIn)
+{
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)superIn;
+	cxa_assert(netClientIn);
+
+	return (cxa_stateMachine_getCurrentState(&netClientIn->stateMachine) == STATE_CONNECTED) &&
+			cxa_posix_network_socket_isOpen(&netClientIn->socket);
+}
+
+
+static void stateCb_connecting_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
+{
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	cxa_logger_info(&netClientIn->super.logger, "connecting to '%s:%u'", netClientIn->targetHostName, netClientIn->targetPortNum);
+	cxa_timeDiff_setStartTime_now(&netClientIn->td_connectTimeout);
+}
+
+
+static void stateCb_connecting_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+{
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	// once our socket is open, completion is reported via cb_socket_onConnectComplete
+	if( !cxa_posix_network_socket_isOpen(&netClientIn->socket) )
+	{
+		char address[CXA_NETWORK_DNSCACHE_MAXADDRESSLEN_BYTES+1];
+		switch( cxa_network_dnsCache_lookup(netClientIn->targetHostName, address, sizeof(address)) )
+		{
+			case CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED:
+				startConnect(netClientIn, address);
+				return;
+
+			case CXA_NETWORK_DNSCACHE_LOOKUP_FAILED:
+				cxa_logger_warn(&netClientIn->super.logger, "resolve failed");
+				cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
+				return;
+
+			default:
+				break;
+		}
+	}
+
+	// ...we just watch the clock
+	if( cxa_timeDiff_isElapsed_ms(&netClientIn->td_connectTimeout, netClientIn->connectTimeout_ms) )
+	{
+		cxa_logger_warn(&netClientIn->super.logger, "timeout during connect");
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
+	}
+}
+
+
+static void stateCb_connected_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
+{
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	// bind our ioStream
+	cxa_ioStream_bind(&netClientIn->super.ioStream, cb_ioStream_readByte, cb_ioStream_writeBytes, (void*)netClientIn);
+	cxa_ioStream_setNotifiesDataAvailable(&netClientIn->super.ioStream, true);
+
+	cxa_logger_trace(&netClientIn->super.logger, "connected");
+
+	// notify our listeners
+	cxa_network_tcpClient_notify_connect(&netClientIn->super);
+}
+
+
+static void stateCb_connected_leave(cxa_stateMachine_t *const smIn, int nextStateIdIn, void* userVarIn)
+{
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	cxa_posix_network_socket_close(&netClientIn->socket);
+	cxa_ioStream_unbind(&netClientIn->super.ioStream);
+
+	// notify our listeners
+	cxa_network_tcpClient_notify_disconnect(&netClientIn->super);
+}
+
+
+static void stateCb_connectFail_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
+{
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	cxa_posix_network_socket_close(&netClientIn->socket);
+
+	// notify our listeners
+	cxa_network_tcpClient_notify_connectFail(&netClientIn->super);
+
+	cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_IDLE);
+}
+
+
+static void startConnect(cxa_posix_network_tcpClient_t *const netClientIn, const char *const addressIn)
+{
+	cxa_assert(netClientIn);
+	cxa_assert(addressIn);
+
+	// addressIn is numeric, so this doesn't touch DNS
+	char portNumStr[6];
+	snprintf(portNumStr, sizeof(portNumStr), "%u", netClientIn->targetPortNum);
+
+	struct addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_NUMERICHOST | AI_NUMERICSERV;
+
+	cxa_logger_debug(&netClientIn->super.logger, "connecting to %s:%s", addressIn, portNumStr);
+	struct addrinfo* addrs = NULL;
+	int rc = getaddrinfo(addressIn, portNumStr, &hints, &addrs);
+	if( (rc != 0) || (addrs == NULL) )
+	{
+		cxa_logger_warn(&netClientIn->super.logger, "bad address '%s': %s", addressIn, gai_strerror(rc));
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
+		return;
+	}
+
+	// start a non-blocking connect
+	int sock = socket(addrs->ai_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, addrs->ai_protocol);
+	if( sock < 0 )
+	{
+		cxa_logger_warn(&netClientIn->super.logger, "error creating socket: %s", strerror(errno));
+		freeaddrinfo(addrs);
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
+		return;
+	}
+
+	// our users do small request/response writes, don't let Nagle delay them
+	int flag = 1;
+	setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+	rc = connect(sock, addrs->ai_addr, addrs->ai_addrlen);
+	freeaddrinfo(addrs);
+	if( (rc != 0) && (errno != EINPROGRESS) )
+	{
+		cxa_logger_warn(&netClientIn->super.logger, "connect failed: %s", strerror(errno));
+		close(sock);
+		cxa_network_dnsCache_invalidate(netClientIn->targetHostName);
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
+		return;
+	}
+
+	if( !cxa_posix_network_socket_attach(&netClientIn->socket, netClientIn->threadId, sock, (rc != 0)) )
+	{
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
+		return;
+	}
+
+	// connects to a local host may complete immediately
+	if( rc == 0 ) cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED);
+}
+
+
+static void cb_socket_onConnectComplete(cxa_posix_network_socket_t *const sockIn, int errorIn, void* userVarIn)
+{
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	if( cxa_stateMachine_getCurrentState(&netClientIn->stateMachine) != STATE_CONNECTING ) return;
+
+	if( errorIn != 0 )
+	{
+		cxa_logger_warn(&netClientIn->super.logger, "connect failed: %s", strerror(errorIn));
+		cxa_network_dnsCache_invalidate(netClientIn->targetHostName);
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
+		return;
+	}
+
+	cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED);
+}
+
+
+static void cb_socket_onClosed(cxa_posix_network_socket_t *const sockIn, void* userVarIn)
+{
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	if( cxa_stateMachine_getCurrentState(&netClientIn->stateMachine) == STATE_CONNECTED )
+	{
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_IDLE);
+	}
+}
+
+
+static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn)
+{
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	return cxa_posix_network_socket_readByte(&netClientIn->socket, byteOut);
+}
+
+
+static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
+{
+	cxa_posix_network_tcpClient_t* netClientIn = (cxa_posix_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	return cxa_posix_network_socket_writeBytes(&netClientIn->socket, buffIn, bufferSize_bytesIn, WRITE_TIMEOUT_MS);
+}
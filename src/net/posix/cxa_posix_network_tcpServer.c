@@ -0,0 +1,309 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include <cxa_posix_network_tcpServer.h>
+
+
+// ******** includes ********
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <cxa_assert.h>
+
+#define CXA_LOG_LEVEL			CXA_LOG_LEVEL_INFO
+#include <cxa_logger_implementation.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+typedef enum
+{
+	STATE_IDLE,
+	STATE_LISTENING,
+	STATE_LISTENING_FAIL
+}state_t;
+
+
+// ******** local function prototypes ********
+static cxa_posix_network_tcpServer_connectedClient_t* reserveFreeConnectedClient(cxa_posix_network_tcpServer_t *const netServerIn);
+static void releaseConnectedClient(cxa_posix_network_tcpServer_t *const netServerIn, cxa_posix_network_tcpServer_connectedClient_t *const ccIn);
+static void acceptPendingConnections(cxa_posix_network_tcpServer_t *const netServerIn);
+static void setAcceptPaused(cxa_posix_network_tcpServer_t *const netServerIn, bool isPausedIn);
+static void closeAllSockets(cxa_posix_network_tcpServer_t *const netServerIn);
+
+static bool scm_listen(cxa_network_tcpServer_t *const superIn, uint16_t portNumIn);
+static void scm_stopListening(cxa_network_tcpServer_t *const superIn);
+
+static void stateCb_listen_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
+static void stateCb_listen_leave(cxa_stateMachine_t *const smIn, int nextStateIdIn, void* userVarIn);
+
+static void cb_onListenSocketEvents(uint32_t eventsIn, void* userVarIn);
+static void cb_onConnectedClientUnbound(cxa_posix_network_tcpServer_connectedClient_t *const ccIn, void* userVarIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_posix_network_tcpServer_init(cxa_posix_network_tcpServer_t *const netServerIn, int threadIdIn)
+{
+	cxa_assert(netServerIn);
+
+	netServerIn->threadId = threadIdIn;
+	netServerIn->portNumber = 0;
+	netServerIn->listenSocket = -1;
+	netServerIn->listenEntry = NULL;
+	netServerIn->isAcceptPaused = false;
+
+	// initialize our client connections (all free)
+	netServerIn->numFreeClients = 0;
+	for( size_t i = 0; i < sizeof(netServerIn->connectedClients)/sizeof(*netServerIn->connectedClients); i++ )
+	{
+		cxa_posix_network_tcpServer_connectedClient_initUnbound(&netServerIn->connectedClients[i], threadIdIn, cb_onConnectedClientUnbound, (void*)netServerIn);
+		releaseConnectedClient(netServerIn, &netServerIn->connectedClients[i]);
+	}
+
+	// setup our state machine
+	cxa_stateMachine_init(&netServerIn->stateMachine, "tcpServer", threadIdIn);
+	cxa_stateMachine_addState(&netServerIn->stateMachine, STATE_IDLE, "idle", NULL, NULL, NULL, (void*)netServerIn);
+	cxa_stateMachine_addState(&netServerIn->stateMachine, STATE_LISTENING, "listening", stateCb_listen_enter, NULL, stateCb_listen_leave, (void*)netServerIn);
+	cxa_stateMachine_addState(&netServerIn->stateMachine, STATE_LISTENING_FAIL, "listenFail", NULL, NULL, NULL, (void*)netServerIn);
+	cxa_stateMachine_setInitialState(&netServerIn->stateMachine, STATE_IDLE);
+	// everything is driven by epoll callbacks and transitions
+	cxa_stateMachine_setSuspendWhenIdle(&netServerIn->stateMachine, true);
+
+	// initialize our super class
+	cxa_network_tcpServer_init(&netServerIn->super, scm_listen, scm_stopListening);
+}
+
+
+// ******** local function implementations ********
+static cxa_posix_network_tcpServer_connectedClient_t* reserveFreeConnectedClient(cxa_posix_network_tcpServer_t *const netServerIn)
+{
+	cxa_assert(netServerIn);
+
+	if( netServerIn->numFreeClients == 0 ) return NULL;
+
+	return &netServerIn->connectedClients[netServerIn->freeClientIndices[--netServerIn->numFreeClients]];
+}
+
+
+static void releaseConnectedClient(cxa_posix_network_tcpServer_t *const netServerIn, cxa_posix_network_tcpServer_connectedClient_t *const ccIn)
+{
+	cxa_assert(netServerIn);
+	cxa_assert(ccIn);
+	cxa_assert(netServerIn->numFreeClients < CXA_POSIX_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS);
+
+	netServerIn->freeClientIndices[netServerIn->numFreeClients++] = (size_t)(ccIn - netServerIn->connectedClients);
+}
+
+
+static void acceptPendingConnections(cxa_posix_network_tcpServer_t *const netServerIn)
+{
+	cxa_assert(netServerIn);
+
+	cxa_posix_network_tcpServer_connectedClient_t* targetClient;
+	while( (targetClient = reserveFreeConnectedClient(netServerIn)) != NULL )
+	{
+		struct sockaddr_storage clientAddress;
+		socklen_t clientAddressLength = sizeof(clientAddress);
+		int clientSock = accept(netServerIn->listenSocket, (struct sockaddr *)&clientAddress, &clientAddressLength);
+		if( clientSock < 0 )
+		{
+			releaseConnectedClient(netServerIn, targetClient);
+			if( (errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR) || (errno == ECONNABORTED) ) return;
+
+			cxa_logger_error(&netServerIn->super.logger, "error listening accept: %d %s", errno, strerror(errno));
+			cxa_stateMachine_transition(&netServerIn->stateMachine, STATE_LISTENING_FAIL);
+			return;
+		}
+
+		// accepted sockets don't inherit O_NONBLOCK on Linux
+		fcntl(clientSock, F_SETFL, fcntl(clientSock, F_GETFL, 0) | O_NONBLOCK);
+		fcntl(clientSock, F_SETFD, FD_CLOEXEC);
+
+		if( !cxa_posix_network_tcpServer_connectedClient_bindToSocket(targetClient, clientSock, &clientAddress) )
+		{
+			cxa_logger_warn(&netServerIn->super.logger, "unable to bind client, dropping connection");
+			releaseConnectedClient(netServerIn, targetClient);
+			continue;
+		}
+		cxa_logger_info(&netServerIn->super.logger, "got connection from %s", targetClient->descriptiveString);
+
+		// notify our listeners
+		cxa_network_tcpServer_notifyConnect(&netServerIn->super, &targetClient->super);
+	}
+
+	// out of clients...leave any further connections in the kernel's backlog until one frees up
+	setAcceptPaused(netServerIn, true);
+}
+
+
+static void setAcceptPaused(cxa_posix_network_tcpServer_t *const netServerIn, bool isPausedIn)
+{
+	cxa_assert(netServerIn);
+
+	if( (netServerIn->listenEntry == NULL) || (netServerIn->isAcceptPaused == isPausedIn) ) return;
+
+	cxa_logger_debug(&netServerIn->super.logger, "%s accepting", isPausedIn ? "pausing" : "resuming");
+	if( cxa_posix_network_epoll_modify(netServerIn->listenEntry, (isPausedIn ? 0 : EPOLLIN)) )
+	{
+		netServerIn->isAcceptPaused = isPausedIn;
+		cxa_network_tcpServer_notifyAcceptPaused(&netServerIn->super, isPausedIn);
+	}
+}
+
+
+static void closeAllSockets(cxa_posix_network_tcpServer_t *const netServerIn)
+{
+	cxa_assert(netServerIn);
+
+	// stop accepting first so freed clients don't try to resume
+	if( netServerIn->listenEntry != NULL ) cxa_posix_network_epoll_remove(netServerIn->listenEntry);
+	netServerIn->listenEntry = NULL;
+	cxa_network_tcpServer_notifyAcceptPaused(&netServerIn->super, false);
+
+	// now our clients
+	for( size_t i = 0; i < sizeof(netServerIn->connectedClients)/sizeof(*netServerIn->connectedClients); i++ )
+	{
+		cxa_network_tcpServer_connectedClient_unbindAndClose(&netServerIn->connectedClients[i].super);
+	}
+
+	// and finally our server
+	if( netServerIn->listenSocket >= 0 ) close(netServerIn->listenSocket);
+	netServerIn->listenSocket = -1;
+}
+
+
+static bool scm_listen(cxa_network_tcpServer_t *const superIn, uint16_t portNumIn)
+{
+	cxa_posix_network_tcpServer_t *netServerIn = (cxa_posix_network_tcpServer_t*)superIn;
+	cxa_assert(netServerIn);
+
+	// make sure we're able to listen
+	if( cxa_stateMachine_getCurrentState(&netServerIn->stateMachine) == STATE_LISTENING )
+	{
+		cxa_logger_warn(&netServerIn->super.logger, "bad state for listening");
+		return false;
+	}
+	// if we made it here, we can listen...
+
+	// save our references
+	netServerIn->portNumber = portNumIn;
+
+	// transition
+	cxa_stateMachine_transition(&netServerIn->stateMachine, STATE_LISTENING);
+	return true;
+}
+
+
+static void scm_stopListening(cxa_network_tcpServer_t *const superIn)
+{
+	cxa_posix_network_tcpServer_t *netServerIn = (cxa_posix_network_tcpServer_t*)superIn;
+	cxa_assert(netServerIn);
+
+	if( cxa_stateMachine_getCurrentState(&netServerIn->stateMachine) == STATE_IDLE ) return;
+
+	cxa_logger_info(&netServerIn->super.logger, "stopping listening");
+	cxa_stateMachine_transition(&netServerIn->stateMachine, STATE_IDLE);
+}
+
+
+static void stateCb_listen_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
+{
+	cxa_posix_network_tcpServer_t *netServerIn = (cxa_posix_network_tcpServer_t*)userVarIn;
+	cxa_assert(netServerIn);
+
+	// create a (non-blocking) socket that we will listen upon
+	cxa_logger_debug(&netServerIn->super.logger, "creating socket");
+	netServerIn->listenSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+	if( netServerIn->listenSocket < 0 )
+	{
+		cxa_logger_error(&netServerIn->super.logger, "error listening socket: %d %s", netServerIn->listenSocket, strerror(errno));
+		cxa_stateMachine_transition(&netServerIn->stateMachine, STATE_LISTENING_FAIL);
+		return;
+	}
+
+	// allow quick restarts (don't wait for TIME_WAIT)
+	int flag = 1;
+	setsockopt(netServerIn->listenSocket, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+
+	// bind our server socket to a port
+	cxa_logger_debug(&netServerIn->super.logger, "bind socket to any address");
+	struct sockaddr_in serverAddress;
+	memset(&serverAddress, 0, sizeof(serverAddress));
+	serverAddress.sin_family = AF_INET;
+	serverAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+	serverAddress.sin_port = htons(netServerIn->portNumber);
+	int rc = bind(netServerIn->listenSocket, (struct sockaddr *)&serverAddress, sizeof(serverAddress));
+	if( rc < 0 )
+	{
+		cxa_logger_error(&netServerIn->super.logger, "error listening bind: %d %s", rc, strerror(errno));
+		cxa_stateMachine_transition(&netServerIn->stateMachine, STATE_LISTENING_FAIL);
+		return;
+	}
+
+	// flag the socket as listening for new connections
+	cxa_logger_debug(&netServerIn->super.logger, "flagging socket as listening");
+	rc = listen(netServerIn->listenSocket, CXA_POSIX_NETWORK_TCPSERVER_CONNECTION_BACKLOG);
+	if( rc < 0 )
+	{
+		cxa_logger_error(&netServerIn->super.logger, "error listening listen: %d %s", rc, strerror(errno));
+		cxa_stateMachine_transition(&netServerIn->stateMachine, STATE_LISTENING_FAIL);
+		return;
+	}
+
+	// incoming connections are reported via epoll
+	netServerIn->isAcceptPaused = false;
+	netServerIn->listenEntry = cxa_posix_network_epoll_add(netServerIn->threadId, netServerIn->listenSocket, EPOLLIN, cb_onListenSocketEvents, (void*)netServerIn);
+	if( netServerIn->listenEntry == NULL )
+	{
+		cxa_stateMachine_transition(&netServerIn->stateMachine, STATE_LISTENING_FAIL);
+		return;
+	}
+
+	cxa_logger_info(&netServerIn->super.logger, "listening on port %d", netServerIn->portNumber);
+}
+
+
+static void stateCb_listen_leave(cxa_stateMachine_t *const smIn, int nextStateIdIn, void* userVarIn)
+{
+	cxa_posix_network_tcpServer_t *netServerIn = (cxa_posix_network_tcpServer_t*)userVarIn;
+	cxa_assert(netServerIn);
+
+	closeAllSockets(netServerIn);
+}
+
+
+static void cb_onListenSocketEvents(uint32_t eventsIn, void* userVarIn)
+{
+	cxa_posix_network_tcpServer_t *netServerIn = (cxa_posix_network_tcpServer_t*)userVarIn;
+	cxa_assert(netServerIn);
+
+	if( cxa_stateMachine_getCurrentState(&netServerIn->stateMachine) != STATE_LISTENING ) return;
+
+	acceptPendingConnections(netServerIn);
+}
+
+
+static void cb_onConnectedClientUnbound(cxa_posix_network_tcpServer_connectedClient_t *const ccIn, void* userVarIn)
+{
+	cxa_posix_network_tcpServer_t *netServerIn = (cxa_posix_network_tcpServer_t*)userVarIn;
+	cxa_assert(netServerIn);
+
+	releaseConnectedClient(netServerIn, ccIn);
+	cxa_network_tcpServer_notifyClientReleased(&netServerIn->super);
+
+	// we have room again
+	setAcceptPaused(netServerIn, false);
+}
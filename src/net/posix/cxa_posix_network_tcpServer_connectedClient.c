@@ -0,0 +1,154 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include <cxa_posix_network_tcpServer_connectedClient.h>
+
+
+// ******** includes ********
+#include <arpa/inet.h>
+
+#include <cxa_assert.h>
+#include <cxa_stringUtils.h>
+
+#define CXA_LOG_LEVEL			CXA_LOG_LEVEL_INFO
+#include <cxa_logger_implementation.h>
+
+
+// ******** local macro definitions ********
+#define WRITE_TIMEOUT_MS				2000
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static bool scm_isBound(cxa_network_tcpServer_connectedClient_t *const superIn);
+static void scm_unbindAndClose(cxa_network_tcpServer_connectedClient_t *const superIn);
+static char* scm_getDescriptiveString(cxa_network_tcpServer_connectedClient_t *const superIn);
+
+static void cb_socket_onClosed(cxa_posix_network_socket_t *const sockIn, void* userVarIn);
+
+static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn);
+static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_posix_network_tcpServer_connectedClient_initUnbound(cxa_posix_network_tcpServer_connectedClient_t *const ccIn, int threadIdIn,
+															 cxa_posix_network_tcpServer_connectedClient_cb_onUnbound_t cb_onUnboundIn,
+															 void* userVarIn)
+{
+	cxa_assert(ccIn);
+
+	cxa_network_tcpServer_connectedClient_initUnbound(&ccIn->super, scm_isBound, scm_unbindAndClose, scm_getDescriptiveString);
+
+	ccIn->threadId = threadIdIn;
+	ccIn->descriptiveString[0] = 0;
+	ccIn->cb_onUnbound = cb_onUnboundIn;
+	ccIn->userVar = userVarIn;
+
+	cxa_posix_network_socket_init(&ccIn->socket, NULL, cb_socket_onClosed, (void*)ccIn, &ccIn->super.ioStream, &ccIn->super.logger);
+}
+
+
+bool cxa_posix_network_tcpServer_connectedClient_bindToSocket(cxa_posix_network_tcpServer_connectedClient_t *const ccIn,
+															  int socketIn,
+															  struct sockaddr_storage *const clientAddressIn)
+{
+	cxa_assert(ccIn);
+	cxa_assert(clientAddressIn);
+
+	if( cxa_network_tcpServer_connectedClient_isBound(&ccIn->super) ) return false;
+
+	if( !cxa_posix_network_socket_attach(&ccIn->socket, ccIn->threadId, socketIn, false) ) return false;
+	cxa_ioStream_bind(&ccIn->super.ioStream, cb_ioStream_readByte, cb_ioStream_writeBytes, (void*)ccIn);
+	cxa_ioStream_setNotifiesDataAvailable(&ccIn->super.ioStream, true);
+
+	ccIn->descriptiveString[0] = 0;
+	if( clientAddressIn->ss_family == AF_INET6 )
+	{
+		struct sockaddr_in6* addr6 = (struct sockaddr_in6*)clientAddressIn;
+		inet_ntop(AF_INET6, &addr6->sin6_addr, ccIn->descriptiveString, sizeof(ccIn->descriptiveString));
+		cxa_stringUtils_concat_formattedString(ccIn->descriptiveString, sizeof(ccIn->descriptiveString), "::%d", ntohs(addr6->sin6_port));
+	}
+	else
+	{
+		struct sockaddr_in* addr4 = (struct sockaddr_in*)clientAddressIn;
+		inet_ntop(AF_INET, &addr4->sin_addr, ccIn->descriptiveString, sizeof(ccIn->descriptiveString));
+		cxa_stringUtils_concat_formattedString(ccIn->descriptiveString, sizeof(ccIn->descriptiveString), "::%d", ntohs(addr4->sin_port));
+	}
+
+	cxa_logger_debug(&ccIn->super.logger, "bound to socket %d", socketIn);
+	return true;
+}
+
+
+// ******** local function implementations ********
+static bool scm_isBound(cxa_network_tcpServer_connectedClient_t *const superIn)
+{
+	cxa_posix_network_tcpServer_connectedClient_t* ccIn = (cxa_posix_network_tcpServer_connectedClient_t*)superIn;
+	cxa_assert(ccIn);
+
+	return cxa_ioStream_isBound(&ccIn->super.ioStream);
+}
+
+
+static void scm_unbindAndClose(cxa_network_tcpServer_connectedClient_t *const superIn)
+{
+	cxa_posix_network_tcpServer_connectedClient_t* ccIn = (cxa_posix_network_tcpServer_connectedClient_t*)superIn;
+	cxa_assert(ccIn);
+
+	if( !scm_isBound(&ccIn->super) ) return;
+
+	cxa_logger_debug(&ccIn->super.logger, "unbinding and closing");
+
+	cxa_ioStream_unbind(&ccIn->super.ioStream);
+	cxa_posix_network_socket_close(&ccIn->socket);
+
+	// notify our listeners
+	cxa_network_tcpServer_connectedClient_notifyDisconnected(&ccIn->super);
+
+	// and finally our server (we're free for reuse now)
+	if( ccIn->cb_onUnbound != NULL ) ccIn->cb_onUnbound(ccIn, ccIn->userVar);
+}
+
+
+static char* scm_getDescriptiveString(cxa_network_tcpServer_connectedClient_t *const superIn)
+{
+	cxa_posix_network_tcpServer_connectedClient_t* ccIn = (cxa_posix_network_tcpServer_connectedClient_t*)superIn;
+	cxa_assert(ccIn);
+
+	return ccIn->descriptiveString;
+}
+
+
+static void cb_socket_onClosed(cxa_posix_network_socket_t *const sockIn, void* userVarIn)
+{
+	cxa_posix_network_tcpServer_connectedClient_t* ccIn = (cxa_posix_network_tcpServer_connectedClient_t*)userVarIn;
+	cxa_assert(ccIn);
+
+	scm_unbindAndClose(&ccIn->super);
+}
+
+
+static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn)
+{
+	cxa_posix_network_tcpServer_connectedClient_t* ccIn = (cxa_posix_network_tcpServer_connectedClient_t*)userVarIn;
+	cxa_assert(ccIn);
+
+	return cxa_posix_network_socket_readByte(&ccIn->socket, byteOut);
+}
+
+
+static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
+{
+	cxa_posix_network_tcpServer_connectedClient_t* ccIn = (cxa_posix_network_tcpServer_connectedClient_t*)userVarIn;
+	cxa_assert(ccIn);
+
+	return cxa_posix_network_socket_writeBytes(&ccIn->socket, buffIn, bufferSize_bytesIn, WRITE_TIMEOUT_MS);
+}
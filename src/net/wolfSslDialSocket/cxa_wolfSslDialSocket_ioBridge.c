@@ -0,0 +1,163 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include <cxa_wolfSslDialSocket_ioBridge.h>
+
+
+// ******** includes ********
+#include <string.h>
+
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static void resetRing(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_wolfSslDialSocket_ioBridge_init(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn)
+{
+	cxa_assert(bridgeIn);
+
+	bridgeIn->modemIoStream = NULL;
+	resetRing(bridgeIn);
+}
+
+
+void cxa_wolfSslDialSocket_ioBridge_attach(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn, cxa_ioStream_t *const modemIoStreamIn)
+{
+	cxa_assert(bridgeIn);
+	cxa_assert(modemIoStreamIn);
+
+	bridgeIn->modemIoStream = modemIoStreamIn;
+	resetRing(bridgeIn);
+}
+
+
+void cxa_wolfSslDialSocket_ioBridge_detach(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn)
+{
+	cxa_assert(bridgeIn);
+
+	bridgeIn->modemIoStream = NULL;
+	resetRing(bridgeIn);
+}
+
+
+bool cxa_wolfSslDialSocket_ioBridge_isAttached(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn)
+{
+	cxa_assert(bridgeIn);
+
+	return (bridgeIn->modemIoStream != NULL);
+}
+
+
+size_t cxa_wolfSslDialSocket_ioBridge_fill(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn)
+{
+	cxa_assert(bridgeIn);
+
+	if( (bridgeIn->modemIoStream == NULL) || bridgeIn->hadReadError ) return 0;
+
+	// drain the modem in one burst (rather than a byte per TLS callback), a
+	// block read straight into each free (contiguous) region of the ring
+	size_t numBytesMoved = 0;
+	while( bridgeIn->ring.numBytes < sizeof(bridgeIn->ring.buffer) )
+	{
+		size_t writeIndex = bridgeIn->ring.readIndex + bridgeIn->ring.numBytes;
+		if( writeIndex >= sizeof(bridgeIn->ring.buffer) ) writeIndex -= sizeof(bridgeIn->ring.buffer);
+		size_t numFreeBytes = sizeof(bridgeIn->ring.buffer) - bridgeIn->ring.numBytes;
+		size_t numBytesToEnd = sizeof(bridgeIn->ring.buffer) - writeIndex;
+		size_t maxNumBytes = (numFreeBytes < numBytesToEnd) ? numFreeBytes : numBytesToEnd;
+
+		size_t numBytesRead;
+		cxa_ioStream_readStatus_t readStat = cxa_ioStream_readBytes(bridgeIn->modemIoStream, &bridgeIn->ring.buffer[writeIndex], maxNumBytes, &numBytesRead);
+		if( readStat == CXA_IOSTREAM_READSTAT_NODATA ) break;
+		if( readStat == CXA_IOSTREAM_READSTAT_ERROR )
+		{
+			bridgeIn->hadReadError = true;
+			break;
+		}
+
+		bridgeIn->ring.numBytes += numBytesRead;
+		numBytesMoved += numBytesRead;
+
+		// the modem ran dry before filling this region
+		if( numBytesRead < maxNumBytes ) break;
+	}
+
+	return numBytesMoved;
+}
+
+
+cxa_ioStream_readStatus_t cxa_wolfSslDialSocket_ioBridge_readBlock(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn,
+																	void *const buffOut, size_t maxNumBytesIn,
+																	size_t *const numBytesReadOut)
+{
+	cxa_assert(bridgeIn);
+	if( maxNumBytesIn != 0 ) { cxa_assert(buffOut); }
+
+	if( numBytesReadOut != NULL ) *numBytesReadOut = 0;
+	if( bridgeIn->modemIoStream == NULL ) return CXA_IOSTREAM_READSTAT_ERROR;
+
+	// top up the ring if we can't satisfy the entire request from it
+	if( bridgeIn->ring.numBytes < maxNumBytesIn ) cxa_wolfSslDialSocket_ioBridge_fill(bridgeIn);
+
+	if( bridgeIn->ring.numBytes == 0 )
+	{
+		return bridgeIn->hadReadError ? CXA_IOSTREAM_READSTAT_ERROR : CXA_IOSTREAM_READSTAT_NODATA;
+	}
+	if( maxNumBytesIn == 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+	// copy out in (at most) two contiguous chunks
+	size_t numBytesToCopy = (bridgeIn->ring.numBytes < maxNumBytesIn) ? bridgeIn->ring.numBytes : maxNumBytesIn;
+	size_t numBytesToEnd = sizeof(bridgeIn->ring.buffer) - bridgeIn->ring.readIndex;
+	size_t firstChunkLen_bytes = (numBytesToCopy < numBytesToEnd) ? numBytesToCopy : numBytesToEnd;
+
+	memcpy(buffOut, &bridgeIn->ring.buffer[bridgeIn->ring.readIndex], firstChunkLen_bytes);
+	if( firstChunkLen_bytes < numBytesToCopy )
+	{
+		memcpy(&((uint8_t*)buffOut)[firstChunkLen_bytes], bridgeIn->ring.buffer, numBytesToCopy - firstChunkLen_bytes);
+	}
+
+	bridgeIn->ring.readIndex += numBytesToCopy;
+	if( bridgeIn->ring.readIndex >= sizeof(bridgeIn->ring.buffer) ) bridgeIn->ring.readIndex -= sizeof(bridgeIn->ring.buffer);
+	bridgeIn->ring.numBytes -= numBytesToCopy;
+
+	if( numBytesReadOut != NULL ) *numBytesReadOut = numBytesToCopy;
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
+bool cxa_wolfSslDialSocket_ioBridge_writeBlock(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn,
+											   void *const buffIn, size_t numBytesIn)
+{
+	cxa_assert(bridgeIn);
+
+	if( bridgeIn->modemIoStream == NULL ) return false;
+	if( numBytesIn == 0 ) return true;
+	cxa_assert(buffIn);
+
+	return cxa_ioStream_writeBytes(bridgeIn->modemIoStream, buffIn, numBytesIn);
+}
+
+
+// ******** local function implementations ********
+static void resetRing(cxa_wolfSslDialSocket_ioBridge_t *const bridgeIn)
+{
+	cxa_assert(bridgeIn);
+
+	bridgeIn->hadReadError = false;
+	bridgeIn->ring.readIndex = 0;
+	bridgeIn->ring.numBytes = 0;
+}
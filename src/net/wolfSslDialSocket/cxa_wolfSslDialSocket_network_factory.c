@@ -106,6 +106,13 @@ void cxa_network_factory_freeTcpServer(cxa_network_tcpServer_t *const serverIn)
 }
 
 
+bool cxa_network_factory_preResolveHost(int threadIdIn, const char *const hostNameIn)
+{
+	// the modem resolves host names itself when opening a socket
+	return false;
+}
+
+
 // ******** local function implementations ********
 static void cxa_network_factory_init(void)
 {
@@ -47,6 +47,7 @@ static void scm_disconnectFromHost(cxa_network_tcpClient_t *const superIn);
 static bool scm_isConnected(cxa_network_tcpClient_t *const superIn);
 
 static void stateCb_connecting_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
+static void stateCb_connecting_state(cxa_stateMachine_t *const smIn, void *userVarIn);
 static void stateCb_connected_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void stateCb_connected_leave(cxa_stateMachine_t *const smIn, int nextStateIdIn, void* userVarIn);
 static void stateCb_connectFail_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
@@ -76,7 +77,7 @@ void cxa_wolfSslDialSocket_network_tcpClient_init(cxa_wolfSslDialSocket_network_
 
 	// set some defaults
     netClientIn->modem = modemIn;
-    netClientIn->modemIoStream = NULL;
+    cxa_wolfSslDialSocket_ioBridge_init(&netClientIn->modemBridge);
 	netClientIn->tls.initState.areBasicsInitialized = false;
 	netClientIn->tls.initState.crc_clientCert = 0;
 	netClientIn->tls.initState.crc_clientPrivateKey = 0;
@@ -84,10 +85,15 @@ void cxa_wolfSslDialSocket_network_tcpClient_init(cxa_wolfSslDialSocket_network_
 	netClientIn->targetHostName[0] = 0;
 	netClientIn->targetPortNum = 0;
 	netClientIn->useClientCert = false;
+	netClientIn->isHandshaking = false;
+	netClientIn->connectTimeout_ms = 0;
+	cxa_timeDiff_init(&netClientIn->td_connectTimeout);
+	netClientIn->rxBuffer.readIndex = 0;
+	netClientIn->rxBuffer.numBytes = 0;
 
 	cxa_stateMachine_init(&netClientIn->stateMachine, "tcpClient", threadIdIn);
 	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_IDLE, "idle", NULL, NULL, NULL, (void*)netClientIn);
-	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTING, "connecting", stateCb_connecting_enter, NULL, NULL, (void*)netClientIn);
+	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTING, "connecting", stateCb_connecting_enter, stateCb_connecting_state, NULL, (void*)netClientIn);
 	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECTED, "connected", stateCb_connected_enter, NULL, stateCb_connected_leave, (void*)netClientIn);
 	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_CONNECT_FAIL, "connFail", stateCb_connectFail_enter, NULL, NULL, (void*)netClientIn);
 	cxa_stateMachine_setInitialState(&netClientIn->stateMachine, STATE_IDLE);
@@ -105,6 +111,8 @@ static void cleanupConnectionResources(cxa_wolfSslDialSocket_network_tcpClient_t
 	cxa_logger_debug(&netClientIn->super.logger, "cleanupConnectionResources");
 
 	// "Gracefully shutdown the connection and free associated data"
+	netClientIn->isHandshaking = false;
+	cxa_wolfSslDialSocket_ioBridge_detach(&netClientIn->modemBridge);
 }
 
 
@@ -215,6 +223,7 @@ static bool scm_connectToHost_clientCert(cxa_network_tcpClient_t *const superIn,
         }
 	}
     netClientIn->targetPortNum = portNumIn;
+    netClientIn->connectTimeout_ms = timeout_msIn;
 
 	// SSL configuration
 	cxa_logger_trace(&netClientIn->super.logger, "configuring ssl object");
@@ -260,6 +269,7 @@ static void stateCb_connecting_enter(cxa_stateMachine_t *const smIn, int prevSta
 	cxa_assert(netClientIn);
 
     cxa_logger_info(&netClientIn->super.logger, "connecting to '%s:%d", netClientIn->targetHostName, netClientIn->targetPortNum);
+    netClientIn->isHandshaking = false;
 
     // start our modem connecting
     if( !aq_telitTsvgModem_openSocket(netClientIn->modem, netClientIn->targetHostName, netClientIn->targetPortNum, cb_modem_onSocketConnected, (void*)netClientIn) )
@@ -271,6 +281,43 @@ static void stateCb_connecting_enter(cxa_stateMachine_t *const smIn, int prevSta
 }
 
 
+static void stateCb_connecting_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+{
+	cxa_wolfSslDialSocket_network_tcpClient_t* netClientIn = (cxa_wolfSslDialSocket_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	// wait for the modem to open our socket
+	if( !netClientIn->isHandshaking ) return;
+
+	// move whatever the modem has for us into the bridge, then let the handshake consume it
+	cxa_wolfSslDialSocket_ioBridge_fill(&netClientIn->modemBridge);
+
+	int tmpRet = wolfSSL_connect(netClientIn->tls.ssl);
+	if( tmpRet == SSL_SUCCESS )
+	{
+		cxa_logger_trace(&netClientIn->super.logger, "tls handshake successful");
+		netClientIn->isHandshaking = false;
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED);
+		return;
+	}
+
+	int err = wolfSSL_get_error(netClientIn->tls.ssl, tmpRet);
+	if( (err != SSL_ERROR_WANT_READ) && (err != SSL_ERROR_WANT_WRITE) )
+	{
+		cxa_logger_warn(&netClientIn->super.logger, "failed tls handshake: %d", err);
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
+		return;
+	}
+
+	if( (netClientIn->connectTimeout_ms != 0) && cxa_timeDiff_isElapsed_ms(&netClientIn->td_connectTimeout, netClientIn->connectTimeout_ms) )
+	{
+		cxa_logger_warn(&netClientIn->super.logger, "tls handshake timed out");
+		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
+		return;
+	}
+}
+
+
 static void stateCb_connected_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
 {
 	cxa_wolfSslDialSocket_network_tcpClient_t* netClientIn = (cxa_wolfSslDialSocket_network_tcpClient_t*)userVarIn;
@@ -280,6 +327,8 @@ static void stateCb_connected_enter(cxa_stateMachine_t *const smIn, int prevStat
     cxa_logger_trace(&netClientIn->super.logger, "connected");
 
 	// bind our ioStream
+	netClientIn->rxBuffer.readIndex = 0;
+	netClientIn->rxBuffer.numBytes = 0;
 	cxa_ioStream_bind(&netClientIn->super.ioStream, cb_ioStream_readByte, cb_ioStream_writeBytes, (void*)netClientIn);
 
 	// notify our listeners
@@ -330,13 +379,29 @@ static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, vo
 	cxa_wolfSslDialSocket_network_tcpClient_t* netClientIn = (cxa_wolfSslDialSocket_network_tcpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
-    int tmpRet = wolfSSL_read(netClientIn->tls.ssl, byteOut, 1);
+    // refill our buffer (running the TLS read path once per record rather than once per byte)
+    if( netClientIn->rxBuffer.readIndex >= netClientIn->rxBuffer.numBytes )
+    {
+        int tmpRet = wolfSSL_read(netClientIn->tls.ssl, netClientIn->rxBuffer.buffer, sizeof(netClientIn->rxBuffer.buffer));
+        if( tmpRet == 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+        if( tmpRet < 0 )
+        {
+            int err = wolfSSL_get_error(netClientIn->tls.ssl, tmpRet);
+            if( (err == SSL_ERROR_WANT_READ) || (err == SSL_ERROR_WANT_WRITE) ) return CXA_IOSTREAM_READSTAT_NODATA;
 
-    cxa_logger_trace(&netClientIn->super. logger, "read retVal: %d", tmpRet);
+            cxa_logger_warn(&netClientIn->super.logger, "error during read: %d", err);
+            return CXA_IOSTREAM_READSTAT_ERROR;
+        }
+
+        cxa_logger_trace(&netClientIn->super.logger, "read %d bytes", tmpRet);
+        netClientIn->rxBuffer.readIndex = 0;
+        netClientIn->rxBuffer.numBytes = (size_t)tmpRet;
+    }
 
-    return  ((tmpRet == SSL_ERROR_WANT_READ) || (tmpRet == 0)) ?
-            CXA_IOSTREAM_READSTAT_NODATA :
-            ((tmpRet == 1) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_ERROR);
+    uint8_t rxByte = netClientIn->rxBuffer.buffer[netClientIn->rxBuffer.readIndex++];
+    if( byteOut != NULL ) *byteOut = rxByte;
+
+    return CXA_IOSTREAM_READSTAT_GOTDATA;
 }
 
 
@@ -365,29 +430,21 @@ static int wolfSsl_ioRx(WOLFSSL *ssl, char *buf, int sz, void *ctx)
     cxa_wolfSslDialSocket_network_tcpClient_t* netClientIn = (cxa_wolfSslDialSocket_network_tcpClient_t*)ctx;
 	cxa_assert(netClientIn);
 
-    uint8_t rxByte;
-    int numRxBytes = 0;
-
-    // only try for a short time before yielding to others
-    cxa_timeDiff_t td_timeout;
-    cxa_timeDiff_init(&td_timeout);
-
-    while( numRxBytes < sz )
+    // never block here...wolfSSL will call us again once our state machine has more data
+    size_t numRxBytes = 0;
+    switch( cxa_wolfSslDialSocket_ioBridge_readBlock(&netClientIn->modemBridge, buf, (size_t)sz, &numRxBytes) )
     {
-        if( cxa_ioStream_readByte(netClientIn->modemIoStream, &rxByte) == CXA_IOSTREAM_READSTAT_GOTDATA )
-        {
-            buf[numRxBytes] = rxByte;
-            numRxBytes++;
-        }
-        else
-        {
-//            if( cxa_timeDiff_isElapsed_ms(&td_timeout, 1000) ) break;
-        }
-    }
+        case CXA_IOSTREAM_READSTAT_GOTDATA:
+            cxa_logger_trace(&netClientIn->super.logger, "read %d / %d bytes", (int)numRxBytes, sz);
+            return (int)numRxBytes;
 
-    cxa_logger_trace(&netClientIn->super.logger, "read %d / %d bytes", numRxBytes, sz);
+        case CXA_IOSTREAM_READSTAT_NODATA:
+            return WOLFSSL_CBIO_ERR_WANT_READ;
 
-    return numRxBytes;
+        default:
+            cxa_logger_warn(&netClientIn->super.logger, "read from ioStream failed");
+            return WOLFSSL_CBIO_ERR_CONN_CLOSE;
+    }
 }
 
 
@@ -396,9 +453,9 @@ static int wolfSsl_ioTx(WOLFSSL *ssl, char *buf, int sz, void *ctx)
     cxa_wolfSslDialSocket_network_tcpClient_t* netClientIn = (cxa_wolfSslDialSocket_network_tcpClient_t*)ctx;
 	cxa_assert(netClientIn);
 
-    if( !cxa_ioStream_writeBytes(netClientIn->modemIoStream, buf, sz) )
+    if( !cxa_wolfSslDialSocket_ioBridge_writeBlock(&netClientIn->modemBridge, buf, (size_t)sz) )
     {
-        cxa_logger_warn(&netClientIn->super.logger, "write to ioStream failed", sz);
+        cxa_logger_warn(&netClientIn->super.logger, "write of %d bytes to ioStream failed", sz);
         return WOLFSSL_CBIO_ERR_GENERAL;
     }
 
@@ -429,24 +486,19 @@ static void cb_modem_onSocketConnected(cxa_ioStream_t *const socketIoStreamIn, v
     cxa_wolfSslDialSocket_network_tcpClient_t* netClientIn = (cxa_wolfSslDialSocket_network_tcpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
-    // save our ioStream
-    netClientIn->modemIoStream = socketIoStreamIn;
+    // we may have given up on this connection already
+    if( cxa_stateMachine_getCurrentState(&netClientIn->stateMachine) != STATE_CONNECTING ) return;
+
+    // route the modem socket through our bridge
+    cxa_wolfSslDialSocket_ioBridge_attach(&netClientIn->modemBridge, socketIoStreamIn);
 
     if( netClientIn->useClientCert )
 	{
-        int tmpRet;
-
+        // the handshake itself is driven by our connecting state
+        cxa_network_tcpClient_notify_tlsHandshakeStarting(&netClientIn->super);
         cxa_logger_trace(&netClientIn->super.logger, "performing tls handshake...");
-        if( (tmpRet = wolfSSL_connect(netClientIn->tls.ssl)) != SSL_SUCCESS )
-        {
-            cxa_logger_warn(&netClientIn->super.logger, "failed tls handshake: %s0x%x", tmpRet<0?"-":"", tmpRet<0?-(unsigned)tmpRet:tmpRet);
-            cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECT_FAIL);
-            return;
-        }
-
-        cxa_logger_trace(&netClientIn->super.logger, "tls handshake successful");
+        cxa_timeDiff_setStartTime_now(&netClientIn->td_connectTimeout);
+        netClientIn->isHandshaking = true;
 	}
 	else cxa_assert(false);
-
-	cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_CONNECTED);
 }
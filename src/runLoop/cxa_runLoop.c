@@ -20,6 +20,10 @@
     #include "freertos/FreeRTOS.h"
     #include "freertos/task.h"
     #include <esp_task_wdt.h>
+#elif defined(__linux__) || defined(__APPLE__)
+	// posix
+	#include <pthread.h>
+	#include <time.h>
 #endif
 
 
@@ -28,6 +32,8 @@
 #include <cxa_config.h>
 
 // ******** local macro definitions ********
+#define HANDLE_GET_INDEX(handleIn)				((size_t)((handleIn) & 0xFFFF) - 1)
+#define HANDLE_GET_GENERATION(handleIn)			((uint16_t)((handleIn) >> 16))
 
 
 // ******** local type definitions ********
@@ -51,37 +57,72 @@ typedef struct
 {
 	state_t state;
 	type_t type;
+	uint16_t generation;
 
 	int threadId;
 
 	uint32_t execPeriod_ms;
 	cxa_timeDiff_t td_exec;
 
+	volatile bool isSuspended;
+	bool hasWakeTime;
+	uint32_t wakeDelay_ms;
+	cxa_timeDiff_t td_wake;
+
 	cxa_runLoop_cb_t startupCb;
 	cxa_runLoop_cb_t updateCb;
 	void *userVar;
-}cxa_runLoop_entry_t;
+}entry_t;
+
+
+typedef struct
+{
+	int threadId;
+	cxa_runLoop_cb_waitForEvents_t cb_wait;
+	cxa_runLoop_cb_t cb_wake;
+	void *userVar;
+
+	bool isWaiting;
+	bool hasJustWaited;
+}eventSource_t;
 
 
 // ******** local function prototypes ********
 static void init(void);
-static cxa_runLoop_entry_t* reserveUnusedEntry(void);
+static entry_t* reserveUnusedEntry(void);
+static entry_t* getEntry_byHandle(cxa_runLoop_entryHandle_t handleIn);
+static cxa_runLoop_entryHandle_t getHandle(entry_t *const entryIn);
+static bool shouldRunEntry(entry_t *const entryIn);
+
+static void idle_prepare(void);
+static void idle_wait(int threadIdIn, uint32_t duration_msIn);
+static void idle_wake(void);
+static void idle_setSuspended(entry_t *const entryIn, bool isSuspendedIn);
 
 
 // ********  local variable declarations *********
 static bool isInit = false;
 
-static cxa_runLoop_entry_t entries[CXA_RUNLOOP_MAXNUM_ENTRIES];
+static entry_t entries[CXA_RUNLOOP_MAXNUM_ENTRIES];
 
 static cxa_logger_t logger;
 
+#if !defined(ESP32) && (defined(__linux__) || defined(__APPLE__))
+static pthread_mutex_t idle_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t idle_condOnce = PTHREAD_ONCE_INIT;
+static pthread_cond_t idle_cond;
+static bool idle_isWakePending = false;
+
+static eventSource_t eventSource = {.cb_wait = NULL};
+#endif
+
 
 // ******** global function implementations ********
-void cxa_runLoop_addEntry(int threadIdIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+cxa_runLoop_entryHandle_t cxa_runLoop_addEntry(int threadIdIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
 {
 	if( !isInit ) init();
 
-	cxa_runLoop_entry_t* newEntry = reserveUnusedEntry();
+	entry_t* newEntry = reserveUnusedEntry();
 	cxa_assert_msg(newEntry, "increase CXA_RUNLOOP_MAXNUM_ENTRIES");
 
 	newEntry->threadId = threadIdIn;
@@ -91,15 +132,20 @@ void cxa_runLoop_addEntry(int threadIdIn, cxa_runLoop_cb_t startupCbIn, cxa_runL
 	newEntry->updateCb=updateCbIn;
 	newEntry->userVar=userVarIn;
 	cxa_timeDiff_init(&newEntry->td_exec);
+	newEntry->isSuspended = false;
+	newEntry->hasWakeTime = false;
 	newEntry->state = STATE_RESERVED_CONFIGURED_UNSTARTED;
+	idle_wake();
+
+	return getHandle(newEntry);
 }
 
 
-void cxa_runLoop_addTimedEntry(int threadIdIn, uint32_t execPeriod_msIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
+cxa_runLoop_entryHandle_t cxa_runLoop_addTimedEntry(int threadIdIn, uint32_t execPeriod_msIn, cxa_runLoop_cb_t startupCbIn, cxa_runLoop_cb_t updateCbIn, void *const userVarIn)
 {
 	if( !isInit ) init();
 
-	cxa_runLoop_entry_t* newEntry = reserveUnusedEntry();
+	entry_t* newEntry = reserveUnusedEntry();
 	cxa_assert_msg(newEntry, "increase CXA_RUNLOOP_MAXNUM_ENTRIES");
 
 	newEntry->threadId = threadIdIn;
@@ -109,7 +155,12 @@ void cxa_runLoop_addTimedEntry(int threadIdIn, uint32_t execPeriod_msIn, cxa_run
 	newEntry->updateCb=updateCbIn;
 	newEntry->userVar=userVarIn;
 	cxa_timeDiff_init(&newEntry->td_exec);
+	newEntry->isSuspended = false;
+	newEntry->hasWakeTime = false;
 	newEntry->state = STATE_RESERVED_CONFIGURED_UNSTARTED;
+	idle_wake();
+
+	return getHandle(newEntry);
 }
 
 
@@ -117,6 +168,67 @@ void cxa_runLoop_clearAllEntries(void)
 {
 	isInit = false;
 	init();
+
+	// outstanding handles must not match whatever reuses these entries
+	for( size_t i = 0; i < sizeof(entries)/sizeof(*entries); i++ )
+	{
+		entries[i].generation++;
+	}
+}
+
+
+void cxa_runLoop_entry_suspend(cxa_runLoop_entryHandle_t entryIn)
+{
+	entry_t* entry = getEntry_byHandle(entryIn);
+	if( entry == NULL ) return;
+
+	entry->hasWakeTime = false;
+	idle_setSuspended(entry, true);
+}
+
+
+void cxa_runLoop_entry_resume(cxa_runLoop_entryHandle_t entryIn)
+{
+	entry_t* entry = getEntry_byHandle(entryIn);
+	if( entry == NULL ) return;
+
+	// clears the flag under the idle lock so a thread about to sleep can't miss it
+	idle_setSuspended(entry, false);
+}
+
+
+void cxa_runLoop_entry_resumeAfter(cxa_runLoop_entryHandle_t entryIn, uint32_t delay_msIn)
+{
+	entry_t* entry = getEntry_byHandle(entryIn);
+	if( entry == NULL ) return;
+
+	entry->wakeDelay_ms = delay_msIn;
+	cxa_timeDiff_setStartTime_now(&entry->td_wake);
+	entry->hasWakeTime = true;
+
+	// our deadline may be earlier than the current sleep (wakes the thread)
+	idle_setSuspended(entry, true);
+}
+
+
+void cxa_runLoop_setEventSource(int threadIdIn, cxa_runLoop_cb_waitForEvents_t cb_waitIn, cxa_runLoop_cb_t cb_wakeIn, void *const userVarIn)
+{
+	cxa_assert(cb_waitIn);
+	cxa_assert(cb_wakeIn);
+
+#if !defined(ESP32) && (defined(__linux__) || defined(__APPLE__))
+	pthread_mutex_lock(&idle_mutex);
+	cxa_assert_msg((eventSource.cb_wait == NULL), "only one runLoop event source is supported");
+	eventSource.threadId = threadIdIn;
+	eventSource.cb_wake = cb_wakeIn;
+	eventSource.userVar = userVarIn;
+	eventSource.isWaiting = false;
+	eventSource.hasJustWaited = false;
+	eventSource.cb_wait = cb_waitIn;
+	pthread_mutex_unlock(&idle_mutex);
+#else
+	cxa_assert_msg(false, "runLoop event sources are only supported on posix");
+#endif
 }
 
 
@@ -124,7 +236,7 @@ void cxa_runLoop_dispatchNextIteration(int threadIdIn, cxa_runLoop_cb_t updateCb
 {
 	if( !isInit ) init();
 
-	cxa_runLoop_entry_t* newEntry = reserveUnusedEntry();
+	entry_t* newEntry = reserveUnusedEntry();
 	cxa_assert_msg(newEntry, "increase CXA_RUNLOOP_MAXNUM_ENTRIES");
 
 	newEntry->threadId = threadIdIn;
@@ -134,7 +246,10 @@ void cxa_runLoop_dispatchNextIteration(int threadIdIn, cxa_runLoop_cb_t updateCb
 	newEntry->updateCb=updateCbIn;
 	newEntry->userVar=userVarIn;
 	cxa_timeDiff_init(&newEntry->td_exec);
+	newEntry->isSuspended = false;
+	newEntry->hasWakeTime = false;
 	newEntry->state = STATE_RESERVED_CONFIGURED_UNSTARTED;
+	idle_wake();
 }
 
 
@@ -142,7 +257,7 @@ void cxa_runLoop_dispatchAfter(int threadIdIn, uint32_t delay_msIn, cxa_runLoop_
 {
 	if( !isInit ) init();
 
-	cxa_runLoop_entry_t* newEntry = reserveUnusedEntry();
+	entry_t* newEntry = reserveUnusedEntry();
 	cxa_assert_msg(newEntry, "increase CXA_RUNLOOP_MAXNUM_ENTRIES");
 
 	newEntry->threadId = threadIdIn;
@@ -152,7 +267,10 @@ void cxa_runLoop_dispatchAfter(int threadIdIn, uint32_t delay_msIn, cxa_runLoop_
 	newEntry->updateCb=updateCbIn;
 	newEntry->userVar=userVarIn;
 	cxa_timeDiff_init(&newEntry->td_exec);
+	newEntry->isSuspended = false;
+	newEntry->hasWakeTime = false;
 	newEntry->state = STATE_RESERVED_CONFIGURED_UNSTARTED;
+	idle_wake();
 }
 
 
@@ -160,7 +278,17 @@ uint32_t cxa_runLoop_iterate(int threadIdIn)
 {
 	if( !isInit ) init();
 
-	uint32_t iter_startTime_us = cxa_timeBase_getCount_us();
+	// 64-bit count so we don't need to worry about the timeBase wrapping
+	uint64_t iter_startTime_us = cxa_timeBase_getCount64_us();
+
+#if !defined(ESP32) && (defined(__linux__) || defined(__APPLE__))
+	// pick up external events (unless we just waited for them)
+	if( (eventSource.cb_wait != NULL) && (eventSource.threadId == threadIdIn) )
+	{
+		if( !eventSource.hasJustWaited ) eventSource.cb_wait(0, eventSource.userVar);
+		eventSource.hasJustWaited = false;
+	}
+#endif
 
 	// iterate first and make sure all of our entries have been started
 	for( size_t i = 0; i < sizeof(entries)/sizeof(*entries); i++ )
@@ -181,8 +309,7 @@ uint32_t cxa_runLoop_iterate(int threadIdIn)
 		{
 			// we know this is valid callback for this thread...
 			// if it's timed, make sure we're calling it at the right pace
-			if( (entries[i].execPeriod_ms == 0) ||
-				 cxa_timeDiff_isElapsed_recurring_ms(&entries[i].td_exec, entries[i].execPeriod_ms) )
+			if( shouldRunEntry(&entries[i]) )
 			{
 				if( entries[i].updateCb != NULL ) entries[i].updateCb(entries[i].userVar);
 
@@ -200,7 +327,7 @@ uint32_t cxa_runLoop_iterate(int threadIdIn)
 	taskYIELD();
 #endif
 
-	return cxa_timeBase_getCount_us() - iter_startTime_us;
+	return (uint32_t)(cxa_timeBase_getCount64_us() - iter_startTime_us);
 }
 
 
@@ -211,11 +338,58 @@ void cxa_runLoop_execute(int threadIdIn)
 	// start the iterations
 	while(1)
 	{
-		cxa_runLoop_iterate(threadIdIn);
+		cxa_runLoop_executeOnce(threadIdIn, CXA_RUNLOOP_MAXIDLETIME_MS);
 	}
 }
 
 
+void cxa_runLoop_executeOnce(int threadIdIn, uint32_t maxIdleTime_msIn)
+{
+	if( !isInit ) init();
+
+	cxa_runLoop_iterate(threadIdIn);
+
+	// sleep until our next entry needs to run (any resume from here on wakes us)
+	idle_prepare();
+	uint32_t idleTime_ms = cxa_runLoop_getTimeUntilNextEntry_ms(threadIdIn);
+	if( idleTime_ms > maxIdleTime_msIn ) idleTime_ms = maxIdleTime_msIn;
+	if( idleTime_ms > 0 ) idle_wait(threadIdIn, idleTime_ms);
+}
+
+
+uint32_t cxa_runLoop_getTimeUntilNextEntry_ms(int threadIdIn)
+{
+	if( !isInit ) init();
+
+	uint32_t retVal_ms = UINT32_MAX;
+	for( size_t i = 0; i < sizeof(entries)/sizeof(*entries); i++ )
+	{
+		if( (entries[i].threadId != threadIdIn) || (entries[i].state == STATE_UNUSED) || (entries[i].state == STATE_RESERVED_CONFIGURING) ) continue;
+
+		// unstarted entries need to be started
+		if( entries[i].state == STATE_RESERVED_CONFIGURED_UNSTARTED ) return 0;
+
+		uint32_t currDelay_ms;
+		if( entries[i].isSuspended )
+		{
+			if( !entries[i].hasWakeTime ) continue;
+			uint32_t elapsed_ms = cxa_timeDiff_getElapsedTime_ms(&entries[i].td_wake);
+			currDelay_ms = (elapsed_ms < entries[i].wakeDelay_ms) ? (entries[i].wakeDelay_ms - elapsed_ms) : 0;
+		}
+		else
+		{
+			uint32_t elapsed_ms = cxa_timeDiff_getElapsedTime_ms(&entries[i].td_exec);
+			currDelay_ms = (elapsed_ms < entries[i].execPeriod_ms) ? (entries[i].execPeriod_ms - elapsed_ms) : 0;
+		}
+
+		if( currDelay_ms == 0 ) return 0;
+		if( currDelay_ms < retVal_ms ) retVal_ms = currDelay_ms;
+	}
+
+	return retVal_ms;
+}
+
+
 // ******** local function implementations ********
 static void init(void)
 {
@@ -231,12 +405,14 @@ static void init(void)
 }
 
 
-static cxa_runLoop_entry_t* reserveUnusedEntry(void)
+static entry_t* reserveUnusedEntry(void)
 {
 	for( size_t i = 0; i < sizeof(entries)/sizeof(*entries); i++ )
 	{
 		if( entries[i].state == STATE_UNUSED )
 		{
+			// invalidates any handle to the previous user of this entry
+			entries[i].generation++;
 			entries[i].state = STATE_RESERVED_CONFIGURING;
 			return &entries[i];
 		}
@@ -244,3 +420,174 @@ static cxa_runLoop_entry_t* reserveUnusedEntry(void)
 
 	return NULL;
 }
+
+
+static entry_t* getEntry_byHandle(cxa_runLoop_entryHandle_t handleIn)
+{
+	if( handleIn == CXA_RUNLOOP_ENTRYHANDLE_INVALID ) return NULL;
+
+	size_t index = HANDLE_GET_INDEX(handleIn);
+	if( index >= sizeof(entries)/sizeof(*entries) ) return NULL;
+
+	entry_t* retVal = &entries[index];
+	return ((retVal->generation == HANDLE_GET_GENERATION(handleIn)) && (retVal->state != STATE_UNUSED)) ? retVal : NULL;
+}
+
+
+static cxa_runLoop_entryHandle_t getHandle(entry_t *const entryIn)
+{
+	cxa_assert(entryIn);
+
+	return ((cxa_runLoop_entryHandle_t)entryIn->generation << 16) | (cxa_runLoop_entryHandle_t)((entryIn - entries) + 1);
+}
+
+
+static bool shouldRunEntry(entry_t *const entryIn)
+{
+	cxa_assert(entryIn);
+
+	// suspended entries only run once their wake time (if any) arrives
+	if( entryIn->isSuspended )
+	{
+		if( !entryIn->hasWakeTime || !cxa_timeDiff_isElapsed_ms(&entryIn->td_wake, entryIn->wakeDelay_ms) ) return false;
+		entryIn->hasWakeTime = false;
+		entryIn->isSuspended = false;
+	}
+
+	return (entryIn->execPeriod_ms == 0) || cxa_timeDiff_isElapsed_recurring_ms(&entryIn->td_exec, entryIn->execPeriod_ms);
+}
+
+
+#if !defined(ESP32) && (defined(__linux__) || defined(__APPLE__))
+static void idle_initCond(void)
+{
+#ifdef __APPLE__
+	// no pthread_condattr_setclock, idle_wait uses a relative timeout instead
+	pthread_cond_init(&idle_cond, NULL);
+#else
+	// wait against the monotonic clock so wall-clock steps don't stretch (or cut) our sleep
+	pthread_condattr_t attr;
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&idle_cond, &attr);
+	pthread_condattr_destroy(&attr);
+#endif
+}
+
+
+static void idle_prepare(void)
+{
+	pthread_once(&idle_condOnce, idle_initCond);
+
+	pthread_mutex_lock(&idle_mutex);
+	idle_isWakePending = false;
+	pthread_mutex_unlock(&idle_mutex);
+}
+
+
+static void idle_wait(int threadIdIn, uint32_t duration_msIn)
+{
+	pthread_once(&idle_condOnce, idle_initCond);
+
+	if( (eventSource.cb_wait != NULL) && (eventSource.threadId == threadIdIn) )
+	{
+		// flag the wait under our lock so a concurrent resume knows to call cb_wake
+		pthread_mutex_lock(&idle_mutex);
+		bool isWakePending = idle_isWakePending;
+		eventSource.isWaiting = !isWakePending;
+		pthread_mutex_unlock(&idle_mutex);
+
+		eventSource.cb_wait((isWakePending ? 0 : duration_msIn), eventSource.userVar);
+		eventSource.hasJustWaited = true;
+
+		pthread_mutex_lock(&idle_mutex);
+		eventSource.isWaiting = false;
+		pthread_mutex_unlock(&idle_mutex);
+		return;
+	}
+
+#ifdef __APPLE__
+	struct timespec timeout;
+	timeout.tv_sec = duration_msIn / 1000;
+	timeout.tv_nsec = (long)(duration_msIn % 1000) * 1000000;
+
+	pthread_mutex_lock(&idle_mutex);
+	if( !idle_isWakePending ) pthread_cond_timedwait_relative_np(&idle_cond, &idle_mutex, &timeout);
+	pthread_mutex_unlock(&idle_mutex);
+#else
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_sec += duration_msIn / 1000;
+	deadline.tv_nsec += (long)(duration_msIn % 1000) * 1000000;
+	if( deadline.tv_nsec >= 1000000000 )
+	{
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000;
+	}
+
+	pthread_mutex_lock(&idle_mutex);
+	while( !idle_isWakePending )
+	{
+		if( pthread_cond_timedwait(&idle_cond, &idle_mutex, &deadline) != 0 ) break;
+	}
+	pthread_mutex_unlock(&idle_mutex);
+#endif
+}
+
+
+static void idle_wake(void)
+{
+	pthread_once(&idle_condOnce, idle_initCond);
+
+	pthread_mutex_lock(&idle_mutex);
+	idle_isWakePending = true;
+	pthread_cond_broadcast(&idle_cond);
+	bool shouldWakeEventSource = eventSource.isWaiting;
+	pthread_mutex_unlock(&idle_mutex);
+
+	if( shouldWakeEventSource ) eventSource.cb_wake(eventSource.userVar);
+}
+
+
+static void idle_setSuspended(entry_t *const entryIn, bool isSuspendedIn)
+{
+	pthread_once(&idle_condOnce, idle_initCond);
+
+	pthread_mutex_lock(&idle_mutex);
+	entryIn->isSuspended = isSuspendedIn;
+	idle_isWakePending = true;
+	pthread_cond_broadcast(&idle_cond);
+	bool shouldWakeEventSource = eventSource.isWaiting;
+	pthread_mutex_unlock(&idle_mutex);
+
+	if( shouldWakeEventSource ) eventSource.cb_wake(eventSource.userVar);
+}
+#else
+static void idle_prepare(void)
+{
+}
+
+
+static void idle_wait(int threadIdIn, uint32_t duration_msIn)
+{
+	(void)threadIdIn;
+#ifdef INC_FREERTOS_H
+	TickType_t numTicks = pdMS_TO_TICKS(duration_msIn);
+	if( numTicks > 0 ) vTaskDelay(numTicks);
+#else
+	// no portable way to sleep...keep iterating
+	(void)duration_msIn;
+#endif
+}
+
+
+static void idle_wake(void)
+{
+}
+
+
+static void idle_setSuspended(entry_t *const entryIn, bool isSuspendedIn)
+{
+	entryIn->isSuspended = isSuspendedIn;
+}
+#endif
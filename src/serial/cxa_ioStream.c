@@ -17,6 +17,7 @@
 #include <cxa_assert.h>
 #include <cxa_config.h>
 #include <cxa_numberUtils.h>
+#include <cxa_stringUtils.h>
 #include <cxa_timeDiff.h>
 
 
@@ -45,6 +46,8 @@ void cxa_ioStream_init(cxa_ioStream_t *const ioStreamIn)
 	cxa_assert(ioStreamIn);
 
 	// setup our internal state
+	ioStreamIn->cb_onDataAvailable = NULL;
+	ioStreamIn->onDataAvailable_userVar = NULL;
 	cxa_ioStream_unbind(ioStreamIn);
 }
 
@@ -55,8 +58,13 @@ void cxa_ioStream_bind(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readByt
 
 	// save our references
 	ioStreamIn->readCb = readCbIn;
+	ioStreamIn->readBytesCb = NULL;
 	ioStreamIn->writeCb = writeCbIn;
 	ioStreamIn->userVar = userVarIn;
+	ioStreamIn->notifiesDataAvailable = false;
+
+	// our reader may be waiting for us
+	cxa_ioStream_notify_dataAvailable(ioStreamIn);
 }
 
 
@@ -65,8 +73,13 @@ void cxa_ioStream_unbind(cxa_ioStream_t *const ioStreamIn)
 	cxa_assert(ioStreamIn);
 
 	ioStreamIn->readCb = NULL;
+	ioStreamIn->readBytesCb = NULL;
 	ioStreamIn->writeCb = NULL;
 	ioStreamIn->userVar = NULL;
+	ioStreamIn->notifiesDataAvailable = false;
+
+	// let our reader see that we're gone
+	cxa_ioStream_notify_dataAvailable(ioStreamIn);
 }
 
 
@@ -78,6 +91,47 @@ bool cxa_ioStream_isBound(cxa_ioStream_t *const ioStreamIn)
 }
 
 
+void cxa_ioStream_setDataAvailableListener(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_onDataAvailable_t cbIn, void *const userVarIn)
+{
+	cxa_assert(ioStreamIn);
+
+	ioStreamIn->cb_onDataAvailable = cbIn;
+	ioStreamIn->onDataAvailable_userVar = userVarIn;
+}
+
+
+bool cxa_ioStream_notifiesDataAvailable(cxa_ioStream_t *const ioStreamIn)
+{
+	cxa_assert(ioStreamIn);
+
+	return !cxa_ioStream_isBound(ioStreamIn) || ioStreamIn->notifiesDataAvailable;
+}
+
+
+void cxa_ioStream_setNotifiesDataAvailable(cxa_ioStream_t *const ioStreamIn, bool notifiesIn)
+{
+	cxa_assert(ioStreamIn);
+
+	ioStreamIn->notifiesDataAvailable = notifiesIn;
+}
+
+
+void cxa_ioStream_notify_dataAvailable(cxa_ioStream_t *const ioStreamIn)
+{
+	cxa_assert(ioStreamIn);
+
+	if( ioStreamIn->cb_onDataAvailable != NULL ) ioStreamIn->cb_onDataAvailable(ioStreamIn, ioStreamIn->onDataAvailable_userVar);
+}
+
+
+void cxa_ioStream_setReadBytesCb(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readBytes_t readBytesCbIn)
+{
+	cxa_assert(ioStreamIn);
+
+	ioStreamIn->readBytesCb = readBytesCbIn;
+}
+
+
 cxa_ioStream_readStatus_t cxa_ioStream_readByte(cxa_ioStream_t *const ioStreamIn, uint8_t *const byteOut)
 {
 	cxa_assert(ioStreamIn);
@@ -89,6 +143,41 @@ cxa_ioStream_readStatus_t cxa_ioStream_readByte(cxa_ioStream_t *const ioStreamIn
 }
 
 
+cxa_ioStream_readStatus_t cxa_ioStream_readBytes(cxa_ioStream_t *const ioStreamIn, void *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut)
+{
+	cxa_assert(ioStreamIn);
+	if( maxNumBytesIn > 0 ) cxa_assert(buffOut);
+
+	if( numBytesReadOut != NULL ) *numBytesReadOut = 0;
+
+	// make sure we're bound
+	if( !cxa_ioStream_isBound(ioStreamIn) ) return CXA_IOSTREAM_READSTAT_ERROR;
+	if( maxNumBytesIn == 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+	if( ioStreamIn->readBytesCb != NULL )
+	{
+		size_t numBytesRead = 0;
+		cxa_ioStream_readStatus_t retVal = ioStreamIn->readBytesCb(buffOut, maxNumBytesIn, &numBytesRead, ioStreamIn->userVar);
+		if( numBytesReadOut != NULL ) *numBytesReadOut = numBytesRead;
+		return retVal;
+	}
+
+	// no block read...one byte at a time
+	uint8_t* currByte = (uint8_t*)buffOut;
+	size_t numBytesRead = 0;
+	cxa_ioStream_readStatus_t readStat = CXA_IOSTREAM_READSTAT_NODATA;
+	while( numBytesRead < maxNumBytesIn )
+	{
+		readStat = ioStreamIn->readCb(&currByte[numBytesRead], ioStreamIn->userVar);
+		if( readStat != CXA_IOSTREAM_READSTAT_GOTDATA ) break;
+		numBytesRead++;
+	}
+
+	if( numBytesReadOut != NULL ) *numBytesReadOut = numBytesRead;
+	return (numBytesRead > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : readStat;
+}
+
+
 bool cxa_ioStream_waitForCharSequence_withTimeout(cxa_ioStream_t *const ioStreamIn, const char* targetSeqIn, uint32_t timeout_msIn)
 {
 	cxa_assert(ioStreamIn);
@@ -183,6 +272,42 @@ bool cxa_ioStream_writeLine(cxa_ioStream_t *const ioStreamIn, const char* string
 }
 
 
+bool cxa_ioStream_writeUint32(cxa_ioStream_t *const ioStreamIn, uint32_t valIn)
+{
+	cxa_assert(ioStreamIn);
+
+	char buff[CXA_STRINGUTILS_NUMBERSTRING_MAXLEN_BYTES];
+	return cxa_ioStream_writeBytes(ioStreamIn, buff, cxa_stringUtils_formatUint32(valIn, buff, sizeof(buff)));
+}
+
+
+bool cxa_ioStream_writeInt32(cxa_ioStream_t *const ioStreamIn, int32_t valIn)
+{
+	cxa_assert(ioStreamIn);
+
+	char buff[CXA_STRINGUTILS_NUMBERSTRING_MAXLEN_BYTES];
+	return cxa_ioStream_writeBytes(ioStreamIn, buff, cxa_stringUtils_formatInt32(valIn, buff, sizeof(buff)));
+}
+
+
+bool cxa_ioStream_writeHex(cxa_ioStream_t *const ioStreamIn, uint32_t valIn, uint8_t minNumDigitsIn)
+{
+	cxa_assert(ioStreamIn);
+
+	char buff[CXA_STRINGUTILS_NUMBERSTRING_MAXLEN_BYTES];
+	return cxa_ioStream_writeBytes(ioStreamIn, buff, cxa_stringUtils_formatHex(valIn, minNumDigitsIn, buff, sizeof(buff)));
+}
+
+
+bool cxa_ioStream_writeFixed(cxa_ioStream_t *const ioStreamIn, int32_t valIn, uint8_t numFracDigitsIn)
+{
+	cxa_assert(ioStreamIn);
+
+	char buff[CXA_STRINGUTILS_NUMBERSTRING_MAXLEN_BYTES];
+	return cxa_ioStream_writeBytes(ioStreamIn, buff, cxa_stringUtils_formatFixed(valIn, numFracDigitsIn, buff, sizeof(buff)));
+}
+
+
 bool cxa_ioStream_writeFormattedString(cxa_ioStream_t *const ioStreamIn, const char* formatIn, ...)
 {
 	cxa_assert(ioStreamIn);
@@ -234,7 +359,7 @@ bool cxa_ioStream_vWriteString(cxa_ioStream_t *const ioStreamIn,
 
 	// now do our VARARGS
 	size_t expectedNumBytesWritten = vsnprintf(buff, sizeof(buff), formatIn, argsIn);
-	if( sizeof(buff) >= expectedNumBytesWritten )
+	if( sizeof(buff) > expectedNumBytesWritten )
 	{
 		// our buffer fits the string...write it
 		retVal = cxa_ioStream_writeBytes(ioStreamIn, buff, CXA_MIN(expectedNumBytesWritten, sizeof(buff)));
@@ -242,7 +367,7 @@ bool cxa_ioStream_vWriteString(cxa_ioStream_t *const ioStreamIn,
 	else if( truncateIfTooLargeIn)
 	{
 		// our buffer doesn't fit the string, but we've been instructed to truncate
-		retVal = cxa_ioStream_writeBytes(ioStreamIn, buff, CXA_MIN(expectedNumBytesWritten, sizeof(buff)));
+		retVal = cxa_ioStream_writeBytes(ioStreamIn, buff, CXA_MIN(expectedNumBytesWritten, sizeof(buff)-1));
 		if( truncateStringIn != NULL ) retVal = cxa_ioStream_writeString(ioStreamIn, (char*)truncateStringIn);
 	}
 
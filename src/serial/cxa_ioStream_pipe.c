@@ -25,6 +25,9 @@ static cxa_ioStream_readStatus_t read_cb_ep1(uint8_t *const byteOut, void *const
 static bool write_cb_ep1(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 static cxa_ioStream_readStatus_t read_cb_ep2(uint8_t *const byteOut, void *const userVarIn);
 static bool write_cb_ep2(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb_ep1(void *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb_ep2(void *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytesFromFifo(cxa_fixedFifo_t *const fifoIn, void *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut);
 
 
 // ********  local variable declarations *********
@@ -38,10 +41,12 @@ void cxa_ioStream_pipe_init(cxa_ioStream_pipe_t *const ioStreamIn)
 	// initialize our ioStreams
 	cxa_ioStream_init(&ioStreamIn->endPoint1);
 	cxa_ioStream_bind(&ioStreamIn->endPoint1, read_cb_ep1, write_cb_ep1, (void*)ioStreamIn);
+	cxa_ioStream_setReadBytesCb(&ioStreamIn->endPoint1, readBytes_cb_ep1);
 	cxa_fixedFifo_initStd(&ioStreamIn->fifo_ep1Read, CXA_FF_ON_FULL_DROP, ioStreamIn->fifo_ep1Read_raw);
 
 	cxa_ioStream_init(&ioStreamIn->endPoint2);
 	cxa_ioStream_bind(&ioStreamIn->endPoint2, read_cb_ep2, write_cb_ep2, (void*)ioStreamIn);
+	cxa_ioStream_setReadBytesCb(&ioStreamIn->endPoint2, readBytes_cb_ep2);
 	cxa_fixedFifo_initStd(&ioStreamIn->fifo_ep2Read, CXA_FF_ON_FULL_DROP, ioStreamIn->fifo_ep2Read_raw);
 }
 
@@ -106,3 +111,45 @@ static bool write_cb_ep2(void* buffIn, size_t bufferSize_bytesIn, void *const us
 
 	return true;
 }
+
+
+static cxa_ioStream_readStatus_t readBytes_cb_ep1(void *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_ioStream_pipe_t* ioStreamIn = (cxa_ioStream_pipe_t*)userVarIn;
+
+	return readBytesFromFifo(&ioStreamIn->fifo_ep1Read, buffOut, maxNumBytesIn, numBytesReadOut);
+}
+
+
+static cxa_ioStream_readStatus_t readBytes_cb_ep2(void *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_ioStream_pipe_t* ioStreamIn = (cxa_ioStream_pipe_t*)userVarIn;
+
+	return readBytesFromFifo(&ioStreamIn->fifo_ep2Read, buffOut, maxNumBytesIn, numBytesReadOut);
+}
+
+
+static cxa_ioStream_readStatus_t readBytesFromFifo(cxa_fixedFifo_t *const fifoIn, void *const buffOut, size_t maxNumBytesIn, size_t *const numBytesReadOut)
+{
+	cxa_assert(fifoIn);
+	cxa_assert(numBytesReadOut);
+
+	// at most two contiguous regions (if the fifo has wrapped)
+	size_t numBytesRead = 0;
+	for( int i = 0; (i < 2) && (numBytesRead < maxNumBytesIn); i++ )
+	{
+		void* contiguousBytes;
+		size_t numContiguousBytes = cxa_fixedFifo_bulkDequeue_peek(fifoIn, &contiguousBytes);
+		if( numContiguousBytes == 0 ) break;
+
+		size_t numBytesToCopy = (numContiguousBytes < (maxNumBytesIn - numBytesRead)) ? numContiguousBytes : (maxNumBytesIn - numBytesRead);
+		memcpy(&((uint8_t*)buffOut)[numBytesRead], contiguousBytes, numBytesToCopy);
+		cxa_fixedFifo_bulkDequeue(fifoIn, numBytesToCopy);
+		numBytesRead += numBytesToCopy;
+	}
+
+	*numBytesReadOut = numBytesRead;
+	return (numBytesRead > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_NODATA;
+}
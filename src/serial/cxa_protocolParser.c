@@ -22,6 +22,7 @@
 
 
 // ******** local function prototypes ********
+static void cb_ioStream_onDataAvailable(cxa_ioStream_t *const ioStreamIn, void *const userVarIn);
 
 
 // ********  local variable declarations *********
@@ -43,6 +44,7 @@ void cxa_protocolParser_init(cxa_protocolParser_t *const ppIn, cxa_ioStream_t *c
 
 	// save our references
 	ppIn->ioStream = ioStreamIn;
+	ppIn->rxStateMachine = NULL;
 	ppIn->currBuffer = buffIn;
 	ppIn->scm_canSetBuffer = scm_canSetBufferIn;
 	ppIn->scm_gotoIdle = scm_gotoIdleIn;
@@ -110,6 +112,7 @@ void cxa_protocolParser_setBuffer(cxa_protocolParser_t *const ppIn, cxa_fixedByt
 		// set the buffer
 		// (state machine will take care of starting automatically if needed)
 		ppIn->currBuffer = buffIn;
+		if( ppIn->rxStateMachine != NULL ) cxa_stateMachine_kick(ppIn->rxStateMachine);
 	}
 	else
 	{
@@ -119,6 +122,7 @@ void cxa_protocolParser_setBuffer(cxa_protocolParser_t *const ppIn, cxa_fixedByt
 		// set the buffer
 		// (state machine will take care of starting automatically)
 		ppIn->currBuffer = buffIn;
+		if( ppIn->rxStateMachine != NULL ) cxa_stateMachine_kick(ppIn->rxStateMachine);
 	}
 }
 
@@ -158,6 +162,30 @@ void cxa_protocolParser_resetError(cxa_protocolParser_t *const ppIn)
 }
 
 
+void cxa_protocolParser_setRxStateMachine(cxa_protocolParser_t *const ppIn, cxa_stateMachine_t *const smIn)
+{
+	cxa_assert(ppIn);
+	cxa_assert(smIn);
+
+	ppIn->rxStateMachine = smIn;
+	cxa_stateMachine_setSuspendWhenIdle(smIn, true);
+	cxa_ioStream_setDataAvailableListener(ppIn->ioStream, cb_ioStream_onDataAvailable, (void*)ppIn);
+}
+
+
+void cxa_protocolParser_continueReading(cxa_protocolParser_t *const ppIn, cxa_ioStream_readStatus_t lastReadStatIn)
+{
+	cxa_assert(ppIn);
+
+	if( ppIn->rxStateMachine == NULL ) return;
+
+	if( (lastReadStatIn == CXA_IOSTREAM_READSTAT_GOTDATA) || !cxa_ioStream_notifiesDataAvailable(ppIn->ioStream) )
+	{
+		cxa_stateMachine_kick(ppIn->rxStateMachine);
+	}
+}
+
+
 void cxa_protocolParser_notify_ioException(cxa_protocolParser_t *const ppIn)
 {
 	cxa_assert(ppIn);
@@ -207,3 +235,10 @@ void cxa_protocolParser_notify_packetReceived(cxa_protocolParser_t *const ppIn,
 
 
 // ******** local function implementations ********
+static void cb_ioStream_onDataAvailable(cxa_ioStream_t *const ioStreamIn, void *const userVarIn)
+{
+	cxa_protocolParser_t* ppIn = (cxa_protocolParser_t*)userVarIn;
+	cxa_assert(ppIn);
+
+	if( ppIn->rxStateMachine != NULL ) cxa_stateMachine_kick(ppIn->rxStateMachine);
+}
@@ -73,6 +73,14 @@ void cxa_protocolParser_cleProto_init(cxa_protocolParser_cleProto_t *const clePp
 	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_PROCESS_PACKET, "processPacket", NULL, rxState_cb_processPacket_state, NULL, (void*)clePpIn);
 	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_ERROR, "error", rxState_cb_error_enter, NULL, NULL, (void*)clePpIn);
 	cxa_stateMachine_setInitialState(&clePpIn->stateMachine, RX_STATE_IDLE);
+
+	// our waiting states only run when the ioStream has data (or times out)
+	cxa_stateMachine_setStateIsPolled(&clePpIn->stateMachine, RX_STATE_IDLE, false);
+	cxa_stateMachine_setStateIsPolled(&clePpIn->stateMachine, RX_STATE_WAIT_0x80, false);
+	cxa_stateMachine_setStateIsPolled(&clePpIn->stateMachine, RX_STATE_WAIT_0x81, false);
+	cxa_stateMachine_setStateIsPolled(&clePpIn->stateMachine, RX_STATE_WAIT_LEN, false);
+	cxa_stateMachine_setStateIsPolled(&clePpIn->stateMachine, RX_STATE_WAIT_DATA_BYTES, false);
+	cxa_protocolParser_setRxStateMachine(&clePpIn->super, &clePpIn->stateMachine);
 }
 
 
@@ -169,6 +177,9 @@ static void rxState_cb_idle_state(cxa_stateMachine_t *const smIn, void *userVarI
 		cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
 		return;
 	}
+
+	// binding our ioStream or setting a buffer kicks us
+	cxa_protocolParser_continueReading(&clePpIn->super, CXA_IOSTREAM_READSTAT_NODATA);
 }
 
 
@@ -187,9 +198,10 @@ static void rxState_cb_wait0x80_state(cxa_stateMachine_t *const smIn, void *user
 	cxa_assert(clePpIn);
 
 	uint8_t rxByte;
+	cxa_ioStream_readStatus_t readStat = CXA_IOSTREAM_READSTAT_NODATA;
 	for( uint8_t i = 0; i < MAX_NUM_RX_BYTES_PER_UPDATE; i++ )
 	{
-		cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(clePpIn->super.ioStream, &rxByte);
+		readStat = cxa_ioStream_readByte(clePpIn->super.ioStream, &rxByte);
 		if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_ERROR); return; }
 		else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
 		{
@@ -207,6 +219,8 @@ static void rxState_cb_wait0x80_state(cxa_stateMachine_t *const smIn, void *user
 			}
 		}
 	}
+
+	cxa_protocolParser_continueReading(&clePpIn->super, readStat);
 }
 
 
@@ -245,6 +259,10 @@ static void rxState_cb_wait0x81_state(cxa_stateMachine_t *const smIn, void *user
 		cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
 		return;
 	}
+
+	// keep reading (and wake up for our reception timeout)
+	cxa_protocolParser_continueReading(&clePpIn->super, readStat);
+	cxa_stateMachine_kickAfter(&clePpIn->stateMachine, cxa_timeDiff_getRemainingTime_ms(&clePpIn->super.td_timeout, RECEPTION_TIMEOUT_MS));
 }
 
 
@@ -270,8 +288,8 @@ static void rxState_cb_waitLen_state(cxa_stateMachine_t *const smIn, void *userV
 			if( cxa_fixedByteBuffer_get_uint16LE(clePpIn->super.currBuffer, 2, len_bytes) && (len_bytes >= 1) )
 			{
 				cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_DATA_BYTES);
+				return;
 			}
-			return;
 		}
 	}
 
@@ -282,6 +300,10 @@ static void rxState_cb_waitLen_state(cxa_stateMachine_t *const smIn, void *userV
 		cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
 		return;
 	}
+
+	// keep reading (and wake up for our reception timeout)
+	cxa_protocolParser_continueReading(&clePpIn->super, readStat);
+	cxa_stateMachine_kickAfter(&clePpIn->stateMachine, cxa_timeDiff_getRemainingTime_ms(&clePpIn->super.td_timeout, RECEPTION_TIMEOUT_MS));
 }
 
 
@@ -336,6 +358,10 @@ static void rxState_cb_waitDataBytes_state(cxa_stateMachine_t *const smIn, void
 			cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
 			return;
 	}
+
+	// keep reading (and wake up for our reception timeout)
+	cxa_protocolParser_continueReading(&clePpIn->super, readStat);
+	cxa_stateMachine_kickAfter(&clePpIn->stateMachine, cxa_timeDiff_getRemainingTime_ms(&clePpIn->super.td_timeout, RECEPTION_TIMEOUT_MS));
 }
 
 
@@ -72,6 +72,13 @@ void cxa_protocolParser_crlf_init(cxa_protocolParser_crlf_t *const crlfPpIn, cxa
 	cxa_stateMachine_addState(&crlfPpIn->stateMachine, RX_STATE_PROCESS_PACKET, "processPacket", NULL, rxState_cb_processPacket_state, NULL, (void*)crlfPpIn);
 	cxa_stateMachine_addState(&crlfPpIn->stateMachine, RX_STATE_ERROR, "error", rxState_cb_error_enter, NULL, NULL, (void*)crlfPpIn);
 	cxa_stateMachine_setInitialState(&crlfPpIn->stateMachine, RX_STATE_IDLE);
+
+	// our waiting states only run when the ioStream has data (or times out)
+	cxa_stateMachine_setStateIsPolled(&crlfPpIn->stateMachine, RX_STATE_IDLE, false);
+	cxa_stateMachine_setStateIsPolled(&crlfPpIn->stateMachine, RX_STATE_WAIT_FIRSTBYTE, false);
+	cxa_stateMachine_setStateIsPolled(&crlfPpIn->stateMachine, RX_STATE_WAIT_CR, false);
+	cxa_stateMachine_setStateIsPolled(&crlfPpIn->stateMachine, RX_STATE_WAIT_LF, false);
+	cxa_protocolParser_setRxStateMachine(&crlfPpIn->super, &crlfPpIn->stateMachine);
 }
 
 
@@ -172,6 +179,9 @@ static void rxState_cb_idle_state(cxa_stateMachine_t *const smIn, void *userVarI
 		cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_WAIT_FIRSTBYTE);
 		return;
 	}
+
+	// binding our ioStream, setting a buffer, or resuming kicks us
+	cxa_protocolParser_continueReading(&crlfPpIn->super, CXA_IOSTREAM_READSTAT_NODATA);
 }
 
 
@@ -190,12 +200,13 @@ static void rxState_cb_waitFirstByte_state(cxa_stateMachine_t *const smIn, void
 	cxa_assert(crlfPpIn);
 
 	uint8_t rxByte;
+	cxa_ioStream_readStatus_t readStat = CXA_IOSTREAM_READSTAT_NODATA;
 	for( uint8_t i = 0; i < MAX_NUM_RX_BYTES_PER_UPDATE; i++ )
 	{
 		// make sure we haven't been paused
 		if( crlfPpIn->isPaused ) return;
 
-		cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(crlfPpIn->super.ioStream, &rxByte);
+		readStat = cxa_ioStream_readByte(crlfPpIn->super.ioStream, &rxByte);
 		if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_ERROR); return; }
 		else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
 		{
@@ -218,6 +229,8 @@ static void rxState_cb_waitFirstByte_state(cxa_stateMachine_t *const smIn, void
 			return;
 		}
 	}
+
+	cxa_protocolParser_continueReading(&crlfPpIn->super, readStat);
 }
 
 
@@ -227,12 +240,13 @@ static void rxState_cb_waitCrLf_state(cxa_stateMachine_t *const smIn, void *user
 	cxa_assert(crlfPpIn);
 
 	uint8_t rxByte;
+	cxa_ioStream_readStatus_t readStat = CXA_IOSTREAM_READSTAT_NODATA;
 	for( uint8_t i = 0; i < MAX_NUM_RX_BYTES_PER_UPDATE; i++ )
 	{
 		// make sure we haven't been paused
 		if( crlfPpIn->isPaused ) return;
 
-		cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(crlfPpIn->super.ioStream, &rxByte);
+		readStat = cxa_ioStream_readByte(crlfPpIn->super.ioStream, &rxByte);
 		if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&crlfPpIn->stateMachine, RX_STATE_ERROR); return; }
 		else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
 		{
@@ -280,6 +294,10 @@ static void rxState_cb_waitCrLf_state(cxa_stateMachine_t *const smIn, void *user
 			return;
 		}
 	}
+
+	// keep reading (and wake up for our reception timeout)
+	cxa_protocolParser_continueReading(&crlfPpIn->super, readStat);
+	cxa_stateMachine_kickAfter(&crlfPpIn->stateMachine, cxa_timeDiff_getRemainingTime_ms(&crlfPpIn->super.td_timeout, RECEPTION_TIMEOUT_MS));
 }
 
 
@@ -24,8 +24,10 @@
 
 // ******** local function prototypes ********
 static void cb_onRunLoopUpdate(void* userVarIn);
+static void scheduleNextUpdate(cxa_stateMachine_t *const smIn);
 
-static cxa_stateMachine_state_t* getState_byId(cxa_stateMachine_t *const smIn, int idIn);
+static void initCommon(cxa_stateMachine_t *const smIn, const char* nameIn, int threadIdIn);
+static const cxa_stateMachine_state_t* getState_byId(cxa_stateMachine_t *const smIn, int idIn);
 
 
 // ********  local variable declarations *********
@@ -37,31 +39,42 @@ void cxa_stateMachine_init(cxa_stateMachine_t *const smIn, const char* nameIn, i
 	cxa_assert(smIn);
 	cxa_assert(nameIn);
 
-	// set some sensible defaults
-	smIn->currState = NULL;
-	smIn->nextState = NULL;
-	smIn->hasStarted = false;
-
+#ifdef CXA_STATE_MACHINE_DISABLE_DYNAMIC_STATES
+	cxa_assert_msg(false, "dynamic states disabled, use cxa_stateMachine_init_stateTable");
+#else
 	// setup our internal state
+	smIn->stateTable = NULL;
+	smIn->stateTable_numStates = 0;
 	cxa_array_init(&smIn->states, sizeof(*smIn->states_raw), (void*)smIn->states_raw, sizeof(smIn->states_raw));
+#endif
 
-	// setup our logger if it's enabled
-	#ifdef CXA_STATE_MACHINE_ENABLE_LOGGING
-	cxa_logger_init_formattedString(&smIn->logger, "fsm::%s", nameIn);
-	#endif
+	initCommon(smIn, nameIn, threadIdIn);
+}
 
-	// a timediff was _not_ supplied so we cannot do timed states
-	// even if they are enabled
-	#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
-	cxa_timeDiff_init(&smIn->td_timedTransition);
-	smIn->timedStatesEnabled = true;
-	#endif
 
-	// register for run loop execution
-	cxa_runLoop_addEntry(threadIdIn, NULL, cb_onRunLoopUpdate, (void*)smIn);
+void cxa_stateMachine_init_stateTable(cxa_stateMachine_t *const smIn, const char* nameIn,
+		const cxa_stateMachine_state_t *const stateTableIn, size_t numStatesIn,
+		int threadIdIn)
+{
+	cxa_assert(smIn);
+	cxa_assert(nameIn);
+	cxa_assert(stateTableIn);
+	cxa_assert(numStatesIn > 0);
+
+	// make sure the table is dense and indexed by state id
+	for( size_t i = 0; i < numStatesIn; i++ )
+	{
+		cxa_assert_msg(((size_t)stateTableIn[i].stateId == i) && (stateTableIn[i].stateName != NULL), "state table must be indexed by state id");
+	}
+
+	smIn->stateTable = stateTableIn;
+	smIn->stateTable_numStates = numStatesIn;
+
+	initCommon(smIn, nameIn, threadIdIn);
 }
 
 
+#ifndef CXA_STATE_MACHINE_DISABLE_DYNAMIC_STATES
 void cxa_stateMachine_addState(cxa_stateMachine_t *const smIn, int idIn, const char* nameIn,
 	cxa_stateMachine_cb_entered_t cb_enteredIn, cxa_stateMachine_cb_state_t cb_stateIn, cxa_stateMachine_cb_leaving_t cb_leavingIn,
 	void *userVarIn)
@@ -79,6 +92,7 @@ void cxa_stateMachine_addState_full(cxa_stateMachine_t *const smIn, int idIn, co
 	cxa_assert(smIn);
 	cxa_assert(nameIn);
 	cxa_assert(!smIn->hasStarted);
+	cxa_assert(smIn->stateTable == NULL);
 	cxa_assert(idIn != CXA_STATE_MACHINE_STATE_UNKNOWN);
 
 	// make sure we don't already have this state added
@@ -120,6 +134,7 @@ void cxa_stateMachine_addState_timed_full(cxa_stateMachine_t *const smIn, int id
 	cxa_assert(nameIn);
 	cxa_assert(!smIn->hasStarted);
 	cxa_assert(smIn->timedStatesEnabled);
+	cxa_assert(smIn->stateTable == NULL);
 	cxa_assert(idIn != CXA_STATE_MACHINE_STATE_UNKNOWN);
 
 	// make sure we don't already have this state added
@@ -144,6 +159,7 @@ void cxa_stateMachine_addState_timed_full(cxa_stateMachine_t *const smIn, int id
 	cxa_assert(cxa_array_append(&smIn->states, &newState));
 }
 #endif
+#endif
 
 
 void cxa_stateMachine_setInitialState(cxa_stateMachine_t *const smIn, int stateIdIn)
@@ -152,7 +168,7 @@ void cxa_stateMachine_setInitialState(cxa_stateMachine_t *const smIn, int stateI
 	cxa_assert(!smIn->hasStarted);
 
 	// get our next state
-	cxa_stateMachine_state_t *newNextState = getState_byId(smIn, stateIdIn);
+	const cxa_stateMachine_state_t *newNextState = getState_byId(smIn, stateIdIn);
 	cxa_assert(newNextState != NULL);
 
 	// we have a valid new state...mark for transition
@@ -160,6 +176,31 @@ void cxa_stateMachine_setInitialState(cxa_stateMachine_t *const smIn, int stateI
 }
 
 
+#ifndef CXA_STATE_MACHINE_DISABLE_DYNAMIC_STATES
+void cxa_stateMachine_setStateIsPolled(cxa_stateMachine_t *const smIn, int stateIdIn, bool isPolledIn)
+{
+	cxa_assert(smIn);
+	cxa_assert_msg((smIn->stateTable == NULL), "declare isEventDriven in the state table");
+
+	const cxa_stateMachine_state_t *targetState = getState_byId(smIn, stateIdIn);
+	cxa_assert(targetState != NULL);
+
+	// runtime states live in our (writable) states_raw
+	smIn->states_raw[targetState - smIn->states_raw].isEventDriven = !isPolledIn;
+	if( smIn->hasStarted && smIn->suspendWhenIdle ) cxa_runLoop_entry_resume(smIn->runLoopEntry);
+}
+#endif
+
+
+void cxa_stateMachine_setSuspendWhenIdle(cxa_stateMachine_t *const smIn, bool suspendWhenIdleIn)
+{
+	cxa_assert(smIn);
+
+	smIn->suspendWhenIdle = suspendWhenIdleIn;
+	if( !suspendWhenIdleIn ) cxa_runLoop_entry_resume(smIn->runLoopEntry);
+}
+
+
 void cxa_stateMachine_transition(cxa_stateMachine_t *const smIn, int stateIdIn)
 {
 	cxa_assert(smIn);
@@ -174,11 +215,12 @@ void cxa_stateMachine_transition(cxa_stateMachine_t *const smIn, int stateIdIn)
 #endif
 
 	// get our next state
-	cxa_stateMachine_state_t *newNextState = getState_byId(smIn, stateIdIn);
+	const cxa_stateMachine_state_t *newNextState = getState_byId(smIn, stateIdIn);
 	cxa_assert(newNextState != NULL);
 
-	// we have a valid new state...mark for transition
+	// we have a valid new state...mark for transition (and make sure we're scheduled)
 	smIn->nextState = newNextState;
+	if( smIn->suspendWhenIdle ) cxa_runLoop_entry_resume(smIn->runLoopEntry);
 }
 
 
@@ -192,6 +234,26 @@ void cxa_stateMachine_transitionNow(cxa_stateMachine_t *const smIn, int stateIdI
 }
 
 
+void cxa_stateMachine_kick(cxa_stateMachine_t *const smIn)
+{
+	cxa_assert(smIn);
+
+	smIn->isKicked = true;
+	if( smIn->suspendWhenIdle ) cxa_runLoop_entry_resume(smIn->runLoopEntry);
+}
+
+
+void cxa_stateMachine_kickAfter(cxa_stateMachine_t *const smIn, uint32_t delay_msIn)
+{
+	cxa_assert(smIn);
+
+	// picked up by scheduleNextUpdate at the end of this update
+	smIn->kickDelay_ms = delay_msIn;
+	cxa_timeDiff_setStartTime_now(&smIn->td_kick);
+	smIn->hasKickDeadline = true;
+}
+
+
 int cxa_stateMachine_getCurrentState(cxa_stateMachine_t *const smIn)
 {
 	cxa_assert(smIn);
@@ -201,6 +263,36 @@ int cxa_stateMachine_getCurrentState(cxa_stateMachine_t *const smIn)
 
 
 // ******** local function implementations ********
+static void initCommon(cxa_stateMachine_t *const smIn, const char* nameIn, int threadIdIn)
+{
+	cxa_assert(smIn);
+
+	// set some sensible defaults
+	smIn->currState = NULL;
+	smIn->nextState = NULL;
+	smIn->hasStarted = false;
+	smIn->suspendWhenIdle = false;
+	smIn->isKicked = false;
+	smIn->hasKickDeadline = false;
+	cxa_timeDiff_init(&smIn->td_kick);
+
+	// setup our logger if it's enabled
+	#ifdef CXA_STATE_MACHINE_ENABLE_LOGGING
+	cxa_logger_init_formattedString(&smIn->logger, "fsm::%s", nameIn);
+	#endif
+
+	// a timediff was _not_ supplied so we cannot do timed states
+	// even if they are enabled
+	#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
+	cxa_timeDiff_init(&smIn->td_timedTransition);
+	smIn->timedStatesEnabled = true;
+	#endif
+
+	// register for run loop execution
+	smIn->runLoopEntry = cxa_runLoop_addEntry(threadIdIn, NULL, cb_onRunLoopUpdate, (void*)smIn);
+}
+
+
 static void cb_onRunLoopUpdate(void* userVarIn)
 {
 	cxa_stateMachine_t* smIn = (cxa_stateMachine_t*)userVarIn;
@@ -222,9 +314,10 @@ static void cb_onRunLoopUpdate(void* userVarIn)
 		if( smIn->nextState->cb_entering != NULL ) smIn->nextState->cb_entering(smIn, ((smIn->currState != NULL) ? smIn->currState->stateId : CXA_STATE_MACHINE_STATE_UNKNOWN), smIn->nextState->userVar);
 
 		// actually do our transition
-		cxa_stateMachine_state_t* prevState = smIn->currState;
+		const cxa_stateMachine_state_t* prevState = smIn->currState;
 		smIn->currState = smIn->nextState;
 		smIn->nextState = NULL;
+		smIn->hasKickDeadline = false;
 
 		#ifdef CXA_STATE_MACHINE_ENABLE_LOGGING
 			cxa_logger_info(&smIn->logger, "new state: '%s'", smIn->currState->stateName);
@@ -239,6 +332,9 @@ static void cb_onRunLoopUpdate(void* userVarIn)
 		// call the entered function of our new state
 		if( smIn->currState->cb_entered != NULL ) smIn->currState->cb_entered(smIn, ((prevState != NULL) ? prevState->stateId : CXA_STATE_MACHINE_STATE_UNKNOWN), smIn->currState->userVar);
 
+		// non-polled states get one call of their state function after entering
+		smIn->isKicked = true;
+
 		#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
 			if( smIn->timedStatesEnabled && (smIn->currState->type == CXA_STATE_MACHINE_STATE_TYPE_TIMED) ) cxa_timeDiff_setStartTime_now(&smIn->td_timedTransition);
 		#endif
@@ -256,23 +352,77 @@ static void cb_onRunLoopUpdate(void* userVarIn)
 			}
 		#endif
 
-		// keep updating our state
-		if( (smIn->currState != NULL) && (smIn->currState->cb_state != NULL) ) smIn->currState->cb_state(smIn, smIn->currState->userVar);
+		// keep updating our state (a kick arriving during the state callback is retained)
+		bool wasKicked = smIn->isKicked;
+		smIn->isKicked = false;
+		if( smIn->hasKickDeadline && cxa_timeDiff_isElapsed_ms(&smIn->td_kick, smIn->kickDelay_ms) )
+		{
+			smIn->hasKickDeadline = false;
+			wasKicked = true;
+		}
+		if( (smIn->currState != NULL) && (smIn->currState->cb_state != NULL) && (!smIn->currState->isEventDriven || wasKicked) )
+		{
+			smIn->currState->cb_state(smIn, smIn->currState->userVar);
+		}
 	}
+
+	scheduleNextUpdate(smIn);
 }
 
 
-static cxa_stateMachine_state_t* getState_byId(cxa_stateMachine_t *const smIn, int idIn)
+static void scheduleNextUpdate(cxa_stateMachine_t *const smIn)
 {
 	cxa_assert(smIn);
 
-	for( size_t i = 0; i < cxa_array_getSize_elems(&smIn->states); i++ )
+	const cxa_stateMachine_state_t* currState = smIn->currState;
+
+	// stay scheduled if there is still work to do (or we've been asked to poll)
+	if( !smIn->suspendWhenIdle || (smIn->nextState != NULL) || (currState == NULL) ) return;
+	if( (currState->cb_state != NULL) && (!currState->isEventDriven || smIn->isKicked) ) return;
+
+	// wake up at our earliest deadline (if any) rather than polling for it
+	bool hasDeadline = false;
+	uint32_t wakeDelay_ms = UINT32_MAX;
+	if( smIn->hasKickDeadline && (currState->cb_state != NULL) )
 	{
-		cxa_stateMachine_state_t* currState = (cxa_stateMachine_state_t*)cxa_array_get(&smIn->states, i);
-		if( currState == NULL ) continue;
+		hasDeadline = true;
+		wakeDelay_ms = cxa_timeDiff_getRemainingTime_ms(&smIn->td_kick, smIn->kickDelay_ms);
+	}
+	#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
+		if( smIn->timedStatesEnabled && (currState->type == CXA_STATE_MACHINE_STATE_TYPE_TIMED) )
+		{
+			uint32_t timedDelay_ms = cxa_timeDiff_getRemainingTime_ms(&smIn->td_timedTransition, currState->stateTime_ms);
+			if( timedDelay_ms < wakeDelay_ms ) wakeDelay_ms = timedDelay_ms;
+			hasDeadline = true;
+		}
+	#endif
+
+	if( hasDeadline ) cxa_runLoop_entry_resumeAfter(smIn->runLoopEntry, wakeDelay_ms);
+	else cxa_runLoop_entry_suspend(smIn->runLoopEntry);
+
+	// a transition (or kick) may have arrived from another context while we were suspending
+	if( (smIn->nextState != NULL) || smIn->isKicked ) cxa_runLoop_entry_resume(smIn->runLoopEntry);
+}
 
-		if( currState->stateId == idIn ) return currState;
+
+static const cxa_stateMachine_state_t* getState_byId(cxa_stateMachine_t *const smIn, int idIn)
+{
+	cxa_assert(smIn);
+
+	// state tables are indexed directly by id
+	if( smIn->stateTable != NULL ) return ((idIn >= 0) && ((size_t)idIn < smIn->stateTable_numStates)) ? &smIn->stateTable[idIn] : NULL;
+
+#ifndef CXA_STATE_MACHINE_DISABLE_DYNAMIC_STATES
+	// states are usually added in id order, so try the direct index first
+	size_t numStates = cxa_array_getSize_elems(&smIn->states);
+	if( (idIn >= 0) && ((size_t)idIn < numStates) && (smIn->states_raw[idIn].stateId == idIn) ) return &smIn->states_raw[idIn];
+
+	for( size_t i = 0; i < numStates; i++ )
+	{
+		if( smIn->states_raw[i].stateId == idIn ) return &smIn->states_raw[i];
 	}
+#endif
 
 	return NULL;
 }
+
@@ -0,0 +1,180 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_perfStats.h"
+
+
+// ******** includes ********
+#include <string.h>
+
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+#define SUBBUCKET_COUNT					(1 << CXA_PERFSTATS_SUBBUCKET_BITS)
+#define SUBBUCKET_MASK					(SUBBUCKET_COUNT - 1)
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static size_t getBucketIndex(uint32_t valueIn);
+static uint32_t getBucketUpperBound(size_t indexIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_perfStats_init(cxa_perfStats_t *const statsIn)
+{
+	cxa_assert(statsIn);
+
+	cxa_timeDiff_init(&statsIn->td_window);
+	cxa_perfStats_reset(statsIn);
+}
+
+
+void cxa_perfStats_reset(cxa_perfStats_t *const statsIn)
+{
+	cxa_assert(statsIn);
+
+	statsIn->numSamples = 0;
+	statsIn->numBytes = 0;
+	statsIn->minLatency_us = UINT32_MAX;
+	statsIn->maxLatency_us = 0;
+	statsIn->sumLatency_us = 0;
+	memset(statsIn->buckets, 0, sizeof(statsIn->buckets));
+
+	cxa_timeDiff_setStartTime_now(&statsIn->td_window);
+}
+
+
+void cxa_perfStats_recordSample(cxa_perfStats_t *const statsIn, uint32_t latency_usIn, size_t numBytesIn)
+{
+	cxa_assert(statsIn);
+
+	// saturate rather than wrap
+	if( statsIn->numSamples == UINT32_MAX ) return;
+
+	statsIn->numSamples++;
+	statsIn->numBytes += numBytesIn;
+	statsIn->sumLatency_us += latency_usIn;
+	if( latency_usIn < statsIn->minLatency_us ) statsIn->minLatency_us = latency_usIn;
+	if( latency_usIn > statsIn->maxLatency_us ) statsIn->maxLatency_us = latency_usIn;
+
+	statsIn->buckets[getBucketIndex(latency_usIn)]++;
+}
+
+
+uint32_t cxa_perfStats_getNumSamples(cxa_perfStats_t *const statsIn)
+{
+	cxa_assert(statsIn);
+
+	return statsIn->numSamples;
+}
+
+
+uint32_t cxa_perfStats_getPercentile_us(cxa_perfStats_t *const statsIn, uint8_t percentIn)
+{
+	cxa_assert(statsIn);
+	cxa_assert(percentIn <= 100);
+
+	if( statsIn->numSamples == 0 ) return 0;
+
+	// rank of the sample we're looking for (1-based, rounded up)
+	uint64_t targetRank = (((uint64_t)statsIn->numSamples * percentIn) + 99) / 100;
+	if( targetRank == 0 ) targetRank = 1;
+
+	uint64_t currRank = 0;
+	for( size_t i = 0; i < CXA_PERFSTATS_NUM_BUCKETS; i++ )
+	{
+		currRank += statsIn->buckets[i];
+		if( currRank >= targetRank )
+		{
+			// bucket bounds are coarse, so never report beyond what we've actually seen
+			uint32_t retVal = getBucketUpperBound(i);
+			if( retVal > statsIn->maxLatency_us ) retVal = statsIn->maxLatency_us;
+			if( retVal < statsIn->minLatency_us ) retVal = statsIn->minLatency_us;
+			return retVal;
+		}
+	}
+
+	return statsIn->maxLatency_us;
+}
+
+
+uint32_t cxa_perfStats_getMeanLatency_us(cxa_perfStats_t *const statsIn)
+{
+	cxa_assert(statsIn);
+
+	return (statsIn->numSamples > 0) ? (uint32_t)(statsIn->sumLatency_us / statsIn->numSamples) : 0;
+}
+
+
+uint32_t cxa_perfStats_getSamplesPerSec(cxa_perfStats_t *const statsIn)
+{
+	cxa_assert(statsIn);
+
+	uint32_t elapsed_ms = cxa_timeDiff_getElapsedTime_ms(&statsIn->td_window);
+	return (elapsed_ms > 0) ? (uint32_t)(((uint64_t)statsIn->numSamples * 1000) / elapsed_ms) : 0;
+}
+
+
+uint32_t cxa_perfStats_getBytesPerSec(cxa_perfStats_t *const statsIn)
+{
+	cxa_assert(statsIn);
+
+	uint32_t elapsed_ms = cxa_timeDiff_getElapsedTime_ms(&statsIn->td_window);
+	return (elapsed_ms > 0) ? (uint32_t)((statsIn->numBytes * 1000) / elapsed_ms) : 0;
+}
+
+
+bool cxa_perfStats_writeReport(cxa_perfStats_t *const statsIn, const char *const nameIn, cxa_ioStream_t *const ioStreamIn)
+{
+	cxa_assert(statsIn);
+	cxa_assert(nameIn);
+	cxa_assert(ioStreamIn);
+
+	return cxa_ioStream_writeFormattedLine(ioStreamIn, "%s: n=%lu  %lu/s  %lu B/s  lat(us) min=%lu p50=%lu p99=%lu max=%lu mean=%lu",
+										   nameIn,
+										   (unsigned long)statsIn->numSamples,
+										   (unsigned long)cxa_perfStats_getSamplesPerSec(statsIn),
+										   (unsigned long)cxa_perfStats_getBytesPerSec(statsIn),
+										   (unsigned long)((statsIn->numSamples > 0) ? statsIn->minLatency_us : 0),
+										   (unsigned long)cxa_perfStats_getPercentile_us(statsIn, 50),
+										   (unsigned long)cxa_perfStats_getPercentile_us(statsIn, 99),
+										   (unsigned long)statsIn->maxLatency_us,
+										   (unsigned long)cxa_perfStats_getMeanLatency_us(statsIn));
+}
+
+
+// ******** local function implementations ********
+static size_t getBucketIndex(uint32_t valueIn)
+{
+	// small values get their own bucket
+	if( valueIn < SUBBUCKET_COUNT ) return valueIn;
+
+	// find the most-significant bit
+	uint8_t msb = 0;
+	for( uint32_t tmp = valueIn; tmp > 1; tmp >>= 1 ) msb++;
+
+	// each power-of-two range is split linearly into SUBBUCKET_COUNT buckets
+	uint8_t shift = msb - CXA_PERFSTATS_SUBBUCKET_BITS;
+	return ((size_t)(shift + 1) << CXA_PERFSTATS_SUBBUCKET_BITS) + ((valueIn >> shift) & SUBBUCKET_MASK);
+}
+
+
+static uint32_t getBucketUpperBound(size_t indexIn)
+{
+	if( indexIn < SUBBUCKET_COUNT ) return indexIn;
+
+	uint8_t shift = (indexIn >> CXA_PERFSTATS_SUBBUCKET_BITS) - 1;
+	uint64_t mantissa = (indexIn & SUBBUCKET_MASK) | SUBBUCKET_COUNT;
+	uint64_t retVal = ((mantissa + 1) << shift) - 1;
+	return (retVal > UINT32_MAX) ? UINT32_MAX : (uint32_t)retVal;
+}
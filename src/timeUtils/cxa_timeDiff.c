@@ -18,6 +18,7 @@
 
 
 // ******** local function prototypes ********
+static uint64_t getElapsedTime64_us(cxa_timeDiff_t *const tdIn);
 
 
 // ********  local variable declarations *********
@@ -36,7 +37,7 @@ void cxa_timeDiff_setStartTime_now(cxa_timeDiff_t *const tdIn)
 {
 	cxa_assert(tdIn);
 
-	tdIn->startTime_us = cxa_timeBase_getCount_us();
+	tdIn->startTime_us = cxa_timeBase_getCount64_us();
 }
 
 
@@ -44,11 +45,17 @@ uint32_t cxa_timeDiff_getElapsedTime_ms(cxa_timeDiff_t *const tdIn)
 {
 	cxa_assert(tdIn);
 
-	uint32_t curr_us = cxa_timeBase_getCount_us();
-	uint32_t elapsedTime_us = (curr_us >= tdIn->startTime_us) ?
-							  (curr_us - tdIn->startTime_us) :
-							  ((cxa_timeBase_getMaxCount_us() - tdIn->startTime_us) + curr_us);
-	return elapsedTime_us / 1000;
+	uint64_t elapsed_ms = getElapsedTime64_us(tdIn) / 1000;
+	return (elapsed_ms > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsed_ms;
+}
+
+
+uint32_t cxa_timeDiff_getElapsedTime_us(cxa_timeDiff_t *const tdIn)
+{
+	cxa_assert(tdIn);
+
+	uint64_t elapsed_us = getElapsedTime64_us(tdIn);
+	return (elapsed_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsed_us;
 }
 
 
@@ -60,15 +67,33 @@ bool cxa_timeDiff_isElapsed_ms(cxa_timeDiff_t *const tdIn, uint32_t msIn)
 }
 
 
+uint32_t cxa_timeDiff_getRemainingTime_ms(cxa_timeDiff_t *const tdIn, uint32_t msIn)
+{
+	cxa_assert(tdIn);
+
+	uint32_t elapsed_ms = cxa_timeDiff_getElapsedTime_ms(tdIn);
+	return (elapsed_ms < msIn) ? (msIn - elapsed_ms) : 0;
+}
+
+
 bool cxa_timeDiff_isElapsed_recurring_ms(cxa_timeDiff_t *const tdIn, uint32_t msIn)
 {
 	cxa_assert(tdIn);
 
-	bool retVal = cxa_timeDiff_isElapsed_ms(tdIn, msIn);
-	if( retVal ) cxa_timeDiff_setStartTime_now(tdIn);
+	uint64_t period_us = (uint64_t)msIn * 1000;
+	uint64_t elapsed_us = getElapsedTime64_us(tdIn);
+	if( elapsed_us < period_us ) return false;
 
-	return retVal;
+	// advance by whole periods (not to "now") so we don't drift by our caller's latency
+	tdIn->startTime_us += (period_us > 0) ? (elapsed_us - (elapsed_us % period_us)) : elapsed_us;
+
+	return true;
 }
 
 
 // ******** local function implementations ********
+static uint64_t getElapsedTime64_us(cxa_timeDiff_t *const tdIn)
+{
+	uint64_t curr_us = cxa_timeBase_getCount64_us();
+	return (curr_us >= tdIn->startTime_us) ? (curr_us - tdIn->startTime_us) : 0;
+}
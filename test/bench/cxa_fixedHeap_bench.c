@@ -0,0 +1,198 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * Compares cxa_fixedHeap against a linear scan of a plain array on a timer
+ * workload, at 8 to 1024 timers. Each iteration:
+ * - serves the soonest timer and reschedules it at a random later time
+ * - moves one other timer earlier (decrease-key via ::cxa_fixedHeap_update)
+ *
+ * Both run the same sequence (ties are broken by timer id, so the order is
+ * fully determined) and must serve the same timers. Each row reports ns and
+ * cycles (see ::cxa_test_getCycles) per iteration; the crossover is where a
+ * heap starts paying for its bookkeeping.
+ *
+ * The heap arity is chosen at compile time (add -DCXA_FIXEDHEAP_ARITY=4 to
+ * compare the 4-ary heap).
+ *
+ * Build (from the repository root, see test/README.md):
+ * @code
+ * gcc -std=gnu99 -O2 $CXA_TEST_INCLUDES -o fixedHeap_bench test/bench/cxa_fixedHeap_bench.c test/support/cxa_test.c \
+ * 	src/collections/cxa_fixedHeap.c src/misc/cxa_assert.c src/misc/cxa_stringUtils.c src/misc/cxa_numberUtils.c \
+ * 	src/misc/cxa_encodingUtils.c src/logger/cxa_logger.c src/runLoop/cxa_runLoop.c src/collections/cxa_array.c \
+ * 	src/collections/cxa_fixedByteBuffer.c src/serial/cxa_ioStream.c src/timeUtils/cxa_timeDiff.c \
+ * 	src/arch-posix/cxa_posix_timeBase.c src/arch-posix/cxa_posix_criticalSection.c -lpthread
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <stdio.h>
+
+#include <cxa_assert.h>
+#include <cxa_fixedHeap.h>
+#include <cxa_test.h>
+
+
+// ******** local macro definitions ********
+#define MAX_NUM_TIMERS					1024
+#define NUM_ITERATIONS					1000000
+#define MAX_DELAY						100000
+
+
+// ******** local type definitions ********
+typedef struct
+{
+	uint32_t expiry;
+	uint32_t id;
+}benchTimer_t;
+
+
+// ******** local function prototypes ********
+static void runRound(size_t numTimersIn);
+static uint64_t runHeap(size_t numTimersIn, uint64_t *const elapsed_nsOut, uint64_t *const elapsed_cyclesOut);
+static uint64_t runLinear(size_t numTimersIn, uint64_t *const elapsed_nsOut, uint64_t *const elapsed_cyclesOut);
+
+static uint32_t nextRandom(void);
+static int compareTimers(const void *const aIn, const void *const bIn);
+
+
+// ********  local variable declarations *********
+static benchTimer_t heapBuffer[MAX_NUM_TIMERS];
+static uint16_t heapIndexBuffer[CXA_FIXEDHEAP_INDEXBUFFER_NUMELEMS(MAX_NUM_TIMERS)];
+static benchTimer_t* heapHandles[MAX_NUM_TIMERS];
+
+static benchTimer_t linearTimers[MAX_NUM_TIMERS];
+
+static uint32_t randomState;
+
+static const size_t NUM_TIMERS[] = {8, 16, 32, 64, 128, 256, 512, 1024};
+
+
+// ******** global function implementations ********
+int main(void)
+{
+	cxa_test_init();
+
+	printf("arity %d\n", CXA_FIXEDHEAP_ARITY);
+	printf("%7s %10s %10s %12s %12s %9s\n", "timers", "heap ns", "linear ns", "heap cycles", "lin cycles", "speedup");
+	for( size_t i = 0; i < sizeof(NUM_TIMERS)/sizeof(*NUM_TIMERS); i++ ) runRound(NUM_TIMERS[i]);
+
+	return cxa_test_finish("fixedHeap_bench");
+}
+
+
+// ******** local function implementations ********
+static void runRound(size_t numTimersIn)
+{
+	uint64_t heap_ns, heap_cycles, linear_ns, linear_cycles;
+	uint64_t heapChecksum = runHeap(numTimersIn, &heap_ns, &heap_cycles);
+	uint64_t linearChecksum = runLinear(numTimersIn, &linear_ns, &linear_cycles);
+	cxa_test_check(heapChecksum == linearChecksum);
+
+	printf("%7zu %10.1f %10.1f %12.1f %12.1f %8.1fx\n", numTimersIn,
+		   (double)heap_ns / NUM_ITERATIONS, (double)linear_ns / NUM_ITERATIONS,
+		   (double)heap_cycles / NUM_ITERATIONS, (double)linear_cycles / NUM_ITERATIONS,
+		   (double)linear_ns / (double)heap_ns);
+}
+
+
+static uint64_t runHeap(size_t numTimersIn, uint64_t *const elapsed_nsOut, uint64_t *const elapsed_cyclesOut)
+{
+	cxa_fixedHeap_t heap;
+	cxa_fixedHeap_init(&heap, sizeof(*heapBuffer), heapBuffer, numTimersIn * sizeof(*heapBuffer),
+					   heapIndexBuffer, sizeof(heapIndexBuffer), compareTimers);
+
+	randomState = 1;
+	for( size_t i = 0; i < numTimersIn; i++ )
+	{
+		benchTimer_t newTimer = {nextRandom() % MAX_DELAY, (uint32_t)i};
+		heapHandles[i] = cxa_fixedHeap_insert(&heap, &newTimer);
+		cxa_assert(heapHandles[i]);
+	}
+
+	uint64_t checksum = 0;
+	uint64_t start_cycles = cxa_test_getCycles();
+	uint64_t start_ns = cxa_test_getTime_ns();
+	for( size_t i = 0; i < NUM_ITERATIONS; i++ )
+	{
+		// serve the soonest and reschedule it
+		benchTimer_t* soonest = cxa_fixedHeap_peek(&heap);
+		uint32_t now = soonest->expiry;
+		checksum += now + soonest->id;
+		soonest->expiry = now + 1 + (nextRandom() % MAX_DELAY);
+		cxa_fixedHeap_update(&heap, soonest);
+
+		// pull another one in
+		benchTimer_t* other = heapHandles[i % numTimersIn];
+		if( other->expiry > (now + 1) )
+		{
+			other->expiry = now + 1 + ((other->expiry - now) / 2);
+			cxa_fixedHeap_update(&heap, other);
+		}
+	}
+	*elapsed_cyclesOut = cxa_test_getCycles() - start_cycles;
+	*elapsed_nsOut = cxa_test_getTime_ns() - start_ns;
+
+	return checksum;
+}
+
+
+static uint64_t runLinear(size_t numTimersIn, uint64_t *const elapsed_nsOut, uint64_t *const elapsed_cyclesOut)
+{
+	randomState = 1;
+	for( size_t i = 0; i < numTimersIn; i++ )
+	{
+		linearTimers[i].expiry = nextRandom() % MAX_DELAY;
+		linearTimers[i].id = (uint32_t)i;
+	}
+
+	uint64_t checksum = 0;
+	uint64_t start_cycles = cxa_test_getCycles();
+	uint64_t start_ns = cxa_test_getTime_ns();
+	for( size_t i = 0; i < NUM_ITERATIONS; i++ )
+	{
+		// serve the soonest and reschedule it
+		benchTimer_t* soonest = &linearTimers[0];
+		for( size_t j = 1; j < numTimersIn; j++ )
+		{
+			if( compareTimers(&linearTimers[j], soonest) < 0 ) soonest = &linearTimers[j];
+		}
+		uint32_t now = soonest->expiry;
+		checksum += now + soonest->id;
+		soonest->expiry = now + 1 + (nextRandom() % MAX_DELAY);
+
+		// pull another one in
+		benchTimer_t* other = &linearTimers[i % numTimersIn];
+		if( other->expiry > (now + 1) ) other->expiry = now + 1 + ((other->expiry - now) / 2);
+	}
+	*elapsed_cyclesOut = cxa_test_getCycles() - start_cycles;
+	*elapsed_nsOut = cxa_test_getTime_ns() - start_ns;
+
+	return checksum;
+}
+
+
+static uint32_t nextRandom(void)
+{
+	// xorshift32: cheap and identical for both runs
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+
+static int compareTimers(const void *const aIn, const void *const bIn)
+{
+	const benchTimer_t* a = (const benchTimer_t*)aIn;
+	const benchTimer_t* b = (const benchTimer_t*)bIn;
+
+	if( a->expiry != b->expiry ) return (a->expiry < b->expiry) ? -1 : 1;
+	return (a->id < b->id) ? -1 : (a->id > b->id);
+}
@@ -0,0 +1,152 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * Measures the cost of building and parsing a message made of a chain of
+ * cxa_linkedFields, at 4, 16 and 64 fields per message:
+ * - build: init the root and children empty, then append a uint16 to each
+ *   field twice (the pattern used when composing mqtt/rpc messages)
+ * - parse: init the root and children with their sizes over an already
+ *   filled buffer, then read a uint16 from each field (the pattern used when
+ *   decoding a received message)
+ *
+ * Each row reports ns and cycles (see ::cxa_test_getCycles) per message and
+ * per field. Per-field cost that stays flat as the chain grows means the
+ * operations are O(1) in the field's position.
+ *
+ * Build (from the repository root, see test/README.md):
+ * @code
+ * gcc -std=gnu99 -O2 $CXA_TEST_INCLUDES -o linkedField_bench test/bench/cxa_linkedField_bench.c test/support/cxa_test.c \
+ * 	src/collections/cxa_linkedField.c src/collections/cxa_fixedByteBuffer.c src/collections/cxa_array.c \
+ * 	src/misc/cxa_assert.c src/misc/cxa_stringUtils.c src/misc/cxa_numberUtils.c src/misc/cxa_encodingUtils.c \
+ * 	src/logger/cxa_logger.c src/runLoop/cxa_runLoop.c src/serial/cxa_ioStream.c src/timeUtils/cxa_timeDiff.c \
+ * 	src/arch-posix/cxa_posix_timeBase.c src/arch-posix/cxa_posix_criticalSection.c -lpthread
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <stdio.h>
+
+#include <cxa_fixedByteBuffer.h>
+#include <cxa_linkedField.h>
+#include <cxa_test.h>
+
+
+// ******** local macro definitions ********
+#define MAX_NUM_FIELDS					64
+#define FIELD_SIZE_BYTES				4
+#define NUM_FIELDS_PER_ITERATION		(256 * 1024)
+
+
+// ******** local type definitions ********
+typedef bool (*roundFunc_t)(size_t numFieldsIn, uint32_t *const checksumOut);
+
+
+// ******** local function prototypes ********
+static void runRound(const char *const opIn, roundFunc_t funcIn, size_t numFieldsIn);
+
+static bool buildMessage(size_t numFieldsIn, uint32_t *const checksumOut);
+static bool parseMessage(size_t numFieldsIn, uint32_t *const checksumOut);
+
+
+// ********  local variable declarations *********
+static uint8_t buffer[MAX_NUM_FIELDS * FIELD_SIZE_BYTES];
+static cxa_fixedByteBuffer_t fbb;
+static cxa_linkedField_t fields[MAX_NUM_FIELDS];
+
+static const size_t NUM_FIELDS[] = {4, 16, 64};
+
+
+// ******** global function implementations ********
+int main(void)
+{
+	cxa_test_init();
+
+	printf("%-6s %7s %12s %14s %12s %14s\n", "op", "fields", "ns/msg", "cycles/msg", "ns/field", "cycles/field");
+	for( size_t i = 0; i < sizeof(NUM_FIELDS)/sizeof(*NUM_FIELDS); i++ )
+	{
+		runRound("build", buildMessage, NUM_FIELDS[i]);
+		runRound("parse", parseMessage, NUM_FIELDS[i]);
+	}
+
+	return cxa_test_finish("linkedField_bench");
+}
+
+
+// ******** local function implementations ********
+static void runRound(const char *const opIn, roundFunc_t funcIn, size_t numFieldsIn)
+{
+	// every field holds (index, index) as two big-endian uint16s
+	uint32_t expectedChecksum = 0;
+	for( size_t i = 0; i < numFieldsIn; i++ ) expectedChecksum += 2 * i;
+
+	// leave a built message in the buffer for parsing
+	uint32_t checksum;
+	if( !cxa_test_check(buildMessage(numFieldsIn, &checksum)) ) return;
+
+	size_t numMessages = NUM_FIELDS_PER_ITERATION / numFieldsIn;
+	bool isValid = true;
+	uint64_t start_cycles = cxa_test_getCycles();
+	uint64_t start_ns = cxa_test_getTime_ns();
+	for( size_t i = 0; i < numMessages; i++ )
+	{
+		if( !funcIn(numFieldsIn, &checksum) || (checksum != expectedChecksum) ) isValid = false;
+	}
+	uint64_t elapsed_cycles = cxa_test_getCycles() - start_cycles;
+	uint64_t elapsed_ns = cxa_test_getTime_ns() - start_ns;
+	cxa_test_check(isValid);
+
+	double nsPerMsg = (double)elapsed_ns / (double)numMessages;
+	double cyclesPerMsg = (double)elapsed_cycles / (double)numMessages;
+	printf("%-6s %7zu %12.1f %14.0f %12.1f %14.1f\n", opIn, numFieldsIn,
+		   nsPerMsg, cyclesPerMsg, nsPerMsg / (double)numFieldsIn, cyclesPerMsg / (double)numFieldsIn);
+}
+
+
+static bool buildMessage(size_t numFieldsIn, uint32_t *const checksumOut)
+{
+	cxa_fixedByteBuffer_initStd(&fbb, buffer);
+	if( !cxa_linkedField_initRoot(&fields[0], &fbb, 0, 0) ) return false;
+	for( size_t i = 1; i < numFieldsIn; i++ )
+	{
+		if( !cxa_linkedField_initChild(&fields[i], &fields[i-1], 0) ) return false;
+	}
+
+	uint32_t checksum = 0;
+	for( size_t i = 0; i < numFieldsIn; i++ )
+	{
+		if( !cxa_linkedField_append_uint16BE(&fields[i], i) || !cxa_linkedField_append_uint16BE(&fields[i], i) ) return false;
+		checksum += 2 * i;
+	}
+
+	*checksumOut = checksum;
+	return (cxa_fixedByteBuffer_getSize_bytes(&fbb) == (numFieldsIn * FIELD_SIZE_BYTES));
+}
+
+
+static bool parseMessage(size_t numFieldsIn, uint32_t *const checksumOut)
+{
+	cxa_fixedByteBuffer_init_inPlace(&fbb, numFieldsIn * FIELD_SIZE_BYTES, buffer, sizeof(buffer));
+	if( !cxa_linkedField_initRoot(&fields[0], &fbb, 0, FIELD_SIZE_BYTES) ) return false;
+	for( size_t i = 1; i < numFieldsIn; i++ )
+	{
+		if( !cxa_linkedField_initChild(&fields[i], &fields[i-1], FIELD_SIZE_BYTES) ) return false;
+	}
+
+	uint32_t checksum = 0;
+	for( size_t i = 0; i < numFieldsIn; i++ )
+	{
+		uint16_t first, second;
+		if( !cxa_linkedField_get_uint16BE(&fields[i], 0, first) || !cxa_linkedField_get_uint16BE(&fields[i], 2, second) ) return false;
+		checksum += (uint32_t)first + second;
+	}
+
+	*checksumOut = checksum;
+	return true;
+}
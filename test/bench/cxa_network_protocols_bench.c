@@ -0,0 +1,639 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * End-to-end benchmark of the networking stacks on the posix backend, each
+ * against a local stand-in peer running in its own thread:
+ * - mqtt pub/sub: cxa_mqtt_client publishes to a topic it is subscribed to,
+ *   a minimal broker routes the message back (publish until onPublish)
+ * - rpc: the broker stand-in calls a method on a cxa_mqtt_rpc_node_root
+ *   (request publish until the response publish reaches the broker)
+ * - http post: cxa_network_httpClient POSTs to a keep-alive HTTP server
+ *   that echoes the body (post_async until onComplete)
+ * - tcp echo: a cxa_network_tcpClient writes a message and reads it back
+ *   from an echo server
+ *
+ * - mqtt sleep: mqtt pub/sub again, but the runLoop sleeps between iterations
+ *   the way cxa_runLoop_execute does, so each message is only seen because
+ *   the socket wakes the runLoop
+ *
+ * One message is outstanding at a time. Each row reports messages/s, p50/p99
+ * latency (see cxa_perfStats) and the runLoop thread's CPU time per message.
+ * Except for mqtt sleep, the runLoop is iterated continuously, so CPU per
+ * message includes polling while waiting on the peer: compare it between
+ * revisions rather than reading it as the pure protocol cost.
+ *
+ * Finally, with everything connected but quiet, the runLoop is executed for
+ * IDLE_DURATION_MS and the thread's CPU time is reported (it should sleep).
+ *
+ * The default MQTT message pool (2 x 64 bytes) is too small for a 64-byte
+ * payload plus topic while the rpc node holds a response, hence the defines.
+ *
+ * Build (from the repository root, see test/README.md):
+ * @code
+ * gcc -std=gnu99 -O2 -DCXA_MQTT_MESSAGEFACTORY_NUM_MESSAGES=4 -DCXA_MQTT_MESSAGEFACTORY_MESSAGE_SIZE_BYTES=256 $CXA_TEST_INCLUDES -o protocols_bench test/bench/cxa_network_protocols_bench.c test/support/cxa_test.c \
+ * 	src/mqtt/cxa_mqtt_client.c src/mqtt/cxa_mqtt_client_network.c src/mqtt/cxa_mqtt_messageFactory.c \
+ * 	src/mqtt/cxa_protocolParser_mqtt.c src/mqtt/messages/cxa_mqtt_message*.c src/mqtt/rpc/cxa_mqtt_rpc_node.c \
+ * 	src/mqtt/rpc/cxa_mqtt_rpc_node_root.c src/net/http/cxa_network_httpClient.c \
+ * 	src/net/posix/cxa_posix_network_*.c src/net/cxa_network_tcpClient.c src/net/cxa_network_tcpServer.c \
+ * 	src/net/cxa_network_tcpServer_connectedClient.c src/net/cxa_network_dnsCache.c src/runLoop/cxa_runLoop.c \
+ * 	src/stateMachine/cxa_stateMachine.c src/logger/cxa_logger.c src/misc/cxa_assert.c src/misc/cxa_stringUtils.c \
+ * 	src/misc/cxa_numberUtils.c src/misc/cxa_encodingUtils.c src/collections/cxa_array.c src/collections/cxa_fixedByteBuffer.c \
+ * 	src/collections/cxa_fixedFifo.c src/collections/cxa_linkedField.c src/serial/cxa_ioStream.c \
+ * 	src/serial/cxa_ioStream_nullablePassthrough.c src/serial/cxa_protocolParser.c src/timeUtils/cxa_perfStats.c \
+ * 	src/timeUtils/cxa_timeDiff.c src/arch-posix/cxa_posix_timeBase.c src/arch-posix/cxa_posix_criticalSection.c -lpthread
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <cxa_assert.h>
+#include <cxa_mqtt_client_network.h>
+#include <cxa_mqtt_rpc_node_root.h>
+#include <cxa_network_factory.h>
+#include <cxa_network_httpClient.h>
+#include <cxa_network_tcpClient.h>
+#include <cxa_perfStats.h>
+#include <cxa_runLoop.h>
+#include <cxa_test.h>
+
+
+// ******** local macro definitions ********
+#define THREAD_ID						CXA_RUNLOOP_THREADID_DEFAULT
+#define TIMEOUT_MS						5000
+
+#define NUM_MESSAGES					5000
+#define IDLE_DURATION_MS				2000
+#define MAX_IDLE_CPU_PERCENT			2.0
+#define PAYLOAD_SIZE_BYTES				64
+
+#define MQTT_TOPIC						"bench/loop"
+#define RPC_NODE_NAME					"benchNode"
+#define RPC_REQUEST_TOPIC				"v1/->/" RPC_NODE_NAME "/echo"
+#define RPC_RESPONSE_TOPIC				"v1/<-/" RPC_NODE_NAME "/echo"
+
+#define MQTT_PACKETTYPE_CONNECT			0x10
+#define MQTT_PACKETTYPE_PUBLISH			0x30
+#define MQTT_PACKETTYPE_SUBSCRIBE		0x80
+#define MQTT_PACKETTYPE_PINGREQ			0xC0
+#define MQTT_PACKETTYPE_DISCONNECT		0xE0
+
+
+// ******** local type definitions ********
+typedef struct
+{
+	const char* name;
+	uint64_t startTime_ns;
+	uint64_t startCpuTime_ns;
+	cxa_perfStats_t stats;
+}round_t;
+
+
+// ******** local function prototypes ********
+static uint16_t startServer(void* (*threadFuncIn)(void*));
+static void* serverThread_mqttBroker(void* userVarIn);
+static void* serverThread_http(void* userVarIn);
+static void* serverThread_echo(void* userVarIn);
+
+static bool mqtt_readPacket(int fdIn, uint8_t *const typeOut, uint8_t *const bodyOut, size_t maxBodyLen_bytesIn, size_t *const bodyLen_bytesOut);
+static bool mqtt_writePacket(int fdIn, uint8_t typeIn, const uint8_t *const bodyIn, size_t bodyLen_bytesIn);
+static bool mqtt_writePublish(int fdIn, const char *const topicIn, const uint8_t *const payloadIn, size_t payloadLen_bytesIn);
+static bool mqtt_isPublishTo(const uint8_t *const bodyIn, size_t bodyLen_bytesIn, const char *const topicIn);
+static void rpc_runCaller(int fdIn);
+
+static bool readAll(int fdIn, void *const dataOut, size_t numBytesIn);
+static bool sendAll(int fdIn, const void *const dataIn, size_t numBytesIn);
+
+static void bench_mqttPubSub(cxa_mqtt_client_t *const clientIn, bool shouldSleepIn);
+static void bench_rpc(cxa_mqtt_client_t *const clientIn);
+static void bench_httpPost(uint16_t portIn);
+static void bench_tcpEcho(uint16_t portIn);
+static void bench_idle(void);
+
+static void round_start(round_t *const roundIn, const char *const nameIn);
+static void round_finish(round_t *const roundIn);
+
+static void mqttCb_onConnect(cxa_mqtt_client_t *const clientIn, void* userVarIn);
+static void mqttCb_onPublish(cxa_mqtt_client_t *const clientIn, cxa_mqtt_message_t *const msgIn,
+							 char* topicNameIn, size_t topicNameLen_bytesIn, void* payloadIn, size_t payloadLen_bytesIn, void* userVarIn);
+static cxa_mqtt_rpc_methodRetVal_t rpcCb_echo(cxa_mqtt_rpc_node_t *const nodeIn,
+											  cxa_linkedField_t *const paramsIn, cxa_linkedField_t *const returnParamsOut,
+											  void* userVarIn);
+static void httpCb_onComplete(cxa_network_httpClient_t *const clientIn, bool didCompleteSuccessfullyIn,
+							  uint16_t statusIn, char *const bodyIn, size_t bodySize_bytesIn, void* userVarIn);
+static bool httpCb_genBody(cxa_network_httpClient_t *const clientIn, cxa_ioStream_t *const iosIn, void* userVarIn);
+
+
+// ********  local variable declarations *********
+static uint8_t payload[PAYLOAD_SIZE_BYTES];
+
+static volatile bool isMqttConnected = false;
+static volatile bool didReceive = false;
+static volatile bool wasSuccessful = false;
+
+// driven by the broker stand-in (the rpc caller)
+static volatile bool isRpcSubscribed = false;
+static volatile bool isRpcStarted = false;
+static volatile bool isRpcDone = false;
+static uint32_t rpcLatencies_us[NUM_MESSAGES];
+static volatile size_t rpcNumCalls = 0;
+
+
+// ******** global function implementations ********
+int main(void)
+{
+	cxa_test_init();
+	for( size_t i = 0; i < sizeof(payload); i++ ) payload[i] = (uint8_t)('a' + (i % 26));
+
+	uint16_t brokerPort = startServer(serverThread_mqttBroker);
+	uint16_t httpPort = startServer(serverThread_http);
+	uint16_t echoPort = startServer(serverThread_echo);
+
+	static cxa_mqtt_client_network_t mqttClient;
+	cxa_mqtt_client_network_init(&mqttClient, "benchClient", THREAD_ID);
+	cxa_mqtt_client_addListener(&mqttClient.super, mqttCb_onConnect, NULL, NULL, NULL, NULL);
+	cxa_mqtt_client_subscribe(&mqttClient.super, MQTT_TOPIC, CXA_MQTT_QOS_ATMOST_ONCE, mqttCb_onPublish, NULL);
+
+	static cxa_mqtt_rpc_node_root_t rpcRoot;
+	cxa_mqtt_rpc_node_root_init(&rpcRoot, &mqttClient.super, false, RPC_NODE_NAME);
+	cxa_mqtt_rpc_node_addMethod(&rpcRoot.super, "echo", rpcCb_echo, NULL);
+
+	// let our state machines start up
+	cxa_test_iterateFor(THREAD_ID, 10);
+	cxa_test_check(cxa_mqtt_client_network_connectToHost(&mqttClient, "127.0.0.1", brokerPort, false, NULL, NULL, 0));
+	if( !cxa_test_check(cxa_test_iterateUntil(THREAD_ID, &isMqttConnected, TIMEOUT_MS)) ||
+		!cxa_test_check(cxa_test_iterateUntil(THREAD_ID, &isRpcSubscribed, TIMEOUT_MS)) ) return cxa_test_finish("network_protocols_bench");
+	cxa_test_iterateFor(THREAD_ID, 50);
+
+	printf("%d x %d-byte messages per round, one outstanding\n", NUM_MESSAGES, PAYLOAD_SIZE_BYTES);
+	printf("%-12s %10s %10s %10s %16s\n", "protocol", "msgs/s", "p50", "p99", "cpu/msg (us)");
+
+	bench_mqttPubSub(&mqttClient.super, false);
+	bench_rpc(&mqttClient.super);
+	bench_httpPost(httpPort);
+	bench_tcpEcho(echoPort);
+	bench_mqttPubSub(&mqttClient.super, true);
+
+	bench_idle();
+
+	return cxa_test_finish("network_protocols_bench");
+}
+
+
+// ******** local function implementations ********
+static uint16_t startServer(void* (*threadFuncIn)(void*))
+{
+	int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+	cxa_assert(listenFd >= 0);
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0;
+	socklen_t addrLen = sizeof(addr);
+	cxa_assert( (bind(listenFd, (struct sockaddr*)&addr, sizeof(addr)) == 0) &&
+				(listen(listenFd, 8) == 0) &&
+				(getsockname(listenFd, (struct sockaddr*)&addr, &addrLen) == 0) );
+
+	pthread_t thread;
+	pthread_create(&thread, NULL, threadFuncIn, (void*)(intptr_t)listenFd);
+	pthread_detach(thread);
+
+	return ntohs(addr.sin_port);
+}
+
+
+static void* serverThread_mqttBroker(void* userVarIn)
+{
+	// a single client, QoS 0 only: route its publishes back to it and, once it
+	// has subscribed to rpc requests, act as the rpc caller
+	int listenFd = (int)(intptr_t)userVarIn;
+	int connFd = accept(listenFd, NULL, NULL);
+	int noDelay = 1;
+	setsockopt(connFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+	static uint8_t body[1024];
+	uint8_t type;
+	size_t bodyLen_bytes;
+	while( mqtt_readPacket(connFd, &type, body, sizeof(body), &bodyLen_bytes) )
+	{
+		switch( type & 0xF0 )
+		{
+			case MQTT_PACKETTYPE_CONNECT:
+			{
+				static const uint8_t connack[] = {0x00, 0x00};
+				mqtt_writePacket(connFd, 0x20, connack, sizeof(connack));
+				break;
+			}
+
+			case MQTT_PACKETTYPE_SUBSCRIBE:
+			{
+				uint8_t suback[] = {body[0], body[1], 0x00};
+				mqtt_writePacket(connFd, 0x90, suback, sizeof(suback));
+
+				uint16_t topicLen_bytes = (uint16_t)((body[2] << 8) | body[3]);
+				if( (topicLen_bytes <= (bodyLen_bytes - 4)) && (strncmp((char*)&body[4], "v1/->/" RPC_NODE_NAME "/", 16) == 0) ) isRpcSubscribed = true;
+				break;
+			}
+
+			case MQTT_PACKETTYPE_PUBLISH:
+				if( mqtt_isPublishTo(body, bodyLen_bytes, MQTT_TOPIC) ) mqtt_writePacket(connFd, type, body, bodyLen_bytes);
+				break;
+
+			case MQTT_PACKETTYPE_PINGREQ:
+				mqtt_writePacket(connFd, 0xD0, NULL, 0);
+				break;
+
+			case MQTT_PACKETTYPE_DISCONNECT:
+				close(connFd);
+				return NULL;
+		}
+
+		if( isRpcStarted && !isRpcDone ) rpc_runCaller(connFd);
+	}
+
+	close(connFd);
+	return NULL;
+}
+
+
+static void* serverThread_http(void* userVarIn)
+{
+	int listenFd = (int)(intptr_t)userVarIn;
+	int connFd;
+	while( (connFd = accept(listenFd, NULL, NULL)) >= 0 )
+	{
+		int noDelay = 1;
+		setsockopt(connFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+		// keep-alive: serve requests until the client goes away
+		while( 1 )
+		{
+			char head[1024];
+			size_t headLen = 0;
+			while( (headLen < 4) || (memcmp(&head[headLen-4], "\r\n\r\n", 4) != 0) )
+			{
+				if( (headLen == sizeof(head)-1) || (read(connFd, &head[headLen], 1) != 1) ) break;
+				headLen++;
+			}
+			if( (headLen < 4) || (memcmp(&head[headLen-4], "\r\n\r\n", 4) != 0) ) break;
+			head[headLen] = 0;
+
+			// echo the body back
+			long contentLength = 0;
+			for( char* currLine = strstr(head, "\r\n"); (currLine != NULL) && (currLine[2] != '\r'); currLine = strstr(currLine+2, "\r\n") )
+			{
+				if( strncasecmp(&currLine[2], "Content-Length:", 15) == 0 ) contentLength = strtol(&currLine[17], NULL, 10);
+			}
+			static char body[1024];
+			if( (contentLength > (long)sizeof(body)) || !readAll(connFd, body, (size_t)contentLength) ) break;
+
+			char respHead[128];
+			int respHeadLen = snprintf(respHead, sizeof(respHead), "HTTP/1.1 200 OK\r\nContent-Length: %ld\r\n\r\n", contentLength);
+			if( !sendAll(connFd, respHead, (size_t)respHeadLen) || !sendAll(connFd, body, (size_t)contentLength) ) break;
+		}
+		close(connFd);
+	}
+	return NULL;
+}
+
+
+static void* serverThread_echo(void* userVarIn)
+{
+	int listenFd = (int)(intptr_t)userVarIn;
+	int connFd;
+	while( (connFd = accept(listenFd, NULL, NULL)) >= 0 )
+	{
+		int noDelay = 1;
+		setsockopt(connFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+		uint8_t buffer[1024];
+		ssize_t numBytesRead;
+		while( (numBytesRead = read(connFd, buffer, sizeof(buffer))) > 0 )
+		{
+			if( !sendAll(connFd, buffer, (size_t)numBytesRead) ) break;
+		}
+		close(connFd);
+	}
+	return NULL;
+}
+
+
+static bool mqtt_readPacket(int fdIn, uint8_t *const typeOut, uint8_t *const bodyOut, size_t maxBodyLen_bytesIn, size_t *const bodyLen_bytesOut)
+{
+	if( !readAll(fdIn, typeOut, 1) ) return false;
+
+	// variable-length remaining length
+	size_t remainingLen_bytes = 0;
+	for( int shift = 0; shift < 28; shift += 7 )
+	{
+		uint8_t currByte;
+		if( !readAll(fdIn, &currByte, 1) ) return false;
+		remainingLen_bytes |= (size_t)(currByte & 0x7F) << shift;
+		if( (currByte & 0x80) == 0 ) break;
+	}
+
+	*bodyLen_bytesOut = remainingLen_bytes;
+	return (remainingLen_bytes <= maxBodyLen_bytesIn) && readAll(fdIn, bodyOut, remainingLen_bytes);
+}
+
+
+static bool mqtt_writePacket(int fdIn, uint8_t typeIn, const uint8_t *const bodyIn, size_t bodyLen_bytesIn)
+{
+	uint8_t head[5] = {typeIn};
+	size_t headLen = 1;
+	size_t remainingLen_bytes = bodyLen_bytesIn;
+	do
+	{
+		head[headLen] = remainingLen_bytes & 0x7F;
+		remainingLen_bytes >>= 7;
+		if( remainingLen_bytes > 0 ) head[headLen] |= 0x80;
+		headLen++;
+	} while( remainingLen_bytes > 0 );
+
+	return sendAll(fdIn, head, headLen) && ((bodyLen_bytesIn == 0) || sendAll(fdIn, bodyIn, bodyLen_bytesIn));
+}
+
+
+static bool mqtt_writePublish(int fdIn, const char *const topicIn, const uint8_t *const payloadIn, size_t payloadLen_bytesIn)
+{
+	uint8_t body[512];
+	size_t topicLen_bytes = strlen(topicIn);
+	if( (2 + topicLen_bytes + payloadLen_bytesIn) > sizeof(body) ) return false;
+
+	body[0] = (uint8_t)(topicLen_bytes >> 8);
+	body[1] = (uint8_t)topicLen_bytes;
+	memcpy(&body[2], topicIn, topicLen_bytes);
+	memcpy(&body[2 + topicLen_bytes], payloadIn, payloadLen_bytesIn);
+
+	return mqtt_writePacket(fdIn, MQTT_PACKETTYPE_PUBLISH, body, 2 + topicLen_bytes + payloadLen_bytesIn);
+}
+
+
+static bool mqtt_isPublishTo(const uint8_t *const bodyIn, size_t bodyLen_bytesIn, const char *const topicIn)
+{
+	if( bodyLen_bytesIn < 2 ) return false;
+	size_t topicLen_bytes = (size_t)((bodyIn[0] << 8) | bodyIn[1]);
+
+	return (topicLen_bytes == strlen(topicIn)) && (topicLen_bytes <= (bodyLen_bytesIn - 2)) && (memcmp(&bodyIn[2], topicIn, topicLen_bytes) == 0);
+}
+
+
+static void rpc_runCaller(int fdIn)
+{
+	static uint8_t body[1024];
+	for( rpcNumCalls = 0; rpcNumCalls < NUM_MESSAGES; rpcNumCalls++ )
+	{
+		uint64_t startTime_ns = cxa_test_getTime_ns();
+		if( !mqtt_writePublish(fdIn, RPC_REQUEST_TOPIC, payload, sizeof(payload)) ) break;
+
+		// wait for the response (answering anything else that arrives meanwhile)
+		uint8_t type;
+		size_t bodyLen_bytes;
+		bool gotResponse = false;
+		while( !gotResponse && mqtt_readPacket(fdIn, &type, body, sizeof(body), &bodyLen_bytes) )
+		{
+			if( ((type & 0xF0) == MQTT_PACKETTYPE_PUBLISH) && mqtt_isPublishTo(body, bodyLen_bytes, RPC_RESPONSE_TOPIC) )
+			{
+				// payload is the return value followed by our echoed params
+				size_t payloadOffset = 2 + strlen(RPC_RESPONSE_TOPIC);
+				gotResponse = (bodyLen_bytes == (payloadOffset + 1 + sizeof(payload))) && (body[payloadOffset] == CXA_MQTT_RPC_METHODRETVAL_SUCCESS) &&
+							  (memcmp(&body[payloadOffset + 1], payload, sizeof(payload)) == 0);
+				if( !gotResponse ) break;
+			}
+			else if( (type & 0xF0) == MQTT_PACKETTYPE_PINGREQ ) mqtt_writePacket(fdIn, 0xD0, NULL, 0);
+		}
+		if( !gotResponse ) break;
+
+		rpcLatencies_us[rpcNumCalls] = (uint32_t)((cxa_test_getTime_ns() - startTime_ns) / 1000);
+	}
+	isRpcDone = true;
+}
+
+
+static bool readAll(int fdIn, void *const dataOut, size_t numBytesIn)
+{
+	uint8_t* currByte = (uint8_t*)dataOut;
+	while( numBytesIn > 0 )
+	{
+		ssize_t numBytesRead = read(fdIn, currByte, numBytesIn);
+		if( numBytesRead <= 0 ) return false;
+		currByte += numBytesRead;
+		numBytesIn -= (size_t)numBytesRead;
+	}
+	return true;
+}
+
+
+static bool sendAll(int fdIn, const void *const dataIn, size_t numBytesIn)
+{
+	const uint8_t* currByte = (const uint8_t*)dataIn;
+	while( numBytesIn > 0 )
+	{
+		ssize_t numBytesSent = send(fdIn, currByte, numBytesIn, MSG_NOSIGNAL);
+		if( numBytesSent <= 0 ) return false;
+		currByte += numBytesSent;
+		numBytesIn -= (size_t)numBytesSent;
+	}
+	return true;
+}
+
+
+static void bench_mqttPubSub(cxa_mqtt_client_t *const clientIn, bool shouldSleepIn)
+{
+	round_t round;
+	round_start(&round, (shouldSleepIn ? "mqtt sleep" : "mqtt pubsub"));
+	for( size_t i = 0; i < NUM_MESSAGES; i++ )
+	{
+		uint64_t startTime_ns = cxa_test_getTime_ns();
+		didReceive = false;
+		wasSuccessful = false;
+		if( !cxa_test_check(cxa_mqtt_client_publish(clientIn, CXA_MQTT_QOS_ATMOST_ONCE, false, MQTT_TOPIC, payload, sizeof(payload))) ||
+			!cxa_test_check(shouldSleepIn ? cxa_test_executeUntil(THREAD_ID, &didReceive, TIMEOUT_MS) : cxa_test_iterateUntil(THREAD_ID, &didReceive, TIMEOUT_MS)) ||
+			!cxa_test_check(wasSuccessful) ) break;
+		cxa_perfStats_recordSample(&round.stats, (uint32_t)((cxa_test_getTime_ns() - startTime_ns) / 1000), sizeof(payload));
+	}
+	round_finish(&round);
+}
+
+
+static void bench_rpc(cxa_mqtt_client_t *const clientIn)
+{
+	// the broker stand-in is the caller...we just service its requests
+	// (it starts after the next packet it receives, so poke it with a publish)
+	round_t round;
+	round_start(&round, "mqtt rpc");
+	isRpcStarted = true;
+	cxa_test_check(cxa_mqtt_client_publish(clientIn, CXA_MQTT_QOS_ATMOST_ONCE, false, MQTT_TOPIC, payload, sizeof(payload)));
+	cxa_test_check(cxa_test_iterateUntil(THREAD_ID, &isRpcDone, NUM_MESSAGES * 10));
+	cxa_test_check(rpcNumCalls == NUM_MESSAGES);
+	for( size_t i = 0; i < rpcNumCalls; i++ ) cxa_perfStats_recordSample(&round.stats, rpcLatencies_us[i], sizeof(payload));
+	round_finish(&round);
+}
+
+
+static void bench_httpPost(uint16_t portIn)
+{
+	static cxa_network_httpClient_t client;
+	cxa_network_httpClient_init(&client, THREAD_ID);
+	cxa_test_iterateFor(THREAD_ID, 10);
+
+	static uint8_t respBuffer[PAYLOAD_SIZE_BYTES + 1];
+	round_t round;
+	round_start(&round, "http post");
+	for( size_t i = 0; i < NUM_MESSAGES; i++ )
+	{
+		uint64_t startTime_ns = cxa_test_getTime_ns();
+		didReceive = false;
+		wasSuccessful = false;
+		cxa_network_httpClient_post_async(&client, "127.0.0.1", portIn, false, "/echo", TIMEOUT_MS, true,
+										  NULL, httpCb_genBody, httpCb_onComplete, respBuffer, sizeof(respBuffer), NULL);
+		if( !cxa_test_check(cxa_test_iterateUntil(THREAD_ID, &didReceive, TIMEOUT_MS)) || !cxa_test_check(wasSuccessful) ) break;
+		cxa_perfStats_recordSample(&round.stats, (uint32_t)((cxa_test_getTime_ns() - startTime_ns) / 1000), sizeof(payload));
+
+		// the client returns to idle on its next iteration
+		while( !cxa_network_httpClient_isIdle(&client) ) cxa_runLoop_iterate(THREAD_ID);
+	}
+	round_finish(&round);
+}
+
+
+static void bench_tcpEcho(uint16_t portIn)
+{
+	cxa_network_tcpClient_t* client = cxa_network_factory_reserveTcpClient(THREAD_ID);
+	cxa_assert(client);
+	cxa_test_iterateFor(THREAD_ID, 10);
+	cxa_test_check(cxa_network_tcpClient_connectToHost(client, "127.0.0.1", portIn, false, TIMEOUT_MS));
+	for( uint64_t startTime_ns = cxa_test_getTime_ns(); !cxa_network_tcpClient_isConnected(client) && ((cxa_test_getTime_ns() - startTime_ns) < (TIMEOUT_MS * 1000000ULL)); )
+	{
+		cxa_runLoop_iterate(THREAD_ID);
+	}
+	if( !cxa_test_check(cxa_network_tcpClient_isConnected(client)) ) return;
+	cxa_ioStream_t* ios = cxa_network_tcpClient_getIoStream(client);
+
+	round_t round;
+	round_start(&round, "tcp echo");
+	for( size_t i = 0; i < NUM_MESSAGES; i++ )
+	{
+		uint64_t startTime_ns = cxa_test_getTime_ns();
+		if( !cxa_test_check(cxa_ioStream_writeBytes(ios, payload, sizeof(payload))) ) break;
+
+		size_t numBytesRead = 0;
+		bool isValid = true;
+		while( (numBytesRead < sizeof(payload)) && ((cxa_test_getTime_ns() - startTime_ns) < (TIMEOUT_MS * 1000000ULL)) )
+		{
+			uint8_t rxByte;
+			cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(ios, &rxByte);
+			if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
+			{
+				if( rxByte != payload[numBytesRead] ) isValid = false;
+				numBytesRead++;
+			}
+			else if( readStat == CXA_IOSTREAM_READSTAT_NODATA ) cxa_runLoop_iterate(THREAD_ID);
+			else break;
+		}
+		if( !cxa_test_check((numBytesRead == sizeof(payload)) && isValid) ) break;
+		cxa_perfStats_recordSample(&round.stats, (uint32_t)((cxa_test_getTime_ns() - startTime_ns) / 1000), sizeof(payload));
+	}
+	round_finish(&round);
+
+	cxa_network_tcpClient_disconnect(client);
+}
+
+
+static void bench_idle(void)
+{
+	// mqtt is still connected (with its keepalive pending), the http client is idle
+	cxa_test_executeFor(THREAD_ID, 100);
+
+	uint64_t startTime_ns = cxa_test_getTime_ns();
+	uint64_t startCpuTime_ns = cxa_test_getThreadCpuTime_ns();
+	cxa_test_executeFor(THREAD_ID, IDLE_DURATION_MS);
+	uint64_t elapsed_ns = cxa_test_getTime_ns() - startTime_ns;
+	uint64_t cpuTime_ns = cxa_test_getThreadCpuTime_ns() - startCpuTime_ns;
+
+	double cpuPercent = (double)cpuTime_ns * 100.0 / (double)elapsed_ns;
+	printf("idle: %.3f ms cpu in %.0f ms (%.3f%%)\n", (double)cpuTime_ns / 1e6, (double)elapsed_ns / 1e6, cpuPercent);
+	cxa_test_check(cpuPercent < MAX_IDLE_CPU_PERCENT);
+}
+
+
+static void round_start(round_t *const roundIn, const char *const nameIn)
+{
+	roundIn->name = nameIn;
+	cxa_perfStats_init(&roundIn->stats);
+	roundIn->startTime_ns = cxa_test_getTime_ns();
+	roundIn->startCpuTime_ns = cxa_test_getThreadCpuTime_ns();
+}
+
+
+static void round_finish(round_t *const roundIn)
+{
+	uint64_t elapsed_ns = cxa_test_getTime_ns() - roundIn->startTime_ns;
+	uint64_t cpuTime_ns = cxa_test_getThreadCpuTime_ns() - roundIn->startCpuTime_ns;
+	uint32_t numSamples = cxa_perfStats_getNumSamples(&roundIn->stats);
+	if( numSamples == 0 ) return;
+
+	printf("%-12s %10.0f %7u us %7u us %16.1f\n", roundIn->name,
+		   (double)numSamples * 1e9 / (double)elapsed_ns,
+		   cxa_perfStats_getPercentile_us(&roundIn->stats, 50), cxa_perfStats_getPercentile_us(&roundIn->stats, 99),
+		   (double)cpuTime_ns / 1000.0 / (double)numSamples);
+}
+
+
+static void mqttCb_onConnect(cxa_mqtt_client_t *const clientIn, void* userVarIn)
+{
+	isMqttConnected = true;
+}
+
+
+static void mqttCb_onPublish(cxa_mqtt_client_t *const clientIn, cxa_mqtt_message_t *const msgIn,
+							 char* topicNameIn, size_t topicNameLen_bytesIn, void* payloadIn, size_t payloadLen_bytesIn, void* userVarIn)
+{
+	wasSuccessful = (payloadLen_bytesIn == sizeof(payload)) && (memcmp(payloadIn, payload, sizeof(payload)) == 0);
+	didReceive = true;
+}
+
+
+static cxa_mqtt_rpc_methodRetVal_t rpcCb_echo(cxa_mqtt_rpc_node_t *const nodeIn,
+											  cxa_linkedField_t *const paramsIn, cxa_linkedField_t *const returnParamsOut,
+											  void* userVarIn)
+{
+	size_t numBytes = cxa_linkedField_getSize_bytes(paramsIn);
+	if( (numBytes > 0) && !cxa_linkedField_append(returnParamsOut, cxa_linkedField_get_pointerToIndex(paramsIn, 0), numBytes) ) return CXA_MQTT_RPC_METHODRETVAL_FAIL_INTERNAL;
+
+	return CXA_MQTT_RPC_METHODRETVAL_SUCCESS;
+}
+
+
+static void httpCb_onComplete(cxa_network_httpClient_t *const clientIn, bool didCompleteSuccessfullyIn,
+							  uint16_t statusIn, char *const bodyIn, size_t bodySize_bytesIn, void* userVarIn)
+{
+	wasSuccessful = didCompleteSuccessfullyIn && (statusIn == 200) &&
+					(bodySize_bytesIn == sizeof(payload)) && (memcmp(bodyIn, payload, sizeof(payload)) == 0);
+	didReceive = true;
+}
+
+
+static bool httpCb_genBody(cxa_network_httpClient_t *const clientIn, cxa_ioStream_t *const iosIn, void* userVarIn)
+{
+	cxa_ioStream_writeBytes(iosIn, payload, sizeof(payload));
+	return false;
+}
@@ -0,0 +1,272 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * Measures the posix cxa_network_tcpServer backend serving an echo protocol
+ * to a growing number of concurrent clients (each a raw-socket thread):
+ * aggregate echo throughput, round-trip latency and accept latency (connect()
+ * until the first echoed byte returns, which includes any time spent waiting
+ * for a free connected client).
+ *
+ * The lwIP backend shares the single-poll servicing structure but cannot run
+ * on a host, so it is not covered here.
+ *
+ * Build (from the repository root, see test/README.md):
+ * @code
+ * gcc -std=gnu99 -O2 $CXA_TEST_INCLUDES -DCXA_POSIX_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS=16 \
+ * 	-DCXA_POSIX_NETWORK_EPOLL_MAXNUM_ENTRIES=64 -o tcpServer_bench \
+ * 	test/bench/cxa_network_tcpServer_bench.c test/support/cxa_test.c \
+ * 	src/net/posix/cxa_posix_network_epoll.c src/net/posix/cxa_posix_network_factory.c src/net/posix/cxa_posix_network_socket.c \
+ * 	src/net/posix/cxa_posix_network_tcpClient.c src/net/posix/cxa_posix_network_tcpServer.c \
+ * 	src/net/posix/cxa_posix_network_tcpServer_connectedClient.c src/net/cxa_network_tcpClient.c src/net/cxa_network_tcpServer.c \
+ * 	src/net/cxa_network_tcpServer_connectedClient.c src/net/cxa_network_dnsCache.c src/runLoop/cxa_runLoop.c \
+ * 	src/stateMachine/cxa_stateMachine.c src/logger/cxa_logger.c src/misc/cxa_assert.c src/misc/cxa_stringUtils.c \
+ * 	src/misc/cxa_numberUtils.c src/misc/cxa_encodingUtils.c src/collections/cxa_array.c src/collections/cxa_fixedByteBuffer.c \
+ * 	src/collections/cxa_fixedFifo.c src/serial/cxa_ioStream.c src/timeUtils/cxa_perfStats.c src/timeUtils/cxa_timeDiff.c \
+ * 	src/arch-posix/cxa_posix_timeBase.c src/arch-posix/cxa_posix_criticalSection.c -lpthread
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <cxa_assert.h>
+#include <cxa_network_factory.h>
+#include <cxa_network_tcpServer.h>
+#include <cxa_perfStats.h>
+#include <cxa_runLoop.h>
+#include <cxa_test.h>
+
+
+// ******** local macro definitions ********
+#define THREAD_ID						CXA_RUNLOOP_THREADID_DEFAULT
+#define PORT_NUM						47034
+
+#define MAXNUM_CLIENTS					32
+#define NUM_MESSAGES_PER_CLIENT			2000
+#define MESSAGE_SIZE_BYTES				64
+
+
+// ******** local type definitions ********
+typedef struct
+{
+	pthread_t thread;
+	bool wasSuccessful;
+
+	uint32_t acceptLatency_us;
+	uint32_t rtts_us[NUM_MESSAGES_PER_CLIENT];
+}benchClient_t;
+
+
+// ******** local function prototypes ********
+static void runRound(size_t numClientsIn);
+static void* clientThread_run(void* userVarIn);
+static bool sendAll(int fdIn, const void *const dataIn, size_t numBytesIn);
+static bool recvAll(int fdIn, void *const dataOut, size_t numBytesIn);
+
+static void cb_onConnect(cxa_network_tcpServer_t *const serverIn, cxa_network_tcpServer_connectedClient_t* clientIn, void* userVarIn);
+static void cb_echo(void* userVarIn);
+
+
+// ********  local variable declarations *********
+static cxa_network_tcpServer_t* server;
+static cxa_network_tcpServer_connectedClient_t* connectedClients[CXA_POSIX_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS];
+
+static benchClient_t clients[MAXNUM_CLIENTS];
+static volatile size_t numClientsDone;
+static pthread_mutex_t mutex_numClientsDone = PTHREAD_MUTEX_INITIALIZER;
+
+
+// ******** global function implementations ********
+int main(void)
+{
+	cxa_test_init();
+
+	server = cxa_network_factory_reserveTcpServer(THREAD_ID);
+	cxa_assert(server);
+	cxa_network_tcpServer_addListener(server, cb_onConnect, NULL);
+	cxa_runLoop_addEntry(THREAD_ID, NULL, cb_echo, NULL);
+
+	// let our state machines start up
+	cxa_test_iterateFor(THREAD_ID, 10);
+	cxa_assert(cxa_network_tcpServer_listen(server, PORT_NUM));
+	cxa_test_iterateFor(THREAD_ID, 10);
+
+	printf("%d connected clients, %d x %d-byte echoes per client\n",
+		   CXA_POSIX_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS, NUM_MESSAGES_PER_CLIENT, MESSAGE_SIZE_BYTES);
+	printf("%8s %12s %12s %10s %10s %12s %12s %14s\n",
+		   "clients", "msgs/s", "bytes/s", "rtt p50", "rtt p99", "accept p50", "accept max", "cpu/msg (ns)");
+
+	static const size_t numClients[] = {1, 4, 16, 32};
+	for( size_t i = 0; i < (sizeof(numClients) / sizeof(*numClients)); i++ ) runRound(numClients[i]);
+
+	cxa_network_tcpServer_stats_t* stats = cxa_network_tcpServer_getStats(server);
+	printf("accepted %u, accept pauses %u (longest %u ms)\n", stats->numAccepted, stats->numAcceptPauses, stats->maxAcceptPause_ms);
+
+	return cxa_test_finish("tcpServer_bench");
+}
+
+
+// ******** local function implementations ********
+static void runRound(size_t numClientsIn)
+{
+	numClientsDone = 0;
+
+	uint64_t startTime_ns = cxa_test_getTime_ns();
+	uint64_t startCpuTime_ns = cxa_test_getCpuTime_ns();
+	for( size_t i = 0; i < numClientsIn; i++ )
+	{
+		pthread_create(&clients[i].thread, NULL, clientThread_run, &clients[i]);
+	}
+
+	// the server is entirely driven from this thread
+	while( numClientsDone < numClientsIn ) cxa_runLoop_iterate(THREAD_ID);
+
+	uint64_t elapsed_ns = cxa_test_getTime_ns() - startTime_ns;
+	uint64_t cpuTime_ns = cxa_test_getCpuTime_ns() - startCpuTime_ns;
+
+	cxa_perfStats_t stats_rtt;
+	cxa_perfStats_init(&stats_rtt);
+	cxa_perfStats_t stats_accept;
+	cxa_perfStats_init(&stats_accept);
+	for( size_t i = 0; i < numClientsIn; i++ )
+	{
+		pthread_join(clients[i].thread, NULL);
+		cxa_test_check(clients[i].wasSuccessful);
+
+		cxa_perfStats_recordSample(&stats_accept, clients[i].acceptLatency_us, 1);
+		for( size_t j = 0; j < NUM_MESSAGES_PER_CLIENT; j++ )
+		{
+			cxa_perfStats_recordSample(&stats_rtt, clients[i].rtts_us[j], MESSAGE_SIZE_BYTES);
+		}
+	}
+
+	// the clients are in this process too, so cpu time includes both ends
+	uint64_t numMessages = (uint64_t)numClientsIn * NUM_MESSAGES_PER_CLIENT;
+	printf("%8zu %12.0f %12.0f %8u us %8u us %9u us %9u us %14.0f\n", numClientsIn,
+		   (double)numMessages * 1e9 / (double)elapsed_ns,
+		   (double)(numMessages * MESSAGE_SIZE_BYTES) * 1e9 / (double)elapsed_ns,
+		   cxa_perfStats_getPercentile_us(&stats_rtt, 50), cxa_perfStats_getPercentile_us(&stats_rtt, 99),
+		   cxa_perfStats_getPercentile_us(&stats_accept, 50), stats_accept.maxLatency_us,
+		   (double)cpuTime_ns / (double)numMessages);
+}
+
+
+static void* clientThread_run(void* userVarIn)
+{
+	benchClient_t* clientIn = (benchClient_t*)userVarIn;
+	clientIn->wasSuccessful = false;
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(PORT_NUM);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+	int noDelay = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+	// accept latency: until the server has accepted us _and_ serviced our first byte
+	uint64_t startTime_ns = cxa_test_getTime_ns();
+	uint8_t probe = 0x5A;
+	if( (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0) &&
+		sendAll(fd, &probe, sizeof(probe)) && recvAll(fd, &probe, sizeof(probe)) )
+	{
+		clientIn->acceptLatency_us = (uint32_t)((cxa_test_getTime_ns() - startTime_ns) / 1000);
+
+		uint8_t txMsg[MESSAGE_SIZE_BYTES];
+		uint8_t rxMsg[MESSAGE_SIZE_BYTES];
+		size_t i;
+		for( i = 0; i < NUM_MESSAGES_PER_CLIENT; i++ )
+		{
+			memset(txMsg, (int)i, sizeof(txMsg));
+
+			startTime_ns = cxa_test_getTime_ns();
+			if( !sendAll(fd, txMsg, sizeof(txMsg)) || !recvAll(fd, rxMsg, sizeof(rxMsg)) ) break;
+			clientIn->rtts_us[i] = (uint32_t)((cxa_test_getTime_ns() - startTime_ns) / 1000);
+
+			if( memcmp(txMsg, rxMsg, sizeof(txMsg)) != 0 ) break;
+		}
+		clientIn->wasSuccessful = (i == NUM_MESSAGES_PER_CLIENT);
+	}
+	close(fd);
+
+	pthread_mutex_lock(&mutex_numClientsDone);
+	numClientsDone++;
+	pthread_mutex_unlock(&mutex_numClientsDone);
+
+	return NULL;
+}
+
+
+static bool sendAll(int fdIn, const void *const dataIn, size_t numBytesIn)
+{
+	const uint8_t* currByte = (const uint8_t*)dataIn;
+	while( numBytesIn > 0 )
+	{
+		ssize_t numBytesSent = send(fdIn, currByte, numBytesIn, MSG_NOSIGNAL);
+		if( numBytesSent <= 0 ) return false;
+		currByte += numBytesSent;
+		numBytesIn -= (size_t)numBytesSent;
+	}
+	return true;
+}
+
+
+static bool recvAll(int fdIn, void *const dataOut, size_t numBytesIn)
+{
+	uint8_t* currByte = (uint8_t*)dataOut;
+	while( numBytesIn > 0 )
+	{
+		ssize_t numBytesRead = recv(fdIn, currByte, numBytesIn, 0);
+		if( numBytesRead <= 0 ) return false;
+		currByte += numBytesRead;
+		numBytesIn -= (size_t)numBytesRead;
+	}
+	return true;
+}
+
+
+static void cb_onConnect(cxa_network_tcpServer_t *const serverIn, cxa_network_tcpServer_connectedClient_t* clientIn, void* userVarIn)
+{
+	// connected clients are reused, so we only need to remember each one once
+	for( size_t i = 0; i < CXA_POSIX_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS; i++ )
+	{
+		if( connectedClients[i] == clientIn ) return;
+		if( connectedClients[i] == NULL )
+		{
+			connectedClients[i] = clientIn;
+			return;
+		}
+	}
+}
+
+
+static void cb_echo(void* userVarIn)
+{
+	for( size_t i = 0; i < CXA_POSIX_NETWORK_TCPSERVER_MAXCONNECTEDCLIENTS; i++ )
+	{
+		cxa_network_tcpServer_connectedClient_t* currClient = connectedClients[i];
+		if( (currClient == NULL) || !cxa_network_tcpServer_connectedClient_isBound(currClient) ) continue;
+
+		cxa_ioStream_t* ios = cxa_network_tcpServer_connectedClient_getIoStream(currClient);
+		uint8_t buffer[MESSAGE_SIZE_BYTES];
+		size_t numBytes = 0;
+		while( (numBytes < sizeof(buffer)) && (cxa_ioStream_readByte(ios, &buffer[numBytes]) == CXA_IOSTREAM_READSTAT_GOTDATA) ) numBytes++;
+		if( numBytes > 0 ) cxa_ioStream_writeBytes(ios, buffer, numBytes);
+	}
+}
@@ -0,0 +1,240 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * Compares the two ways a TLS tcpClient can serve cxa_ioStream_readByte:
+ * - perByte: one TLS library read per byte (the lwipMbedTls / wolfSslDialSocket
+ *   clients before their receive buffers were added)
+ * - buffered: refill a decrypted receive buffer with one read, then serve
+ *   bytes from it (what those clients do now, see
+ *   CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_RXBUFFERLEN_BYTES)
+ *
+ * Neither the lwIP nor the dial socket transport runs on a host, and mbedTLS /
+ * wolfSSL headers are not assumed, so OpenSSL stands in for the TLS library:
+ * a client and server are connected through an in-memory BIO pair using an
+ * ephemeral self-signed P-256 certificate. Only the client's reads are timed;
+ * the server's encryption is excluded. Each row reports throughput and process
+ * CPU time per KB delivered through the ioStream.
+ *
+ * Build (from the repository root, see test/README.md):
+ * @code
+ * gcc -std=gnu99 -O2 $CXA_TEST_INCLUDES -o tlsRead_bench test/bench/cxa_network_tlsRead_bench.c \
+ * 	test/support/cxa_test.c src/serial/cxa_ioStream.c src/misc/cxa_assert.c src/misc/cxa_stringUtils.c \
+ * 	src/misc/cxa_numberUtils.c src/misc/cxa_encodingUtils.c src/logger/cxa_logger.c src/runLoop/cxa_runLoop.c \
+ * 	src/collections/cxa_array.c src/collections/cxa_fixedByteBuffer.c src/timeUtils/cxa_timeDiff.c \
+ * 	src/arch-posix/cxa_posix_timeBase.c src/arch-posix/cxa_posix_criticalSection.c -lssl -lcrypto -lpthread
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <stdio.h>
+#include <string.h>
+
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include <cxa_ioStream.h>
+#include <cxa_test.h>
+
+
+// ******** local macro definitions ********
+#define RXBUFFERLEN_BYTES				512
+#define TOTAL_TRANSFER_BYTES			(16UL * 1024 * 1024)
+#define BIO_PAIR_BUFFERLEN_BYTES		(64 * 1024)
+
+
+// ******** local type definitions ********
+typedef struct
+{
+	SSL* ssl;
+
+	uint8_t buffer[RXBUFFERLEN_BYTES];
+	size_t readIndex;
+	size_t numBytes;
+}tlsClient_t;
+
+
+// ******** local function prototypes ********
+static bool setupTls(void);
+static void runRound(const char *const modeIn, cxa_ioStream_cb_readByte_t readCbIn, size_t recordSize_bytesIn);
+
+static cxa_ioStream_readStatus_t cb_readByte_perByte(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t cb_readByte_buffered(uint8_t *const byteOut, void *const userVarIn);
+static bool cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+
+
+// ********  local variable declarations *********
+static SSL* serverSsl;
+static tlsClient_t client;
+
+static uint8_t record[16 * 1024];
+static const size_t RECORD_SIZES[] = {256, 1024, 16 * 1024};
+
+
+// ******** global function implementations ********
+int main(void)
+{
+	cxa_test_init();
+
+	if( !cxa_test_check(setupTls()) ) return cxa_test_finish("network_tlsRead_bench");
+	for( size_t i = 0; i < sizeof(record); i++ ) record[i] = (uint8_t)i;
+
+	printf("%-9s %8s %10s %12s %10s\n", "mode", "record", "MB/s", "cpu ns/KB", "speedup");
+	for( size_t i = 0; i < sizeof(RECORD_SIZES)/sizeof(*RECORD_SIZES); i++ )
+	{
+		runRound("perByte", cb_readByte_perByte, RECORD_SIZES[i]);
+		runRound("buffered", cb_readByte_buffered, RECORD_SIZES[i]);
+	}
+
+	return cxa_test_finish("network_tlsRead_bench");
+}
+
+
+// ******** local function implementations ********
+static bool setupTls(void)
+{
+	// ephemeral self-signed certificate
+	EVP_PKEY* key = EVP_EC_gen("P-256");
+	X509* cert = X509_new();
+	if( (key == NULL) || (cert == NULL) ) return false;
+	ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+	X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+	X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+	X509_set_pubkey(cert, key);
+	X509_NAME_add_entry_by_txt(X509_get_subject_name(cert), "CN", MBSTRING_ASC, (const unsigned char*)"localhost", -1, -1, 0);
+	X509_set_issuer_name(cert, X509_get_subject_name(cert));
+	if( X509_sign(cert, key, EVP_sha256()) <= 0 ) return false;
+
+	SSL_CTX* serverCtx = SSL_CTX_new(TLS_server_method());
+	SSL_CTX* clientCtx = SSL_CTX_new(TLS_client_method());
+	if( (serverCtx == NULL) || (clientCtx == NULL) ) return false;
+	if( (SSL_CTX_use_certificate(serverCtx, cert) != 1) || (SSL_CTX_use_PrivateKey(serverCtx, key) != 1) ) return false;
+	SSL_CTX_set_verify(clientCtx, SSL_VERIFY_NONE, NULL);
+
+	// connect them back-to-back in memory
+	BIO* serverBio;
+	BIO* clientBio;
+	if( BIO_new_bio_pair(&serverBio, BIO_PAIR_BUFFERLEN_BYTES, &clientBio, BIO_PAIR_BUFFERLEN_BYTES) != 1 ) return false;
+
+	serverSsl = SSL_new(serverCtx);
+	client.ssl = SSL_new(clientCtx);
+	SSL_set_bio(serverSsl, serverBio, serverBio);
+	SSL_set_bio(client.ssl, clientBio, clientBio);
+	SSL_set_accept_state(serverSsl);
+	SSL_set_connect_state(client.ssl);
+
+	for( int i = 0; i < 100; i++ )
+	{
+		int clientRet = SSL_do_handshake(client.ssl);
+		int serverRet = SSL_do_handshake(serverSsl);
+		if( (clientRet == 1) && (serverRet == 1) ) return true;
+	}
+
+	ERR_print_errors_fp(stderr);
+	return false;
+}
+
+
+static void runRound(const char *const modeIn, cxa_ioStream_cb_readByte_t readCbIn, size_t recordSize_bytesIn)
+{
+	static double perByte_nsPerKb = 0.0;
+
+	cxa_ioStream_t ioStream;
+	cxa_ioStream_init(&ioStream);
+	cxa_ioStream_bind(&ioStream, readCbIn, cb_writeBytes, (void*)&client);
+	client.readIndex = 0;
+	client.numBytes = 0;
+
+	uint64_t clientTime_ns = 0;
+	uint64_t clientCpuTime_ns = 0;
+	size_t numBytesRead = 0;
+	uint32_t checksum = 0;
+	uint32_t expectedChecksum = 0;
+	for( size_t numBytesSent = 0; numBytesSent < TOTAL_TRANSFER_BYTES; numBytesSent += recordSize_bytesIn )
+	{
+		// untimed: the server encrypts one record
+		if( !cxa_test_check(SSL_write(serverSsl, record, (int)recordSize_bytesIn) == (int)recordSize_bytesIn) ) return;
+		for( size_t i = 0; i < recordSize_bytesIn; i++ ) expectedChecksum += record[i];
+
+		// timed: the client drains it through the ioStream
+		uint64_t start_ns = cxa_test_getTime_ns();
+		uint64_t startCpu_ns = cxa_test_getCpuTime_ns();
+		uint8_t rxByte;
+		while( cxa_ioStream_readByte(&ioStream, &rxByte) == CXA_IOSTREAM_READSTAT_GOTDATA )
+		{
+			checksum += rxByte;
+			numBytesRead++;
+		}
+		clientTime_ns += cxa_test_getTime_ns() - start_ns;
+		clientCpuTime_ns += cxa_test_getCpuTime_ns() - startCpu_ns;
+	}
+	cxa_test_check(numBytesRead == TOTAL_TRANSFER_BYTES);
+	cxa_test_check(checksum == expectedChecksum);
+
+	double numKb = (double)numBytesRead / 1024.0;
+	double nsPerKb = (double)clientCpuTime_ns / numKb;
+	double mbPerSec = ((double)numBytesRead * 1000.0) / (double)clientTime_ns;
+	if( readCbIn == cb_readByte_perByte )
+	{
+		perByte_nsPerKb = nsPerKb;
+		printf("%-9s %8zu %10.1f %12.0f %10s\n", modeIn, recordSize_bytesIn, mbPerSec, nsPerKb, "-");
+	}
+	else printf("%-9s %8zu %10.1f %12.0f %9.1fx\n", modeIn, recordSize_bytesIn, mbPerSec, nsPerKb, perByte_nsPerKb / nsPerKb);
+}
+
+
+static cxa_ioStream_readStatus_t cb_readByte_perByte(uint8_t *const byteOut, void *const userVarIn)
+{
+	tlsClient_t* clientIn = (tlsClient_t*)userVarIn;
+
+	uint8_t rxByte;
+	int tmpRet = SSL_read(clientIn->ssl, &rxByte, 1);
+	if( tmpRet <= 0 )
+	{
+		return (SSL_get_error(clientIn->ssl, tmpRet) == SSL_ERROR_WANT_READ) ? CXA_IOSTREAM_READSTAT_NODATA : CXA_IOSTREAM_READSTAT_ERROR;
+	}
+
+	if( byteOut != NULL ) *byteOut = rxByte;
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
+static cxa_ioStream_readStatus_t cb_readByte_buffered(uint8_t *const byteOut, void *const userVarIn)
+{
+	tlsClient_t* clientIn = (tlsClient_t*)userVarIn;
+
+	// same structure as cxa_lwipMbedTls_network_tcpClient's cb_ioStream_readByte
+	if( clientIn->readIndex >= clientIn->numBytes )
+	{
+		int tmpRet = SSL_read(clientIn->ssl, clientIn->buffer, sizeof(clientIn->buffer));
+		if( tmpRet <= 0 )
+		{
+			return (SSL_get_error(clientIn->ssl, tmpRet) == SSL_ERROR_WANT_READ) ? CXA_IOSTREAM_READSTAT_NODATA : CXA_IOSTREAM_READSTAT_ERROR;
+		}
+
+		clientIn->readIndex = 0;
+		clientIn->numBytes = (size_t)tmpRet;
+	}
+
+	uint8_t rxByte = clientIn->buffer[clientIn->readIndex++];
+	if( byteOut != NULL ) *byteOut = rxByte;
+
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
+static bool cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
+{
+	tlsClient_t* clientIn = (tlsClient_t*)userVarIn;
+
+	return (SSL_write(clientIn->ssl, buffIn, (int)bufferSize_bytesIn) == (int)bufferSize_bytesIn);
+}
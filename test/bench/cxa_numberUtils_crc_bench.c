@@ -0,0 +1,193 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * Measures the throughput (bytes per cycle and MB/s) of the CRC-16, CRC-32
+ * and CRC-32C implementations in cxa_numberUtils, after checking each against
+ * a bit-by-bit reference (including split updates).
+ *
+ * The implementation is chosen at compile time, so the program is built once
+ * per variant. The label passed as the first argument is printed with each row:
+ * - bitwise: CXA_NUMBERUTILS_CRC_TABLE_BITS=0
+ * - table4: 16-entry tables
+ * - table8: 256-entry tables (the embedded default)
+ * - slice8: slice-by-8 (the hosted default)
+ * - hw: slice-by-8 for CRC-16, SSE4.2 for CRC-32C (CRC-32 has no x86 instruction)
+ *
+ * Cycles come from ::cxa_test_getCycles (the TSC on x86-64, so they are
+ * nominal-rate cycles).
+ *
+ * Build and run (from the repository root, see test/README.md):
+ * @code
+ * for v in "bitwise:-DCXA_NUMBERUTILS_CRC_TABLE_BITS=0 -DCXA_NUMBERUTILS_CRC_SLICE_BY_8=0" \
+ * 		"table4:-DCXA_NUMBERUTILS_CRC_TABLE_BITS=4 -DCXA_NUMBERUTILS_CRC_SLICE_BY_8=0" \
+ * 		"table8:-DCXA_NUMBERUTILS_CRC_SLICE_BY_8=0" "slice8:-DCXA_NUMBERUTILS_CRC_SLICE_BY_8=1" \
+ * 		"hw:-DCXA_NUMBERUTILS_CRC_SLICE_BY_8=1 -msse4.2"; do
+ * 	gcc -std=gnu99 -O2 $CXA_TEST_INCLUDES ${v#*:} -o crc_bench test/bench/cxa_numberUtils_crc_bench.c \
+ * 		test/support/cxa_test.c src/misc/cxa_numberUtils.c src/misc/cxa_assert.c src/misc/cxa_stringUtils.c \
+ * 		src/misc/cxa_encodingUtils.c src/logger/cxa_logger.c src/runLoop/cxa_runLoop.c src/collections/cxa_array.c \
+ * 		src/collections/cxa_fixedByteBuffer.c src/serial/cxa_ioStream.c src/timeUtils/cxa_timeDiff.c \
+ * 		src/arch-posix/cxa_posix_timeBase.c src/arch-posix/cxa_posix_criticalSection.c -lpthread && ./crc_bench ${v%%:*}
+ * done
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cxa_numberUtils.h>
+#include <cxa_test.h>
+
+
+// ******** local macro definitions ********
+#define BUFFER_SIZE_BYTES				(64 * 1024)
+
+// the bitwise variant is ~50x slower...don't wait forever
+#if CXA_NUMBERUTILS_CRC_TABLE_BITS == 0
+	#define NUM_PASSES					64
+#else
+	#define NUM_PASSES					1024
+#endif
+
+#define CRC32_POLY_REFLECTED			0xEDB88320
+#define CRC32C_POLY_REFLECTED			0x82F63B78
+
+
+// ******** local type definitions ********
+typedef uint32_t (*crcFunc_t)(const uint8_t* dataIn, size_t dataLen_bytesIn);
+
+
+// ******** local function prototypes ********
+static void checkAgainstReference(void);
+static void benchCrc(const char *const variantIn, const char *const crcNameIn, crcFunc_t funcIn);
+
+static uint32_t crc16(const uint8_t* dataIn, size_t dataLen_bytesIn);
+static uint32_t crc32(const uint8_t* dataIn, size_t dataLen_bytesIn);
+static uint32_t crc32c(const uint8_t* dataIn, size_t dataLen_bytesIn);
+
+static uint16_t ref_crc16(const uint8_t* dataIn, size_t dataLen_bytesIn);
+static uint32_t ref_crc32(uint32_t polyIn, const uint8_t* dataIn, size_t dataLen_bytesIn);
+
+
+// ********  local variable declarations *********
+static uint8_t buffer[BUFFER_SIZE_BYTES + 8];
+static const size_t BLOCK_SIZES[] = {16, 64, 1024, BUFFER_SIZE_BYTES};
+
+
+// ******** global function implementations ********
+int main(int argc, char** argv)
+{
+	cxa_test_init();
+
+	const char* variant = (argc > 1) ? argv[1] : "default";
+	for( size_t i = 0; i < sizeof(buffer); i++ ) buffer[i] = (uint8_t)rand();
+
+	checkAgainstReference();
+
+	printf("%-8s %-7s %8s %12s %10s\n", "variant", "crc", "block", "bytes/cycle", "MB/s");
+	benchCrc(variant, "crc16", crc16);
+	benchCrc(variant, "crc32", crc32);
+	benchCrc(variant, "crc32c", crc32c);
+
+	return cxa_test_finish("numberUtils_crc_bench");
+}
+
+
+// ******** local function implementations ********
+static void checkAgainstReference(void)
+{
+	cxa_test_check(cxa_numberUtils_crc16_oneShot("123456789", 9) == 0xBB3D);
+	cxa_test_check(cxa_numberUtils_crc32_oneShot("123456789", 9) == 0xCBF43926);
+	cxa_test_check(cxa_numberUtils_crc32c_oneShot("123456789", 9) == 0xE3069283);
+
+	// random lengths, (mis)alignments and split points
+	for( int i = 0; i < 1000; i++ )
+	{
+		size_t offset = (size_t)rand() % 8;
+		size_t len = (size_t)rand() % 3000;
+		size_t split = (len > 0) ? ((size_t)rand() % len) : 0;
+		const uint8_t* data = &buffer[offset];
+
+		uint16_t c16 = cxa_numberUtils_crc16_update(cxa_numberUtils_crc16_update(0, data, split), &data[split], len - split);
+		uint32_t c32 = cxa_numberUtils_crc32_update(cxa_numberUtils_crc32_update(0, data, split), &data[split], len - split);
+		uint32_t c32c = cxa_numberUtils_crc32c_update(cxa_numberUtils_crc32c_update(0, data, split), &data[split], len - split);
+
+		if( !cxa_test_check(c16 == ref_crc16(data, len)) ) break;
+		if( !cxa_test_check(c32 == ref_crc32(CRC32_POLY_REFLECTED, data, len)) ) break;
+		if( !cxa_test_check(c32c == ref_crc32(CRC32C_POLY_REFLECTED, data, len)) ) break;
+	}
+}
+
+
+static void benchCrc(const char *const variantIn, const char *const crcNameIn, crcFunc_t funcIn)
+{
+	for( size_t i = 0; i < sizeof(BLOCK_SIZES)/sizeof(*BLOCK_SIZES); i++ )
+	{
+		size_t blockSize_bytes = BLOCK_SIZES[i];
+		size_t numBlocks = BUFFER_SIZE_BYTES / blockSize_bytes;
+
+		volatile uint32_t sink = 0;
+		uint64_t start_cycles = cxa_test_getCycles();
+		uint64_t start_ns = cxa_test_getTime_ns();
+		for( size_t pass = 0; pass < NUM_PASSES; pass++ )
+		{
+			for( size_t block = 0; block < numBlocks; block++ ) sink += funcIn(&buffer[block * blockSize_bytes], blockSize_bytes);
+		}
+		uint64_t elapsed_cycles = cxa_test_getCycles() - start_cycles;
+		uint64_t elapsed_ns = cxa_test_getTime_ns() - start_ns;
+		(void)sink;
+
+		double totalBytes = (double)NUM_PASSES * (double)numBlocks * (double)blockSize_bytes;
+		if( elapsed_cycles > 0 ) printf("%-8s %-7s %8zu %12.3f %10.0f\n", variantIn, crcNameIn, blockSize_bytes, totalBytes / (double)elapsed_cycles, (totalBytes * 1000.0) / (double)elapsed_ns);
+		else printf("%-8s %-7s %8zu %12s %10.0f\n", variantIn, crcNameIn, blockSize_bytes, "n/a", (totalBytes * 1000.0) / (double)elapsed_ns);
+	}
+}
+
+
+static uint32_t crc16(const uint8_t* dataIn, size_t dataLen_bytesIn)
+{
+	return cxa_numberUtils_crc16_oneShot(dataIn, dataLen_bytesIn);
+}
+
+
+static uint32_t crc32(const uint8_t* dataIn, size_t dataLen_bytesIn)
+{
+	return cxa_numberUtils_crc32_oneShot(dataIn, dataLen_bytesIn);
+}
+
+
+static uint32_t crc32c(const uint8_t* dataIn, size_t dataLen_bytesIn)
+{
+	return cxa_numberUtils_crc32c_oneShot(dataIn, dataLen_bytesIn);
+}
+
+
+static uint16_t ref_crc16(const uint8_t* dataIn, size_t dataLen_bytesIn)
+{
+	uint16_t crc = 0;
+	for( size_t i = 0; i < dataLen_bytesIn; i++ )
+	{
+		crc ^= dataIn[i];
+		for( int j = 0; j < 8; j++ ) crc = (crc & 0x01) ? ((crc >> 1) ^ 0xA001) : (crc >> 1);
+	}
+	return crc;
+}
+
+
+static uint32_t ref_crc32(uint32_t polyIn, const uint8_t* dataIn, size_t dataLen_bytesIn)
+{
+	uint32_t crc = 0xFFFFFFFF;
+	for( size_t i = 0; i < dataLen_bytesIn; i++ )
+	{
+		crc ^= dataIn[i];
+		for( int j = 0; j < 8; j++ ) crc = (crc & 0x01) ? ((crc >> 1) ^ polyIn) : (crc >> 1);
+	}
+	return ~crc;
+}
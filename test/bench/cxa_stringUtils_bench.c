@@ -0,0 +1,185 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * Measures the cxa_stringUtils search functions on realistic MQTT / RPC
+ * topic strings (10 to 90 bytes, 2 to 8 levels), the way the mqtt client and
+ * rpc nodes use them when routing a received publish:
+ * - startsWith: the rpc version/direction prefix
+ * - endsWith: a trailing request id
+ * - indexOf: the first '/' (is there another topic level?)
+ * - contains: a multi-character element that is usually absent
+ * - count: every '/' in the topic
+ * - split: break the topic into its levels
+ * - dispatch: count '/' + contains "/_req/" + startsWith, per topic
+ *
+ * Each row reports ns and cycles (see ::cxa_test_getCycles) per topic,
+ * averaged over the whole set.
+ *
+ * Build (from the repository root, see test/README.md):
+ * @code
+ * gcc -std=gnu99 -O2 $CXA_TEST_INCLUDES -o stringUtils_bench test/bench/cxa_stringUtils_bench.c test/support/cxa_test.c \
+ * 	src/misc/cxa_stringUtils.c src/misc/cxa_assert.c src/misc/cxa_numberUtils.c src/misc/cxa_encodingUtils.c \
+ * 	src/logger/cxa_logger.c src/runLoop/cxa_runLoop.c src/collections/cxa_array.c src/collections/cxa_fixedByteBuffer.c \
+ * 	src/serial/cxa_ioStream.c src/timeUtils/cxa_timeDiff.c src/arch-posix/cxa_posix_timeBase.c \
+ * 	src/arch-posix/cxa_posix_criticalSection.c -lpthread
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <stdio.h>
+#include <string.h>
+
+#include <cxa_stringUtils.h>
+#include <cxa_test.h>
+
+
+// ******** local macro definitions ********
+#define NUM_PASSES						200000
+#define MAX_NUM_TOKENS					16
+
+
+// ******** local type definitions ********
+typedef size_t (*topicFunc_t)(const char *const topicIn, size_t topicLen_bytesIn);
+
+
+// ******** local function prototypes ********
+static void checkResults(void);
+static void runRound(const char *const nameIn, topicFunc_t funcIn);
+
+static size_t op_startsWith(const char *const topicIn, size_t topicLen_bytesIn);
+static size_t op_endsWith(const char *const topicIn, size_t topicLen_bytesIn);
+static size_t op_indexOf(const char *const topicIn, size_t topicLen_bytesIn);
+static size_t op_contains(const char *const topicIn, size_t topicLen_bytesIn);
+static size_t op_count(const char *const topicIn, size_t topicLen_bytesIn);
+static size_t op_split(const char *const topicIn, size_t topicLen_bytesIn);
+static size_t op_dispatch(const char *const topicIn, size_t topicLen_bytesIn);
+
+
+// ********  local variable declarations *********
+static const char *const TOPICS[] =
+{
+	"v1/->/gw01",
+	"v1/->/gw01/getVersion",
+	"v1/<-/gw01/sensors/temp0/getReading/0042",
+	"v1/->/~/bridge/ble/F4:12:FA:33:0B:9C/setConnectionParams/_req/8f1c",
+	"devices/3f2a9c4e-71b0-4d55-a1e7-0c6b2f9d8e13/telemetry/battery/voltage/mv/raw/1024",
+	"home/livingroom/light/state",
+	"v1/<-/gw01/bridge/uart/_req/1f",
+	"$SYS/broker/clients/connected",
+};
+#define NUM_TOPICS						(sizeof(TOPICS)/sizeof(*TOPICS))
+
+static size_t topicLens_bytes[NUM_TOPICS];
+
+
+// ******** global function implementations ********
+int main(void)
+{
+	cxa_test_init();
+
+	size_t totalLen_bytes = 0;
+	for( size_t i = 0; i < NUM_TOPICS; i++ )
+	{
+		topicLens_bytes[i] = strlen(TOPICS[i]);
+		totalLen_bytes += topicLens_bytes[i];
+	}
+	checkResults();
+
+	printf("%zu topics, %.1f bytes average\n", NUM_TOPICS, (double)totalLen_bytes / (double)NUM_TOPICS);
+	printf("%-11s %10s %14s\n", "op", "ns/topic", "cycles/topic");
+	runRound("startsWith", op_startsWith);
+	runRound("endsWith", op_endsWith);
+	runRound("indexOf", op_indexOf);
+	runRound("contains", op_contains);
+	runRound("count", op_count);
+	runRound("split", op_split);
+	runRound("dispatch", op_dispatch);
+
+	return cxa_test_finish("stringUtils_bench");
+}
+
+
+// ******** local function implementations ********
+static void checkResults(void)
+{
+	static const size_t EXPECTED_NUM_SEPARATORS[NUM_TOPICS] = {2, 3, 6, 8, 7, 3, 6, 3};
+	static const bool EXPECTED_HAS_REQ[NUM_TOPICS] = {false, false, false, true, false, false, true, false};
+
+	for( size_t i = 0; i < NUM_TOPICS; i++ )
+	{
+		cxa_test_check(op_count(TOPICS[i], topicLens_bytes[i]) == EXPECTED_NUM_SEPARATORS[i]);
+		cxa_test_check(op_split(TOPICS[i], topicLens_bytes[i]) == (EXPECTED_NUM_SEPARATORS[i] + 1));
+		cxa_test_check(cxa_stringUtils_contains_withLengths(TOPICS[i], topicLens_bytes[i], "/_req/", 6) == EXPECTED_HAS_REQ[i]);
+		cxa_test_check((size_t)cxa_stringUtils_indexOfFirstOccurence_withLengths(TOPICS[i], topicLens_bytes[i], "/", 1) == (size_t)(strchr(TOPICS[i], '/') - TOPICS[i]));
+	}
+}
+
+
+static void runRound(const char *const nameIn, topicFunc_t funcIn)
+{
+	volatile size_t sink = 0;
+	uint64_t start_cycles = cxa_test_getCycles();
+	uint64_t start_ns = cxa_test_getTime_ns();
+	for( size_t pass = 0; pass < NUM_PASSES; pass++ )
+	{
+		for( size_t i = 0; i < NUM_TOPICS; i++ ) sink += funcIn(TOPICS[i], topicLens_bytes[i]);
+	}
+	uint64_t elapsed_cycles = cxa_test_getCycles() - start_cycles;
+	uint64_t elapsed_ns = cxa_test_getTime_ns() - start_ns;
+	(void)sink;
+
+	double numTopics = (double)NUM_PASSES * (double)NUM_TOPICS;
+	printf("%-11s %10.1f %14.1f\n", nameIn, (double)elapsed_ns / numTopics, (double)elapsed_cycles / numTopics);
+}
+
+
+static size_t op_startsWith(const char *const topicIn, size_t topicLen_bytesIn)
+{
+	return cxa_stringUtils_startsWith_withLengths(topicIn, topicLen_bytesIn, "v1/->/", 6);
+}
+
+
+static size_t op_endsWith(const char *const topicIn, size_t topicLen_bytesIn)
+{
+	return cxa_stringUtils_endsWith_withLengths(topicIn, topicLen_bytesIn, "/0042");
+}
+
+
+static size_t op_indexOf(const char *const topicIn, size_t topicLen_bytesIn)
+{
+	return (size_t)cxa_stringUtils_indexOfFirstOccurence_withLengths(topicIn, topicLen_bytesIn, "/", 1);
+}
+
+
+static size_t op_contains(const char *const topicIn, size_t topicLen_bytesIn)
+{
+	return cxa_stringUtils_contains_withLengths(topicIn, topicLen_bytesIn, "setConnectionParams", 19);
+}
+
+
+static size_t op_count(const char *const topicIn, size_t topicLen_bytesIn)
+{
+	return cxa_stringUtils_countOccurences_withLengths(topicIn, topicLen_bytesIn, "/", 1);
+}
+
+
+static size_t op_split(const char *const topicIn, size_t topicLen_bytesIn)
+{
+	cxa_stringUtils_token_t tokens[MAX_NUM_TOKENS];
+	return cxa_stringUtils_split_withLengths(topicIn, topicLen_bytesIn, '/', tokens, MAX_NUM_TOKENS);
+}
+
+
+static size_t op_dispatch(const char *const topicIn, size_t topicLen_bytesIn)
+{
+	return cxa_stringUtils_countOccurences_withLengths(topicIn, topicLen_bytesIn, "/", 1) +
+		   cxa_stringUtils_contains_withLengths(topicIn, topicLen_bytesIn, "/_req/", 6) +
+		   cxa_stringUtils_startsWith_withLengths(topicIn, topicLen_bytesIn, "v1/->/", 6);
+}
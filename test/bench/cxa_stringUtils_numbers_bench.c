@@ -0,0 +1,337 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * Compares the printf-free number writers / parsers against the libc calls
+ * they replace, in cycles (see ::cxa_test_getCycles) and ns per call:
+ * - cxa_stringUtils_format* vs snprintf
+ * - cxa_stringUtils_parse* vs strtoul / strtol
+ * - cxa_ioStream_write{Uint32,Hex,Fixed} vs cxa_ioStream_writeFormattedString
+ *   (which goes through vsnprintf) into a discarding ioStream
+ *
+ * Every result is checked against the libc one before timing. Values are a
+ * mix of small and full-range numbers.
+ *
+ * Code size is not measured by this program. To compare it, build the
+ * stringUtils object at -Os and list the formatter / parser sizes next to
+ * vsnprintf's, eg.
+ * `nm -S --size-sort cxa_stringUtils.o | grep -i 'format\|parse'`
+ *
+ * Build (from the repository root, see test/README.md):
+ * @code
+ * gcc -std=gnu99 -O2 $CXA_TEST_INCLUDES -o numbers_bench test/bench/cxa_stringUtils_numbers_bench.c test/support/cxa_test.c \
+ * 	src/misc/cxa_stringUtils.c src/misc/cxa_assert.c src/misc/cxa_numberUtils.c src/misc/cxa_encodingUtils.c \
+ * 	src/logger/cxa_logger.c src/runLoop/cxa_runLoop.c src/collections/cxa_array.c src/collections/cxa_fixedByteBuffer.c \
+ * 	src/serial/cxa_ioStream.c src/timeUtils/cxa_timeDiff.c src/arch-posix/cxa_posix_timeBase.c \
+ * 	src/arch-posix/cxa_posix_criticalSection.c -lpthread
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cxa_ioStream.h>
+#include <cxa_stringUtils.h>
+#include <cxa_test.h>
+
+
+// ******** local macro definitions ********
+#define NUM_VALUES						1024
+#define NUM_PASSES						1000
+#define STRING_MAXLEN_BYTES				CXA_STRINGUTILS_NUMBERSTRING_MAXLEN_BYTES
+
+
+// ******** local type definitions ********
+typedef size_t (*benchFunc_t)(size_t indexIn);
+
+
+// ******** local function prototypes ********
+static void checkResults(void);
+static double timeFunc(benchFunc_t funcIn, double *const nsPerCallOut);
+static void runRound(const char *const nameIn, benchFunc_t cxaFuncIn, const char *const libcNameIn, benchFunc_t libcFuncIn);
+
+static size_t cxa_formatUint32(size_t indexIn);
+static size_t libc_formatUint32(size_t indexIn);
+static size_t cxa_formatInt32(size_t indexIn);
+static size_t libc_formatInt32(size_t indexIn);
+static size_t cxa_formatHex(size_t indexIn);
+static size_t libc_formatHex(size_t indexIn);
+static size_t cxa_formatFixed(size_t indexIn);
+static size_t libc_formatFixed(size_t indexIn);
+static size_t cxa_parseUint32(size_t indexIn);
+static size_t libc_parseUint32(size_t indexIn);
+static size_t cxa_parseInt32(size_t indexIn);
+static size_t libc_parseInt32(size_t indexIn);
+static size_t cxa_parseHex(size_t indexIn);
+static size_t libc_parseHex(size_t indexIn);
+static size_t cxa_writeUint32(size_t indexIn);
+static size_t libc_writeUint32(size_t indexIn);
+static size_t cxa_writeHex(size_t indexIn);
+static size_t libc_writeHex(size_t indexIn);
+static size_t cxa_writeFixed(size_t indexIn);
+static size_t libc_writeFixed(size_t indexIn);
+
+static cxa_ioStream_readStatus_t cb_readByte(uint8_t *const byteOut, void *const userVarIn);
+static bool cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+
+
+// ********  local variable declarations *********
+static uint32_t values[NUM_VALUES];
+static char decStrings[NUM_VALUES][STRING_MAXLEN_BYTES];
+static char signedStrings[NUM_VALUES][STRING_MAXLEN_BYTES];
+static char hexStrings[NUM_VALUES][STRING_MAXLEN_BYTES];
+
+static char strOut[STRING_MAXLEN_BYTES];
+
+static cxa_ioStream_t ios;
+static size_t numBytesWritten;
+
+
+// ******** global function implementations ********
+int main(void)
+{
+	cxa_test_init();
+
+	srand(1);
+	for( size_t i = 0; i < NUM_VALUES; i++ )
+	{
+		uint32_t val = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+		switch( i % 4 )
+		{
+			case 0: val %= 1000; break;
+			case 1: val >>= (i % 32); break;
+			default: break;
+		}
+		values[i] = val;
+		snprintf(decStrings[i], sizeof(decStrings[i]), "%" PRIu32, val);
+		snprintf(signedStrings[i], sizeof(signedStrings[i]), "%" PRId32, (int32_t)val);
+		snprintf(hexStrings[i], sizeof(hexStrings[i]), "%08" PRIX32, val);
+	}
+
+	cxa_ioStream_init(&ios);
+	cxa_ioStream_bind(&ios, cb_readByte, cb_writeBytes, NULL);
+
+	checkResults();
+
+	printf("%-14s %10s %8s   %-20s %10s %8s %9s\n", "cxa", "cycles", "ns", "libc", "cycles", "ns", "speedup");
+	runRound("formatUint32", cxa_formatUint32, "snprintf %lu", libc_formatUint32);
+	runRound("formatInt32", cxa_formatInt32, "snprintf %ld", libc_formatInt32);
+	runRound("formatHex", cxa_formatHex, "snprintf %08lX", libc_formatHex);
+	runRound("formatFixed", cxa_formatFixed, "snprintf %.2f", libc_formatFixed);
+	runRound("parseUint32", cxa_parseUint32, "strtoul", libc_parseUint32);
+	runRound("parseInt32", cxa_parseInt32, "strtol", libc_parseInt32);
+	runRound("parseHex", cxa_parseHex, "strtoul base 16", libc_parseHex);
+	runRound("writeUint32", cxa_writeUint32, "writeFormatted %lu", libc_writeUint32);
+	runRound("writeHex", cxa_writeHex, "writeFormatted %08lX", libc_writeHex);
+	runRound("writeFixed", cxa_writeFixed, "writeFormatted %.2f", libc_writeFixed);
+
+	return cxa_test_finish("stringUtils_numbers_bench");
+}
+
+
+// ******** local function implementations ********
+static void checkResults(void)
+{
+	char libcStr[STRING_MAXLEN_BYTES];
+	for( size_t i = 0; i < NUM_VALUES; i++ )
+	{
+		cxa_formatUint32(i);
+		if( !cxa_test_check(strcmp(strOut, decStrings[i]) == 0) ) break;
+		cxa_formatInt32(i);
+		if( !cxa_test_check(strcmp(strOut, signedStrings[i]) == 0) ) break;
+		cxa_formatHex(i);
+		if( !cxa_test_check(strcmp(strOut, hexStrings[i]) == 0) ) break;
+
+		// an int32 / 100 is exact enough in a double for %.2f to agree
+		cxa_formatFixed(i);
+		snprintf(libcStr, sizeof(libcStr), "%.2f", (double)(int32_t)values[i] / 100.0);
+		if( !cxa_test_check(strcmp(strOut, libcStr) == 0) ) break;
+
+		if( !cxa_test_check(cxa_parseUint32(i) == libc_parseUint32(i)) ) break;
+		if( !cxa_test_check(cxa_parseInt32(i) == libc_parseInt32(i)) ) break;
+		if( !cxa_test_check(cxa_parseHex(i) == libc_parseHex(i)) ) break;
+	}
+}
+
+
+static double timeFunc(benchFunc_t funcIn, double *const nsPerCallOut)
+{
+	volatile size_t sink = 0;
+	uint64_t start_cycles = cxa_test_getCycles();
+	uint64_t start_ns = cxa_test_getTime_ns();
+	for( size_t pass = 0; pass < NUM_PASSES; pass++ )
+	{
+		for( size_t i = 0; i < NUM_VALUES; i++ ) sink += funcIn(i);
+	}
+	uint64_t elapsed_cycles = cxa_test_getCycles() - start_cycles;
+	uint64_t elapsed_ns = cxa_test_getTime_ns() - start_ns;
+	(void)sink;
+
+	double numCalls = (double)NUM_PASSES * (double)NUM_VALUES;
+	*nsPerCallOut = (double)elapsed_ns / numCalls;
+	return (double)elapsed_cycles / numCalls;
+}
+
+
+static void runRound(const char *const nameIn, benchFunc_t cxaFuncIn, const char *const libcNameIn, benchFunc_t libcFuncIn)
+{
+	double cxa_ns, libc_ns;
+	double cxa_cycles = timeFunc(cxaFuncIn, &cxa_ns);
+	double libc_cycles = timeFunc(libcFuncIn, &libc_ns);
+
+	printf("%-14s %10.1f %8.1f   %-20s %10.1f %8.1f %8.1fx\n", nameIn, cxa_cycles, cxa_ns, libcNameIn, libc_cycles, libc_ns, libc_ns / cxa_ns);
+}
+
+
+static size_t cxa_formatUint32(size_t indexIn)
+{
+	return cxa_stringUtils_formatUint32(values[indexIn], strOut, sizeof(strOut));
+}
+
+
+static size_t libc_formatUint32(size_t indexIn)
+{
+	return (size_t)snprintf(strOut, sizeof(strOut), "%" PRIu32, values[indexIn]);
+}
+
+
+static size_t cxa_formatInt32(size_t indexIn)
+{
+	return cxa_stringUtils_formatInt32((int32_t)values[indexIn], strOut, sizeof(strOut));
+}
+
+
+static size_t libc_formatInt32(size_t indexIn)
+{
+	return (size_t)snprintf(strOut, sizeof(strOut), "%" PRId32, (int32_t)values[indexIn]);
+}
+
+
+static size_t cxa_formatHex(size_t indexIn)
+{
+	return cxa_stringUtils_formatHex(values[indexIn], 8, strOut, sizeof(strOut));
+}
+
+
+static size_t libc_formatHex(size_t indexIn)
+{
+	return (size_t)snprintf(strOut, sizeof(strOut), "%08" PRIX32, values[indexIn]);
+}
+
+
+static size_t cxa_formatFixed(size_t indexIn)
+{
+	return cxa_stringUtils_formatFixed((int32_t)values[indexIn], 2, strOut, sizeof(strOut));
+}
+
+
+static size_t libc_formatFixed(size_t indexIn)
+{
+	return (size_t)snprintf(strOut, sizeof(strOut), "%.2f", (double)(int32_t)values[indexIn] / 100.0);
+}
+
+
+static size_t cxa_parseUint32(size_t indexIn)
+{
+	uint32_t val = 0;
+	cxa_stringUtils_parseUint32(decStrings[indexIn], &val);
+	return val;
+}
+
+
+static size_t libc_parseUint32(size_t indexIn)
+{
+	return (uint32_t)strtoul(decStrings[indexIn], NULL, 10);
+}
+
+
+static size_t cxa_parseInt32(size_t indexIn)
+{
+	int32_t val = 0;
+	cxa_stringUtils_parseInt32(signedStrings[indexIn], &val);
+	return (size_t)val;
+}
+
+
+static size_t libc_parseInt32(size_t indexIn)
+{
+	return (size_t)(int32_t)strtol(signedStrings[indexIn], NULL, 10);
+}
+
+
+static size_t cxa_parseHex(size_t indexIn)
+{
+	uint32_t val = 0;
+	cxa_stringUtils_parseHex(hexStrings[indexIn], &val);
+	return val;
+}
+
+
+static size_t libc_parseHex(size_t indexIn)
+{
+	return (uint32_t)strtoul(hexStrings[indexIn], NULL, 16);
+}
+
+
+static size_t cxa_writeUint32(size_t indexIn)
+{
+	cxa_ioStream_writeUint32(&ios, values[indexIn]);
+	return numBytesWritten;
+}
+
+
+static size_t libc_writeUint32(size_t indexIn)
+{
+	cxa_ioStream_writeFormattedString(&ios, "%" PRIu32, values[indexIn]);
+	return numBytesWritten;
+}
+
+
+static size_t cxa_writeHex(size_t indexIn)
+{
+	cxa_ioStream_writeHex(&ios, values[indexIn], 8);
+	return numBytesWritten;
+}
+
+
+static size_t libc_writeHex(size_t indexIn)
+{
+	cxa_ioStream_writeFormattedString(&ios, "%08" PRIX32, values[indexIn]);
+	return numBytesWritten;
+}
+
+
+static size_t cxa_writeFixed(size_t indexIn)
+{
+	cxa_ioStream_writeFixed(&ios, (int32_t)values[indexIn], 2);
+	return numBytesWritten;
+}
+
+
+static size_t libc_writeFixed(size_t indexIn)
+{
+	cxa_ioStream_writeFormattedString(&ios, "%.2f", (double)(int32_t)values[indexIn] / 100.0);
+	return numBytesWritten;
+}
+
+
+static cxa_ioStream_readStatus_t cb_readByte(uint8_t *const byteOut, void *const userVarIn)
+{
+	return CXA_IOSTREAM_READSTAT_NODATA;
+}
+
+
+static bool cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
+{
+	numBytesWritten += bufferSize_bytesIn;
+	return true;
+}
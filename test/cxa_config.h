@@ -0,0 +1,23 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_CONFIG_H_
+#define CXA_CONFIG_H_
+
+
+/**
+ * @file
+ * Configuration used when building the host (posix) tests and benchmarks.
+ * Everything is left at its default unless a test needs otherwise.
+ */
+
+
+// report where an assert fired
+#define CXA_ASSERT_LINE_NUM_ENABLE
+#define CXA_ASSERT_MSG_ENABLE
+
+
+#endif
@@ -0,0 +1,359 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * Exercises cxa_network_dnsCache against a stub resolver (the backend's
+ * startResolve, answered explicitly by each test) and a timeBase the test
+ * advances by hand (implemented here, in place of the posix one), covering:
+ * - TTL expiry (and the CXA_NETWORK_DNSCACHE_MAX_TTL_S cap)
+ * - negative caching of failed resolutions
+ * - LRU eviction of unpinned entries (pinned and resolving entries stay)
+ * - resolve timeouts, and late results being discarded
+ * - a result staged while the cache's runLoop entry is suspending (the
+ *   lost-wakeup recheck)
+ *
+ * Build (from the repository root, see test/README.md):
+ * @code
+ * gcc -std=gnu99 -DCXA_NETWORK_DNSCACHE_MAXNUM_ENTRIES=4 $CXA_TEST_INCLUDES -o dnsCache_test test/net/cxa_network_dnsCache_test.c \
+ * 	test/support/cxa_test.c src/net/cxa_network_dnsCache.c src/runLoop/cxa_runLoop.c src/logger/cxa_logger.c \
+ * 	src/misc/cxa_assert.c src/misc/cxa_stringUtils.c src/misc/cxa_numberUtils.c src/misc/cxa_encodingUtils.c \
+ * 	src/collections/cxa_array.c src/collections/cxa_fixedByteBuffer.c src/serial/cxa_ioStream.c \
+ * 	src/timeUtils/cxa_timeDiff.c src/arch-posix/cxa_posix_criticalSection.c -lpthread
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <stdio.h>
+#include <string.h>
+
+#include <cxa_network_dnsCache.h>
+#include <cxa_runLoop.h>
+#include <cxa_test.h>
+#include <cxa_timeBase.h>
+
+
+// ******** local macro definitions ********
+#define THREAD_ID						CXA_RUNLOOP_THREADID_DEFAULT
+#define MAX_NUM_SETTLE_ITERATIONS		10
+#define MAX_NUM_REQUESTS				CXA_NETWORK_DNSCACHE_MAXNUM_ENTRIES
+
+
+// ******** local type definitions ********
+typedef struct
+{
+	cxa_network_dnsCache_entry_t* entry;
+	char hostName[CXA_NETWORK_DNSCACHE_MAXHOSTNAMELEN_BYTES+1];
+}request_t;
+
+
+// ******** local function prototypes ********
+static void test_ttlExpiry(void);
+static void test_negativeCaching(void);
+static void test_resolveTimeout(void);
+static void test_lostWakeup(void);
+static void test_lruEviction(void);
+
+static void advance_ms(uint32_t msIn);
+static void settle(void);
+static cxa_network_dnsCache_lookupResult_t lookup(const char *const hostNameIn);
+static bool answer(const char *const hostNameIn, const char *const addressIn, uint32_t ttl_sIn);
+static bool resolve(const char *const hostNameIn, const char *const addressIn, uint32_t ttl_sIn);
+
+static bool scm_startResolve(cxa_network_dnsCache_entry_t *const entryIn, const char *const hostNameIn);
+
+
+// ********  local variable declarations *********
+static uint64_t now_us = 1000000;
+
+// stub resolver
+static unsigned int numResolves = 0;
+static request_t requests[MAX_NUM_REQUESTS];		// most recent first
+static const char* lastHostName = requests[0].hostName;
+static const char* syncAddress = NULL;
+
+static char address[CXA_NETWORK_DNSCACHE_MAXADDRESSLEN_BYTES+1];
+
+
+// ******** global function implementations ********
+int main(void)
+{
+	cxa_test_init();
+
+	cxa_network_dnsCache_init(THREAD_ID, scm_startResolve);
+	cxa_test_check(cxa_network_dnsCache_isInit());
+	settle();
+
+	// numeric addresses never touch the cache
+	cxa_test_check((lookup("192.168.1.20") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, "192.168.1.20") == 0));
+	cxa_test_check((lookup("fe80::1") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, "fe80::1") == 0));
+	settle();
+	cxa_test_check(numResolves == 0);
+
+	test_ttlExpiry();
+	test_negativeCaching();
+	test_resolveTimeout();
+	test_lostWakeup();
+	test_lruEviction();
+
+	return cxa_test_finish("dnsCache");
+}
+
+
+uint32_t cxa_timeBase_getCount_us(void)
+{
+	return (uint32_t)now_us;
+}
+
+
+uint32_t cxa_timeBase_getMaxCount_us(void)
+{
+	return UINT32_MAX;
+}
+
+
+uint64_t cxa_timeBase_getCount64_us(void)
+{
+	return now_us;
+}
+
+
+// ******** local function implementations ********
+static void test_ttlExpiry(void)
+{
+	cxa_test_check(resolve("ttl.example", "10.0.0.1", 60));
+	unsigned int numResolvesBefore = numResolves;
+
+	// served from the cache (case-insensitively) until the TTL runs out
+	advance_ms(59000);
+	cxa_test_check((lookup("TTL.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, "10.0.0.1") == 0));
+	settle();
+	cxa_test_check(numResolves == numResolvesBefore);
+
+	advance_ms(2000);
+	cxa_test_check(lookup("ttl.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+	cxa_test_check(numResolves == (numResolvesBefore + 1));
+	cxa_test_check(answer("ttl.example", "10.0.0.2", 0));
+	cxa_test_check((lookup("ttl.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, "10.0.0.2") == 0));
+
+	// no TTL means the default
+	advance_ms((CXA_NETWORK_DNSCACHE_DEFAULT_TTL_S * 1000) - 1000);
+	cxa_test_check(lookup("ttl.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED);
+	advance_ms(2000);
+	cxa_test_check(lookup("ttl.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+
+	// long TTLs are capped
+	cxa_test_check(answer("ttl.example", "10.0.0.3", 10 * CXA_NETWORK_DNSCACHE_MAX_TTL_S));
+	advance_ms((CXA_NETWORK_DNSCACHE_MAX_TTL_S * 1000) - 1000);
+	cxa_test_check(lookup("ttl.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED);
+	advance_ms(2000);
+	cxa_test_check(lookup("ttl.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+	cxa_test_check(answer("ttl.example", "10.0.0.4", 60));
+}
+
+
+static void test_negativeCaching(void)
+{
+	cxa_test_check(lookup("bad.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+	cxa_test_check(answer("bad.example", NULL, 0));
+	cxa_test_check(lookup("bad.example") == CXA_NETWORK_DNSCACHE_LOOKUP_FAILED);
+	unsigned int numResolvesBefore = numResolves;
+
+	// the failure is remembered (no new resolution) for the negative TTL
+	advance_ms((CXA_NETWORK_DNSCACHE_NEGATIVE_TTL_S * 1000) - 1000);
+	cxa_test_check(lookup("bad.example") == CXA_NETWORK_DNSCACHE_LOOKUP_FAILED);
+	settle();
+	cxa_test_check(numResolves == numResolvesBefore);
+
+	advance_ms(2000);
+	cxa_test_check(lookup("bad.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+	cxa_test_check(numResolves == (numResolvesBefore + 1));
+	cxa_test_check(answer("bad.example", "10.0.1.1", 60));
+	cxa_test_check(lookup("bad.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED);
+
+	// invalidating a good result forces a new resolution
+	cxa_network_dnsCache_invalidate("bad.example");
+	cxa_test_check(lookup("bad.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+	cxa_test_check(numResolves == (numResolvesBefore + 2));
+	cxa_test_check(answer("bad.example", "10.0.1.2", 60));
+}
+
+
+static void test_resolveTimeout(void)
+{
+	cxa_test_check(lookup("slow.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+	cxa_network_dnsCache_entry_t* slowEntry = requests[0].entry;
+
+	// the cache sleeps until the timeout (nothing else is pending)
+	uint32_t timeUntilNext_ms = cxa_runLoop_getTimeUntilNextEntry_ms(THREAD_ID);
+	cxa_test_check((timeUntilNext_ms > 0) && (timeUntilNext_ms <= CXA_NETWORK_DNSCACHE_RESOLVE_TIMEOUT_MS));
+
+	advance_ms(CXA_NETWORK_DNSCACHE_RESOLVE_TIMEOUT_MS - 1000);
+	settle();
+	cxa_test_check(lookup("slow.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	advance_ms(2000);
+	settle();
+	cxa_test_check(lookup("slow.example") == CXA_NETWORK_DNSCACHE_LOOKUP_FAILED);
+
+	// the answer finally shows up...too late
+	cxa_network_dnsCache_entry_setResult(slowEntry, "slow.example", "10.0.2.1", 60);
+	settle();
+	cxa_test_check(lookup("slow.example") == CXA_NETWORK_DNSCACHE_LOOKUP_FAILED);
+
+	// once retried, a late answer for the previous attempt's host is
+	// only accepted if it is (still) for this entry's host
+	advance_ms((CXA_NETWORK_DNSCACHE_NEGATIVE_TTL_S * 1000) + 1000);
+	cxa_test_check(lookup("slow.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+	cxa_network_dnsCache_entry_setResult(slowEntry, "other.example", "10.0.2.2", 60);
+	settle();
+	cxa_test_check(lookup("slow.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	cxa_test_check(answer("slow.example", "10.0.2.3", 60));
+	cxa_test_check((lookup("slow.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, "10.0.2.3") == 0));
+}
+
+
+static void test_lostWakeup(void)
+{
+	// the backend answers from within startResolve, ie. while the cache's
+	// update is running and about to suspend its runLoop entry (with a
+	// resolve timeout pending): the result must still be picked up right away
+	syncAddress = "10.0.3.1";
+	cxa_test_check(lookup("sync.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	cxa_runLoop_iterate(THREAD_ID);
+	syncAddress = NULL;
+	cxa_test_check(cxa_runLoop_getTimeUntilNextEntry_ms(THREAD_ID) == 0);
+
+	cxa_runLoop_iterate(THREAD_ID);
+	cxa_test_check((lookup("sync.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, "10.0.3.1") == 0));
+	cxa_test_check(cxa_runLoop_getTimeUntilNextEntry_ms(THREAD_ID) == UINT32_MAX);
+}
+
+
+static void test_lruEviction(void)
+{
+	// fill the cache (the older entries from the previous tests get evicted)
+	cxa_test_check(cxa_network_dnsCache_preResolve("pinned.example"));
+	settle();
+	cxa_test_check(answer("pinned.example", "10.0.4.0", 0));
+	advance_ms(1000);
+	cxa_test_check(resolve("lru1.example", "10.0.4.1", 0));
+	advance_ms(1000);
+	cxa_test_check(resolve("lru2.example", "10.0.4.2", 0));
+	advance_ms(1000);
+	cxa_test_check(resolve("lru3.example", "10.0.4.3", 0));
+	advance_ms(1000);
+
+	// touch lru1 (and leave the pinned entry untouched the longest)
+	cxa_test_check(lookup("lru1.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED);
+	advance_ms(1000);
+
+	// lru2 is now the least-recently-used unpinned entry
+	cxa_test_check(resolve("lru4.example", "10.0.4.4", 0));
+	unsigned int numResolvesBefore = numResolves;
+	cxa_test_check((lookup("pinned.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, "10.0.4.0") == 0));
+	cxa_test_check((lookup("lru1.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, "10.0.4.1") == 0));
+	cxa_test_check((lookup("lru3.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, "10.0.4.3") == 0));
+	cxa_test_check((lookup("lru4.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, "10.0.4.4") == 0));
+	settle();
+	cxa_test_check(numResolves == numResolvesBefore);
+
+	// lru2 has to be resolved again (evicting lru3, now the oldest)...and
+	// while that and another resolution are in flight, they can't be evicted
+	advance_ms(1000);
+	cxa_test_check(lookup("lru2.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+	cxa_test_check(strcmp(lastHostName, "lru2.example") == 0);
+	advance_ms(1000);
+	cxa_test_check(lookup("lru5.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+	cxa_test_check(strcmp(lastHostName, "lru5.example") == 0);
+
+	// only lru4 is left to evict, then there's no room
+	cxa_test_check(lookup("lru6.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+	cxa_test_check(lookup("lru7.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+	settle();
+	cxa_test_check(strcmp(lastHostName, "lru6.example") == 0);
+	cxa_test_check(!cxa_network_dnsCache_preResolve("pinned2.example"));
+
+	cxa_test_check(answer("lru2.example", "10.0.4.2", 0) && answer("lru5.example", "10.0.4.5", 0) && answer("lru6.example", "10.0.4.6", 0));
+	cxa_test_check((lookup("pinned.example") == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, "10.0.4.0") == 0));
+	cxa_test_check(lookup("lru3.example") == CXA_NETWORK_DNSCACHE_LOOKUP_PENDING);
+}
+
+
+static void advance_ms(uint32_t msIn)
+{
+	now_us += (uint64_t)msIn * 1000;
+}
+
+
+static void settle(void)
+{
+	// run until the cache goes back to sleep
+	for( int i = 0; i < MAX_NUM_SETTLE_ITERATIONS; i++ )
+	{
+		cxa_runLoop_iterate(THREAD_ID);
+		if( cxa_runLoop_getTimeUntilNextEntry_ms(THREAD_ID) != 0 ) return;
+	}
+	cxa_test_check(false);
+}
+
+
+static cxa_network_dnsCache_lookupResult_t lookup(const char *const hostNameIn)
+{
+	address[0] = 0;
+	return cxa_network_dnsCache_lookup(hostNameIn, address, sizeof(address));
+}
+
+
+static bool answer(const char *const hostNameIn, const char *const addressIn, uint32_t ttl_sIn)
+{
+	// answers the most recent resolution of the given host
+	for( size_t i = 0; i < MAX_NUM_REQUESTS; i++ )
+	{
+		if( (requests[i].entry == NULL) || (strcmp(requests[i].hostName, hostNameIn) != 0) ) continue;
+
+		cxa_network_dnsCache_entry_setResult(requests[i].entry, hostNameIn, addressIn, ttl_sIn);
+		settle();
+		return true;
+	}
+	return false;
+}
+
+
+static bool resolve(const char *const hostNameIn, const char *const addressIn, uint32_t ttl_sIn)
+{
+	if( lookup(hostNameIn) != CXA_NETWORK_DNSCACHE_LOOKUP_PENDING ) return false;
+	settle();
+	if( strcmp(lastHostName, hostNameIn) != 0 ) return false;
+	if( !answer(hostNameIn, addressIn, ttl_sIn) ) return false;
+
+	return (lookup(hostNameIn) == CXA_NETWORK_DNSCACHE_LOOKUP_RESOLVED) && (strcmp(address, addressIn) == 0);
+}
+
+
+static bool scm_startResolve(cxa_network_dnsCache_entry_t *const entryIn, const char *const hostNameIn)
+{
+	numResolves++;
+	memmove(&requests[1], &requests[0], sizeof(requests) - sizeof(*requests));
+	requests[0].entry = entryIn;
+	strncpy(requests[0].hostName, hostNameIn, sizeof(requests[0].hostName) - 1);
+	requests[0].hostName[sizeof(requests[0].hostName) - 1] = 0;
+
+	if( syncAddress != NULL ) cxa_network_dnsCache_entry_setResult(entryIn, hostNameIn, syncAddress, 0);
+	return true;
+}
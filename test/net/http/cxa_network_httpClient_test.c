@@ -0,0 +1,436 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * Exercises cxa_network_httpClient and cxa_network_httpClientPool (posix
+ * backend) against a local server that misbehaves in the ways real servers
+ * do: closing immediately after a response, dropping connections mid-body
+ * and ignoring Range headers. Every request must be reported exactly once.
+ *
+ * Build (from the repository root, see test/README.md):
+ * @code
+ * gcc -std=gnu99 $CXA_TEST_INCLUDES -o httpClient_test test/net/http/cxa_network_httpClient_test.c test/support/cxa_test.c \
+ * 	src/net/http/cxa_network_httpClient.c src/net/http/cxa_network_httpClientPool.c \
+ * 	src/net/posix/cxa_posix_network_*.c src/net/cxa_network_tcpClient.c src/net/cxa_network_tcpServer.c \
+ * 	src/net/cxa_network_tcpServer_connectedClient.c src/net/cxa_network_dnsCache.c src/runLoop/cxa_runLoop.c \
+ * 	src/stateMachine/cxa_stateMachine.c src/logger/cxa_logger.c src/misc/cxa_assert.c src/misc/cxa_stringUtils.c \
+ * 	src/misc/cxa_numberUtils.c src/misc/cxa_encodingUtils.c src/collections/cxa_array.c src/collections/cxa_fixedByteBuffer.c \
+ * 	src/collections/cxa_fixedFifo.c src/serial/cxa_ioStream.c src/serial/cxa_ioStream_nullablePassthrough.c \
+ * 	src/timeUtils/cxa_timeDiff.c src/arch-posix/cxa_posix_timeBase.c src/arch-posix/cxa_posix_criticalSection.c -lpthread
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <cxa_network_httpClient.h>
+#include <cxa_network_httpClientPool.h>
+#include <cxa_runLoop.h>
+#include <cxa_test.h>
+
+
+// ******** local macro definitions ********
+#define THREAD_ID						CXA_RUNLOOP_THREADID_DEFAULT
+#define TIMEOUT_MS						5000
+#define SETTLE_TIME_MS					300
+
+#define BIG_RESOURCE_SIZE_BYTES			100000
+#define BIG_NUM_DROPPED_REQUESTS		2
+
+
+// ******** local type definitions ********
+typedef struct
+{
+	volatile bool isDone;
+	unsigned int numCalls;
+	bool wasSuccessful;
+	uint16_t status;
+	char body[64];
+	size_t offset_bytes;
+}completion_t;
+
+
+// ******** local function prototypes ********
+static void startServer(void);
+static void* serverThread_accept(void* userVarIn);
+static void* serverThread_connection(void* userVarIn);
+static bool readRequest(int fdIn, char *const pathOut, size_t maxPathLen_bytesIn, long *const rangeStartOut);
+static bool sendAll(int fdIn, const void *const dataIn, size_t numBytesIn);
+static void serveBig(int fdIn, long rangeStartIn, bool *const shouldCloseOut);
+
+static void test_closeAfterResponse(cxa_network_httpClient_t *const clientIn, bool keepOpenIn);
+static void test_keepAlive(cxa_network_httpClient_t *const clientIn);
+static void test_resumedDownload(cxa_network_httpClient_t *const clientIn);
+static void test_pool(cxa_network_httpClientPool_t *const poolIn);
+
+static void resetCompletion(completion_t *const compIn);
+static void cb_onComplete(cxa_network_httpClient_t *const clientIn, bool didCompleteSuccessfullyIn,
+						  uint16_t statusIn, char *const bodyIn, size_t bodySize_bytesIn, void* userVarIn);
+static void cb_onDownloadComplete(cxa_network_httpClient_t *const clientIn, bool didCompleteSuccessfullyIn,
+								  uint16_t statusIn, size_t offset_bytesIn, void* userVarIn);
+static bool cb_genBody(cxa_network_httpClient_t *const clientIn, cxa_ioStream_t *const iosIn, void* userVarIn);
+
+static cxa_ioStream_readStatus_t cb_sink_readByte(uint8_t *const byteOut, void *const userVarIn);
+static bool cb_sink_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+
+
+// ********  local variable declarations *********
+static uint16_t serverPort;
+static volatile int numBigRequests = 0;
+
+static uint8_t sink[BIG_RESOURCE_SIZE_BYTES];
+static size_t sink_numBytes = 0;
+
+
+// ******** global function implementations ********
+int main(void)
+{
+	cxa_test_init();
+	startServer();
+
+	static cxa_network_httpClient_t client;
+	cxa_network_httpClient_init(&client, THREAD_ID);
+	static cxa_network_httpClientPool_t pool;
+	cxa_network_httpClientPool_init(&pool, THREAD_ID);
+
+	// let our state machines start up
+	cxa_test_iterateFor(THREAD_ID, 10);
+
+	test_closeAfterResponse(&client, false);
+	test_closeAfterResponse(&client, true);
+	test_keepAlive(&client);
+	test_resumedDownload(&client);
+	test_pool(&pool);
+
+	return cxa_test_finish("httpClient");
+}
+
+
+// ******** local function implementations ********
+static void startServer(void)
+{
+	int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+	cxa_test_check(listenFd >= 0);
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0;
+	socklen_t addrLen = sizeof(addr);
+	if( !cxa_test_check(bind(listenFd, (struct sockaddr*)&addr, sizeof(addr)) == 0) ||
+		!cxa_test_check(listen(listenFd, 8) == 0) ||
+		!cxa_test_check(getsockname(listenFd, (struct sockaddr*)&addr, &addrLen) == 0) ) exit(cxa_test_finish("httpClient"));
+	serverPort = ntohs(addr.sin_port);
+
+	pthread_t thread;
+	pthread_create(&thread, NULL, serverThread_accept, (void*)(intptr_t)listenFd);
+	pthread_detach(thread);
+}
+
+
+static void* serverThread_accept(void* userVarIn)
+{
+	int listenFd = (int)(intptr_t)userVarIn;
+	while( 1 )
+	{
+		int connFd = accept(listenFd, NULL, NULL);
+		if( connFd < 0 ) continue;
+
+		pthread_t thread;
+		pthread_create(&thread, NULL, serverThread_connection, (void*)(intptr_t)connFd);
+		pthread_detach(thread);
+	}
+	return NULL;
+}
+
+
+static void* serverThread_connection(void* userVarIn)
+{
+	int connFd = (int)(intptr_t)userVarIn;
+
+	char path[64];
+	long rangeStart;
+	bool shouldClose = false;
+	while( !shouldClose && readRequest(connFd, path, sizeof(path), &rangeStart) )
+	{
+		if( strcmp(path, "/close") == 0 )
+		{
+			// respond and close immediately (before the client can return to idle)
+			static const char resp[] = "HTTP/1.1 200 OK\r\nContent-Length: 5\r\nConnection: close\r\n\r\nhello";
+			sendAll(connFd, resp, sizeof(resp)-1);
+			shouldClose = true;
+		}
+		else if( strcmp(path, "/keep") == 0 )
+		{
+			static const char resp[] = "HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\nkept";
+			sendAll(connFd, resp, sizeof(resp)-1);
+		}
+		else if( strcmp(path, "/big") == 0 )
+		{
+			serveBig(connFd, rangeStart, &shouldClose);
+		}
+		else
+		{
+			static const char resp[] = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+			sendAll(connFd, resp, sizeof(resp)-1);
+		}
+	}
+
+	shutdown(connFd, SHUT_RDWR);
+	close(connFd);
+	return NULL;
+}
+
+
+static bool readRequest(int fdIn, char *const pathOut, size_t maxPathLen_bytesIn, long *const rangeStartOut)
+{
+	// read the request head a byte at a time (so we never consume the next request)
+	char head[1024];
+	size_t headLen = 0;
+	while( (headLen < 4) || (memcmp(&head[headLen-4], "\r\n\r\n", 4) != 0) )
+	{
+		if( (headLen == sizeof(head)-1) || (read(fdIn, &head[headLen], 1) != 1) ) return false;
+		headLen++;
+	}
+	head[headLen] = 0;
+
+	char method[8];
+	char format[32];
+	snprintf(format, sizeof(format), "%%7s %%%zus", maxPathLen_bytesIn-1);
+	if( sscanf(head, format, method, pathOut) != 2 ) return false;
+
+	*rangeStartOut = -1;
+	long contentLength = 0;
+	for( char* currLine = strstr(head, "\r\n"); (currLine != NULL) && (currLine[2] != '\r'); currLine = strstr(currLine+2, "\r\n") )
+	{
+		if( strncasecmp(&currLine[2], "Content-Length:", 15) == 0 ) contentLength = strtol(&currLine[17], NULL, 10);
+		else if( strncasecmp(&currLine[2], "Range: bytes=", 13) == 0 ) *rangeStartOut = strtol(&currLine[15], NULL, 10);
+	}
+
+	// discard any body
+	for( long i = 0; i < contentLength; i++ )
+	{
+		char discard;
+		if( read(fdIn, &discard, 1) != 1 ) return false;
+	}
+
+	return true;
+}
+
+
+static bool sendAll(int fdIn, const void *const dataIn, size_t numBytesIn)
+{
+	const uint8_t* currByte = (const uint8_t*)dataIn;
+	while( numBytesIn > 0 )
+	{
+		ssize_t numBytesSent = send(fdIn, currByte, numBytesIn, MSG_NOSIGNAL);
+		if( numBytesSent <= 0 ) return false;
+		currByte += numBytesSent;
+		numBytesIn -= (size_t)numBytesSent;
+	}
+	return true;
+}
+
+
+static void serveBig(int fdIn, long rangeStartIn, bool *const shouldCloseOut)
+{
+	static uint8_t resource[BIG_RESOURCE_SIZE_BYTES];
+	for( size_t i = 0; i < sizeof(resource); i++ ) resource[i] = (uint8_t)((i * 7) + 3);
+
+	// the first requests are dropped mid-body, the last ignores the Range
+	// header and closes right after the (complete) response
+	int requestNum = ++numBigRequests;
+	bool honorRange = (rangeStartIn > 0) && (requestNum <= BIG_NUM_DROPPED_REQUESTS);
+	size_t start = honorRange ? (size_t)rangeStartIn : 0;
+
+	char head[256];
+	int headLen = honorRange ?
+			snprintf(head, sizeof(head), "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes %zu-%zu/%zu\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n",
+					 start, sizeof(resource)-1, sizeof(resource), sizeof(resource)-start) :
+			snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n", sizeof(resource));
+	sendAll(fdIn, head, (size_t)headLen);
+
+	size_t numBodyBytes = sizeof(resource) - start;
+	if( requestNum <= BIG_NUM_DROPPED_REQUESTS ) numBodyBytes = 20000 + (requestNum * 1111);
+	sendAll(fdIn, &resource[start], numBodyBytes);
+
+	*shouldCloseOut = true;
+}
+
+
+static void test_closeAfterResponse(cxa_network_httpClient_t *const clientIn, bool keepOpenIn)
+{
+	static uint8_t respBuffer[64];
+	completion_t comp;
+
+	// the server's close usually beats our (deferred) return to idle
+	for( int i = 0; i < 10; i++ )
+	{
+		resetCompletion(&comp);
+		cxa_network_httpClient_get_async(clientIn, "127.0.0.1", serverPort, false, "/close", TIMEOUT_MS, keepOpenIn,
+										 NULL, cb_onComplete, respBuffer, sizeof(respBuffer), (void*)&comp);
+		cxa_test_check(cxa_test_iterateUntil(THREAD_ID, &comp.isDone, TIMEOUT_MS));
+		cxa_test_iterateFor(THREAD_ID, SETTLE_TIME_MS / 10);
+
+		cxa_test_check(comp.numCalls == 1);
+		cxa_test_check(comp.wasSuccessful);
+		cxa_test_check(comp.status == 200);
+		cxa_test_check(strcmp(comp.body, "hello") == 0);
+		cxa_test_check(cxa_network_httpClient_isIdle(clientIn));
+	}
+}
+
+
+static void test_keepAlive(cxa_network_httpClient_t *const clientIn)
+{
+	static uint8_t respBuffer[64];
+	completion_t comp;
+
+	for( int i = 0; i < 3; i++ )
+	{
+		resetCompletion(&comp);
+		cxa_network_httpClient_post_async(clientIn, "127.0.0.1", serverPort, false, "/keep", TIMEOUT_MS, true,
+										  NULL, cb_genBody, cb_onComplete, respBuffer, sizeof(respBuffer), (void*)&comp);
+		cxa_test_check(cxa_test_iterateUntil(THREAD_ID, &comp.isDone, TIMEOUT_MS));
+		cxa_test_iterateFor(THREAD_ID, SETTLE_TIME_MS / 10);
+
+		cxa_test_check(comp.numCalls == 1);
+		cxa_test_check(comp.wasSuccessful);
+		cxa_test_check(strcmp(comp.body, "kept") == 0);
+		cxa_test_check(cxa_network_httpClient_getLastTiming(clientIn)->wasConnectionReused == (i > 0));
+	}
+}
+
+
+static void test_resumedDownload(cxa_network_httpClient_t *const clientIn)
+{
+	static cxa_ioStream_t ios_sink;
+	cxa_ioStream_init(&ios_sink);
+	cxa_ioStream_bind(&ios_sink, cb_sink_readByte, cb_sink_writeBytes, NULL);
+
+	completion_t comp;
+	resetCompletion(&comp);
+	sink_numBytes = 0;
+	numBigRequests = 0;
+
+	cxa_network_httpClient_download_async(clientIn, "127.0.0.1", serverPort, false, "/big", TIMEOUT_MS,
+										  &ios_sink, 0, cb_onDownloadComplete, (void*)&comp);
+	cxa_test_check(cxa_test_iterateUntil(THREAD_ID, &comp.isDone, TIMEOUT_MS));
+	cxa_test_iterateFor(THREAD_ID, SETTLE_TIME_MS);
+
+	cxa_test_check(comp.numCalls == 1);
+	cxa_test_check(comp.wasSuccessful);
+	cxa_test_check(comp.offset_bytes == BIG_RESOURCE_SIZE_BYTES);
+	cxa_test_check(numBigRequests == BIG_NUM_DROPPED_REQUESTS + 1);
+	cxa_test_check(sink_numBytes == BIG_RESOURCE_SIZE_BYTES);
+
+	bool isSinkValid = true;
+	for( size_t i = 0; i < sink_numBytes; i++ )
+	{
+		if( sink[i] != (uint8_t)((i * 7) + 3) ) isSinkValid = false;
+	}
+	cxa_test_check(isSinkValid);
+}
+
+
+static void test_pool(cxa_network_httpClientPool_t *const poolIn)
+{
+	static uint8_t respBuffers[4][64];
+	completion_t comps[4];
+	for( size_t i = 0; i < 4; i++ ) resetCompletion(&comps[i]);
+
+	cxa_test_check(cxa_network_httpClientPool_get_async(poolIn, "127.0.0.1", serverPort, false, "/close", TIMEOUT_MS,
+														NULL, cb_onComplete, respBuffers[0], sizeof(respBuffers[0]), (void*)&comps[0]));
+	cxa_test_check(cxa_network_httpClientPool_get_async(poolIn, "127.0.0.1", serverPort, false, "/close", TIMEOUT_MS,
+														NULL, cb_onComplete, respBuffers[1], sizeof(respBuffers[1]), (void*)&comps[1]));
+	cxa_test_check(cxa_network_httpClientPool_put_async(poolIn, "127.0.0.1", serverPort, false, "/keep", TIMEOUT_MS,
+														NULL, cb_genBody, cb_onComplete, respBuffers[2], sizeof(respBuffers[2]), (void*)&comps[2]));
+	cxa_test_check(cxa_network_httpClientPool_post_async(poolIn, "127.0.0.1", serverPort, false, "/keep", TIMEOUT_MS,
+														 NULL, cb_genBody, cb_onComplete, respBuffers[3], sizeof(respBuffers[3]), (void*)&comps[3]));
+
+	for( size_t i = 0; i < 4; i++ ) cxa_test_check(cxa_test_iterateUntil(THREAD_ID, &comps[i].isDone, TIMEOUT_MS));
+	cxa_test_iterateFor(THREAD_ID, SETTLE_TIME_MS);
+
+	for( size_t i = 0; i < 4; i++ )
+	{
+		cxa_test_check(comps[i].numCalls == 1);
+		cxa_test_check(comps[i].wasSuccessful);
+	}
+	cxa_test_check(strcmp(comps[0].body, "hello") == 0);
+	cxa_test_check(strcmp(comps[2].body, "kept") == 0);
+
+	cxa_network_httpClientPool_stats_t* stats = cxa_network_httpClientPool_getStats(poolIn);
+	cxa_test_check(stats->numRequests == 4);
+	cxa_test_check(stats->numSuccesses == 4);
+	cxa_test_check(stats->numFailures == 0);
+}
+
+
+static void resetCompletion(completion_t *const compIn)
+{
+	memset(compIn, 0, sizeof(*compIn));
+}
+
+
+static void cb_onComplete(cxa_network_httpClient_t *const clientIn, bool didCompleteSuccessfullyIn,
+						  uint16_t statusIn, char *const bodyIn, size_t bodySize_bytesIn, void* userVarIn)
+{
+	completion_t* comp = (completion_t*)userVarIn;
+
+	comp->numCalls++;
+	comp->wasSuccessful = didCompleteSuccessfullyIn;
+	comp->status = statusIn;
+	snprintf(comp->body, sizeof(comp->body), "%.*s", (int)bodySize_bytesIn, (bodyIn != NULL) ? bodyIn : "");
+	comp->isDone = true;
+}
+
+
+static void cb_onDownloadComplete(cxa_network_httpClient_t *const clientIn, bool didCompleteSuccessfullyIn,
+								  uint16_t statusIn, size_t offset_bytesIn, void* userVarIn)
+{
+	completion_t* comp = (completion_t*)userVarIn;
+
+	comp->numCalls++;
+	comp->wasSuccessful = didCompleteSuccessfullyIn;
+	comp->status = statusIn;
+	comp->offset_bytes = offset_bytesIn;
+	comp->isDone = true;
+}
+
+
+static bool cb_genBody(cxa_network_httpClient_t *const clientIn, cxa_ioStream_t *const iosIn, void* userVarIn)
+{
+	cxa_ioStream_writeString(iosIn, "payload");
+	return false;
+}
+
+
+static cxa_ioStream_readStatus_t cb_sink_readByte(uint8_t *const byteOut, void *const userVarIn)
+{
+	return CXA_IOSTREAM_READSTAT_NODATA;
+}
+
+
+static bool cb_sink_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
+{
+	if( (sink_numBytes + bufferSize_bytesIn) > sizeof(sink) ) return false;
+
+	memcpy(&sink[sink_numBytes], buffIn, bufferSize_bytesIn);
+	sink_numBytes += bufferSize_bytesIn;
+	return true;
+}
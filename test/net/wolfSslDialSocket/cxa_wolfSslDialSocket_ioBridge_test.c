@@ -0,0 +1,295 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+
+/**
+ * @file
+ * Exercises cxa_wolfSslDialSocket_ioBridge with a cxa_ioStream_pipe standing
+ * in for the modem socket: partial reads, bursts larger than the ring, a
+ * TLS receive that has to be re-entered after WANT_READ, and EOF with data
+ * still buffered. Every case runs twice: over the pipe itself (block reads)
+ * and over a byte-at-a-time wrapper (the per-byte fallback of
+ * ::cxa_ioStream_readBytes). No data may be lost, duplicated or reordered.
+ *
+ * The ring is shrunk (and the pipe grown) so a burst can exceed the ring.
+ *
+ * Build (from the repository root, see test/README.md):
+ * @code
+ * gcc -std=gnu99 -DCXA_WOLFSSLDIALSOCKET_IOBRIDGE_RINGBUFFERLEN_BYTES=64 -DCXA_IOSTREAM_PIPE_BUFFER_SIZE_BYTES=512 $CXA_TEST_INCLUDES \
+ * 	-o ioBridge_test test/net/wolfSslDialSocket/cxa_wolfSslDialSocket_ioBridge_test.c test/support/cxa_test.c \
+ * 	src/net/wolfSslDialSocket/cxa_wolfSslDialSocket_ioBridge.c src/serial/cxa_ioStream.c src/serial/cxa_ioStream_pipe.c \
+ * 	src/collections/cxa_fixedFifo.c src/collections/cxa_array.c src/collections/cxa_fixedByteBuffer.c \
+ * 	src/misc/cxa_assert.c src/misc/cxa_stringUtils.c src/misc/cxa_numberUtils.c src/misc/cxa_encodingUtils.c \
+ * 	src/logger/cxa_logger.c src/runLoop/cxa_runLoop.c src/timeUtils/cxa_timeDiff.c \
+ * 	src/arch-posix/cxa_posix_timeBase.c src/arch-posix/cxa_posix_criticalSection.c -lpthread
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <stdio.h>
+#include <string.h>
+
+#include <cxa_ioStream_pipe.h>
+#include <cxa_test.h>
+#include <cxa_wolfSslDialSocket_ioBridge.h>
+
+
+// ******** local macro definitions ********
+#define RING_SIZE_BYTES					CXA_WOLFSSLDIALSOCKET_IOBRIDGE_RINGBUFFERLEN_BYTES
+#define BURST_SIZE_BYTES				(5 * RING_SIZE_BYTES + 13)
+
+// what the tcpClient's wolfSSL receive callback returns (see tlsRecv)
+#define TLSRECV_WANT_READ				-2
+#define TLSRECV_CONN_CLOSE				-5
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static void runAll(bool useByteReadsIn);
+
+static void test_partialReads(void);
+static void test_burstLargerThanRing(void);
+static void test_wantReadReentry(void);
+static void test_eof(void);
+
+static void reset(void);
+static void modemSend(const uint8_t *const dataIn, size_t numBytesIn);
+static bool readExactly(uint8_t *const buffOut, size_t numBytesIn, size_t maxChunkSize_bytesIn);
+static int tlsRecv(uint8_t *const buffOut, size_t maxNumBytesIn);
+static uint8_t patternByte(size_t indexIn);
+
+static cxa_ioStream_readStatus_t cb_byteModem_readByte(uint8_t *const byteOut, void *const userVarIn);
+static bool cb_byteModem_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+
+
+// ********  local variable declarations *********
+static cxa_ioStream_pipe_t modemPipe;
+static cxa_ioStream_t byteModem;
+static bool isEof;
+
+static cxa_wolfSslDialSocket_ioBridge_t bridge;
+
+
+// ******** global function implementations ********
+int main(void)
+{
+	cxa_test_init();
+
+	runAll(false);
+	runAll(true);
+
+	return cxa_test_finish("wolfSslDialSocket_ioBridge");
+}
+
+
+// ******** local function implementations ********
+static void runAll(bool useByteReadsIn)
+{
+	// endpoint 1 is the "network", endpoint 2 is the modem socket the bridge reads
+	cxa_ioStream_init(&byteModem);
+	cxa_ioStream_bind(&byteModem, cb_byteModem_readByte, cb_byteModem_writeBytes, NULL);
+	cxa_ioStream_t* modem = useByteReadsIn ? &byteModem : cxa_ioStream_pipe_getEndpoint2(&modemPipe);
+
+	cxa_wolfSslDialSocket_ioBridge_init(&bridge);
+	cxa_test_check(!cxa_wolfSslDialSocket_ioBridge_isAttached(&bridge));
+
+	reset();
+	cxa_wolfSslDialSocket_ioBridge_attach(&bridge, modem);
+	test_partialReads();
+
+	reset();
+	cxa_wolfSslDialSocket_ioBridge_attach(&bridge, modem);
+	test_burstLargerThanRing();
+
+	reset();
+	cxa_wolfSslDialSocket_ioBridge_attach(&bridge, modem);
+	test_wantReadReentry();
+
+	// only the wrapper can report EOF (the pipe never closes)
+	if( useByteReadsIn )
+	{
+		reset();
+		cxa_wolfSslDialSocket_ioBridge_attach(&bridge, modem);
+		test_eof();
+	}
+
+	cxa_wolfSslDialSocket_ioBridge_detach(&bridge);
+	uint8_t rxByte;
+	size_t numBytesRead;
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_readBlock(&bridge, &rxByte, 1, &numBytesRead) == CXA_IOSTREAM_READSTAT_ERROR);
+}
+
+
+static void test_partialReads(void)
+{
+	uint8_t data[10];
+	for( size_t i = 0; i < sizeof(data); i++ ) data[i] = patternByte(i);
+	modemSend(data, sizeof(data));
+
+	// smaller than what's available, then the remainder, then nothing
+	uint8_t rxData[16];
+	size_t numBytesRead;
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_readBlock(&bridge, rxData, 4, &numBytesRead) == CXA_IOSTREAM_READSTAT_GOTDATA);
+	cxa_test_check(numBytesRead == 4);
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_readBlock(&bridge, &rxData[4], 4, &numBytesRead) == CXA_IOSTREAM_READSTAT_GOTDATA);
+	cxa_test_check(numBytesRead == 4);
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_readBlock(&bridge, &rxData[8], sizeof(rxData) - 8, &numBytesRead) == CXA_IOSTREAM_READSTAT_GOTDATA);
+	cxa_test_check(numBytesRead == 2);
+	cxa_test_check(memcmp(rxData, data, sizeof(data)) == 0);
+
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_readBlock(&bridge, rxData, sizeof(rxData), &numBytesRead) == CXA_IOSTREAM_READSTAT_NODATA);
+	cxa_test_check(numBytesRead == 0);
+
+	// a zero-length read never consumes anything
+	modemSend(data, 1);
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_readBlock(&bridge, rxData, 0, &numBytesRead) == CXA_IOSTREAM_READSTAT_NODATA);
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_readBlock(&bridge, rxData, 1, &numBytesRead) == CXA_IOSTREAM_READSTAT_GOTDATA);
+	cxa_test_check((numBytesRead == 1) && (rxData[0] == data[0]));
+}
+
+
+static void test_burstLargerThanRing(void)
+{
+	static uint8_t data[BURST_SIZE_BYTES];
+	for( size_t i = 0; i < sizeof(data); i++ ) data[i] = patternByte(i);
+	modemSend(data, sizeof(data));
+
+	// a fill stops at a full ring, the rest stays with the modem
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_fill(&bridge) == RING_SIZE_BYTES);
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_fill(&bridge) == 0);
+
+	// odd chunk sizes make the ring wrap at a different spot on every pass
+	static uint8_t rxData[BURST_SIZE_BYTES];
+	cxa_test_check(readExactly(rxData, 37, 37));
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_fill(&bridge) == 37);
+	cxa_test_check(readExactly(&rxData[37], sizeof(rxData) - 37, 23));
+	cxa_test_check(memcmp(rxData, data, sizeof(data)) == 0);
+
+	size_t numBytesRead;
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_readBlock(&bridge, rxData, 1, &numBytesRead) == CXA_IOSTREAM_READSTAT_NODATA);
+}
+
+
+static void test_wantReadReentry(void)
+{
+	// wolfSSL asks for a 5-byte record header before anything has arrived...
+	uint8_t header[5];
+	cxa_test_check(tlsRecv(header, sizeof(header)) == TLSRECV_WANT_READ);
+
+	// ...then re-enters as the header trickles in
+	uint8_t data[5 + 20];
+	for( size_t i = 0; i < sizeof(data); i++ ) data[i] = patternByte(i);
+	modemSend(data, 3);
+	cxa_test_check(tlsRecv(header, sizeof(header)) == 3);
+	cxa_test_check(tlsRecv(&header[3], 2) == TLSRECV_WANT_READ);
+	modemSend(&data[3], 2);
+	cxa_test_check(tlsRecv(&header[3], 2) == 2);
+	cxa_test_check(memcmp(header, data, sizeof(header)) == 0);
+
+	// the record body arrives in two pieces, the second after a WANT_READ
+	uint8_t body[20];
+	modemSend(&data[5], 12);
+	cxa_test_check(tlsRecv(body, sizeof(body)) == 12);
+	cxa_test_check(tlsRecv(&body[12], sizeof(body) - 12) == TLSRECV_WANT_READ);
+	modemSend(&data[17], 8);
+	cxa_test_check(tlsRecv(&body[12], sizeof(body) - 12) == 8);
+	cxa_test_check(memcmp(body, &data[5], sizeof(body)) == 0);
+}
+
+
+static void test_eof(void)
+{
+	uint8_t data[6];
+	for( size_t i = 0; i < sizeof(data); i++ ) data[i] = patternByte(i);
+	modemSend(data, sizeof(data));
+	isEof = true;
+
+	// everything sent before the close is still delivered...
+	uint8_t rxData[8];
+	cxa_test_check(tlsRecv(rxData, 4) == 4);
+	cxa_test_check(tlsRecv(&rxData[4], 4) == 2);
+	cxa_test_check(memcmp(rxData, data, sizeof(data)) == 0);
+
+	// ...then the close is reported (and keeps being reported)
+	cxa_test_check(tlsRecv(rxData, sizeof(rxData)) == TLSRECV_CONN_CLOSE);
+	cxa_test_check(tlsRecv(rxData, sizeof(rxData)) == TLSRECV_CONN_CLOSE);
+	cxa_test_check(cxa_wolfSslDialSocket_ioBridge_fill(&bridge) == 0);
+
+	// re-attaching (a new connection) clears the error
+	isEof = false;
+	cxa_wolfSslDialSocket_ioBridge_attach(&bridge, &byteModem);
+	cxa_test_check(tlsRecv(rxData, sizeof(rxData)) == TLSRECV_WANT_READ);
+}
+
+
+static void reset(void)
+{
+	cxa_ioStream_pipe_init(&modemPipe);
+	isEof = false;
+}
+
+
+static void modemSend(const uint8_t *const dataIn, size_t numBytesIn)
+{
+	cxa_test_check(cxa_ioStream_writeBytes(cxa_ioStream_pipe_getEndpoint1(&modemPipe), (void*)dataIn, numBytesIn));
+}
+
+
+static bool readExactly(uint8_t *const buffOut, size_t numBytesIn, size_t maxChunkSize_bytesIn)
+{
+	size_t numBytesRead = 0;
+	while( numBytesRead < numBytesIn )
+	{
+		size_t numBytesRemaining = numBytesIn - numBytesRead;
+		size_t currNumBytesRead;
+		if( cxa_wolfSslDialSocket_ioBridge_readBlock(&bridge, &buffOut[numBytesRead],
+													 ((numBytesRemaining < maxChunkSize_bytesIn) ? numBytesRemaining : maxChunkSize_bytesIn),
+													 &currNumBytesRead) != CXA_IOSTREAM_READSTAT_GOTDATA ) return false;
+		numBytesRead += currNumBytesRead;
+	}
+	return true;
+}
+
+
+static int tlsRecv(uint8_t *const buffOut, size_t maxNumBytesIn)
+{
+	// mirrors the tcpClient's wolfSSL receive callback
+	size_t numBytesRead = 0;
+	switch( cxa_wolfSslDialSocket_ioBridge_readBlock(&bridge, buffOut, maxNumBytesIn, &numBytesRead) )
+	{
+		case CXA_IOSTREAM_READSTAT_GOTDATA:
+			return (int)numBytesRead;
+
+		case CXA_IOSTREAM_READSTAT_NODATA:
+			return TLSRECV_WANT_READ;
+
+		default:
+			return TLSRECV_CONN_CLOSE;
+	}
+}
+
+
+static uint8_t patternByte(size_t indexIn)
+{
+	return (uint8_t)((indexIn * 7) + (indexIn >> 8));
+}
+
+
+static cxa_ioStream_readStatus_t cb_byteModem_readByte(uint8_t *const byteOut, void *const userVarIn)
+{
+	// a socket that only reads a byte at a time, and reports EOF once drained
+	cxa_ioStream_readStatus_t retVal = cxa_ioStream_readByte(cxa_ioStream_pipe_getEndpoint2(&modemPipe), byteOut);
+	return ((retVal == CXA_IOSTREAM_READSTAT_NODATA) && isEof) ? CXA_IOSTREAM_READSTAT_ERROR : retVal;
+}
+
+
+static bool cb_byteModem_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
+{
+	return cxa_ioStream_writeBytes(cxa_ioStream_pipe_getEndpoint2(&modemPipe), buffIn, bufferSize_bytesIn);
+}
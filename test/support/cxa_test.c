@@ -0,0 +1,194 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#include "cxa_test.h"
+
+
+// ******** includes ********
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if defined(__x86_64__)
+	#include <x86intrin.h>
+#endif
+
+#include <cxa_assert.h>
+#include <cxa_ioStream.h>
+#include <cxa_logger_implementation.h>
+#include <cxa_mutex.h>
+#include <cxa_runLoop.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn);
+static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+
+
+// ********  local variable declarations *********
+static cxa_ioStream_t ios_log;
+static cxa_ioStream_t ios_assert;
+static cxa_mutex_t mutex;
+
+static unsigned int numChecks = 0;
+static unsigned int numFailures = 0;
+
+
+// ******** global function implementations ********
+void cxa_test_init(void)
+{
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	cxa_ioStream_init(&ios_assert);
+	cxa_ioStream_bind(&ios_assert, cb_ioStream_readByte, cb_ioStream_writeBytes, NULL);
+	cxa_assert_setIoStream(&ios_assert);
+
+	if( getenv("CXA_TEST_VERBOSE") != NULL )
+	{
+		cxa_ioStream_init(&ios_log);
+		cxa_ioStream_bind(&ios_log, cb_ioStream_readByte, cb_ioStream_writeBytes, NULL);
+		cxa_logger_setGlobalIoStream(&ios_log);
+	}
+}
+
+
+bool cxa_test_check_impl(bool condIn, const char *const condStrIn, const char *const fileIn, int lineIn)
+{
+	numChecks++;
+	if( !condIn )
+	{
+		numFailures++;
+		printf("FAIL %s:%d: %s\n", fileIn, lineIn, condStrIn);
+	}
+	return condIn;
+}
+
+
+int cxa_test_finish(const char *const nameIn)
+{
+	printf("%s: %u checks, %u failures\n", nameIn, numChecks, numFailures);
+	return (numFailures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+bool cxa_test_iterateUntil(int threadIdIn, volatile bool *const flagIn, uint32_t timeout_msIn)
+{
+	cxa_assert(flagIn);
+
+	uint64_t startTime_ns = cxa_test_getTime_ns();
+	while( !*flagIn )
+	{
+		if( (cxa_test_getTime_ns() - startTime_ns) > ((uint64_t)timeout_msIn * 1000000) ) return false;
+		cxa_runLoop_iterate(threadIdIn);
+	}
+	return true;
+}
+
+
+void cxa_test_iterateFor(int threadIdIn, uint32_t duration_msIn)
+{
+	uint64_t startTime_ns = cxa_test_getTime_ns();
+	while( (cxa_test_getTime_ns() - startTime_ns) < ((uint64_t)duration_msIn * 1000000) )
+	{
+		cxa_runLoop_iterate(threadIdIn);
+	}
+}
+
+
+bool cxa_test_executeUntil(int threadIdIn, volatile bool *const flagIn, uint32_t timeout_msIn)
+{
+	cxa_assert(flagIn);
+
+	uint64_t startTime_ns = cxa_test_getTime_ns();
+	while( !*flagIn )
+	{
+		uint64_t elapsed_ms = (cxa_test_getTime_ns() - startTime_ns) / 1000000;
+		if( elapsed_ms >= timeout_msIn ) return false;
+		cxa_runLoop_executeOnce(threadIdIn, (uint32_t)(timeout_msIn - elapsed_ms));
+	}
+	return true;
+}
+
+
+void cxa_test_executeFor(int threadIdIn, uint32_t duration_msIn)
+{
+	uint64_t startTime_ns = cxa_test_getTime_ns();
+	for( uint64_t elapsed_ms = 0; elapsed_ms < duration_msIn; elapsed_ms = (cxa_test_getTime_ns() - startTime_ns) / 1000000 )
+	{
+		cxa_runLoop_executeOnce(threadIdIn, (uint32_t)(duration_msIn - elapsed_ms));
+	}
+}
+
+
+uint64_t cxa_test_getTime_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
+}
+
+
+uint64_t cxa_test_getCpuTime_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
+}
+
+
+uint64_t cxa_test_getThreadCpuTime_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
+}
+
+
+uint64_t cxa_test_getCycles(void)
+{
+#if defined(__x86_64__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+
+// the tests drive all cxa objects from a single thread
+cxa_mutex_t* cxa_mutex_reserve(void)
+{
+	return &mutex;
+}
+
+
+void cxa_mutex_aquire(cxa_mutex_t *const mutexIn)
+{
+}
+
+
+void cxa_mutex_release(cxa_mutex_t *const mutexIn)
+{
+}
+
+
+// ******** local function implementations ********
+static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn)
+{
+	return CXA_IOSTREAM_READSTAT_NODATA;
+}
+
+
+static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
+{
+	fwrite(buffIn, 1, bufferSize_bytesIn, stdout);
+	return true;
+}
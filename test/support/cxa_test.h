@@ -0,0 +1,134 @@
+/*
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of this source code package.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_TEST_H_
+#define CXA_TEST_H_
+
+
+/**
+ * @file
+ * Minimal support for the host (posix) tests and benchmarks: checks that
+ * record failures (rather than asserting), runLoop helpers and a
+ * monotonic clock.
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * int main(void)
+ * {
+ * 	cxa_test_init();
+ *
+ * 	cxa_test_check(1 + 1 == 2);
+ *
+ * 	return cxa_test_finish("myTest");
+ * }
+ * @endcode
+ */
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// ******** global macro definitions ********
+#define cxa_test_check(condIn)			cxa_test_check_impl((condIn), #condIn, __FILE__, __LINE__)
+
+
+// ******** global type definitions *********
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * Routes log and assert output to stdout. Set the environment variable
+ * CXA_TEST_VERBOSE to see log output.
+ */
+void cxa_test_init(void);
+
+
+/**
+ * @private
+ */
+bool cxa_test_check_impl(bool condIn, const char *const condStrIn, const char *const fileIn, int lineIn);
+
+
+/**
+ * @public
+ * Prints a summary of the checks performed
+ *
+ * @return the process exit code (0 if all checks passed)
+ */
+int cxa_test_finish(const char *const nameIn);
+
+
+/**
+ * @public
+ * Iterates the given runLoop until the flag is set or the timeout expires
+ *
+ * @return true if the flag was set
+ */
+bool cxa_test_iterateUntil(int threadIdIn, volatile bool *const flagIn, uint32_t timeout_msIn);
+
+
+/**
+ * @public
+ * Iterates the given runLoop for the given amount of time (eg. to catch
+ * callbacks that should _not_ happen)
+ */
+void cxa_test_iterateFor(int threadIdIn, uint32_t duration_msIn);
+
+
+/**
+ * @public
+ * Like ::cxa_test_iterateUntil, but sleeps between iterations the way
+ * ::cxa_runLoop_execute does (so only resumed entries and external events
+ * move things along)
+ *
+ * @return true if the flag was set
+ */
+bool cxa_test_executeUntil(int threadIdIn, volatile bool *const flagIn, uint32_t timeout_msIn);
+
+
+/**
+ * @public
+ * Like ::cxa_test_iterateFor, but sleeps between iterations the way
+ * ::cxa_runLoop_execute does
+ */
+void cxa_test_executeFor(int threadIdIn, uint32_t duration_msIn);
+
+
+/**
+ * @public
+ * @return a monotonic timestamp, in nanoseconds
+ */
+uint64_t cxa_test_getTime_ns(void);
+
+
+/**
+ * @public
+ * @return CPU time consumed by this process, in nanoseconds
+ */
+uint64_t cxa_test_getCpuTime_ns(void);
+
+
+/**
+ * @public
+ * @return CPU time consumed by the calling thread, in nanoseconds
+ */
+uint64_t cxa_test_getThreadCpuTime_ns(void);
+
+
+/**
+ * @public
+ * @return the timestamp counter (rdtsc) on x86-64, or 0 where there is no
+ * 		user-readable cycle counter. The TSC ticks at the CPU's nominal rate,
+ * 		so it matches core cycles only with frequency scaling/turbo disabled.
+ */
+uint64_t cxa_test_getCycles(void);
+
+
+#endif